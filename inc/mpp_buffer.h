@@ -45,6 +45,7 @@
  *    mpp_buffer_group_limit_get
  *    mpp_buffer_group_put
  *    mpp_buffer_group_limit_config
+ *    mpp_buffer_group_prealloc
  *
  * 3. buffer allocator management
  *    this part is for allocator on different os, it does not have user interface
@@ -301,6 +302,12 @@ MppBufferType mpp_buffer_group_type(MppBufferGroup group);
  */
 MPP_RET mpp_buffer_group_limit_config(MppBufferGroup group, size_t size, RK_S32 count);
 
+/*
+ * allocate count unused buffers of size into an internal group ahead of time
+ * so that the first mpp_buffer_get calls do not hit the allocator
+ */
+MPP_RET mpp_buffer_group_prealloc(MppBufferGroup group, size_t size, RK_S32 count);
+
 #ifdef __cplusplus
 }
 #endif
@@ -285,6 +285,18 @@ void    mpp_frame_set_buffer(MppFrame frame, MppBuffer buffer);
 MppMeta mpp_frame_get_meta(const MppFrame frame);
 void    mpp_frame_set_meta(MppFrame frame, MppMeta meta);
 
+/*
+ * release notification for caller owned frame
+ *
+ * The callback is called once from mpp_frame_deinit before the buffer
+ * reference is dropped. Encoder with asynchronous put_frame releases the
+ * input frame as soon as it is encoded, so the callback tells the caller
+ * when the input buffer can be refilled. Copies do not take the callback.
+ */
+typedef void (*MppFrameReleaseCb)(void *arg, MppFrame frame);
+
+MPP_RET mpp_frame_set_release(MppFrame frame, MppFrameReleaseCb cb, void *arg);
+
 /*
  * color related parameter
  */
@@ -70,6 +70,20 @@ MPP_RET mpp_packet_set_extra_data(MppPacket packet);
 void        mpp_packet_set_buffer(MppPacket packet, MppBuffer buffer);
 MppBuffer   mpp_packet_get_buffer(const MppPacket packet);
 
+/*
+ * zero copy input for caller owned data
+ *
+ * When a release callback is set, mpp_packet_copy_init (and so decoder
+ * put_packet) takes over the data by reference instead of copying it and
+ * moves the callback to the new packet. The callback is called with data
+ * when the last packet owning it is deinit. The data must stay valid until
+ * then and should have 256 readable bytes after the valid length like the
+ * copied packets have, because parsers may read a few bytes past the end.
+ */
+typedef void (*MppPacketReleaseCb)(void *arg, void *data);
+
+MPP_RET mpp_packet_set_release(MppPacket packet, MppPacketReleaseCb cb, void *arg);
+
 /*
  * data access interface
  */
@@ -159,9 +159,23 @@ typedef struct MppApi_t {
     MPP_RET (*control)(MppCtx ctx, MpiCmd cmd, MppParam param);
 
     /**
-     * @brief The reserved segment
+     * @brief send several video stream packets to decoder under one queue
+     *        lock and one decoder wake up, async interface
+     * @param ctx The context of mpp
+     * @param packets The input video streams in decoding order
+     * @param count The number of packets
+     * @param sent[out] The number of packets taken, can be NULL
+     * @return 0 for all packets sent, MPP_ERR_BUFFER_FULL or MPP_ERR_TIMEOUT
+     *         when the input queue filled up before all packets were taken
+     */
+    MPP_RET (*decode_put_packets)(MppCtx ctx, MppPacket *packets, RK_S32 count,
+                                  RK_S32 *sent);
+
+    /**
+     * @brief The reserved segment, shrunk by the pointers added above so that
+     *        the struct size stays the same for prebuilt callers
      */
-    RK_U32 reserv[16];
+    RK_U32 reserv[16 - sizeof(void *) / sizeof(RK_U32)];
 } MppApi;
 
 
@@ -72,6 +72,21 @@ typedef enum {
      */
     MPP_SET_INPUT_TIMEOUT,              /* parameter type RK_S64 */
     MPP_SET_OUTPUT_TIMEOUT,             /* parameter type RK_S64 */
+    /*
+     * decoder - packet queue depth, default 4
+     * encoder - set before init to make put_frame asynchronous with up to
+     *           depth frames in flight. The input frame is released when it
+     *           is encoded, see mpp_frame_set_release.
+     */
+    MPP_SET_INPUT_DEPTH,                /* parameter type RK_U32 */
+    /*
+     * eventfd for poll / epoll, readable while the port is ready:
+     * input  - decoder packet queue has room
+     * output - decoded frame is waiting
+     * The fd is owned by mpp and closed on mpp_destroy.
+     */
+    MPP_GET_INPUT_EVENT_FD,             /* parameter type RK_S32 */
+    MPP_GET_OUTPUT_EVENT_FD,            /* parameter type RK_S32 */
     MPP_CMD_END,
 
     MPP_CODEC_CMD_BASE                  = CMD_MODULE_CODEC,
@@ -117,6 +132,8 @@ typedef enum {
     MPP_ENC_SET_QP_RANGE,               /* used for adjusting qp range, the parameter can be 1 or 2 */
     MPP_ENC_SET_ROI_CFG,                /* set MppEncROICfg structure */
     MPP_ENC_SET_CTU_QP,                 /* for H265 Encoder,set CTU's size and QP */
+    MPP_ENC_SET_HAL_BACKEND,            /* select soft / remote encoder backend by name, parameter is const char * */
+    MPP_ENC_GET_RC_TRACE,               /* dump rate control trace into MppPacket provided by user, replay with rc_trace_test */
 
     MPP_ENC_CFG_RC                      = CMD_MODULE_CODEC | CMD_CTX_ID_ENC | CMD_ENC_CFG_RC,
     MPP_ENC_SET_RC,                     /* set MppEncRcCfg structure */
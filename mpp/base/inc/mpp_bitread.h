@@ -116,6 +116,8 @@ typedef struct bitread_ctx_t {
     // ctx
     MPP_RET   ret;
     RK_S32    need_prevention_detection;
+    // End of the bytes known to hold no emulation prevention byte
+    RK_U8    *epb_free_end;
 } BitReadCtx_t;
 
 
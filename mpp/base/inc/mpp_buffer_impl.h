@@ -17,6 +17,8 @@
 #ifndef __MPP_BUFFER_IMPL_H__
 #define __MPP_BUFFER_IMPL_H__
 
+#include <pthread.h>
+
 #include "mpp_list.h"
 #include "mpp_common.h"
 #include "mpp_allocator.h"
@@ -28,6 +30,14 @@
 #define MPP_BUF_DBG_DUMP_ON_EXIT        (0x00000020)
 #define MPP_BUF_DBG_CHECK_SIZE          (0x00000100)
 
+/*
+ * unused buffers are kept in power of two size classes:
+ * class 0 holds size <= 4K, class n holds (2K << n, 4K << n]
+ * and the last class holds everything larger
+ */
+#define MPP_BUFFER_SIZE_CLASS_MIN       (12)
+#define MPP_BUFFER_SIZE_CLASS_COUNT     (16)
+
 #define mpp_buf_dbg(flag, fmt, ...)     _mpp_dbg(mpp_buffer_debug, flag, fmt, ## __VA_ARGS__)
 #define mpp_buf_dbg_f(flag, fmt, ...)   _mpp_dbg_f(mpp_buffer_debug, flag, fmt, ## __VA_ARGS__)
 
@@ -45,6 +55,8 @@ struct MppBufferImpl_t {
     char                tag[MPP_TAG_SIZE];
     const char          *caller;
     RK_U32              group_id;
+    // group lives until its last buffer is gone (orphan mode)
+    MppBufferGroupImpl  *group;
     RK_S32              buffer_id;
     MppBufferMode       mode;
 
@@ -59,6 +71,7 @@ struct MppBufferImpl_t {
     // used flag is for used/unused list detection
     RK_U32              used;
     RK_U32              internal;
+    // atomic, changes to and from zero are done under group lock
     RK_S32              ref_count;
     struct list_head    list_status;
 };
@@ -73,6 +86,7 @@ struct MppBufferGroupImpl_t {
     size_t              limit_size;
     RK_S32              limit_count;
     // status record
+    // high water mark of usage, undersized unused buffers are freed above it
     size_t              limit;
     size_t              usage;
     RK_S32              buffer_id;
@@ -80,6 +94,12 @@ struct MppBufferGroupImpl_t {
     RK_S32              count_used;
     RK_S32              count_unused;
 
+    // allocation and reuse statistics
+    RK_U32              stat_get;
+    RK_U32              stat_reuse;
+    RK_U32              stat_alloc;
+    RK_U32              stat_free;
+
     MppAllocator        allocator;
     MppAllocatorApi     *alloc_api;
 
@@ -91,6 +111,11 @@ struct MppBufferGroupImpl_t {
     RK_U32              clear_on_exit;
     // is_orphan: 0 - normal group 1 - orphan group
     RK_U32              is_orphan;
+    // misc group releases buffer on last put instead of keeping it unused
+    RK_U32              is_misc;
+
+    // protect buffer lists, counters and logs of this group
+    pthread_mutex_t     lock;
 
     // buffer log function
     RK_U32              log_runtime_en;
@@ -103,7 +128,7 @@ struct MppBufferGroupImpl_t {
 
     // link to list_status in MppBufferImpl
     struct list_head    list_used;
-    struct list_head    list_unused;
+    struct list_head    list_unused[MPP_BUFFER_SIZE_CLASS_COUNT];
 };
 
 #ifdef __cplusplus
@@ -121,9 +146,12 @@ extern RK_U32 mpp_buffer_debug;
  *                            It required map to access. This is an optimization
  *                            for reducing virtual memory usage.
  *
- *  mpp_buffer_get_unused   : get unused buffer with size. it will first search
- *                            the unused list. if failed it will create on from
- *                            group allocator.
+ *  mpp_buffer_get_unused   : get unused buffer with size. it searches the size
+ *                            class of the request for the best fit then takes
+ *                            any buffer of a larger class. on miss in internal
+ *                            mode it frees unused buffers only when the group
+ *                            is at its count limit or over its high water mark
+ *                            so the caller can create a new one.
  *
  *  mpp_buffer_ref_inc      : increase buffer's reference counter. if it is unused
  *                            then it will be moved to used list.
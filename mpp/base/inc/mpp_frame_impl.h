@@ -108,6 +108,12 @@ struct MppFrameImpl_t {
      * pointer for multiple frame output at one time
      */
     MppFrameImpl    *next;
+
+    /*
+     * caller callback on frame release, not taken over by copies
+     */
+    MppFrameReleaseCb   release;
+    void                *release_arg;
 };
 
 
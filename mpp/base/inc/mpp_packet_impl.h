@@ -17,7 +17,7 @@
 #ifndef __MPP_PACKET_IMPL_H__
 #define __MPP_PACKET_IMPL_H__
 
-#include "mpp_meta.h"
+#include "mpp_packet.h"
 
 #define MPP_PACKET_FLAG_EOS             (0x00000001)
 #define MPP_PACKET_FLAG_EXTRA_DATA      (0x00000002)
@@ -49,6 +49,10 @@ typedef struct MppPacketImpl_t {
 
     MppBuffer   buffer;
     MppMeta     meta;
+
+    // owner of caller data for zero copy input
+    MppPacketReleaseCb  release;
+    void                *release_arg;
 } MppPacketImpl;
 
 #ifdef __cplusplus
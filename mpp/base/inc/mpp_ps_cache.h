@@ -0,0 +1,80 @@
+/*
+ * Copyright 2015 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __MPP_PS_CACHE_H__
+#define __MPP_PS_CACHE_H__
+
+#include "rk_type.h"
+#include "mpp_err.h"
+
+/*
+ * Parameter set cache of one decoder
+ *
+ * Keeps the raw nal of the parameter set last parsed for each id so that a
+ * byte identical re-send, like the headers repeated before every idr, is
+ * found by its hash and the parser can skip it without any allocation.
+ *
+ * The levels depend on each other in order: a set which really changes
+ * drops the cached sets of all higher levels, so they are parsed again
+ * against the new one.
+ */
+typedef void* MppPsCache;
+
+typedef enum MppPsType_e {
+    MPP_PS_VPS,
+    MPP_PS_SPS,
+    MPP_PS_PPS,
+    MPP_PS_TYPE_BUTT,
+} MppPsType;
+
+typedef struct MppPsCacheStat_t {
+    RK_U32          hit;
+    RK_U32          miss;
+} MppPsCacheStat;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * max_ids gives the id count of each type, 0 for an unused type.
+ * Env mpp_ps_cache=0 disables the cache, every set is then parsed.
+ */
+MPP_RET mpp_ps_cache_init(MppPsCache *cache, const char *name,
+                          const RK_S32 max_ids[MPP_PS_TYPE_BUTT]);
+MPP_RET mpp_ps_cache_deinit(MppPsCache cache);
+
+/*
+ * Look up a nal with the same bytes as a cached one and count a hit or miss
+ * return its id, or -1 when the nal has to be parsed
+ */
+RK_S32 mpp_ps_cache_find(MppPsCache cache, MppPsType type,
+                         const RK_U8 *nal, RK_S32 size);
+
+/* remember the nal just parsed into id, the copy is grown only */
+MPP_RET mpp_ps_cache_update(MppPsCache cache, MppPsType type, RK_S32 id,
+                            const RK_U8 *nal, RK_S32 size);
+
+/* forget the set of id, or of all ids of type with id -1 */
+void mpp_ps_cache_drop(MppPsCache cache, MppPsType type, RK_S32 id);
+
+MPP_RET mpp_ps_cache_get_stat(MppPsCache cache, MppPsType type, MppPsCacheStat *stat);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*__MPP_PS_CACHE_H__*/
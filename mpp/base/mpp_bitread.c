@@ -21,6 +21,98 @@
 #include "mpp_mem.h"
 #include "mpp_bitread.h"
 
+static RK_U64 load_be64(const RK_U8 *p)
+{
+    RK_U64 v;
+
+    memcpy(&v, p, sizeof(v));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+/*
+ * Locate the next emulation prevention byte from the read position with a
+ * memchr pass, the bytes before it can then be loaded without checking.
+ */
+static void update_epb_free_end(BitReadCtx_t *bitctx)
+{
+    RK_U8 *p = bitctx->data_;
+    RK_U8 *end = p + bitctx->bytes_left_;
+    RK_U32 prev = (RK_U32)(bitctx->prev_two_bytes_ & 0xffff);
+    RK_S32 i;
+
+    // the first two depend on bytes already read or an epb just skipped
+    for (i = 0; i < 2 && p < end; i++, p++) {
+        if (*p == 0x03 && !prev)
+            goto DONE;
+        prev = ((prev << 8) | *p) & 0xffff;
+    }
+
+    while (p < end) {
+        p = memchr(p, 0x03, end - p);
+        if (NULL == p) {
+            p = end;
+            break;
+        }
+        if (!p[-1] && !p[-2])
+            break;
+        p++;
+    }
+DONE:
+    bitctx->epb_free_end = p;
+}
+
+/*
+ * Get the next 64 bits left aligned without touching the read position.
+ * Only possible with 8 bytes left and no emulation prevention byte among
+ * them, otherwise the byte wise path below is used.
+ */
+static inline RK_U32 peek_window(BitReadCtx_t *bitctx, RK_U64 *win)
+{
+    RK_S32 rest = bitctx->num_remaining_bits_in_curr_byte_;
+    RK_U64 raw;
+
+    if (bitctx->bytes_left_ < 8)
+        return 0;
+
+    if (bitctx->need_prevention_detection &&
+        bitctx->data_ + 8 > bitctx->epb_free_end) {
+        update_epb_free_end(bitctx);
+        if (bitctx->data_ + 8 > bitctx->epb_free_end)
+            return 0;
+    }
+
+    raw = load_be64(bitctx->data_);
+    *win = rest ? (((RK_U64)bitctx->curr_byte_ << (64 - rest)) | (raw >> rest)) : raw;
+    return 1;
+}
+
+/* consume num_bits (1 to 64) of a window returned by peek_window */
+static inline void skip_window(BitReadCtx_t *bitctx, RK_S32 num_bits)
+{
+    RK_S32 more = num_bits - bitctx->num_remaining_bits_in_curr_byte_;
+    RK_S32 bytes;
+    RK_U8 *p;
+
+    bitctx->used_bits += num_bits;
+    if (more <= 0) {
+        bitctx->num_remaining_bits_in_curr_byte_ -= num_bits;
+        return;
+    }
+
+    bytes = (more + 7) >> 3;
+    p = bitctx->data_ + bytes;
+    bitctx->data_ = p;
+    bitctx->bytes_left_ -= bytes;
+    bitctx->curr_byte_ = p[-1];
+    bitctx->num_remaining_bits_in_curr_byte_ = bytes * 8 - more;
+    if (bytes > 1)
+        bitctx->prev_two_bytes_ = (p[-2] << 8) | p[-1];
+    else
+        bitctx->prev_two_bytes_ = (bitctx->prev_two_bytes_ << 8) | p[-1];
+}
 
 static MPP_RET update_curbyte(BitReadCtx_t *bitctx)
 {
@@ -50,21 +142,11 @@ static MPP_RET update_curbyte(BitReadCtx_t *bitctx)
     return MPP_OK;
 }
 
-/*!
-***********************************************************************
-* \brief
-*   Read |num_bits| (1 to 31 inclusive) from the stream and return them
-*   in |out|, with first bit in the stream as MSB in |out| at position
-*   (|num_bits| - 1)
-***********************************************************************
-*/
-MPP_RET mpp_read_bits(BitReadCtx_t *bitctx, RK_S32 num_bits, RK_S32 *out)
+/* refill byte by byte, drops emulation prevention bytes on the way */
+static MPP_RET read_bits_bytewise(BitReadCtx_t *bitctx, RK_S32 num_bits, RK_S32 *out)
 {
     RK_S32 bits_left = num_bits;
-    *out = 0;
-    if (num_bits > 31) {
-        return  MPP_ERR_READ_BIT;
-    }
+
     while (bitctx->num_remaining_bits_in_curr_byte_ < bits_left) {
         // Take all that's left in current byte, shift to make space for the rest.
         *out |= (bitctx->curr_byte_ << (bits_left - bitctx->num_remaining_bits_in_curr_byte_));
@@ -83,6 +165,39 @@ MPP_RET mpp_read_bits(BitReadCtx_t *bitctx, RK_S32 num_bits, RK_S32 *out)
 /*!
 ***********************************************************************
 * \brief
+*   Read |num_bits| (1 to 31 inclusive) from the stream and return them
+*   in |out|, with first bit in the stream as MSB in |out| at position
+*   (|num_bits| - 1)
+***********************************************************************
+*/
+MPP_RET mpp_read_bits(BitReadCtx_t *bitctx, RK_S32 num_bits, RK_S32 *out)
+{
+    RK_U64 win;
+
+    *out = 0;
+    if (num_bits > 31) {
+        return  MPP_ERR_READ_BIT;
+    }
+    if (num_bits <= bitctx->num_remaining_bits_in_curr_byte_) {
+        bitctx->num_remaining_bits_in_curr_byte_ -= num_bits;
+        *out = (bitctx->curr_byte_ >> bitctx->num_remaining_bits_in_curr_byte_) &
+               ((1 << num_bits) - 1);
+        bitctx->used_bits += num_bits;
+        return MPP_OK;
+    }
+    // a single byte refill is cheaper done directly
+    if (num_bits - bitctx->num_remaining_bits_in_curr_byte_ > 8 &&
+        peek_window(bitctx, &win)) {
+        *out = (RK_S32)(win >> (64 - num_bits));
+        skip_window(bitctx, num_bits);
+        return MPP_OK;
+    }
+
+    return read_bits_bytewise(bitctx, num_bits, out);
+}
+/*!
+***********************************************************************
+* \brief
 *   read more than 32 bits data
 ***********************************************************************
 */
@@ -113,7 +228,13 @@ MPP_RET mpp_read_longbits(BitReadCtx_t *bitctx, RK_S32 num_bits, RK_U32 *out)
 MPP_RET mpp_skip_bits(BitReadCtx_t *bitctx, RK_S32 num_bits)
 {
     RK_S32 bits_left = num_bits;
+    RK_U64 win;
 
+    if (num_bits - bitctx->num_remaining_bits_in_curr_byte_ > 8 && num_bits <= 56 &&
+        peek_window(bitctx, &win)) {
+        skip_window(bitctx, num_bits);
+        return MPP_OK;
+    }
     while (bitctx->num_remaining_bits_in_curr_byte_ < bits_left) {
         // Take all that's left in current byte, shift to make space for the rest.
         bits_left -= bitctx->num_remaining_bits_in_curr_byte_;
@@ -186,6 +307,17 @@ MPP_RET mpp_read_ue(BitReadCtx_t *bitctx, RK_U32 *val)
     RK_S32 num_bits = -1;
     RK_S32 bit;
     RK_S32 rest;
+    RK_U64 win;
+
+    // Whole code in the window: prefix length by clz, value in one shift.
+    if (peek_window(bitctx, &win) && (win >> 32)) {
+        RK_S32 len = 2 * __builtin_clzll(win) + 1;
+
+        *val = (RK_U32)((win >> (64 - len)) - 1);
+        skip_window(bitctx, len);
+        return MPP_OK;
+    }
+
     // Count the number of contiguous zero bits.
     do {
         if (mpp_read_bits(bitctx, 1, &bit)) {
@@ -35,10 +35,10 @@ MPP_RET mpp_buffer_group_share(MppBufferGroup group, unsigned int cmd, unsigned
         // p = mpp_buffer_get_misc_group(MPP_BUFFER_INTERNAL, MPP_BUFFER_TYPE_ION);
         p = mpp_buffer_get_misc_group(MPP_BUFFER_EXTERNAL, MPP_BUFFER_TYPE_ION);
     }
-    
+
     mpp_assert(p);
 
-    // pre-open ion device 
+    // pre-open ion device
     MppBuffer buff;
     if (MPP_OK == (ret = mpp_buffer_get(p, &buff, 1024))) {
         mpp_buffer_put(buff);
@@ -385,3 +385,31 @@ MPP_RET mpp_buffer_group_limit_config(MppBufferGroup group, size_t size, RK_S32
     return MPP_OK;
 }
 
+MPP_RET mpp_buffer_group_prealloc(MppBufferGroup group, size_t size, RK_S32 count)
+{
+    if (NULL == group || 0 == size) {
+        mpp_err_f("input invalid group %p size %d\n", group, size);
+        return MPP_NOK;
+    }
+
+    MppBufferGroupImpl *p = (MppBufferGroupImpl *)group;
+    if (p->mode != MPP_BUFFER_INTERNAL) {
+        mpp_err_f("can not prealloc on external group %p\n", group);
+        return MPP_NOK;
+    }
+
+    for (RK_S32 i = 0; i < count; i++) {
+        MppBufferInfo info = {
+            p->type,
+            size,
+            NULL,
+            NULL,
+            -1,
+            -1,
+        };
+        MPP_RET ret = mpp_buffer_create(NULL, __FUNCTION__, p, &info, NULL);
+        if (ret)
+            return ret;
+    }
+    return MPP_OK;
+}
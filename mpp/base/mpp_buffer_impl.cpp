@@ -26,8 +26,6 @@
 
 #define BUFFER_OPS_MAX_COUNT            1024
 
-#define SEARCH_GROUP_BY_ID(id)  ((MppBufferService::get_instance())->get_group_by_id(id))
-
 typedef MPP_RET (*BufferOp)(MppAllocator allocator, MppBufferInfo *data);
 
 typedef enum MppBufOps_e {
@@ -57,6 +55,15 @@ typedef struct MppBufLog_t {
     const char          *caller;
 } MppBufLog;
 
+/*
+ * Locking:
+ * The service lock protects the group lists, group ids and misc groups.
+ * Each group lock protects the buffer lists, counters and logs of its group.
+ * When both are needed the service lock is taken first.
+ * A buffer ref_count is atomic. Only changes to and from zero need the group
+ * lock, so sharing an in-use buffer does not serialize different sessions.
+ */
+
 // use this class only need it to init legacy group before main
 class MppBufferService
 {
@@ -193,41 +200,135 @@ static void buffer_group_dump_log(MppBufferGroupImpl *group)
     }
 }
 
-static MPP_RET deinit_buffer_no_lock(MppBufferImpl *buffer, const char *caller)
+static void group_lock_init(MppBufferGroupImpl *group)
 {
+    pthread_mutexattr_t attr;
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&group->lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+/*
+ * Called with group lock held.
+ * return 1 when the buffer was the last one of an orphan group and the group
+ * should be released by the caller once the group lock is dropped
+ */
+static RK_U32 deinit_buffer_no_lock(MppBufferImpl *buffer, const char *caller)
+{
+    MppBufferGroupImpl *group = buffer->group;
+
     if (!MppBufferService::get_instance()->is_finalizing()) {
         mpp_assert(buffer->ref_count == 0);
         mpp_assert(buffer->used == 0);
     }
 
     list_del_init(&buffer->list_status);
-    MppBufferGroupImpl *group = SEARCH_GROUP_BY_ID(buffer->group_id);
-    if (group) {
-        BufferOp func = (group->mode == MPP_BUFFER_INTERNAL) ?
-                        (group->alloc_api->free) :
-                        (group->alloc_api->release);
-        func(group->allocator, &buffer->info);
-        group->usage -= buffer->info.size;
-        group->buffer_count--;
-
-        buffer_group_add_log(group, buffer, BUF_DESTROY, caller);
-
-        if (group->is_orphan && !group->usage) {
-            MppBufferService::get_instance()->put_group(group);
+
+    BufferOp func = (group->mode == MPP_BUFFER_INTERNAL) ?
+                    (group->alloc_api->free) :
+                    (group->alloc_api->release);
+    func(group->allocator, &buffer->info);
+    group->usage -= buffer->info.size;
+    group->buffer_count--;
+
+    group->stat_free++;
+
+    buffer_group_add_log(group, buffer, BUF_DESTROY, caller);
+
+    mpp_free(buffer);
+
+    return (group->is_orphan && !group->usage) ? (1) : (0);
+}
+
+static RK_U32 buffer_size_class(size_t size)
+{
+    size_t max = (size_t)1 << MPP_BUFFER_SIZE_CLASS_MIN;
+    RK_U32 cls = 0;
+
+    while (size > max && cls < MPP_BUFFER_SIZE_CLASS_COUNT - 1) {
+        max <<= 1;
+        cls++;
+    }
+    return cls;
+}
+
+static void add_unused_no_lock(MppBufferGroupImpl *group, MppBufferImpl *buffer)
+{
+    list_add_tail(&buffer->list_status,
+                  &group->list_unused[buffer_size_class(buffer->info.size)]);
+    group->count_unused++;
+}
+
+static void free_unused_no_lock(MppBufferGroupImpl *group, const char *caller)
+{
+    RK_U32 i;
+
+    for (i = 0; i < MPP_BUFFER_SIZE_CLASS_COUNT; i++) {
+        MppBufferImpl *pos, *n;
+        list_for_each_entry_safe(pos, n, &group->list_unused[i], MppBufferImpl, list_status) {
+            deinit_buffer_no_lock(pos, caller);
+            group->count_unused--;
         }
-    } else {
-        mpp_assert(MppBufferService::get_instance()->is_finalizing());
     }
+}
 
-    mpp_free(buffer);
+/*
+ * Make room for a new buffer of size. Unused buffers are only freed when
+ * the group is at its count limit or over its usage high water mark, and
+ * the smallest ones go first.
+ */
+static void evict_unused_no_lock(MppBufferGroupImpl *group, size_t size)
+{
+    RK_U32 i = 0;
 
-    return MPP_OK;
+    while (group->count_unused && i < MPP_BUFFER_SIZE_CLASS_COUNT) {
+        if (!(group->limit_count && group->buffer_count >= group->limit_count) &&
+            group->usage + size <= group->limit)
+            break;
+
+        if (list_empty(&group->list_unused[i])) {
+            i++;
+            continue;
+        }
+
+        deinit_buffer_no_lock(list_entry(group->list_unused[i].next,
+                                         MppBufferImpl, list_status), __FUNCTION__);
+        group->count_unused--;
+    }
+}
+
+// ref_count + 1 without group lock when the buffer is already in use
+static RK_U32 try_inc_buffer_ref(MppBufferImpl *buffer)
+{
+    RK_S32 ref = __atomic_load_n(&buffer->ref_count, __ATOMIC_RELAXED);
+
+    while (ref > 0) {
+        if (__atomic_compare_exchange_n(&buffer->ref_count, &ref, ref + 1, 1,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+            return 1;
+    }
+    return 0;
+}
+
+// ref_count - 1 without group lock when it does not drop to zero
+static RK_U32 try_dec_buffer_ref(MppBufferImpl *buffer)
+{
+    RK_S32 ref = __atomic_load_n(&buffer->ref_count, __ATOMIC_RELAXED);
+
+    while (ref > 1) {
+        if (__atomic_compare_exchange_n(&buffer->ref_count, &ref, ref - 1, 1,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+            return 1;
+    }
+    return 0;
 }
 
 static MPP_RET inc_buffer_ref_no_lock(MppBufferImpl *buffer, const char *caller)
 {
     MPP_RET ret = MPP_OK;
-    MppBufferGroupImpl *group = SEARCH_GROUP_BY_ID(buffer->group_id);
+    MppBufferGroupImpl *group = buffer->group;
     if (!buffer->used) {
         // NOTE: when increasing ref_count the unused buffer must be under certain group
         mpp_assert(group);
@@ -243,7 +344,7 @@ static MPP_RET inc_buffer_ref_no_lock(MppBufferImpl *buffer, const char *caller)
         }
     }
     buffer_group_add_log(group, buffer, BUF_REF_INC, caller);
-    buffer->ref_count++;
+    __atomic_add_fetch(&buffer->ref_count, 1, __ATOMIC_ACQ_REL);
     return ret;
 }
 
@@ -258,7 +359,6 @@ MPP_RET mpp_buffer_create(const char *tag, const char *caller,
                           MppBufferGroupImpl *group, MppBufferInfo *info,
                           MppBufferImpl **buffer)
 {
-    AutoMutex auto_lock(MppBufferService::get_lock());
     MPP_BUF_FUNCTION_ENTER();
 
     MPP_RET ret = MPP_OK;
@@ -267,10 +367,12 @@ MPP_RET mpp_buffer_create(const char *tag, const char *caller,
 
     if (NULL == group) {
         mpp_err_f("can not create buffer without group\n");
-        ret = MPP_NOK;
-        goto RET;
+        MPP_BUF_FUNCTION_LEAVE();
+        return MPP_NOK;
     }
 
+    pthread_mutex_lock(&group->lock);
+
     if (group->limit_count && group->buffer_count >= group->limit_count) {
         if (group->log_runtime_en)
             mpp_log_f("group %d reach count limit %d\n", group->group_id, group->limit_count);
@@ -310,14 +412,15 @@ MPP_RET mpp_buffer_create(const char *tag, const char *caller,
     strncpy(p->tag, tag, sizeof(p->tag));
     p->caller = caller;
     p->group_id = group->group_id;
+    p->group = group;
     p->buffer_id = group->buffer_id;
     INIT_LIST_HEAD(&p->list_status);
-    list_add_tail(&p->list_status, &group->list_unused);
+    add_unused_no_lock(group, p);
 
     group->buffer_id++;
     group->usage += info->size;
     group->buffer_count++;
-    group->count_unused++;
+    group->stat_alloc++;
 
     buffer_group_add_log(group, p,
                          (group->mode == MPP_BUFFER_INTERNAL) ? (BUF_CREATE) : (BUF_COMMIT),
@@ -331,22 +434,24 @@ MPP_RET mpp_buffer_create(const char *tag, const char *caller,
     if (group->callback)
         group->callback(group->arg, group);
 RET:
+    pthread_mutex_unlock(&group->lock);
     MPP_BUF_FUNCTION_LEAVE();
     return ret;
 }
 
 MPP_RET mpp_buffer_mmap(MppBufferImpl *buffer, const char* caller)
 {
-    AutoMutex auto_lock(MppBufferService::get_lock());
     MPP_BUF_FUNCTION_ENTER();
 
     MPP_RET ret = MPP_NOK;
-    MppBufferGroupImpl *group = SEARCH_GROUP_BY_ID(buffer->group_id);
+    MppBufferGroupImpl *group = buffer->group;
 
     if (group && group->alloc_api && group->alloc_api->mmap) {
+        pthread_mutex_lock(&group->lock);
         ret = group->alloc_api->mmap(group->allocator, &buffer->info);
 
         buffer_group_add_log(group, buffer, BUF_MMAP, caller);
+        pthread_mutex_unlock(&group->lock);
     }
 
     if (ret)
@@ -359,50 +464,65 @@ MPP_RET mpp_buffer_mmap(MppBufferImpl *buffer, const char* caller)
 
 MPP_RET mpp_buffer_ref_inc(MppBufferImpl *buffer, const char* caller)
 {
-    AutoMutex auto_lock(MppBufferService::get_lock());
+    MppBufferGroupImpl *group = buffer->group;
+    MPP_RET ret = MPP_OK;
+
     MPP_BUF_FUNCTION_ENTER();
 
-    MPP_RET ret = inc_buffer_ref_no_lock(buffer, caller);
+    // the logs need the group lock to keep them in order
+    if (group->log_runtime_en || group->log_history_en ||
+        !try_inc_buffer_ref(buffer)) {
+        pthread_mutex_lock(&group->lock);
+        ret = inc_buffer_ref_no_lock(buffer, caller);
+        pthread_mutex_unlock(&group->lock);
+    }
 
     MPP_BUF_FUNCTION_LEAVE();
     return ret;
 }
 
-
 MPP_RET mpp_buffer_ref_dec(MppBufferImpl *buffer, const char* caller)
 {
-    AutoMutex auto_lock(MppBufferService::get_lock());
+    MppBufferGroupImpl *group = buffer->group;
+    MPP_RET ret = MPP_OK;
+    RK_U32 release = 0;
+
     MPP_BUF_FUNCTION_ENTER();
 
-    MPP_RET ret = MPP_OK;
-    MppBufferGroupImpl *group = SEARCH_GROUP_BY_ID(buffer->group_id);
-    if (group)
-        buffer_group_add_log(group, buffer, BUF_REF_DEC, caller);
+    if (!group->log_runtime_en && !group->log_history_en &&
+        try_dec_buffer_ref(buffer)) {
+        MPP_BUF_FUNCTION_LEAVE();
+        return MPP_OK;
+    }
+
+    pthread_mutex_lock(&group->lock);
+
+    buffer_group_add_log(group, buffer, BUF_REF_DEC, caller);
 
     if (buffer->ref_count <= 0) {
         mpp_err_f("found non-positive ref_count %d caller %s\n",
                   buffer->ref_count, buffer->caller);
         mpp_abort();
         ret = MPP_NOK;
-    } else {
-        buffer->ref_count--;
-        if (0 == buffer->ref_count) {
-            buffer->used = 0;
-            list_del_init(&buffer->list_status);
-            if (group == MppBufferService::get_instance()->get_misc(group->mode, group->type)) {
-                deinit_buffer_no_lock(buffer, caller);
-            } else {
-                if (buffer->discard) {
-                    deinit_buffer_no_lock(buffer, caller);
-                } else {
-                    list_add_tail(&buffer->list_status, &group->list_unused);
-                    group->count_unused++;
-                }
-            }
-            group->count_used--;
-            if (group->callback)
-                group->callback(group->arg, group);
+    } else if (0 == __atomic_sub_fetch(&buffer->ref_count, 1, __ATOMIC_ACQ_REL)) {
+        buffer->used = 0;
+        list_del_init(&buffer->list_status);
+        if (group->is_misc || buffer->discard) {
+            release = deinit_buffer_no_lock(buffer, caller);
+        } else {
+            add_unused_no_lock(group, buffer);
         }
+        group->count_used--;
+        if (group->callback)
+            group->callback(group->arg, group);
+    }
+
+    pthread_mutex_unlock(&group->lock);
+
+    // last buffer of an orphan group is gone, release the group itself
+    if (release) {
+        AutoMutex auto_lock(MppBufferService::get_lock());
+        MppBufferService::get_instance()->put_group(group);
     }
 
     MPP_BUF_FUNCTION_LEAVE();
@@ -411,37 +531,44 @@ MPP_RET mpp_buffer_ref_dec(MppBufferImpl *buffer, const char* caller)
 
 MppBufferImpl *mpp_buffer_get_unused(MppBufferGroupImpl *p, size_t size)
 {
-    AutoMutex auto_lock(MppBufferService::get_lock());
     MPP_BUF_FUNCTION_ENTER();
 
     MppBufferImpl *buffer = NULL;
+    MppBufferImpl *pos;
+    RK_U32 cls = buffer_size_class(size);
+    RK_U32 i;
 
-    if (!list_empty(&p->list_unused)) {
-        MppBufferImpl *pos, *n;
-        RK_S32 found = 0;
-        RK_S32 search_count = 0;
-
-        list_for_each_entry_safe(pos, n, &p->list_unused, MppBufferImpl, list_status) {
-            mpp_buf_dbg(MPP_BUF_DBG_CHECK_SIZE, "request size %d on buf idx %d size %d\n",
-                        size, pos->buffer_id, pos->info.size);
-            if (pos->info.size >= size) {
-                buffer = pos;
-                inc_buffer_ref_no_lock(buffer, __FUNCTION__);
-                found = 1;
-                break;
-            } else {
-                if (MPP_BUFFER_INTERNAL == p->mode) {
-                    deinit_buffer_no_lock(pos, __FUNCTION__);
-                    p->count_unused--;
-                } else
-                    search_count++;
-            }
-        }
+    pthread_mutex_lock(&p->lock);
+
+    p->stat_get++;
 
-        if (!found && search_count)
-            mpp_err_f("can not found match buffer with size larger than %d\n", size);
+    // best fit in the class of the request size
+    list_for_each_entry(pos, &p->list_unused[cls], MppBufferImpl, list_status) {
+        mpp_buf_dbg(MPP_BUF_DBG_CHECK_SIZE, "request size %d on buf idx %d size %d\n",
+                    size, pos->buffer_id, pos->info.size);
+        if (pos->info.size >= size &&
+            (NULL == buffer || pos->info.size < buffer->info.size))
+            buffer = pos;
     }
 
+    // any buffer in a larger class is large enough
+    for (i = cls + 1; NULL == buffer && i < MPP_BUFFER_SIZE_CLASS_COUNT; i++) {
+        if (!list_empty(&p->list_unused[i]))
+            buffer = list_entry(p->list_unused[i].next, MppBufferImpl, list_status);
+    }
+
+    if (buffer) {
+        inc_buffer_ref_no_lock(buffer, __FUNCTION__);
+        p->stat_reuse++;
+    } else if (MPP_BUFFER_INTERNAL == p->mode) {
+        // caller will create a new one
+        evict_unused_no_lock(p, size);
+    } else if (p->count_unused) {
+        mpp_err_f("can not found match buffer with size larger than %d\n", size);
+    }
+
+    pthread_mutex_unlock(&p->lock);
+
     MPP_BUF_FUNCTION_LEAVE();
     return buffer;
 }
@@ -478,7 +605,6 @@ MPP_RET mpp_buffer_group_deinit(MppBufferGroupImpl *p)
 
 MPP_RET mpp_buffer_group_reset(MppBufferGroupImpl *p)
 {
-    AutoMutex auto_lock(MppBufferService::get_lock());
     if (NULL == p) {
         mpp_err_f("found NULL pointer\n");
         return MPP_ERR_NULL_PTR;
@@ -486,6 +612,8 @@ MPP_RET mpp_buffer_group_reset(MppBufferGroupImpl *p)
 
     MPP_BUF_FUNCTION_ENTER();
 
+    pthread_mutex_lock(&p->lock);
+
     buffer_group_add_log(p, NULL, GRP_RESET, NULL);
 
     if (!list_empty(&p->list_used)) {
@@ -497,13 +625,9 @@ MPP_RET mpp_buffer_group_reset(MppBufferGroupImpl *p)
     }
 
     // remove unused list
-    if (!list_empty(&p->list_unused)) {
-        MppBufferImpl *pos, *n;
-        list_for_each_entry_safe(pos, n, &p->list_unused, MppBufferImpl, list_status) {
-            deinit_buffer_no_lock(pos, __FUNCTION__);
-            p->count_unused--;
-        }
-    }
+    free_unused_no_lock(p, __FUNCTION__);
+
+    pthread_mutex_unlock(&p->lock);
 
     MPP_BUF_FUNCTION_LEAVE();
     return MPP_OK;
@@ -512,7 +636,6 @@ MPP_RET mpp_buffer_group_reset(MppBufferGroupImpl *p)
 MPP_RET mpp_buffer_group_set_callback(MppBufferGroupImpl *p,
                                       MppBufCallback callback, void *arg)
 {
-    AutoMutex auto_lock(MppBufferService::get_lock());
     if (NULL == p) {
         mpp_err_f("found NULL pointer\n");
         return MPP_ERR_NULL_PTR;
@@ -520,8 +643,10 @@ MPP_RET mpp_buffer_group_set_callback(MppBufferGroupImpl *p,
 
     MPP_BUF_FUNCTION_ENTER();
 
+    pthread_mutex_lock(&p->lock);
     p->callback = callback;
     p->arg      = arg;
+    pthread_mutex_unlock(&p->lock);
 
     MPP_BUF_FUNCTION_LEAVE();
     return MPP_OK;
@@ -529,6 +654,8 @@ MPP_RET mpp_buffer_group_set_callback(MppBufferGroupImpl *p,
 
 void mpp_buffer_group_dump(MppBufferGroupImpl *group, const char *caller)
 {
+    pthread_mutex_lock(&group->lock);
+
     mpp_log("\ndumping buffer group %p id %d from %s\n", group,
             group->group_id, caller);
     mpp_log("mode %s\n", mode2str[group->mode]);
@@ -538,16 +665,26 @@ void mpp_buffer_group_dump(MppBufferGroupImpl *group, const char *caller)
     mpp_log("used buffer count %d\n", group->count_used);
 
     MppBufferImpl *pos, *n;
+    RK_U32 i;
     list_for_each_entry_safe(pos, n, &group->list_used, MppBufferImpl, list_status) {
         dump_buffer_info(pos);
     }
 
     mpp_log("unused buffer count %d\n", group->count_unused);
-    list_for_each_entry_safe(pos, n, &group->list_unused, MppBufferImpl, list_status) {
-        dump_buffer_info(pos);
+    for (i = 0; i < MPP_BUFFER_SIZE_CLASS_COUNT; i++) {
+        list_for_each_entry_safe(pos, n, &group->list_unused[i], MppBufferImpl, list_status) {
+            dump_buffer_info(pos);
+        }
     }
 
+    mpp_log("get %u reuse %u hit rate %.1f%% alloc %u free %u\n",
+            group->stat_get, group->stat_reuse,
+            group->stat_get ? 100.0 * group->stat_reuse / group->stat_get : 0.0,
+            group->stat_alloc, group->stat_free);
+
     buffer_group_dump_log(group);
+
+    pthread_mutex_unlock(&group->lock);
 }
 
 void mpp_buffer_service_dump()
@@ -624,11 +761,20 @@ MppBufferService::~MppBufferService()
 
     // remove all orphan buffer
     if (!list_empty(&mListOrphan)) {
-        MppBufferImpl *pos, *n;
+        MppBufferGroupImpl *pos, *n;
 
         mpp_log_f("cleaning leaked buffer\n");
-        list_for_each_entry_safe(pos, n, &mListOrphan, MppBufferImpl, list_status) {
-            deinit_buffer_no_lock(pos, __FUNCTION__);
+        list_for_each_entry_safe(pos, n, &mListOrphan, MppBufferGroupImpl, list_group) {
+            MppBufferImpl *buf, *tmp;
+
+            pthread_mutex_lock(&pos->lock);
+            list_for_each_entry_safe(buf, tmp, &pos->list_used, MppBufferImpl, list_status) {
+                deinit_buffer_no_lock(buf, __FUNCTION__);
+                pos->count_used--;
+            }
+            pthread_mutex_unlock(&pos->lock);
+
+            destroy_group(pos);
         }
     }
 }
@@ -650,6 +796,7 @@ MppBufferGroupImpl *MppBufferService::get_group(const char *tag, const char *cal
 {
     MppBufferType buffer_type = (MppBufferType)(type & MPP_BUFFER_TYPE_MASK);
     MppBufferGroupImpl *p = mpp_calloc(MppBufferGroupImpl, 1);
+    RK_U32 i;
     if (NULL == p) {
         mpp_err("MppBufferService failed to allocate group context\n");
         return NULL;
@@ -660,7 +807,9 @@ MppBufferGroupImpl *MppBufferService::get_group(const char *tag, const char *cal
     INIT_LIST_HEAD(&p->list_logs);
     INIT_LIST_HEAD(&p->list_group);
     INIT_LIST_HEAD(&p->list_used);
-    INIT_LIST_HEAD(&p->list_unused);
+    for (i = 0; i < MPP_BUFFER_SIZE_CLASS_COUNT; i++)
+        INIT_LIST_HEAD(&p->list_unused[i]);
+    group_lock_init(p);
 
     mpp_env_get_u32("mpp_buffer_debug", &mpp_buffer_debug, 0);
     p->log_runtime_en   = (mpp_buffer_debug & MPP_BUF_DBG_OPS_RUNTIME) ? (1) : (0);
@@ -690,6 +839,8 @@ MppBufferGroupImpl *MppBufferService::get_group(const char *tag, const char *cal
     if (is_misc) {
         misc[mode][buffer_type] = p;
         misc_count++;
+        // normal type misc group is never found by get_misc so keeps its buffer
+        p->is_misc = (buffer_type != MPP_BUFFER_TYPE_NORMAL);
     }
 
     return p;
@@ -721,19 +872,17 @@ void MppBufferService::set_misc(MppBufferMode mode, MppBufferType type, MppBuffe
 
 void MppBufferService::put_group(MppBufferGroupImpl *p)
 {
+    RK_U32 destroy = 0;
+
+    pthread_mutex_lock(&p->lock);
+
     buffer_group_add_log(p, NULL, GRP_RELEASE, __FUNCTION__);
 
     // remove unused list
-    if (!list_empty(&p->list_unused)) {
-        MppBufferImpl *pos, *n;
-        list_for_each_entry_safe(pos, n, &p->list_unused, MppBufferImpl, list_status) {
-            deinit_buffer_no_lock(pos, __FUNCTION__);
-            p->count_unused--;
-        }
-    }
+    free_unused_no_lock(p, __FUNCTION__);
 
     if (list_empty(&p->list_used)) {
-        destroy_group(p);
+        destroy = 1;
     } else {
         if (!finalizing ||
             (finalizing && (mpp_buffer_debug & MPP_BUF_DBG_DUMP_ON_EXIT))) {
@@ -758,7 +907,7 @@ void MppBufferService::put_group(MppBufferGroupImpl *p)
                 p->count_used--;
             }
 
-            destroy_group(p);
+            destroy = 1;
         } else {
             // otherwise move the group to list_orphan and wait for buffer release
             buffer_group_add_log(p, NULL, GRP_ORPHAN, __FUNCTION__);
@@ -767,6 +916,11 @@ void MppBufferService::put_group(MppBufferGroupImpl *p)
             p->is_orphan = 1;
         }
     }
+
+    pthread_mutex_unlock(&p->lock);
+
+    if (destroy)
+        destroy_group(p);
 }
 
 void MppBufferService::destroy_group(MppBufferGroupImpl *group)
@@ -799,6 +953,7 @@ void MppBufferService::destroy_group(MppBufferGroupImpl *group)
     mpp_assert(group->allocator);
     mpp_allocator_put(&group->allocator);
     list_del_init(&group->list_group);
+    pthread_mutex_destroy(&group->lock);
     mpp_free(group);
     group_count--;
 
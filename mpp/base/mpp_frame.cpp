@@ -67,6 +67,9 @@ MPP_RET mpp_frame_deinit(MppFrame *frame)
     }
 
     MppFrameImpl *p = (MppFrameImpl *)*frame;
+    if (p->release)
+        p->release(p->release_arg, *frame);
+
     if (p->buffer)
         mpp_buffer_put(p->buffer);
 
@@ -161,6 +164,21 @@ MPP_RET mpp_frame_copy(MppFrame dst, MppFrame src)
     if (p->meta)
         mpp_meta_inc_ref(p->meta);
 
+    // only the caller's own frame reports its release
+    ((MppFrameImpl *)dst)->release = NULL;
+    ((MppFrameImpl *)dst)->release_arg = NULL;
+
+    return MPP_OK;
+}
+
+MPP_RET mpp_frame_set_release(MppFrame frame, MppFrameReleaseCb cb, void *arg)
+{
+    if (check_is_mpp_frame(frame))
+        return MPP_ERR_UNKNOW;
+
+    MppFrameImpl *p = (MppFrameImpl *)frame;
+    p->release = cb;
+    p->release_arg = arg;
     return MPP_OK;
 }
 
@@ -121,6 +121,10 @@ MPP_RET mpp_packet_copy_init(MppPacket *packet, const MppPacket src)
     if (src_impl->buffer) {
         /* if source packet has buffer just create a new reference to buffer */
         mpp_buffer_inc_ref(src_impl->buffer);
+    } else if (src_impl->release) {
+        /* caller data with release callback is moved instead of copied */
+        src_impl->release = NULL;
+        src_impl->release_arg = NULL;
     } else {
         /*
          * NOTE: only copy valid data
@@ -171,6 +175,9 @@ MPP_RET mpp_packet_deinit(MppPacket *packet)
     if (p->flag & MPP_PACKET_FLAG_INTERNAL)
         mpp_free(p->data);
 
+    if (p->release)
+        p->release(p->release_arg, p->data);
+
     if (p->meta)
         mpp_meta_put(p->meta);
 
@@ -258,16 +265,36 @@ MPP_RET mpp_packet_reset(MppPacketImpl *packet)
 
     void *data = packet->data;
     size_t size = packet->size;
+    MppPacketReleaseCb release = packet->release;
+    void *release_arg = packet->release_arg;
 
     memset(packet, 0, sizeof(*packet));
 
     packet->data = data;
     packet->pos  = data;
     packet->size = size;
+    packet->release = release;
+    packet->release_arg = release_arg;
     setup_mpp_packet_name(packet);
     return MPP_OK;
 }
 
+MPP_RET mpp_packet_set_release(MppPacket packet, MppPacketReleaseCb cb, void *arg)
+{
+    if (check_is_mpp_packet(packet))
+        return MPP_ERR_UNKNOW;
+
+    MppPacketImpl *p = (MppPacketImpl *)packet;
+    if (p->buffer || (p->flag & MPP_PACKET_FLAG_INTERNAL)) {
+        mpp_err_f("packet %p data is already owned by mpp\n", packet);
+        return MPP_NOK;
+    }
+
+    p->release = cb;
+    p->release_arg = arg;
+    return MPP_OK;
+}
+
 void mpp_packet_set_buffer(MppPacket packet, MppBuffer buffer)
 {
     if (check_is_mpp_packet(packet))
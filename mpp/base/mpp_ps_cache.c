@@ -0,0 +1,215 @@
+/*
+ * Copyright 2015 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_TAG "mpp_ps_cache"
+
+#include <string.h>
+
+#include "mpp_env.h"
+#include "mpp_log.h"
+#include "mpp_mem.h"
+
+#include "mpp_ps_cache.h"
+
+typedef struct MppPsEntry_t {
+    RK_U32          valid;
+    RK_U32          hash;
+    RK_S32          size;
+    RK_S32          capacity;
+    RK_U8           *data;
+} MppPsEntry;
+
+typedef struct MppPsCacheImpl_t {
+    const char      *name;
+    RK_U32          enable;
+    RK_U32          debug;
+
+    RK_S32          count[MPP_PS_TYPE_BUTT];
+    MppPsEntry      *entries[MPP_PS_TYPE_BUTT];
+    MppPsCacheStat  stat[MPP_PS_TYPE_BUTT];
+} MppPsCacheImpl;
+
+static const char *ps_type_name[MPP_PS_TYPE_BUTT] = {
+    "vps",
+    "sps",
+    "pps",
+};
+
+/* 32bit FNV-1a, parameter sets are only tens of bytes */
+static RK_U32 ps_hash(const RK_U8 *nal, RK_S32 size)
+{
+    RK_U32 hash = 0x811c9dc5;
+    RK_S32 i;
+
+    for (i = 0; i < size; i++) {
+        hash ^= nal[i];
+        hash *= 0x01000193;
+    }
+
+    return hash;
+}
+
+MPP_RET mpp_ps_cache_init(MppPsCache *cache, const char *name,
+                          const RK_S32 max_ids[MPP_PS_TYPE_BUTT])
+{
+    MppPsCacheImpl *p = NULL;
+    RK_S32 total = 0;
+    MppPsEntry *entry;
+    RK_S32 i;
+
+    if (NULL == cache || NULL == max_ids) {
+        mpp_err_f("invalid cache %p max_ids %p\n", cache, max_ids);
+        return MPP_ERR_NULL_PTR;
+    }
+
+    *cache = NULL;
+
+    for (i = 0; i < MPP_PS_TYPE_BUTT; i++)
+        total += max_ids[i];
+
+    p = mpp_calloc_size(MppPsCacheImpl, sizeof(MppPsCacheImpl) + sizeof(MppPsEntry) * total);
+    if (NULL == p) {
+        mpp_err_f("failed to malloc %d entries\n", total);
+        return MPP_ERR_MALLOC;
+    }
+
+    p->name = name;
+    mpp_env_get_u32("mpp_ps_cache", &p->enable, 1);
+    mpp_env_get_u32("mpp_ps_cache_debug", &p->debug, 0);
+
+    entry = (MppPsEntry *)(p + 1);
+    for (i = 0; i < MPP_PS_TYPE_BUTT; i++) {
+        p->count[i] = max_ids[i];
+        p->entries[i] = entry;
+        entry += max_ids[i];
+    }
+
+    *cache = p;
+    return MPP_OK;
+}
+
+MPP_RET mpp_ps_cache_deinit(MppPsCache cache)
+{
+    MppPsCacheImpl *p = (MppPsCacheImpl *)cache;
+    RK_S32 i, j;
+
+    if (NULL == p)
+        return MPP_OK;
+
+    for (i = 0; i < MPP_PS_TYPE_BUTT; i++) {
+        if (p->debug && p->count[i])
+            mpp_log("%s %s hit %d miss %d\n", p->name, ps_type_name[i],
+                    p->stat[i].hit, p->stat[i].miss);
+
+        for (j = 0; j < p->count[i]; j++)
+            MPP_FREE(p->entries[i][j].data);
+    }
+
+    MPP_FREE(p);
+    return MPP_OK;
+}
+
+RK_S32 mpp_ps_cache_find(MppPsCache cache, MppPsType type,
+                         const RK_U8 *nal, RK_S32 size)
+{
+    MppPsCacheImpl *p = (MppPsCacheImpl *)cache;
+    MppPsEntry *entry;
+    RK_U32 hash;
+    RK_S32 i;
+
+    if (NULL == p || !p->enable || type >= MPP_PS_TYPE_BUTT || size <= 0)
+        return -1;
+
+    hash = ps_hash(nal, size);
+    entry = p->entries[type];
+
+    for (i = 0; i < p->count[type]; i++, entry++) {
+        if (entry->valid && entry->hash == hash && entry->size == size &&
+            !memcmp(entry->data, nal, size)) {
+            p->stat[type].hit++;
+            return i;
+        }
+    }
+
+    p->stat[type].miss++;
+    return -1;
+}
+
+MPP_RET mpp_ps_cache_update(MppPsCache cache, MppPsType type, RK_S32 id,
+                            const RK_U8 *nal, RK_S32 size)
+{
+    MppPsCacheImpl *p = (MppPsCacheImpl *)cache;
+    MppPsEntry *entry;
+    RK_S32 i;
+
+    if (NULL == p || !p->enable)
+        return MPP_OK;
+
+    if (type >= MPP_PS_TYPE_BUTT || id < 0 || id >= p->count[type] || size <= 0) {
+        mpp_err_f("invalid type %d id %d size %d\n", type, id, size);
+        return MPP_ERR_VALUE;
+    }
+
+    // the sets above may have been parsed against the old one
+    for (i = type + 1; i < MPP_PS_TYPE_BUTT; i++)
+        mpp_ps_cache_drop(cache, (MppPsType)i, -1);
+
+    entry = &p->entries[type][id];
+    if (entry->capacity < size) {
+        MPP_FREE(entry->data);
+        entry->data = mpp_malloc(RK_U8, size);
+        entry->capacity = entry->data ? size : 0;
+        if (NULL == entry->data) {
+            entry->valid = 0;
+            return MPP_ERR_MALLOC;
+        }
+    }
+
+    memcpy(entry->data, nal, size);
+    entry->size = size;
+    entry->hash = ps_hash(nal, size);
+    entry->valid = 1;
+
+    return MPP_OK;
+}
+
+void mpp_ps_cache_drop(MppPsCache cache, MppPsType type, RK_S32 id)
+{
+    MppPsCacheImpl *p = (MppPsCacheImpl *)cache;
+    RK_S32 i;
+
+    if (NULL == p || type >= MPP_PS_TYPE_BUTT || id >= p->count[type])
+        return;
+
+    if (id >= 0) {
+        p->entries[type][id].valid = 0;
+        return;
+    }
+
+    for (i = 0; i < p->count[type]; i++)
+        p->entries[type][i].valid = 0;
+}
+
+MPP_RET mpp_ps_cache_get_stat(MppPsCache cache, MppPsType type, MppPsCacheStat *stat)
+{
+    MppPsCacheImpl *p = (MppPsCacheImpl *)cache;
+
+    if (NULL == p || NULL == stat || type >= MPP_PS_TYPE_BUTT)
+        return MPP_ERR_NULL_PTR;
+
+    *stat = p->stat[type];
+    return MPP_OK;
+}
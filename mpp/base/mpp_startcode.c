@@ -0,0 +1,115 @@
+/*
+ * Copyright 2015 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mpp_startcode.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SC_SIMD_WIDTH   32
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define SC_SIMD_WIDTH   16
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define SC_SIMD_WIDTH   16
+#endif
+
+static RK_U32 find_start_code_c(const RK_U8 *buf, RK_U32 pos, RK_U32 len)
+{
+    // a start code ends on its 0x01, so step over anything larger
+    for (pos += 2; pos < len; pos++) {
+        if (buf[pos] > 1) {
+            pos += 2;
+            continue;
+        }
+        if (buf[pos] == 1 && !buf[pos - 1] && !buf[pos - 2])
+            return pos - 2;
+    }
+
+    return len;
+}
+
+#ifdef SC_SIMD_WIDTH
+/*
+ * Bit i of the mask is set when buf[pos + i], buf[pos + i + 1] are zero and
+ * buf[pos + i + 2] is one. Needs SC_SIMD_WIDTH + 2 readable bytes.
+ */
+static inline RK_U32 start_code_mask(const RK_U8 *p)
+{
+#if defined(__AVX2__)
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi8(1);
+    __m256i a = _mm256_loadu_si256((const __m256i *)p);
+    __m256i b = _mm256_loadu_si256((const __m256i *)(p + 1));
+    __m256i c = _mm256_loadu_si256((const __m256i *)(p + 2));
+    __m256i m = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_or_si256(a, b), zero),
+                                 _mm256_cmpeq_epi8(c, one));
+
+    return (RK_U32)_mm256_movemask_epi8(m);
+#elif defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi8(1);
+    __m128i a = _mm_loadu_si128((const __m128i *)p);
+    __m128i b = _mm_loadu_si128((const __m128i *)(p + 1));
+    __m128i c = _mm_loadu_si128((const __m128i *)(p + 2));
+    __m128i m = _mm_and_si128(_mm_cmpeq_epi8(_mm_or_si128(a, b), zero),
+                              _mm_cmpeq_epi8(c, one));
+
+    return (RK_U32)_mm_movemask_epi8(m);
+#else
+    static const RK_U8 bits[16] = {
+        1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128,
+    };
+    uint8x16_t a = vld1q_u8(p);
+    uint8x16_t b = vld1q_u8(p + 1);
+    uint8x16_t c = vld1q_u8(p + 2);
+    uint8x16_t m = vandq_u8(vceqq_u8(vorrq_u8(a, b), vdupq_n_u8(0)),
+                            vceqq_u8(c, vdupq_n_u8(1)));
+    uint8x16_t w;
+    RK_U32 lo, hi;
+
+    if (!(vgetq_lane_u64(vreinterpretq_u64_u8(m), 0) |
+          vgetq_lane_u64(vreinterpretq_u64_u8(m), 1)))
+        return 0;
+
+    // fold the lane flags into a 16-bit mask
+    w = vandq_u8(m, vld1q_u8(bits));
+    lo = vaddv_u8(vget_low_u8(w));
+    hi = vaddv_u8(vget_high_u8(w));
+
+    return lo | (hi << 8);
+#endif
+}
+#endif
+
+RK_U32 mpp_find_start_code(const RK_U8 *buf, RK_U32 len)
+{
+    RK_U32 pos = 0;
+
+    if (len < 3)
+        return len;
+
+#ifdef SC_SIMD_WIDTH
+    for (; pos + SC_SIMD_WIDTH + 2 <= len; pos += SC_SIMD_WIDTH) {
+        RK_U32 mask = start_code_mask(buf + pos);
+
+        if (mask)
+            return pos + __builtin_ctz(mask);
+    }
+#endif
+
+    return find_start_code_c(buf, pos, len);
+}
@@ -0,0 +1,449 @@
+/*
+ * Copyright 2015 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_TAG "mpp_bitread_test"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mpp_log.h"
+#include "mpp_mem.h"
+#include "mpp_time.h"
+#include "mpp_common.h"
+#include "mpp_bitread.h"
+#include "mpp_bitwrite.h"
+#include "mpp_startcode.h"
+
+#define CHECK_SIZE          (256)
+#define CHECK_ROUNDS        (20000)
+#define BENCH_SIZE          (1024 * 1024)
+#define BENCH_LOOPS         (20)
+
+typedef enum BitReadOp_e {
+    OP_READ_BITS,
+    OP_READ_LONGBITS,
+    OP_SHOW_BITS,
+    OP_SKIP_BITS,
+    OP_READ_UE,
+    OP_READ_SE,
+    OP_ALIGN,
+    OP_BUTT,
+} BitReadOp;
+
+/*
+ * Byte at a time reader as it was before the 64-bit window, kept here as
+ * the reference for bit exactness.
+ */
+static MPP_RET ref_update_curbyte(BitReadCtx_t *bitctx)
+{
+    if (bitctx->bytes_left_ < 1)
+        return  MPP_ERR_READ_BIT;
+
+    if (bitctx->need_prevention_detection
+        && (*bitctx->data_ == 0x03)
+        && ((bitctx->prev_two_bytes_ & 0xffff) == 0)) {
+        ++bitctx->data_;
+        --bitctx->bytes_left_;
+        ++bitctx->emulation_prevention_bytes_;
+        bitctx->prev_two_bytes_ = 0xffff;
+        if (bitctx->bytes_left_ < 1)
+            return  MPP_ERR_READ_BIT;
+    }
+    bitctx->curr_byte_ = *bitctx->data_++ & 0xff;
+    --bitctx->bytes_left_;
+    bitctx->num_remaining_bits_in_curr_byte_ = 8;
+    bitctx->prev_two_bytes_ = (bitctx->prev_two_bytes_ << 8) | bitctx->curr_byte_;
+
+    return MPP_OK;
+}
+
+static MPP_RET ref_read_bits(BitReadCtx_t *bitctx, RK_S32 num_bits, RK_S32 *out)
+{
+    RK_S32 bits_left = num_bits;
+    *out = 0;
+    if (num_bits > 31)
+        return  MPP_ERR_READ_BIT;
+
+    while (bitctx->num_remaining_bits_in_curr_byte_ < bits_left) {
+        *out |= (bitctx->curr_byte_ << (bits_left - bitctx->num_remaining_bits_in_curr_byte_));
+        bits_left -= bitctx->num_remaining_bits_in_curr_byte_;
+        if (ref_update_curbyte(bitctx))
+            return  MPP_ERR_READ_BIT;
+    }
+    *out |= (bitctx->curr_byte_ >> (bitctx->num_remaining_bits_in_curr_byte_ - bits_left));
+    *out &= ((1 << num_bits) - 1);
+    bitctx->num_remaining_bits_in_curr_byte_ -= bits_left;
+    bitctx->used_bits += num_bits;
+
+    return MPP_OK;
+}
+
+static MPP_RET ref_read_longbits(BitReadCtx_t *bitctx, RK_S32 num_bits, RK_U32 *out)
+{
+    RK_S32 val = 0, val1 = 0;
+
+    if (num_bits < 32)
+        return ref_read_bits(bitctx, num_bits, (RK_S32 *)out);
+
+    if (ref_read_bits(bitctx, 16, &val))
+        return  MPP_ERR_READ_BIT;
+    if (ref_read_bits(bitctx, (num_bits - 16), &val1))
+        return  MPP_ERR_READ_BIT;
+
+    *out = (RK_U32)((val << 16) | val1);
+
+    return MPP_OK;
+}
+
+static MPP_RET ref_skip_bits(BitReadCtx_t *bitctx, RK_S32 num_bits)
+{
+    RK_S32 bits_left = num_bits;
+
+    while (bitctx->num_remaining_bits_in_curr_byte_ < bits_left) {
+        bits_left -= bitctx->num_remaining_bits_in_curr_byte_;
+        if (ref_update_curbyte(bitctx))
+            return  MPP_ERR_READ_BIT;
+    }
+    bitctx->num_remaining_bits_in_curr_byte_ -= bits_left;
+    bitctx->used_bits += num_bits;
+
+    return MPP_OK;
+}
+
+static MPP_RET ref_read_ue(BitReadCtx_t *bitctx, RK_U32 *val)
+{
+    RK_S32 num_bits = -1;
+    RK_S32 bit;
+    RK_S32 rest;
+
+    do {
+        if (ref_read_bits(bitctx, 1, &bit))
+            return  MPP_ERR_READ_BIT;
+        num_bits++;
+    } while (bit == 0);
+    if (num_bits > 31)
+        return  MPP_ERR_READ_BIT;
+
+    *val = (1 << num_bits) - 1;
+    if (num_bits > 0) {
+        if (ref_read_bits(bitctx, num_bits, &rest))
+            return  MPP_ERR_READ_BIT;
+        *val += rest;
+    }
+
+    return MPP_OK;
+}
+
+static MPP_RET ref_read_se(BitReadCtx_t *bitctx, RK_S32 *val)
+{
+    RK_U32 ue;
+
+    if (ref_read_ue(bitctx, &ue))
+        return  MPP_ERR_READ_BIT;
+    if (ue % 2 == 0)
+        *val = -(RK_S32)(ue >> 1);
+    else
+        *val = (RK_S32)((ue >> 1) + 1);
+
+    return MPP_OK;
+}
+
+static MPP_RET run_op(BitReadCtx_t *bitctx, RK_U32 ref, BitReadOp op,
+                      RK_S32 len, RK_S32 *out)
+{
+    BitReadCtx_t tmp;
+
+    *out = 0;
+    switch (op) {
+    case OP_READ_BITS :
+        return ref ? ref_read_bits(bitctx, len, out) : mpp_read_bits(bitctx, len, out);
+    case OP_READ_LONGBITS :
+        return ref ? ref_read_longbits(bitctx, 32, (RK_U32 *)out) :
+               mpp_read_longbits(bitctx, 32, (RK_U32 *)out);
+    case OP_SHOW_BITS :
+        if (!ref)
+            return mpp_show_bits(bitctx, len, out);
+        tmp = *bitctx;
+        return ref_read_bits(&tmp, len, out);
+    case OP_SKIP_BITS :
+        return ref ? ref_skip_bits(bitctx, len) : mpp_skip_bits(bitctx, len);
+    case OP_READ_UE :
+        return ref ? ref_read_ue(bitctx, (RK_U32 *)out) : mpp_read_ue(bitctx, (RK_U32 *)out);
+    case OP_READ_SE :
+        return ref ? ref_read_se(bitctx, out) : mpp_read_se(bitctx, out);
+    case OP_ALIGN :
+        if (!ref) {
+            mpp_align_get_bits(bitctx);
+        } else if (bitctx->num_remaining_bits_in_curr_byte_) {
+            ref_skip_bits(bitctx, bitctx->num_remaining_bits_in_curr_byte_);
+        }
+        return MPP_OK;
+    default :
+        break;
+    }
+
+    return MPP_NOK;
+}
+
+static RK_U32 same_state(BitReadCtx_t *a, BitReadCtx_t *b)
+{
+    return a->data_ == b->data_ &&
+           a->bytes_left_ == b->bytes_left_ &&
+           a->num_remaining_bits_in_curr_byte_ == b->num_remaining_bits_in_curr_byte_ &&
+           (a->curr_byte_ & 0xff) == (b->curr_byte_ & 0xff) &&
+           (a->prev_two_bytes_ & 0xffff) == (b->prev_two_bytes_ & 0xffff) &&
+           a->emulation_prevention_bytes_ == b->emulation_prevention_bytes_ &&
+           a->used_bits == b->used_bits;
+}
+
+/* zero and 0x03 heavy data so emulation prevention and long codes happen */
+static void fill_random(RK_U8 *buf, RK_U32 size)
+{
+    RK_U32 i;
+
+    for (i = 0; i < size; i++) {
+        RK_U32 r = rand() % 8;
+        buf[i] = r < 3 ? 0 : r < 5 ? 3 : r < 6 ? 1 : rand();
+    }
+}
+
+static MPP_RET check_exact(void)
+{
+    RK_U8 buf[CHECK_SIZE];
+    RK_U32 round;
+
+    srand(1);
+    for (round = 0; round < CHECK_ROUNDS; round++) {
+        BitReadCtx_t ref;
+        BitReadCtx_t cur;
+        RK_S32 size = rand() % CHECK_SIZE;
+        RK_U32 step = 0;
+
+        fill_random(buf, sizeof(buf));
+        mpp_set_bitread_ctx(&ref, buf, size);
+        if (round & 1)
+            mpp_set_pre_detection(&ref);
+        cur = ref;
+
+        while (1) {
+            BitReadOp op = rand() % OP_BUTT;
+            RK_S32 len = rand() % 32;
+            RK_S32 out_ref, out_cur;
+            MPP_RET ret_ref, ret_cur;
+
+            if (op == OP_SKIP_BITS && !(rand() % 4))
+                len = rand() % 100;
+
+            ret_ref = run_op(&ref, 1, op, len, &out_ref);
+            ret_cur = run_op(&cur, 0, op, len, &out_cur);
+
+            if (ret_ref != ret_cur || (!ret_ref && out_ref != out_cur) ||
+                !same_state(&ref, &cur)) {
+                mpp_err("round %d step %d op %d len %d ret %d/%d out %08x/%08x\n",
+                        round, step, op, len, ret_ref, ret_cur, out_ref, out_cur);
+                return MPP_NOK;
+            }
+            if (ret_ref)
+                break;
+            step++;
+        }
+    }
+
+    return MPP_OK;
+}
+
+/*
+ * Slice header like syntax: mostly short ue / se with a few flags and fixed
+ * length fields, written with emulation prevention.
+ */
+static RK_S32 make_headers(RK_U8 *buf, RK_S32 size, RK_U8 *ops, RK_U8 *lens, RK_S32 max_ops)
+{
+    MppWriteCtx writer;
+    RK_S32 count = 0;
+
+    srand(2);
+    mpp_writer_init(&writer, buf, size);
+    while (count < max_ops && writer.byte_cnt + 16 < (RK_U32)size) {
+        RK_U32 r = rand() % 8;
+        RK_S32 len = 1 + rand() % 16;
+
+        if (r < 3) {
+            ops[count] = OP_READ_UE;
+            mpp_writer_put_ue(&writer, rand() % ((rand() % 4) ? 8 : 300));
+        } else if (r < 5) {
+            ops[count] = OP_READ_SE;
+            mpp_writer_put_se(&writer, rand() % 52 - 26);
+        } else if (r < 7) {
+            ops[count] = OP_READ_BITS;
+            len = 1;
+            mpp_writer_put_bits(&writer, rand() & 1, 1);
+        } else {
+            ops[count] = OP_READ_BITS;
+            mpp_writer_put_bits(&writer, rand() & ((1 << len) - 1), len);
+        }
+        lens[count++] = len;
+    }
+    mpp_writer_trailing(&writer);
+
+    return writer.byte_cnt;
+}
+
+static RK_S64 replay(const RK_U8 *buf, RK_S32 size, const RK_U8 *ops,
+                     const RK_U8 *lens, RK_S32 count, RK_U32 ref, RK_S64 *sum)
+{
+    RK_S64 start = mpp_time();
+    RK_U32 loop;
+
+    for (loop = 0; loop < BENCH_LOOPS; loop++) {
+        BitReadCtx_t ctx;
+        RK_S32 i;
+
+        mpp_set_bitread_ctx(&ctx, (RK_U8 *)buf, size);
+        mpp_set_pre_detection(&ctx);
+        for (i = 0; i < count; i++) {
+            RK_S32 out;
+
+            if (run_op(&ctx, ref, ops[i], lens[i], &out))
+                break;
+            *sum += out;
+        }
+    }
+
+    return mpp_time() - start;
+}
+
+static void bench_headers(void)
+{
+    RK_U8 *buf = mpp_malloc(RK_U8, BENCH_SIZE);
+    RK_U8 *ops = mpp_malloc(RK_U8, BENCH_SIZE);
+    RK_U8 *lens = mpp_malloc(RK_U8, BENCH_SIZE);
+    RK_S64 sum_ref = 0, sum_cur = 0;
+    RK_S64 t_ref, t_cur;
+    RK_S32 size;
+
+    if (buf && ops && lens) {
+        size = make_headers(buf, BENCH_SIZE, ops, lens, BENCH_SIZE);
+        t_ref = replay(buf, size, ops, lens, BENCH_SIZE, 1, &sum_ref);
+        t_cur = replay(buf, size, ops, lens, BENCH_SIZE, 0, &sum_cur);
+
+        mpp_log("headers: %d bytes bytewise %.1f MB/s window %.1f MB/s\n", size,
+                (double)size * BENCH_LOOPS / MPP_MAX(t_ref, 1),
+                (double)size * BENCH_LOOPS / MPP_MAX(t_cur, 1));
+        if (sum_ref != sum_cur)
+            mpp_err("headers: checksum %lld vs %lld\n", sum_ref, sum_cur);
+    }
+
+    MPP_FREE(buf);
+    MPP_FREE(ops);
+    MPP_FREE(lens);
+}
+
+/* read each nalu of an elementary stream as ue until it runs out */
+static RK_S64 read_stream(const RK_U8 *buf, RK_U32 size, RK_U32 ref, RK_S64 *sum)
+{
+    RK_S64 start = mpp_time();
+    RK_U32 loop;
+
+    for (loop = 0; loop < BENCH_LOOPS; loop++) {
+        RK_U32 pos = mpp_find_start_code(buf, size) + 3;
+
+        while (pos < size) {
+            RK_U32 len = mpp_find_start_code(buf + pos, size - pos);
+            BitReadCtx_t ctx;
+            RK_U32 val;
+
+            mpp_set_bitread_ctx(&ctx, (RK_U8 *)buf + pos, len);
+            mpp_set_pre_detection(&ctx);
+            while (!run_op(&ctx, ref, OP_READ_UE, 0, (RK_S32 *)&val))
+                *sum += val;
+            pos += len + 3;
+        }
+    }
+
+    return mpp_time() - start;
+}
+
+static MPP_RET bench_file(const char *path)
+{
+    FILE *fp = fopen(path, "rb");
+    RK_S64 sum_ref = 0, sum_cur = 0;
+    RK_S64 t_ref, t_cur;
+    RK_U8 *buf = NULL;
+    long size;
+
+    if (NULL == fp) {
+        mpp_err("failed to open %s\n", path);
+        return MPP_NOK;
+    }
+
+    fseek(fp, 0, SEEK_END);
+    size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    if (size > 0)
+        buf = mpp_malloc(RK_U8, size);
+    if (NULL == buf || fread(buf, 1, size, fp) != (size_t)size) {
+        mpp_err("failed to read %s\n", path);
+        MPP_FREE(buf);
+        fclose(fp);
+        return MPP_NOK;
+    }
+    fclose(fp);
+
+    t_ref = read_stream(buf, size, 1, &sum_ref);
+    t_cur = read_stream(buf, size, 0, &sum_cur);
+    mpp_log("%s: bytewise %.1f MB/s window %.1f MB/s\n", path,
+            (double)size * BENCH_LOOPS / MPP_MAX(t_ref, 1),
+            (double)size * BENCH_LOOPS / MPP_MAX(t_cur, 1));
+    MPP_FREE(buf);
+
+    if (sum_ref != sum_cur) {
+        mpp_err("%s: checksum %lld vs %lld\n", path, sum_ref, sum_cur);
+        return MPP_NOK;
+    }
+
+    return MPP_OK;
+}
+
+int main(int argc, char **argv)
+{
+    MPP_RET ret = MPP_NOK;
+    int i;
+
+    mpp_log("mpp_bitread_test start\n");
+
+    if (check_exact()) {
+        mpp_err("reader differs from the byte wise reader\n");
+        goto TEST_FAILED;
+    }
+
+    bench_headers();
+
+    // elementary streams given on the command line
+    for (i = 1; i < argc; i++) {
+        if (bench_file(argv[i]))
+            goto TEST_FAILED;
+    }
+
+    ret = MPP_OK;
+TEST_FAILED:
+    if (ret)
+        mpp_log("mpp_bitread_test failed\n");
+    else
+        mpp_log("mpp_bitread_test success\n");
+
+    return ret;
+}
@@ -0,0 +1,175 @@
+/*
+ * Copyright 2015 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_TAG "mpp_buffer_stress_test"
+
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "mpp_log.h"
+#include "mpp_time.h"
+#include "mpp_common.h"
+#include "mpp_buffer.h"
+
+#define STRESS_MAX_THREADS      16
+#define STRESS_LOOPS            (100 * 1000)
+#define STRESS_BUF_COUNT        4
+#define STRESS_BUF_SIZE         (4 * 1024)
+
+typedef struct StressCtx_t {
+    MppBufferGroup  group;
+    MppBuffer       shared;
+    RK_U32          loops;
+    MPP_RET         ret;
+} StressCtx;
+
+/* one decoder like session: cycle a few frames through its own group */
+static void *session_loop(void *arg)
+{
+    StressCtx *ctx = (StressCtx *)arg;
+    MppBuffer bufs[STRESS_BUF_COUNT];
+    RK_U32 i, j;
+
+    for (i = 0; i < ctx->loops; i++) {
+        for (j = 0; j < STRESS_BUF_COUNT; j++) {
+            if (mpp_buffer_get(ctx->group, &bufs[j], STRESS_BUF_SIZE)) {
+                ctx->ret = MPP_NOK;
+                return NULL;
+            }
+            // display holds another reference for a while
+            mpp_buffer_inc_ref(bufs[j]);
+        }
+        for (j = 0; j < STRESS_BUF_COUNT; j++) {
+            mpp_buffer_put(bufs[j]);
+            mpp_buffer_put(bufs[j]);
+        }
+    }
+
+    ctx->ret = MPP_OK;
+    return NULL;
+}
+
+/* many owners of one buffer taking and dropping references */
+static void *shared_loop(void *arg)
+{
+    StressCtx *ctx = (StressCtx *)arg;
+    RK_U32 i;
+
+    for (i = 0; i < ctx->loops * STRESS_BUF_COUNT; i++) {
+        mpp_buffer_inc_ref(ctx->shared);
+        mpp_buffer_put(ctx->shared);
+    }
+
+    ctx->ret = MPP_OK;
+    return NULL;
+}
+
+static MPP_RET run(const char *name, void * (*loop)(void *), RK_U32 count,
+                   MppBufferGroup shared_group, MppBuffer shared)
+{
+    pthread_t threads[STRESS_MAX_THREADS];
+    StressCtx ctx[STRESS_MAX_THREADS];
+    MPP_RET ret = MPP_OK;
+    RK_S64 time;
+    RK_U32 i;
+
+    for (i = 0; i < count; i++) {
+        ctx[i].group = shared_group;
+        ctx[i].shared = shared;
+        ctx[i].loops = STRESS_LOOPS / count;
+        ctx[i].ret = MPP_NOK;
+
+        // with a count limit unused reports the buffers not in use
+        if (NULL == shared_group &&
+            (mpp_buffer_group_get_internal(&ctx[i].group, MPP_BUFFER_TYPE_NORMAL) ||
+             mpp_buffer_group_limit_config(ctx[i].group, 0, STRESS_BUF_COUNT)))
+            return MPP_NOK;
+    }
+
+    time = mpp_time();
+    for (i = 0; i < count; i++)
+        pthread_create(&threads[i], NULL, loop, &ctx[i]);
+    for (i = 0; i < count; i++)
+        pthread_join(threads[i], NULL);
+    time = mpp_time() - time;
+
+    for (i = 0; i < count; i++) {
+        if (ctx[i].ret)
+            ret = MPP_NOK;
+
+        if (NULL == shared_group) {
+            // every buffer must be back on the unused list
+            if (mpp_buffer_group_unused(ctx[i].group) != STRESS_BUF_COUNT) {
+                mpp_err("%s thread %d group has %d unused buffer\n", name, i,
+                        mpp_buffer_group_unused(ctx[i].group));
+                ret = MPP_NOK;
+            }
+            mpp_buffer_group_put(ctx[i].group);
+        }
+    }
+
+    // each loop is one get or inc plus one put per buffer and reference
+    mpp_log("%-8s threads %2d %8.2f Mops/s\n", name, count,
+            (double)STRESS_LOOPS * STRESS_BUF_COUNT * 3 / MPP_MAX(time, 1));
+
+    return ret;
+}
+
+int main()
+{
+    MPP_RET ret = MPP_NOK;
+    MppBufferGroup group = NULL;
+    MppBuffer shared = NULL;
+    RK_U32 count;
+
+    mpp_log("mpp_buffer_stress_test start\n");
+
+    for (count = 1; count <= STRESS_MAX_THREADS; count *= 2) {
+        if (run("session", session_loop, count, NULL, NULL))
+            goto TEST_FAILED;
+    }
+
+    if (mpp_buffer_group_get_internal(&group, MPP_BUFFER_TYPE_NORMAL) ||
+        mpp_buffer_group_limit_config(group, 0, 1) ||
+        mpp_buffer_get(group, &shared, STRESS_BUF_SIZE))
+        goto TEST_FAILED;
+
+    for (count = 1; count <= STRESS_MAX_THREADS; count *= 2) {
+        if (run("shared", shared_loop, count, group, shared))
+            goto TEST_FAILED;
+    }
+
+    mpp_buffer_put(shared);
+    shared = NULL;
+    if (mpp_buffer_group_unused(group) != 1) {
+        mpp_err("shared buffer reference leaked\n");
+        goto TEST_FAILED;
+    }
+
+    ret = MPP_OK;
+TEST_FAILED:
+    if (shared)
+        mpp_buffer_put(shared);
+    if (group)
+        mpp_buffer_group_put(group);
+
+    if (ret)
+        mpp_log("mpp_buffer_stress_test failed\n");
+    else
+        mpp_log("mpp_buffer_stress_test success\n");
+
+    return ret;
+}
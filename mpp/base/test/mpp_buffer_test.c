@@ -239,6 +239,67 @@ int main()
         group = NULL;
     }
 
+    mpp_log("mpp_buffer_test size class mode start\n");
+
+    ret = mpp_buffer_group_get_internal(&group, MPP_BUFFER_TYPE_NORMAL);
+    if (MPP_OK != ret) {
+        mpp_err("mpp_buffer_test mpp_buffer_group_get failed\n");
+        goto MPP_BUFFER_failed;
+    }
+
+    if (mpp_buffer_group_prealloc(group, SZ_4K, 4) ||
+        mpp_buffer_group_prealloc(group, SZ_64K, 2)) {
+        mpp_err("mpp_buffer_test mpp_buffer_group_prealloc failed\n");
+        goto MPP_BUFFER_failed;
+    }
+
+    {
+        // request size and the preallocated size it must be served from
+        static const size_t req[3][2] = {
+            { SZ_32K + SZ_8K,   SZ_64K, },
+            { SZ_1K,            SZ_4K,  },
+            { SZ_4K + SZ_1K,    SZ_64K, },
+        };
+        size_t usage = mpp_buffer_group_usage(group);
+
+        for (i = 0; i < 3; i++) {
+            ret = mpp_buffer_get(group, &normal_buffer[i], req[i][0]);
+            if (ret || mpp_buffer_get_size(normal_buffer[i]) != req[i][1]) {
+                mpp_err("mpp_buffer_test size %d not served from size %d\n",
+                        req[i][0], req[i][1]);
+                ret = MPP_NOK;
+                goto MPP_BUFFER_failed;
+            }
+        }
+
+        for (i = 0; i < 3; i++) {
+            mpp_buffer_put(normal_buffer[i]);
+            normal_buffer[i] = NULL;
+        }
+
+        if (mpp_buffer_group_usage(group) != usage) {
+            mpp_err("mpp_buffer_test preallocated buffer not reused\n");
+            ret = MPP_NOK;
+            goto MPP_BUFFER_failed;
+        }
+
+        // at the count limit one small unused buffer makes room for a large one
+        mpp_buffer_group_limit_config(group, 0, 6);
+        ret = mpp_buffer_get(group, &normal_buffer[0], SZ_128K);
+        if (ret || mpp_buffer_group_usage(group) != usage - SZ_4K + SZ_128K) {
+            mpp_err("mpp_buffer_test evict on count limit failed\n");
+            ret = MPP_NOK;
+            goto MPP_BUFFER_failed;
+        }
+        mpp_buffer_put(normal_buffer[0]);
+        normal_buffer[0] = NULL;
+    }
+
+    mpp_buffer_group_put(group);
+    group = NULL;
+
+    mpp_log("mpp_buffer_test size class mode success\n");
+
     mpp_log("mpp_buffer_test success\n");
 
     ret = mpp_buffer_get(NULL, &legacy_buffer, MPP_BUFFER_TEST_SIZE);
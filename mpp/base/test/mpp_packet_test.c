@@ -23,10 +23,20 @@
 
 #define MPP_PACKET_TEST_SIZE    1024
 
+static RK_S32 release_count = 0;
+
+static void release_data(void *arg, void *data)
+{
+    if (arg == data)
+        release_count++;
+    free(data);
+}
+
 int main()
 {
     MPP_RET ret = MPP_ERR_UNKNOW;
     MppPacket packet = NULL;
+    MppPacket copy = NULL;
     void *data = NULL;
     size_t size = MPP_PACKET_TEST_SIZE;
 
@@ -50,7 +60,37 @@ int main()
     }
     mpp_packet_deinit(&packet);
 
-    free(data);
+    // zero copy: data moves to the copy and is released once by the copy
+    ret = mpp_packet_init(&packet, data, size);
+    if (ret || mpp_packet_set_release(packet, release_data, data)) {
+        mpp_err("mpp_packet_test mpp_packet_set_release failed\n");
+        ret = MPP_NOK;
+        goto MPP_PACKET_failed;
+    }
+    // owned by packet now
+    data = NULL;
+
+    ret = mpp_packet_copy_init(&copy, packet);
+    if (ret) {
+        mpp_err("mpp_packet_test zero copy mpp_packet_copy_init failed\n");
+        goto MPP_PACKET_failed;
+    }
+    mpp_packet_deinit(&packet);
+
+    if (release_count || mpp_packet_get_data(copy) != mpp_packet_get_pos(copy) ||
+        mpp_packet_get_length(copy) != size) {
+        mpp_err("mpp_packet_test zero copy packet mismatch\n");
+        ret = MPP_NOK;
+        goto MPP_PACKET_failed;
+    }
+    mpp_packet_deinit(&copy);
+
+    if (release_count != 1) {
+        mpp_err("mpp_packet_test zero copy released %d times\n", release_count);
+        ret = MPP_NOK;
+        goto MPP_PACKET_failed;
+    }
+
     mpp_log("mpp_packet_test success\n");
     return ret;
 
@@ -58,6 +98,9 @@ MPP_PACKET_failed:
     if (packet)
         mpp_packet_deinit(&packet);
 
+    if (copy)
+        mpp_packet_deinit(&copy);
+
     if (data)
         free(data);
 
@@ -0,0 +1,100 @@
+/*
+ * Copyright 2015 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_TAG "mpp_ps_cache_test"
+
+#include <string.h>
+
+#include "mpp_log.h"
+#include "mpp_ps_cache.h"
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            mpp_err("check %s failed at line %d\n", #cond, __LINE__); \
+            goto TEST_FAILED; \
+        } \
+    } while (0)
+
+static const RK_U8 vps0[] = { 0x40, 0x01, 0x0c, 0x01, 0xff, 0xff };
+static const RK_U8 sps0[] = { 0x42, 0x01, 0x01, 0x01, 0x60, 0x00, 0x00 };
+static const RK_U8 sps1[] = { 0x42, 0x01, 0x01, 0x01, 0x60, 0x00, 0x80 };
+static const RK_U8 pps0[] = { 0x44, 0x01, 0xc1, 0x72, 0xb4 };
+static const RK_U8 pps1[] = { 0x44, 0x01, 0xc1, 0x72, 0xb4, 0x62 };
+
+int main()
+{
+    static const RK_S32 max_ids[MPP_PS_TYPE_BUTT] = { 16, 16, 64 };
+    MPP_RET ret = MPP_NOK;
+    MppPsCache cache = NULL;
+    MppPsCacheStat stat;
+
+    mpp_log("mpp_ps_cache_test start\n");
+
+    CHECK(!mpp_ps_cache_init(&cache, MODULE_TAG, max_ids));
+
+    // nothing cached yet
+    CHECK(mpp_ps_cache_find(cache, MPP_PS_VPS, vps0, sizeof(vps0)) < 0);
+    CHECK(!mpp_ps_cache_update(cache, MPP_PS_VPS, 0, vps0, sizeof(vps0)));
+    CHECK(mpp_ps_cache_find(cache, MPP_PS_SPS, sps0, sizeof(sps0)) < 0);
+    CHECK(!mpp_ps_cache_update(cache, MPP_PS_SPS, 3, sps0, sizeof(sps0)));
+    CHECK(mpp_ps_cache_find(cache, MPP_PS_PPS, pps0, sizeof(pps0)) < 0);
+    CHECK(!mpp_ps_cache_update(cache, MPP_PS_PPS, 7, pps0, sizeof(pps0)));
+
+    // repeated headers are found with their id
+    CHECK(mpp_ps_cache_find(cache, MPP_PS_VPS, vps0, sizeof(vps0)) == 0);
+    CHECK(mpp_ps_cache_find(cache, MPP_PS_SPS, sps0, sizeof(sps0)) == 3);
+    CHECK(mpp_ps_cache_find(cache, MPP_PS_PPS, pps0, sizeof(pps0)) == 7);
+
+    // same prefix, other length or content, or other type is a miss
+    CHECK(mpp_ps_cache_find(cache, MPP_PS_PPS, pps1, sizeof(pps1)) < 0);
+    CHECK(mpp_ps_cache_find(cache, MPP_PS_SPS, sps1, sizeof(sps1)) < 0);
+    CHECK(mpp_ps_cache_find(cache, MPP_PS_PPS, sps0, sizeof(sps0)) < 0);
+
+    // a new pps keeps the sps
+    CHECK(!mpp_ps_cache_update(cache, MPP_PS_PPS, 7, pps1, sizeof(pps1)));
+    CHECK(mpp_ps_cache_find(cache, MPP_PS_PPS, pps0, sizeof(pps0)) < 0);
+    CHECK(mpp_ps_cache_find(cache, MPP_PS_PPS, pps1, sizeof(pps1)) == 7);
+    CHECK(mpp_ps_cache_find(cache, MPP_PS_SPS, sps0, sizeof(sps0)) == 3);
+
+    // a changed sps drops the pps parsed against the old one
+    CHECK(!mpp_ps_cache_update(cache, MPP_PS_SPS, 3, sps1, sizeof(sps1)));
+    CHECK(mpp_ps_cache_find(cache, MPP_PS_SPS, sps0, sizeof(sps0)) < 0);
+    CHECK(mpp_ps_cache_find(cache, MPP_PS_SPS, sps1, sizeof(sps1)) == 3);
+    CHECK(mpp_ps_cache_find(cache, MPP_PS_PPS, pps1, sizeof(pps1)) < 0);
+    CHECK(mpp_ps_cache_find(cache, MPP_PS_VPS, vps0, sizeof(vps0)) == 0);
+
+    mpp_ps_cache_drop(cache, MPP_PS_VPS, 0);
+    CHECK(mpp_ps_cache_find(cache, MPP_PS_VPS, vps0, sizeof(vps0)) < 0);
+
+    CHECK(mpp_ps_cache_update(cache, MPP_PS_PPS, 64, pps0, sizeof(pps0)));
+
+    CHECK(!mpp_ps_cache_get_stat(cache, MPP_PS_SPS, &stat));
+    CHECK(stat.hit == 3 && stat.miss == 3);
+    CHECK(!mpp_ps_cache_get_stat(cache, MPP_PS_PPS, &stat));
+    CHECK(stat.hit == 2 && stat.miss == 5);
+
+    ret = MPP_OK;
+TEST_FAILED:
+    mpp_ps_cache_deinit(cache);
+
+    if (ret)
+        mpp_log("mpp_ps_cache_test failed\n");
+    else
+        mpp_log("mpp_ps_cache_test success\n");
+
+    return ret;
+}
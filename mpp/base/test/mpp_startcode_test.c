@@ -0,0 +1,247 @@
+/*
+ * Copyright 2015 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_TAG "mpp_startcode_test"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mpp_err.h"
+#include "mpp_log.h"
+#include "mpp_time.h"
+#include "mpp_common.h"
+#include "mpp_startcode.h"
+
+#define SYNTH_SIZE          (16 * 1024 * 1024)
+#define SYNTH_NALU_SIZE     (256 * 1024)
+#define CHECK_SIZE          (4096)
+#define CHECK_ROUNDS        (2000)
+
+/* the byte by byte prefix loop the h264 parser used */
+static RK_U32 find_start_code_ref(const RK_U8 *buf, RK_U32 len)
+{
+    RK_U32 prefix = 0xffffffff;
+    RK_U32 i;
+
+    for (i = 0; i < len; i++) {
+        prefix = (prefix << 8) | buf[i];
+        if ((prefix & 0x00FFFFFF) == 0x00000001)
+            return i - 2;
+    }
+
+    return len;
+}
+
+static RK_U32 split_ref(const RK_U8 *buf, RK_U32 len)
+{
+    RK_U32 count = 0;
+    RK_U32 pos = 0;
+
+    while (pos < len) {
+        RK_U32 found = find_start_code_ref(buf + pos, len - pos);
+        if (found == len - pos)
+            break;
+        pos += found + 3;
+        count++;
+    }
+
+    return count;
+}
+
+static RK_U32 split(const RK_U8 *buf, RK_U32 len)
+{
+    RK_U32 count = 0;
+    RK_U32 pos = 0;
+
+    while (pos < len) {
+        RK_U32 found = mpp_find_start_code(buf + pos, len - pos);
+        if (found == len - pos)
+            break;
+        pos += found + 3;
+        count++;
+    }
+
+    return count;
+}
+
+/* zero heavy random data so that 00 00 xx patterns show up everywhere */
+static MPP_RET check_random(void)
+{
+    RK_U8 *buf = malloc(CHECK_SIZE);
+    RK_U32 round;
+
+    if (NULL == buf)
+        return MPP_ERR_MALLOC;
+
+    srand(1);
+    for (round = 0; round < CHECK_ROUNDS; round++) {
+        RK_U32 len = rand() % CHECK_SIZE;
+        RK_U32 off = rand() % 64;
+        RK_U32 i;
+
+        for (i = 0; i < CHECK_SIZE; i++) {
+            RK_U32 r = rand() % 8;
+            buf[i] = r < 5 ? 0 : r < 6 ? 1 : r < 7 ? 3 : rand();
+        }
+
+        // sparse start codes with long clean runs in between
+        if (round & 1) {
+            for (i = 0; i < CHECK_SIZE; i++)
+                buf[i] |= 0x80;
+            i = rand() % CHECK_SIZE;
+            if (i + 3 <= CHECK_SIZE)
+                memcpy(buf + i, "\0\0\1", 3);
+        }
+
+        if (off > len)
+            off = len;
+
+        for (i = off; i <= len; i += 1 + (rand() % 37)) {
+            RK_U32 ref = find_start_code_ref(buf + i, len - i);
+            RK_U32 got = mpp_find_start_code(buf + i, len - i);
+
+            if (ref != got) {
+                mpp_err("mismatch round %d off %d len %d ref %d got %d\n",
+                        round, i, len - i, ref, got);
+                free(buf);
+                return MPP_NOK;
+            }
+        }
+    }
+
+    free(buf);
+    return MPP_OK;
+}
+
+/* nalu sized runs of emulation prevented payload split by 4-byte start codes */
+static void fill_synthetic(RK_U8 *buf, RK_U32 size)
+{
+    RK_U32 zeros = 0;
+    RK_U32 i;
+
+    srand(2);
+    for (i = 0; i < size; i++) {
+        RK_U8 c = (rand() % 4) ? rand() : 0;
+
+        if (i % SYNTH_NALU_SIZE < 4) {
+            c = (i % SYNTH_NALU_SIZE == 3) ? 1 : 0;
+        } else if (zeros >= 2 && c <= 3) {
+            c = 3;
+        }
+
+        zeros = c ? 0 : zeros + 1;
+        buf[i] = c;
+    }
+}
+
+static void bench(const char *name, const RK_U8 *buf, RK_U32 size)
+{
+    RK_U32 loops = MPP_MAX(1, (256 * 1024 * 1024) / MPP_MAX(size, 1));
+    RK_U32 nalu_ref = 0;
+    RK_U32 nalu = 0;
+    RK_S64 t_ref;
+    RK_S64 t_new;
+    RK_U32 i;
+
+    t_ref = mpp_time();
+    for (i = 0; i < loops; i++)
+        nalu_ref += split_ref(buf, size);
+    t_ref = mpp_time() - t_ref;
+
+    t_new = mpp_time();
+    for (i = 0; i < loops; i++)
+        nalu += split(buf, size);
+    t_new = mpp_time() - t_new;
+
+    mpp_log("%s: %d nalu bytewise %.1f MB/s scanner %.1f MB/s\n",
+            name, nalu / loops,
+            (double)size * loops / MPP_MAX(t_ref, 1),
+            (double)size * loops / MPP_MAX(t_new, 1));
+
+    if (nalu != nalu_ref)
+        mpp_err("%s: nalu count %d vs %d\n", name, nalu, nalu_ref);
+}
+
+static RK_U8 *read_file(const char *path, RK_U32 *size)
+{
+    FILE *fp = fopen(path, "rb");
+    RK_U8 *buf = NULL;
+    long len;
+
+    if (NULL == fp) {
+        mpp_err("failed to open %s\n", path);
+        return NULL;
+    }
+
+    fseek(fp, 0, SEEK_END);
+    len = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    if (len > 0)
+        buf = malloc(len);
+    if (buf && fread(buf, 1, len, fp) != (size_t)len) {
+        free(buf);
+        buf = NULL;
+    }
+    fclose(fp);
+
+    *size = buf ? (RK_U32)len : 0;
+    return buf;
+}
+
+int main(int argc, char **argv)
+{
+    MPP_RET ret = MPP_NOK;
+    RK_U8 *buf = NULL;
+    RK_U32 size = 0;
+    int i;
+
+    mpp_log("mpp_startcode_test start\n");
+
+    if (check_random()) {
+        mpp_err("scanner differs from the bytewise search\n");
+        goto TEST_FAILED;
+    }
+
+    buf = malloc(SYNTH_SIZE);
+    if (NULL == buf) {
+        mpp_err("mpp_startcode_test malloc failed\n");
+        goto TEST_FAILED;
+    }
+    fill_synthetic(buf, SYNTH_SIZE);
+    bench("synthetic", buf, SYNTH_SIZE);
+    free(buf);
+
+    // elementary streams given on the command line
+    for (i = 1; i < argc; i++) {
+        buf = read_file(argv[i], &size);
+        if (NULL == buf)
+            goto TEST_FAILED;
+        bench(argv[i], buf, size);
+        free(buf);
+    }
+    buf = NULL;
+
+    ret = MPP_OK;
+TEST_FAILED:
+    if (ret)
+        mpp_log("mpp_startcode_test failed\n");
+    else
+        mpp_log("mpp_startcode_test success\n");
+
+    return ret;
+}
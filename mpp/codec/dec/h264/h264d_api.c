@@ -20,6 +20,7 @@
 #include <string.h>
 
 #include "mpp_env.h"
+#include "mpp_common.h"
 #include "mpp_mem.h"
 #include "mpp_platform.h"
 #include "mpp_packet_impl.h"
@@ -133,7 +134,12 @@ static MPP_RET free_vid_ctx(H264dVideoCtx_t *p_Vid)
         MPP_FREE(p_Vid->p_Dpb_layer[i]);
     }
     free_storable_picture(p_Vid->p_Dec, p_Vid->dec_pic);
-    //free_frame_store(p_Dec, &p_Vid->out_buffer);
+    p_Vid->dec_pic = NULL;
+    //!< fields waiting in out_buffer for direct output
+    free_storable_picture(p_Vid->p_Dec, p_Vid->out_buffer.frame);
+    free_storable_picture(p_Vid->p_Dec, p_Vid->out_buffer.top_field);
+    free_storable_picture(p_Vid->p_Dec, p_Vid->out_buffer.bottom_field);
+    memset(&p_Vid->out_buffer, 0, sizeof(p_Vid->out_buffer));
 
 __RETURN:
     return ret = MPP_OK;
@@ -217,24 +223,58 @@ __FAILED:
     return ret;
 }
 
+static void check_dpb_pool(H264_DecCtx_t *p_Dec)
+{
+    H264dPool_t *pools[2] = { &p_Dec->pic_pool, &p_Dec->fs_pool };
+    RK_U32 i = 0;
+
+    if (!(H264D_DBG_DPB_MALLIC & rkv_h264d_parse_debug))
+        return;
+
+    for (i = 0; i < MPP_ARRAY_ELEMS(pools); i++) {
+        H264dPoolStat_t *stat = &pools[i]->stat;
+
+        mpp_log("%s capacity %d peak %d get %d heap %d\n", pools[i]->name,
+                stat->capacity, stat->peak, stat->get_cnt, stat->heap_cnt);
+        if (stat->used)
+            mpp_err("%s leak %d objects\n", pools[i]->name, stat->used);
+    }
+    if (p_Dec->mem) {
+        for (i = 0; i < MAX_MARK_SIZE; i++) {
+            H264_DpbMark_t *p_mark = &p_Dec->dpb_mark[i];
+
+            if (p_mark->top_used || p_mark->bot_used)
+                mpp_err("dpb mark %d slot %d leak top %d bot %d\n", i,
+                        p_mark->slot_idx, p_mark->top_used, p_mark->bot_used);
+        }
+    }
+}
+
 static MPP_RET free_dec_ctx(H264_DecCtx_t *p_Dec)
 {
     MPP_RET ret = MPP_ERR_UNKNOW;
 
     INP_CHECK(ret, NULL == p_Dec);
 
+    check_dpb_pool(p_Dec);
+    h264d_pool_deinit(&p_Dec->pic_pool);
+    h264d_pool_deinit(&p_Dec->fs_pool);
     if (p_Dec->mem) {
         free_dxva_ctx(&p_Dec->mem->dxva_ctx);
         MPP_FREE(p_Dec->mem);
     }
     //!< free mpp packet
     mpp_packet_deinit(&p_Dec->task_pkt);
+    mpp_ps_cache_deinit(p_Dec->ps_cache);
+    p_Dec->ps_cache = NULL;
 
 __RETURN:
     return ret = MPP_OK;
 }
 static MPP_RET init_dec_ctx(H264_DecCtx_t *p_Dec)
 {
+    static const RK_S32 ps_cache_ids[MPP_PS_TYPE_BUTT] = { 0, MAXSPS, MAXPPS };
+    RK_U32 dpb_pool = 1;
     RK_U32 i = 0;
     MPP_RET ret = MPP_ERR_UNKNOW;
 
@@ -260,6 +300,12 @@ static MPP_RET init_dec_ctx(H264_DecCtx_t *p_Dec)
     //!< malloc mpp packet
     mpp_packet_init(&p_Dec->task_pkt, p_Dec->dxva_ctx->bitstream, p_Dec->dxva_ctx->max_strm_size);
     MEM_CHECK(ret, p_Dec->task_pkt);
+    //!< skip parsing sps and pps re-sent unchanged
+    FUN_CHECK(ret = mpp_ps_cache_init(&p_Dec->ps_cache, MODULE_TAG, ps_cache_ids));
+    //!< dpb pictures and frame stores, reserved in init_dpb
+    mpp_env_get_u32("h264d_dpb_pool", &dpb_pool, 1);
+    FUN_CHECK(ret = h264d_pool_init(&p_Dec->pic_pool, "h264d_pic_pool", sizeof(H264_StorePic_t), dpb_pool));
+    FUN_CHECK(ret = h264d_pool_init(&p_Dec->fs_pool, "h264d_fs_pool", sizeof(H264_FrameStore_t), dpb_pool));
     //!< set Dec support decoder method
     p_Dec->spt_decode_mtds = MPP_DEC_BY_FRAME;
     p_Dec->next_state = SliceSTATE_ResetSlice;
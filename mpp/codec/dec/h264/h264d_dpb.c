@@ -757,10 +757,10 @@ static RK_S32 get_smallest_poc(H264_DpbBuf_t *p_Dpb, RK_S32 *poc, RK_S32 *pos)
     return find_flag;
 }
 
-static H264_FrameStore_t *alloc_frame_store()
+static H264_FrameStore_t *alloc_frame_store(H264_DecCtx_t *p_Dec)
 {
     MPP_RET ret = MPP_ERR_UNKNOW;
-    H264_FrameStore_t *f = mpp_calloc(H264_FrameStore_t, 1);
+    H264_FrameStore_t *f = h264d_pool_get(&p_Dec->fs_pool);
     MEM_CHECK(ret, f);
 
     f->is_used = 0;
@@ -1162,8 +1162,10 @@ static MPP_RET dpb_split_field(H264dVideoCtx_t *p_Vid, H264_FrameStore_t *fs)
     }
     return ret = MPP_OK;
 __FAILED:
-    MPP_FREE(fs->top_field);
-    MPP_FREE(fs->bottom_field);
+    h264d_pool_put(&p_Vid->p_Dec->pic_pool, fs->top_field);
+    h264d_pool_put(&p_Vid->p_Dec->pic_pool, fs->bottom_field);
+    fs->top_field = NULL;
+    fs->bottom_field = NULL;
     return ret;
 }
 
@@ -1399,7 +1401,7 @@ void free_frame_store(H264_DecCtx_t *p_Dec, H264_FrameStore_t* f)
             free_storable_picture(p_Dec, f->bottom_field);
             f->bottom_field = NULL;
         }
-        MPP_FREE(f);
+        h264d_pool_put(&p_Dec->fs_pool, f);
     }
 }
 
@@ -1644,7 +1646,7 @@ void free_storable_picture(H264_DecCtx_t *p_Dec, H264_StorePic_t *p)
         if (p->mem_malloc_type == Mem_BotOnly) {
             free_dpb_mark(p_Dec, p->mem_mark, BOTTOM_FIELD);
         }
-        MPP_FREE(p);
+        h264d_pool_put(&p_Dec->pic_pool, p);
     }
 }
 
@@ -1658,12 +1660,11 @@ void free_storable_picture(H264_DecCtx_t *p_Dec, H264_StorePic_t *p)
 H264_StorePic_t *alloc_storable_picture(H264dVideoCtx_t *p_Vid, RK_S32 structure)
 {
     MPP_RET ret = MPP_ERR_UNKNOW;
-    H264_StorePic_t *s = mpp_calloc(H264_StorePic_t, 1);
+    H264_StorePic_t *s = h264d_pool_get(&p_Vid->p_Dec->pic_pool);
 
     MEM_CHECK(ret, s);
     s->view_id = -1;
     s->structure = structure;
-    (void)p_Vid;
 
     return s;
 __FAILED:
@@ -1715,7 +1716,9 @@ MPP_RET init_dpb(H264dVideoCtx_t *p_Vid, H264_DpbBuf_t *p_Dpb, RK_S32 type)  //
     RK_U32 i = 0;
     MPP_RET ret = MPP_ERR_UNKNOW;
     H264_SPS_t *active_sps = p_Vid->active_sps;
+    H264_DecCtx_t *p_Dec = p_Vid->p_Dec;
     RK_U32 dpb_size;
+    RK_S32 layers;
 
     if (!active_sps) {
         ret = MPP_NOK;
@@ -1735,6 +1738,13 @@ MPP_RET init_dpb(H264dVideoCtx_t *p_Vid, H264_DpbBuf_t *p_Dpb, RK_S32 type)  //
     p_Dpb->last_picture = NULL;
     p_Dpb->ref_frames_in_buffer = 0;
     p_Dpb->ltref_frames_in_buffer = 0;
+    //!< frame stores with frame and fields, plus fs_ilref, out_buffer, dec_pic and no_ref_pic
+    layers = p_Dpb->layer_id + 1;
+    FUN_CHECK(ret = h264d_pool_reserve(&p_Dec->fs_pool, layers * (p_Dpb->size + 1)));
+    FUN_CHECK(ret = h264d_pool_reserve(&p_Dec->pic_pool, layers * (3 * (p_Dpb->size + 2) + 2)));
+    H264D_DBG(H264D_DBG_DPB_MALLIC, "[DPB_POOL] layer %d dpb size %d reserve pic %d fs %d\n",
+              p_Dpb->layer_id, p_Dpb->size, p_Dec->pic_pool.stat.capacity,
+              p_Dec->fs_pool.stat.capacity);
     //--------
     p_Dpb->fs       = mpp_calloc(H264_FrameStore_t*, p_Dpb->size);
     p_Dpb->fs_ref   = mpp_calloc(H264_FrameStore_t*, p_Dpb->size);
@@ -1742,7 +1752,7 @@ MPP_RET init_dpb(H264dVideoCtx_t *p_Vid, H264_DpbBuf_t *p_Dpb, RK_S32 type)  //
     p_Dpb->fs_ilref = mpp_calloc(H264_FrameStore_t*, 1);  //!< inter-layer reference (for multi-layered codecs)
     MEM_CHECK(ret, p_Dpb->fs && p_Dpb->fs_ref && p_Dpb->fs_ltref && p_Dpb->fs_ilref);
     for (i = 0; i < p_Dpb->size; i++) {
-        p_Dpb->fs[i] = alloc_frame_store();
+        p_Dpb->fs[i] = alloc_frame_store(p_Dec);
         MEM_CHECK(ret, p_Dpb->fs[i]);
         p_Dpb->fs_ref[i] = NULL;
         p_Dpb->fs_ltref[i] = NULL;
@@ -1752,7 +1762,7 @@ MPP_RET init_dpb(H264dVideoCtx_t *p_Vid, H264_DpbBuf_t *p_Dpb, RK_S32 type)  //
         p_Dpb->fs[i]->anchor_pic_flag[0] = p_Dpb->fs[i]->anchor_pic_flag[1] = 0;
     }
     if (type == 2) {
-        p_Dpb->fs_ilref[0] = alloc_frame_store();
+        p_Dpb->fs_ilref[0] = alloc_frame_store(p_Dec);
         MEM_CHECK(ret, p_Dpb->fs_ilref[0]);
         //!< These may need some cleanups
         p_Dpb->fs_ilref[0]->view_id = -1;
@@ -23,9 +23,11 @@
 
 #include "mpp_log.h"
 #include "mpp_bitread.h"
+#include "mpp_ps_cache.h"
 
 #include "h264d_syntax.h"
 #include "h264d_api.h"
+#include "h264d_pool.h"
 
 
 #define H264D_DBG_ERROR             (0x00000001)
@@ -39,7 +41,7 @@
 #define H264D_DBG_PARSE_NALU        (0x00000080)
 
 #define H264D_DBG_DPB_INFO          (0x00000100)   //!< dpb size
-#define H264D_DBG_DPB_MALLIC        (0x00000200)   //!< malloc
+#define H264D_DBG_DPB_MALLIC        (0x00000200)   //!< malloc, dpb pool stat and leak
 
 
 #define H264D_DBG_DPB_REF_ERR       (0x00001000)
@@ -1135,6 +1137,9 @@ typedef struct h264_dec_ctx_t {
     RK_U32                     disable_error;
     RK_U32                     immediate_out;
     struct h264_err_ctx_t      errctx;
+    MppPsCache                 ps_cache;      //!< raw nal of spsSet and ppsSet
+    H264dPool_t                pic_pool;      //!< H264_StorePic_t, sized from dpb
+    H264dPool_t                fs_pool;       //!< H264_FrameStore_t, sized from dpb
 } H264_DecCtx_t;
 
 #endif /* __H264D_GLOBAL_H__ */
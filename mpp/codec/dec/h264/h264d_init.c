@@ -636,7 +636,7 @@ static MPP_RET alloc_decpic(H264_SLICE_t *currSlice)
 
     return ret = MPP_OK;
 __FAILED:
-    MPP_FREE(dec_pic);
+    h264d_pool_put(&p_Vid->p_Dec->pic_pool, dec_pic);
     p_Vid->dec_pic = NULL;
 
     return ret;
@@ -22,6 +22,7 @@
 
 #include "mpp_mem.h"
 #include "mpp_packet_impl.h"
+#include "mpp_startcode.h"
 #include "hal_task.h"
 
 #include "h264d_global.h"
@@ -146,6 +147,42 @@ static void find_prefix_code(RK_U8 *p_data, H264dCurStream_t *p_strm)
     }
 }
 
+/*
+ * Append input up to and including the next start code to the nalu in one
+ * copy. The caller makes sure the last byte taken was not zero, so a start
+ * code can not straddle the current position.
+ */
+static MPP_RET copy_nalu_span(H264dInputCtx_t *p_Inp, H264dCurStream_t *p_strm,
+                              MppPacketImpl *pkt_impl)
+{
+    MPP_RET ret = MPP_ERR_UNKNOW;
+    RK_U8 *src = &p_Inp->in_buf[p_strm->nalu_offset];
+    RK_U32 len = (RK_U32)pkt_impl->length;
+    RK_U32 pos = mpp_find_start_code(src, len);
+    RK_U32 i;
+
+    if (pos < len)
+        len = pos + START_PREFIX_3BYTE;
+
+    if (p_strm->nalu_len + len > p_strm->nalu_max_size) {
+        RK_U32 add_size = p_strm->nalu_len + len - p_strm->nalu_max_size;
+        FUN_CHECK(ret = realloc_buffer(&p_strm->nalu_buf, &p_strm->nalu_max_size,
+                                       MPP_MAX(NALU_BUF_ADD_SIZE, add_size)));
+    }
+    memcpy(&p_strm->nalu_buf[p_strm->nalu_len], src, len);
+    p_strm->nalu_len += len;
+    p_strm->nalu_offset += len;
+    pkt_impl->length -= len;
+
+    for (i = len > 4 ? len - 4 : 0; i < len; i++)
+        p_strm->prefixdata = (p_strm->prefixdata << 8) | src[i];
+    p_strm->curdata = &src[len - 1];
+
+    return ret = MPP_OK;
+__FAILED:
+    return ret;
+}
+
 static MPP_RET parser_nalu_header(H264_SLICE_t *currSlice)
 {
     MPP_RET ret = MPP_ERR_UNKNOW;
@@ -552,6 +589,12 @@ MPP_RET parse_prepare(H264dInputCtx_t *p_Inp, H264dCurCtx_t *p_Cur)
         goto __RETURN;
     }
     while (pkt_impl->length > 0) {
+        //!< nalu header judged, take the rest of the nalu in bulk
+        if (p_strm->startcode_found && p_strm->nalu_len >= NALU_TYPE_EXT_LENGTH
+            && (p_strm->prefixdata & 0xFF)) {
+            FUN_CHECK(ret = copy_nalu_span(p_Inp, p_strm, pkt_impl));
+            goto __FIND_PREFIX;
+        }
         p_strm->curdata = &p_Inp->in_buf[p_strm->nalu_offset++];
         pkt_impl->length--;
         p_strm->prefixdata = (p_strm->prefixdata << 8) | (*p_strm->curdata);
@@ -573,6 +616,7 @@ MPP_RET parse_prepare(H264dInputCtx_t *p_Inp, H264dCurCtx_t *p_Cur)
             }
         }
 
+    __FIND_PREFIX:
         find_prefix_code(p_strm->curdata, p_strm);
 
         if (p_strm->endcode_found) {
@@ -620,6 +664,12 @@ MPP_RET parse_prepare_fast(H264dInputCtx_t *p_Inp, H264dCurCtx_t *p_Cur)
     p_Inp->task_valid = 0;
 
     while (pkt_impl->length > 0) {
+        //!< nalu type judged, take the rest of the nalu in bulk
+        if (p_strm->startcode_found && p_strm->nalu_len >= 1
+            && (p_strm->prefixdata & 0xFF)) {
+            FUN_CHECK(ret = copy_nalu_span(p_Inp, p_strm, pkt_impl));
+            goto __FIND_PREFIX;
+        }
         p_strm->curdata = &p_Inp->in_buf[p_strm->nalu_offset++];
         pkt_impl->length--;
         p_strm->prefixdata = (p_strm->prefixdata << 8) | (*p_strm->curdata);
@@ -646,6 +696,7 @@ MPP_RET parse_prepare_fast(H264dInputCtx_t *p_Inp, H264dCurCtx_t *p_Cur)
             }
         }
 
+    __FIND_PREFIX:
         find_prefix_code(p_strm->curdata, p_strm);
 
         if (p_strm->endcode_found) {
@@ -0,0 +1,144 @@
+/*
+ *
+ * Copyright 2015 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_TAG "h264d_pool"
+
+#include <string.h>
+
+#include "mpp_log.h"
+#include "mpp_mem.h"
+#include "mpp_common.h"
+
+#include "h264d_pool.h"
+
+typedef struct h264d_pool_chunk_t {
+    struct h264d_pool_chunk_t  *next;
+    RK_U8                      *start;
+    RK_U8                      *end;
+} H264dPoolChunk_t;
+
+#define POOL_CHUNK_HEAD     MPP_ALIGN(sizeof(H264dPoolChunk_t), 16)
+
+MPP_RET h264d_pool_init(H264dPool_t *pool, const char *name, RK_S32 elem_size, RK_U32 enable)
+{
+    if (NULL == pool || elem_size <= 0) {
+        mpp_err_f("invalid pool %p elem_size %d\n", pool, elem_size);
+        return MPP_ERR_VALUE;
+    }
+
+    memset(pool, 0, sizeof(*pool));
+    pool->name = name;
+    pool->elem_size = MPP_ALIGN(elem_size, sizeof(void *));
+    pool->enable = enable;
+
+    return MPP_OK;
+}
+
+void h264d_pool_deinit(H264dPool_t *pool)
+{
+    H264dPoolChunk_t *chunk;
+
+    if (NULL == pool)
+        return;
+
+    chunk = pool->chunks;
+    while (chunk) {
+        H264dPoolChunk_t *next = chunk->next;
+
+        mpp_free(chunk);
+        chunk = next;
+    }
+    pool->chunks = NULL;
+    pool->free_cnt = 0;
+    pool->stat.capacity = 0;
+    MPP_FREE(pool->free_list);
+}
+
+MPP_RET h264d_pool_reserve(H264dPool_t *pool, RK_S32 count)
+{
+    H264dPoolChunk_t *chunk;
+    void **free_list;
+    RK_S32 add = count - pool->stat.capacity;
+    RK_S32 i;
+
+    if (!pool->enable || add <= 0)
+        return MPP_OK;
+
+    // the list holds every object at most once, size it for the new capacity
+    free_list = mpp_realloc(pool->free_list, void *, count);
+    if (NULL == free_list)
+        return MPP_ERR_MALLOC;
+    pool->free_list = free_list;
+
+    chunk = (H264dPoolChunk_t *)mpp_malloc_size(RK_U8, POOL_CHUNK_HEAD + (size_t)pool->elem_size * add);
+    if (NULL == chunk)
+        return MPP_ERR_MALLOC;
+
+    chunk->start = (RK_U8 *)chunk + POOL_CHUNK_HEAD;
+    chunk->end = chunk->start + (size_t)pool->elem_size * add;
+    chunk->next = pool->chunks;
+    pool->chunks = chunk;
+
+    for (i = 0; i < add; i++)
+        pool->free_list[pool->free_cnt++] = chunk->start + (size_t)pool->elem_size * i;
+
+    pool->stat.capacity = count;
+
+    return MPP_OK;
+}
+
+void *h264d_pool_get(H264dPool_t *pool)
+{
+    void *obj;
+
+    if (pool->free_cnt) {
+        obj = pool->free_list[--pool->free_cnt];
+        memset(obj, 0, pool->elem_size);
+    } else {
+        obj = mpp_calloc_size(void, pool->elem_size);
+        if (NULL == obj)
+            return NULL;
+        pool->stat.heap_cnt++;
+    }
+
+    pool->stat.get_cnt++;
+    pool->stat.used++;
+    if (pool->stat.peak < pool->stat.used)
+        pool->stat.peak = pool->stat.used;
+
+    return obj;
+}
+
+void h264d_pool_put(H264dPool_t *pool, void *obj)
+{
+    H264dPoolChunk_t *chunk = pool->chunks;
+
+    if (NULL == obj)
+        return;
+
+    pool->stat.used--;
+
+    while (chunk) {
+        if ((RK_U8 *)obj >= chunk->start && (RK_U8 *)obj < chunk->end) {
+            pool->free_list[pool->free_cnt++] = obj;
+            return;
+        }
+        chunk = chunk->next;
+    }
+
+    mpp_free(obj);
+}
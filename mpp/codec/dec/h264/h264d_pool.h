@@ -0,0 +1,63 @@
+/*
+*
+* Copyright 2015 Rockchip Electronics Co. LTD
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef _H264D_POOL_H_
+#define _H264D_POOL_H_
+
+#include "rk_type.h"
+#include "mpp_err.h"
+
+/*
+ * Fixed size object pool of one decoder, used for the store pictures and
+ * frame stores of the dpb. The capacity is reserved from the dpb size when
+ * the dpb is initialized and only grows, objects never move. A get on an
+ * empty pool falls back to the heap and is counted, so the stat shows when
+ * the reservation is too small.
+ */
+typedef struct h264d_pool_stat_t {
+    RK_S32      capacity;   //!< objects reserved in the chunks
+    RK_S32      used;       //!< objects not returned yet, heap ones included
+    RK_S32      peak;
+    RK_U32      get_cnt;
+    RK_U32      heap_cnt;   //!< gets served by the heap
+} H264dPoolStat_t;
+
+typedef struct h264d_pool_t {
+    const char                 *name;
+    RK_S32                      elem_size;
+    RK_U32                      enable;
+    struct h264d_pool_chunk_t  *chunks;
+    void                      **free_list;
+    RK_S32                      free_cnt;
+    H264dPoolStat_t             stat;
+} H264dPool_t;
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+MPP_RET h264d_pool_init(H264dPool_t *pool, const char *name, RK_S32 elem_size, RK_U32 enable);
+void    h264d_pool_deinit(H264dPool_t *pool);
+MPP_RET h264d_pool_reserve(H264dPool_t *pool, RK_S32 count);
+void   *h264d_pool_get(H264dPool_t *pool);
+void    h264d_pool_put(H264dPool_t *pool, void *obj);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* _H264D_POOL_H_ */
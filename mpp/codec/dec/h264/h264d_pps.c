@@ -134,6 +134,15 @@ MPP_RET process_pps(H264_SLICE_t *currSlice)
     H264dCurCtx_t *p_Cur = currSlice->p_Cur;
     BitReadCtx_t *p_bitctx = &p_Cur->bitctx;
     H264_PPS_t *cur_pps = &p_Cur->pps;
+    H264_Nalu_t *nalu = &p_Cur->nalu;
+    MppPsCache ps_cache = currSlice->p_Dec->ps_cache;
+    RK_S32 id = mpp_ps_cache_find(ps_cache, MPP_PS_PPS, nalu->sodb_buf, nalu->sodb_len);
+
+    if (id >= 0) {
+        //!< same pps again, only restore the state of parsing it
+        memcpy(cur_pps, &currSlice->p_Vid->ppsSet[id], sizeof(H264_PPS_t));
+        return ret = MPP_OK;
+    }
 
     reset_curpps_data(cur_pps);// reset
 
@@ -141,6 +150,8 @@ MPP_RET process_pps(H264_SLICE_t *currSlice)
     //!< MakePPSavailable
     ASSERT(cur_pps->Valid == 1);
     memcpy(&currSlice->p_Vid->ppsSet[cur_pps->pic_parameter_set_id], cur_pps, sizeof(H264_PPS_t));
+    mpp_ps_cache_update(ps_cache, MPP_PS_PPS, cur_pps->pic_parameter_set_id,
+                        nalu->sodb_buf, nalu->sodb_len);
 
     return ret = MPP_OK;
 __FAILED:
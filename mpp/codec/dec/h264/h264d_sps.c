@@ -446,16 +446,30 @@ MPP_RET process_sps(H264_SLICE_t *currSlice)
     H264dCurCtx_t *p_Cur = currSlice->p_Cur;
     BitReadCtx_t *p_bitctx = &p_Cur->bitctx;
     H264_SPS_t *cur_sps = &p_Cur->sps;
-
-    reset_cur_sps_data(cur_sps); // reset
-    //!< parse sps
-    FUN_CHECK(ret = parser_sps(p_bitctx, cur_sps, currSlice->p_Dec));
-    //!< decide "max_dec_frame_buffering" for DPB
-    FUN_CHECK(ret = get_max_dec_frame_buf_size(cur_sps));
-    //!< make SPS available, copy
-    if (cur_sps->Valid) {
-        memcpy(&currSlice->p_Vid->spsSet[cur_sps->seq_parameter_set_id], cur_sps, sizeof(H264_SPS_t));
+    H264_Nalu_t *nalu = &p_Cur->nalu;
+    MppPsCache ps_cache = currSlice->p_Dec->ps_cache;
+    RK_S32 chroma_format_idc = cur_sps->chroma_format_idc;
+    RK_S32 id = mpp_ps_cache_find(ps_cache, MPP_PS_SPS, nalu->sodb_buf, nalu->sodb_len);
+
+    if (id >= 0) {
+        //!< same sps again, only restore the state of parsing it
+        memcpy(cur_sps, &currSlice->p_Vid->spsSet[id], sizeof(H264_SPS_t));
+    } else {
+        reset_cur_sps_data(cur_sps); // reset
+        //!< parse sps
+        FUN_CHECK(ret = parser_sps(p_bitctx, cur_sps, currSlice->p_Dec));
+        //!< decide "max_dec_frame_buffering" for DPB
+        FUN_CHECK(ret = get_max_dec_frame_buf_size(cur_sps));
+        //!< make SPS available, copy
+        if (cur_sps->Valid) {
+            memcpy(&currSlice->p_Vid->spsSet[cur_sps->seq_parameter_set_id], cur_sps, sizeof(H264_SPS_t));
+            mpp_ps_cache_update(ps_cache, MPP_PS_SPS, cur_sps->seq_parameter_set_id,
+                                nalu->sodb_buf, nalu->sodb_len);
+        }
     }
+    //!< pps scaling lists are parsed with the chroma format of the last sps
+    if (cur_sps->chroma_format_idc != chroma_format_idc)
+        mpp_ps_cache_drop(ps_cache, MPP_PS_PPS, -1);
 
     return ret = MPP_OK;
 __FAILED:
@@ -0,0 +1,404 @@
+/*
+ * Copyright 2015 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_TAG "h264d_dpb_pool_test"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "mpp_log.h"
+#include "mpp_time.h"
+#include "mpp_common.h"
+#include "mpp_packet.h"
+
+#include "h264d_api.h"
+#include "h264d_global.h"
+
+#define TEST_FRAMES         3000
+#define TEST_SLICE_DATA     32
+#define TEST_MAX_NAL        128
+/* top field of a p frame, its picture gets a new frame slot */
+#define TEST_FAIL_FIELD     200
+
+/* msb first rbsp writer, enough for the parameter sets and slice headers */
+typedef struct TestBits_t {
+    RK_U8           buf[TEST_MAX_NAL];
+    RK_S32          bit;
+} TestBits;
+
+typedef struct TestStream_t {
+    RK_U8           *data;
+    RK_S32          size;
+    RK_S32          *field_pos;
+    RK_S32          fields;
+} TestStream;
+
+typedef struct TestCtx_t {
+    MppBufSlots     frame_slots;
+    MppBufSlots     packet_slots;
+    H264_DecCtx_t   *p_Dec;
+    RK_U32          displayed;
+} TestCtx;
+
+/* linked with --wrap so that the test can run out of frame slots */
+static RK_U32 slot_fail = 0;
+
+MPP_RET __real_mpp_buf_slot_get_unused(MppBufSlots slots, RK_S32 *index);
+
+MPP_RET __wrap_mpp_buf_slot_get_unused(MppBufSlots slots, RK_S32 *index)
+{
+    if (slot_fail) {
+        *index = -1;
+        return MPP_NOK;
+    }
+
+    return __real_mpp_buf_slot_get_unused(slots, index);
+}
+
+static void put_bits(TestBits *b, RK_U32 val, RK_S32 n)
+{
+    while (n--) {
+        if ((val >> n) & 1)
+            b->buf[b->bit >> 3] |= 0x80 >> (b->bit & 7);
+        b->bit++;
+    }
+}
+
+static void put_ue(TestBits *b, RK_U32 val)
+{
+    RK_S32 len = 0;
+
+    while ((val + 1) >> (len + 1))
+        len++;
+    put_bits(b, 0, len);
+    put_bits(b, val + 1, len + 1);
+}
+
+/* write the rbsp with trailing bits and emulation prevention as one nal */
+static void put_nal(TestStream *s, RK_U8 header, TestBits *b)
+{
+    RK_U8 *p = s->data + s->size;
+    RK_S32 zeros = 0;
+    RK_S32 i;
+
+    put_bits(b, 1, 1);
+    memcpy(p, "\0\0\0\1", 4);
+    p[4] = header;
+    p += 5;
+
+    for (i = 0; i < (b->bit + 7) >> 3; i++) {
+        if (zeros >= 2 && b->buf[i] <= 3) {
+            *p++ = 3;
+            zeros = 0;
+        }
+        zeros = b->buf[i] ? 0 : zeros + 1;
+        *p++ = b->buf[i];
+    }
+    s->size = p - s->data;
+}
+
+/* main profile level 3.0 720x576 field coding, poc type 2, 4 ref frames */
+static void put_sps_pps(TestStream *s)
+{
+    TestBits b;
+
+    memset(&b, 0, sizeof(b));
+    put_bits(&b, 77, 8);
+    put_bits(&b, 0, 8);
+    put_bits(&b, 30, 8);
+    put_ue(&b, 0);          // seq_parameter_set_id
+    put_ue(&b, 0);          // log2_max_frame_num_minus4
+    put_ue(&b, 2);          // pic_order_cnt_type
+    put_ue(&b, 4);          // max_num_ref_frames
+    put_bits(&b, 0, 1);     // gaps_in_frame_num_value_allowed_flag
+    put_ue(&b, 44);         // pic_width_in_mbs_minus1
+    put_ue(&b, 17);         // pic_height_in_map_units_minus1
+    put_bits(&b, 0, 1);     // frame_mbs_only_flag
+    put_bits(&b, 0, 1);     // mb_adaptive_frame_field_flag
+    put_bits(&b, 1, 1);     // direct_8x8_inference_flag
+    put_bits(&b, 0, 2);     // frame_cropping_flag, vui_parameters_present_flag
+    put_nal(s, 0x67, &b);
+
+    memset(&b, 0, sizeof(b));
+    put_ue(&b, 0);          // pic_parameter_set_id
+    put_ue(&b, 0);          // seq_parameter_set_id
+    put_bits(&b, 0, 2);     // entropy_coding_mode_flag, bottom_field_pic_order_in_frame_present_flag
+    put_ue(&b, 0);          // num_slice_groups_minus1
+    put_ue(&b, 0);          // num_ref_idx_l0_default_active_minus1
+    put_ue(&b, 0);          // num_ref_idx_l1_default_active_minus1
+    put_bits(&b, 0, 3);     // weighted_pred_flag, weighted_bipred_idc
+    put_ue(&b, 0);          // pic_init_qp_minus26
+    put_ue(&b, 0);          // pic_init_qs_minus26
+    put_ue(&b, 0);          // chroma_qp_index_offset
+    put_bits(&b, 0, 3);     // deblocking, constrained_intra_pred, redundant_pic_cnt
+    put_nal(s, 0x68, &b);
+}
+
+/* one field slice, the idr top field is intra and all others predict */
+static void put_field(TestStream *s, RK_S32 frame, RK_S32 bottom)
+{
+    RK_S32 idr = !frame && !bottom;
+    TestBits b;
+    RK_S32 i;
+
+    memset(&b, 0, sizeof(b));
+    put_ue(&b, 0);                  // first_mb_in_slice
+    put_ue(&b, idr ? 7 : 5);        // slice_type I or P
+    put_ue(&b, 0);                  // pic_parameter_set_id
+    put_bits(&b, frame & 15, 4);    // frame_num
+    put_bits(&b, 1, 1);             // field_pic_flag
+    put_bits(&b, bottom, 1);        // bottom_field_flag
+    if (idr) {
+        put_ue(&b, 0);              // idr_pic_id
+        put_bits(&b, 0, 2);         // no_output_of_prior_pics_flag, long_term_reference_flag
+    } else {
+        put_bits(&b, 0, 1);         // num_ref_idx_active_override_flag
+        put_bits(&b, 0, 1);         // ref_pic_list_modification_flag_l0
+        put_bits(&b, 0, 1);         // adaptive_ref_pic_marking_mode_flag
+    }
+    put_ue(&b, 0);                  // slice_qp_delta
+    // macroblock data is left to the hardware, any bytes do for the parser
+    for (i = 0; i < TEST_SLICE_DATA; i++)
+        put_bits(&b, 0x5a, 8);
+
+    s->field_pos[s->fields++] = s->size;
+    put_nal(s, idr ? 0x65 : 0x61, &b);
+}
+
+static MPP_RET build_stream(TestStream *s, RK_S32 frames)
+{
+    RK_S32 i;
+
+    memset(s, 0, sizeof(*s));
+    s->data = malloc((size_t)(2 * frames + 2) * (TEST_MAX_NAL + 8));
+    s->field_pos = malloc(sizeof(RK_S32) * (2 * frames + 1));
+    if (NULL == s->data || NULL == s->field_pos)
+        return MPP_ERR_MALLOC;
+
+    put_sps_pps(s);
+    for (i = 0; i < frames; i++) {
+        put_field(s, i, 0);
+        put_field(s, i, 1);
+    }
+    // the first field carries the parameter sets
+    s->field_pos[0] = 0;
+    s->field_pos[s->fields] = s->size;
+
+    return MPP_OK;
+}
+
+/* what mpp_dec and the hal do with the slots around one parsed picture */
+static void finish_task(TestCtx *ctx, HalDecTask *task)
+{
+    RK_S32 index;
+    RK_U32 i;
+
+    if (mpp_buf_slot_is_changed(ctx->frame_slots))
+        mpp_buf_slot_ready(ctx->frame_slots);
+
+    if (task->output >= 0)
+        mpp_buf_slot_clr_flag(ctx->frame_slots, task->output, SLOT_HAL_OUTPUT);
+    for (i = 0; i < MPP_ARRAY_ELEMS(task->refer); i++) {
+        if (task->refer[i] >= 0)
+            mpp_buf_slot_clr_flag(ctx->frame_slots, task->refer[i], SLOT_HAL_INPUT);
+    }
+
+    while (MPP_OK == mpp_buf_slot_dequeue(ctx->frame_slots, &index, QUEUE_DISPLAY)) {
+        mpp_buf_slot_clr_flag(ctx->frame_slots, index, SLOT_QUEUE_USE);
+        ctx->displayed++;
+    }
+}
+
+static MPP_RET decode(TestCtx *ctx, MppPacket pkt)
+{
+    HalDecTask task;
+    RK_U32 i;
+
+    do {
+        memset(&task, 0, sizeof(task));
+        task.input = -1;
+        task.output = -1;
+        for (i = 0; i < MPP_ARRAY_ELEMS(task.refer); i++)
+            task.refer[i] = -1;
+
+        if (api_h264d_parser.prepare(ctx->p_Dec, pkt, &task))
+            return MPP_NOK;
+
+        if (task.valid) {
+            if (api_h264d_parser.parse(ctx->p_Dec, &task) || task.flags.parse_err)
+                return MPP_NOK;
+            finish_task(ctx, &task);
+        } else if (task.flags.eos) {
+            finish_task(ctx, &task);
+        }
+    } while (mpp_packet_get_length(pkt));
+
+    return MPP_OK;
+}
+
+/*
+ * decode the stream one field per packet and report the dpb object traffic,
+ * with fail_at the picture of that field finds no frame slot and the stream
+ * ends there
+ */
+static MPP_RET run(TestStream *s, RK_U32 pool, RK_S32 fail_at)
+{
+    MPP_RET ret = MPP_NOK;
+    TestCtx ctx;
+    ParserCfg cfg;
+    MppPacket pkt = NULL;
+    H264dPoolStat_t pic, fs;
+    H264_DpbBuf_t *p_Dpb;
+    RK_S64 time;
+    RK_S32 fields = (fail_at >= 0) ? fail_at : s->fields;
+    RK_S32 i;
+
+    memset(&ctx, 0, sizeof(ctx));
+    setenv("h264d_dpb_pool", pool ? "1" : "0", 1);
+
+    mpp_buf_slot_init(&ctx.frame_slots);
+    mpp_buf_slot_init(&ctx.packet_slots);
+    ctx.p_Dec = calloc(1, api_h264d_parser.ctx_size);
+    if (NULL == ctx.frame_slots || NULL == ctx.packet_slots || NULL == ctx.p_Dec)
+        goto RET;
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.coding = MPP_VIDEO_CodingAVC;
+    cfg.frame_slots = ctx.frame_slots;
+    cfg.packet_slots = ctx.packet_slots;
+    cfg.need_split = 1;
+    if (api_h264d_parser.init(ctx.p_Dec, &cfg))
+        goto RET;
+
+    mpp_packet_init(&pkt, s->data, s->size);
+
+    time = mpp_time();
+    for (i = 0; i < fields; i++) {
+        mpp_packet_set_pos(pkt, s->data + s->field_pos[i]);
+        mpp_packet_set_length(pkt, s->field_pos[i + 1] - s->field_pos[i]);
+        if (decode(&ctx, pkt)) {
+            mpp_err("decode field %d failed\n", i);
+            goto RET;
+        }
+    }
+
+    // the picture is parsed once the next field starts, fail from here on
+    if (fail_at >= 0) {
+        MPP_RET fail = MPP_OK;
+
+        slot_fail = 1;
+        for (; i < s->fields && !fail; i++) {
+            mpp_packet_set_pos(pkt, s->data + s->field_pos[i]);
+            mpp_packet_set_length(pkt, s->field_pos[i + 1] - s->field_pos[i]);
+            fail = decode(&ctx, pkt);
+        }
+        slot_fail = 0;
+
+        if (!fail) {
+            mpp_err("no picture failed without frame slot\n");
+            goto RET;
+        }
+    }
+
+    mpp_packet_set_pos(pkt, s->data);
+    mpp_packet_set_length(pkt, 0);
+    mpp_packet_set_eos(pkt);
+    if (decode(&ctx, pkt)) {
+        mpp_err("decode eos failed\n");
+        goto RET;
+    }
+    time = mpp_time() - time;
+
+    pic = ctx.p_Dec->pic_pool.stat;
+    fs = ctx.p_Dec->fs_pool.stat;
+    p_Dpb = ctx.p_Dec->p_Vid->p_Dpb_layer[0];
+
+    mpp_log("pool %d %d fields %d frames out %.1f us per frame\n", pool,
+            fields, ctx.displayed, (double)time / TEST_FRAMES);
+    mpp_log("pool %d per frame pic get %.2f fs get %.2f heap alloc %.2f\n", pool,
+            (double)pic.get_cnt / TEST_FRAMES, (double)fs.get_cnt / TEST_FRAMES,
+            (double)(pic.heap_cnt + fs.heap_cnt) / TEST_FRAMES);
+    mpp_log("pool %d capacity pic %d fs %d peak pic %d fs %d\n", pool,
+            pic.capacity, fs.capacity, pic.peak, fs.peak);
+
+    // the last field pair is only output on eos
+    if (ctx.displayed < (RK_U32)fields / 2 - 1) {
+        mpp_err("output %d frames of %d\n", ctx.displayed, fields / 2);
+        goto RET;
+    }
+
+    if (pool && (pic.heap_cnt || fs.heap_cnt || pic.peak > pic.capacity)) {
+        mpp_err("pool exhausted pic heap %d fs heap %d\n", pic.heap_cnt, fs.heap_cnt);
+        goto RET;
+    }
+
+    // after the eos flush the dpb holds its empty frame stores and no_ref_pic
+    if (pic.used != 1 || fs.used != (RK_S32)p_Dpb->size) {
+        mpp_err("leak pic %d fs %d with dpb size %d\n", pic.used, fs.used, p_Dpb->size);
+        goto RET;
+    }
+
+    ret = MPP_OK;
+RET:
+    if (pkt)
+        mpp_packet_deinit(&pkt);
+    if (ctx.p_Dec) {
+        api_h264d_parser.deinit(ctx.p_Dec);
+        free(ctx.p_Dec);
+    }
+    if (ctx.frame_slots)
+        mpp_buf_slot_deinit(ctx.frame_slots);
+    if (ctx.packet_slots)
+        mpp_buf_slot_deinit(ctx.packet_slots);
+
+    return ret;
+}
+
+int main()
+{
+    MPP_RET ret = MPP_NOK;
+    TestStream s;
+
+    mpp_log("h264d_dpb_pool_test start\n");
+
+    if (build_stream(&s, TEST_FRAMES)) {
+        mpp_err("h264d_dpb_pool_test build stream failed\n");
+        goto TEST_FAILED;
+    }
+
+    // heap objects as before the pool for comparison
+    if (run(&s, 0, -1))
+        goto TEST_FAILED;
+
+    if (run(&s, 1, -1))
+        goto TEST_FAILED;
+
+    // error path of the picture allocation in both modes
+    if (run(&s, 0, TEST_FAIL_FIELD) || run(&s, 1, TEST_FAIL_FIELD))
+        goto TEST_FAILED;
+
+    ret = MPP_OK;
+TEST_FAILED:
+    free(s.data);
+    free(s.field_pos);
+
+    if (ret)
+        mpp_log("h264d_dpb_pool_test failed\n");
+    else
+        mpp_log("h264d_dpb_pool_test success\n");
+
+    return ret;
+}
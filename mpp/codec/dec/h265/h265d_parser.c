@@ -1238,6 +1238,45 @@ fail:
     return ret;
 }
 
+/*
+ * A parameter set with the same bytes as the one in the list is skipped, the
+ * list entry and anything depending on it stays as it is.
+ */
+static RK_S32 hevc_decode_nal_ps(HEVCContext *s, const RK_U8 *nal, int length)
+{
+    MppPsType type = MPP_PS_PPS;
+    RK_S32 ret;
+    RK_S32 id;
+
+    if (s->nal_unit_type == NAL_VPS)
+        type = MPP_PS_VPS;
+    else if (s->nal_unit_type == NAL_SPS)
+        type = MPP_PS_SPS;
+
+    id = mpp_ps_cache_find(s->ps_cache, type, nal, length);
+    if (id >= 0) {
+        if (type == MPP_PS_SPS)
+            s->sps_list_of_updated[id] = 1;
+        else if (type == MPP_PS_PPS)
+            s->pps_list_of_updated[id] = 1;
+        return 0;
+    }
+
+    // some rejects return 0 without an id, those are not cached
+    s->ps_id = -1;
+    if (type == MPP_PS_VPS)
+        ret = mpp_hevc_decode_nal_vps(s);
+    else if (type == MPP_PS_SPS)
+        ret = mpp_hevc_decode_nal_sps(s);
+    else
+        ret = mpp_hevc_decode_nal_pps(s);
+
+    if (ret >= 0 && s->ps_id >= 0)
+        mpp_ps_cache_update(s->ps_cache, type, s->ps_id, nal, length);
+
+    return ret;
+}
+
 static RK_S32 parser_nal_unit(HEVCContext *s, const RK_U8 *nal, int length)
 {
 
@@ -1262,21 +1301,21 @@ static RK_S32 parser_nal_unit(HEVCContext *s, const RK_U8 *nal, int length)
 
     switch (s->nal_unit_type) {
     case NAL_VPS:
-        ret = mpp_hevc_decode_nal_vps(s);
+        ret = hevc_decode_nal_ps(s, nal, length);
         if (ret < 0) {
             mpp_err("mpp_hevc_decode_nal_vps error ret = %d", ret);
             goto fail;
         }
         break;
     case NAL_SPS:
-        ret = mpp_hevc_decode_nal_sps(s);
+        ret = hevc_decode_nal_ps(s, nal, length);
         if (ret < 0) {
             mpp_err("mpp_hevc_decode_nal_sps error ret = %d", ret);
             goto fail;
         }
         break;
     case NAL_PPS:
-        ret = mpp_hevc_decode_nal_pps(s);
+        ret = hevc_decode_nal_ps(s, nal, length);
         if (ret < 0) {
             mpp_err("mpp_hevc_decode_nal_pps error ret = %d", ret);
             goto fail;
@@ -1403,13 +1442,14 @@ typedef union {
 #ifndef MPP_RN32A
 #define MPP_RN32A(p) (((const mpp_alias32*)(p))->u32)
 #endif
-RK_S32 mpp_hevc_extract_rbsp(HEVCContext *s, const RK_U8 *src, int length,
-                             HEVCNAL *nal)
+/*
+ * Find the end of the nal at src. The emulation prevention bytes are kept
+ * and skipped by the bit reader, so the nal is used in place.
+ */
+RK_S32 mpp_hevc_extract_rbsp(const RK_U8 *src, int length, HEVCNAL *nal)
 {
     RK_S32 i;
 
-    s->skipped_bytes = 0;
-
 #define STARTCODE_TEST                                              \
     if (i + 2 < length && src[i + 1] == 0 && src[i + 2] < 3) {      \
             /* startcode, so we must be past the end */             \
@@ -1445,23 +1485,9 @@ RK_S32 mpp_hevc_extract_rbsp(HEVCContext *s, const RK_U8 *src, int length,
     }
 #endif
 
-    if (length + MPP_INPUT_BUFFER_PADDING_SIZE > nal->rbsp_buffer_size) {
-        RK_S32 min_size = length + MPP_INPUT_BUFFER_PADDING_SIZE;
-        mpp_free(nal->rbsp_buffer);
-        nal->rbsp_buffer = NULL;
-        min_size = MPP_MAX(17 * min_size / 16 + 32, min_size);
-        nal->rbsp_buffer = mpp_malloc(RK_U8, min_size);
-        if (nal->rbsp_buffer == NULL) {
-            min_size = 0;
-        }
-        nal->rbsp_buffer_size = min_size;
-    }
-
-    memcpy(nal->rbsp_buffer, src, length);
-    nal->data = nal->rbsp_buffer;
+    nal->data = src;
     nal->size = length;
 
-    memset(nal->rbsp_buffer + length, 0, MPP_INPUT_BUFFER_PADDING_SIZE);
     return length;
 }
 
@@ -1469,6 +1495,7 @@ static RK_S32 split_nal_units(HEVCContext *s, RK_U8 *buf, RK_U32 length)
 {
     RK_S32 i, consumed;
     MPP_RET ret = MPP_OK;
+    RK_U8 *start = buf;
     s->nb_nals = 0;
     while (length >= 4) {
         HEVCNAL *nal;
@@ -1550,7 +1577,8 @@ static RK_S32 split_nal_units(HEVCContext *s, RK_U8 *buf, RK_U32 length)
         }
         nal = &s->nals[s->nb_nals];
 
-        consumed = mpp_hevc_extract_rbsp(s, buf, extract_length, nal);
+        nal->offset = (RK_S32)(buf - start);
+        consumed = mpp_hevc_extract_rbsp(buf, extract_length, nal);
 
         s->nb_nals++;
 
@@ -1744,6 +1772,8 @@ MPP_RET h265d_prepare(void *ctx, MppPacket pkt, HalDecTask *task)
 
     if (MPP_OK == ret) {
         if (MPP_OK == h265d_syntax_fill_slice(s->h265dctx, task->input)) {
+            h265d_dbg(H265D_DBG_STREAM, "frame %d copy %d bytes total %lld\n",
+                      s->nb_frame, s->frame_copy_bytes, s->total_copy_bytes);
             task->valid = 1;
             task->input_packet = s->input_packet;
         }
@@ -1834,8 +1864,10 @@ MPP_RET h265d_deinit(void *ctx)
 
     s->HEVClc = NULL;
 
-    for (i = 0; i < s->nals_allocated; i++)
-        mpp_free(s->nals[i].rbsp_buffer);
+    mpp_ps_cache_deinit(s->ps_cache);
+    s->ps_cache = NULL;
+
+    mpp_free(s->nal_arena);
 
     if (s->nals) {
         mpp_free(s->nals);
@@ -1862,6 +1894,12 @@ MPP_RET h265d_deinit(void *ctx)
     return 0;
 }
 
+static const RK_S32 ps_cache_ids[MPP_PS_TYPE_BUTT] = {
+    MAX_VPS_COUNT,
+    MAX_SPS_COUNT,
+    MAX_PPS_COUNT,
+};
+
 static RK_S32 hevc_init_context(H265dContext_t *h265dctx)
 {
     HEVCContext *s = h265dctx->priv_data;
@@ -1873,6 +1911,9 @@ static RK_S32 hevc_init_context(H265dContext_t *h265dctx)
     if (!s->HEVClc)
         goto fail;
 
+    if (mpp_ps_cache_init(&s->ps_cache, MODULE_TAG, ps_cache_ids))
+        goto fail;
+
     for (i = 0; i < MPP_ARRAY_ELEMS(s->DPB); i++) {
         s->DPB[i].slot_index = 0xff;
         s->DPB[i].poc = INT_MAX;
@@ -35,6 +35,7 @@
 #include "mpp_mem.h"
 #include "mpp_bitread.h"
 #include "mpp_buf_slot.h"
+#include "mpp_ps_cache.h"
 
 #include "hal_task.h"
 #include "h265d_codec.h"
@@ -51,6 +52,7 @@ extern RK_U32 h265d_debug;
 #define H265D_DBG_GLOBAL            (0x00000040)
 #define H265D_DBG_REF               (0x00000080)
 #define H265D_DBG_TIME              (0x00000100)
+#define H265D_DBG_STREAM            (0x00000200)
 
 
 #define h265d_dbg(flag, fmt, ...) _mpp_dbg(h265d_debug, flag, fmt, ## __VA_ARGS__)
@@ -459,9 +461,10 @@ typedef struct HEVCFrame {
 } HEVCFrame;
 
 typedef struct HEVCNAL {
-    RK_U8 *rbsp_buffer;
-    RK_S32 rbsp_buffer_size;
+    /* position in the stream given to prepare, nothing is copied by split */
+    RK_S32 offset;
     RK_S32 size;
+    /* the source on split, the stream buffer or nal arena after fill slice */
     const RK_U8 *data;
 } HEVCNAL;
 
@@ -489,6 +492,11 @@ typedef struct HEVCContext {
     RK_U8 *sps_list[MAX_SPS_COUNT];
     RK_U8 *pps_list[MAX_PPS_COUNT];
 
+    /* raw nals of the lists above, re-sends are not parsed again */
+    MppPsCache ps_cache;
+    /* id of the parameter set decoded last, -1 if it was rejected */
+    RK_S32 ps_id;
+
     SliceHeader sh;
 
     ///< candidate references for the current frame
@@ -519,13 +527,20 @@ typedef struct HEVCContext {
     RK_U16 seq_output;
 
     RK_S32 wpp_err;
-    RK_S32 skipped_bytes;
 
     RK_U8 *data;
 
     HEVCNAL *nals;
     RK_S32 nb_nals;
     RK_S32 nals_allocated;
+
+    /* non-vcl nals kept for parse, reused by every frame */
+    RK_U8 *nal_arena;
+    RK_S32 nal_arena_size;
+
+    /* stream bytes copied for the last frame and since init */
+    RK_U32 frame_copy_bytes;
+    RK_U64 total_copy_bytes;
     // type of the first VCL NAL of the current frame
     enum NALUnitType first_nal_type;
 
@@ -603,8 +618,7 @@ RK_S32 mpp_hevc_decode_nal_sps(HEVCContext *s);
 RK_S32 mpp_hevc_decode_nal_pps(HEVCContext *s);
 RK_S32 mpp_hevc_decode_nal_sei(HEVCContext *s);
 
-RK_S32 mpp_hevc_extract_rbsp(HEVCContext *s, const RK_U8 *src, RK_S32 length,
-                             HEVCNAL *nal);
+RK_S32 mpp_hevc_extract_rbsp(const RK_U8 *src, RK_S32 length, HEVCNAL *nal);
 
 
 /**
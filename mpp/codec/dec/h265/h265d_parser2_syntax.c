@@ -281,72 +281,105 @@ RK_S32 h265d_parser2_syntax(void *ctx)
     return 0;
 }
 
+/* grow a buffer reused by every frame, the old content is not kept */
+static MPP_RET h265d_reserve(RK_U8 **buf, RK_S32 *size, RK_S32 need)
+{
+    if (need <= *size)
+        return MPP_OK;
+
+    need = MPP_ALIGN(need + (need >> 2), 1024);
+    mpp_free(*buf);
+    *buf = mpp_malloc(RK_U8, need);
+    *size = (*buf) ? need : 0;
+
+    return (*buf) ? MPP_OK : MPP_ERR_NOMEM;
+}
+
+/*
+ * The nals found by split are copied here once, the vcl ones with a start
+ * code into the stream buffer for hardware and the others into the nal
+ * arena. Parse reads them from there as the input packet may be released
+ * after prepare.
+ */
 RK_S32 h265d_syntax_fill_slice(void *ctx, RK_S32 input_index)
 {
     H265dContext_t *h265dctx = (H265dContext_t *)ctx;
-    const HEVCContext *h = (const HEVCContext *)h265dctx->priv_data;
+    HEVCContext *h = (HEVCContext *)h265dctx->priv_data;
     h265d_dxva2_picture_context_t *ctx_pic = (h265d_dxva2_picture_context_t *)h->hal_pic_private;
+    static const RK_U8 start_code[] = {0, 0, 1 };
+    static const RK_U32 start_code_size = sizeof(start_code);
     MppBuffer streambuf = NULL;
     RK_S32 i, count = 0;
     RK_U32 position = 0;
+    RK_U32 extra = 0;
     RK_U8 *ptr = NULL;
-    RK_U8 *current = NULL;
-    RK_U32 size = 0, length = 0;
-    // mpp_err("input_index = %d",input_index);
+    RK_S32 size = 0;
+    RK_U32 length = 0, other = 0;
+
+    for (i = 0; i < h->nb_nals; i++) {
+        HEVCNAL *nal = &h->nals[i];
+
+        if (nal->size < 1)
+            return MPP_ERR_STREAM;
+
+        if (((nal->data[0] >> 1) & 0x3f) < 32)
+            length += start_code_size + nal->size;
+        else
+            other += nal->size;
+    }
+
     if (-1 != input_index) {
         mpp_buf_slot_get_prop(h->packet_slots, input_index, SLOT_BUFFER, &streambuf);
-        current = ptr = (RK_U8 *)mpp_buffer_get_ptr(streambuf);
-        if (current == NULL) {
+        ptr = (RK_U8 *)mpp_buffer_get_ptr(streambuf);
+        if (ptr == NULL) {
             return MPP_ERR_NULL_PTR;
         }
-    } else {
-        RK_S32 buff_size = 0;
-        current = (RK_U8 *)mpp_packet_get_data(h->input_packet);
-        size = (RK_U32)mpp_packet_get_size(h->input_packet);
-        for (i = 0; i < h->nb_nals; i++) {
-            length += h->nals[i].size;
+        size = (RK_S32)mpp_buffer_get_size(streambuf);
+        if (length > (RK_U32)size) {
+            mpp_err("stream size %d over buffer size %d\n", length, size);
+            return MPP_ERR_NOMEM;
         }
-        length = MPP_ALIGN(length, 16) + 64;
-        if (length > size) {
-            mpp_free(current);
-            buff_size = MPP_ALIGN(length + 10 * 1024, 1024);
-            current = mpp_malloc(RK_U8, buff_size);
-            mpp_packet_set_data(h->input_packet, (void*)current);
-            mpp_packet_set_size(h->input_packet, buff_size);
+    } else {
+        ptr = (RK_U8 *)mpp_packet_get_data(h->input_packet);
+        size = (RK_S32)mpp_packet_get_size(h->input_packet);
+        if (MPP_ALIGN(length, 16) + 64 > (RK_U32)size) {
+            MPP_RET ret = h265d_reserve(&ptr, &size, MPP_ALIGN(length, 16) + 64);
+
+            mpp_packet_set_data(h->input_packet, (void*)ptr);
+            mpp_packet_set_size(h->input_packet, size);
+            if (ret)
+                return ret;
         }
     }
-    for (i = 0; i < h->nb_nals; i++) {
-        static const RK_U8 start_code[] = {0, 0, 1 };
-        static const RK_U32 start_code_size = sizeof(start_code);
-        BitReadCtx_t gb_cxt, *gb;
-        RK_S32 value;
-        RK_U32 nal_type;
-
-        mpp_set_bitread_ctx(&gb_cxt, (RK_U8 *)h->nals[i].data,
-                            h->nals[i].size);
-        mpp_set_pre_detection(&gb_cxt);
-
-        gb = &gb_cxt;
 
-        READ_ONEBIT(gb, &value); /*this bit should be zero*/
+    if (h265d_reserve(&h->nal_arena, &h->nal_arena_size, other))
+        return MPP_ERR_NOMEM;
 
-        READ_BITS(gb, 6, &nal_type);
+    for (i = 0; i < h->nb_nals; i++) {
+        HEVCNAL *nal = &h->nals[i];
 
-        if (nal_type >= 32) {
+        if (((nal->data[0] >> 1) & 0x3f) >= 32) {
+            memcpy(h->nal_arena + extra, nal->data, nal->size);
+            nal->data = h->nal_arena + extra;
+            extra += nal->size;
             continue;
         }
-        memcpy(current, start_code, start_code_size);
-        current += start_code_size;
+        if (count >= MAX_SLICES) {
+            mpp_err("slice count over %d\n", MAX_SLICES);
+            return MPP_ERR_STREAM;
+        }
+        memcpy(ptr + position, start_code, start_code_size);
         position += start_code_size;
-        memcpy(current, h->nals[i].data, h->nals[i].size);
-        // mpp_log("h->nals[%d].size = %d", i, h->nals[i].size);
-        fill_slice_short(&ctx_pic->slice_short[count], position, h->nals[i].size);
-        current += h->nals[i].size;
-        position += h->nals[i].size;
+        memcpy(ptr + position, nal->data, nal->size);
+        nal->data = ptr + position;
+        fill_slice_short(&ctx_pic->slice_short[count], position, nal->size);
+        position += nal->size;
         count++;
     }
     ctx_pic->slice_count    = count;
     ctx_pic->bitstream_size = position;
+    h->frame_copy_bytes = position + extra;
+    h->total_copy_bytes += h->frame_copy_bytes;
     if (-1 != input_index) {
         ctx_pic->bitstream      = (RK_U8*)ptr;
 
@@ -357,6 +390,4 @@ RK_S32 h265d_syntax_fill_slice(void *ctx, RK_S32 input_index)
         mpp_packet_set_length(h->input_packet, position);
     }
     return MPP_OK;
-__BITREAD_ERR:
-    return  MPP_ERR_STREAM;
 }
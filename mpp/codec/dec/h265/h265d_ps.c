@@ -1150,6 +1150,7 @@ int mpp_hevc_decode_nal_vps(HEVCContext *s)
         }
         s->vps_list[vps_id] = vps_buf;
     }
+    s->ps_id = vps_id;
 
     return 0;
 __BITREAD_ERR:
@@ -1830,6 +1831,7 @@ RK_S32 mpp_hevc_decode_nal_sps(HEVCContext *s)
 
     if (s->sps_list[sps_id])
         s->sps_list_of_updated[sps_id] = 1;
+    s->ps_id = sps_id;
 
     return 0;
 __BITREAD_ERR:
@@ -2108,6 +2110,7 @@ int mpp_hevc_decode_nal_pps(HEVCContext *s)
 
     if (s->pps_list[pps_id])
         s->pps_list_of_updated[pps_id] = 1;
+    s->ps_id = pps_id;
 
     return 0;
 __BITREAD_ERR:
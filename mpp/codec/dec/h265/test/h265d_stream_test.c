@@ -0,0 +1,273 @@
+/*
+ * Copyright 2015 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_TAG "h265d_stream_test"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mpp_log.h"
+#include "mpp_time.h"
+#include "mpp_common.h"
+
+#include "h265d_api.h"
+#include "h265d_parser.h"
+
+#define TEST_SLICES         8
+#define TEST_SLICE_SIZE     (64 * 1024)
+#define TEST_AUD_SIZE       3
+#define BENCH_BYTES         (256 * 1024 * 1024)
+
+typedef struct TestCtx_t {
+    MppBufSlots     frame_slots;
+    MppBufSlots     packet_slots;
+    void            *parser;
+    HEVCContext     *s;
+    MppPacket       packet;
+
+    RK_U8           *stream;
+    RK_U32          size;
+    /* payload bytes of the non-vcl nals */
+    RK_U32          other_bytes;
+} TestCtx;
+
+/* cabac like payload with emulation prevention and a non-zero last byte */
+static void fill_payload(RK_U8 *buf, RK_U32 size)
+{
+    RK_U32 zeros = 0;
+    RK_U32 i;
+
+    for (i = 0; i < size; i++) {
+        RK_U8 c = rand();
+
+        if (zeros >= 2 && c <= 3)
+            c = 3;
+
+        zeros = c ? 0 : zeros + 1;
+        buf[i] = c;
+    }
+    buf[size - 1] = 0x80;
+}
+
+/* one access unit: an aud and TEST_SLICES slices of TRAIL_R */
+static MPP_RET build_stream(TestCtx *ctx)
+{
+    RK_U32 size = 4 + TEST_AUD_SIZE + TEST_SLICES * (3 + TEST_SLICE_SIZE);
+    RK_U8 *p;
+    RK_U32 i;
+
+    ctx->stream = malloc(size);
+    if (NULL == ctx->stream)
+        return MPP_ERR_MALLOC;
+
+    p = ctx->stream;
+    memcpy(p, "\0\0\0\1", 4);
+    p += 4;
+    p[0] = 35 << 1;
+    p[1] = 1;
+    p[2] = 0x50;
+    p += TEST_AUD_SIZE;
+
+    srand(1);
+    for (i = 0; i < TEST_SLICES; i++) {
+        memcpy(p, "\0\0\1", 3);
+        p += 3;
+        fill_payload(p, TEST_SLICE_SIZE);
+        p[0] = 1 << 1;
+        p[1] = 1;
+        p += TEST_SLICE_SIZE;
+    }
+
+    ctx->size = size;
+    ctx->other_bytes = TEST_AUD_SIZE;
+
+    return MPP_OK;
+}
+
+static MPP_RET test_init(TestCtx *ctx)
+{
+    ParserCfg cfg;
+
+    memset(ctx, 0, sizeof(*ctx));
+
+    if (build_stream(ctx))
+        return MPP_ERR_MALLOC;
+
+    mpp_buf_slot_init(&ctx->frame_slots);
+    mpp_buf_slot_init(&ctx->packet_slots);
+    if (NULL == ctx->frame_slots || NULL == ctx->packet_slots)
+        return MPP_NOK;
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.coding = MPP_VIDEO_CodingHEVC;
+    cfg.frame_slots = ctx->frame_slots;
+    cfg.packet_slots = ctx->packet_slots;
+
+    ctx->parser = calloc(1, api_h265d_parser.ctx_size);
+    if (NULL == ctx->parser)
+        return MPP_ERR_MALLOC;
+
+    if (api_h265d_parser.init(ctx->parser, &cfg))
+        return MPP_NOK;
+
+    ctx->s = (HEVCContext *)((H265dContext_t *)ctx->parser)->priv_data;
+
+    return mpp_packet_init(&ctx->packet, ctx->stream, ctx->size);
+}
+
+static void test_deinit(TestCtx *ctx)
+{
+    if (ctx->packet)
+        mpp_packet_deinit(&ctx->packet);
+    if (ctx->parser) {
+        api_h265d_parser.deinit(ctx->parser);
+        free(ctx->parser);
+    }
+    if (ctx->frame_slots)
+        mpp_buf_slot_deinit(ctx->frame_slots);
+    if (ctx->packet_slots)
+        mpp_buf_slot_deinit(ctx->packet_slots);
+    free(ctx->stream);
+}
+
+static MPP_RET prepare_frame(TestCtx *ctx, HalDecTask *task)
+{
+    mpp_packet_set_pos(ctx->packet, ctx->stream);
+    mpp_packet_set_length(ctx->packet, ctx->size);
+
+    memset(task, 0, sizeof(*task));
+    task->input = -1;
+
+    if (api_h265d_parser.prepare(ctx->parser, ctx->packet, task) || !task->valid)
+        return MPP_NOK;
+
+    return MPP_OK;
+}
+
+/* every nal is found in place and copied exactly once */
+static MPP_RET check_frame(TestCtx *ctx)
+{
+    HEVCContext *s = ctx->s;
+    HalDecTask task;
+    RK_U8 *out;
+    RK_U32 pos = 0;
+    RK_S32 i;
+
+    if (prepare_frame(ctx, &task)) {
+        mpp_err("prepare failed\n");
+        return MPP_NOK;
+    }
+
+    if (s->nb_nals != TEST_SLICES + 1) {
+        mpp_err("found %d nals expect %d\n", s->nb_nals, TEST_SLICES + 1);
+        return MPP_NOK;
+    }
+
+    out = (RK_U8 *)mpp_packet_get_data(task.input_packet);
+    for (i = 0; i < s->nb_nals; i++) {
+        HEVCNAL *nal = &s->nals[i];
+        const RK_U8 *src = ctx->stream + nal->offset;
+
+        if (memcmp(nal->data, src, nal->size)) {
+            mpp_err("nal %d differs from the stream at offset %d\n", i, nal->offset);
+            return MPP_NOK;
+        }
+
+        if (!i) {
+            if (nal->size != TEST_AUD_SIZE || nal->data != s->nal_arena) {
+                mpp_err("aud size %d not in the nal arena\n", nal->size);
+                return MPP_NOK;
+            }
+            continue;
+        }
+
+        if (nal->size != TEST_SLICE_SIZE || memcmp(out + pos, "\0\0\1", 3) ||
+            nal->data != out + pos + 3) {
+            mpp_err("slice %d size %d not at %d of the stream buffer\n",
+                    i, nal->size, pos);
+            return MPP_NOK;
+        }
+        pos += 3 + nal->size;
+    }
+
+    if (mpp_packet_get_length(task.input_packet) != pos ||
+        s->frame_copy_bytes != pos + ctx->other_bytes) {
+        mpp_err("stream length %d copied %d bytes expect %d\n",
+                mpp_packet_get_length(task.input_packet),
+                s->frame_copy_bytes, pos + ctx->other_bytes);
+        return MPP_NOK;
+    }
+
+    return MPP_OK;
+}
+
+static MPP_RET bench(TestCtx *ctx)
+{
+    RK_U32 loops = MPP_MAX(1, BENCH_BYTES / ctx->size);
+    RK_U64 copied = ctx->s->total_copy_bytes;
+    HalDecTask task;
+    RK_S64 time;
+    RK_U32 i;
+
+    time = mpp_time();
+    for (i = 0; i < loops; i++) {
+        if (prepare_frame(ctx, &task))
+            return MPP_NOK;
+    }
+    time = mpp_time() - time;
+
+    copied = ctx->s->total_copy_bytes - copied;
+    mpp_log("%d frames of %d bytes prepare %.1f MB/s copy %lld bytes per frame\n",
+            loops, ctx->size, (double)ctx->size * loops / MPP_MAX(time, 1),
+            copied / loops);
+
+    return MPP_OK;
+}
+
+int main()
+{
+    MPP_RET ret = MPP_NOK;
+    TestCtx ctx;
+
+    mpp_log("h265d_stream_test start\n");
+
+    if (test_init(&ctx)) {
+        mpp_err("h265d_stream_test init failed\n");
+        goto TEST_FAILED;
+    }
+
+    if (check_frame(&ctx))
+        goto TEST_FAILED;
+
+    if (bench(&ctx))
+        goto TEST_FAILED;
+
+    // the buffers are reused and the result stays the same
+    if (check_frame(&ctx))
+        goto TEST_FAILED;
+
+    ret = MPP_OK;
+TEST_FAILED:
+    test_deinit(&ctx);
+
+    if (ret)
+        mpp_log("h265d_stream_test failed\n");
+    else
+        mpp_log("h265d_stream_test success\n");
+
+    return ret;
+}
@@ -31,6 +31,18 @@
 
 #include "enc_impl_api.h"
 
+#define H264E_MAX_TASK_COUNT    4
+
+/*
+ * rc syntax of one frame in flight and the rc state its feedback is
+ * checked against, mpp_enc may start the next frames before the feedback
+ */
+typedef struct H264eRcTask_t {
+    RcSyntax        syntax;
+    ENC_FRAME_TYPE  frm_type;
+    RK_S32          bits_target;
+} H264eRcTask;
+
 typedef struct {
     /* config from mpp_enc */
     MppEncCfgSet    *cfg;
@@ -42,8 +54,11 @@ typedef struct {
     RK_U32          prep_ready;
     MppRateControl  *rc;
 
-    /* output to hal */
-    RcSyntax        syntax;
+    /* output to hal, feedback comes back in encoding order */
+    H264eRcTask     tasks[H264E_MAX_TASK_COUNT];
+    RK_S32          task_count;
+    RK_U32          task_start;
+    RK_U32          task_done;
 
     /*
      * input from hal
@@ -105,6 +120,12 @@ static MPP_RET h264e_init(void *ctx, EncImplCfg *ctrl_cfg)
     p->set = ctrl_cfg->set;
     p->idr_request = 0;
 
+    if (ctrl_cfg->task_count > H264E_MAX_TASK_COUNT)
+        ctrl_cfg->task_count = H264E_MAX_TASK_COUNT;
+    if (ctrl_cfg->task_count < 1)
+        ctrl_cfg->task_count = 1;
+    p->task_count = ctrl_cfg->task_count;
+
     ret = mpp_rc_init(&p->rc);
 
     INIT_LIST_HEAD(&p->rc_list);
@@ -139,7 +160,8 @@ static MPP_RET h264e_deinit(void *ctx)
 static MPP_RET h264e_encode(void *ctx, HalEncTask *task)
 {
     H264eCtx *p = (H264eCtx *)ctx;
-    RcSyntax *rc_syn = &p->syntax;
+    H264eRcTask *rc_task;
+    RcSyntax *rc_syn;
     MppEncCfgSet *cfg = p->cfg;
     MppEncRcCfg *rc = &cfg->rc;
 
@@ -151,6 +173,13 @@ static MPP_RET h264e_encode(void *ctx, HalEncTask *task)
         return MPP_NOK;
     }
 
+    // a task failed in hal never returns its feedback, drop the oldest
+    if (p->task_start - p->task_done >= (RK_U32)p->task_count)
+        p->task_done = p->task_start - p->task_count + 1;
+
+    rc_task = &p->tasks[p->task_start % p->task_count];
+    rc_syn = &rc_task->syntax;
+
     mpp_rc_update_user_cfg(p->rc, rc, !!p->idr_request);
     if (p->idr_request)
         p->idr_request--;
@@ -164,7 +193,11 @@ static MPP_RET h264e_encode(void *ctx, HalEncTask *task)
     }
     mpp_rc_record_param(&p->rc_list, p->rc, rc_syn);
 
-    task->syntax.data   = &p->syntax;
+    rc_task->frm_type = p->rc->cur_frmtype;
+    rc_task->bits_target = p->rc->bits_target;
+    p->task_start++;
+
+    task->syntax.data   = rc_syn;
     task->syntax.number = 1;
     task->valid = 1;
     task->is_intra = (p->rc->cur_frmtype == INTRA_FRAME) ? (1) : (0);
@@ -244,10 +277,25 @@ static MPP_RET h264e_callback(void *ctx, void *feedback)
 {
     H264eCtx *p = (H264eCtx *)ctx;
     h264e_feedback *fb  = (h264e_feedback *)feedback;
+    MppRateControl *rc = p->rc;
+    ENC_FRAME_TYPE frm_type = rc->cur_frmtype;
+    RK_S32 bits_target = rc->bits_target;
+
+    /* update with the state of the fed back frame, not of the latest one */
+    if (p->task_done != p->task_start) {
+        H264eRcTask *rc_task = &p->tasks[p->task_done % p->task_count];
+
+        rc->cur_frmtype = rc_task->frm_type;
+        rc->bits_target = rc_task->bits_target;
+        p->task_done++;
+    }
 
     p->result = *fb->result;
-    mpp_rc_update_hw_result(p->rc, fb->result);
-    mpp_rc_calc_real_bps(&p->rc_list, p->rc, fb->result->bits);
+    mpp_rc_update_hw_result(rc, fb->result);
+    mpp_rc_calc_real_bps(&p->rc_list, rc, fb->result->bits);
+
+    rc->cur_frmtype = frm_type;
+    rc->bits_target = bits_target;
 
     return MPP_OK;
 }
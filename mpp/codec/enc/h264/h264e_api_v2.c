@@ -69,6 +69,7 @@ typedef struct {
 
     /* rate control config */
     RcCtx               rc_ctx;
+    RcTrace             rc_trace;
 
     /* output to hal */
     RK_S32              syn_num;
@@ -160,6 +161,7 @@ static MPP_RET h264e_init(void *ctx, EncImplCfg *ctrl_cfg)
     mpp_assert(p->hdr_pkt);
 
     p->cfg = ctrl_cfg->cfg;
+    p->rc_trace = ctrl_cfg->rc_trace;
     p->idr_request = 0;
 
     h264e_reorder_init(&p->reorder);
@@ -514,6 +516,7 @@ static MPP_RET h264e_start(void *ctx, HalEncTask *task)
         rc_init(&p->rc_ctx, MPP_VIDEO_CodingAVC, NULL);
         mpp_assert(p->rc_ctx);
 
+        rc_set_trace(p->rc_ctx, p->rc_trace);
         rc_update_usr_cfg(p->rc_ctx, &rc_cfg);
     }
 
@@ -52,6 +52,7 @@ static MPP_RET h265e_init(void *ctx, EncImplCfg *ctrlCfg)
     mpp_assert(ctrlCfg->coding == MPP_VIDEO_CodingHEVC);
     p->cfg = ctrlCfg->cfg;
     p->set = ctrlCfg->set;
+    p->rc_trace = ctrlCfg->rc_trace;
 
     memset(&p->syntax, 0, sizeof(p->syntax));
     ctrlCfg->task_count = 1;
@@ -267,6 +268,7 @@ static MPP_RET h265e_start(void *ctx, HalEncTask *task)
 
         rc_init(&p->rc_ctx, MPP_VIDEO_CodingHEVC, NULL);
         mpp_assert(p->rc_ctx);
+        rc_set_trace(p->rc_ctx, p->rc_trace);
         rc_update_usr_cfg(p->rc_ctx, &rc_cfg);
 
         p->rc_ready = 1;
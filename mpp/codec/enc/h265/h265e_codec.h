@@ -61,6 +61,7 @@ typedef struct H265eCtx_t {
     MppDeviceId         dev_id;
     MppRateControl      *rc;
     RcCtx               rc_ctx;
+    RcTrace             rc_trace;
     RK_U32              rc_ready;
     RK_S32              idr_request;
 
@@ -74,7 +74,7 @@ static MPP_RET jpege_init(void *ctx, EncImplCfg *cfg)
     p->set = cfg->set;
 
     mpp_assert(cfg->coding = MPP_VIDEO_CodingMJPEG);
-    cfg->task_count = 1;
+    // no per frame state, any task count from mpp_enc is fine
 
     jpege_dbg_func("leave ctx %p\n", ctx);
     return MPP_OK;
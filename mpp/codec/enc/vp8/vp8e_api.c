@@ -66,6 +66,8 @@ MPP_RET vp8e_init(void *ctx, EncImplCfg *ctrl_cfg)
 
     p->cfg = ctrl_cfg->cfg;
     p->set = ctrl_cfg->set;
+    // hal reads the rc context directly, one frame at a time
+    ctrl_cfg->task_count = 1;
 
     /*
      * default prep:
@@ -20,6 +20,7 @@
 #include "mpp_err.h"
 
 #include "rc_api.h"
+#include "rc_trace.h"
 
 /*
  * Mpp rate control principle
@@ -67,6 +68,9 @@ MPP_RET rc_api_register(const RcImplApi *api);
 MPP_RET rc_init(RcCtx *ctx, MppCodingType type, const char *name);
 MPP_RET rc_deinit(RcCtx ctx);
 
+/* record the calls into the RcImplApi, NULL to stop recording */
+MPP_RET rc_set_trace(RcCtx ctx, RcTrace trace);
+
 /* update rc control  */
 MPP_RET rc_update_usr_cfg(RcCtx ctx, RcCfg *cfg);
 
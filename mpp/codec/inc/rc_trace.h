@@ -0,0 +1,102 @@
+/*
+ * Copyright 2016 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __RC_TRACE_H__
+#define __RC_TRACE_H__
+
+#include "rc_api.h"
+#include "rc_data.h"
+
+/*
+ * Rate control trace
+ *
+ * A fixed size ring of the calls into the RcImplApi of one encoder. Each
+ * record keeps both the input and the output of the call so the trace can be
+ * replayed offline against the same or a modified rate control model.
+ *
+ * The ring is allocated once at init and the oldest records are overwritten.
+ * Env rc_trace sets the record count, 0 disables the trace.
+ */
+typedef void* RcTrace;
+
+#define RC_TRACE_MAGIC          (0x52544352)    /* "RCTR" in memory */
+#define RC_TRACE_VERSION        (1)
+
+/* the dump starts after the first config so model state is rebuilt from it */
+#define RC_TRACE_FLAG_PARTIAL   (0x00000001)
+
+typedef enum RcTraceType_e {
+    RC_TRACE_CFG,               /* rc_update_usr_cfg on a new rc context */
+    RC_TRACE_START,             /* rc_frm_start */
+    RC_TRACE_END,               /* rc_frm_end */
+    RC_TRACE_BUTT,
+} RcTraceType;
+
+/*
+ * Binary dump layout in host byte order:
+ * one RcTraceHdr followed by count RcTraceRec of rec_size bytes each, the
+ * oldest first. A dump always starts with a RC_TRACE_CFG record.
+ */
+typedef struct RcTraceHdr_t {
+    RK_U32          magic;
+    RK_U32          version;
+    RK_U32          hdr_size;
+    RK_U32          rec_size;
+    RK_U32          count;
+    RK_U32          coding;
+    RK_U32          flag;
+    RK_U32          reserve;
+} RcTraceHdr;
+
+typedef struct RcTraceFrm_t {
+    EncFrmStatus    status;
+    RcHalCfg        in;
+    RcHalCfg        out;
+} RcTraceFrm;
+
+typedef struct RcTraceRec_t {
+    RK_U32          type;
+    /* call sequence number since the trace is created */
+    RK_U32          seq;
+    union {
+        RcCfg       cfg;
+        RcTraceFrm  frm;
+    };
+} RcTraceRec;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+MPP_RET rc_trace_init(RcTrace *trace, MppCodingType coding, RK_S32 count);
+MPP_RET rc_trace_deinit(RcTrace trace);
+
+/* called by rc framework with RcCtx calls */
+void rc_trace_cfg(RcTrace trace, RcCfg *cfg);
+void rc_trace_frm(RcTrace trace, RcTraceType type, EncFrmStatus *frm,
+                  RcHalCfg *in, RcHalCfg *out);
+
+/*
+ * Write the newest records that fit in size bytes into buf.
+ * return the written size, 0 on empty trace or too small buffer
+ */
+size_t rc_trace_dump(RcTrace trace, void *buf, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RC_TRACE_H__ */
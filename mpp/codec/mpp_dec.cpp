@@ -396,6 +396,7 @@ static void mpp_dec_put_frame(Mpp *mpp, RK_S32 index, HalDecTaskFlag flags)
         list->add_at_tail(&out, sizeof(out));
         mpp->mFramePutCount++;
         list->signal();
+        mpp->update_output_event();
         list->unlock();
 
         if (fake_frame)
@@ -517,6 +518,9 @@ static MPP_RET try_proc_dec_task(Mpp *mpp, DecTask *task)
         task->wait.dec_pkt_in = 0;
         packets->del_at_head(&dec->mpp_pkt_in, sizeof(dec->mpp_pkt_in));
         mpp->mPacketGetCount++;
+        mpp->update_input_event();
+        // wake up put_packet blocked on a full queue
+        packets->signal();
 
         if (dec->use_preset_time_order) {
             MppPacket pkt_in = NULL;
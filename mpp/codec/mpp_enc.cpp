@@ -21,6 +21,7 @@
 #include "mpp_env.h"
 #include "mpp_log.h"
 #include "mpp_mem.h"
+#include "mpp_common.h"
 
 #include "mpp_packet_impl.h"
 
@@ -30,18 +31,43 @@
 #include "mpp_hal.h"
 #include "hal_h264e_api.h"
 
+#define MPP_ENC_MAX_TASK_COUNT  4
+
+/* mpp port tasks of one hal task in flight */
+typedef struct EncPipeTask_t {
+    MppTask             task_in;
+    MppTask             task_out;
+    // enc_impl_proc_hal result, hal is skipped on error
+    MPP_RET             ret;
+} EncPipeTask;
+
+/*
+ * The encoder runs in two threads. The control thread takes the port tasks
+ * and does the rate control of a frame in enc_impl_proc_hal, then hands it
+ * to the hal thread which generates registers, encodes and outputs it. With
+ * env mpp_enc_task_count above 1 the control thread goes on with the next
+ * frames while the current one is in hal, the rate control feedback is still
+ * returned in frame order but it lags behind the frames prepared.
+ */
 typedef struct MppEncImpl_t {
     MppCodingType       coding;
     EncImpl             impl;
     MppHal              hal;
 
     MppThread           *thread_enc;
+    MppThread           *thread_hal;
     void                *mpp;
 
     // common resource
     MppBufSlots         frame_slots;
     MppBufSlots         packet_slots;
     HalTaskGroup        tasks;
+    RK_S32              task_count;
+
+    // port tasks in the order of the hal tasks handed to hal thread
+    EncPipeTask         *pipe;
+    RK_U32              pipe_put;
+    RK_U32              pipe_get;
 
     // internal status and protection
     Mutex               lock;
@@ -53,6 +79,12 @@ typedef struct MppEncImpl_t {
     RK_U32              status_flag;
     RK_U32              notify_flag;
 
+    // frames held by hal and output by later tasks, drained after eos
+    RK_U32              hal_delayed;
+    RK_U32              drain;
+    // eos or drain task in flight, hal thread decides whether to drain
+    RK_U32              hal_flush;
+
     /* Encoder configure set */
     MppEncCfgSet        cfg;
     MppEncCfgSet        set;
@@ -67,7 +99,7 @@ typedef union EncTaskWait_u {
         RK_U32      enc_pkt_out     : 1;   // 0x0008 MPP_ENC_NOTIFY_PACKET_ENQUEUE
 
         RK_U32      reserv0010      : 1;   // 0x0010
-        RK_U32      reserv0020      : 1;   // 0x0020
+        RK_U32      enc_task_done   : 1;   // 0x0020 MPP_ENC_NOTIFY_TASK_DONE
         RK_U32      reserv0040      : 1;   // 0x0040
         RK_U32      reserv0080      : 1;   // 0x0080
 
@@ -102,6 +134,206 @@ static void reset_hal_enc_task(HalEncTask *task)
     memset(task, 0, sizeof(*task));
 }
 
+/*
+ * Output one frame delayed in hal after eos. There is no input frame, hal
+ * flushes its next frame into the packet and eos is set on the last one.
+ */
+static void drain_hal_task(Mpp *mpp, MppEncImpl *enc, HalTaskInfo *task_info,
+                           MppTask task_out)
+{
+    HalEncTask *hal_task = &task_info->enc;
+    MppPort output = mpp_task_queue_get_port(mpp->mOutputTaskQueue, MPP_PORT_INPUT);
+    MppPacket packet = NULL;
+    MppBuffer buffer = NULL;
+    RK_U32 size = enc->cfg.prep.width * enc->cfg.prep.height;
+    MPP_RET ret;
+
+    mpp_buffer_get(mpp->mPacketGroup, &buffer, size);
+    mpp_packet_init_with_buffer(&packet, buffer);
+    mpp_buffer_put(buffer);
+
+    hal_task->packet = packet;
+    hal_task->output = mpp_packet_get_buffer(packet);
+
+    enc_dbg_detail("mpp_hal_hw_wait  hal %p drain %d\n", enc->hal, enc->hal_delayed);
+    ret = mpp_hal_reg_gen(enc->hal, task_info);
+    if (!ret)
+        ret = mpp_hal_hw_start(enc->hal, task_info);
+    if (!ret)
+        ret = mpp_hal_hw_wait(enc->hal, task_info);
+    if (ret) {
+        mpp_err("mpp %p drain delayed frame failed return %d", mpp, ret);
+        hal_task->length = 0;
+        hal_task->delayed = 0;
+    }
+
+    mpp_packet_set_length(packet, hal_task->length);
+    if (hal_task->is_intra)
+        mpp_packet_set_flag(packet, mpp_packet_get_flag(packet) | MPP_PACKET_FLAG_INTRA);
+
+    enc->hal_delayed = hal_task->delayed;
+    if (!enc->hal_delayed) {
+        enc->drain = 0;
+        mpp_packet_set_eos(packet);
+    }
+
+    if (task_out) {
+        mpp_task_meta_set_packet(task_out, KEY_OUTPUT_PACKET, packet);
+        mpp_task_meta_set_s32(task_out, KEY_OUTPUT_INTRA, hal_task->is_intra);
+        mpp_port_enqueue(output, task_out);
+    } else {
+        mpp_packet_deinit(&packet);
+    }
+}
+
+/*
+ * Encode one frame prepared by the control thread, then return its input
+ * task and output the packet. Frames without buffer only output an empty
+ * packet.
+ */
+static void encode_hal_task(Mpp *mpp, MppEncImpl *enc, HalTaskInfo *task_info,
+                            EncPipeTask *pipe)
+{
+    HalEncTask *hal_task = &task_info->enc;
+    MppPort input  = mpp_task_queue_get_port(mpp->mInputTaskQueue,  MPP_PORT_OUTPUT);
+    MppPort output = mpp_task_queue_get_port(mpp->mOutputTaskQueue, MPP_PORT_INPUT);
+    MppHal hal = enc->hal;
+    MppFrame frame = hal_task->frame;
+    MppPacket packet = hal_task->packet;
+    MppBuffer mv_info = hal_task->mv_info;
+    MppTask task_in = pipe->task_in;
+    MppTask task_out = pipe->task_out;
+    MPP_RET ret = pipe->ret;
+
+    if (hal_task->input) {
+        if (ret)
+            goto TASK_END;
+
+        enc_dbg_detail("mpp_hal_reg_gen  hal %p task %p\n", hal, task_info);
+        ret = mpp_hal_reg_gen(hal, task_info);
+        if (ret) {
+            mpp_err("mpp %p hal_reg_gen failed return %d", mpp, ret);
+            goto TASK_END;
+        }
+        enc_dbg_detail("mpp_hal_hw_start hal %p task %p\n", hal, task_info);
+        ret = mpp_hal_hw_start(hal, task_info);
+        if (ret) {
+            mpp_err("mpp %p hal_hw_start failed return %d", mpp, ret);
+            goto TASK_END;
+        }
+        enc_dbg_detail("mpp_hal_hw_wait  hal %p task %p\n", hal, task_info);
+        ret = mpp_hal_hw_wait(hal, task_info);
+        if (ret) {
+            mpp_err("mpp %p hal_hw_wait failed return %d", mpp, ret);
+            goto TASK_END;
+        }
+    TASK_END:
+        mpp_packet_set_length(packet, hal_task->length);
+        enc->hal_delayed = (ret) ? 0 : hal_task->delayed;
+    }
+
+    // with delayed frames eos goes on the last drained packet
+    if (mpp_frame_get_eos(frame)) {
+        if (enc->hal_delayed)
+            enc->drain = 1;
+        else
+            mpp_packet_set_eos(packet);
+    }
+
+    /*
+     * first clear output packet
+     * then enqueue task back to input port
+     * final user will release the mpp_frame they had input
+     */
+    // asynchronous put_frame does not wait for the task, release here
+    if (mpp->mInputDepth)
+        mpp_frame_deinit(&frame);
+
+    mpp_task_meta_set_frame(task_in, KEY_INPUT_FRAME, frame);
+    mpp_port_enqueue(input, task_in);
+
+    /*
+     * task_out may be null if output port is awaken by Mpp::clear()
+     */
+    if (task_out) {
+        //set motion info buffer to output task
+        if (mv_info)
+            mpp_task_meta_set_buffer(task_out, KEY_MOTION_INFO, mv_info);
+
+        mpp_task_meta_set_packet(task_out, KEY_OUTPUT_PACKET, packet);
+
+        {
+            RK_S32 is_intra = hal_task->is_intra;
+            RK_U32 flag = mpp_packet_get_flag(packet);
+
+            mpp_task_meta_set_s32(task_out, KEY_OUTPUT_INTRA, is_intra);
+            if (is_intra) {
+                mpp_packet_set_flag(packet, flag | MPP_PACKET_FLAG_INTRA);
+            }
+        }
+
+        // setup output task here
+        mpp_port_enqueue(output, task_out);
+    } else {
+        mpp_packet_deinit(&packet);
+    }
+}
+
+/*
+ * Rate control feedback from hal thread, locked against enc_impl_proc_hal
+ * of the next frames and against config
+ */
+static MPP_RET mpp_enc_hal_callback(void *ctx, void *info)
+{
+    MppEncImpl *enc = (MppEncImpl *)ctx;
+    AutoMutex auto_lock(&enc->lock);
+
+    return hal_enc_callback(enc->impl, info);
+}
+
+/* hand a prepared task over to hal thread, hal tasks are done in order */
+static void put_hal_task(MppEncImpl *enc, HalTaskHnd hnd, HalTaskInfo *task_info,
+                         MppTask task_in, MppTask task_out, MPP_RET ret)
+{
+    MppThread *thd_hal = enc->thread_hal;
+    EncPipeTask *pipe = &enc->pipe[enc->pipe_put++ % enc->task_count];
+
+    pipe->task_in = task_in;
+    pipe->task_out = task_out;
+    pipe->ret = ret;
+    hal_task_hnd_set_info(hnd, task_info);
+
+    thd_hal->lock();
+    hal_task_hnd_set_status(hnd, TASK_PROCESSING);
+    thd_hal->signal();
+    thd_hal->unlock();
+
+    if (mpp_enc_debug & MPP_ENC_DBG_DETAIL) {
+        RK_U32 count = 0;
+
+        hal_task_get_count(enc->tasks, TASK_PROCESSING, &count);
+        enc_dbg_detail("hal task %d put, %d in hal thread\n", enc->pipe_put, count);
+    }
+}
+
+/* block control thread until hal thread has done all tasks */
+static MPP_RET wait_hal_task_done(MppEncImpl *enc)
+{
+    MppThread *thd_enc = enc->thread_enc;
+    AutoMutex autolock(thd_enc->mutex());
+
+    while (hal_task_check_empty(enc->tasks, TASK_PROCESSING)) {
+        if (MPP_THREAD_RUNNING != thd_enc->get_status())
+            return MPP_NOK;
+
+        enc->status_flag = MPP_ENC_NOTIFY_TASK_DONE;
+        enc->notify_flag &= ~MPP_ENC_NOTIFY_TASK_DONE;
+        thd_enc->wait();
+    }
+
+    return MPP_OK;
+}
+
 static MPP_RET release_task_in_port(MppPort port)
 {
     MPP_RET ret = MPP_OK;
@@ -180,6 +412,7 @@ void *mpp_enc_control_thread(void *data)
     EncTask task;
     HalTaskInfo *task_info = &task.info;
     HalEncTask *hal_task = &task_info->enc;
+    HalTaskHnd hnd = NULL;
     MppPort input  = mpp_task_queue_get_port(mpp->mInputTaskQueue,  MPP_PORT_OUTPUT);
     MppPort output = mpp_task_queue_get_port(mpp->mOutputTaskQueue, MPP_PORT_INPUT);
     MppTask task_in = NULL;
@@ -202,18 +435,62 @@ void *mpp_enc_control_thread(void *data)
         }
 
         if (enc->reset_flag) {
+            // frames already in hal thread are output before reset
+            if (wait_hal_task_done(enc))
+                continue;
+
             {
                 AutoMutex autolock(thd_enc->mutex());
                 enc->status_flag = 0;
             }
 
+            // drop frames still held by hal
+            if (enc->hal_delayed)
+                mpp_hal_reset(hal);
+            enc->hal_delayed = 0;
+            enc->drain = 0;
+            enc->hal_flush = 0;
+
             AutoMutex autolock(thd_enc->mutex(THREAD_CONTROL));
             enc->reset_flag = 0;
             sem_post(&enc->enc_reset);
             continue;
         }
 
-        // 1. check task in
+        // 0. wait the eos or drain task to know whether hal has more frames
+        if (enc->hal_flush) {
+            if (hal_task_check_empty(enc->tasks, TASK_PROCESSING)) {
+                task.wait.enc_task_done = 1;
+                continue;
+            }
+
+            task.wait.enc_task_done = 0;
+            enc->hal_flush = 0;
+        }
+
+        // 1. output frames delayed in hal before taking new input
+        if (enc->drain) {
+            if (mpp_port_poll(output, MPP_POLL_NON_BLOCK)) {
+                task.wait.enc_pkt_out = 1;
+                continue;
+            }
+
+            task.wait.enc_pkt_out = 0;
+
+            hal_task_get_hnd(enc->tasks, TASK_IDLE, &hnd);
+            mpp_assert(hnd);
+            mpp_port_dequeue(output, &task_out);
+
+            reset_hal_enc_task(hal_task);
+            put_hal_task(enc, hnd, task_info, NULL, task_out, MPP_OK);
+            enc->hal_flush = 1;
+
+            hnd = NULL;
+            task_out = NULL;
+            continue;
+        }
+
+        // 2. check task in
         if (!task.status.task_in_rdy) {
             ret = mpp_port_poll(input, MPP_POLL_NON_BLOCK);
             if (ret) {
@@ -226,7 +503,7 @@ void *mpp_enc_control_thread(void *data)
         }
         enc_dbg_detail("task in ready\n");
 
-        // 2. get task out
+        // 3. get task out
         if (!task.status.task_out_rdy) {
             ret = mpp_port_poll(output, MPP_POLL_NON_BLOCK);
             if (ret) {
@@ -239,6 +516,14 @@ void *mpp_enc_control_thread(void *data)
         }
         enc_dbg_detail("task out ready\n");
 
+        // 4. get hal task, all of them may be in hal thread
+        if (hal_task_get_hnd(enc->tasks, TASK_IDLE, &hnd)) {
+            task.wait.enc_task_done = 1;
+            continue;
+        }
+        task.wait.enc_task_done = 0;
+        enc_dbg_detail("hal task ready\n");
+
         ret = mpp_port_dequeue(input, &task_in);
         mpp_assert(task_in);
 
@@ -248,10 +533,16 @@ void *mpp_enc_control_thread(void *data)
 
         if (NULL == frame) {
             mpp_port_enqueue(input, task_in);
+            task_in = NULL;
+            hnd = NULL;
             continue;
         }
 
+        // keep the output task for this frame, hal thread fills it
+        mpp_port_dequeue(output, &task_out);
+
         reset_hal_enc_task(hal_task);
+        ret = MPP_OK;
 
         if (mpp_frame_get_buffer(frame)) {
             /*
@@ -270,43 +561,19 @@ void *mpp_enc_control_thread(void *data)
             }
             mpp_assert(packet);
 
+            // hal with reordering or delay overrides both
             mpp_packet_set_pts(packet, mpp_frame_get_pts(frame));
+            mpp_packet_set_dts(packet, mpp_frame_get_pts(frame));
 
-            hal_task->frame  = frame;
             hal_task->input  = mpp_frame_get_buffer(frame);
-            hal_task->packet = packet;
             hal_task->output = mpp_packet_get_buffer(packet);
-            hal_task->mv_info = mv_info;
 
             {
                 AutoMutex auto_lock(&enc->lock);
                 ret = enc_impl_proc_hal(enc->impl, hal_task);
-                if (ret) {
+                if (ret)
                     mpp_err("mpp %p enc_impl_proc_hal failed return %d", mpp, ret);
-                    goto TASK_END;
-                }
-            }
-
-            enc_dbg_detail("mpp_hal_reg_gen  hal %p task %p\n", hal, task_info);
-            ret = mpp_hal_reg_gen(hal, task_info);
-            if (ret) {
-                mpp_err("mpp %p hal_reg_gen failed return %d", mpp, ret);
-                goto TASK_END;
-            }
-            enc_dbg_detail("mpp_hal_hw_start hal %p task %p\n", hal, task_info);
-            ret = mpp_hal_hw_start(hal, task_info);
-            if (ret) {
-                mpp_err("mpp %p hal_hw_start failed return %d", mpp, ret);
-                goto TASK_END;
-            }
-            enc_dbg_detail("mpp_hal_hw_wait  hal %p task %p\n", hal, task_info);
-            ret = mpp_hal_hw_wait(hal, task_info);
-            if (ret) {
-                mpp_err("mpp %p hal_hw_wait failed return %d", mpp, ret);
-                goto TASK_END;
             }
-        TASK_END:
-            mpp_packet_set_length(packet, hal_task->length);
         } else {
             /*
              * else init a empty packet for output
@@ -314,46 +581,20 @@ void *mpp_enc_control_thread(void *data)
             mpp_packet_new(&packet);
         }
 
-        if (mpp_frame_get_eos(frame))
-            mpp_packet_set_eos(packet);
-
-        /*
-         * first clear output packet
-         * then enqueue task back to input port
-         * final user will release the mpp_frame they had input
-         */
-        mpp_task_meta_set_frame(task_in, KEY_INPUT_FRAME, frame);
-        mpp_port_enqueue(input, task_in);
-
-        // send finished task to output port
-        ret = mpp_port_dequeue(output, &task_out);
+        hal_task->frame  = frame;
+        hal_task->packet = packet;
+        hal_task->mv_info = mv_info;
 
-        /*
-         * task_in may be null if output port is awaken by Mpp::clear()
-         */
-        if (task_out) {
-            //set motion info buffer to output task
-            if (mv_info)
-                mpp_task_meta_set_buffer(task_out, KEY_MOTION_INFO, mv_info);
+        // the frame belongs to the hal thread once the task is put
+        RK_U32 eos = mpp_frame_get_eos(frame);
 
-            mpp_task_meta_set_packet(task_out, KEY_OUTPUT_PACKET, packet);
+        put_hal_task(enc, hnd, task_info, task_in, task_out, ret);
 
-            {
-                RK_S32 is_intra = hal_task->is_intra;
-                RK_U32 flag = mpp_packet_get_flag(packet);
-
-                mpp_task_meta_set_s32(task_out, KEY_OUTPUT_INTRA, is_intra);
-                if (is_intra) {
-                    mpp_packet_set_flag(packet, flag | MPP_PACKET_FLAG_INTRA);
-                }
-            }
-
-            // setup output task here
-            mpp_port_enqueue(output, task_out);
-        } else {
-            mpp_packet_deinit(&packet);
-        }
+        // hal thread sets up the drain on eos
+        if (eos)
+            enc->hal_flush = 1;
 
+        hnd = NULL;
         task_in = NULL;
         task_out = NULL;
         packet = NULL;
@@ -362,9 +603,46 @@ void *mpp_enc_control_thread(void *data)
         task.status.val = 0;
     }
 
-    // clear remain task in output port
-    release_task_in_port(input);
-    release_task_in_port(mpp->mOutputPort);
+    return NULL;
+}
+
+void *mpp_enc_hal_thread(void *data)
+{
+    Mpp *mpp = (Mpp*)data;
+    MppEncImpl *enc = (MppEncImpl *)mpp->mEnc;
+    MppThread *thd_hal = enc->thread_hal;
+    HalTaskGroup tasks = enc->tasks;
+    HalTaskHnd hnd = NULL;
+    HalTaskInfo task_info;
+
+    while (1) {
+        {
+            AutoMutex autolock(thd_hal->mutex());
+
+            // tasks already handed over are still done on stop
+            if (hal_task_get_hnd(tasks, TASK_PROCESSING, &hnd)) {
+                if (MPP_THREAD_RUNNING != thd_hal->get_status())
+                    break;
+
+                thd_hal->wait();
+                continue;
+            }
+        }
+
+        EncPipeTask *pipe = &enc->pipe[enc->pipe_get++ % enc->task_count];
+
+        hal_task_hnd_get_info(hnd, &task_info);
+
+        if (pipe->task_in)
+            encode_hal_task(mpp, enc, &task_info, pipe);
+        else
+            drain_hal_task(mpp, enc, &task_info, pipe->task_out);
+
+        hal_task_hnd_set_status(hnd, TASK_IDLE);
+        hnd = NULL;
+
+        mpp_enc_notify(enc, MPP_ENC_NOTIFY_TASK_DONE);
+    }
 
     return NULL;
 }
@@ -379,9 +657,13 @@ MPP_RET mpp_enc_init(MppEnc *enc, MppEncCfg *cfg)
     MppHal hal = NULL;
     MppEncImpl *p = NULL;
     RK_S32 task_count = 2;
+    RK_U32 hal_task_count = 1;
     IOInterruptCB cb = {NULL, NULL};
 
     mpp_env_get_u32("mpp_enc_debug", &mpp_enc_debug, 0);
+    // frames prepared ahead of the one in hal, 1 for serial encoding
+    mpp_env_get_u32("mpp_enc_task_count", &hal_task_count, 1);
+    hal_task_count = mpp_clip(hal_task_count, 1, MPP_ENC_MAX_TASK_COUNT);
 
     if (NULL == enc) {
         mpp_err_f("failed to malloc context\n");
@@ -416,7 +698,8 @@ MPP_RET mpp_enc_init(MppEnc *enc, MppEncCfg *cfg)
             DEV_VEPU,
             &p->cfg,
             &p->set,
-            task_count,
+            NULL,
+            (RK_S32)hal_task_count,
         };
 
         ret = enc_impl_init(&impl, &ctrl_cfg);
@@ -424,8 +707,8 @@ MPP_RET mpp_enc_init(MppEnc *enc, MppEncCfg *cfg)
             mpp_err_f("could not init impl\n");
             break;
         }
-        cb.callBack = hal_enc_callback;
-        cb.opaque = impl;
+        cb.callBack = mpp_enc_hal_callback;
+        cb.opaque = p;
         // then init hal with task count from impl
         MppHalCfg hal_cfg = {
             MPP_CTX_ENC,
@@ -437,7 +720,7 @@ MPP_RET mpp_enc_init(MppEnc *enc, MppEncCfg *cfg)
             &p->cfg,
             &p->set,
             NULL,
-            1/*ctrl_cfg.task_count*/,  // TODO
+            ctrl_cfg.task_count,
             0,
             cb,
         };
@@ -448,11 +731,19 @@ MPP_RET mpp_enc_init(MppEnc *enc, MppEncCfg *cfg)
             break;
         }
 
+        p->pipe = mpp_calloc(EncPipeTask, ctrl_cfg.task_count);
+        if (NULL == p->pipe) {
+            mpp_err_f("failed to malloc pipe tasks\n");
+            ret = MPP_ERR_MALLOC;
+            break;
+        }
+
         p->coding       = coding;
         p->impl         = impl;
         p->hal          = hal;
         p->mpp          = cfg->mpp;
         p->tasks        = hal_cfg.tasks;
+        p->task_count   = ctrl_cfg.task_count;
         p->frame_slots  = frame_slots;
         p->packet_slots = packet_slots;
 
@@ -496,6 +787,8 @@ MPP_RET mpp_enc_deinit(MppEnc ctx)
         enc->packet_slots = NULL;
     }
 
+    MPP_FREE(enc->pipe);
+
     sem_destroy(&enc->enc_reset);
 
     mpp_free(enc);
@@ -508,6 +801,10 @@ MPP_RET mpp_enc_start(MppEnc ctx)
 
     enc_dbg_func("%p in\n", enc);
 
+    enc->thread_hal = new MppThread(mpp_enc_hal_thread,
+                                    enc->mpp, "mpp_enc_hal");
+    enc->thread_hal->start();
+
     enc->thread_enc = new MppThread(mpp_enc_control_thread,
                                     enc->mpp, "mpp_enc_ctrl");
     enc->thread_enc->start();
@@ -521,15 +818,31 @@ MPP_RET mpp_enc_stop(MppEnc ctx)
 {
     MPP_RET ret = MPP_OK;
     MppEncImpl *enc = (MppEncImpl *)ctx;
+    Mpp *mpp = (Mpp *)enc->mpp;
 
     enc_dbg_func("%p in\n", enc);
 
-    if (enc->thread_enc) {
+    // hal thread finishes the tasks handed over and notifies control thread
+    if (enc->thread_enc)
         enc->thread_enc->stop();
+
+    if (enc->thread_hal) {
+        enc->thread_hal->stop();
+        delete enc->thread_hal;
+        enc->thread_hal = NULL;
+    }
+
+    if (enc->thread_enc) {
         delete enc->thread_enc;
         enc->thread_enc = NULL;
     }
 
+    // clear remain task in output port
+    if (mpp) {
+        release_task_in_port(mpp_task_queue_get_port(mpp->mInputTaskQueue, MPP_PORT_OUTPUT));
+        release_task_in_port(mpp->mOutputPort);
+    }
+
     enc_dbg_func("%p out\n", enc);
     return ret;
 
@@ -711,6 +1024,10 @@ MPP_RET mpp_enc_control(MppEnc ctx, MpiCmd cmd, void *param)
         enc_dbg_ctrl("set ctu qp\n");
         ret = mpp_hal_control(enc->hal, cmd, param);
     } break;
+    case MPP_ENC_SET_HAL_BACKEND: {
+        enc_dbg_ctrl("set hal backend %s\n", (const char *)param);
+        ret = mpp_hal_control(enc->hal, cmd, param);
+    } break;
     default : {
         mpp_log_f("unsupported cmd id %08x param %p\n", cmd, param);
         ret = MPP_NOK;
@@ -31,6 +31,8 @@
 #include "mpp_enc_hal.h"
 #include "hal_h264e_api_v2.h"
 
+#define RC_TRACE_COUNT_DEFAULT      512
+
 RK_U32 mpp_enc_debug = 0;
 
 typedef struct MppEncImpl_t {
@@ -63,6 +65,9 @@ typedef struct MppEncImpl_t {
     // legacy support for MPP_ENC_GET_EXTRA_INFO
     MppPacket           hdr_pkt;
 
+    // rate control trace read by MPP_ENC_GET_RC_TRACE
+    RcTrace             rc_trace;
+
     RK_U32              cmd_send;
     RK_U32              cmd_recv;
     RK_U32              hdr_need_updated;
@@ -426,6 +431,10 @@ void *mpp_enc_thread(void *data)
         mpp_task_meta_set_packet(task_out, KEY_OUTPUT_PACKET, packet);
         mpp_port_enqueue(output, task_out);
 
+        // asynchronous put_frame does not wait for the task, release here
+        if (mpp->mInputDepth && frame)
+            mpp_frame_deinit(&frame);
+
         mpp_task_meta_set_frame(task_in, KEY_INPUT_FRAME, frame);
         mpp_port_enqueue(input, task_in);
 
@@ -450,8 +459,10 @@ MPP_RET mpp_enc_init_v2(MppEnc *enc, MppEncCfg *cfg)
     MppCodingType coding = cfg->coding;
     EncImpl impl = NULL;
     MppEncImpl *p = NULL;
+    RK_U32 trace_count = RC_TRACE_COUNT_DEFAULT;
 
     mpp_env_get_u32("mpp_enc_debug", &mpp_enc_debug, 0);
+    mpp_env_get_u32("rc_trace", &trace_count, RC_TRACE_COUNT_DEFAULT);
 
     if (NULL == enc) {
         mpp_err_f("failed to malloc context\n");
@@ -482,6 +493,7 @@ MPP_RET mpp_enc_init_v2(MppEnc *enc, MppEncCfg *cfg)
         DEV_VEPU,
         &p->cfg,
         &p->set,
+        NULL,
         2,
     };
 
@@ -491,7 +503,12 @@ MPP_RET mpp_enc_init_v2(MppEnc *enc, MppEncCfg *cfg)
         goto ERR_RET;
     }
 
+    // the trace is optional so encoding goes on without it
+    if (trace_count)
+        rc_trace_init(&p->rc_trace, coding, trace_count);
+
     ctrl_cfg.dev_id = enc_hal_cfg.device_id;
+    ctrl_cfg.rc_trace = p->rc_trace;
     ctrl_cfg.task_count = -1;
 
     ret = enc_impl_init(&impl, &ctrl_cfg);
@@ -537,6 +554,11 @@ MPP_RET mpp_enc_deinit_v2(MppEnc ctx)
     if (enc->hdr_pkt)
         mpp_packet_deinit(&enc->hdr_pkt);
 
+    if (enc->rc_trace) {
+        rc_trace_deinit(enc->rc_trace);
+        enc->rc_trace = NULL;
+    }
+
     sem_destroy(&enc->enc_reset);
     sem_destroy(&enc->enc_ctrl);
 
@@ -661,6 +683,16 @@ MPP_RET mpp_enc_control_v2(MppEnc ctx, MpiCmd cmd, void *param)
         enc_dbg_ctrl("get rc config\n");
         memcpy(param, &enc->cfg.rc, sizeof(enc->cfg.rc));
     } break;
+    case MPP_ENC_GET_RC_TRACE : {
+        MppPacket pkt = (MppPacket)param;
+        size_t len = rc_trace_dump(enc->rc_trace, mpp_packet_get_data(pkt),
+                                   mpp_packet_get_size(pkt));
+
+        enc_dbg_ctrl("get rc trace %d bytes\n", (RK_S32)len);
+        mpp_packet_set_length(pkt, len);
+        if (!len)
+            ret = MPP_NOK;
+    } break;
     default : {
         // Cmd which is not get configure will handle by enc_impl
         enc->cmd    = cmd;
@@ -39,6 +39,9 @@ typedef struct MppRcImpl_t {
 
     RK_U32          frm_send;
     RK_U32          frm_done;
+
+    /* owned by encoder and kept across rc context re-creation */
+    RcTrace         trace;
 } MppRcImpl;
 
 RK_U32 rc_debug = 0;
@@ -111,6 +114,15 @@ MPP_RET rc_deinit(RcCtx ctx)
     return ret;
 }
 
+MPP_RET rc_set_trace(RcCtx ctx, RcTrace trace)
+{
+    MppRcImpl *p = (MppRcImpl *)ctx;
+
+    p->trace = trace;
+
+    return MPP_OK;
+}
+
 MPP_RET rc_update_usr_cfg(RcCtx ctx, RcCfg *cfg)
 {
     MppRcImpl *p = (MppRcImpl *)ctx;
@@ -122,6 +134,8 @@ MPP_RET rc_update_usr_cfg(RcCtx ctx, RcCfg *cfg)
     p->cfg = *cfg;
     p->fps = cfg->fps;
 
+    rc_trace_cfg(p->trace, &p->cfg);
+
     if (api && api->init && p->ctx) {
         api->init(p->ctx, &p->cfg);
     }
@@ -168,20 +182,38 @@ MPP_RET rc_frm_start(RcCtx ctx, RcHalCfg *cfg, EncFrmStatus *frm)
 {
     MppRcImpl *p = (MppRcImpl *)ctx;
     const RcImplApi *api = p->api;
+    MPP_RET ret;
 
     if (!api || !api->start || !p->ctx)
         return MPP_OK;
 
-    return api->start(p->ctx, cfg, frm);
+    if (NULL == p->trace)
+        return api->start(p->ctx, cfg, frm);
+
+    RcHalCfg in = *cfg;
+
+    ret = api->start(p->ctx, cfg, frm);
+    rc_trace_frm(p->trace, RC_TRACE_START, frm, &in, cfg);
+
+    return ret;
 }
 
 MPP_RET rc_frm_end(RcCtx ctx, RcHalCfg *cfg)
 {
     MppRcImpl *p = (MppRcImpl *)ctx;
     const RcImplApi *api = p->api;
+    MPP_RET ret;
 
     if (!api || !api->end || !p->ctx)
         return MPP_OK;
 
-    return api->end(p->ctx, cfg);
+    if (NULL == p->trace)
+        return api->end(p->ctx, cfg);
+
+    RcHalCfg in = *cfg;
+
+    ret = api->end(p->ctx, cfg);
+    rc_trace_frm(p->trace, RC_TRACE_END, NULL, &in, cfg);
+
+    return ret;
 }
@@ -29,20 +29,18 @@
  * 1. MppData - data statistic struct
  *    size  - max valid data number
  *    len   - valid data number
- *    pos_r - current data read position
- *    pos_w - current data write position
+ *    pos_w - current data write position, the newest data is just before it
+ *    sum   - running sum of all size entries
  *    val   - buffer array pointer
  *
- *    When statistic length is less than 8 use direct save mode which will move
- *    all the data on each update.
- *    When statistic length is larger than 8 use loop save mode which will
- *    cyclically reuse the data position.
+ *    The data is saved in a ring so update and sum are both O(1). Index 0 of
+ *    mpp_data_get_pre_val_v2 is the newest data, size - 1 is the oldest.
  */
 typedef struct MppDataV2_t {
     RK_S32  size;
     RK_S32  len;
     RK_S32  pos_w;
-    RK_S32  pos_r;
+    RK_S64  sum;
     RK_S32  *val;
 } MppDataV2;
 
@@ -242,9 +240,6 @@ typedef struct RcSyntaxV2_t {
     RK_S32           bit_max;
     RK_S32           bit_min;
     RK_S32           aq_prop_offset;
-
-    /* head node of rc parameter list */
-    struct list_head *rc_head;
 } RcSyntaxV2;
 
 /*
@@ -258,37 +253,6 @@ typedef struct HalRcResultV2_s {
     RK_S32          bits;
 } RcHalResultV2;
 
-typedef struct RecordNodeV2_t {
-    struct list_head list;
-    ENC_FRAME_TYPE   frm_type;
-    /* @frm_cnt starts from ONE */
-    RK_U32           frm_cnt;
-    RK_U32           bps;
-    RK_U32           fps;
-    RK_S32           gop;
-    RK_S32           bits_per_pic;
-    RK_S32           bits_per_intra;
-    RK_S32           bits_per_inter;
-    RK_U32           tgt_bits;
-    RK_U32           bit_min;
-    RK_U32           bit_max;
-    RK_U32           real_bits;
-    RK_S32           acc_intra_bits_in_fps;
-    RK_S32           acc_inter_bits_in_fps;
-    RK_S32           last_fps_bits;
-    float            last_intra_percent;
-
-    /* hardware result */
-    RK_S32           qp_sum;
-    RK_S64           sse_sum;
-    RK_S32           set_qp;
-    RK_S32           qp_min;
-    RK_S32           qp_max;
-    RK_S32           real_qp;
-    MppLinRegV2      lin_reg;
-    RK_S32           wlen;
-} RecordNodeV2;
-
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -298,6 +262,7 @@ void mpp_data_deinit_v2(MppDataV2 *p);
 void mpp_data_reset_v2(MppDataV2 *p, RK_S32 val);
 void mpp_data_update_v2(MppDataV2 *p, RK_S32 val);
 RK_S32 mpp_data_sum_v2(MppDataV2 *p);
+RK_S32 mpp_data_get_pre_val_v2(MppDataV2 *p, RK_S32 idx);
 RK_S32 mpp_data_mean_v2(MppDataV2 *p);
 RK_S32 mpp_data_sum_with_ratio_v2(MppDataV2 *p, RK_S32 len, RK_S32 num, RK_S32 denorm);
 
@@ -336,15 +301,6 @@ MPP_RET mpp_rc_update_hw_result_v2(MppRateControlV2 *ctx, RcHalResultV2 *result)
  */
 MPP_RET mpp_rc_bits_allocation_v2(MppRateControlV2 *ctx, RcSyntaxV2 *rc_syn);
 
-MPP_RET mpp_rc_record_param_v2(struct list_head *head, MppRateControlV2 *ctx,
-                               RcSyntaxV2 *rc_syn);
-
-MPP_RET mpp_rc_calc_real_bps_v2(struct list_head *head, MppRateControlV2 *ctx,
-                                RK_S32 cur_bits);
-
-MPP_RET mpp_rc_param_ops_v2(struct list_head *head, RK_U32 frm_cnt,
-                            RC_PARAM_OPS ops, void *arg);
-
 #ifdef __cplusplus
 }
 #endif
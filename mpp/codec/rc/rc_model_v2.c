@@ -415,7 +415,7 @@ MPP_RET reenc_calc_cbr_ratio(RcModelV2Ctx *ctx, RcHalCfg *cfg)
 {
     RK_S32 stat_time = ctx->usr_cfg.stat_times;
     RK_S32 last_ins_bps = mpp_data_sum_v2(ctx->stat_bits) / stat_time;
-    RK_S32 ins_bps = (last_ins_bps - ctx->stat_bits->val[0] + cfg->bit_real) / stat_time;
+    RK_S32 ins_bps = (last_ins_bps - mpp_data_get_pre_val_v2(ctx->stat_bits, 0) + cfg->bit_real) / stat_time;
     RK_S32 real_bit = cfg->bit_real;
     RK_S32 target_bit = cfg->bit_target;
     RK_S32 target_bps = ctx->target_bps;
@@ -547,7 +547,7 @@ MPP_RET reenc_calc_vbr_ratio(RcModelV2Ctx *ctx, RcHalCfg *cfg)
 {
     RK_S32 stat_time = ctx->usr_cfg.stat_times;
     RK_S32 last_ins_bps = mpp_data_sum_v2(ctx->stat_bits) / stat_time;
-    RK_S32 ins_bps = (last_ins_bps - ctx->stat_bits->val[0] + cfg->bit_real) / stat_time;
+    RK_S32 ins_bps = (last_ins_bps - mpp_data_get_pre_val_v2(ctx->stat_bits, 0) + cfg->bit_real) / stat_time;
     RK_S32 bps_change = ctx->target_bps;
     RK_S32 max_bps_target = ctx->usr_cfg.bps_max;
     RK_S32 real_bit = cfg->bit_real;
@@ -610,7 +610,7 @@ MPP_RET check_re_enc(RcModelV2Ctx *ctx, RcHalCfg *cfg)
     RK_S32 big_flag = 0;
     RK_S32 stat_time = ctx->usr_cfg.stat_times;
     RK_S32 last_ins_bps = mpp_data_sum_v2(ctx->stat_bits) / stat_time;
-    RK_S32 ins_bps = (last_ins_bps - ctx->stat_bits->val[0] + cfg->bit_real) / stat_time;
+    RK_S32 ins_bps = (last_ins_bps - mpp_data_get_pre_val_v2(ctx->stat_bits, 0) + cfg->bit_real) / stat_time;
     RK_S32 target_bps;
     RK_S32 flag1 = 0;
     RK_S32 flag2 = 0;
@@ -0,0 +1,199 @@
+/*
+ * Copyright 2016 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_TAG "rc_trace"
+
+#include <string.h>
+#include <pthread.h>
+
+#include "mpp_mem.h"
+#include "mpp_common.h"
+
+#include "rc_debug.h"
+#include "rc_trace.h"
+
+typedef struct RcTraceImpl_t {
+    pthread_mutex_t lock;
+    MppCodingType   coding;
+
+    /* ring capacity and the number of records ever written */
+    RK_U32          count;
+    RK_U32          total;
+
+    /* the newest config which has been overwritten in the ring */
+    RK_U32          base_valid;
+    RcTraceRec      base;
+
+    RcTraceRec      *recs;
+} RcTraceImpl;
+
+MPP_RET rc_trace_init(RcTrace *trace, MppCodingType coding, RK_S32 count)
+{
+    RcTraceImpl *p = NULL;
+
+    if (NULL == trace || count <= 0) {
+        mpp_err_f("invalid trace %p count %d\n", trace, count);
+        return MPP_ERR_VALUE;
+    }
+
+    *trace = NULL;
+
+    p = mpp_calloc_size(RcTraceImpl, sizeof(RcTraceImpl) + sizeof(RcTraceRec) * count);
+    if (NULL == p) {
+        mpp_err_f("failed to malloc %d records\n", count);
+        return MPP_ERR_MALLOC;
+    }
+
+    pthread_mutex_init(&p->lock, NULL);
+    p->coding = coding;
+    p->count = count;
+    p->recs = (RcTraceRec *)(p + 1);
+
+    *trace = p;
+    return MPP_OK;
+}
+
+MPP_RET rc_trace_deinit(RcTrace trace)
+{
+    RcTraceImpl *p = (RcTraceImpl *)trace;
+
+    if (NULL == p)
+        return MPP_OK;
+
+    pthread_mutex_destroy(&p->lock);
+    MPP_FREE(p);
+    return MPP_OK;
+}
+
+/* take the next slot with lock held, keep the config it drops as base */
+static RcTraceRec *trace_next(RcTraceImpl *p, RcTraceType type)
+{
+    RcTraceRec *rec = &p->recs[p->total % p->count];
+
+    if (p->total >= p->count && rec->type == RC_TRACE_CFG) {
+        p->base = *rec;
+        p->base_valid = 1;
+    }
+
+    rec->type = type;
+    rec->seq = p->total++;
+
+    return rec;
+}
+
+void rc_trace_cfg(RcTrace trace, RcCfg *cfg)
+{
+    RcTraceImpl *p = (RcTraceImpl *)trace;
+    RcTraceRec *rec;
+
+    if (NULL == p)
+        return;
+
+    pthread_mutex_lock(&p->lock);
+    rec = trace_next(p, RC_TRACE_CFG);
+    rec->cfg = *cfg;
+    pthread_mutex_unlock(&p->lock);
+}
+
+void rc_trace_frm(RcTrace trace, RcTraceType type, EncFrmStatus *frm,
+                  RcHalCfg *in, RcHalCfg *out)
+{
+    RcTraceImpl *p = (RcTraceImpl *)trace;
+    RcTraceRec *rec;
+
+    if (NULL == p)
+        return;
+
+    pthread_mutex_lock(&p->lock);
+    rec = trace_next(p, type);
+    if (frm)
+        rec->frm.status = *frm;
+    else
+        memset(&rec->frm.status, 0, sizeof(rec->frm.status));
+    rec->frm.in = *in;
+    rec->frm.out = *out;
+    pthread_mutex_unlock(&p->lock);
+}
+
+size_t rc_trace_dump(RcTrace trace, void *buf, size_t size)
+{
+    RcTraceImpl *p = (RcTraceImpl *)trace;
+    RcTraceHdr *hdr = (RcTraceHdr *)buf;
+    RcTraceRec *dst = (RcTraceRec *)(hdr + 1);
+    const RcTraceRec *cfg = NULL;
+    RK_U32 first, start, fit, seq;
+    RK_U32 flag = 0;
+
+    if (NULL == p || NULL == buf || size < sizeof(*hdr) + sizeof(*dst))
+        return 0;
+
+    fit = (size - sizeof(*hdr)) / sizeof(*dst);
+
+    pthread_mutex_lock(&p->lock);
+
+    if (!p->total) {
+        pthread_mutex_unlock(&p->lock);
+        return 0;
+    }
+
+    first = p->total - MPP_MIN(p->total, p->count);
+    start = p->total - MPP_MIN(p->total - first, fit);
+
+    // find the config in effect for the oldest record to dump
+    for (seq = start + 1; seq-- > first;) {
+        const RcTraceRec *rec = &p->recs[seq % p->count];
+
+        if (rec->type == RC_TRACE_CFG) {
+            cfg = rec;
+            break;
+        }
+    }
+    if (NULL == cfg && p->base_valid)
+        cfg = &p->base;
+
+    if (NULL == cfg) {
+        pthread_mutex_unlock(&p->lock);
+        return 0;
+    }
+
+    if (cfg->seq != start) {
+        // prepend the config and make room for it when the buffer is full
+        if (p->total - start + 1 > fit)
+            start++;
+
+        if (start == p->total || p->recs[start % p->count].type != RC_TRACE_CFG) {
+            *dst++ = *cfg;
+            if (cfg->seq + 1 != start)
+                flag |= RC_TRACE_FLAG_PARTIAL;
+        }
+    }
+
+    for (seq = start; seq < p->total; seq++)
+        *dst++ = p->recs[seq % p->count];
+
+    pthread_mutex_unlock(&p->lock);
+
+    hdr->magic = RC_TRACE_MAGIC;
+    hdr->version = RC_TRACE_VERSION;
+    hdr->hdr_size = sizeof(*hdr);
+    hdr->rec_size = sizeof(*dst);
+    hdr->count = dst - (RcTraceRec *)(hdr + 1);
+    hdr->coding = p->coding;
+    hdr->flag = flag;
+    hdr->reserve = 0;
+
+    return (RK_U8 *)dst - (RK_U8 *)buf;
+}
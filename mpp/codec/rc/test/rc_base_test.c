@@ -17,19 +17,163 @@
 #define MODULE_TAG "mpp_rc_test"
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "mpp_log.h"
+#include "mpp_common.h"
 #include "rc_base.h"
 
+#define SIGN(a)         ((a) < (0) ? (-1) : (1))
+#define DIV(a, b)       (((a) + (SIGN(a) * (b)) / 2) / (b))
+
+#define REF_MAX_SIZE    64
+#define REF_RATIO_LEN   16
+#define REF_UPDATES     1000
+
+/* the memmove based window MppDataV2 used before, val[0] is the newest */
+typedef struct RefData_t {
+    RK_S32  size;
+    RK_S32  val[REF_MAX_SIZE];
+} RefData;
+
+static void ref_reset(RefData *p, RK_S32 val)
+{
+    RK_S32 i;
+
+    for (i = 0; i < p->size; i++)
+        p->val[i] = val;
+}
+
+static void ref_update(RefData *p, RK_S32 val)
+{
+    memmove(p->val + 1, p->val, sizeof(RK_S32) * (p->size - 1));
+    p->val[0] = val;
+}
+
+static RK_S32 ref_sum(RefData *p)
+{
+    RK_S32 sum = 0;
+    RK_S32 i;
+
+    for (i = 0; i < p->size; i++)
+        sum += p->val[i];
+
+    return sum;
+}
+
+static RK_S32 ref_sum_with_ratio(RefData *p, RK_S32 len, RK_S32 num, RK_S32 denorm)
+{
+    RK_S64 sum = 0;
+    RK_S32 i;
+
+    if (num == denorm) {
+        for (i = 0; i < len; i++)
+            sum += p->val[i];
+    } else {
+        RK_S64 acc_num = 1;
+        RK_S64 acc_denorm = 1;
+
+        for (i = 0; i < len; i++) {
+            sum += p->val[i] * acc_num / acc_denorm;
+            acc_num *= num;
+            acc_denorm *= denorm;
+        }
+    }
+
+    return DIV(sum, len);
+}
+
+static MPP_RET check_window(MppDataV2 *data, RefData *ref)
+{
+    static const RK_S32 ratio[][2] = {
+        { 1, 1 }, { 3, 4 }, { 1, 2 }, { 7, 8 }, { 5, 4 },
+    };
+    RK_S32 size = ref->size;
+    RK_U32 i;
+    RK_S32 len;
+
+    if (mpp_data_sum_v2(data) != ref_sum(ref) ||
+        mpp_data_mean_v2(data) != ref_sum(ref) / size) {
+        mpp_err("size %d sum %d vs %d\n", size,
+                mpp_data_sum_v2(data), ref_sum(ref));
+        return MPP_NOK;
+    }
+
+    for (len = 0; len < size; len++) {
+        if (mpp_data_get_pre_val_v2(data, len) != ref->val[len]) {
+            mpp_err("size %d pre val %d is %d vs %d\n", size, len,
+                    mpp_data_get_pre_val_v2(data, len), ref->val[len]);
+            return MPP_NOK;
+        }
+    }
+
+    for (i = 0; i < MPP_ARRAY_ELEMS(ratio); i++) {
+        RK_S32 num = ratio[i][0];
+        RK_S32 denorm = ratio[i][1];
+        RK_S32 max_len = (num == denorm) ? size : MPP_MIN(size, REF_RATIO_LEN);
+
+        for (len = 1; len <= max_len; len++) {
+            RK_S32 got = mpp_data_sum_with_ratio_v2(data, len, num, denorm);
+            RK_S32 exp = ref_sum_with_ratio(ref, len, num, denorm);
+
+            if (got != exp) {
+                mpp_err("size %d len %d ratio %d/%d sum %d vs %d\n",
+                        size, len, num, denorm, got, exp);
+                return MPP_NOK;
+            }
+        }
+    }
+
+    return MPP_OK;
+}
+
+/* random rate control like bit counts checked against the old window */
+static MPP_RET check_size(RK_S32 size)
+{
+    MppDataV2 *data = NULL;
+    RefData ref;
+    MPP_RET ret = MPP_NOK;
+    RK_S32 i;
+
+    if (mpp_data_init_v2(&data, size))
+        return MPP_NOK;
+
+    ref.size = size;
+    ref_reset(&ref, 0);
+
+    srand(size);
+    for (i = 0; i < REF_UPDATES; i++) {
+        RK_S32 val = rand() % (1 << 20) - (1 << 16);
+
+        // windows are reset on rc config change
+        if (i % 397 == 0) {
+            mpp_data_reset_v2(data, val);
+            ref_reset(&ref, val);
+        } else {
+            mpp_data_update_v2(data, val);
+            ref_update(&ref, val);
+        }
+
+        if (check_window(data, &ref))
+            goto DONE;
+    }
+
+    ret = MPP_OK;
+DONE:
+    mpp_data_deinit_v2(data);
+    return ret;
+}
+
 int main()
 {
-    MPP_RET ret = MPP_ERR_UNKNOW;
+    static const RK_S32 sizes[] = { 1, 2, 5, 8, 9, 30, 60, REF_MAX_SIZE };
+    MPP_RET ret = MPP_NOK;
     MppDataV2 *data_2 = NULL;
     MppDataV2 *data_5 = NULL;
     MppDataV2 *data_8 = NULL;
     MppDataV2 *data_30 = NULL;
     RK_S32 val = 0;
-    RK_S32 i;
+    RK_U32 i;
 
     mpp_log("mpp rc test start\n");
 
@@ -67,8 +211,19 @@ int main()
     mpp_data_deinit_v2(data_30);
     mpp_data_deinit_v2(data_2);
 
-    mpp_log("mpp rc test success\n");
+    for (i = 0; i < MPP_ARRAY_ELEMS(sizes); i++) {
+        if (check_size(sizes[i])) {
+            mpp_err("ring window differs from the memmove window\n");
+            goto TEST_FAILED;
+        }
+    }
+
+    ret = MPP_OK;
+TEST_FAILED:
+    if (ret)
+        mpp_log("mpp rc test failed\n");
+    else
+        mpp_log("mpp rc test success\n");
 
     return ret;
 }
-
@@ -0,0 +1,415 @@
+/*
+ * Copyright 2015 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_TAG "rc_trace_test"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mpp_log.h"
+#include "mpp_common.h"
+#include "rc.h"
+
+#define TEST_FRAMES         300
+#define TEST_GOP            30
+
+/*
+ * Offline replay of a rate control trace from MPP_ENC_GET_RC_TRACE.
+ *
+ * Without overrides every rc_frm_start / rc_frm_end output must be equal to
+ * the recorded one. With overrides the recorded real bits are fed back into
+ * the modified model, which only approximates an encoder which would have
+ * produced different frame sizes for the new targets.
+ */
+typedef struct ReplayOpt_t {
+    RK_S32      bps_target;
+    RK_S32      bps_max;
+    RK_S32      bps_min;
+    RK_S32      stat_times;
+    RK_S32      max_i_bit_prop;
+    RK_S32      verbose;
+} ReplayOpt;
+
+typedef struct ReplayStat_t {
+    RK_S32      cfgs;
+    RK_S32      frames;
+    RK_S32      mismatch;
+    RK_S64      bits_real;
+    RK_S64      bits_target;
+    RK_S64      bits_replay;
+} ReplayStat;
+
+static RK_S32 replay_override(ReplayOpt *opt, RcCfg *cfg)
+{
+    RK_S32 changed = 0;
+
+    if (opt->bps_target) {
+        cfg->bps_target = opt->bps_target;
+        changed = 1;
+    }
+    if (opt->bps_max) {
+        cfg->bps_max = opt->bps_max;
+        changed = 1;
+    }
+    if (opt->bps_min) {
+        cfg->bps_min = opt->bps_min;
+        changed = 1;
+    }
+    if (opt->stat_times) {
+        cfg->stat_times = opt->stat_times;
+        changed = 1;
+    }
+    if (opt->max_i_bit_prop) {
+        cfg->max_i_bit_prop = opt->max_i_bit_prop;
+        changed = 1;
+    }
+
+    return changed;
+}
+
+static MPP_RET replay(const void *buf, size_t size, ReplayOpt *opt, ReplayStat *stat)
+{
+    const RcTraceHdr *hdr = (const RcTraceHdr *)buf;
+    const RcTraceRec *rec = (const RcTraceRec *)(hdr + 1);
+    RcHalCfg start_out;
+    RcCtx ctx = NULL;
+    RK_S32 tuned = 0;
+    RK_U32 i;
+
+    memset(stat, 0, sizeof(*stat));
+    memset(&start_out, 0, sizeof(start_out));
+
+    if (size < sizeof(*hdr) || hdr->magic != RC_TRACE_MAGIC ||
+        hdr->version != RC_TRACE_VERSION || hdr->hdr_size != sizeof(*hdr) ||
+        hdr->rec_size != sizeof(*rec) ||
+        size < sizeof(*hdr) + (size_t)hdr->count * sizeof(*rec)) {
+        mpp_err("invalid trace size %d\n", (RK_S32)size);
+        return MPP_NOK;
+    }
+
+    if (!hdr->count || rec[0].type != RC_TRACE_CFG) {
+        mpp_err("trace does not start with a config\n");
+        return MPP_NOK;
+    }
+
+    if (hdr->flag & RC_TRACE_FLAG_PARTIAL)
+        mpp_log("trace starts mid-stream, model state is rebuilt from the last config\n");
+
+    for (i = 0; i < hdr->count; i++, rec++) {
+        switch (rec->type) {
+        case RC_TRACE_CFG : {
+            RcCfg cfg = rec->cfg;
+
+            // encoder creates a new rc context on each config change
+            if (ctx)
+                rc_deinit(ctx);
+            ctx = NULL;
+
+            tuned = replay_override(opt, &cfg);
+            if (rc_init(&ctx, (MppCodingType)hdr->coding, NULL))
+                return MPP_NOK;
+            rc_update_usr_cfg(ctx, &cfg);
+            stat->cfgs++;
+        } break;
+        case RC_TRACE_START : {
+            EncFrmStatus frm = rec->frm.status;
+            RcHalCfg hal = rec->frm.in;
+
+            rc_frm_start(ctx, &hal, &frm);
+            start_out = hal;
+
+            if (memcmp(&hal, &rec->frm.out, sizeof(hal)))
+                stat->mismatch++;
+
+            stat->frames++;
+            stat->bits_target += rec->frm.out.bit_target;
+            stat->bits_replay += hal.bit_target;
+
+            if (opt->verbose)
+                mpp_log("seq %6d %c target %8d replay %8d next_ratio %4d %4d\n",
+                        rec->seq, frm.is_intra ? 'I' : 'P',
+                        rec->frm.out.bit_target, hal.bit_target,
+                        rec->frm.out.next_ratio, hal.next_ratio);
+        } break;
+        case RC_TRACE_END : {
+            RcHalCfg hal = rec->frm.in;
+
+            // a tuned model has its own targets, keep only the hardware result
+            if (tuned) {
+                hal.bit_target = start_out.bit_target;
+                hal.bit_max = start_out.bit_max;
+                hal.bit_min = start_out.bit_min;
+                hal.next_i_ratio = start_out.next_i_ratio;
+                hal.next_ratio = start_out.next_ratio;
+            }
+
+            rc_frm_end(ctx, &hal);
+
+            if (memcmp(&hal, &rec->frm.out, sizeof(hal)))
+                stat->mismatch++;
+
+            stat->bits_real += rec->frm.in.bit_real;
+        } break;
+        default : {
+            mpp_err("invalid record type %d at %d\n", rec->type, i);
+            rc_deinit(ctx);
+            return MPP_NOK;
+        }
+        }
+    }
+
+    if (ctx)
+        rc_deinit(ctx);
+
+    return MPP_OK;
+}
+
+static void init_cfg(RcCfg *cfg, RK_S32 bps)
+{
+    memset(cfg, 0, sizeof(*cfg));
+
+    cfg->mode = RC_CBR;
+    cfg->fps.fps_in_num = 30;
+    cfg->fps.fps_in_denorm = 1;
+    cfg->fps.fps_out_num = 30;
+    cfg->fps.fps_out_denorm = 1;
+    cfg->igop = TEST_GOP;
+    cfg->bps_target = bps;
+    cfg->bps_max = bps * 17 / 16;
+    cfg->bps_min = bps * 15 / 16;
+    cfg->stat_times = 3;
+    cfg->max_i_bit_prop = 20;
+    cfg->min_i_bit_prop = 10;
+    cfg->max_reencode_times = 1;
+}
+
+/* drive the rc framework like h264e does with a noisy synthetic encoder */
+static void run_encoder(RcTrace trace)
+{
+    RcCtx ctx = NULL;
+    RcCfg cfg;
+    RK_S32 i;
+
+    srand(1);
+    for (i = 0; i < TEST_FRAMES; i++) {
+        EncFrmStatus frm;
+        RcHalCfg hal;
+
+        if (i == 0 || i == TEST_FRAMES / 2) {
+            if (ctx)
+                rc_deinit(ctx);
+
+            init_cfg(&cfg, i ? SZ_1M : 2 * SZ_1M);
+            rc_init(&ctx, MPP_VIDEO_CodingAVC, NULL);
+            rc_set_trace(ctx, trace);
+            rc_update_usr_cfg(ctx, &cfg);
+        }
+
+        memset(&frm, 0, sizeof(frm));
+        memset(&hal, 0, sizeof(hal));
+        frm.is_intra = !(i % TEST_GOP);
+        frm.is_idr = frm.is_intra;
+
+        rc_frm_start(ctx, &hal, &frm);
+
+        hal.bit_real = hal.bit_target / 2 + rand() % (hal.bit_target + 1);
+        hal.quality_real = 26 + rand() % 8;
+        rc_frm_end(ctx, &hal);
+
+        if (hal.need_reenc) {
+            frm.reencode = 1;
+            rc_frm_start(ctx, &hal, &frm);
+            hal.bit_real = hal.bit_target;
+            rc_frm_end(ctx, &hal);
+        }
+    }
+
+    rc_deinit(ctx);
+}
+
+static MPP_RET check_trace(void)
+{
+    size_t size = sizeof(RcTraceHdr) + sizeof(RcTraceRec) * TEST_FRAMES * 8;
+    void *buf = malloc(size);
+    RcTraceHdr *hdr = (RcTraceHdr *)buf;
+    RcTraceRec *rec = (RcTraceRec *)(hdr + 1);
+    RcTrace trace = NULL;
+    ReplayOpt opt;
+    ReplayStat stat;
+    MPP_RET ret = MPP_NOK;
+    size_t len;
+    RK_U32 i;
+
+    memset(&opt, 0, sizeof(opt));
+
+    if (NULL == buf)
+        return MPP_ERR_MALLOC;
+
+    // the whole stream fits so replay must be exact
+    rc_trace_init(&trace, MPP_VIDEO_CodingAVC, TEST_FRAMES * 4);
+    run_encoder(trace);
+
+    len = rc_trace_dump(trace, buf, size);
+    if (!len || replay(buf, len, &opt, &stat) || stat.mismatch ||
+        stat.cfgs != 2 || stat.frames < TEST_FRAMES || hdr->flag) {
+        mpp_err("full trace len %d frames %d mismatch %d\n",
+                (RK_S32)len, stat.frames, stat.mismatch);
+        goto DONE;
+    }
+
+    // a short buffer gets the newest records behind the config in effect
+    len = rc_trace_dump(trace, buf, sizeof(*hdr) + sizeof(*rec) * 16);
+    if (hdr->count != 16 || rec[0].type != RC_TRACE_CFG ||
+        !(hdr->flag & RC_TRACE_FLAG_PARTIAL) || replay(buf, len, &opt, &stat)) {
+        mpp_err("short dump count %d flag %x\n", hdr->count, hdr->flag);
+        goto DONE;
+    }
+    for (i = 2; i < hdr->count; i++) {
+        if (rec[i].seq != rec[i - 1].seq + 1) {
+            mpp_err("short dump seq %d after %d\n", rec[i].seq, rec[i - 1].seq);
+            goto DONE;
+        }
+    }
+    rc_trace_deinit(trace);
+    trace = NULL;
+
+    // a ring smaller than the stream keeps the overwritten config
+    rc_trace_init(&trace, MPP_VIDEO_CodingAVC, 64);
+    run_encoder(trace);
+
+    len = rc_trace_dump(trace, buf, size);
+    if (hdr->count != 65 || rec[0].type != RC_TRACE_CFG ||
+        rec[0].cfg.bps_target != SZ_1M || replay(buf, len, &opt, &stat)) {
+        mpp_err("ring dump count %d\n", hdr->count);
+        goto DONE;
+    }
+
+    // tuning replays the recorded frame sizes against new targets
+    opt.bps_target = SZ_1M / 2;
+    if (replay(buf, len, &opt, &stat) || stat.bits_replay >= stat.bits_target) {
+        mpp_err("tuned replay target %lld vs %lld\n",
+                stat.bits_replay, stat.bits_target);
+        goto DONE;
+    }
+
+    ret = MPP_OK;
+DONE:
+    rc_trace_deinit(trace);
+    free(buf);
+    return ret;
+}
+
+static void *read_file(const char *path, size_t *size)
+{
+    FILE *fp = fopen(path, "rb");
+    void *buf = NULL;
+    long len;
+
+    if (NULL == fp) {
+        mpp_err("failed to open %s\n", path);
+        return NULL;
+    }
+
+    fseek(fp, 0, SEEK_END);
+    len = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    if (len > 0)
+        buf = malloc(len);
+    if (buf && fread(buf, 1, len, fp) != (size_t)len) {
+        free(buf);
+        buf = NULL;
+    }
+    fclose(fp);
+
+    *size = buf ? (size_t)len : 0;
+    return buf;
+}
+
+static void usage(void)
+{
+    mpp_log("usage: rc_trace_test [-i trace] [-b bps] [-x bps_max] [-n bps_min]\n");
+    mpp_log("                     [-s stat_times] [-p max_i_bit_prop] [-v]\n");
+    mpp_log("without -i run the built-in record and replay check\n");
+}
+
+int main(int argc, char **argv)
+{
+    MPP_RET ret = MPP_NOK;
+    const char *path = NULL;
+    ReplayOpt opt;
+    ReplayStat stat;
+    void *buf = NULL;
+    size_t size = 0;
+    int i;
+
+    memset(&opt, 0, sizeof(opt));
+
+    for (i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (!strcmp(arg, "-v")) {
+            opt.verbose = 1;
+            continue;
+        }
+        if (NULL == val || arg[0] != '-' || !arg[1] || arg[2]) {
+            usage();
+            return MPP_NOK;
+        }
+
+        switch (arg[1]) {
+        case 'i' : path = val; break;
+        case 'b' : opt.bps_target = atoi(val); break;
+        case 'x' : opt.bps_max = atoi(val); break;
+        case 'n' : opt.bps_min = atoi(val); break;
+        case 's' : opt.stat_times = atoi(val); break;
+        case 'p' : opt.max_i_bit_prop = atoi(val); break;
+        default : {
+            usage();
+            return MPP_NOK;
+        }
+        }
+        i++;
+    }
+
+    mpp_log("rc_trace_test start\n");
+
+    if (NULL == path) {
+        ret = check_trace();
+        goto TEST_DONE;
+    }
+
+    buf = read_file(path, &size);
+    if (NULL == buf || replay(buf, size, &opt, &stat))
+        goto TEST_DONE;
+
+    mpp_log("config %d frames %d mismatch %d\n", stat.cfgs, stat.frames, stat.mismatch);
+    mpp_log("real bits %lld target bits %lld replayed target bits %lld\n",
+            stat.bits_real, stat.bits_target, stat.bits_replay);
+    ret = MPP_OK;
+
+TEST_DONE:
+    free(buf);
+
+    if (ret)
+        mpp_log("rc_trace_test failed\n");
+    else
+        mpp_log("rc_trace_test success\n");
+
+    return ret;
+}
@@ -82,7 +82,7 @@ static MPP_RET hal_h264e_init(void *hal, MppHalCfg *cfg)
         api->control = hal_h264e_vepu1_control;
         hw_cfg->hw_type = H264E_VPU;
     } else {
-      #if defined(USE_REMOTE_VPU) || defined(USE_SOFT_X264) || defined(USE_VPU_NVIDIA)
+#if defined(USE_REMOTE_VPU) || defined(USE_SOFT_X264) || defined(USE_VPU_NVIDIA)
         api->init    = hal_h264e_stub_init;
         api->deinit  = hal_h264e_stub_deinit;
         api->reg_gen = hal_h264e_stub_gen_regs;
@@ -94,11 +94,11 @@ static MPP_RET hal_h264e_init(void *hal, MppHalCfg *cfg)
         hw_cfg->hw_type = H264E_VPU;
         mpp_log("vcodec type %08x use remote H.264 encoder device\n",
                 vcodec_type);
-      #else /* !USE_REMOTE_VPU */
+#else /* !USE_REMOTE_VPU */
         mpp_err("vcodec type %08x can not find H.264 encoder device\n",
                 vcodec_type);
         return MPP_NOK;
-      #endif /* USE_REMOTE_VPU */
+#endif /* USE_REMOTE_VPU */
     }
 
     /*
@@ -270,6 +270,10 @@ typedef struct H264eHalContext_t {
     void                            *ioctl_output;
     void                            *buffers;
     void                            *extra_info;
+    /* RvpuBackend of the stub hal, owns extra_info */
+    const void                      *backend;
+    /* packets of the stub encoded again after a backend was lost */
+    void                            *replay;
     void                            *dpb_ctx;
     void                            *dump_files;
     RK_U32                          frame_cnt_gen_ready;
@@ -191,6 +191,9 @@ typedef struct HalEncTask_t {
     RK_U32          is_intra;
     RK_S32          temporal_id;
 
+    // frames kept by hal after this task, output by later tasks
+    RK_U32          delayed;
+
     HalEncTaskFlag  flags;
 } HalEncTask;
 
@@ -32,18 +32,13 @@
 #include "hal_h264d_nv.h"
 #endif
 
-// TODO: save in context
-#ifdef _VPU_STUB_
-static int remote_fd = -1;
-#endif
-
 MPP_RET hal_h264d_stub_init(void *hal, MppHalCfg *cfg)
 {
     MPP_RET ret = MPP_OK;
     H264dHalCtx_t *ctx = (H264dHalCtx_t *)hal;
 
     ctx->fast_mode = cfg->fast_mode;
-    // ctx->priv = NULL;
+    ctx->priv = NULL;
     // ctx->reg_ctx
     // ctx->frame_slots
 
@@ -52,8 +47,14 @@ MPP_RET hal_h264d_stub_init(void *hal, MppHalCfg *cfg)
 #endif
 
 #ifdef _VPU_STUB_
-    if ((remote_fd = connect_remote()) > 0) {
-        ret = send_remote(remote_fd, RVPU_PRIM_INIT, NULL, 0);
+    // one remote channel per decoder context
+    if (NULL == (ctx->priv = mpp_calloc(HalRvpuInfo, 1))) {
+        ret = MPP_ERR_NOMEM;
+    } else {
+        HalRvpuInfo *remote = (HalRvpuInfo *)ctx->priv;
+        if (MPP_OK == rvpu_open(remote)) {
+            ret = rvpu_send(remote, RVPU_PRIM_INIT, NULL, 0);
+        }
     }
 #endif
 
@@ -69,8 +70,10 @@ MPP_RET hal_h264d_stub_deinit(void *hal)
 #endif
 
 #ifdef _VPU_STUB_
-    if (remote_fd > 0) {
-        disconnect_remote(remote_fd);
+    H264dHalCtx_t *ctx = (H264dHalCtx_t *)hal;
+    if (ctx->priv) {
+        rvpu_close((HalRvpuInfo *)ctx->priv);
+        MPP_FREE(ctx->priv);
     }
 #endif
 
@@ -86,8 +89,10 @@ MPP_RET hal_h264d_stub_gen_regs(void *hal, HalTaskInfo *task)
 #endif
 
 #ifdef _VPU_STUB_
-    if (remote_fd > 0) {
-        send_remote(remote_fd, RVPU_PRIM_REGS, NULL, 0);
+    HalRvpuInfo *remote = (HalRvpuInfo *)((H264dHalCtx_t *)hal)->priv;
+
+    if (remote && remote->remote_fd > 0) {
+        rvpu_queue(remote, RVPU_PRIM_REGS, NULL, 0);
     }
 #endif
 
@@ -103,7 +108,9 @@ MPP_RET hal_h264d_stub_start(void *hal, HalTaskInfo *task)
 #endif
 
 #ifdef _VPU_STUB_
-    if (remote_fd > 0) {
+    HalRvpuInfo *remote = (HalRvpuInfo *)((H264dHalCtx_t *)hal)->priv;
+
+    if (remote && remote->remote_fd > 0) {
         MppBuffer input = task->dec.input;
         MppBufferInfo binfo;
         mpp_buffer_info_get(input, &binfo);
@@ -111,9 +118,9 @@ MPP_RET hal_h264d_stub_start(void *hal, HalTaskInfo *task)
             // mpp_buffer_inc_ref(input);
             binfo.fd = 0;       // requires ion_map from binfo.hdl
             binfo.ptr = NULL;   // required ion_import
-            send_remote(remote_fd, RVPU_PRIM_START, &binfo, sizeof(binfo));
+            rvpu_queue(remote, RVPU_PRIM_START, &binfo, sizeof(binfo));
         } else {
-            send_remote(remote_fd, RVPU_PRIM_START, NULL, 0);
+            rvpu_queue(remote, RVPU_PRIM_START, NULL, 0);
         }
     }
 #endif
@@ -131,7 +138,9 @@ MPP_RET hal_h264d_stub_wait(void *hal, HalTaskInfo *task)
 #endif
 
 #ifdef _VPU_STUB_
-    if (remote_fd > 0) {
+    HalRvpuInfo *remote = (HalRvpuInfo *)((H264dHalCtx_t *)hal)->priv;
+
+    if (remote && remote->remote_fd > 0) {
         MppBuffer     output = task->dec.output;
         MppBufferInfo binfo;
         mpp_buffer_info_get(output, &binfo);
@@ -141,17 +150,17 @@ MPP_RET hal_h264d_stub_wait(void *hal, HalTaskInfo *task)
             // pbuf[0] = '\0';
             binfo.fd = 0;       // requires ion_map from binfo.hdl
             binfo.ptr = NULL;   // required ion_import
-            send_remote(remote_fd, RVPU_PRIM_WAIT, &binfo, sizeof(binfo));
+            rvpu_send(remote, RVPU_PRIM_WAIT, &binfo, sizeof(binfo));
             // TODO: set output buffer ready-flag
             // while (!puf[0]) { usleep(100); }
         } else {
-            send_remote(remote_fd, RVPU_PRIM_WAIT, NULL, 0);
+            rvpu_send(remote, RVPU_PRIM_WAIT, NULL, 0);
         }
     }
 #endif
 
     return ret;
-    
+
 }
 
 MPP_RET hal_h264d_stub_reset(void *hal)
@@ -164,8 +173,10 @@ MPP_RET hal_h264d_stub_reset(void *hal)
 #endif
 
 #ifdef _VPU_STUB_
-    if (remote_fd > 0) {
-        send_remote(remote_fd, RVPU_PRIM_RESET, NULL, 0);
+    HalRvpuInfo *remote = (HalRvpuInfo *)((H264dHalCtx_t *)hal)->priv;
+
+    if (remote && remote->remote_fd > 0) {
+        rvpu_send(remote, RVPU_PRIM_RESET, NULL, 0);
     }
 #endif
 
@@ -182,8 +193,10 @@ MPP_RET hal_h264d_stub_flush(void *hal)
 #endif
 
 #ifdef _VPU_STUB_
-    if (remote_fd > 0) {
-        send_remote(remote_fd, RVPU_PRIM_FLUSH, NULL, 0);
+    HalRvpuInfo *remote = (HalRvpuInfo *)((H264dHalCtx_t *)hal)->priv;
+
+    if (remote && remote->remote_fd > 0) {
+        rvpu_send(remote, RVPU_PRIM_FLUSH, NULL, 0);
     }
 #endif
 
@@ -16,19 +16,24 @@
 
 #define MODULE_TAG "mpp_hal_h264e_stub"
 
+#include <pthread.h>
 #include <string.h>
 #include <math.h>
 #include <limits.h>
 
+#include "mpp_env.h"
 #include "mpp_device.h"
 #include "mpp_common.h"
 #include "mpp_mem.h"
 #include "mpp_log.h"
 #include "mpp_allocator.h"
+#include "mpp_time.h"
+#include "mpp_runtime.h"
 
 #include "h264_syntax.h"
 #include "hal_h264e_stub.h"
 #include "rvpu_primitive.h"
+#include "rvpu_backend.h"
 
 #ifdef USE_VPU_NVIDIA
 #include "hal_h264e_nv.h"
@@ -38,206 +43,277 @@
 #include "hal_h264e_x264.h"
 #endif
 
-const int MAX_WAIT_TIMES = 50;     // 50ms
+#ifdef _VPU_STUB_
+/*
+ * Server maps an ion buffer from its handle. Without ion device the buffer
+ * is plain memory, which only a server in the same process can use by its
+ * address.
+ */
+static RK_S32 share_buffer(MppBuffer buffer, MppBufferInfo *binfo)
+{
+    mpp_buffer_info_get(buffer, binfo);
+    if (binfo->type != MPP_BUFFER_TYPE_ION)
+        return 0;
 
-MPP_RET hal_h264e_stub_init(void *hal, MppHalCfg *cfg)
+    if (mpp_rt_allcator_is_valid(MPP_BUFFER_TYPE_ION)) {
+        binfo->fd = 0;      // requires ion_map from binfo.hdl
+        binfo->ptr = NULL;  // required ion_import
+    }
+    return 1;
+}
+
+static MPP_RET import_packet(HalTaskInfo *task, MppBufferInfo *info)
 {
-    MPP_RET ret = MPP_OK;
-    H264eHalContext *ctx = (H264eHalContext *)hal;
-    
-    // mpp_log("init %p\n", ctx);
+    MppBuffer output = NULL;
 
-    ctx->int_cb = cfg->hal_int_cb;
-  //ctx->buffers = mpp_calloc(h264e_hal_vpu_buffers, 1);
-    ctx->param_buf = NULL;
-    ctx->cfg = cfg->cfg;
-    ctx->set = cfg->set;
+    mpp_buffer_import(&output, info);
+    if (NULL == output) {
+        mpp_err("invalid packet buffer with size %u", info->size);
+        return MPP_NOK;
+    }
 
-#if defined(USE_VPU_NVIDIA)
-    ret = hal_h264e_nv_init(hal, cfg);
-#elif defined(USE_SOFT_VPU_X264)
-    ret = hal_h264e_x264_init(hal, cfg);
-#elif defined(_VPU_STUB_)
-    if (NULL == (ctx->extra_info = mpp_calloc(HalRvpuInfo, 1))) {
-        ret = MPP_ERR_NOMEM;
-    } else {
-        HalRvpuInfo *info = (HalRvpuInfo *)ctx->extra_info;
-        if ((info->remote_fd = connect_remote()) > 0) {
-            ret = send_remote(info->remote_fd, RVPU_PRIM_INIT, NULL, 0);
-        } else {
-            ret = MPP_NOK;
-        }
+    //mpp_buffer_put(task->enc.output);
+    task->enc.output = output;
+    mpp_buffer_inc_ref(output);
+    return MPP_OK;
+}
+
+/*
+ * Output buffer the server writes the packet of this task to. At depth 1 the
+ * frame completes on its own task, so the task output is used directly.
+ * Otherwise the task output is handed to the user before its frame completes
+ * and the server gets a buffer of its own.
+ */
+static MppBuffer get_wait_buffer(HalRvpuInfo *info, HalTaskInfo *task)
+{
+    MppBuffer output = task->enc.output;
+    MppBuffer buffer = NULL;
+
+    if (info->depth <= 1) {
+        mpp_buffer_inc_ref(output);
+        return output;
     }
-#endif
 
-    return ret;
+    if (NULL == info->group &&
+        mpp_buffer_group_get_internal(&info->group, MPP_BUFFER_TYPE_ION))
+        return NULL;
+
+    mpp_buffer_get(info->group, &buffer, mpp_buffer_get_size(output));
+    return buffer;
 }
 
-MPP_RET hal_h264e_stub_deinit(void *hal)
+/*
+ * Complete the oldest frame in flight. With depth > 1 the packet is reported
+ * on a later task, the same as the cached frames of x264, so it carries the
+ * pts and rc type of its own frame.
+ */
+static MPP_RET complete_oldest(HalRvpuInfo *info, HalTaskInfo *task, RK_S32 *type,
+                               size_t *outsize)
 {
-    MPP_RET ret = MPP_OK;
-    H264eHalContext *ctx = (H264eHalContext *)hal;
-    // mpp_log("deinit %p\n", ctx);
-    
-    if (ctx->param_buf) {
-        mpp_free(ctx->param_buf);
-        ctx->param_buf = NULL;
+    RvpuInflight *frame = rvpu_inflight_peek(info);
+    MppBuffer output = task->enc.output;
+    MppBuffer copy;
+    RvpuWaitResult result;
+    RK_S32 ret;
+
+    *outsize = 0;
+    if (NULL == frame)
+        return MPP_OK;
+
+    // a lost remote leaves its frames in flight to the fallback backend
+    ret = rvpu_wait(info, frame->seq, &result, (RK_S32)info->timeout);
+    if (ret < 0)
+        return MPP_ERR_VPUHW;   // remote closed
+
+    rvpu_inflight_pop(info);
+    copy = frame->output;
+    if (ret == 0) {
+        rvpu_inflight_release(frame);
+        mpp_log("read response timeout");
+        return MPP_OK;
     }
 
-#if defined(USE_VPU_NVIDIA)
-    ret = hal_h264e_nv_deinit(hal);
-#elif defined(USE_SOFT_VPU_X264)
-    ret = hal_h264e_x264_deinit(hal);
-#elif defined(_VPU_STUB_)
-    if (ctx->extra_info != NULL) {
-        HalRvpuInfo *info = (HalRvpuInfo *)ctx->extra_info;
-        if (info->remote_fd > 0) {
-            disconnect_remote(info->remote_fd);
-        }
-        MPP_FREE(ctx->extra_info);
+    // ion packet is imported, others are copied by server to the wait buffer
+    if (!result.length) {
+        mpp_log("frame pts %lld without packet", frame->pts);
+    } else if (result.info.type == MPP_BUFFER_TYPE_ION &&
+               mpp_rt_allcator_is_valid(MPP_BUFFER_TYPE_ION)) {
+        if (import_packet(task, &result.info))
+            result.length = 0;
+    } else if (NULL == copy) {
+        mpp_err("packet of frame pts %lld is not shared", frame->pts);
+        result.length = 0;
+    } else if (result.length > mpp_buffer_get_size(output)) {
+        mpp_err("packet size %u overflows output buffer %u", result.length,
+                (RK_U32)mpp_buffer_get_size(output));
+        result.length = 0;
+    } else if (copy != output) {
+        memcpy(mpp_buffer_get_ptr(output), mpp_buffer_get_ptr(copy), result.length);
     }
-#endif
 
-    return ret;
+    if (task->enc.packet) {
+        mpp_packet_set_pts(task->enc.packet, frame->pts);
+        mpp_packet_set_dts(task->enc.packet, frame->pts);
+    }
+
+    *type = frame->type;
+    *outsize = result.length;
+    rvpu_inflight_release(frame);
+    return MPP_OK;
 }
 
-MPP_RET hal_h264e_stub_gen_regs(void *hal, HalTaskInfo *task)
+static MPP_RET remote_init(void *hal, MppHalCfg *cfg)
 {
-    MPP_RET ret = MPP_OK;
-    (void) task;
-    // MppEncPrepCfg   *prep = &ctx->cfg->prep;
-    
-    // H264eHwCfg *hw_cfg   = &ctx->hw_cfg;
-    // HalEncTask *enc_task = &task->enc;
+    H264eHalContext *ctx = (H264eHalContext *)hal;
+    HalRvpuInfo *info;
+    MPP_RET ret;
+    (void)cfg;
+
+    if (NULL == (ctx->extra_info = mpp_calloc(HalRvpuInfo, 1)))
+        return MPP_ERR_NOMEM;
+
+    info = (HalRvpuInfo *)ctx->extra_info;
+    if (MPP_OK == (ret = rvpu_open(info))) {
+        // server keeps packets of the frames in flight
+        RvpuInitCfg init = { MPP_VIDEO_CodingAVC, (RK_S32)info->depth };
+        if (info->proto >= RVPU_PROTO_V1)
+            ret = rvpu_send(info, RVPU_PRIM_INIT, &init, sizeof(init));
+        else
+            ret = rvpu_send(info, RVPU_PRIM_INIT, NULL, 0);
+    }
 
-    // RK_U32 mbs_in_row, mbs_in_col; 
+    return ret;
+}
 
-    // mpp_log("gen_regs v:%u\n", task->enc.valid);
+static MPP_RET remote_deinit(void *hal)
+{
+    H264eHalContext *ctx = (H264eHalContext *)hal;
 
-    // mbs_in_row = (prep->width + 15) / 16;
-    // mbs_in_col = (prep->height + 15) / 16;
+    if (ctx->extra_info != NULL) {
+        rvpu_close((HalRvpuInfo *)ctx->extra_info);
+        MPP_FREE(ctx->extra_info);
+    }
 
-#if defined(USE_VPU_NVIDIA)
-    ret = hal_h264e_nv_gen_regs(hal, task);
-#elif defined(USE_SOFT_VPU_X264)
-    ret = hal_h264e_x264_gen_regs(hal, task);
-#endif
+    return MPP_OK;
+}
 
-#ifdef _VPU_STUB_
+static MPP_RET remote_gen_regs(void *hal, HalTaskInfo *task)
+{
     H264eHalContext *ctx  = (H264eHalContext *)hal;
     HalRvpuInfo *info = (HalRvpuInfo *)ctx->extra_info;
 
-    if (info && info->remote_fd > 0) {
-        send_remote(info->remote_fd, RVPU_PRIM_REGS, NULL, 0);
+    // drain task without input only collects a frame in flight
+    if (info && info->remote_fd > 0 && task->enc.input) {
+        // batched with START and WAIT
+        rvpu_queue(info, RVPU_PRIM_REGS, NULL, 0);
     }
-#endif
 
-    return ret;
+    return MPP_OK;
 }
 
-MPP_RET hal_h264e_stub_start(void *hal, HalTaskInfo *task)
+static MPP_RET remote_start(void *hal, HalTaskInfo *task)
 {
-    MPP_RET ret = MPP_OK;
-
-    // mpp_log("start v:%u\n", task->enc.valid);
-
-#if defined(USE_VPU_NVIDIA)
-    ret = hal_h264e_nv_start(hal, task);
-#elif defined(USE_SOFT_VPU_X264)
-    ret = hal_h264e_x264_start(hal, task);
-#endif
-
-#ifdef _VPU_STUB_
     H264eHalContext *ctx  = (H264eHalContext *)hal;
     HalRvpuInfo *info = (HalRvpuInfo *)ctx->extra_info;
 
-    if (info && info->remote_fd > 0) {
-        MppBuffer input = task->enc.input;
+    if (info && info->remote_fd > 0 && task->enc.input) {
         MppBufferInfo binfo;
-        mpp_buffer_info_get(input, &binfo);
-        if (binfo.type == MPP_BUFFER_TYPE_ION) {
+
+        if (share_buffer(task->enc.input, &binfo)) {
             // mpp_buffer_inc_ref(input);
-            binfo.fd = 0;       // requires ion_map from binfo.hdl
-            binfo.ptr = NULL;   // required ion_import
-            send_remote(info->remote_fd, RVPU_PRIM_START, &binfo, sizeof(binfo));
+            rvpu_queue(info, RVPU_PRIM_START, &binfo, sizeof(binfo));
         } else {
-            send_remote(info->remote_fd, RVPU_PRIM_START, NULL, 0);
+            rvpu_queue(info, RVPU_PRIM_START, NULL, 0);
         }
     }
-#endif
 
-    return ret;
+    return MPP_OK;
 }
 
-MPP_RET hal_h264e_stub_wait(void *hal, HalTaskInfo *task)
+static MPP_RET remote_wait(void *hal, HalTaskInfo *task)
 {
     MPP_RET ret = MPP_OK;
-
-    // mpp_log("wait w:%u v:%u\n", ctx->cfg->prep.hor_stride, task->enc.valid);
-
-#if defined(USE_VPU_NVIDIA)
-    ret = hal_h264e_nv_wait(hal, task);
-#elif defined(USE_SOFT_VPU_X264)
-    ret = hal_h264e_x264_wait(hal, task);
-#endif
-
-#ifdef _VPU_STUB_
     H264eHalContext *ctx  = (H264eHalContext *)hal;
     HalRvpuInfo *info = (HalRvpuInfo *)ctx->extra_info;
 
     if (info && info->remote_fd > 0) {
         size_t    outsize = 0;
         MppBuffer output  = task->enc.output;
-        size_t    bufsize = mpp_buffer_get_size(output);
-        volatile uint32_t *ptag = (uint32_t *)mpp_buffer_get_ptr(output);
-
+        RK_S32    type    = 0;      // rc type of the frame the packet belongs to
+        RcSyntax *rc_syn;
         MppBufferInfo binfo;
         mpp_buffer_info_get(output, &binfo);
-        if (binfo.type == MPP_BUFFER_TYPE_ION) {
-            int times = MAX_WAIT_TIMES;
 
-          #ifndef RECV_SOCKET
+        task->enc.length = 0;
+
+        if (NULL == task->enc.input) {
+            // drain after eos, output the frames in flight one by one
+            if (info->proto >= RVPU_PROTO_V1 &&
+                MPP_OK != (ret = complete_oldest(info, task, &type, &outsize)))
+                return ret;
+
+            task->enc.length  = outsize;
+            task->enc.delayed = info->inflight;
+            return MPP_OK;
+        }
+
+        rc_syn = (RcSyntax *)task->enc.syntax.data;
+        if (info->proto >= RVPU_PROTO_V1) {
+            MppBuffer copy = get_wait_buffer(info, task);
+
+            // REGS + START + WAIT in one sendmsg
+            if (copy && share_buffer(copy, &binfo)) {
+                ret = rvpu_send(info, RVPU_PRIM_WAIT, &binfo, sizeof(binfo));
+            } else {
+                ret = rvpu_send(info, RVPU_PRIM_WAIT, NULL, 0);
+            }
+            if (MPP_OK != ret) {
+                if (copy)
+                    mpp_buffer_put(copy);
+                return MPP_ERR_VPUHW;   // remote closed
+            }
+            mpp_buffer_inc_ref(task->enc.input);
+            rvpu_inflight_push(info, info->seq - 1, rc_syn->type,
+                               task->enc.frame ? mpp_frame_get_pts(task->enc.frame) : 0,
+                               task->enc.input, copy);
+
+            // keep depth frames encoding remotely, block on the oldest one
+            if (info->inflight >= info->depth &&
+                MPP_OK != (ret = complete_oldest(info, task, &type, &outsize))) {
+                // this frame is encoded again by the caller, not as in flight
+                rvpu_inflight_release(rvpu_inflight_pop_newest(info));
+                return ret;
+            }
+        } else if (binfo.type == MPP_BUFFER_TYPE_ION) {
+            // legacy server only reports through the ready-flag in output buffer
+            size_t bufsize = mpp_buffer_get_size(output);
+            volatile uint32_t *ptag = (uint32_t *)mpp_buffer_get_ptr(output);
+            int times = RVPU_WAIT_TIMEOUT;
+
+            type = rc_syn->type;
+
             // set output buffer ready-flag
             *ptag = bufsize;
-          #endif
 
             binfo.fd = 0;       // requires ion_map from binfo.hdl
             binfo.ptr = NULL;   // required ion_import
-            send_remote(info->remote_fd, RVPU_PRIM_WAIT, &binfo, sizeof(binfo));
+            rvpu_send(info, RVPU_PRIM_WAIT, &binfo, sizeof(binfo));
             // wait output buffer ready
             while (times-- > 0) {
                 usleep(1000);
 
-              #ifdef RECV_SOCKET
-                MppBufferInfo resp;
-                RVPU_PRIM_CODE prim = RVPU_PRIM_UNDEFINED;
-                if (prim == RVPU_PRIM_WAIT && 
-                    sizeof(resp) == recv_remote(info->remote_fd, &prim, &resp, sizeof(resp))) {
-                    outsize = resp.size;
-                    break;
-                }
-              #else /* !RECV_SOCKET */
                 if (*ptag < bufsize) {
-                    output = NULL;
-                    mpp_buffer_import(&output, (MppBufferInfo *)(ptag + 1));
-                    if (NULL != output) {
-                        //mpp_buffer_put(task->enc.output);
-                        task->enc.output = output;
-                        mpp_buffer_inc_ref(output);
+                    if (MPP_OK == import_packet(task, (MppBufferInfo *)(ptag + 1)))
                         outsize = *ptag;    // packet size
-                    } else {
-                        mpp_err("invalid packet buffer with size %u", *ptag);
-                    }
                     break;
                 }
-              #endif /* RECV_SOCKET */
             }   // while (times)
 
             if (outsize == 0) {
                 mpp_log("read response timeout");
             }
         } else {
-            send_remote(info->remote_fd, RVPU_PRIM_WAIT, NULL, 0);
+            rvpu_send(info, RVPU_PRIM_WAIT, NULL, 0);
         }
 
         if (outsize > 0) {
@@ -249,77 +325,574 @@ MPP_RET hal_h264e_stub_wait(void *hal, HalTaskInfo *task)
             if (int_cb->callBack) {
                 RcHalResult result;
                 result.bits = outsize * 8;
-                result.type = ((RcSyntax *)task->enc.syntax.data)->type;
+                result.type = (ENC_FRAME_TYPE)type;
                 feedback->result = &result;
                 // mpp_log("callback %p", int_cb->opaque);
                 int_cb->callBack(int_cb->opaque, feedback);
             }
         }
+        task->enc.delayed = info->inflight;
     }
-#endif
 
-    return ret;
+    return MPP_OK;
 }
 
-MPP_RET hal_h264e_stub_reset(void *hal)
+static MPP_RET remote_reset(void *hal)
 {
-    MPP_RET ret = MPP_OK;
+    H264eHalContext *ctx  = (H264eHalContext *)hal;
+    HalRvpuInfo *info = (HalRvpuInfo *)ctx->extra_info;
 
-    mpp_log("reset %p\n", hal);
+    if (info && info->remote_fd > 0) {
+        rvpu_inflight_reset(info);
+        rvpu_send(info, RVPU_PRIM_RESET, NULL, 0);
+    }
 
-#if defined(USE_VPU_NVIDIA)
-    ret = hal_h264e_nv_reset(hal);
-#elif defined(USE_SOFT_VPU_X264)
-    ret = hal_h264e_x264_reset(hal);
-#endif
+    return MPP_OK;
+}
 
-#ifdef _VPU_STUB_
+static MPP_RET remote_flush(void *hal)
+{
     H264eHalContext *ctx  = (H264eHalContext *)hal;
     HalRvpuInfo *info = (HalRvpuInfo *)ctx->extra_info;
-    if (info && info->remote_fd > 0) {
-        send_remote(info->remote_fd, RVPU_PRIM_RESET, NULL, 0);
+
+    // frames in flight are left to the drain tasks, only reset drops them
+    if (info && info->remote_fd > 0)
+        rvpu_send(info, RVPU_PRIM_FLUSH, NULL, 0);
+
+    return MPP_OK;
+}
+
+/*
+ * Forward the configure checked by the stub to server
+ */
+static MPP_RET remote_control(void *hal, RK_S32 cmd, void *param)
+{
+    H264eHalContext *ctx  = (H264eHalContext *)hal;
+    HalRvpuInfo *info = (HalRvpuInfo *)ctx->extra_info;
+    (void)param;
+
+    if (NULL == info || info->remote_fd <= 0 || NULL == ctx->set)
+        return MPP_OK;
+
+    switch (cmd) {
+    case MPP_ENC_SET_PREP_CFG:
+        rvpu_send(info, RVPU_PRIM_CONTROL_PREP, &ctx->set->prep, sizeof(ctx->set->prep));
+        break;
+    case MPP_ENC_SET_RC_CFG:
+        rvpu_send(info, RVPU_PRIM_CONTROL_RC, &ctx->set->rc, sizeof(ctx->set->rc));
+        break;
+    case MPP_ENC_SET_CODEC_CFG:
+        rvpu_send(info, RVPU_PRIM_CONTROL_CODEC, &ctx->cfg->codec.h264,
+                  sizeof(ctx->cfg->codec.h264));
+        break;
+    case MPP_ENC_SET_SEI_CFG:
+        rvpu_send(info, RVPU_PRIM_CONTROL_SEI, &ctx->sei_mode, sizeof(ctx->sei_mode));
+        break;
+    default:
+        break;
     }
+
+    return MPP_OK;
+}
+
+static const RvpuBackend h264e_remote = {
+    "remote",
+    RVPU_CAP_ENC_AVC | RVPU_CAP_REMOTE,
+    probe_remote,
+    remote_init,
+    remote_deinit,
+    remote_gen_regs,
+    remote_start,
+    remote_wait,
+    remote_reset,
+    remote_flush,
+    remote_control,
+};
+#endif /* _VPU_STUB_ */
+
+#ifdef USE_VPU_NVIDIA
+static const RvpuBackend h264e_nv = {
+    "nvidia",
+    RVPU_CAP_ENC_AVC | RVPU_CAP_HW,
+    NULL,
+    hal_h264e_nv_init,
+    hal_h264e_nv_deinit,
+    hal_h264e_nv_gen_regs,
+    hal_h264e_nv_start,
+    hal_h264e_nv_wait,
+    hal_h264e_nv_reset,
+    hal_h264e_nv_flush,
+    hal_h264e_nv_control,
+};
+#endif
+
+#ifdef USE_SOFT_VPU_X264
+static const RvpuBackend h264e_x264 = {
+    "x264",
+    RVPU_CAP_ENC_AVC | RVPU_CAP_SOFT,
+    NULL,
+    hal_h264e_x264_init,
+    hal_h264e_x264_deinit,
+    hal_h264e_x264_gen_regs,
+    hal_h264e_x264_start,
+    hal_h264e_x264_wait,
+    hal_h264e_x264_reset,
+    hal_h264e_x264_flush,
+    hal_h264e_x264_control,
+};
+#endif
+
+static pthread_once_t backend_once = PTHREAD_ONCE_INIT;
+
+/*
+ * Built-in backends, remote vpu first and local software encoder as the last
+ * resort
+ */
+static void register_backends(void)
+{
+#ifdef _VPU_STUB_
+    rvpu_backend_register(&h264e_remote);
+#endif
+#ifdef USE_VPU_NVIDIA
+    rvpu_backend_register(&h264e_nv);
+#endif
+#ifdef USE_SOFT_VPU_X264
+    rvpu_backend_register(&h264e_x264);
 #endif
+}
+
+static const RvpuBackend *get_backend(void *hal)
+{
+    return (const RvpuBackend *)((H264eHalContext *)hal)->backend;
+}
+
+static MPP_RET try_backend(H264eHalContext *ctx, const RvpuBackend *b)
+{
+    MppHalCfg cfg;
+    MPP_RET ret;
+
+    if (b->probe && b->probe()) {
+        mpp_log("backend %s not available", b->name);
+        return MPP_NOK;
+    }
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.cfg        = ctx->cfg;
+    cfg.set        = ctx->set;
+    cfg.hal_int_cb = ctx->int_cb;
+
+    ret = b->init(ctx, &cfg);
+    if (ret) {
+        mpp_log("backend %s init failed ret %d", b->name, ret);
+        b->deinit(ctx);
+        return ret;
+    }
+
+    ctx->backend = b;
+    mpp_log("use backend %s", b->name);
+    return MPP_OK;
+}
+
+/*
+ * Open the preferred backend, or the first working one after skip
+ */
+static MPP_RET open_backend(H264eHalContext *ctx, const RvpuBackend *prefer,
+                            const RvpuBackend *skip)
+{
+    const RvpuBackend *b;
+
+    if (prefer && MPP_OK == try_backend(ctx, prefer))
+        return MPP_OK;
+
+    for (b = rvpu_backend_next(skip, RVPU_CAP_ENC_AVC); b;
+         b = rvpu_backend_next(b, RVPU_CAP_ENC_AVC)) {
+        if (b != prefer && MPP_OK == try_backend(ctx, b))
+            return MPP_OK;
+    }
+
+    mpp_err("no H.264 encoder backend available");
+    return MPP_NOK;
+}
+
+/*
+ * Bring a backend opened after configure up to date
+ */
+static void replay_cfg(H264eHalContext *ctx)
+{
+    const RvpuBackend *b = get_backend(ctx);
+
+    if (NULL == ctx->set || !ctx->cfg->prep.width || NULL == b->control)
+        return;
+
+    b->control(ctx, MPP_ENC_SET_PREP_CFG, &ctx->set->prep);
+    b->control(ctx, MPP_ENC_SET_RC_CFG, &ctx->set->rc);
+    b->control(ctx, MPP_ENC_SET_CODEC_CFG, &ctx->set->codec);
+    b->control(ctx, MPP_ENC_SET_SEI_CFG, &ctx->sei_mode);
+}
+
+/*
+ * Close current backend and move to another one, the first working one after
+ * current if next is NULL
+ */
+static MPP_RET switch_backend(H264eHalContext *ctx, const RvpuBackend *next)
+{
+    const RvpuBackend *curr = get_backend(ctx);
+    MPP_RET ret;
+
+    if (curr) {
+        curr->deinit(ctx);
+        ctx->backend = NULL;
+    }
+
+    ret = open_backend(ctx, next, next ? NULL : curr);
+    if (MPP_OK == ret)
+        replay_cfg(ctx);
 
     return ret;
 }
 
-MPP_RET hal_h264e_stub_flush(void *hal)
+/*
+ * Packets encoded again on the fallback backend for frames the lost one had
+ * in flight. Later frames queue behind them, so packets keep frame order and
+ * the queue is drained after eos as delayed frames.
+ */
+typedef struct StubPacket_t {
+    MppBuffer       buffer;
+    size_t          length;
+    RK_S64          pts;
+    RK_S64          dts;
+    RK_U32          is_intra;
+} StubPacket;
+
+typedef struct StubReplay_t {
+    MppBufferGroup  group;
+    RK_U32          head;
+    RK_U32          count;
+    RK_U32          delayed;    /**< frames cached in backend */
+    StubPacket      pkts[RVPU_MAX_INFLIGHT + 1];
+} StubReplay;
+
+static void replay_deinit(H264eHalContext *ctx)
+{
+    StubReplay *r = (StubReplay *)ctx->replay;
+
+    if (NULL == r)
+        return;
+
+    while (r->count) {
+        mpp_buffer_put(r->pkts[r->head].buffer);
+        r->head = (r->head + 1) % MPP_ARRAY_ELEMS(r->pkts);
+        r->count--;
+    }
+    if (r->group)
+        mpp_buffer_group_put(r->group);
+    MPP_FREE(ctx->replay);
+}
+
+/*
+ * Encode a frame on current backend into the queue. A lost frame has only its
+ * input and pts left, its rate control was done on its own task.
+ */
+static MPP_RET replay_encode(H264eHalContext *ctx, HalTaskInfo *task, RvpuInflight *lost)
+{
+    const RvpuBackend *b = get_backend(ctx);
+    StubReplay *r = (StubReplay *)ctx->replay;
+    IOInterruptCB int_cb = ctx->int_cb;
+    HalTaskInfo info = *task;
+    HalEncTask *enc = &info.enc;
+    MppFrame frame = NULL;
+    MppBuffer buffer = NULL;
+    MppPacket packet = NULL;
+    MPP_RET ret;
+
+    if (r->count >= MPP_ARRAY_ELEMS(r->pkts)) {
+        mpp_err("replay queue full");
+        return MPP_NOK;
+    }
+
+    if (NULL == r->group &&
+        mpp_buffer_group_get_internal(&r->group, MPP_BUFFER_TYPE_ION))
+        return MPP_NOK;
+
+    ret = mpp_buffer_get(r->group, &buffer, mpp_buffer_get_size(task->enc.output));
+    if (ret)
+        return ret;
+
+    mpp_packet_init_with_buffer(&packet, buffer);
+    enc->output = buffer;
+    enc->packet = packet;
+
+    if (lost) {
+        mpp_frame_init(&frame);
+        mpp_frame_set_pts(frame, lost->pts);
+        mpp_frame_set_buffer(frame, lost->input);
+        enc->input = lost->input;
+        enc->frame = frame;
+        ctx->int_cb.callBack = NULL;
+    }
+
+    ret = b->reg_gen(ctx, &info);
+    if (!ret)
+        ret = b->start(ctx, &info);
+    if (!ret)
+        ret = b->wait(ctx, &info);
+
+    ctx->int_cb = int_cb;
+    r->delayed = ret ? 0 : enc->delayed;
+
+    if (!ret && enc->length) {
+        StubPacket *pkt = &r->pkts[(r->head + r->count) % MPP_ARRAY_ELEMS(r->pkts)];
+
+        pkt->buffer   = buffer;
+        pkt->length   = enc->length;
+        pkt->pts      = mpp_packet_get_pts(packet);
+        pkt->dts      = mpp_packet_get_dts(packet);
+        pkt->is_intra = enc->is_intra;
+        r->count++;
+        buffer = NULL;
+    }
+
+    if (buffer)
+        mpp_buffer_put(buffer);
+    mpp_packet_deinit(&packet);
+    if (frame)
+        mpp_frame_deinit(&frame);
+
+    return ret;
+}
+
+/*
+ * Encode this frame behind the queued ones and output the oldest packet
+ */
+static MPP_RET replay_wait(H264eHalContext *ctx, HalTaskInfo *task)
 {
+    StubReplay *r = (StubReplay *)ctx->replay;
+    StubPacket *pkt;
     MPP_RET ret = MPP_OK;
 
-    mpp_log("flush %p\n", hal);
+    task->enc.length = 0;
+    if (task->enc.input || r->delayed)
+        ret = replay_encode(ctx, task, NULL);
+
+    if (r->count) {
+        pkt = &r->pkts[r->head];
+        if (pkt->length <= mpp_buffer_get_size(task->enc.output)) {
+            memcpy(mpp_buffer_get_ptr(task->enc.output),
+                   mpp_buffer_get_ptr(pkt->buffer), pkt->length);
+            task->enc.length   = pkt->length;
+            task->enc.is_intra = pkt->is_intra;
+            if (task->enc.packet) {
+                mpp_packet_set_pts(task->enc.packet, pkt->pts);
+                mpp_packet_set_dts(task->enc.packet, pkt->dts);
+            }
+        } else {
+            mpp_err("packet size %u overflows output buffer %u", (RK_U32)pkt->length,
+                    (RK_U32)mpp_buffer_get_size(task->enc.output));
+        }
 
-#if defined(USE_VPU_NVIDIA)
-    ret = hal_h264e_nv_flush(hal);
-#elif defined(USE_SOFT_VPU_X264)
-    ret = hal_h264e_x264_flush(hal);
-#endif
+        mpp_buffer_put(pkt->buffer);
+        r->head = (r->head + 1) % MPP_ARRAY_ELEMS(r->pkts);
+        r->count--;
+    }
+
+    task->enc.delayed = r->count + r->delayed;
+    return ret;
+}
+
+/*
+ * Move the frames in flight on a lost remote to the fallback backend, they
+ * are encoded again before this task
+ */
+static MPP_RET replay_lost(H264eHalContext *ctx, HalTaskInfo *task,
+                           RvpuInflight *lost, RK_U32 count)
+{
+    RK_U32 i;
+    MPP_RET ret = MPP_OK;
+
+    if (NULL == ctx->replay &&
+        NULL == (ctx->replay = mpp_calloc(StubReplay, 1)))
+        return MPP_ERR_NOMEM;
+
+    mpp_log("encode %u frames in flight again", count);
+    for (i = 0; i < count && !ret; i++)
+        ret = replay_encode(ctx, task, &lost[i]);
+
+    if (ret) {
+        mpp_err("encode frames in flight again failed ret %d", ret);
+        return ret;
+    }
+
+    return replay_wait(ctx, task);
+}
 
+/*
+ * Take the frames in flight of the current backend before it is closed
+ */
+static RK_U32 take_inflight(H264eHalContext *ctx, RvpuInflight *lost)
+{
+    RK_U32 count = 0;
 #ifdef _VPU_STUB_
-    H264eHalContext *ctx  = (H264eHalContext *)hal;
     HalRvpuInfo *info = (HalRvpuInfo *)ctx->extra_info;
+    RvpuInflight *frame;
 
-    if (info && info->remote_fd > 0) {
-        send_remote(info->remote_fd, RVPU_PRIM_FLUSH, NULL, 0);
+    if (get_backend(ctx) != &h264e_remote || NULL == info)
+        return 0;
+
+    while (NULL != (frame = rvpu_inflight_pop(info))) {
+        lost[count++] = *frame;
+        frame->input  = NULL;
+        frame->output = NULL;
     }
+#else
+    (void)ctx;
+    (void)lost;
 #endif
+    return count;
+}
+
+MPP_RET hal_h264e_stub_init(void *hal, MppHalCfg *cfg)
+{
+    H264eHalContext *ctx = (H264eHalContext *)hal;
+    const char *name = NULL;
+
+    // mpp_log("init %p\n", ctx);
+
+    ctx->int_cb = cfg->hal_int_cb;
+    //ctx->buffers = mpp_calloc(h264e_hal_vpu_buffers, 1);
+    ctx->param_buf = NULL;
+    ctx->cfg = cfg->cfg;
+    ctx->set = cfg->set;
+    ctx->backend = NULL;
+    ctx->replay = NULL;
+
+    pthread_once(&backend_once, register_backends);
+
+    // env rvpu_backend picks the preferred one, others remain as fallback
+    mpp_env_get_str("rvpu_backend", &name, NULL);
+    return open_backend(ctx, rvpu_backend_find(name), NULL);
+}
+
+MPP_RET hal_h264e_stub_deinit(void *hal)
+{
+    MPP_RET ret = MPP_OK;
+    H264eHalContext *ctx = (H264eHalContext *)hal;
+    const RvpuBackend *b = get_backend(hal);
+    // mpp_log("deinit %p\n", ctx);
+
+    if (ctx->param_buf) {
+        mpp_free(ctx->param_buf);
+        ctx->param_buf = NULL;
+    }
+
+    if (b) {
+        ret = b->deinit(hal);
+        ctx->backend = NULL;
+    }
+    replay_deinit(ctx);
+
+    return ret;
+}
+
+MPP_RET hal_h264e_stub_gen_regs(void *hal, HalTaskInfo *task)
+{
+    const RvpuBackend *b = get_backend(hal);
+
+    // mpp_log("gen_regs v:%u\n", task->enc.valid);
+
+    return b ? b->reg_gen(hal, task) : MPP_NOK;
+}
+
+MPP_RET hal_h264e_stub_start(void *hal, HalTaskInfo *task)
+{
+    const RvpuBackend *b = get_backend(hal);
+
+    // mpp_log("start v:%u\n", task->enc.valid);
+
+    return b ? b->start(hal, task) : MPP_NOK;
+}
+
+MPP_RET hal_h264e_stub_wait(void *hal, HalTaskInfo *task)
+{
+    H264eHalContext *ctx = (H264eHalContext *)hal;
+    const RvpuBackend *b = get_backend(hal);
+    RvpuInflight lost[RVPU_MAX_INFLIGHT];
+    RK_U32 count, i;
+    MPP_RET ret;
+
+    // mpp_log("wait w:%u v:%u\n", ctx->cfg->prep.hor_stride, task->enc.valid);
+
+    if (NULL == b)
+        return MPP_NOK;
+
+    // packets encoded again on failover go out first
+    if (ctx->replay && (((StubReplay *)ctx->replay)->count ||
+                        ((StubReplay *)ctx->replay)->delayed))
+        return replay_wait(ctx, task);
+
+    ret = b->wait(hal, task);
+    if (MPP_ERR_VPUHW != ret)
+        return ret;
+
+    // device is gone, encode the frames in flight and this one again on the
+    // next backend
+    mpp_err("backend %s lost, fall back", b->name);
+    count = take_inflight(ctx, lost);
+    ret = switch_backend(ctx, NULL);
+    if (MPP_OK == ret && count) {
+        ret = replay_lost(ctx, task, lost, count);
+    } else if (MPP_OK == ret) {
+        b = get_backend(hal);
+        ret = b->reg_gen(hal, task);
+        if (!ret)
+            ret = b->start(hal, task);
+        if (!ret)
+            ret = b->wait(hal, task);
+    }
+
+    for (i = 0; i < count; i++)
+        rvpu_inflight_release(&lost[i]);
 
     return ret;
 }
 
+MPP_RET hal_h264e_stub_reset(void *hal)
+{
+    const RvpuBackend *b = get_backend(hal);
+
+    mpp_log("reset %p\n", hal);
+
+    replay_deinit((H264eHalContext *)hal);
+    return b ? b->reset(hal) : MPP_OK;
+}
+
+MPP_RET hal_h264e_stub_flush(void *hal)
+{
+    const RvpuBackend *b = get_backend(hal);
+
+    mpp_log("flush %p\n", hal);
+
+    return b ? b->flush(hal) : MPP_OK;
+}
+
 MPP_RET hal_h264e_stub_control(void *hal, RK_S32 cmd, void *param)
 {
     MPP_RET ret = MPP_OK;
     H264eHalContext *ctx  = (H264eHalContext *)hal;
     MppEncCfgSet    *set;
     MppPacket        pkt;
-
-#ifdef _VPU_STUB_
-    HalRvpuInfo *info = (HalRvpuInfo *)ctx->extra_info;
-#endif
+    const RvpuBackend *b;
 
     switch (cmd) {
+    case MPP_ENC_SET_HAL_BACKEND:
+        mpp_log("control with cmd MPP_ENC_SET_HAL_BACKEND %s\n", (const char *)param);
+        if (NULL == (b = rvpu_backend_find((const char *)param))) {
+            mpp_err("unknown backend %s\n", (const char *)param);
+            return MPP_NOK;
+        }
+        if (b == get_backend(hal))
+            return MPP_OK;
+        return switch_backend(ctx, b);
+
     case MPP_ENC_GET_EXTRA_INFO:
         mpp_log("control with cmd MPP_ENC_GET_EXTRA_INFO\n");
         pkt = ctx->packeted_param;
@@ -350,32 +923,18 @@ MPP_RET hal_h264e_stub_control(void *hal, RK_S32 cmd, void *param)
 
             if (change & MPP_ENC_PREP_CFG_CHANGE_FORMAT) {
                 if ((prep->format < MPP_FRAME_FMT_RGB &&
-                    prep->format >= MPP_FMT_YUV_BUTT) ||
+                     prep->format >= MPP_FMT_YUV_BUTT) ||
                     prep->format >= MPP_FMT_RGB_BUTT) {
                     mpp_err("invalid format %d\n", prep->format);
                     ret = MPP_NOK;
                 }
             }
-
-          #ifdef _VPU_STUB_
-            if (info && info->remote_fd > 0) {
-                send_remote(info->remote_fd, RVPU_PRIM_CONTROL_PREP, prep, sizeof(*prep));
-            }
-          #endif
         }
         break;
 
     case MPP_ENC_SET_RC_CFG:
         // TODO: do rate control check here
         mpp_log("control with cmd MPP_ENC_SET_RC_CFG\n");
-        if (NULL != (set = ctx->set)) {
-          #ifdef _VPU_STUB_
-            MppEncRcCfg *rc = &ctx->set->rc;
-            if (info && info->remote_fd > 0) {
-                send_remote(info->remote_fd, RVPU_PRIM_CONTROL_RC, rc, sizeof(*rc));
-            }
-          #endif
-        }
         break;
 
     case MPP_ENC_SET_CODEC_CFG:
@@ -439,12 +998,6 @@ MPP_RET hal_h264e_stub_control(void *hal, RK_S32 cmd, void *param)
             */
             dst->change |= change;
             src->change = 0;
-
-          #ifdef _VPU_STUB_
-            if (info && info->remote_fd > 0) {
-                send_remote(info->remote_fd, RVPU_PRIM_CONTROL_CODEC, dst, sizeof(*dst));
-            }
-          #endif
         }
         break;
 
@@ -455,12 +1008,6 @@ MPP_RET hal_h264e_stub_control(void *hal, RK_S32 cmd, void *param)
     case MPP_ENC_SET_SEI_CFG:
         // mpp_log("control with cmd MPP_ENC_SET_SEI_CFG\n");
         ctx->sei_mode = *((MppEncSeiMode *)param);
-
-      #ifdef _VPU_STUB_
-        if (info && info->remote_fd > 0) {
-            send_remote(info->remote_fd, RVPU_PRIM_CONTROL_SEI, &ctx->sei_mode, sizeof(ctx->sei_mode));
-        }
-      #endif
         break;
 
     case MPP_ENC_GET_HDR_SYNC:
@@ -475,16 +1022,14 @@ MPP_RET hal_h264e_stub_control(void *hal, RK_S32 cmd, void *param)
         break;
 
     default:
-        mpp_err("unrecognizable cmd type %d", cmd);
-        ret = MPP_NOK;
+        // left to backend
         break;
     }
 
-#if defined(USE_VPU_NVIDIA)
-    ret = hal_h264e_nv_control(hal, cmd, param);
-#elif defined(USE_SOFT_VPU_X264)
-    ret = hal_h264e_x264_control(hal, cmd, param);
-#endif
+    // backend applies what passed the checks above
+    b = get_backend(hal);
+    if (MPP_OK == ret && b && b->control)
+        ret = b->control(hal, cmd, param);
 
     return ret;
 }
@@ -26,33 +26,32 @@
 #include "mpp_hal.h"
 
 #include "jpege_syntax.h"
+#include "hal_jpege_hdr.h"
+#include "hal_jpege_base.h"
 #include "hal_jpege_stub.h"
 
 #include "mpp_device.h"
 #include "mpp_platform.h"
 
+#include "rvpu_convert.h"
 #include "turbojpeg.h"
 
 #define LEN_PREPADDING          4       // MppEncoder::mPrePadding
 
 /**
- * Context, refer to vpu/jpege/hal_jpege_bash.h
+ * Software encoder state, keep in HalJpegeCtx::extra_info
  */
-typedef struct hal_jpege_ctx_s {
-    IOInterruptCB       int_cb;
-    MppDevCtx           dev_ctx;
-  //JpegeBits           bits;
-  //JpegeIocRegInfo     ioctl_info;
+typedef struct hal_jpege_stub_s {
     tjhandle            tj_hdr;
-    MppEncCfgSet        *cfg;
-    MppEncCfgSet        *set;
-    JpegeSyntax         syntax;
-    MppHalApi           hal_api;
-} HalJpegeCtx;
+    RvpuConvert         convert;
+    RK_U8              *yuv;        // I420 of the yuv input turbojpeg can not take
+    size_t              yuv_size;
+} HalJpegeStub;
 
 MPP_RET hal_jpege_stub_init(void *hal, MppHalCfg *cfg)
 {
     HalJpegeCtx *ctx = (HalJpegeCtx *)hal;
+    HalJpegeStub *stub;
 
   #ifdef LEN_PREPADDING
      mpp_log("init %p with prepadding %d bytes\n", ctx, LEN_PREPADDING);
@@ -60,7 +59,16 @@ MPP_RET hal_jpege_stub_init(void *hal, MppHalCfg *cfg)
      mpp_log("init %p\n", ctx);
   #endif
 
-    ctx->tj_hdr = tjInitCompress();
+    stub = mpp_calloc(HalJpegeStub, 1);
+    if (NULL == stub)
+        return MPP_ERR_MALLOC;
+    ctx->extra_info = stub;
+
+    stub->tj_hdr = tjInitCompress();
+    if (NULL == stub->tj_hdr || rvpu_convert_init(&stub->convert)) {
+        mpp_err("failed to init turbojpeg %p\n", stub->tj_hdr);
+        return MPP_ERR_MALLOC;
+    }
     ctx->int_cb = cfg->hal_int_cb;
     ctx->cfg = cfg->cfg;
     ctx->set = cfg->set;
@@ -71,9 +79,16 @@ MPP_RET hal_jpege_stub_init(void *hal, MppHalCfg *cfg)
 MPP_RET hal_jpege_stub_deinit(void *hal)
 {
     HalJpegeCtx *ctx = (HalJpegeCtx *)hal;
+    HalJpegeStub *stub = (HalJpegeStub *)ctx->extra_info;
     mpp_log("deinit %p\n", ctx);
 
-    tjDestroy(ctx->tj_hdr);
+    if (stub) {
+        if (stub->tj_hdr)
+            tjDestroy(stub->tj_hdr);
+        rvpu_convert_deinit(stub->convert);
+        MPP_FREE(stub->yuv);
+        MPP_FREE(ctx->extra_info);
+    }
     return MPP_OK;
 }
 
@@ -93,8 +108,8 @@ MPP_RET hal_jpege_stub_gen_regs(void *hal, HalTaskInfo *task)
     // initial frame settings in syntax
     syntax->width       = width;
     syntax->height      = height;
-    syntax->hor_stride  = prep->hor_stride;
-    syntax->ver_stride  = prep->ver_stride;
+    syntax->hor_stride  = prep->hor_stride ? prep->hor_stride : (RK_S32)width;
+    syntax->ver_stride  = prep->ver_stride ? prep->ver_stride : (RK_S32)height;
     syntax->format      = fmt;
     syntax->quality     = codec->jpeg.quant;
 
@@ -111,30 +126,75 @@ MPP_RET hal_jpege_stub_start(void *hal, HalTaskInfo *task)
     return MPP_OK;
 }
 
-static int fmt2TJPF(MppFrameFormat format) {
-    int fmt = TJPF_RGB;
-
+/*
+ * turbojpeg pixel format of the rgb input it takes directly, -1 for the
+ * formats converted to I420 first
+ */
+static int fmt2TJPF(MppFrameFormat format)
+{
     switch (format) {
     case MPP_FMT_ARGB8888:
-        fmt = TJPF_RGBA;
-        break;
+        return TJPF_RGBA;
     case MPP_FMT_RGB888:
-        fmt = TJPF_RGB;
-        break;
+        return TJPF_RGB;
+    case MPP_FMT_BGR888:
+        return TJPF_BGR;
     case MPP_FMT_ABGR8888:
-        fmt = TJPF_BGRA;
-        break;
-    case MPP_FMT_YUV420SP_VU:
+        return TJPF_BGRA;
     default:
-        mpp_err("unsupport MppFrameFormat %d\n", format);
-        break;
+        return -1;
+    }
+}
+
+/*
+ * Yuv input goes to turbojpeg as planes, skipping its rgb to yuv stage.
+ * I420 is taken in place, other layouts are converted into stub->yuv.
+ */
+static MPP_RET get_yuv_planes(HalJpegeStub *stub, RvpuImage *src,
+                              unsigned char **planes, int *strides)
+{
+    RvpuImage dst;
+    RK_S32 w = MPP_ALIGN(src->width, 2);
+    RK_S32 h = MPP_ALIGN(src->height, 2);
+    size_t size = (size_t)w * h * 3 / 2;
+    RK_U32 i;
+
+    if (src->format == MPP_FMT_YUV420P) {
+        dst = *src;
+    } else {
+        if (stub->yuv_size < size) {
+            MPP_FREE(stub->yuv);
+            stub->yuv = mpp_malloc(RK_U8, size);
+            stub->yuv_size = stub->yuv ? size : 0;
+            if (NULL == stub->yuv)
+                return MPP_ERR_MALLOC;
+        }
+
+        dst.format    = MPP_FMT_YUV420P;
+        dst.width     = src->width;
+        dst.height    = src->height;
+        dst.plane[0]  = stub->yuv;
+        dst.stride[0] = w;
+        dst.plane[1]  = stub->yuv + w * h;
+        dst.stride[1] = w / 2;
+        dst.plane[2]  = stub->yuv + w * h * 5 / 4;
+        dst.stride[2] = w / 2;
+
+        if (rvpu_convert_to_i420(stub->convert, src, &dst))
+            return MPP_NOK;
+    }
+
+    for (i = 0; i < 3; i++) {
+        planes[i]  = dst.plane[i];
+        strides[i] = dst.stride[i];
     }
-    return fmt;
+    return MPP_OK;
 }
 
 MPP_RET hal_jpege_stub_wait(void *hal, HalTaskInfo *task)
 {
     HalJpegeCtx *ctx = (HalJpegeCtx *)hal;
+    HalJpegeStub *stub = (HalJpegeStub *)ctx->extra_info;
 
     JpegeSyntax *syntax = &ctx->syntax;
     HalEncTask  *info   = &task->enc;
@@ -144,29 +204,50 @@ MPP_RET hal_jpege_stub_wait(void *hal, HalTaskInfo *task)
     unsigned char *pout = mpp_buffer_get_ptr(output);
     size_t         size = mpp_buffer_get_size(output);
     JpegeFeedback  feedback;
+    RvpuImage      src;
+    int pixel_fmt = fmt2TJPF(syntax->format);
+    int flags = TJFLAG_FASTDCT | TJFLAG_NOREALLOC;
+    int quality = syntax->quality * 10;         // 1 ~ 100
     int res;
 
     mpp_log("wait s:%u q:%d v:%u\n", syntax->hor_stride, syntax->quality, task->enc.valid);
 
+    if (mpp_buffer_get_size(input) <
+        rvpu_image_size(syntax->format, syntax->hor_stride, syntax->ver_stride)) {
+        mpp_err("invalid input buffer size %d for format %d stride %dx%d\n",
+                (int)mpp_buffer_get_size(input), syntax->format,
+                syntax->hor_stride, syntax->ver_stride);
+        return MPP_NOK;
+    }
+
+    if (rvpu_image_setup(&src, mpp_buffer_get_ptr(input), syntax->format,
+                         syntax->width, syntax->height,
+                         syntax->hor_stride, syntax->ver_stride))
+        return MPP_NOK;
+
   #ifdef LEN_PREPADDING
     pout += LEN_PREPADDING;     // hacker header offset for minicap
   #endif
 
-    res = tjCompress2(ctx->tj_hdr, 
-        mpp_buffer_get_ptr(input), 
-        syntax->width,
-        syntax->hor_stride * 4,  // pitch = frame->stride * frame->bpp
-        syntax->height,
-        fmt2TJPF(syntax->format),
-        &pout,
-        &size,
-        TJSAMP_420,
-        syntax->quality * 10,    // 1 ~ 100
-        TJFLAG_FASTDCT | TJFLAG_NOREALLOC
-    );
+    if (pixel_fmt >= 0) {
+        // pitch = frame->stride * frame->bpp
+        res = tjCompress2(stub->tj_hdr, src.plane[0], src.width, src.stride[0],
+                          src.height, pixel_fmt, &pout, &size,
+                          TJSAMP_420, quality, flags);
+    } else {
+        unsigned char *planes[3];
+        int strides[3];
+
+        if (get_yuv_planes(stub, &src, planes, strides))
+            return MPP_NOK;
+
+        res = tjCompressFromYUVPlanes(stub->tj_hdr, planes, src.width, strides,
+                                      src.height, TJSAMP_420, &pout, &size,
+                                      quality, flags);
+    }
 
     if (res != 0) {
-        mpp_err("tjCompress2: %s\n", tjGetErrorStr());
+        mpp_err("turbojpeg format %d: %s\n", syntax->format, tjGetErrorStr());
         return MPP_NOK;
     }
 
@@ -191,7 +272,7 @@ MPP_RET hal_jpege_stub_flush(void *hal)
     return MPP_OK;
 }
 
-MPP_RET hal_jpege_stub_control(void *hal, RK_S32 cmd, void *param)
+MPP_RET hal_jpege_stub_control(void *hal, MpiCmd cmd, void *param)
 {
     MPP_RET ret = MPP_OK;
     MppEncPrepCfg *cfg;
@@ -210,15 +291,8 @@ MPP_RET hal_jpege_stub_control(void *hal, RK_S32 cmd, void *param)
             ret = MPP_NOK;
         }
 
-        if (cfg->format != MPP_FMT_YUV420SP     &&      // NV12
-            cfg->format != MPP_FMT_YUV420P      &&
-            cfg->format != MPP_FMT_YUV420SP_VU  &&      // NV21
-            cfg->format != MPP_FMT_YUV422SP_VU  &&      // NV42
-            cfg->format != MPP_FMT_YUV422_YUYV  &&
-            cfg->format != MPP_FMT_YUV422_UYVY  &&
-            cfg->format != MPP_FMT_RGB888       &&
-            cfg->format != MPP_FMT_BGR888       &&
-            cfg->format != MPP_FMT_ARGB8888) {
+        // rgb of fmt2TJPF is taken directly, the rest converted to I420
+        if (!rvpu_image_bpp(cfg->format)) {
             mpp_err("jpege: invalid format %d is not support\n", cfg->format);
             ret = MPP_NOK;
         }
@@ -17,7 +17,7 @@
 #ifndef __HAL_JPEGE_STUB_H__
 #define __HAL_JPEGE_STUB_H__
 
-#include "rk_type.h"
+#include "mpp_hal.h"
 
 MPP_RET hal_jpege_stub_init(void *hal, MppHalCfg *cfg);
 MPP_RET hal_jpege_stub_deinit(void *hal);
@@ -26,6 +26,6 @@ MPP_RET hal_jpege_stub_start(void *hal, HalTaskInfo *task);
 MPP_RET hal_jpege_stub_wait(void *hal, HalTaskInfo *task);
 MPP_RET hal_jpege_stub_reset(void *hal);
 MPP_RET hal_jpege_stub_flush(void *hal);
-MPP_RET hal_jpege_stub_control(void *hal, RK_S32 cmd, void *param);
+MPP_RET hal_jpege_stub_control(void *hal, MpiCmd cmd, void *param);
 
 #endif /* __HAL_JPEGE_STUB_H__ */
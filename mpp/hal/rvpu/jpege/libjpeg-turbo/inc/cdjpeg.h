@@ -26,14 +26,14 @@
 typedef struct cjpeg_source_struct * cjpeg_source_ptr;
 
 struct cjpeg_source_struct {
-  void (*start_input) (j_compress_ptr cinfo, cjpeg_source_ptr sinfo);
-  JDIMENSION (*get_pixel_rows) (j_compress_ptr cinfo, cjpeg_source_ptr sinfo);
-  void (*finish_input) (j_compress_ptr cinfo, cjpeg_source_ptr sinfo);
+    void (*start_input) (j_compress_ptr cinfo, cjpeg_source_ptr sinfo);
+    JDIMENSION (*get_pixel_rows) (j_compress_ptr cinfo, cjpeg_source_ptr sinfo);
+    void (*finish_input) (j_compress_ptr cinfo, cjpeg_source_ptr sinfo);
 
-  FILE *input_file;
+    FILE *input_file;
 
-  JSAMPARRAY buffer;
-  JDIMENSION buffer_height;
+    JSAMPARRAY buffer;
+    JDIMENSION buffer_height;
 };
 
 
@@ -44,25 +44,25 @@ struct cjpeg_source_struct {
 typedef struct djpeg_dest_struct * djpeg_dest_ptr;
 
 struct djpeg_dest_struct {
-  /* start_output is called after jpeg_start_decompress finishes.
-   * The color map will be ready at this time, if one is needed.
-   */
-  void (*start_output) (j_decompress_ptr cinfo, djpeg_dest_ptr dinfo);
-  /* Emit the specified number of pixel rows from the buffer. */
-  void (*put_pixel_rows) (j_decompress_ptr cinfo, djpeg_dest_ptr dinfo,
-                          JDIMENSION rows_supplied);
-  /* Finish up at the end of the image. */
-  void (*finish_output) (j_decompress_ptr cinfo, djpeg_dest_ptr dinfo);
-
-  /* Target file spec; filled in by djpeg.c after object is created. */
-  FILE * output_file;
-
-  /* Output pixel-row buffer.  Created by module init or start_output.
-   * Width is cinfo->output_width * cinfo->output_components;
-   * height is buffer_height.
-   */
-  JSAMPARRAY buffer;
-  JDIMENSION buffer_height;
+    /* start_output is called after jpeg_start_decompress finishes.
+     * The color map will be ready at this time, if one is needed.
+     */
+    void (*start_output) (j_decompress_ptr cinfo, djpeg_dest_ptr dinfo);
+    /* Emit the specified number of pixel rows from the buffer. */
+    void (*put_pixel_rows) (j_decompress_ptr cinfo, djpeg_dest_ptr dinfo,
+                            JDIMENSION rows_supplied);
+    /* Finish up at the end of the image. */
+    void (*finish_output) (j_decompress_ptr cinfo, djpeg_dest_ptr dinfo);
+
+    /* Target file spec; filled in by djpeg.c after object is created. */
+    FILE * output_file;
+
+    /* Output pixel-row buffer.  Created by module init or start_output.
+     * Width is cinfo->output_width * cinfo->output_components;
+     * height is buffer_height.
+     */
+    JSAMPARRAY buffer;
+    JDIMENSION buffer_height;
 };
 
 
@@ -75,11 +75,11 @@ struct djpeg_dest_struct {
  */
 
 struct cdjpeg_progress_mgr {
-  struct jpeg_progress_mgr pub; /* fields known to JPEG library */
-  int completed_extra_passes;   /* extra passes completed */
-  int total_extra_passes;       /* total extra */
-  /* last printed percentage stored here to avoid multiple printouts */
-  int percent_done;
+    struct jpeg_progress_mgr pub; /* fields known to JPEG library */
+    int completed_extra_passes;   /* extra passes completed */
+    int total_extra_passes;       /* total extra */
+    /* last printed percentage stored here to avoid multiple printouts */
+    int percent_done;
 };
 
 typedef struct cdjpeg_progress_mgr * cd_progress_ptr;
@@ -39,178 +39,178 @@ typedef enum {
 
 #endif /* JMAKE_ENUM_LIST */
 
-JMESSAGE(JMSG_NOMESSAGE, "Bogus message code %d") /* Must be first entry! */
+    JMESSAGE(JMSG_NOMESSAGE, "Bogus message code %d") /* Must be first entry! */
 
-/* For maintenance convenience, list is alphabetical by message code name */
+    /* For maintenance convenience, list is alphabetical by message code name */
 #if JPEG_LIB_VERSION < 70
-JMESSAGE(JERR_ARITH_NOTIMPL,
-         "Sorry, arithmetic coding is not implemented")
+    JMESSAGE(JERR_ARITH_NOTIMPL,
+             "Sorry, arithmetic coding is not implemented")
 #endif
-JMESSAGE(JERR_BAD_ALIGN_TYPE, "ALIGN_TYPE is wrong, please fix")
-JMESSAGE(JERR_BAD_ALLOC_CHUNK, "MAX_ALLOC_CHUNK is wrong, please fix")
-JMESSAGE(JERR_BAD_BUFFER_MODE, "Bogus buffer control mode")
-JMESSAGE(JERR_BAD_COMPONENT_ID, "Invalid component ID %d in SOS")
+    JMESSAGE(JERR_BAD_ALIGN_TYPE, "ALIGN_TYPE is wrong, please fix")
+    JMESSAGE(JERR_BAD_ALLOC_CHUNK, "MAX_ALLOC_CHUNK is wrong, please fix")
+    JMESSAGE(JERR_BAD_BUFFER_MODE, "Bogus buffer control mode")
+    JMESSAGE(JERR_BAD_COMPONENT_ID, "Invalid component ID %d in SOS")
 #if JPEG_LIB_VERSION >= 70
-JMESSAGE(JERR_BAD_CROP_SPEC, "Invalid crop request")
+    JMESSAGE(JERR_BAD_CROP_SPEC, "Invalid crop request")
 #endif
-JMESSAGE(JERR_BAD_DCT_COEF, "DCT coefficient out of range")
-JMESSAGE(JERR_BAD_DCTSIZE, "IDCT output block size %d not supported")
+    JMESSAGE(JERR_BAD_DCT_COEF, "DCT coefficient out of range")
+    JMESSAGE(JERR_BAD_DCTSIZE, "IDCT output block size %d not supported")
 #if JPEG_LIB_VERSION >= 70
-JMESSAGE(JERR_BAD_DROP_SAMPLING,
-         "Component index %d: mismatching sampling ratio %d:%d, %d:%d, %c")
+    JMESSAGE(JERR_BAD_DROP_SAMPLING,
+             "Component index %d: mismatching sampling ratio %d:%d, %d:%d, %c")
 #endif
-JMESSAGE(JERR_BAD_HUFF_TABLE, "Bogus Huffman table definition")
-JMESSAGE(JERR_BAD_IN_COLORSPACE, "Bogus input colorspace")
-JMESSAGE(JERR_BAD_J_COLORSPACE, "Bogus JPEG colorspace")
-JMESSAGE(JERR_BAD_LENGTH, "Bogus marker length")
-JMESSAGE(JERR_BAD_LIB_VERSION,
-         "Wrong JPEG library version: library is %d, caller expects %d")
-JMESSAGE(JERR_BAD_MCU_SIZE, "Sampling factors too large for interleaved scan")
-JMESSAGE(JERR_BAD_POOL_ID, "Invalid memory pool code %d")
-JMESSAGE(JERR_BAD_PRECISION, "Unsupported JPEG data precision %d")
-JMESSAGE(JERR_BAD_PROGRESSION,
-         "Invalid progressive parameters Ss=%d Se=%d Ah=%d Al=%d")
-JMESSAGE(JERR_BAD_PROG_SCRIPT,
-         "Invalid progressive parameters at scan script entry %d")
-JMESSAGE(JERR_BAD_SAMPLING, "Bogus sampling factors")
-JMESSAGE(JERR_BAD_SCAN_SCRIPT, "Invalid scan script at entry %d")
-JMESSAGE(JERR_BAD_STATE, "Improper call to JPEG library in state %d")
-JMESSAGE(JERR_BAD_STRUCT_SIZE,
-         "JPEG parameter struct mismatch: library thinks size is %u, caller expects %u")
-JMESSAGE(JERR_BAD_VIRTUAL_ACCESS, "Bogus virtual array access")
-JMESSAGE(JERR_BUFFER_SIZE, "Buffer passed to JPEG library is too small")
-JMESSAGE(JERR_CANT_SUSPEND, "Suspension not allowed here")
-JMESSAGE(JERR_CCIR601_NOTIMPL, "CCIR601 sampling not implemented yet")
-JMESSAGE(JERR_COMPONENT_COUNT, "Too many color components: %d, max %d")
-JMESSAGE(JERR_CONVERSION_NOTIMPL, "Unsupported color conversion request")
-JMESSAGE(JERR_DAC_INDEX, "Bogus DAC index %d")
-JMESSAGE(JERR_DAC_VALUE, "Bogus DAC value 0x%x")
-JMESSAGE(JERR_DHT_INDEX, "Bogus DHT index %d")
-JMESSAGE(JERR_DQT_INDEX, "Bogus DQT index %d")
-JMESSAGE(JERR_EMPTY_IMAGE, "Empty JPEG image (DNL not supported)")
-JMESSAGE(JERR_EMS_READ, "Read from EMS failed")
-JMESSAGE(JERR_EMS_WRITE, "Write to EMS failed")
-JMESSAGE(JERR_EOI_EXPECTED, "Didn't expect more than one scan")
-JMESSAGE(JERR_FILE_READ, "Input file read error")
-JMESSAGE(JERR_FILE_WRITE, "Output file write error --- out of disk space?")
-JMESSAGE(JERR_FRACT_SAMPLE_NOTIMPL, "Fractional sampling not implemented yet")
-JMESSAGE(JERR_HUFF_CLEN_OVERFLOW, "Huffman code size table overflow")
-JMESSAGE(JERR_HUFF_MISSING_CODE, "Missing Huffman code table entry")
-JMESSAGE(JERR_IMAGE_TOO_BIG, "Maximum supported image dimension is %u pixels")
-JMESSAGE(JERR_INPUT_EMPTY, "Empty input file")
-JMESSAGE(JERR_INPUT_EOF, "Premature end of input file")
-JMESSAGE(JERR_MISMATCHED_QUANT_TABLE,
-         "Cannot transcode due to multiple use of quantization table %d")
-JMESSAGE(JERR_MISSING_DATA, "Scan script does not transmit all data")
-JMESSAGE(JERR_MODE_CHANGE, "Invalid color quantization mode change")
-JMESSAGE(JERR_NOTIMPL, "Not implemented yet")
-JMESSAGE(JERR_NOT_COMPILED, "Requested feature was omitted at compile time")
+    JMESSAGE(JERR_BAD_HUFF_TABLE, "Bogus Huffman table definition")
+    JMESSAGE(JERR_BAD_IN_COLORSPACE, "Bogus input colorspace")
+    JMESSAGE(JERR_BAD_J_COLORSPACE, "Bogus JPEG colorspace")
+    JMESSAGE(JERR_BAD_LENGTH, "Bogus marker length")
+    JMESSAGE(JERR_BAD_LIB_VERSION,
+             "Wrong JPEG library version: library is %d, caller expects %d")
+    JMESSAGE(JERR_BAD_MCU_SIZE, "Sampling factors too large for interleaved scan")
+    JMESSAGE(JERR_BAD_POOL_ID, "Invalid memory pool code %d")
+    JMESSAGE(JERR_BAD_PRECISION, "Unsupported JPEG data precision %d")
+    JMESSAGE(JERR_BAD_PROGRESSION,
+             "Invalid progressive parameters Ss=%d Se=%d Ah=%d Al=%d")
+    JMESSAGE(JERR_BAD_PROG_SCRIPT,
+             "Invalid progressive parameters at scan script entry %d")
+    JMESSAGE(JERR_BAD_SAMPLING, "Bogus sampling factors")
+    JMESSAGE(JERR_BAD_SCAN_SCRIPT, "Invalid scan script at entry %d")
+    JMESSAGE(JERR_BAD_STATE, "Improper call to JPEG library in state %d")
+    JMESSAGE(JERR_BAD_STRUCT_SIZE,
+             "JPEG parameter struct mismatch: library thinks size is %u, caller expects %u")
+    JMESSAGE(JERR_BAD_VIRTUAL_ACCESS, "Bogus virtual array access")
+    JMESSAGE(JERR_BUFFER_SIZE, "Buffer passed to JPEG library is too small")
+    JMESSAGE(JERR_CANT_SUSPEND, "Suspension not allowed here")
+    JMESSAGE(JERR_CCIR601_NOTIMPL, "CCIR601 sampling not implemented yet")
+    JMESSAGE(JERR_COMPONENT_COUNT, "Too many color components: %d, max %d")
+    JMESSAGE(JERR_CONVERSION_NOTIMPL, "Unsupported color conversion request")
+    JMESSAGE(JERR_DAC_INDEX, "Bogus DAC index %d")
+    JMESSAGE(JERR_DAC_VALUE, "Bogus DAC value 0x%x")
+    JMESSAGE(JERR_DHT_INDEX, "Bogus DHT index %d")
+    JMESSAGE(JERR_DQT_INDEX, "Bogus DQT index %d")
+    JMESSAGE(JERR_EMPTY_IMAGE, "Empty JPEG image (DNL not supported)")
+    JMESSAGE(JERR_EMS_READ, "Read from EMS failed")
+    JMESSAGE(JERR_EMS_WRITE, "Write to EMS failed")
+    JMESSAGE(JERR_EOI_EXPECTED, "Didn't expect more than one scan")
+    JMESSAGE(JERR_FILE_READ, "Input file read error")
+    JMESSAGE(JERR_FILE_WRITE, "Output file write error --- out of disk space?")
+    JMESSAGE(JERR_FRACT_SAMPLE_NOTIMPL, "Fractional sampling not implemented yet")
+    JMESSAGE(JERR_HUFF_CLEN_OVERFLOW, "Huffman code size table overflow")
+    JMESSAGE(JERR_HUFF_MISSING_CODE, "Missing Huffman code table entry")
+    JMESSAGE(JERR_IMAGE_TOO_BIG, "Maximum supported image dimension is %u pixels")
+    JMESSAGE(JERR_INPUT_EMPTY, "Empty input file")
+    JMESSAGE(JERR_INPUT_EOF, "Premature end of input file")
+    JMESSAGE(JERR_MISMATCHED_QUANT_TABLE,
+             "Cannot transcode due to multiple use of quantization table %d")
+    JMESSAGE(JERR_MISSING_DATA, "Scan script does not transmit all data")
+    JMESSAGE(JERR_MODE_CHANGE, "Invalid color quantization mode change")
+    JMESSAGE(JERR_NOTIMPL, "Not implemented yet")
+    JMESSAGE(JERR_NOT_COMPILED, "Requested feature was omitted at compile time")
 #if JPEG_LIB_VERSION >= 70
-JMESSAGE(JERR_NO_ARITH_TABLE, "Arithmetic table 0x%02x was not defined")
+    JMESSAGE(JERR_NO_ARITH_TABLE, "Arithmetic table 0x%02x was not defined")
 #endif
-JMESSAGE(JERR_NO_BACKING_STORE, "Backing store not supported")
-JMESSAGE(JERR_NO_HUFF_TABLE, "Huffman table 0x%02x was not defined")
-JMESSAGE(JERR_NO_IMAGE, "JPEG datastream contains no image")
-JMESSAGE(JERR_NO_QUANT_TABLE, "Quantization table 0x%02x was not defined")
-JMESSAGE(JERR_NO_SOI, "Not a JPEG file: starts with 0x%02x 0x%02x")
-JMESSAGE(JERR_OUT_OF_MEMORY, "Insufficient memory (case %d)")
-JMESSAGE(JERR_QUANT_COMPONENTS,
-         "Cannot quantize more than %d color components")
-JMESSAGE(JERR_QUANT_FEW_COLORS, "Cannot quantize to fewer than %d colors")
-JMESSAGE(JERR_QUANT_MANY_COLORS, "Cannot quantize to more than %d colors")
-JMESSAGE(JERR_SOF_DUPLICATE, "Invalid JPEG file structure: two SOF markers")
-JMESSAGE(JERR_SOF_NO_SOS, "Invalid JPEG file structure: missing SOS marker")
-JMESSAGE(JERR_SOF_UNSUPPORTED, "Unsupported JPEG process: SOF type 0x%02x")
-JMESSAGE(JERR_SOI_DUPLICATE, "Invalid JPEG file structure: two SOI markers")
-JMESSAGE(JERR_SOS_NO_SOF, "Invalid JPEG file structure: SOS before SOF")
-JMESSAGE(JERR_TFILE_CREATE, "Failed to create temporary file %s")
-JMESSAGE(JERR_TFILE_READ, "Read failed on temporary file")
-JMESSAGE(JERR_TFILE_SEEK, "Seek failed on temporary file")
-JMESSAGE(JERR_TFILE_WRITE,
-         "Write failed on temporary file --- out of disk space?")
-JMESSAGE(JERR_TOO_LITTLE_DATA, "Application transferred too few scanlines")
-JMESSAGE(JERR_UNKNOWN_MARKER, "Unsupported marker type 0x%02x")
-JMESSAGE(JERR_VIRTUAL_BUG, "Virtual array controller messed up")
-JMESSAGE(JERR_WIDTH_OVERFLOW, "Image too wide for this implementation")
-JMESSAGE(JERR_XMS_READ, "Read from XMS failed")
-JMESSAGE(JERR_XMS_WRITE, "Write to XMS failed")
-JMESSAGE(JMSG_COPYRIGHT, JCOPYRIGHT_SHORT)
-JMESSAGE(JMSG_VERSION, JVERSION)
-JMESSAGE(JTRC_16BIT_TABLES,
-         "Caution: quantization tables are too coarse for baseline JPEG")
-JMESSAGE(JTRC_ADOBE,
-         "Adobe APP14 marker: version %d, flags 0x%04x 0x%04x, transform %d")
-JMESSAGE(JTRC_APP0, "Unknown APP0 marker (not JFIF), length %u")
-JMESSAGE(JTRC_APP14, "Unknown APP14 marker (not Adobe), length %u")
-JMESSAGE(JTRC_DAC, "Define Arithmetic Table 0x%02x: 0x%02x")
-JMESSAGE(JTRC_DHT, "Define Huffman Table 0x%02x")
-JMESSAGE(JTRC_DQT, "Define Quantization Table %d  precision %d")
-JMESSAGE(JTRC_DRI, "Define Restart Interval %u")
-JMESSAGE(JTRC_EMS_CLOSE, "Freed EMS handle %u")
-JMESSAGE(JTRC_EMS_OPEN, "Obtained EMS handle %u")
-JMESSAGE(JTRC_EOI, "End Of Image")
-JMESSAGE(JTRC_HUFFBITS, "        %3d %3d %3d %3d %3d %3d %3d %3d")
-JMESSAGE(JTRC_JFIF, "JFIF APP0 marker: version %d.%02d, density %dx%d  %d")
-JMESSAGE(JTRC_JFIF_BADTHUMBNAILSIZE,
-         "Warning: thumbnail image size does not match data length %u")
-JMESSAGE(JTRC_JFIF_EXTENSION,
-         "JFIF extension marker: type 0x%02x, length %u")
-JMESSAGE(JTRC_JFIF_THUMBNAIL, "    with %d x %d thumbnail image")
-JMESSAGE(JTRC_MISC_MARKER, "Miscellaneous marker 0x%02x, length %u")
-JMESSAGE(JTRC_PARMLESS_MARKER, "Unexpected marker 0x%02x")
-JMESSAGE(JTRC_QUANTVALS, "        %4u %4u %4u %4u %4u %4u %4u %4u")
-JMESSAGE(JTRC_QUANT_3_NCOLORS, "Quantizing to %d = %d*%d*%d colors")
-JMESSAGE(JTRC_QUANT_NCOLORS, "Quantizing to %d colors")
-JMESSAGE(JTRC_QUANT_SELECTED, "Selected %d colors for quantization")
-JMESSAGE(JTRC_RECOVERY_ACTION, "At marker 0x%02x, recovery action %d")
-JMESSAGE(JTRC_RST, "RST%d")
-JMESSAGE(JTRC_SMOOTH_NOTIMPL,
-         "Smoothing not supported with nonstandard sampling ratios")
-JMESSAGE(JTRC_SOF, "Start Of Frame 0x%02x: width=%u, height=%u, components=%d")
-JMESSAGE(JTRC_SOF_COMPONENT, "    Component %d: %dhx%dv q=%d")
-JMESSAGE(JTRC_SOI, "Start of Image")
-JMESSAGE(JTRC_SOS, "Start Of Scan: %d components")
-JMESSAGE(JTRC_SOS_COMPONENT, "    Component %d: dc=%d ac=%d")
-JMESSAGE(JTRC_SOS_PARAMS, "  Ss=%d, Se=%d, Ah=%d, Al=%d")
-JMESSAGE(JTRC_TFILE_CLOSE, "Closed temporary file %s")
-JMESSAGE(JTRC_TFILE_OPEN, "Opened temporary file %s")
-JMESSAGE(JTRC_THUMB_JPEG,
-         "JFIF extension marker: JPEG-compressed thumbnail image, length %u")
-JMESSAGE(JTRC_THUMB_PALETTE,
-         "JFIF extension marker: palette thumbnail image, length %u")
-JMESSAGE(JTRC_THUMB_RGB,
-         "JFIF extension marker: RGB thumbnail image, length %u")
-JMESSAGE(JTRC_UNKNOWN_IDS,
-         "Unrecognized component IDs %d %d %d, assuming YCbCr")
-JMESSAGE(JTRC_XMS_CLOSE, "Freed XMS handle %u")
-JMESSAGE(JTRC_XMS_OPEN, "Obtained XMS handle %u")
-JMESSAGE(JWRN_ADOBE_XFORM, "Unknown Adobe color transform code %d")
+    JMESSAGE(JERR_NO_BACKING_STORE, "Backing store not supported")
+    JMESSAGE(JERR_NO_HUFF_TABLE, "Huffman table 0x%02x was not defined")
+    JMESSAGE(JERR_NO_IMAGE, "JPEG datastream contains no image")
+    JMESSAGE(JERR_NO_QUANT_TABLE, "Quantization table 0x%02x was not defined")
+    JMESSAGE(JERR_NO_SOI, "Not a JPEG file: starts with 0x%02x 0x%02x")
+    JMESSAGE(JERR_OUT_OF_MEMORY, "Insufficient memory (case %d)")
+    JMESSAGE(JERR_QUANT_COMPONENTS,
+             "Cannot quantize more than %d color components")
+    JMESSAGE(JERR_QUANT_FEW_COLORS, "Cannot quantize to fewer than %d colors")
+    JMESSAGE(JERR_QUANT_MANY_COLORS, "Cannot quantize to more than %d colors")
+    JMESSAGE(JERR_SOF_DUPLICATE, "Invalid JPEG file structure: two SOF markers")
+    JMESSAGE(JERR_SOF_NO_SOS, "Invalid JPEG file structure: missing SOS marker")
+    JMESSAGE(JERR_SOF_UNSUPPORTED, "Unsupported JPEG process: SOF type 0x%02x")
+    JMESSAGE(JERR_SOI_DUPLICATE, "Invalid JPEG file structure: two SOI markers")
+    JMESSAGE(JERR_SOS_NO_SOF, "Invalid JPEG file structure: SOS before SOF")
+    JMESSAGE(JERR_TFILE_CREATE, "Failed to create temporary file %s")
+    JMESSAGE(JERR_TFILE_READ, "Read failed on temporary file")
+    JMESSAGE(JERR_TFILE_SEEK, "Seek failed on temporary file")
+    JMESSAGE(JERR_TFILE_WRITE,
+             "Write failed on temporary file --- out of disk space?")
+    JMESSAGE(JERR_TOO_LITTLE_DATA, "Application transferred too few scanlines")
+    JMESSAGE(JERR_UNKNOWN_MARKER, "Unsupported marker type 0x%02x")
+    JMESSAGE(JERR_VIRTUAL_BUG, "Virtual array controller messed up")
+    JMESSAGE(JERR_WIDTH_OVERFLOW, "Image too wide for this implementation")
+    JMESSAGE(JERR_XMS_READ, "Read from XMS failed")
+    JMESSAGE(JERR_XMS_WRITE, "Write to XMS failed")
+    JMESSAGE(JMSG_COPYRIGHT, JCOPYRIGHT_SHORT)
+    JMESSAGE(JMSG_VERSION, JVERSION)
+    JMESSAGE(JTRC_16BIT_TABLES,
+             "Caution: quantization tables are too coarse for baseline JPEG")
+    JMESSAGE(JTRC_ADOBE,
+             "Adobe APP14 marker: version %d, flags 0x%04x 0x%04x, transform %d")
+    JMESSAGE(JTRC_APP0, "Unknown APP0 marker (not JFIF), length %u")
+    JMESSAGE(JTRC_APP14, "Unknown APP14 marker (not Adobe), length %u")
+    JMESSAGE(JTRC_DAC, "Define Arithmetic Table 0x%02x: 0x%02x")
+    JMESSAGE(JTRC_DHT, "Define Huffman Table 0x%02x")
+    JMESSAGE(JTRC_DQT, "Define Quantization Table %d  precision %d")
+    JMESSAGE(JTRC_DRI, "Define Restart Interval %u")
+    JMESSAGE(JTRC_EMS_CLOSE, "Freed EMS handle %u")
+    JMESSAGE(JTRC_EMS_OPEN, "Obtained EMS handle %u")
+    JMESSAGE(JTRC_EOI, "End Of Image")
+    JMESSAGE(JTRC_HUFFBITS, "        %3d %3d %3d %3d %3d %3d %3d %3d")
+    JMESSAGE(JTRC_JFIF, "JFIF APP0 marker: version %d.%02d, density %dx%d  %d")
+    JMESSAGE(JTRC_JFIF_BADTHUMBNAILSIZE,
+             "Warning: thumbnail image size does not match data length %u")
+    JMESSAGE(JTRC_JFIF_EXTENSION,
+             "JFIF extension marker: type 0x%02x, length %u")
+    JMESSAGE(JTRC_JFIF_THUMBNAIL, "    with %d x %d thumbnail image")
+    JMESSAGE(JTRC_MISC_MARKER, "Miscellaneous marker 0x%02x, length %u")
+    JMESSAGE(JTRC_PARMLESS_MARKER, "Unexpected marker 0x%02x")
+    JMESSAGE(JTRC_QUANTVALS, "        %4u %4u %4u %4u %4u %4u %4u %4u")
+    JMESSAGE(JTRC_QUANT_3_NCOLORS, "Quantizing to %d = %d*%d*%d colors")
+    JMESSAGE(JTRC_QUANT_NCOLORS, "Quantizing to %d colors")
+    JMESSAGE(JTRC_QUANT_SELECTED, "Selected %d colors for quantization")
+    JMESSAGE(JTRC_RECOVERY_ACTION, "At marker 0x%02x, recovery action %d")
+    JMESSAGE(JTRC_RST, "RST%d")
+    JMESSAGE(JTRC_SMOOTH_NOTIMPL,
+             "Smoothing not supported with nonstandard sampling ratios")
+    JMESSAGE(JTRC_SOF, "Start Of Frame 0x%02x: width=%u, height=%u, components=%d")
+    JMESSAGE(JTRC_SOF_COMPONENT, "    Component %d: %dhx%dv q=%d")
+    JMESSAGE(JTRC_SOI, "Start of Image")
+    JMESSAGE(JTRC_SOS, "Start Of Scan: %d components")
+    JMESSAGE(JTRC_SOS_COMPONENT, "    Component %d: dc=%d ac=%d")
+    JMESSAGE(JTRC_SOS_PARAMS, "  Ss=%d, Se=%d, Ah=%d, Al=%d")
+    JMESSAGE(JTRC_TFILE_CLOSE, "Closed temporary file %s")
+    JMESSAGE(JTRC_TFILE_OPEN, "Opened temporary file %s")
+    JMESSAGE(JTRC_THUMB_JPEG,
+             "JFIF extension marker: JPEG-compressed thumbnail image, length %u")
+    JMESSAGE(JTRC_THUMB_PALETTE,
+             "JFIF extension marker: palette thumbnail image, length %u")
+    JMESSAGE(JTRC_THUMB_RGB,
+             "JFIF extension marker: RGB thumbnail image, length %u")
+    JMESSAGE(JTRC_UNKNOWN_IDS,
+             "Unrecognized component IDs %d %d %d, assuming YCbCr")
+    JMESSAGE(JTRC_XMS_CLOSE, "Freed XMS handle %u")
+    JMESSAGE(JTRC_XMS_OPEN, "Obtained XMS handle %u")
+    JMESSAGE(JWRN_ADOBE_XFORM, "Unknown Adobe color transform code %d")
 #if JPEG_LIB_VERSION >= 70
-JMESSAGE(JWRN_ARITH_BAD_CODE, "Corrupt JPEG data: bad arithmetic code")
+    JMESSAGE(JWRN_ARITH_BAD_CODE, "Corrupt JPEG data: bad arithmetic code")
 #endif
-JMESSAGE(JWRN_BOGUS_PROGRESSION,
-         "Inconsistent progression sequence for component %d coefficient %d")
-JMESSAGE(JWRN_EXTRANEOUS_DATA,
-         "Corrupt JPEG data: %u extraneous bytes before marker 0x%02x")
-JMESSAGE(JWRN_HIT_MARKER, "Corrupt JPEG data: premature end of data segment")
-JMESSAGE(JWRN_HUFF_BAD_CODE, "Corrupt JPEG data: bad Huffman code")
-JMESSAGE(JWRN_JFIF_MAJOR, "Warning: unknown JFIF revision number %d.%02d")
-JMESSAGE(JWRN_JPEG_EOF, "Premature end of JPEG file")
-JMESSAGE(JWRN_MUST_RESYNC,
-         "Corrupt JPEG data: found marker 0x%02x instead of RST%d")
-JMESSAGE(JWRN_NOT_SEQUENTIAL, "Invalid SOS parameters for sequential JPEG")
-JMESSAGE(JWRN_TOO_MUCH_DATA, "Application transferred too many scanlines")
+    JMESSAGE(JWRN_BOGUS_PROGRESSION,
+             "Inconsistent progression sequence for component %d coefficient %d")
+    JMESSAGE(JWRN_EXTRANEOUS_DATA,
+             "Corrupt JPEG data: %u extraneous bytes before marker 0x%02x")
+    JMESSAGE(JWRN_HIT_MARKER, "Corrupt JPEG data: premature end of data segment")
+    JMESSAGE(JWRN_HUFF_BAD_CODE, "Corrupt JPEG data: bad Huffman code")
+    JMESSAGE(JWRN_JFIF_MAJOR, "Warning: unknown JFIF revision number %d.%02d")
+    JMESSAGE(JWRN_JPEG_EOF, "Premature end of JPEG file")
+    JMESSAGE(JWRN_MUST_RESYNC,
+             "Corrupt JPEG data: found marker 0x%02x instead of RST%d")
+    JMESSAGE(JWRN_NOT_SEQUENTIAL, "Invalid SOS parameters for sequential JPEG")
+    JMESSAGE(JWRN_TOO_MUCH_DATA, "Application transferred too many scanlines")
 #if JPEG_LIB_VERSION < 70
-JMESSAGE(JERR_BAD_CROP_SPEC, "Invalid crop request")
+    JMESSAGE(JERR_BAD_CROP_SPEC, "Invalid crop request")
 #if defined(C_ARITH_CODING_SUPPORTED) || defined(D_ARITH_CODING_SUPPORTED)
-JMESSAGE(JERR_NO_ARITH_TABLE, "Arithmetic table 0x%02x was not defined")
-JMESSAGE(JWRN_ARITH_BAD_CODE, "Corrupt JPEG data: bad arithmetic code")
+    JMESSAGE(JERR_NO_ARITH_TABLE, "Arithmetic table 0x%02x was not defined")
+    JMESSAGE(JWRN_ARITH_BAD_CODE, "Corrupt JPEG data: bad arithmetic code")
 #endif
 #endif
 
 #ifdef JMAKE_ENUM_LIST
 
-  JMSG_LASTMSGCODE
+    JMSG_LASTMSGCODE
 } J_MESSAGE_CODE;
 
 #undef JMAKE_ENUM_LIST
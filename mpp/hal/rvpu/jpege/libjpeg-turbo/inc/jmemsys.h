@@ -104,9 +104,9 @@ typedef unsigned short XMSH;    /* type of extended-memory handles */
 typedef unsigned short EMSH;    /* type of expanded-memory handles */
 
 typedef union {
-  short file_handle;            /* DOS file handle if it's a temp file */
-  XMSH xms_handle;              /* handle if it's a chunk of XMS */
-  EMSH ems_handle;              /* handle if it's a chunk of EMS */
+    short file_handle;            /* DOS file handle if it's a temp file */
+    XMSH xms_handle;              /* handle if it's a chunk of XMS */
+    EMSH ems_handle;              /* handle if it's a chunk of EMS */
 } handle_union;
 
 #endif /* USE_MSDOS_MEMMGR */
@@ -119,30 +119,30 @@ typedef union {
 typedef struct backing_store_struct * backing_store_ptr;
 
 typedef struct backing_store_struct {
-  /* Methods for reading/writing/closing this backing-store object */
-  void (*read_backing_store) (j_common_ptr cinfo, backing_store_ptr info,
-                              void * buffer_address, long file_offset,
-                              long byte_count);
-  void (*write_backing_store) (j_common_ptr cinfo, backing_store_ptr info,
-                               void * buffer_address, long file_offset,
-                               long byte_count);
-  void (*close_backing_store) (j_common_ptr cinfo, backing_store_ptr info);
-
-  /* Private fields for system-dependent backing-store management */
+    /* Methods for reading/writing/closing this backing-store object */
+    void (*read_backing_store) (j_common_ptr cinfo, backing_store_ptr info,
+                                void * buffer_address, long file_offset,
+                                long byte_count);
+    void (*write_backing_store) (j_common_ptr cinfo, backing_store_ptr info,
+                                 void * buffer_address, long file_offset,
+                                 long byte_count);
+    void (*close_backing_store) (j_common_ptr cinfo, backing_store_ptr info);
+
+    /* Private fields for system-dependent backing-store management */
 #ifdef USE_MSDOS_MEMMGR
-  /* For the MS-DOS manager (jmemdos.c), we need: */
-  handle_union handle;          /* reference to backing-store storage object */
-  char temp_name[TEMP_NAME_LENGTH]; /* name if it's a file */
+    /* For the MS-DOS manager (jmemdos.c), we need: */
+    handle_union handle;          /* reference to backing-store storage object */
+    char temp_name[TEMP_NAME_LENGTH]; /* name if it's a file */
 #else
 #ifdef USE_MAC_MEMMGR
-  /* For the Mac manager (jmemmac.c), we need: */
-  short temp_file;              /* file reference number to temp file */
-  FSSpec tempSpec;              /* the FSSpec for the temp file */
-  char temp_name[TEMP_NAME_LENGTH]; /* name if it's a file */
+    /* For the Mac manager (jmemmac.c), we need: */
+    short temp_file;              /* file reference number to temp file */
+    FSSpec tempSpec;              /* the FSSpec for the temp file */
+    char temp_name[TEMP_NAME_LENGTH]; /* name if it's a file */
 #else
-  /* For a typical implementation with temp files, we need: */
-  FILE * temp_file;             /* stdio reference to temp file */
-  char temp_name[TEMP_NAME_LENGTH]; /* name of temp file */
+    /* For a typical implementation with temp files, we need: */
+    FILE * temp_file;             /* stdio reference to temp file */
+    char temp_name[TEMP_NAME_LENGTH]; /* name of temp file */
 #endif
 #endif
 } backing_store_info;
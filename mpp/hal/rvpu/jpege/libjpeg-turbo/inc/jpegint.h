@@ -17,11 +17,11 @@
 /* Declarations for both compression & decompression */
 
 typedef enum {            /* Operating modes for buffer controllers */
-  JBUF_PASS_THRU,         /* Plain stripwise operation */
-  /* Remaining modes require a full-image buffer to have been created */
-  JBUF_SAVE_SOURCE,       /* Run source subobject only, save output */
-  JBUF_CRANK_DEST,        /* Run dest subobject only, using saved data */
-  JBUF_SAVE_AND_PASS      /* Run both subobjects, save output */
+    JBUF_PASS_THRU,         /* Plain stripwise operation */
+    /* Remaining modes require a full-image buffer to have been created */
+    JBUF_SAVE_SOURCE,       /* Run source subobject only, save output */
+    JBUF_CRANK_DEST,        /* Run dest subobject only, using saved data */
+    JBUF_SAVE_AND_PASS      /* Run both subobjects, save output */
 } J_BUF_MODE;
 
 /* Values of global_state field (jdapi.c has some dependencies on ordering!) */
@@ -46,85 +46,85 @@ typedef enum {            /* Operating modes for buffer controllers */
 
 /* Master control module */
 struct jpeg_comp_master {
-  void (*prepare_for_pass) (j_compress_ptr cinfo);
-  void (*pass_startup) (j_compress_ptr cinfo);
-  void (*finish_pass) (j_compress_ptr cinfo);
+    void (*prepare_for_pass) (j_compress_ptr cinfo);
+    void (*pass_startup) (j_compress_ptr cinfo);
+    void (*finish_pass) (j_compress_ptr cinfo);
 
-  /* State variables made visible to other modules */
-  boolean call_pass_startup;    /* True if pass_startup must be called */
-  boolean is_last_pass;         /* True during last pass */
+    /* State variables made visible to other modules */
+    boolean call_pass_startup;    /* True if pass_startup must be called */
+    boolean is_last_pass;         /* True during last pass */
 };
 
 /* Main buffer control (downsampled-data buffer) */
 struct jpeg_c_main_controller {
-  void (*start_pass) (j_compress_ptr cinfo, J_BUF_MODE pass_mode);
-  void (*process_data) (j_compress_ptr cinfo, JSAMPARRAY input_buf,
-                        JDIMENSION *in_row_ctr, JDIMENSION in_rows_avail);
+    void (*start_pass) (j_compress_ptr cinfo, J_BUF_MODE pass_mode);
+    void (*process_data) (j_compress_ptr cinfo, JSAMPARRAY input_buf,
+                          JDIMENSION *in_row_ctr, JDIMENSION in_rows_avail);
 };
 
 /* Compression preprocessing (downsampling input buffer control) */
 struct jpeg_c_prep_controller {
-  void (*start_pass) (j_compress_ptr cinfo, J_BUF_MODE pass_mode);
-  void (*pre_process_data) (j_compress_ptr cinfo, JSAMPARRAY input_buf,
-                            JDIMENSION *in_row_ctr, JDIMENSION in_rows_avail,
-                            JSAMPIMAGE output_buf,
-                            JDIMENSION *out_row_group_ctr,
-                            JDIMENSION out_row_groups_avail);
+    void (*start_pass) (j_compress_ptr cinfo, J_BUF_MODE pass_mode);
+    void (*pre_process_data) (j_compress_ptr cinfo, JSAMPARRAY input_buf,
+                              JDIMENSION *in_row_ctr, JDIMENSION in_rows_avail,
+                              JSAMPIMAGE output_buf,
+                              JDIMENSION *out_row_group_ctr,
+                              JDIMENSION out_row_groups_avail);
 };
 
 /* Coefficient buffer control */
 struct jpeg_c_coef_controller {
-  void (*start_pass) (j_compress_ptr cinfo, J_BUF_MODE pass_mode);
-  boolean (*compress_data) (j_compress_ptr cinfo, JSAMPIMAGE input_buf);
+    void (*start_pass) (j_compress_ptr cinfo, J_BUF_MODE pass_mode);
+    boolean (*compress_data) (j_compress_ptr cinfo, JSAMPIMAGE input_buf);
 };
 
 /* Colorspace conversion */
 struct jpeg_color_converter {
-  void (*start_pass) (j_compress_ptr cinfo);
-  void (*color_convert) (j_compress_ptr cinfo, JSAMPARRAY input_buf,
-                         JSAMPIMAGE output_buf, JDIMENSION output_row,
-                         int num_rows);
+    void (*start_pass) (j_compress_ptr cinfo);
+    void (*color_convert) (j_compress_ptr cinfo, JSAMPARRAY input_buf,
+                           JSAMPIMAGE output_buf, JDIMENSION output_row,
+                           int num_rows);
 };
 
 /* Downsampling */
 struct jpeg_downsampler {
-  void (*start_pass) (j_compress_ptr cinfo);
-  void (*downsample) (j_compress_ptr cinfo, JSAMPIMAGE input_buf,
-                      JDIMENSION in_row_index, JSAMPIMAGE output_buf,
-                      JDIMENSION out_row_group_index);
+    void (*start_pass) (j_compress_ptr cinfo);
+    void (*downsample) (j_compress_ptr cinfo, JSAMPIMAGE input_buf,
+                        JDIMENSION in_row_index, JSAMPIMAGE output_buf,
+                        JDIMENSION out_row_group_index);
 
-  boolean need_context_rows;    /* TRUE if need rows above & below */
+    boolean need_context_rows;    /* TRUE if need rows above & below */
 };
 
 /* Forward DCT (also controls coefficient quantization) */
 struct jpeg_forward_dct {
-  void (*start_pass) (j_compress_ptr cinfo);
-  /* perhaps this should be an array??? */
-  void (*forward_DCT) (j_compress_ptr cinfo, jpeg_component_info * compptr,
-                       JSAMPARRAY sample_data, JBLOCKROW coef_blocks,
-                       JDIMENSION start_row, JDIMENSION start_col,
-                       JDIMENSION num_blocks);
+    void (*start_pass) (j_compress_ptr cinfo);
+    /* perhaps this should be an array??? */
+    void (*forward_DCT) (j_compress_ptr cinfo, jpeg_component_info * compptr,
+                         JSAMPARRAY sample_data, JBLOCKROW coef_blocks,
+                         JDIMENSION start_row, JDIMENSION start_col,
+                         JDIMENSION num_blocks);
 };
 
 /* Entropy encoding */
 struct jpeg_entropy_encoder {
-  void (*start_pass) (j_compress_ptr cinfo, boolean gather_statistics);
-  boolean (*encode_mcu) (j_compress_ptr cinfo, JBLOCKROW *MCU_data);
-  void (*finish_pass) (j_compress_ptr cinfo);
+    void (*start_pass) (j_compress_ptr cinfo, boolean gather_statistics);
+    boolean (*encode_mcu) (j_compress_ptr cinfo, JBLOCKROW *MCU_data);
+    void (*finish_pass) (j_compress_ptr cinfo);
 };
 
 /* Marker writing */
 struct jpeg_marker_writer {
-  void (*write_file_header) (j_compress_ptr cinfo);
-  void (*write_frame_header) (j_compress_ptr cinfo);
-  void (*write_scan_header) (j_compress_ptr cinfo);
-  void (*write_file_trailer) (j_compress_ptr cinfo);
-  void (*write_tables_only) (j_compress_ptr cinfo);
-  /* These routines are exported to allow insertion of extra markers */
-  /* Probably only COM and APPn markers should be written this way */
-  void (*write_marker_header) (j_compress_ptr cinfo, int marker,
-                               unsigned int datalen);
-  void (*write_marker_byte) (j_compress_ptr cinfo, int val);
+    void (*write_file_header) (j_compress_ptr cinfo);
+    void (*write_frame_header) (j_compress_ptr cinfo);
+    void (*write_scan_header) (j_compress_ptr cinfo);
+    void (*write_file_trailer) (j_compress_ptr cinfo);
+    void (*write_tables_only) (j_compress_ptr cinfo);
+    /* These routines are exported to allow insertion of extra markers */
+    /* Probably only COM and APPn markers should be written this way */
+    void (*write_marker_header) (j_compress_ptr cinfo, int marker,
+                                 unsigned int datalen);
+    void (*write_marker_byte) (j_compress_ptr cinfo, int val);
 };
 
 
@@ -132,80 +132,80 @@ struct jpeg_marker_writer {
 
 /* Master control module */
 struct jpeg_decomp_master {
-  void (*prepare_for_output_pass) (j_decompress_ptr cinfo);
-  void (*finish_output_pass) (j_decompress_ptr cinfo);
+    void (*prepare_for_output_pass) (j_decompress_ptr cinfo);
+    void (*finish_output_pass) (j_decompress_ptr cinfo);
 
-  /* State variables made visible to other modules */
-  boolean is_dummy_pass;        /* True during 1st pass for 2-pass quant */
+    /* State variables made visible to other modules */
+    boolean is_dummy_pass;        /* True during 1st pass for 2-pass quant */
 };
 
 /* Input control module */
 struct jpeg_input_controller {
-  int (*consume_input) (j_decompress_ptr cinfo);
-  void (*reset_input_controller) (j_decompress_ptr cinfo);
-  void (*start_input_pass) (j_decompress_ptr cinfo);
-  void (*finish_input_pass) (j_decompress_ptr cinfo);
-
-  /* State variables made visible to other modules */
-  boolean has_multiple_scans;   /* True if file has multiple scans */
-  boolean eoi_reached;          /* True when EOI has been consumed */
+    int (*consume_input) (j_decompress_ptr cinfo);
+    void (*reset_input_controller) (j_decompress_ptr cinfo);
+    void (*start_input_pass) (j_decompress_ptr cinfo);
+    void (*finish_input_pass) (j_decompress_ptr cinfo);
+
+    /* State variables made visible to other modules */
+    boolean has_multiple_scans;   /* True if file has multiple scans */
+    boolean eoi_reached;          /* True when EOI has been consumed */
 };
 
 /* Main buffer control (downsampled-data buffer) */
 struct jpeg_d_main_controller {
-  void (*start_pass) (j_decompress_ptr cinfo, J_BUF_MODE pass_mode);
-  void (*process_data) (j_decompress_ptr cinfo, JSAMPARRAY output_buf,
-                        JDIMENSION *out_row_ctr, JDIMENSION out_rows_avail);
+    void (*start_pass) (j_decompress_ptr cinfo, J_BUF_MODE pass_mode);
+    void (*process_data) (j_decompress_ptr cinfo, JSAMPARRAY output_buf,
+                          JDIMENSION *out_row_ctr, JDIMENSION out_rows_avail);
 };
 
 /* Coefficient buffer control */
 struct jpeg_d_coef_controller {
-  void (*start_input_pass) (j_decompress_ptr cinfo);
-  int (*consume_data) (j_decompress_ptr cinfo);
-  void (*start_output_pass) (j_decompress_ptr cinfo);
-  int (*decompress_data) (j_decompress_ptr cinfo, JSAMPIMAGE output_buf);
-  /* Pointer to array of coefficient virtual arrays, or NULL if none */
-  jvirt_barray_ptr *coef_arrays;
+    void (*start_input_pass) (j_decompress_ptr cinfo);
+    int (*consume_data) (j_decompress_ptr cinfo);
+    void (*start_output_pass) (j_decompress_ptr cinfo);
+    int (*decompress_data) (j_decompress_ptr cinfo, JSAMPIMAGE output_buf);
+    /* Pointer to array of coefficient virtual arrays, or NULL if none */
+    jvirt_barray_ptr *coef_arrays;
 };
 
 /* Decompression postprocessing (color quantization buffer control) */
 struct jpeg_d_post_controller {
-  void (*start_pass) (j_decompress_ptr cinfo, J_BUF_MODE pass_mode);
-  void (*post_process_data) (j_decompress_ptr cinfo, JSAMPIMAGE input_buf,
-                             JDIMENSION *in_row_group_ctr,
-                             JDIMENSION in_row_groups_avail,
-                             JSAMPARRAY output_buf, JDIMENSION *out_row_ctr,
-                             JDIMENSION out_rows_avail);
+    void (*start_pass) (j_decompress_ptr cinfo, J_BUF_MODE pass_mode);
+    void (*post_process_data) (j_decompress_ptr cinfo, JSAMPIMAGE input_buf,
+                               JDIMENSION *in_row_group_ctr,
+                               JDIMENSION in_row_groups_avail,
+                               JSAMPARRAY output_buf, JDIMENSION *out_row_ctr,
+                               JDIMENSION out_rows_avail);
 };
 
 /* Marker reading & parsing */
 struct jpeg_marker_reader {
-  void (*reset_marker_reader) (j_decompress_ptr cinfo);
-  /* Read markers until SOS or EOI.
-   * Returns same codes as are defined for jpeg_consume_input:
-   * JPEG_SUSPENDED, JPEG_REACHED_SOS, or JPEG_REACHED_EOI.
-   */
-  int (*read_markers) (j_decompress_ptr cinfo);
-  /* Read a restart marker --- exported for use by entropy decoder only */
-  jpeg_marker_parser_method read_restart_marker;
-
-  /* State of marker reader --- nominally internal, but applications
-   * supplying COM or APPn handlers might like to know the state.
-   */
-  boolean saw_SOI;              /* found SOI? */
-  boolean saw_SOF;              /* found SOF? */
-  int next_restart_num;         /* next restart number expected (0-7) */
-  unsigned int discarded_bytes; /* # of bytes skipped looking for a marker */
+    void (*reset_marker_reader) (j_decompress_ptr cinfo);
+    /* Read markers until SOS or EOI.
+     * Returns same codes as are defined for jpeg_consume_input:
+     * JPEG_SUSPENDED, JPEG_REACHED_SOS, or JPEG_REACHED_EOI.
+     */
+    int (*read_markers) (j_decompress_ptr cinfo);
+    /* Read a restart marker --- exported for use by entropy decoder only */
+    jpeg_marker_parser_method read_restart_marker;
+
+    /* State of marker reader --- nominally internal, but applications
+     * supplying COM or APPn handlers might like to know the state.
+     */
+    boolean saw_SOI;              /* found SOI? */
+    boolean saw_SOF;              /* found SOF? */
+    int next_restart_num;         /* next restart number expected (0-7) */
+    unsigned int discarded_bytes; /* # of bytes skipped looking for a marker */
 };
 
 /* Entropy decoding */
 struct jpeg_entropy_decoder {
-  void (*start_pass) (j_decompress_ptr cinfo);
-  boolean (*decode_mcu) (j_decompress_ptr cinfo, JBLOCKROW *MCU_data);
+    void (*start_pass) (j_decompress_ptr cinfo);
+    boolean (*decode_mcu) (j_decompress_ptr cinfo, JBLOCKROW *MCU_data);
 
-  /* This is here to share code between baseline and progressive decoders; */
-  /* other modules probably should not use it */
-  boolean insufficient_data;    /* set TRUE after emitting warning */
+    /* This is here to share code between baseline and progressive decoders; */
+    /* other modules probably should not use it */
+    boolean insufficient_data;    /* set TRUE after emitting warning */
 };
 
 /* Inverse DCT (also performs dequantization) */
@@ -216,37 +216,37 @@ typedef void (*inverse_DCT_method_ptr) (j_decompress_ptr cinfo,
                                         JDIMENSION output_col);
 
 struct jpeg_inverse_dct {
-  void (*start_pass) (j_decompress_ptr cinfo);
-  /* It is useful to allow each component to have a separate IDCT method. */
-  inverse_DCT_method_ptr inverse_DCT[MAX_COMPONENTS];
+    void (*start_pass) (j_decompress_ptr cinfo);
+    /* It is useful to allow each component to have a separate IDCT method. */
+    inverse_DCT_method_ptr inverse_DCT[MAX_COMPONENTS];
 };
 
 /* Upsampling (note that upsampler must also call color converter) */
 struct jpeg_upsampler {
-  void (*start_pass) (j_decompress_ptr cinfo);
-  void (*upsample) (j_decompress_ptr cinfo, JSAMPIMAGE input_buf,
-                    JDIMENSION *in_row_group_ctr,
-                    JDIMENSION in_row_groups_avail, JSAMPARRAY output_buf,
-                    JDIMENSION *out_row_ctr, JDIMENSION out_rows_avail);
+    void (*start_pass) (j_decompress_ptr cinfo);
+    void (*upsample) (j_decompress_ptr cinfo, JSAMPIMAGE input_buf,
+                      JDIMENSION *in_row_group_ctr,
+                      JDIMENSION in_row_groups_avail, JSAMPARRAY output_buf,
+                      JDIMENSION *out_row_ctr, JDIMENSION out_rows_avail);
 
-  boolean need_context_rows;    /* TRUE if need rows above & below */
+    boolean need_context_rows;    /* TRUE if need rows above & below */
 };
 
 /* Colorspace conversion */
 struct jpeg_color_deconverter {
-  void (*start_pass) (j_decompress_ptr cinfo);
-  void (*color_convert) (j_decompress_ptr cinfo, JSAMPIMAGE input_buf,
-                         JDIMENSION input_row, JSAMPARRAY output_buf,
-                         int num_rows);
+    void (*start_pass) (j_decompress_ptr cinfo);
+    void (*color_convert) (j_decompress_ptr cinfo, JSAMPIMAGE input_buf,
+                           JDIMENSION input_row, JSAMPARRAY output_buf,
+                           int num_rows);
 };
 
 /* Color quantization or color precision reduction */
 struct jpeg_color_quantizer {
-  void (*start_pass) (j_decompress_ptr cinfo, boolean is_pre_scan);
-  void (*color_quantize) (j_decompress_ptr cinfo, JSAMPARRAY input_buf,
-                          JSAMPARRAY output_buf, int num_rows);
-  void (*finish_pass) (j_decompress_ptr cinfo);
-  void (*new_color_map) (j_decompress_ptr cinfo);
+    void (*start_pass) (j_decompress_ptr cinfo, boolean is_pre_scan);
+    void (*color_quantize) (j_decompress_ptr cinfo, JSAMPARRAY input_buf,
+                            JSAMPARRAY output_buf, int num_rows);
+    void (*finish_pass) (j_decompress_ptr cinfo);
+    void (*new_color_map) (j_decompress_ptr cinfo);
 };
 
 
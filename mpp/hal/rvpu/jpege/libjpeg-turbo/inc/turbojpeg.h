@@ -89,47 +89,46 @@
  * (the human eye is more sensitive to small changes in brightness than to
  * small changes in color.)  This is called "chrominance subsampling".
  */
-enum TJSAMP
-{
-  /**
-   * 4:4:4 chrominance subsampling (no chrominance subsampling).  The JPEG or
-   * YUV image will contain one chrominance component for every pixel in the
-   * source image.
-   */
-  TJSAMP_444=0,
-  /**
-   * 4:2:2 chrominance subsampling.  The JPEG or YUV image will contain one
-   * chrominance component for every 2x1 block of pixels in the source image.
-   */
-  TJSAMP_422,
-  /**
-   * 4:2:0 chrominance subsampling.  The JPEG or YUV image will contain one
-   * chrominance component for every 2x2 block of pixels in the source image.
-   */
-  TJSAMP_420,
-  /**
-   * Grayscale.  The JPEG or YUV image will contain no chrominance components.
-   */
-  TJSAMP_GRAY,
-  /**
-   * 4:4:0 chrominance subsampling.  The JPEG or YUV image will contain one
-   * chrominance component for every 1x2 block of pixels in the source image.
-   *
-   * @note 4:4:0 subsampling is not fully accelerated in libjpeg-turbo.
-   */
-  TJSAMP_440,
-  /**
-   * 4:1:1 chrominance subsampling.  The JPEG or YUV image will contain one
-   * chrominance component for every 4x1 block of pixels in the source image.
-   * JPEG images compressed with 4:1:1 subsampling will be almost exactly the
-   * same size as those compressed with 4:2:0 subsampling, and in the
-   * aggregate, both subsampling methods produce approximately the same
-   * perceptual quality.  However, 4:1:1 is better able to reproduce sharp
-   * horizontal features.
-   *
-   * @note 4:1:1 subsampling is not fully accelerated in libjpeg-turbo.
-   */
-  TJSAMP_411
+enum TJSAMP {
+    /**
+     * 4:4:4 chrominance subsampling (no chrominance subsampling).  The JPEG or
+     * YUV image will contain one chrominance component for every pixel in the
+     * source image.
+     */
+    TJSAMP_444 = 0,
+    /**
+     * 4:2:2 chrominance subsampling.  The JPEG or YUV image will contain one
+     * chrominance component for every 2x1 block of pixels in the source image.
+     */
+    TJSAMP_422,
+    /**
+     * 4:2:0 chrominance subsampling.  The JPEG or YUV image will contain one
+     * chrominance component for every 2x2 block of pixels in the source image.
+     */
+    TJSAMP_420,
+    /**
+     * Grayscale.  The JPEG or YUV image will contain no chrominance components.
+     */
+    TJSAMP_GRAY,
+    /**
+     * 4:4:0 chrominance subsampling.  The JPEG or YUV image will contain one
+     * chrominance component for every 1x2 block of pixels in the source image.
+     *
+     * @note 4:4:0 subsampling is not fully accelerated in libjpeg-turbo.
+     */
+    TJSAMP_440,
+    /**
+     * 4:1:1 chrominance subsampling.  The JPEG or YUV image will contain one
+     * chrominance component for every 4x1 block of pixels in the source image.
+     * JPEG images compressed with 4:1:1 subsampling will be almost exactly the
+     * same size as those compressed with 4:2:0 subsampling, and in the
+     * aggregate, both subsampling methods produce approximately the same
+     * perceptual quality.  However, 4:1:1 is better able to reproduce sharp
+     * horizontal features.
+     *
+     * @note 4:1:1 subsampling is not fully accelerated in libjpeg-turbo.
+     */
+    TJSAMP_411
 };
 
 /**
@@ -163,93 +162,92 @@ static const int tjMCUHeight[TJ_NUMSAMP] = {8, 8, 16, 8, 16, 8};
 /**
  * Pixel formats
  */
-enum TJPF
-{
-  /**
-   * RGB pixel format.  The red, green, and blue components in the image are
-   * stored in 3-byte pixels in the order R, G, B from lowest to highest byte
-   * address within each pixel.
-   */
-  TJPF_RGB=0,
-  /**
-   * BGR pixel format.  The red, green, and blue components in the image are
-   * stored in 3-byte pixels in the order B, G, R from lowest to highest byte
-   * address within each pixel.
-   */
-  TJPF_BGR,
-  /**
-   * RGBX pixel format.  The red, green, and blue components in the image are
-   * stored in 4-byte pixels in the order R, G, B from lowest to highest byte
-   * address within each pixel.  The X component is ignored when compressing
-   * and undefined when decompressing.
-   */
-  TJPF_RGBX,
-  /**
-   * BGRX pixel format.  The red, green, and blue components in the image are
-   * stored in 4-byte pixels in the order B, G, R from lowest to highest byte
-   * address within each pixel.  The X component is ignored when compressing
-   * and undefined when decompressing.
-   */
-  TJPF_BGRX,
-  /**
-   * XBGR pixel format.  The red, green, and blue components in the image are
-   * stored in 4-byte pixels in the order R, G, B from highest to lowest byte
-   * address within each pixel.  The X component is ignored when compressing
-   * and undefined when decompressing.
-   */
-  TJPF_XBGR,
-  /**
-   * XRGB pixel format.  The red, green, and blue components in the image are
-   * stored in 4-byte pixels in the order B, G, R from highest to lowest byte
-   * address within each pixel.  The X component is ignored when compressing
-   * and undefined when decompressing.
-   */
-  TJPF_XRGB,
-  /**
-   * Grayscale pixel format.  Each 1-byte pixel represents a luminance
-   * (brightness) level from 0 to 255.
-   */
-  TJPF_GRAY,
-  /**
-   * RGBA pixel format.  This is the same as @ref TJPF_RGBX, except that when
-   * decompressing, the X component is guaranteed to be 0xFF, which can be
-   * interpreted as an opaque alpha channel.
-   */
-  TJPF_RGBA,
-  /**
-   * BGRA pixel format.  This is the same as @ref TJPF_BGRX, except that when
-   * decompressing, the X component is guaranteed to be 0xFF, which can be
-   * interpreted as an opaque alpha channel.
-   */
-  TJPF_BGRA,
-  /**
-   * ABGR pixel format.  This is the same as @ref TJPF_XBGR, except that when
-   * decompressing, the X component is guaranteed to be 0xFF, which can be
-   * interpreted as an opaque alpha channel.
-   */
-  TJPF_ABGR,
-  /**
-   * ARGB pixel format.  This is the same as @ref TJPF_XRGB, except that when
-   * decompressing, the X component is guaranteed to be 0xFF, which can be
-   * interpreted as an opaque alpha channel.
-   */
-  TJPF_ARGB,
-  /**
-   * CMYK pixel format.  Unlike RGB, which is an additive color model used
-   * primarily for display, CMYK (Cyan/Magenta/Yellow/Key) is a subtractive
-   * color model used primarily for printing.  In the CMYK color model, the
-   * value of each color component typically corresponds to an amount of cyan,
-   * magenta, yellow, or black ink that is applied to a white background.  In
-   * order to convert between CMYK and RGB, it is necessary to use a color
-   * management system (CMS.)  A CMS will attempt to map colors within the
-   * printer's gamut to perceptually similar colors in the display's gamut and
-   * vice versa, but the mapping is typically not 1:1 or reversible, nor can it
-   * be defined with a simple formula.  Thus, such a conversion is out of scope
-   * for a codec library.  However, the TurboJPEG API allows for compressing
-   * CMYK pixels into a YCCK JPEG image (see #TJCS_YCCK) and decompressing YCCK
-   * JPEG images into CMYK pixels.
-   */
-  TJPF_CMYK
+enum TJPF {
+    /**
+     * RGB pixel format.  The red, green, and blue components in the image are
+     * stored in 3-byte pixels in the order R, G, B from lowest to highest byte
+     * address within each pixel.
+     */
+    TJPF_RGB = 0,
+    /**
+     * BGR pixel format.  The red, green, and blue components in the image are
+     * stored in 3-byte pixels in the order B, G, R from lowest to highest byte
+     * address within each pixel.
+     */
+    TJPF_BGR,
+    /**
+     * RGBX pixel format.  The red, green, and blue components in the image are
+     * stored in 4-byte pixels in the order R, G, B from lowest to highest byte
+     * address within each pixel.  The X component is ignored when compressing
+     * and undefined when decompressing.
+     */
+    TJPF_RGBX,
+    /**
+     * BGRX pixel format.  The red, green, and blue components in the image are
+     * stored in 4-byte pixels in the order B, G, R from lowest to highest byte
+     * address within each pixel.  The X component is ignored when compressing
+     * and undefined when decompressing.
+     */
+    TJPF_BGRX,
+    /**
+     * XBGR pixel format.  The red, green, and blue components in the image are
+     * stored in 4-byte pixels in the order R, G, B from highest to lowest byte
+     * address within each pixel.  The X component is ignored when compressing
+     * and undefined when decompressing.
+     */
+    TJPF_XBGR,
+    /**
+     * XRGB pixel format.  The red, green, and blue components in the image are
+     * stored in 4-byte pixels in the order B, G, R from highest to lowest byte
+     * address within each pixel.  The X component is ignored when compressing
+     * and undefined when decompressing.
+     */
+    TJPF_XRGB,
+    /**
+     * Grayscale pixel format.  Each 1-byte pixel represents a luminance
+     * (brightness) level from 0 to 255.
+     */
+    TJPF_GRAY,
+    /**
+     * RGBA pixel format.  This is the same as @ref TJPF_RGBX, except that when
+     * decompressing, the X component is guaranteed to be 0xFF, which can be
+     * interpreted as an opaque alpha channel.
+     */
+    TJPF_RGBA,
+    /**
+     * BGRA pixel format.  This is the same as @ref TJPF_BGRX, except that when
+     * decompressing, the X component is guaranteed to be 0xFF, which can be
+     * interpreted as an opaque alpha channel.
+     */
+    TJPF_BGRA,
+    /**
+     * ABGR pixel format.  This is the same as @ref TJPF_XBGR, except that when
+     * decompressing, the X component is guaranteed to be 0xFF, which can be
+     * interpreted as an opaque alpha channel.
+     */
+    TJPF_ABGR,
+    /**
+     * ARGB pixel format.  This is the same as @ref TJPF_XRGB, except that when
+     * decompressing, the X component is guaranteed to be 0xFF, which can be
+     * interpreted as an opaque alpha channel.
+     */
+    TJPF_ARGB,
+    /**
+     * CMYK pixel format.  Unlike RGB, which is an additive color model used
+     * primarily for display, CMYK (Cyan/Magenta/Yellow/Key) is a subtractive
+     * color model used primarily for printing.  In the CMYK color model, the
+     * value of each color component typically corresponds to an amount of cyan,
+     * magenta, yellow, or black ink that is applied to a white background.  In
+     * order to convert between CMYK and RGB, it is necessary to use a color
+     * management system (CMS.)  A CMS will attempt to map colors within the
+     * printer's gamut to perceptually similar colors in the display's gamut and
+     * vice versa, but the mapping is typically not 1:1 or reversible, nor can it
+     * be defined with a simple formula.  Thus, such a conversion is out of scope
+     * for a codec library.  However, the TurboJPEG API allows for compressing
+     * CMYK pixels into a YCCK JPEG image (see #TJCS_YCCK) and decompressing YCCK
+     * JPEG images into CMYK pixels.
+     */
+    TJPF_CMYK
 };
 
 
@@ -290,57 +288,56 @@ static const int tjPixelSize[TJ_NUMPF] = {3, 3, 4, 4, 4, 4, 1, 4, 4, 4, 4, 4};
 /**
  * JPEG colorspaces
  */
-enum TJCS
-{
-  /**
-   * RGB colorspace.  When compressing the JPEG image, the R, G, and B
-   * components in the source image are reordered into image planes, but no
-   * colorspace conversion or subsampling is performed.  RGB JPEG images can be
-   * decompressed to any of the extended RGB pixel formats or grayscale, but
-   * they cannot be decompressed to YUV images.
-   */
-  TJCS_RGB=0,
-  /**
-   * YCbCr colorspace.  YCbCr is not an absolute colorspace but rather a
-   * mathematical transformation of RGB designed solely for storage and
-   * transmission.  YCbCr images must be converted to RGB before they can
-   * actually be displayed.  In the YCbCr colorspace, the Y (luminance)
-   * component represents the black & white portion of the original image, and
-   * the Cb and Cr (chrominance) components represent the color portion of the
-   * original image.  Originally, the analog equivalent of this transformation
-   * allowed the same signal to drive both black & white and color televisions,
-   * but JPEG images use YCbCr primarily because it allows the color data to be
-   * optionally subsampled for the purposes of reducing bandwidth or disk
-   * space.  YCbCr is the most common JPEG colorspace, and YCbCr JPEG images
-   * can be compressed from and decompressed to any of the extended RGB pixel
-   * formats or grayscale, or they can be decompressed to YUV planar images.
-   */
-  TJCS_YCbCr,
-  /**
-   * Grayscale colorspace.  The JPEG image retains only the luminance data (Y
-   * component), and any color data from the source image is discarded.
-   * Grayscale JPEG images can be compressed from and decompressed to any of
-   * the extended RGB pixel formats or grayscale, or they can be decompressed
-   * to YUV planar images.
-   */
-  TJCS_GRAY,
-  /**
-   * CMYK colorspace.  When compressing the JPEG image, the C, M, Y, and K
-   * components in the source image are reordered into image planes, but no
-   * colorspace conversion or subsampling is performed.  CMYK JPEG images can
-   * only be decompressed to CMYK pixels.
-   */
-  TJCS_CMYK,
-  /**
-   * YCCK colorspace.  YCCK (AKA "YCbCrK") is not an absolute colorspace but
-   * rather a mathematical transformation of CMYK designed solely for storage
-   * and transmission.  It is to CMYK as YCbCr is to RGB.  CMYK pixels can be
-   * reversibly transformed into YCCK, and as with YCbCr, the chrominance
-   * components in the YCCK pixels can be subsampled without incurring major
-   * perceptual loss.  YCCK JPEG images can only be compressed from and
-   * decompressed to CMYK pixels.
-   */
-  TJCS_YCCK
+enum TJCS {
+    /**
+     * RGB colorspace.  When compressing the JPEG image, the R, G, and B
+     * components in the source image are reordered into image planes, but no
+     * colorspace conversion or subsampling is performed.  RGB JPEG images can be
+     * decompressed to any of the extended RGB pixel formats or grayscale, but
+     * they cannot be decompressed to YUV images.
+     */
+    TJCS_RGB = 0,
+    /**
+     * YCbCr colorspace.  YCbCr is not an absolute colorspace but rather a
+     * mathematical transformation of RGB designed solely for storage and
+     * transmission.  YCbCr images must be converted to RGB before they can
+     * actually be displayed.  In the YCbCr colorspace, the Y (luminance)
+     * component represents the black & white portion of the original image, and
+     * the Cb and Cr (chrominance) components represent the color portion of the
+     * original image.  Originally, the analog equivalent of this transformation
+     * allowed the same signal to drive both black & white and color televisions,
+     * but JPEG images use YCbCr primarily because it allows the color data to be
+     * optionally subsampled for the purposes of reducing bandwidth or disk
+     * space.  YCbCr is the most common JPEG colorspace, and YCbCr JPEG images
+     * can be compressed from and decompressed to any of the extended RGB pixel
+     * formats or grayscale, or they can be decompressed to YUV planar images.
+     */
+    TJCS_YCbCr,
+    /**
+     * Grayscale colorspace.  The JPEG image retains only the luminance data (Y
+     * component), and any color data from the source image is discarded.
+     * Grayscale JPEG images can be compressed from and decompressed to any of
+     * the extended RGB pixel formats or grayscale, or they can be decompressed
+     * to YUV planar images.
+     */
+    TJCS_GRAY,
+    /**
+     * CMYK colorspace.  When compressing the JPEG image, the C, M, Y, and K
+     * components in the source image are reordered into image planes, but no
+     * colorspace conversion or subsampling is performed.  CMYK JPEG images can
+     * only be decompressed to CMYK pixels.
+     */
+    TJCS_CMYK,
+    /**
+     * YCCK colorspace.  YCCK (AKA "YCbCrK") is not an absolute colorspace but
+     * rather a mathematical transformation of CMYK designed solely for storage
+     * and transmission.  It is to CMYK as YCbCr is to RGB.  CMYK pixels can be
+     * reversibly transformed into YCCK, and as with YCbCr, the chrominance
+     * components in the YCCK pixels can be subsampled without incurring major
+     * perceptual loss.  YCCK JPEG images can only be compressed from and
+     * decompressed to CMYK pixels.
+     */
+    TJCS_YCCK
 };
 
 
@@ -393,50 +390,49 @@ enum TJCS
 /**
  * Transform operations for #tjTransform()
  */
-enum TJXOP
-{
-  /**
-   * Do not transform the position of the image pixels
-   */
-  TJXOP_NONE=0,
-  /**
-   * Flip (mirror) image horizontally.  This transform is imperfect if there
-   * are any partial MCU blocks on the right edge (see #TJXOPT_PERFECT.)
-   */
-  TJXOP_HFLIP,
-  /**
-   * Flip (mirror) image vertically.  This transform is imperfect if there are
-   * any partial MCU blocks on the bottom edge (see #TJXOPT_PERFECT.)
-   */
-  TJXOP_VFLIP,
-  /**
-   * Transpose image (flip/mirror along upper left to lower right axis.)  This
-   * transform is always perfect.
-   */
-  TJXOP_TRANSPOSE,
-  /**
-   * Transverse transpose image (flip/mirror along upper right to lower left
-   * axis.)  This transform is imperfect if there are any partial MCU blocks in
-   * the image (see #TJXOPT_PERFECT.)
-   */
-  TJXOP_TRANSVERSE,
-  /**
-   * Rotate image clockwise by 90 degrees.  This transform is imperfect if
-   * there are any partial MCU blocks on the bottom edge (see
-   * #TJXOPT_PERFECT.)
-   */
-  TJXOP_ROT90,
-  /**
-   * Rotate image 180 degrees.  This transform is imperfect if there are any
-   * partial MCU blocks in the image (see #TJXOPT_PERFECT.)
-   */
-  TJXOP_ROT180,
-  /**
-   * Rotate image counter-clockwise by 90 degrees.  This transform is imperfect
-   * if there are any partial MCU blocks on the right edge (see
-   * #TJXOPT_PERFECT.)
-   */
-  TJXOP_ROT270
+enum TJXOP {
+    /**
+     * Do not transform the position of the image pixels
+     */
+    TJXOP_NONE = 0,
+    /**
+     * Flip (mirror) image horizontally.  This transform is imperfect if there
+     * are any partial MCU blocks on the right edge (see #TJXOPT_PERFECT.)
+     */
+    TJXOP_HFLIP,
+    /**
+     * Flip (mirror) image vertically.  This transform is imperfect if there are
+     * any partial MCU blocks on the bottom edge (see #TJXOPT_PERFECT.)
+     */
+    TJXOP_VFLIP,
+    /**
+     * Transpose image (flip/mirror along upper left to lower right axis.)  This
+     * transform is always perfect.
+     */
+    TJXOP_TRANSPOSE,
+    /**
+     * Transverse transpose image (flip/mirror along upper right to lower left
+     * axis.)  This transform is imperfect if there are any partial MCU blocks in
+     * the image (see #TJXOPT_PERFECT.)
+     */
+    TJXOP_TRANSVERSE,
+    /**
+     * Rotate image clockwise by 90 degrees.  This transform is imperfect if
+     * there are any partial MCU blocks on the bottom edge (see
+     * #TJXOPT_PERFECT.)
+     */
+    TJXOP_ROT90,
+    /**
+     * Rotate image 180 degrees.  This transform is imperfect if there are any
+     * partial MCU blocks in the image (see #TJXOPT_PERFECT.)
+     */
+    TJXOP_ROT180,
+    /**
+     * Rotate image counter-clockwise by 90 degrees.  This transform is imperfect
+     * if there are any partial MCU blocks on the right edge (see
+     * #TJXOPT_PERFECT.)
+     */
+    TJXOP_ROT270
 };
 
 
@@ -480,103 +476,100 @@ enum TJXOP
 /**
  * Scaling factor
  */
-typedef struct
-{
-  /**
-   * Numerator
-   */
-  int num;
-  /**
-   * Denominator
-   */
-  int denom;
+typedef struct {
+    /**
+     * Numerator
+     */
+    int num;
+    /**
+     * Denominator
+     */
+    int denom;
 } tjscalingfactor;
 
 /**
  * Cropping region
  */
-typedef struct
-{
-  /**
-   * The left boundary of the cropping region.  This must be evenly divisible
-   * by the MCU block width (see #tjMCUWidth.)
-   */
-  int x;
-  /**
-   * The upper boundary of the cropping region.  This must be evenly divisible
-   * by the MCU block height (see #tjMCUHeight.)
-   */
-  int y;
-  /**
-   * The width of the cropping region. Setting this to 0 is the equivalent of
-   * setting it to the width of the source JPEG image - x.
-   */
-  int w;
-  /**
-   * The height of the cropping region. Setting this to 0 is the equivalent of
-   * setting it to the height of the source JPEG image - y.
-   */
-  int h;
+typedef struct {
+    /**
+     * The left boundary of the cropping region.  This must be evenly divisible
+     * by the MCU block width (see #tjMCUWidth.)
+     */
+    int x;
+    /**
+     * The upper boundary of the cropping region.  This must be evenly divisible
+     * by the MCU block height (see #tjMCUHeight.)
+     */
+    int y;
+    /**
+     * The width of the cropping region. Setting this to 0 is the equivalent of
+     * setting it to the width of the source JPEG image - x.
+     */
+    int w;
+    /**
+     * The height of the cropping region. Setting this to 0 is the equivalent of
+     * setting it to the height of the source JPEG image - y.
+     */
+    int h;
 } tjregion;
 
 /**
  * Lossless transform
  */
-typedef struct tjtransform
-{
-  /**
-   * Cropping region
-   */
-  tjregion r;
-  /**
-   * One of the @ref TJXOP "transform operations"
-   */
-  int op;
-  /**
-   * The bitwise OR of one of more of the @ref TJXOPT_CROP "transform options"
-   */
-  int options;
-  /**
-   * Arbitrary data that can be accessed within the body of the callback
-   * function
-   */
-  void *data;
-  /**
-   * A callback function that can be used to modify the DCT coefficients
-   * after they are losslessly transformed but before they are transcoded to a
-   * new JPEG image.  This allows for custom filters or other transformations
-   * to be applied in the frequency domain.
-   *
-   * @param coeffs pointer to an array of transformed DCT coefficients.  (NOTE:
-   * this pointer is not guaranteed to be valid once the callback returns, so
-   * applications wishing to hand off the DCT coefficients to another function
-   * or library should make a copy of them within the body of the callback.)
-   *
-   * @param arrayRegion #tjregion structure containing the width and height of
-   * the array pointed to by <tt>coeffs</tt> as well as its offset relative to
-   * the component plane.  TurboJPEG implementations may choose to split each
-   * component plane into multiple DCT coefficient arrays and call the callback
-   * function once for each array.
-   *
-   * @param planeRegion #tjregion structure containing the width and height of
-   * the component plane to which <tt>coeffs</tt> belongs
-   *
-   * @param componentID ID number of the component plane to which
-   * <tt>coeffs</tt> belongs (Y, Cb, and Cr have, respectively, ID's of 0, 1,
-   * and 2 in typical JPEG images.)
-   *
-   * @param transformID ID number of the transformed image to which
-   * <tt>coeffs</tt> belongs.  This is the same as the index of the transform
-   * in the <tt>transforms</tt> array that was passed to #tjTransform().
-   *
-   * @param transform a pointer to a #tjtransform structure that specifies the
-   * parameters and/or cropping region for this transform
-   *
-   * @return 0 if the callback was successful, or -1 if an error occurred.
-   */
-  int (*customFilter)(short *coeffs, tjregion arrayRegion,
-    tjregion planeRegion, int componentIndex, int transformIndex,
-    struct tjtransform *transform);
+typedef struct tjtransform {
+    /**
+     * Cropping region
+     */
+    tjregion r;
+    /**
+     * One of the @ref TJXOP "transform operations"
+     */
+    int op;
+    /**
+     * The bitwise OR of one of more of the @ref TJXOPT_CROP "transform options"
+     */
+    int options;
+    /**
+     * Arbitrary data that can be accessed within the body of the callback
+     * function
+     */
+    void *data;
+    /**
+     * A callback function that can be used to modify the DCT coefficients
+     * after they are losslessly transformed but before they are transcoded to a
+     * new JPEG image.  This allows for custom filters or other transformations
+     * to be applied in the frequency domain.
+     *
+     * @param coeffs pointer to an array of transformed DCT coefficients.  (NOTE:
+     * this pointer is not guaranteed to be valid once the callback returns, so
+     * applications wishing to hand off the DCT coefficients to another function
+     * or library should make a copy of them within the body of the callback.)
+     *
+     * @param arrayRegion #tjregion structure containing the width and height of
+     * the array pointed to by <tt>coeffs</tt> as well as its offset relative to
+     * the component plane.  TurboJPEG implementations may choose to split each
+     * component plane into multiple DCT coefficient arrays and call the callback
+     * function once for each array.
+     *
+     * @param planeRegion #tjregion structure containing the width and height of
+     * the component plane to which <tt>coeffs</tt> belongs
+     *
+     * @param componentID ID number of the component plane to which
+     * <tt>coeffs</tt> belongs (Y, Cb, and Cr have, respectively, ID's of 0, 1,
+     * and 2 in typical JPEG images.)
+     *
+     * @param transformID ID number of the transformed image to which
+     * <tt>coeffs</tt> belongs.  This is the same as the index of the transform
+     * in the <tt>transforms</tt> array that was passed to #tjTransform().
+     *
+     * @param transform a pointer to a #tjtransform structure that specifies the
+     * parameters and/or cropping region for this transform
+     *
+     * @return 0 if the callback was successful, or -1 if an error occurred.
+     */
+    int (*customFilter)(short *coeffs, tjregion arrayRegion,
+                        tjregion planeRegion, int componentIndex, int transformIndex,
+                        struct tjtransform *transform);
 } tjtransform;
 
 /**
@@ -673,8 +666,8 @@ DLLEXPORT tjhandle DLLCALL tjInitCompress(void);
  * @return 0 if successful, or -1 if an error occurred (see #tjGetErrorStr().)
 */
 DLLEXPORT int DLLCALL tjCompress2(tjhandle handle, unsigned char *srcBuf,
-  int width, int pitch, int height, int pixelFormat, unsigned char **jpegBuf,
-  unsigned long *jpegSize, int jpegSubsamp, int jpegQual, int flags);
+                                  int width, int pitch, int height, int pixelFormat, unsigned char **jpegBuf,
+                                  unsigned long *jpegSize, int jpegSubsamp, int jpegQual, int flags);
 
 
 /**
@@ -737,8 +730,8 @@ DLLEXPORT int DLLCALL tjCompress2(tjhandle handle, unsigned char *srcBuf,
  * @return 0 if successful, or -1 if an error occurred (see #tjGetErrorStr().)
 */
 DLLEXPORT int DLLCALL tjCompressFromYUV(tjhandle handle, unsigned char *srcBuf,
-  int width, int pad, int height, int subsamp, unsigned char **jpegBuf,
-  unsigned long *jpegSize, int jpegQual, int flags);
+                                        int width, int pad, int height, int subsamp, unsigned char **jpegBuf,
+                                        unsigned long *jpegSize, int jpegQual, int flags);
 
 
 /**
@@ -762,7 +755,7 @@ DLLEXPORT int DLLCALL tjCompressFromYUV(tjhandle handle, unsigned char *srcBuf,
  * line in the corresponding plane of the YUV source image.  Setting the stride
  * for any plane to 0 is the same as setting it to the plane width (see
  * @ref YUVnotes "YUV Image Format Notes".)  If <tt>strides</tt> is NULL, then
- * the strides for all planes will be set to their respective plane widths. 
+ * the strides for all planes will be set to their respective plane widths.
  * You can adjust the strides in order to specify an arbitrary amount of line
  * padding in each plane or to create a JPEG image from a subregion of a larger
  * YUV planar image.
@@ -807,8 +800,8 @@ DLLEXPORT int DLLCALL tjCompressFromYUV(tjhandle handle, unsigned char *srcBuf,
  * @return 0 if successful, or -1 if an error occurred (see #tjGetErrorStr().)
 */
 DLLEXPORT int DLLCALL tjCompressFromYUVPlanes(tjhandle handle,
-	unsigned char **srcPlanes, int width, int *strides, int height, int subsamp,
-	unsigned char **jpegBuf, unsigned long *jpegSize, int jpegQual, int flags);
+                                              unsigned char **srcPlanes, int width, int *strides, int height, int subsamp,
+                                              unsigned char **jpegBuf, unsigned long *jpegSize, int jpegQual, int flags);
 
 
 /**
@@ -834,7 +827,7 @@ DLLEXPORT int DLLCALL tjCompressFromYUVPlanes(tjhandle handle,
  * image, or -1 if the arguments are out of bounds.
  */
 DLLEXPORT unsigned long DLLCALL tjBufSize(int width, int height,
-  int jpegSubsamp);
+                                          int jpegSubsamp);
 
 
 /**
@@ -855,7 +848,7 @@ DLLEXPORT unsigned long DLLCALL tjBufSize(int width, int height,
  * -1 if the arguments are out of bounds.
  */
 DLLEXPORT unsigned long DLLCALL tjBufSizeYUV2(int width, int pad, int height,
-  int subsamp);
+                                              int subsamp);
 
 
 /**
@@ -880,7 +873,7 @@ DLLEXPORT unsigned long DLLCALL tjBufSizeYUV2(int width, int pad, int height,
  * plane, or -1 if the arguments are out of bounds.
  */
 DLLEXPORT unsigned long DLLCALL tjPlaneSizeYUV(int componentID, int width,
-	int stride, int height, int subsamp);
+                                               int stride, int height, int subsamp);
 
 
 /**
@@ -921,7 +914,7 @@ DLLEXPORT int tjPlaneHeight(int componentID, int height, int subsamp);
  * Encode an RGB or grayscale image into a YUV planar image.  This function
  * uses the accelerated color conversion routines in the underlying
  * codec but does not execute any of the other steps in the JPEG compression
- * process.  
+ * process.
  *
  * @param handle a handle to a TurboJPEG compressor or transformer instance
  *
@@ -966,8 +959,8 @@ DLLEXPORT int tjPlaneHeight(int componentID, int height, int subsamp);
  * @return 0 if successful, or -1 if an error occurred (see #tjGetErrorStr().)
 */
 DLLEXPORT int DLLCALL tjEncodeYUV3(tjhandle handle,
-  unsigned char *srcBuf, int width, int pitch, int height, int pixelFormat,
-  unsigned char *dstBuf, int pad, int subsamp, int flags);
+                                   unsigned char *srcBuf, int width, int pitch, int height, int pixelFormat,
+                                   unsigned char *dstBuf, int pad, int subsamp, int flags);
 
 
 /**
@@ -1024,8 +1017,8 @@ DLLEXPORT int DLLCALL tjEncodeYUV3(tjhandle handle,
  * @return 0 if successful, or -1 if an error occurred (see #tjGetErrorStr().)
 */
 DLLEXPORT int DLLCALL tjEncodeYUVPlanes(tjhandle handle,
-  unsigned char *srcBuf, int width, int pitch, int height, int pixelFormat,
-  unsigned char **dstPlanes, int *strides, int subsamp, int flags);
+                                        unsigned char *srcBuf, int width, int pitch, int height, int pixelFormat,
+                                        unsigned char **dstPlanes, int *strides, int subsamp, int flags);
 
 
 /**
@@ -1063,8 +1056,8 @@ DLLEXPORT tjhandle DLLCALL tjInitDecompress(void);
  * @return 0 if successful, or -1 if an error occurred (see #tjGetErrorStr().)
 */
 DLLEXPORT int DLLCALL tjDecompressHeader3(tjhandle handle,
-  unsigned char *jpegBuf, unsigned long jpegSize, int *width, int *height,
-  int *jpegSubsamp, int *jpegColorspace);
+                                          unsigned char *jpegBuf, unsigned long jpegSize, int *width, int *height,
+                                          int *jpegSubsamp, int *jpegColorspace);
 
 
 /**
@@ -1130,8 +1123,8 @@ DLLEXPORT tjscalingfactor* DLLCALL tjGetScalingFactors(int *numscalingfactors);
  * @return 0 if successful, or -1 if an error occurred (see #tjGetErrorStr().)
  */
 DLLEXPORT int DLLCALL tjDecompress2(tjhandle handle,
-  unsigned char *jpegBuf, unsigned long jpegSize, unsigned char *dstBuf,
-  int width, int pitch, int height, int pixelFormat, int flags);
+                                    unsigned char *jpegBuf, unsigned long jpegSize, unsigned char *dstBuf,
+                                    int width, int pitch, int height, int pixelFormat, int flags);
 
 
 /**
@@ -1180,8 +1173,8 @@ DLLEXPORT int DLLCALL tjDecompress2(tjhandle handle,
  * @return 0 if successful, or -1 if an error occurred (see #tjGetErrorStr().)
  */
 DLLEXPORT int DLLCALL tjDecompressToYUV2(tjhandle handle,
-  unsigned char *jpegBuf, unsigned long jpegSize, unsigned char *dstBuf,
-  int width, int pad, int height, int flags);
+                                         unsigned char *jpegBuf, unsigned long jpegSize, unsigned char *dstBuf,
+                                         int width, int pad, int height, int flags);
 
 
 /**
@@ -1236,8 +1229,8 @@ DLLEXPORT int DLLCALL tjDecompressToYUV2(tjhandle handle,
  * @return 0 if successful, or -1 if an error occurred (see #tjGetErrorStr().)
  */
 DLLEXPORT int DLLCALL tjDecompressToYUVPlanes(tjhandle handle,
-  unsigned char *jpegBuf, unsigned long jpegSize, unsigned char **dstPlanes,
-  int width, int *strides, int height, int flags);
+                                              unsigned char *jpegBuf, unsigned long jpegSize, unsigned char **dstPlanes,
+                                              int width, int *strides, int height, int flags);
 
 
 /**
@@ -1288,8 +1281,8 @@ DLLEXPORT int DLLCALL tjDecompressToYUVPlanes(tjhandle handle,
  * @return 0 if successful, or -1 if an error occurred (see #tjGetErrorStr().)
  */
 DLLEXPORT int DLLCALL tjDecodeYUV(tjhandle handle, unsigned char *srcBuf,
-	int pad, int subsamp, unsigned char *dstBuf, int width, int pitch,
-	int height, int pixelFormat, int flags);
+                                  int pad, int subsamp, unsigned char *dstBuf, int width, int pitch,
+                                  int height, int pixelFormat, int flags);
 
 
 /**
@@ -1345,8 +1338,8 @@ DLLEXPORT int DLLCALL tjDecodeYUV(tjhandle handle, unsigned char *srcBuf,
  * @return 0 if successful, or -1 if an error occurred (see #tjGetErrorStr().)
  */
 DLLEXPORT int DLLCALL tjDecodeYUVPlanes(tjhandle handle,
-	unsigned char **srcPlanes, int *strides, int subsamp, unsigned char *dstBuf,
-	int width, int pitch, int height, int pixelFormat, int flags);
+                                        unsigned char **srcPlanes, int *strides, int subsamp, unsigned char *dstBuf,
+                                        int width, int pitch, int height, int pixelFormat, int flags);
 
 
 /**
@@ -1414,8 +1407,8 @@ DLLEXPORT tjhandle DLLCALL tjInitTransform(void);
  * @return 0 if successful, or -1 if an error occurred (see #tjGetErrorStr().)
  */
 DLLEXPORT int DLLCALL tjTransform(tjhandle handle, unsigned char *jpegBuf,
-  unsigned long jpegSize, int n, unsigned char **dstBufs,
-  unsigned long *dstSizes, tjtransform *transforms, int flags);
+                                  unsigned long jpegSize, int n, unsigned char **dstBufs,
+                                  unsigned long *dstSizes, tjtransform *transforms, int flags);
 
 
 /**
@@ -1494,37 +1487,37 @@ DLLEXPORT char* DLLCALL tjGetErrorStr(void);
 DLLEXPORT unsigned long DLLCALL TJBUFSIZE(int width, int height);
 
 DLLEXPORT unsigned long DLLCALL TJBUFSIZEYUV(int width, int height,
-  int jpegSubsamp);
+                                             int jpegSubsamp);
 
 DLLEXPORT unsigned long DLLCALL tjBufSizeYUV(int width, int height,
-  int subsamp);
+                                             int subsamp);
 
 DLLEXPORT int DLLCALL tjCompress(tjhandle handle, unsigned char *srcBuf,
-  int width, int pitch, int height, int pixelSize, unsigned char *dstBuf,
-  unsigned long *compressedSize, int jpegSubsamp, int jpegQual, int flags);
+                                 int width, int pitch, int height, int pixelSize, unsigned char *dstBuf,
+                                 unsigned long *compressedSize, int jpegSubsamp, int jpegQual, int flags);
 
 DLLEXPORT int DLLCALL tjEncodeYUV(tjhandle handle,
-  unsigned char *srcBuf, int width, int pitch, int height, int pixelSize,
-  unsigned char *dstBuf, int subsamp, int flags);
+                                  unsigned char *srcBuf, int width, int pitch, int height, int pixelSize,
+                                  unsigned char *dstBuf, int subsamp, int flags);
 
 DLLEXPORT int DLLCALL tjEncodeYUV2(tjhandle handle,
-  unsigned char *srcBuf, int width, int pitch, int height, int pixelFormat,
-  unsigned char *dstBuf, int subsamp, int flags);
+                                   unsigned char *srcBuf, int width, int pitch, int height, int pixelFormat,
+                                   unsigned char *dstBuf, int subsamp, int flags);
 
 DLLEXPORT int DLLCALL tjDecompressHeader(tjhandle handle,
-  unsigned char *jpegBuf, unsigned long jpegSize, int *width, int *height);
+                                         unsigned char *jpegBuf, unsigned long jpegSize, int *width, int *height);
 
 DLLEXPORT int DLLCALL tjDecompressHeader2(tjhandle handle,
-  unsigned char *jpegBuf, unsigned long jpegSize, int *width, int *height,
-  int *jpegSubsamp);
+                                          unsigned char *jpegBuf, unsigned long jpegSize, int *width, int *height,
+                                          int *jpegSubsamp);
 
 DLLEXPORT int DLLCALL tjDecompress(tjhandle handle,
-  unsigned char *jpegBuf, unsigned long jpegSize, unsigned char *dstBuf,
-  int width, int pitch, int height, int pixelSize, int flags);
+                                   unsigned char *jpegBuf, unsigned long jpegSize, unsigned char *dstBuf,
+                                   int width, int pitch, int height, int pixelSize, int flags);
 
 DLLEXPORT int DLLCALL tjDecompressToYUV(tjhandle handle,
-  unsigned char *jpegBuf, unsigned long jpegSize, unsigned char *dstBuf,
-  int flags);
+                                        unsigned char *jpegBuf, unsigned long jpegSize, unsigned char *dstBuf,
+                                        int flags);
 
 
 /**
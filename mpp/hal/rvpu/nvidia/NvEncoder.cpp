@@ -13,27 +13,29 @@
 
 #ifndef _WIN32
 #include <cstring>
-static inline bool operator==(const GUID &guid1, const GUID &guid2) {
+static inline bool operator==(const GUID &guid1, const GUID &guid2)
+{
     return !memcmp(&guid1, &guid2, sizeof(GUID));
 }
 
-static inline bool operator!=(const GUID &guid1, const GUID &guid2) {
+static inline bool operator!=(const GUID &guid1, const GUID &guid2)
+{
     return !(guid1 == guid2);
 }
 #endif
 
 NvEncoder::NvEncoder(NV_ENC_DEVICE_TYPE eDeviceType, void *pDevice,
-                     uint32_t nWidth, uint32_t nHeight, 
+                     uint32_t nWidth, uint32_t nHeight,
                      NV_ENC_BUFFER_FORMAT eBufferFormat,
                      uint32_t nExtraOutputDelay,
                      bool bMotionEstimationOnly, bool bOutputInVideoMemory) :
-    m_bMotionEstimationOnly(bMotionEstimationOnly), 
+    m_bMotionEstimationOnly(bMotionEstimationOnly),
     m_bOutputInVideoMemory(bOutputInVideoMemory),
     m_hEncoder(nullptr),
     m_nWidth(nWidth),
     m_nHeight(nHeight),
-    m_eBufferFormat(eBufferFormat), 
-    m_pDevice(pDevice), 
+    m_eBufferFormat(eBufferFormat),
+    m_pDevice(pDevice),
     m_eDeviceType(eDeviceType),
     m_nExtraOutputDelay(nExtraOutputDelay),
     m_nMaxEncodeWidth(nWidth),
@@ -41,8 +43,7 @@ NvEncoder::NvEncoder(NV_ENC_DEVICE_TYPE eDeviceType, void *pDevice,
 {
     LoadNvEncApi();
 
-    if (!m_nvenc.nvEncOpenEncodeSession) 
-    {
+    if (!m_nvenc.nvEncOpenEncodeSession) {
         m_nEncoderBuffer = 0;
         NVENC_THROW_ERROR("EncodeAPI not found", NV_ENC_ERR_NO_ENCODE_DEVICE);
     }
@@ -62,8 +63,7 @@ void NvEncoder::LoadNvEncApi()
     uint32_t version = 0;
     uint32_t currentVersion = (NVENCAPI_MAJOR_VERSION << 4) | NVENCAPI_MINOR_VERSION;
     NVENC_API_CALL(NvEncodeAPIGetMaxSupportedVersion(&version));
-    if (currentVersion > version)
-    {
+    if (currentVersion > version) {
         NVENC_THROW_ERROR("Current Driver Version does not support this NvEncodeAPI version, please upgrade driver", NV_ENC_ERR_INVALID_VERSION);
     }
 
@@ -79,14 +79,12 @@ NvEncoder::~NvEncoder()
 
 void NvEncoder::CreateDefaultEncoderParams(NV_ENC_INITIALIZE_PARAMS* pIntializeParams, GUID codecGuid, GUID presetGuid)
 {
-    if (!m_hEncoder)
-    {
+    if (!m_hEncoder) {
         NVENC_THROW_ERROR("Encoder Initialization failed", NV_ENC_ERR_NO_ENCODE_DEVICE);
         return;
     }
 
-    if (pIntializeParams == nullptr || pIntializeParams->encodeConfig == nullptr)
-    {
+    if (pIntializeParams == nullptr || pIntializeParams->encodeConfig == nullptr) {
         NVENC_THROW_ERROR("pInitializeParams and pInitializeParams->encodeConfig can't be NULL", NV_ENC_ERR_INVALID_PTR);
     }
 
@@ -115,8 +113,7 @@ void NvEncoder::CreateDefaultEncoderParams(NV_ENC_INITIALIZE_PARAMS* pIntializeP
     pIntializeParams->enableMEOnlyMode = m_bMotionEstimationOnly;
     pIntializeParams->enableOutputInVidmem = m_bOutputInVideoMemory;
 #if defined(_WIN32)
-    if (!m_bOutputInVideoMemory)
-    {
+    if (!m_bOutputInVideoMemory) {
         pIntializeParams->enableEncodeAsync = GetCapabilityValue(codecGuid, NV_ENC_CAPS_ASYNC_ENCODE_SUPPORT);
     }
 #endif
@@ -130,25 +127,19 @@ void NvEncoder::CreateDefaultEncoderParams(NV_ENC_INITIALIZE_PARAMS* pIntializeP
     pIntializeParams->encodeConfig->rcParams.rateControlMode = NV_ENC_PARAMS_RC_CONSTQP;
 
     if (pIntializeParams->presetGUID != NV_ENC_PRESET_LOSSLESS_DEFAULT_GUID
-        && pIntializeParams->presetGUID != NV_ENC_PRESET_LOSSLESS_HP_GUID)
-    {
+        && pIntializeParams->presetGUID != NV_ENC_PRESET_LOSSLESS_HP_GUID) {
         pIntializeParams->encodeConfig->rcParams.constQP = { 28, 31, 25 };
     }
 
-    if (pIntializeParams->encodeGUID == NV_ENC_CODEC_H264_GUID)
-    {
-        if (m_eBufferFormat == NV_ENC_BUFFER_FORMAT_YUV444 || m_eBufferFormat == NV_ENC_BUFFER_FORMAT_YUV444_10BIT)
-        {
+    if (pIntializeParams->encodeGUID == NV_ENC_CODEC_H264_GUID) {
+        if (m_eBufferFormat == NV_ENC_BUFFER_FORMAT_YUV444 || m_eBufferFormat == NV_ENC_BUFFER_FORMAT_YUV444_10BIT) {
             pIntializeParams->encodeConfig->encodeCodecConfig.h264Config.chromaFormatIDC = 3;
         }
         pIntializeParams->encodeConfig->encodeCodecConfig.h264Config.idrPeriod = pIntializeParams->encodeConfig->gopLength;
-    }
-    else if (pIntializeParams->encodeGUID == NV_ENC_CODEC_HEVC_GUID)
-    {
+    } else if (pIntializeParams->encodeGUID == NV_ENC_CODEC_HEVC_GUID) {
         pIntializeParams->encodeConfig->encodeCodecConfig.hevcConfig.pixelBitDepthMinus8 =
             (m_eBufferFormat == NV_ENC_BUFFER_FORMAT_YUV420_10BIT || m_eBufferFormat == NV_ENC_BUFFER_FORMAT_YUV444_10BIT ) ? 2 : 0;
-        if (m_eBufferFormat == NV_ENC_BUFFER_FORMAT_YUV444 || m_eBufferFormat == NV_ENC_BUFFER_FORMAT_YUV444_10BIT)
-        {
+        if (m_eBufferFormat == NV_ENC_BUFFER_FORMAT_YUV444 || m_eBufferFormat == NV_ENC_BUFFER_FORMAT_YUV444_10BIT) {
             pIntializeParams->encodeConfig->encodeCodecConfig.hevcConfig.chromaFormatIDC = 3;
         }
         pIntializeParams->encodeConfig->encodeCodecConfig.hevcConfig.idrPeriod = pIntializeParams->encodeConfig->gopLength;
@@ -159,55 +150,44 @@ void NvEncoder::CreateDefaultEncoderParams(NV_ENC_INITIALIZE_PARAMS* pIntializeP
 
 void NvEncoder::CreateEncoder(const NV_ENC_INITIALIZE_PARAMS* pEncoderParams)
 {
-    if (!m_hEncoder)
-    {
+    if (!m_hEncoder) {
         NVENC_THROW_ERROR("Encoder Initialization failed", NV_ENC_ERR_NO_ENCODE_DEVICE);
     }
 
-    if (!pEncoderParams)
-    {
+    if (!pEncoderParams) {
         NVENC_THROW_ERROR("Invalid NV_ENC_INITIALIZE_PARAMS ptr", NV_ENC_ERR_INVALID_PTR);
     }
 
-    if (pEncoderParams->encodeWidth == 0 || pEncoderParams->encodeHeight == 0)
-    {
+    if (pEncoderParams->encodeWidth == 0 || pEncoderParams->encodeHeight == 0) {
         NVENC_THROW_ERROR("Invalid encoder width and height", NV_ENC_ERR_INVALID_PARAM);
     }
 
-    if (pEncoderParams->encodeGUID != NV_ENC_CODEC_H264_GUID && pEncoderParams->encodeGUID != NV_ENC_CODEC_HEVC_GUID)
-    {
+    if (pEncoderParams->encodeGUID != NV_ENC_CODEC_H264_GUID && pEncoderParams->encodeGUID != NV_ENC_CODEC_HEVC_GUID) {
         NVENC_THROW_ERROR("Invalid codec guid", NV_ENC_ERR_INVALID_PARAM);
     }
 
-    if (pEncoderParams->encodeGUID == NV_ENC_CODEC_H264_GUID)
-    {
-        if (m_eBufferFormat == NV_ENC_BUFFER_FORMAT_YUV420_10BIT || m_eBufferFormat == NV_ENC_BUFFER_FORMAT_YUV444_10BIT)
-        {
+    if (pEncoderParams->encodeGUID == NV_ENC_CODEC_H264_GUID) {
+        if (m_eBufferFormat == NV_ENC_BUFFER_FORMAT_YUV420_10BIT || m_eBufferFormat == NV_ENC_BUFFER_FORMAT_YUV444_10BIT) {
             NVENC_THROW_ERROR("10-bit format isn't supported by H264 encoder", NV_ENC_ERR_INVALID_PARAM);
         }
     }
 
     // set other necessary params if not set yet
-    if (pEncoderParams->encodeGUID == NV_ENC_CODEC_H264_GUID)
-    {
+    if (pEncoderParams->encodeGUID == NV_ENC_CODEC_H264_GUID) {
         if ((m_eBufferFormat == NV_ENC_BUFFER_FORMAT_YUV444) &&
-            (pEncoderParams->encodeConfig->encodeCodecConfig.h264Config.chromaFormatIDC != 3))
-        {
+            (pEncoderParams->encodeConfig->encodeCodecConfig.h264Config.chromaFormatIDC != 3)) {
             NVENC_THROW_ERROR("Invalid ChromaFormatIDC", NV_ENC_ERR_INVALID_PARAM);
         }
     }
 
-    if (pEncoderParams->encodeGUID == NV_ENC_CODEC_HEVC_GUID)
-    {
+    if (pEncoderParams->encodeGUID == NV_ENC_CODEC_HEVC_GUID) {
         bool yuv10BitFormat = (m_eBufferFormat == NV_ENC_BUFFER_FORMAT_YUV420_10BIT || m_eBufferFormat == NV_ENC_BUFFER_FORMAT_YUV444_10BIT) ? true : false;
-        if (yuv10BitFormat && pEncoderParams->encodeConfig->encodeCodecConfig.hevcConfig.pixelBitDepthMinus8 != 2)
-        {
+        if (yuv10BitFormat && pEncoderParams->encodeConfig->encodeCodecConfig.hevcConfig.pixelBitDepthMinus8 != 2) {
             NVENC_THROW_ERROR("Invalid PixelBitdepth", NV_ENC_ERR_INVALID_PARAM);
         }
 
         if ((m_eBufferFormat == NV_ENC_BUFFER_FORMAT_YUV444 || m_eBufferFormat == NV_ENC_BUFFER_FORMAT_YUV444_10BIT) &&
-            (pEncoderParams->encodeConfig->encodeCodecConfig.hevcConfig.chromaFormatIDC != 3))
-        {
+            (pEncoderParams->encodeConfig->encodeCodecConfig.hevcConfig.chromaFormatIDC != 3)) {
             NVENC_THROW_ERROR("Invalid ChromaFormatIDC", NV_ENC_ERR_INVALID_PARAM);
         }
     }
@@ -215,13 +195,10 @@ void NvEncoder::CreateEncoder(const NV_ENC_INITIALIZE_PARAMS* pEncoderParams)
     memcpy(&m_initializeParams, pEncoderParams, sizeof(m_initializeParams));
     m_initializeParams.version = NV_ENC_INITIALIZE_PARAMS_VER;
 
-    if (pEncoderParams->encodeConfig)
-    {
+    if (pEncoderParams->encodeConfig) {
         memcpy(&m_encodeConfig, pEncoderParams->encodeConfig, sizeof(m_encodeConfig));
         m_encodeConfig.version = NV_ENC_CONFIG_VER;
-    }
-    else
-    {
+    } else {
         NV_ENC_PRESET_CONFIG presetConfig = { NV_ENC_PRESET_CONFIG_VER, { NV_ENC_CONFIG_VER } };
         m_nvenc.nvEncGetEncodePresetConfig(m_hEncoder, pEncoderParams->encodeGUID, NV_ENC_PRESET_DEFAULT_GUID, &presetConfig);
         memcpy(&m_encodeConfig, &presetConfig.presetCfg, sizeof(NV_ENC_CONFIG));
@@ -243,14 +220,12 @@ void NvEncoder::CreateEncoder(const NV_ENC_INITIALIZE_PARAMS* pEncoderParams)
     m_nOutputDelay = m_nEncoderBuffer - 1;
     m_vMappedInputBuffers.resize(m_nEncoderBuffer, nullptr);
 
-    if (!m_bOutputInVideoMemory)
-    {
+    if (!m_bOutputInVideoMemory) {
         m_vpCompletionEvent.resize(m_nEncoderBuffer, nullptr);
     }
 
 #if defined(_WIN32)
-    for (uint32_t i = 0; i < m_vpCompletionEvent.size(); i++) 
-    {
+    for (uint32_t i = 0; i < m_vpCompletionEvent.size(); i++) {
         m_vpCompletionEvent[i] = CreateEvent(NULL, FALSE, FALSE, NULL);
         NV_ENC_EVENT_PARAMS eventParams = { NV_ENC_EVENT_PARAMS_VER };
         eventParams.completionEvent = m_vpCompletionEvent[i];
@@ -258,19 +233,14 @@ void NvEncoder::CreateEncoder(const NV_ENC_INITIALIZE_PARAMS* pEncoderParams)
     }
 #endif
 
-    if (m_bMotionEstimationOnly)
-    {
+    if (m_bMotionEstimationOnly) {
         m_vMappedRefBuffers.resize(m_nEncoderBuffer, nullptr);
 
-        if (!m_bOutputInVideoMemory)
-        {
+        if (!m_bOutputInVideoMemory) {
             InitializeMVOutputBuffer();
         }
-    }
-    else
-    {
-        if (!m_bOutputInVideoMemory)
-        {
+    } else {
+        if (!m_bOutputInVideoMemory) {
             m_vBitstreamOutputBuffer.resize(m_nEncoderBuffer, nullptr);
             InitializeBitstreamBuffer();
         }
@@ -281,8 +251,7 @@ void NvEncoder::CreateEncoder(const NV_ENC_INITIALIZE_PARAMS* pEncoderParams)
 
 void NvEncoder::DestroyEncoder()
 {
-    if (!m_hEncoder)
-    {
+    if (!m_hEncoder) {
         return;
     }
 
@@ -293,16 +262,13 @@ void NvEncoder::DestroyEncoder()
 
 void NvEncoder::DestroyHWEncoder()
 {
-    if (!m_hEncoder)
-    {
+    if (!m_hEncoder) {
         return;
     }
 
 #if defined(_WIN32)
-    for (uint32_t i = 0; i < m_vpCompletionEvent.size(); i++)
-    {
-        if (m_vpCompletionEvent[i])
-        {
+    for (uint32_t i = 0; i < m_vpCompletionEvent.size(); i++) {
+        if (m_vpCompletionEvent[i]) {
             NV_ENC_EVENT_PARAMS eventParams = { NV_ENC_EVENT_PARAMS_VER };
             eventParams.completionEvent = m_vpCompletionEvent[i];
             m_nvenc.nvEncUnregisterAsyncEvent(m_hEncoder, &eventParams);
@@ -312,12 +278,9 @@ void NvEncoder::DestroyHWEncoder()
     m_vpCompletionEvent.clear();
 #endif
 
-    if (m_bMotionEstimationOnly)
-    {
+    if (m_bMotionEstimationOnly) {
         DestroyMVOutputBuffer();
-    }
-    else
-    {
+    } else {
         DestroyBitstreamBuffer();
     }
 
@@ -348,8 +311,7 @@ void NvEncoder::MapResources(uint32_t bfrIdx)
     NVENC_API_CALL(m_nvenc.nvEncMapInputResource(m_hEncoder, &mapInputResource));
     m_vMappedInputBuffers[bfrIdx] = mapInputResource.mappedResource;
 
-    if (m_bMotionEstimationOnly)
-    {
+    if (m_bMotionEstimationOnly) {
         mapInputResource.registeredResource = m_vRegisteredResourcesForReference[bfrIdx];
         NVENC_API_CALL(m_nvenc.nvEncMapInputResource(m_hEncoder, &mapInputResource));
         m_vMappedRefBuffers[bfrIdx] = mapInputResource.mappedResource;
@@ -359,8 +321,7 @@ void NvEncoder::MapResources(uint32_t bfrIdx)
 void NvEncoder::EncodeFrame(std::vector<std::vector<uint8_t>> &vPacket, NV_ENC_PIC_PARAMS *pPicParams)
 {
     vPacket.clear();
-    if (!IsHWEncoderInitialized())
-    {
+    if (!IsHWEncoderInitialized()) {
         NVENC_THROW_ERROR("Encoder device not found", NV_ENC_ERR_NO_ENCODE_DEVICE);
     }
 
@@ -370,21 +331,17 @@ void NvEncoder::EncodeFrame(std::vector<std::vector<uint8_t>> &vPacket, NV_ENC_P
 
     NVENCSTATUS nvStatus = DoEncode(m_vMappedInputBuffers[bfrIdx], m_vBitstreamOutputBuffer[bfrIdx], pPicParams);
 
-    if (nvStatus == NV_ENC_SUCCESS || nvStatus == NV_ENC_ERR_NEED_MORE_INPUT)
-    {
+    if (nvStatus == NV_ENC_SUCCESS || nvStatus == NV_ENC_ERR_NEED_MORE_INPUT) {
         m_iToSend++;
         GetEncodedPacket(m_vBitstreamOutputBuffer, vPacket, true);
-    }
-    else
-    {
+    } else {
         NVENC_THROW_ERROR("nvEncEncodePicture API failed", nvStatus);
     }
 }
 
 void NvEncoder::RunMotionEstimation(std::vector<uint8_t> &mvData)
 {
-    if (!m_hEncoder)
-    {
+    if (!m_hEncoder) {
         NVENC_THROW_ERROR("Encoder Initialization failed", NV_ENC_ERR_NO_ENCODE_DEVICE);
         return;
     }
@@ -395,19 +352,15 @@ void NvEncoder::RunMotionEstimation(std::vector<uint8_t> &mvData)
 
     NVENCSTATUS nvStatus = DoMotionEstimation(m_vMappedInputBuffers[bfrIdx], m_vMappedRefBuffers[bfrIdx], m_vMVDataOutputBuffer[bfrIdx]);
 
-    if (nvStatus == NV_ENC_SUCCESS)
-    {
+    if (nvStatus == NV_ENC_SUCCESS) {
         m_iToSend++;
         std::vector<std::vector<uint8_t>> vPacket;
         GetEncodedPacket(m_vMVDataOutputBuffer, vPacket, true);
-        if (vPacket.size() != 1)
-        {
+        if (vPacket.size() != 1) {
             NVENC_THROW_ERROR("GetEncodedPacket() doesn't return one (and only one) MVData", NV_ENC_ERR_GENERIC);
         }
         mvData = vPacket[0];
-    }
-    else
-    {
+    } else {
         NVENC_THROW_ERROR("nvEncEncodePicture API failed", nvStatus);
     }
 }
@@ -431,8 +384,7 @@ void NvEncoder::GetSequenceParams(std::vector<uint8_t> &seqParams)
 NVENCSTATUS NvEncoder::DoEncode(NV_ENC_INPUT_PTR inputBuffer, NV_ENC_OUTPUT_PTR outputBuffer, NV_ENC_PIC_PARAMS *pPicParams)
 {
     NV_ENC_PIC_PARAMS picParams = {};
-    if (pPicParams)
-    {
+    if (pPicParams) {
         picParams = *pPicParams;
     }
     picParams.version = NV_ENC_PIC_PARAMS_VER;
@@ -445,7 +397,7 @@ NVENCSTATUS NvEncoder::DoEncode(NV_ENC_INPUT_PTR inputBuffer, NV_ENC_OUTPUT_PTR
     picParams.completionEvent = GetCompletionEvent(m_iToSend % m_nEncoderBuffer);
     NVENCSTATUS nvStatus = m_nvenc.nvEncEncodePicture(m_hEncoder, &picParams);
 
-    return nvStatus; 
+    return nvStatus;
 }
 
 void NvEncoder::SendEOS()
@@ -459,8 +411,7 @@ void NvEncoder::SendEOS()
 void NvEncoder::EndEncode(std::vector<std::vector<uint8_t>> &vPacket)
 {
     vPacket.clear();
-    if (!IsHWEncoderInitialized())
-    {
+    if (!IsHWEncoderInitialized()) {
         NVENC_THROW_ERROR("Encoder device not initialized", NV_ENC_ERR_ENCODER_NOT_INITIALIZED);
     }
 
@@ -473,17 +424,15 @@ void NvEncoder::GetEncodedPacket(std::vector<NV_ENC_OUTPUT_PTR> &vOutputBuffer,
 {
     unsigned i = 0;
     int iEnd = bOutputDelay ? m_iToSend - m_nOutputDelay : m_iToSend;
-    for (; m_iGot < iEnd; m_iGot++)
-    {
+    for (; m_iGot < iEnd; m_iGot++) {
         WaitForCompletionEvent(m_iGot % m_nEncoderBuffer);
         NV_ENC_LOCK_BITSTREAM lockBitstreamData = { NV_ENC_LOCK_BITSTREAM_VER };
         lockBitstreamData.outputBitstream = vOutputBuffer[m_iGot % m_nEncoderBuffer];
         lockBitstreamData.doNotWait = false;
         NVENC_API_CALL(m_nvenc.nvEncLockBitstream(m_hEncoder, &lockBitstreamData));
-  
+
         uint8_t *pData = (uint8_t *)lockBitstreamData.bitstreamBufferPtr;
-        if (vPacket.size() < i + 1)
-        {
+        if (vPacket.size() < i + 1) {
             vPacket.push_back(std::vector<uint8_t>());
         }
         vPacket[i].clear();
@@ -492,14 +441,12 @@ void NvEncoder::GetEncodedPacket(std::vector<NV_ENC_OUTPUT_PTR> &vOutputBuffer,
 
         NVENC_API_CALL(m_nvenc.nvEncUnlockBitstream(m_hEncoder, lockBitstreamData.outputBitstream));
 
-        if (m_vMappedInputBuffers[m_iGot % m_nEncoderBuffer])
-        {
+        if (m_vMappedInputBuffers[m_iGot % m_nEncoderBuffer]) {
             NVENC_API_CALL(m_nvenc.nvEncUnmapInputResource(m_hEncoder, m_vMappedInputBuffers[m_iGot % m_nEncoderBuffer]));
             m_vMappedInputBuffers[m_iGot % m_nEncoderBuffer] = nullptr;
         }
 
-        if (m_bMotionEstimationOnly && m_vMappedRefBuffers[m_iGot % m_nEncoderBuffer])
-        {
+        if (m_bMotionEstimationOnly && m_vMappedRefBuffers[m_iGot % m_nEncoderBuffer]) {
             NVENC_API_CALL(m_nvenc.nvEncUnmapInputResource(m_hEncoder, m_vMappedRefBuffers[m_iGot % m_nEncoderBuffer]));
             m_vMappedRefBuffers[m_iGot % m_nEncoderBuffer] = nullptr;
         }
@@ -511,8 +458,7 @@ bool NvEncoder::Reconfigure(const NV_ENC_RECONFIGURE_PARAMS *pReconfigureParams)
     NVENC_API_CALL(m_nvenc.nvEncReconfigureEncoder(m_hEncoder, const_cast<NV_ENC_RECONFIGURE_PARAMS*>(pReconfigureParams)));
 
     memcpy(&m_initializeParams, &(pReconfigureParams->reInitEncodeParams), sizeof(m_initializeParams));
-    if (pReconfigureParams->reInitEncodeParams.encodeConfig)
-    {
+    if (pReconfigureParams->reInitEncodeParams.encodeConfig) {
         memcpy(&m_encodeConfig, pReconfigureParams->reInitEncodeParams.encodeConfig, sizeof(m_encodeConfig));
     }
 
@@ -525,7 +471,7 @@ bool NvEncoder::Reconfigure(const NV_ENC_RECONFIGURE_PARAMS *pReconfigureParams)
 }
 
 NV_ENC_REGISTERED_PTR NvEncoder::RegisterResource(void *pBuffer, NV_ENC_INPUT_RESOURCE_TYPE eResourceType,
-    int width, int height, int pitch, NV_ENC_BUFFER_FORMAT bufferFormat, NV_ENC_BUFFER_USAGE bufferUsage)
+                                                  int width, int height, int pitch, NV_ENC_BUFFER_FORMAT bufferFormat, NV_ENC_BUFFER_USAGE bufferUsage)
 {
     NV_ENC_REGISTER_RESOURCE registerResource = { NV_ENC_REGISTER_RESOURCE_VER };
     registerResource.resourceType = eResourceType;
@@ -541,20 +487,18 @@ NV_ENC_REGISTERED_PTR NvEncoder::RegisterResource(void *pBuffer, NV_ENC_INPUT_RE
 }
 
 void NvEncoder::RegisterInputResources(std::vector<void*> inputframes, NV_ENC_INPUT_RESOURCE_TYPE eResourceType,
-                                         int width, int height, int pitch, NV_ENC_BUFFER_FORMAT bufferFormat, bool bReferenceFrame)
+                                       int width, int height, int pitch, NV_ENC_BUFFER_FORMAT bufferFormat, bool bReferenceFrame)
 {
-    for (uint32_t i = 0; i < inputframes.size(); ++i)
-    {
+    for (uint32_t i = 0; i < inputframes.size(); ++i) {
         NV_ENC_REGISTERED_PTR registeredPtr = RegisterResource(inputframes[i], eResourceType, width, height, pitch, bufferFormat, NV_ENC_INPUT_IMAGE);
-        
+
         std::vector<uint32_t> _chromaOffsets;
         NvEncoder::GetChromaSubPlaneOffsets(bufferFormat, pitch, height, _chromaOffsets);
         NvEncInputFrame inputframe = {};
         inputframe.inputPtr = (void *)inputframes[i];
         inputframe.chromaOffsets[0] = 0;
         inputframe.chromaOffsets[1] = 0;
-        for (uint32_t ch = 0; ch < _chromaOffsets.size(); ch++)
-        {
+        for (uint32_t ch = 0; ch < _chromaOffsets.size(); ch++) {
             inputframe.chromaOffsets[ch] = _chromaOffsets[ch];
         }
         inputframe.numChromaPlanes = NvEncoder::GetNumChromaPlanes(bufferFormat);
@@ -563,13 +507,10 @@ void NvEncoder::RegisterInputResources(std::vector<void*> inputframes, NV_ENC_IN
         inputframe.bufferFormat = bufferFormat;
         inputframe.resourceType = eResourceType;
 
-        if (bReferenceFrame)
-        {
+        if (bReferenceFrame) {
             m_vRegisteredResourcesForReference.push_back(registeredPtr);
             m_vReferenceFrames.push_back(inputframe);
-        }
-        else
-        {
+        } else {
             m_vRegisteredResources.push_back(registeredPtr);
             m_vInputFrames.push_back(inputframe);
         }
@@ -578,17 +519,13 @@ void NvEncoder::RegisterInputResources(std::vector<void*> inputframes, NV_ENC_IN
 
 void NvEncoder::FlushEncoder()
 {
-    if (!m_bMotionEstimationOnly && !m_bOutputInVideoMemory)
-    {
+    if (!m_bMotionEstimationOnly && !m_bOutputInVideoMemory) {
         // Incase of error it is possible for buffers still mapped to encoder.
         // flush the encoder queue and then unmapped it if any surface is still mapped
-        try
-        {
+        try {
             std::vector<std::vector<uint8_t>> vPacket;
             EndEncode(vPacket);
-        }
-        catch (...)
-        {
+        } catch (...) {
 
         }
     }
@@ -597,42 +534,33 @@ void NvEncoder::FlushEncoder()
 void NvEncoder::UnregisterInputResources()
 {
     FlushEncoder();
-    
-    if (m_bMotionEstimationOnly)
-    {
-        for (uint32_t i = 0; i < m_vMappedRefBuffers.size(); ++i)
-        {
-            if (m_vMappedRefBuffers[i])
-            {
+
+    if (m_bMotionEstimationOnly) {
+        for (uint32_t i = 0; i < m_vMappedRefBuffers.size(); ++i) {
+            if (m_vMappedRefBuffers[i]) {
                 m_nvenc.nvEncUnmapInputResource(m_hEncoder, m_vMappedRefBuffers[i]);
             }
         }
     }
     m_vMappedRefBuffers.clear();
 
-    for (uint32_t i = 0; i < m_vMappedInputBuffers.size(); ++i)
-    {
-        if (m_vMappedInputBuffers[i])
-        {
+    for (uint32_t i = 0; i < m_vMappedInputBuffers.size(); ++i) {
+        if (m_vMappedInputBuffers[i]) {
             m_nvenc.nvEncUnmapInputResource(m_hEncoder, m_vMappedInputBuffers[i]);
         }
     }
     m_vMappedInputBuffers.clear();
 
-    for (uint32_t i = 0; i < m_vRegisteredResources.size(); ++i)
-    {
-        if (m_vRegisteredResources[i])
-        {
+    for (uint32_t i = 0; i < m_vRegisteredResources.size(); ++i) {
+        if (m_vRegisteredResources[i]) {
             m_nvenc.nvEncUnregisterResource(m_hEncoder, m_vRegisteredResources[i]);
         }
     }
     m_vRegisteredResources.clear();
 
 
-    for (uint32_t i = 0; i < m_vRegisteredResourcesForReference.size(); ++i)
-    {
-        if (m_vRegisteredResourcesForReference[i])
-        {
+    for (uint32_t i = 0; i < m_vRegisteredResourcesForReference.size(); ++i) {
+        if (m_vRegisteredResourcesForReference[i]) {
             m_nvenc.nvEncUnregisterResource(m_hEncoder, m_vRegisteredResourcesForReference[i]);
         }
     }
@@ -650,16 +578,14 @@ void NvEncoder::WaitForCompletionEvent(int iEvent)
     sInitializeParams.encodeConfig = &sEncodeConfig;
     GetInitializeParams(&sInitializeParams);
 
-    if (0U == sInitializeParams.enableEncodeAsync)
-    {
+    if (0U == sInitializeParams.enableEncodeAsync) {
         return;
     }
 #ifdef DEBUG
     WaitForSingleObject(m_vpCompletionEvent[iEvent], INFINITE);
 #else
     // wait for 20s which is infinite on terms of gpu time
-    if (WaitForSingleObject(m_vpCompletionEvent[iEvent], 20000) == WAIT_FAILED)
-    {
+    if (WaitForSingleObject(m_vpCompletionEvent[iEvent], 20000) == WAIT_FAILED) {
         NVENC_THROW_ERROR("Failed to encode frame", NV_ENC_ERR_GENERIC);
     }
 #endif
@@ -691,8 +617,7 @@ uint32_t NvEncoder::GetWidthInBytes(const NV_ENC_BUFFER_FORMAT bufferFormat, con
 
 uint32_t NvEncoder::GetNumChromaPlanes(const NV_ENC_BUFFER_FORMAT bufferFormat)
 {
-    switch (bufferFormat) 
-    {
+    switch (bufferFormat) {
     case NV_ENC_BUFFER_FORMAT_NV12:
     case NV_ENC_BUFFER_FORMAT_YUV420_10BIT:
         return 1;
@@ -713,10 +638,9 @@ uint32_t NvEncoder::GetNumChromaPlanes(const NV_ENC_BUFFER_FORMAT bufferFormat)
     }
 }
 
-uint32_t NvEncoder::GetChromaPitch(const NV_ENC_BUFFER_FORMAT bufferFormat,const uint32_t lumaPitch)
+uint32_t NvEncoder::GetChromaPitch(const NV_ENC_BUFFER_FORMAT bufferFormat, const uint32_t lumaPitch)
 {
-    switch (bufferFormat)
-    {
+    switch (bufferFormat) {
     case NV_ENC_BUFFER_FORMAT_NV12:
     case NV_ENC_BUFFER_FORMAT_YUV420_10BIT:
     case NV_ENC_BUFFER_FORMAT_YUV444:
@@ -724,7 +648,7 @@ uint32_t NvEncoder::GetChromaPitch(const NV_ENC_BUFFER_FORMAT bufferFormat,const
         return lumaPitch;
     case NV_ENC_BUFFER_FORMAT_YV12:
     case NV_ENC_BUFFER_FORMAT_IYUV:
-        return (lumaPitch + 1)/2;
+        return (lumaPitch + 1) / 2;
     case NV_ENC_BUFFER_FORMAT_ARGB:
     case NV_ENC_BUFFER_FORMAT_ARGB10:
     case NV_ENC_BUFFER_FORMAT_AYUV:
@@ -740,8 +664,7 @@ uint32_t NvEncoder::GetChromaPitch(const NV_ENC_BUFFER_FORMAT bufferFormat,const
 void NvEncoder::GetChromaSubPlaneOffsets(const NV_ENC_BUFFER_FORMAT bufferFormat, const uint32_t pitch, const uint32_t height, std::vector<uint32_t>& chromaOffsets)
 {
     chromaOffsets.clear();
-    switch (bufferFormat)
-    {
+    switch (bufferFormat) {
     case NV_ENC_BUFFER_FORMAT_NV12:
     case NV_ENC_BUFFER_FORMAT_YUV420_10BIT:
         chromaOffsets.push_back(pitch * height);
@@ -770,13 +693,12 @@ void NvEncoder::GetChromaSubPlaneOffsets(const NV_ENC_BUFFER_FORMAT bufferFormat
 
 uint32_t NvEncoder::GetChromaHeight(const NV_ENC_BUFFER_FORMAT bufferFormat, const uint32_t lumaHeight)
 {
-    switch (bufferFormat)
-    {
+    switch (bufferFormat) {
     case NV_ENC_BUFFER_FORMAT_YV12:
     case NV_ENC_BUFFER_FORMAT_IYUV:
     case NV_ENC_BUFFER_FORMAT_NV12:
     case NV_ENC_BUFFER_FORMAT_YUV420_10BIT:
-        return (lumaHeight + 1)/2;
+        return (lumaHeight + 1) / 2;
     case NV_ENC_BUFFER_FORMAT_YUV444:
     case NV_ENC_BUFFER_FORMAT_YUV444_10BIT:
         return lumaHeight;
@@ -794,8 +716,7 @@ uint32_t NvEncoder::GetChromaHeight(const NV_ENC_BUFFER_FORMAT bufferFormat, con
 
 uint32_t NvEncoder::GetChromaWidthInBytes(const NV_ENC_BUFFER_FORMAT bufferFormat, const uint32_t lumaWidth)
 {
-    switch (bufferFormat)
-    {
+    switch (bufferFormat) {
     case NV_ENC_BUFFER_FORMAT_YV12:
     case NV_ENC_BUFFER_FORMAT_IYUV:
         return (lumaWidth + 1) / 2;
@@ -822,8 +743,7 @@ uint32_t NvEncoder::GetChromaWidthInBytes(const NV_ENC_BUFFER_FORMAT bufferForma
 
 int NvEncoder::GetCapabilityValue(GUID guidCodec, NV_ENC_CAPS capsToQuery)
 {
-    if (!m_hEncoder)
-    {
+    if (!m_hEncoder) {
         return 0;
     }
     NV_ENC_CAPS_PARAM capsParam = { NV_ENC_CAPS_PARAM_VER };
@@ -835,8 +755,7 @@ int NvEncoder::GetCapabilityValue(GUID guidCodec, NV_ENC_CAPS capsToQuery)
 
 int NvEncoder::GetFrameSize() const
 {
-    switch (GetPixelFormat())
-    {
+    switch (GetPixelFormat()) {
     case NV_ENC_BUFFER_FORMAT_YV12:
     case NV_ENC_BUFFER_FORMAT_IYUV:
     case NV_ENC_BUFFER_FORMAT_NV12:
@@ -861,8 +780,7 @@ int NvEncoder::GetFrameSize() const
 
 void NvEncoder::GetInitializeParams(NV_ENC_INITIALIZE_PARAMS *pInitializeParams)
 {
-    if (!pInitializeParams || !pInitializeParams->encodeConfig)
-    {
+    if (!pInitializeParams || !pInitializeParams->encodeConfig) {
         NVENC_THROW_ERROR("Both pInitializeParams and pInitializeParams->encodeConfig can't be NULL", NV_ENC_ERR_INVALID_PTR);
     }
     NV_ENC_CONFIG *pEncodeConfig = pInitializeParams->encodeConfig;
@@ -873,8 +791,7 @@ void NvEncoder::GetInitializeParams(NV_ENC_INITIALIZE_PARAMS *pInitializeParams)
 
 void NvEncoder::InitializeBitstreamBuffer()
 {
-    for (int i = 0; i < m_nEncoderBuffer; i++)
-    {
+    for (int i = 0; i < m_nEncoderBuffer; i++) {
         NV_ENC_CREATE_BITSTREAM_BUFFER createBitstreamBuffer = { NV_ENC_CREATE_BITSTREAM_BUFFER_VER };
         NVENC_API_CALL(m_nvenc.nvEncCreateBitstreamBuffer(m_hEncoder, &createBitstreamBuffer));
         m_vBitstreamOutputBuffer[i] = createBitstreamBuffer.bitstreamBuffer;
@@ -883,10 +800,8 @@ void NvEncoder::InitializeBitstreamBuffer()
 
 void NvEncoder::DestroyBitstreamBuffer()
 {
-    for (uint32_t i = 0; i < m_vBitstreamOutputBuffer.size(); i++)
-    {
-        if (m_vBitstreamOutputBuffer[i])
-        {
+    for (uint32_t i = 0; i < m_vBitstreamOutputBuffer.size(); i++) {
+        if (m_vBitstreamOutputBuffer[i]) {
             m_nvenc.nvEncDestroyBitstreamBuffer(m_hEncoder, m_vBitstreamOutputBuffer[i]);
         }
     }
@@ -896,8 +811,7 @@ void NvEncoder::DestroyBitstreamBuffer()
 
 void NvEncoder::InitializeMVOutputBuffer()
 {
-    for (int i = 0; i < m_nEncoderBuffer; i++)
-    {
+    for (int i = 0; i < m_nEncoderBuffer; i++) {
         NV_ENC_CREATE_MV_BUFFER createMVBuffer = { NV_ENC_CREATE_MV_BUFFER_VER };
         NVENC_API_CALL(m_nvenc.nvEncCreateMVBuffer(m_hEncoder, &createMVBuffer));
         m_vMVDataOutputBuffer.push_back(createMVBuffer.mvBuffer);
@@ -906,10 +820,8 @@ void NvEncoder::InitializeMVOutputBuffer()
 
 void NvEncoder::DestroyMVOutputBuffer()
 {
-    for (uint32_t i = 0; i < m_vMVDataOutputBuffer.size(); i++)
-    {
-        if (m_vMVDataOutputBuffer[i])
-        {
+    for (uint32_t i = 0; i < m_vMVDataOutputBuffer.size(); i++) {
+        if (m_vMVDataOutputBuffer[i]) {
             m_nvenc.nvEncDestroyMVBuffer(m_hEncoder, m_vMVDataOutputBuffer[i]);
         }
     }
@@ -927,6 +839,6 @@ NVENCSTATUS NvEncoder::DoMotionEstimation(NV_ENC_INPUT_PTR inputBuffer, NV_ENC_I
     meParams.mvBuffer = outputBuffer;
     meParams.completionEvent = GetCompletionEvent(m_iToSend % m_nEncoderBuffer);
     NVENCSTATUS nvStatus = m_nvenc.nvEncRunMotionEstimationOnly(m_hEncoder, &meParams);
-    
+
     return nvStatus;
 }
@@ -34,14 +34,14 @@ public:
     NVENCSTATUS  getErrorCode() const { return m_errorCode; }
     const std::string& getErrorString() const { return m_errorString; }
     static NVENCException makeNVENCException(const std::string& errorStr, const NVENCSTATUS errorCode,
-        const std::string& functionName, const std::string& fileName, int lineNo);
+                                             const std::string& functionName, const std::string& fileName, int lineNo);
 private:
     std::string m_errorString;
     NVENCSTATUS m_errorCode;
 };
 
 inline NVENCException NVENCException::makeNVENCException(const std::string& errorStr, const NVENCSTATUS errorCode, const std::string& functionName,
-    const std::string& fileName, int lineNo)
+                                                         const std::string& fileName, int lineNo)
 {
     std::ostringstream errorLog;
     errorLog << functionName << " : " << errorStr << " at " << fileName << ":" << lineNo << std::endl;
@@ -68,8 +68,7 @@ inline NVENCException NVENCException::makeNVENCException(const std::string& erro
         }                                                                                                          \
     } while (0)
 
-struct NvEncInputFrame
-{
+struct NvEncInputFrame {
     void* inputPtr = nullptr;
     uint32_t chromaOffsets[2];
     uint32_t numChromaPlanes;
@@ -221,7 +220,7 @@ public:
     *  @brief This a static function to get chroma offsets for YUV planar formats.
     */
     static void GetChromaSubPlaneOffsets(const NV_ENC_BUFFER_FORMAT bufferFormat, const uint32_t pitch,
-                                        const uint32_t height, std::vector<uint32_t>& chromaOffsets);
+                                         const uint32_t height, std::vector<uint32_t>& chromaOffsets);
     /**
     *  @brief This a static function to get the chroma plane pitch for YUV planar formats.
     */
@@ -256,7 +255,7 @@ protected:
     *  NvEncoder class constructor cannot be called directly by the application.
     */
     NvEncoder(NV_ENC_DEVICE_TYPE eDeviceType, void *pDevice, uint32_t nWidth, uint32_t nHeight,
-        NV_ENC_BUFFER_FORMAT eBufferFormat, uint32_t nOutputDelay, bool bMotionEstimationOnly, bool bOutputInVideoMemory = false);
+              NV_ENC_BUFFER_FORMAT eBufferFormat, uint32_t nOutputDelay, bool bMotionEstimationOnly, bool bOutputInVideoMemory = false);
 
     /**
     *  @brief This function is used to check if hardware encoder is properly initialized.
@@ -269,7 +268,7 @@ protected:
     *  and registering input buffers.
     */
     void RegisterInputResources(std::vector<void*> inputframes, NV_ENC_INPUT_RESOURCE_TYPE eResourceType,
-        int width, int height, int pitch, NV_ENC_BUFFER_FORMAT bufferFormat, bool bReferenceFrame = false);
+                                int width, int height, int pitch, NV_ENC_BUFFER_FORMAT bufferFormat, bool bReferenceFrame = false);
 
     /**
     *  @brief This function is used to unregister resources which had been previously registered for encoding
@@ -281,7 +280,7 @@ protected:
     *  @brief This function is used to register CUDA, D3D or OpenGL input or output buffers with NvEncodeAPI.
     */
     NV_ENC_REGISTERED_PTR RegisterResource(void *pBuffer, NV_ENC_INPUT_RESOURCE_TYPE eResourceType,
-        int width, int height, int pitch, NV_ENC_BUFFER_FORMAT bufferFormat, NV_ENC_BUFFER_USAGE bufferUsage = NV_ENC_INPUT_IMAGE);
+                                           int width, int height, int pitch, NV_ENC_BUFFER_FORMAT bufferFormat, NV_ENC_BUFFER_USAGE bufferUsage = NV_ENC_INPUT_IMAGE);
 
     /**
     *  @brief This function returns maximum width used to open the encoder session.
@@ -306,13 +305,13 @@ protected:
     NV_ENC_BUFFER_FORMAT GetPixelFormat() const { return m_eBufferFormat; }
 
     /**
-    *  @brief This function is used to submit the encode commands to the  
+    *  @brief This function is used to submit the encode commands to the
     *         NVENC hardware.
     */
     NVENCSTATUS DoEncode(NV_ENC_INPUT_PTR inputBuffer, NV_ENC_OUTPUT_PTR outputBuffer, NV_ENC_PIC_PARAMS *pPicParams);
 
     /**
-    *  @brief This function is used to submit the encode commands to the 
+    *  @brief This function is used to submit the encode commands to the
     *         NVENC hardware for ME only mode.
     */
     NVENCSTATUS DoMotionEstimation(NV_ENC_INPUT_PTR inputBuffer, NV_ENC_INPUT_PTR inputBufferForReference, NV_ENC_OUTPUT_PTR outputBuffer);
@@ -12,17 +12,15 @@
 #include "NvEncoderCuda.h"
 
 NvEncoderCuda::NvEncoderCuda(CUcontext cuContext, uint32_t nWidth, uint32_t nHeight, NV_ENC_BUFFER_FORMAT eBufferFormat,
-    uint32_t nExtraOutputDelay, bool bMotionEstimationOnly, bool bOutputInVideoMemory):
+                             uint32_t nExtraOutputDelay, bool bMotionEstimationOnly, bool bOutputInVideoMemory):
     NvEncoder(NV_ENC_DEVICE_TYPE_CUDA, cuContext, nWidth, nHeight, eBufferFormat, nExtraOutputDelay, bMotionEstimationOnly, bOutputInVideoMemory),
     m_cuContext(cuContext)
 {
-    if (!m_hEncoder) 
-    {
+    if (!m_hEncoder) {
         NVENC_THROW_ERROR("Encoder Initialization failed", NV_ENC_ERR_INVALID_DEVICE);
     }
 
-    if (!m_cuContext)
-    {
+    if (!m_cuContext) {
         NVENC_THROW_ERROR("Invalid Cuda Context", NV_ENC_ERR_INVALID_DEVICE);
     }
 }
@@ -34,39 +32,36 @@ NvEncoderCuda::~NvEncoderCuda()
 
 void NvEncoderCuda::AllocateInputBuffers(int32_t numInputBuffers)
 {
-    if (!IsHWEncoderInitialized())
-    {
+    if (!IsHWEncoderInitialized()) {
         NVENC_THROW_ERROR("Encoder intialization failed", NV_ENC_ERR_ENCODER_NOT_INITIALIZED);
     }
 
     // for MEOnly mode we need to allocate seperate set of buffers for reference frame
     int numCount = m_bMotionEstimationOnly ? 2 : 1;
 
-    for (int count = 0; count < numCount; count++)
-    {
+    for (int count = 0; count < numCount; count++) {
         CUDA_DRVAPI_CALL(cuCtxPushCurrent(m_cuContext));
         std::vector<void*> inputFrames;
-        for (int i = 0; i < numInputBuffers; i++)
-        {
+        for (int i = 0; i < numInputBuffers; i++) {
             CUdeviceptr pDeviceFrame;
             uint32_t chromaHeight = GetNumChromaPlanes(GetPixelFormat()) * GetChromaHeight(GetPixelFormat(), GetMaxEncodeHeight());
             if (GetPixelFormat() == NV_ENC_BUFFER_FORMAT_YV12 || GetPixelFormat() == NV_ENC_BUFFER_FORMAT_IYUV)
                 chromaHeight = GetChromaHeight(GetPixelFormat(), GetMaxEncodeHeight());
             CUDA_DRVAPI_CALL(cuMemAllocPitch((CUdeviceptr *)&pDeviceFrame,
-                &m_cudaPitch,
-                GetWidthInBytes(GetPixelFormat(), GetMaxEncodeWidth()),
-                GetMaxEncodeHeight() + chromaHeight, 16));
+                                             &m_cudaPitch,
+                                             GetWidthInBytes(GetPixelFormat(), GetMaxEncodeWidth()),
+                                             GetMaxEncodeHeight() + chromaHeight, 16));
             inputFrames.push_back((void*)pDeviceFrame);
         }
         CUDA_DRVAPI_CALL(cuCtxPopCurrent(NULL));
 
         RegisterInputResources(inputFrames,
-            NV_ENC_INPUT_RESOURCE_TYPE_CUDADEVICEPTR,
-            GetMaxEncodeWidth(),
-            GetMaxEncodeHeight(),
-            (int)m_cudaPitch,
-            GetPixelFormat(),
-            (count == 1) ? true : false);
+                               NV_ENC_INPUT_RESOURCE_TYPE_CUDADEVICEPTR,
+                               GetMaxEncodeWidth(),
+                               GetMaxEncodeHeight(),
+                               (int)m_cudaPitch,
+                               GetPixelFormat(),
+                               (count == 1) ? true : false);
     }
 }
 
@@ -82,13 +77,11 @@ void NvEncoderCuda::ReleaseInputBuffers()
 
 void NvEncoderCuda::ReleaseCudaResources()
 {
-    if (!m_hEncoder)
-    {
+    if (!m_hEncoder) {
         return;
     }
 
-    if (!m_cuContext)
-    {
+    if (!m_cuContext) {
         return;
     }
 
@@ -96,19 +89,15 @@ void NvEncoderCuda::ReleaseCudaResources()
 
     cuCtxPushCurrent(m_cuContext);
 
-    for (uint32_t i = 0; i < m_vInputFrames.size(); ++i)
-    {
-        if (m_vInputFrames[i].inputPtr)
-        {
+    for (uint32_t i = 0; i < m_vInputFrames.size(); ++i) {
+        if (m_vInputFrames[i].inputPtr) {
             cuMemFree(reinterpret_cast<CUdeviceptr>(m_vInputFrames[i].inputPtr));
         }
     }
     m_vInputFrames.clear();
 
-    for (uint32_t i = 0; i < m_vReferenceFrames.size(); ++i)
-    {
-        if (m_vReferenceFrames[i].inputPtr)
-        {
+    for (uint32_t i = 0; i < m_vReferenceFrames.size(); ++i) {
+        if (m_vReferenceFrames[i].inputPtr) {
             cuMemFree(reinterpret_cast<CUdeviceptr>(m_vReferenceFrames[i].inputPtr));
         }
     }
@@ -119,21 +108,20 @@ void NvEncoderCuda::ReleaseCudaResources()
 }
 
 void NvEncoderCuda::CopyToDeviceFrame(CUcontext device,
-    void* pSrcFrame,
-    uint32_t nSrcPitch,
-    CUdeviceptr pDstFrame,
-    uint32_t dstPitch,
-    int width,
-    int height,
-    CUmemorytype srcMemoryType,
-    NV_ENC_BUFFER_FORMAT pixelFormat,
-    const uint32_t dstChromaOffsets[],
-    uint32_t numChromaPlanes,
-    bool bUnAlignedDeviceCopy,
-    CUstream stream)
+                                      void* pSrcFrame,
+                                      uint32_t nSrcPitch,
+                                      CUdeviceptr pDstFrame,
+                                      uint32_t dstPitch,
+                                      int width,
+                                      int height,
+                                      CUmemorytype srcMemoryType,
+                                      NV_ENC_BUFFER_FORMAT pixelFormat,
+                                      const uint32_t dstChromaOffsets[],
+                                      uint32_t numChromaPlanes,
+                                      bool bUnAlignedDeviceCopy,
+                                      CUstream stream)
 {
-    if (srcMemoryType != CU_MEMORYTYPE_HOST && srcMemoryType != CU_MEMORYTYPE_DEVICE)
-    {
+    if (srcMemoryType != CU_MEMORYTYPE_HOST && srcMemoryType != CU_MEMORYTYPE_DEVICE) {
         NVENC_THROW_ERROR("Invalid source memory type for copy", NV_ENC_ERR_INVALID_PARAM);
     }
 
@@ -142,12 +130,9 @@ void NvEncoderCuda::CopyToDeviceFrame(CUcontext device,
     uint32_t srcPitch = nSrcPitch ? nSrcPitch : NvEncoder::GetWidthInBytes(pixelFormat, width);
     CUDA_MEMCPY2D m = { 0 };
     m.srcMemoryType = srcMemoryType;
-    if (srcMemoryType == CU_MEMORYTYPE_HOST)
-    {
+    if (srcMemoryType == CU_MEMORYTYPE_HOST) {
         m.srcHost = pSrcFrame;
-    }
-    else
-    {
+    } else {
         m.srcDevice = (CUdeviceptr)pSrcFrame;
     }
     m.srcPitch = srcPitch;
@@ -156,13 +141,10 @@ void NvEncoderCuda::CopyToDeviceFrame(CUcontext device,
     m.dstPitch = dstPitch;
     m.WidthInBytes = NvEncoder::GetWidthInBytes(pixelFormat, width);
     m.Height = height;
-    if (bUnAlignedDeviceCopy && srcMemoryType == CU_MEMORYTYPE_DEVICE)
-    {
+    if (bUnAlignedDeviceCopy && srcMemoryType == CU_MEMORYTYPE_DEVICE) {
         CUDA_DRVAPI_CALL(cuMemcpy2DUnaligned(&m));
-    }
-    else
-    {
-        CUDA_DRVAPI_CALL(stream == NULL? cuMemcpy2D(&m) : cuMemcpy2DAsync(&m, stream));
+    } else {
+        CUDA_DRVAPI_CALL(stream == NULL ? cuMemcpy2D(&m) : cuMemcpy2DAsync(&m, stream));
     }
 
     std::vector<uint32_t> srcChromaOffsets;
@@ -172,16 +154,11 @@ void NvEncoderCuda::CopyToDeviceFrame(CUcontext device,
     uint32_t srcChromaPitch = NvEncoder::GetChromaPitch(pixelFormat, srcPitch);
     uint32_t chromaWidthInBytes = NvEncoder::GetChromaWidthInBytes(pixelFormat, width);
 
-    for (uint32_t i = 0; i < numChromaPlanes; ++i)
-    {
-        if (chromaHeight)
-        {
-            if (srcMemoryType == CU_MEMORYTYPE_HOST)
-            {
+    for (uint32_t i = 0; i < numChromaPlanes; ++i) {
+        if (chromaHeight) {
+            if (srcMemoryType == CU_MEMORYTYPE_HOST) {
                 m.srcHost = ((uint8_t *)pSrcFrame + srcChromaOffsets[i]);
-            }
-            else
-            {
+            } else {
                 m.srcDevice = (CUdeviceptr)((uint8_t *)pSrcFrame + srcChromaOffsets[i]);
             }
             m.srcPitch = srcChromaPitch;
@@ -190,13 +167,10 @@ void NvEncoderCuda::CopyToDeviceFrame(CUcontext device,
             m.dstPitch = destChromaPitch;
             m.WidthInBytes = chromaWidthInBytes;
             m.Height = chromaHeight;
-            if (bUnAlignedDeviceCopy && srcMemoryType == CU_MEMORYTYPE_DEVICE)
-            {
+            if (bUnAlignedDeviceCopy && srcMemoryType == CU_MEMORYTYPE_DEVICE) {
                 CUDA_DRVAPI_CALL(cuMemcpy2DUnaligned(&m));
-            }
-            else
-            {
-                CUDA_DRVAPI_CALL(stream == NULL? cuMemcpy2D(&m) : cuMemcpy2DAsync(&m, stream));
+            } else {
+                CUDA_DRVAPI_CALL(stream == NULL ? cuMemcpy2D(&m) : cuMemcpy2DAsync(&m, stream));
             }
         }
     }
@@ -204,21 +178,20 @@ void NvEncoderCuda::CopyToDeviceFrame(CUcontext device,
 }
 
 void NvEncoderCuda::CopyToDeviceFrame(CUcontext device,
-    void* pSrcFrame,
-    uint32_t nSrcPitch,
-    CUdeviceptr pDstFrame,
-    uint32_t dstPitch,
-    int width,
-    int height,
-    CUmemorytype srcMemoryType,
-    NV_ENC_BUFFER_FORMAT pixelFormat,
-    CUdeviceptr dstChromaDevicePtrs[],
-    uint32_t dstChromaPitch,
-    uint32_t numChromaPlanes,
-    bool bUnAlignedDeviceCopy)
+                                      void* pSrcFrame,
+                                      uint32_t nSrcPitch,
+                                      CUdeviceptr pDstFrame,
+                                      uint32_t dstPitch,
+                                      int width,
+                                      int height,
+                                      CUmemorytype srcMemoryType,
+                                      NV_ENC_BUFFER_FORMAT pixelFormat,
+                                      CUdeviceptr dstChromaDevicePtrs[],
+                                      uint32_t dstChromaPitch,
+                                      uint32_t numChromaPlanes,
+                                      bool bUnAlignedDeviceCopy)
 {
-    if (srcMemoryType != CU_MEMORYTYPE_HOST && srcMemoryType != CU_MEMORYTYPE_DEVICE)
-    {
+    if (srcMemoryType != CU_MEMORYTYPE_HOST && srcMemoryType != CU_MEMORYTYPE_DEVICE) {
         NVENC_THROW_ERROR("Invalid source memory type for copy", NV_ENC_ERR_INVALID_PARAM);
     }
 
@@ -227,12 +200,9 @@ void NvEncoderCuda::CopyToDeviceFrame(CUcontext device,
     uint32_t srcPitch = nSrcPitch ? nSrcPitch : NvEncoder::GetWidthInBytes(pixelFormat, width);
     CUDA_MEMCPY2D m = { 0 };
     m.srcMemoryType = srcMemoryType;
-    if (srcMemoryType == CU_MEMORYTYPE_HOST)
-    {
+    if (srcMemoryType == CU_MEMORYTYPE_HOST) {
         m.srcHost = pSrcFrame;
-    }
-    else
-    {
+    } else {
         m.srcDevice = (CUdeviceptr)pSrcFrame;
     }
     m.srcPitch = srcPitch;
@@ -241,12 +211,9 @@ void NvEncoderCuda::CopyToDeviceFrame(CUcontext device,
     m.dstPitch = dstPitch;
     m.WidthInBytes = NvEncoder::GetWidthInBytes(pixelFormat, width);
     m.Height = height;
-    if (bUnAlignedDeviceCopy && srcMemoryType == CU_MEMORYTYPE_DEVICE)
-    {
+    if (bUnAlignedDeviceCopy && srcMemoryType == CU_MEMORYTYPE_DEVICE) {
         CUDA_DRVAPI_CALL(cuMemcpy2DUnaligned(&m));
-    }
-    else
-    {
+    } else {
         CUDA_DRVAPI_CALL(cuMemcpy2D(&m));
     }
 
@@ -256,16 +223,11 @@ void NvEncoderCuda::CopyToDeviceFrame(CUcontext device,
     uint32_t srcChromaPitch = NvEncoder::GetChromaPitch(pixelFormat, srcPitch);
     uint32_t chromaWidthInBytes = NvEncoder::GetChromaWidthInBytes(pixelFormat, width);
 
-    for (uint32_t i = 0; i < numChromaPlanes; ++i)
-    {
-        if (chromaHeight)
-        {
-            if (srcMemoryType == CU_MEMORYTYPE_HOST)
-            {
+    for (uint32_t i = 0; i < numChromaPlanes; ++i) {
+        if (chromaHeight) {
+            if (srcMemoryType == CU_MEMORYTYPE_HOST) {
                 m.srcHost = ((uint8_t *)pSrcFrame + srcChromaOffsets[i]);
-            }
-            else
-            {
+            } else {
                 m.srcDevice = (CUdeviceptr)((uint8_t *)pSrcFrame + srcChromaOffsets[i]);
             }
             m.srcPitch = srcChromaPitch;
@@ -274,12 +236,9 @@ void NvEncoderCuda::CopyToDeviceFrame(CUcontext device,
             m.dstPitch = dstChromaPitch;
             m.WidthInBytes = chromaWidthInBytes;
             m.Height = chromaHeight;
-            if (bUnAlignedDeviceCopy && srcMemoryType == CU_MEMORYTYPE_DEVICE)
-            {
+            if (bUnAlignedDeviceCopy && srcMemoryType == CU_MEMORYTYPE_DEVICE) {
                 CUDA_DRVAPI_CALL(cuMemcpy2DUnaligned(&m));
-            }
-            else
-            {
+            } else {
                 CUDA_DRVAPI_CALL(cuMemcpy2D(&m));
             }
         }
@@ -39,7 +39,7 @@ class NvEncoderCuda : public NvEncoder
 {
 public:
     NvEncoderCuda(CUcontext cuContext, uint32_t nWidth, uint32_t nHeight, NV_ENC_BUFFER_FORMAT eBufferFormat,
-        uint32_t nExtraOutputDelay = 3, bool bMotionEstimationOnly = false, bool bOPInVideoMemory = false);
+                  uint32_t nExtraOutputDelay = 3, bool bMotionEstimationOnly = false, bool bOPInVideoMemory = false);
     virtual ~NvEncoderCuda();
 
     /**
@@ -47,36 +47,36 @@ public:
     *  This function assumes YUV plane is a single contiguous memory segment.
     */
     static void CopyToDeviceFrame(CUcontext device,
-        void* pSrcFrame,
-        uint32_t nSrcPitch,
-        CUdeviceptr pDstFrame,
-        uint32_t dstPitch,
-        int width,
-        int height,
-        CUmemorytype srcMemoryType,
-        NV_ENC_BUFFER_FORMAT pixelFormat,
-        const uint32_t dstChromaOffsets[],
-        uint32_t numChromaPlanes,
-        bool bUnAlignedDeviceCopy = false,
-        CUstream stream = NULL);
+                                  void* pSrcFrame,
+                                  uint32_t nSrcPitch,
+                                  CUdeviceptr pDstFrame,
+                                  uint32_t dstPitch,
+                                  int width,
+                                  int height,
+                                  CUmemorytype srcMemoryType,
+                                  NV_ENC_BUFFER_FORMAT pixelFormat,
+                                  const uint32_t dstChromaOffsets[],
+                                  uint32_t numChromaPlanes,
+                                  bool bUnAlignedDeviceCopy = false,
+                                  CUstream stream = NULL);
 
     /**
     *  @brief This is a static function to copy input data from host memory to device memory.
     *  Application must pass a seperate device pointer for each YUV plane.
     */
     static void CopyToDeviceFrame(CUcontext device,
-        void* pSrcFrame,
-        uint32_t nSrcPitch,
-        CUdeviceptr pDstFrame,
-        uint32_t dstPitch,
-        int width,
-        int height,
-        CUmemorytype srcMemoryType,
-        NV_ENC_BUFFER_FORMAT pixelFormat,
-        CUdeviceptr dstChromaPtr[],
-        uint32_t dstChromaPitch,
-        uint32_t numChromaPlanes,
-        bool bUnAlignedDeviceCopy = false);
+                                  void* pSrcFrame,
+                                  uint32_t nSrcPitch,
+                                  CUdeviceptr pDstFrame,
+                                  uint32_t dstPitch,
+                                  int width,
+                                  int height,
+                                  CUmemorytype srcMemoryType,
+                                  NV_ENC_BUFFER_FORMAT pixelFormat,
+                                  CUdeviceptr dstChromaPtr[],
+                                  uint32_t dstChromaPitch,
+                                  uint32_t numChromaPlanes,
+                                  bool bUnAlignedDeviceCopy = false);
 
     /**
     *  @brief This function sets input and output CUDA streams
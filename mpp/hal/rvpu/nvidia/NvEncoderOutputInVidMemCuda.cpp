@@ -12,22 +12,19 @@
 #include "NvEncoderOutputInVidMemCuda.h"
 
 
-NvEncoderOutputInVidMemCuda::NvEncoderOutputInVidMemCuda(CUcontext cuContext, 
-    uint32_t nWidth, uint32_t nHeight, NV_ENC_BUFFER_FORMAT eBufferFormat,
-    bool bMotionEstimationOnly)
+NvEncoderOutputInVidMemCuda::NvEncoderOutputInVidMemCuda(CUcontext cuContext,
+                                                         uint32_t nWidth, uint32_t nHeight, NV_ENC_BUFFER_FORMAT eBufferFormat,
+                                                         bool bMotionEstimationOnly)
     : NvEncoderCuda(cuContext, nWidth, nHeight, eBufferFormat, 0, bMotionEstimationOnly, true)
 {
 }
 
 NvEncoderOutputInVidMemCuda::~NvEncoderOutputInVidMemCuda()
 {
-    try
-    {
+    try {
         FlushEncoder();
         ReleaseOutputBuffers();
-    }
-    catch (...)
-    {
+    } catch (...) {
 
     }
 }
@@ -36,15 +33,12 @@ uint32_t NvEncoderOutputInVidMemCuda::GetOutputBufferSize()
 {
     uint32_t bufferSize = 0;
 
-    if (m_bMotionEstimationOnly)
-    {
+    if (m_bMotionEstimationOnly) {
         uint32_t encodeWidthInMbs = (GetEncodeWidth() + 15) >> 4;
         uint32_t encodeHeightInMbs = (GetEncodeHeight() + 15) >> 4;
-        
+
         bufferSize = encodeWidthInMbs * encodeHeightInMbs * sizeof(NV_ENC_H264_MV_DATA);
-    }
-    else
-    {
+    } else {
         // 2-times the input size
         bufferSize = GetFrameSize() * 2;
 
@@ -62,13 +56,11 @@ void NvEncoderOutputInVidMemCuda::AllocateOutputBuffers(uint32_t numOutputBuffer
 
     CUDA_DRVAPI_CALL(cuCtxPushCurrent(m_cuContext));
 
-    for (uint32_t i = 0; i < numOutputBuffers; i++)
-    {
+    for (uint32_t i = 0; i < numOutputBuffers; i++) {
         CUdeviceptr pDeviceFrame;
 
         CUresult cuResult = cuMemAlloc(&pDeviceFrame, size);
-        if (cuResult != CUDA_SUCCESS)
-        {
+        if (cuResult != CUDA_SUCCESS) {
             NVENC_THROW_ERROR("cuMemAlloc Failed", NV_ENC_ERR_OUT_OF_MEMORY);
         }
 
@@ -82,15 +74,13 @@ void NvEncoderOutputInVidMemCuda::AllocateOutputBuffers(uint32_t numOutputBuffer
 
 void NvEncoderOutputInVidMemCuda::ReleaseOutputBuffers()
 {
-    if (!m_hEncoder)
-    {
+    if (!m_hEncoder) {
         return;
     }
 
     UnregisterOutputResources();
-    
-    for (uint32_t i = 0; i < m_pOutputBuffers.size(); ++i)
-    {
+
+    for (uint32_t i = 0; i < m_pOutputBuffers.size(); ++i) {
         cuMemFree(reinterpret_cast<CUdeviceptr>(m_pOutputBuffers[i]));
     }
 
@@ -99,16 +89,14 @@ void NvEncoderOutputInVidMemCuda::ReleaseOutputBuffers()
 
 void NvEncoderOutputInVidMemCuda::RegisterOutputResources(uint32_t bfrSize)
 {
-    NV_ENC_BUFFER_USAGE bufferUsage = m_bMotionEstimationOnly? NV_ENC_OUTPUT_MOTION_VECTOR : NV_ENC_OUTPUT_BITSTREAM;
-
-    for (uint32_t i = 0; i < m_pOutputBuffers.size(); ++i)
-    {
-        if (m_pOutputBuffers[i])
-        {
-            NV_ENC_REGISTERED_PTR registeredPtr = RegisterResource((void *)m_pOutputBuffers[i], 
-                                                            NV_ENC_INPUT_RESOURCE_TYPE_CUDADEVICEPTR, 
-                                                            bfrSize, 1, bfrSize, NV_ENC_BUFFER_FORMAT_U8, bufferUsage);
-        
+    NV_ENC_BUFFER_USAGE bufferUsage = m_bMotionEstimationOnly ? NV_ENC_OUTPUT_MOTION_VECTOR : NV_ENC_OUTPUT_BITSTREAM;
+
+    for (uint32_t i = 0; i < m_pOutputBuffers.size(); ++i) {
+        if (m_pOutputBuffers[i]) {
+            NV_ENC_REGISTERED_PTR registeredPtr = RegisterResource((void *)m_pOutputBuffers[i],
+                                                                   NV_ENC_INPUT_RESOURCE_TYPE_CUDADEVICEPTR,
+                                                                   bfrSize, 1, bfrSize, NV_ENC_BUFFER_FORMAT_U8, bufferUsage);
+
             m_vRegisteredResourcesOutputBuffer.push_back(registeredPtr);
         }
     }
@@ -116,19 +104,15 @@ void NvEncoderOutputInVidMemCuda::RegisterOutputResources(uint32_t bfrSize)
 
 void NvEncoderOutputInVidMemCuda::UnregisterOutputResources()
 {
-    for (uint32_t i = 0; i < m_vMappedOutputBuffers.size(); ++i)
-    {
-        if (m_vMappedOutputBuffers[i])
-        {
+    for (uint32_t i = 0; i < m_vMappedOutputBuffers.size(); ++i) {
+        if (m_vMappedOutputBuffers[i]) {
             m_nvenc.nvEncUnmapInputResource(m_hEncoder, m_vMappedOutputBuffers[i]);
         }
     }
     m_vMappedOutputBuffers.clear();
 
-    for (uint32_t i = 0; i < m_vRegisteredResourcesOutputBuffer.size(); ++i)
-    {
-        if (m_vRegisteredResourcesOutputBuffer[i])
-        {
+    for (uint32_t i = 0; i < m_vRegisteredResourcesOutputBuffer.size(); ++i) {
+        if (m_vRegisteredResourcesOutputBuffer[i]) {
             m_nvenc.nvEncUnregisterResource(m_hEncoder, m_vRegisteredResourcesOutputBuffer[i]);
         }
     }
@@ -159,32 +143,27 @@ void NvEncoderOutputInVidMemCuda::MapResources(uint32_t bfrIdx)
 void NvEncoderOutputInVidMemCuda::EncodeFrame(std::vector<NV_ENC_OUTPUT_PTR> &pOutputBuffer, NV_ENC_PIC_PARAMS *pPicParams)
 {
     pOutputBuffer.clear();
-    if (!IsHWEncoderInitialized())
-    {
+    if (!IsHWEncoderInitialized()) {
         NVENC_THROW_ERROR("Encoder device not found", NV_ENC_ERR_NO_ENCODE_DEVICE);
     }
 
     int bfrIdx = m_iToSend % m_nEncoderBuffer;
-    
+
     MapResources(bfrIdx);
-    
+
     NVENCSTATUS nvStatus = DoEncode(m_vMappedInputBuffers[bfrIdx], m_vMappedOutputBuffers[bfrIdx], pPicParams);
-    
-    if (nvStatus == NV_ENC_SUCCESS || nvStatus == NV_ENC_ERR_NEED_MORE_INPUT)
-    {
+
+    if (nvStatus == NV_ENC_SUCCESS || nvStatus == NV_ENC_ERR_NEED_MORE_INPUT) {
         m_iToSend++;
         GetEncodedPacket(pOutputBuffer, true);
-    }
-    else
-    {
+    } else {
         NVENC_THROW_ERROR("nvEncEncodePicture API failed", nvStatus);
     }
 }
 
 void NvEncoderOutputInVidMemCuda::EndEncode(std::vector<NV_ENC_OUTPUT_PTR> &pOutputBuffer)
 {
-    if (!IsHWEncoderInitialized())
-    {
+    if (!IsHWEncoderInitialized()) {
         NVENC_THROW_ERROR("Encoder device not initialized", NV_ENC_ERR_ENCODER_NOT_INITIALIZED);
     }
 
@@ -197,8 +176,7 @@ void NvEncoderOutputInVidMemCuda::RunMotionEstimation(std::vector<NV_ENC_OUTPUT_
 {
     pOutputBuffer.clear();
 
-    if (!m_hEncoder)
-    {
+    if (!m_hEncoder) {
         NVENC_THROW_ERROR("Encoder Initialization failed", NV_ENC_ERR_NO_ENCODE_DEVICE);
         return;
     }
@@ -206,16 +184,13 @@ void NvEncoderOutputInVidMemCuda::RunMotionEstimation(std::vector<NV_ENC_OUTPUT_
     const uint32_t bfrIdx = m_iToSend % m_nEncoderBuffer;
 
     MapResources(bfrIdx);
-    
+
     NVENCSTATUS nvStatus = DoMotionEstimation(m_vMappedInputBuffers[bfrIdx], m_vMappedRefBuffers[bfrIdx], m_vMappedOutputBuffers[bfrIdx]);
 
-    if (nvStatus == NV_ENC_SUCCESS)
-    {
+    if (nvStatus == NV_ENC_SUCCESS) {
         m_iToSend++;
         GetEncodedPacket(pOutputBuffer, true);
-    }
-    else
-    {
+    } else {
         NVENC_THROW_ERROR("nvEncRunMotionEstimationOnly API failed", nvStatus);
     }
 }
@@ -225,41 +200,35 @@ void NvEncoderOutputInVidMemCuda::GetEncodedPacket(std::vector<NV_ENC_OUTPUT_PTR
     unsigned i = 0;
     int iEnd = bOutputDelay ? m_iToSend - m_nOutputDelay : m_iToSend;
 
-    for (; m_iGot < iEnd; m_iGot++)
-    {
-        if (m_vMappedOutputBuffers[m_iGot % m_nEncoderBuffer])
-        {
+    for (; m_iGot < iEnd; m_iGot++) {
+        if (m_vMappedOutputBuffers[m_iGot % m_nEncoderBuffer]) {
             NVENC_API_CALL(m_nvenc.nvEncUnmapInputResource(m_hEncoder, m_vMappedOutputBuffers[m_iGot % m_nEncoderBuffer]));
             m_vMappedOutputBuffers[m_iGot % m_nEncoderBuffer] = nullptr;
         }
-        
-        if (m_vMappedInputBuffers[m_iGot % m_nEncoderBuffer])
-        {
+
+        if (m_vMappedInputBuffers[m_iGot % m_nEncoderBuffer]) {
             NVENC_API_CALL(m_nvenc.nvEncUnmapInputResource(m_hEncoder, m_vMappedInputBuffers[m_iGot % m_nEncoderBuffer]));
             m_vMappedInputBuffers[m_iGot % m_nEncoderBuffer] = nullptr;
         }
 
-        if (m_bMotionEstimationOnly && m_vMappedRefBuffers[m_iGot % m_nEncoderBuffer])
-        {
+        if (m_bMotionEstimationOnly && m_vMappedRefBuffers[m_iGot % m_nEncoderBuffer]) {
             NVENC_API_CALL(m_nvenc.nvEncUnmapInputResource(m_hEncoder, m_vMappedRefBuffers[m_iGot % m_nEncoderBuffer]));
             m_vMappedRefBuffers[m_iGot % m_nEncoderBuffer] = nullptr;
         }
 
         pOutputBuffer.push_back(m_pOutputBuffers[(m_iGot % m_nEncoderBuffer)]);
-        
+
         i++;
     }
 }
 
 void NvEncoderOutputInVidMemCuda::FlushEncoder()
 {
-    if (!m_hEncoder)
-    {
+    if (!m_hEncoder) {
         return;
     }
 
-    if (!m_bMotionEstimationOnly)
-    {
+    if (!m_bMotionEstimationOnly) {
         std::vector<NV_ENC_OUTPUT_PTR> pOutputBuffer;
         EndEncode(pOutputBuffer);
     }
@@ -267,11 +236,10 @@ void NvEncoderOutputInVidMemCuda::FlushEncoder()
 
 void NvEncoderOutputInVidMemCuda::DestroyEncoder()
 {
-    if (!m_hEncoder)
-    {
+    if (!m_hEncoder) {
         return;
     }
-    
+
     // Incase of error it is possible for buffers still mapped to encoder.
     // flush the encoder queue and then unmapped it if any surface is still mapped
     FlushEncoder();
@@ -33,8 +33,8 @@ public:
     /**
     *  @brief  NvEncoderOutputInVidMem class constructor.
     */
-    NvEncoderOutputInVidMemCuda(CUcontext cuContext, uint32_t nWidth, uint32_t nHeight, NV_ENC_BUFFER_FORMAT eBufferFormat, 
-        bool bMotionEstimationOnly = false);
+    NvEncoderOutputInVidMemCuda(CUcontext cuContext, uint32_t nWidth, uint32_t nHeight, NV_ENC_BUFFER_FORMAT eBufferFormat,
+                                bool bMotionEstimationOnly = false);
 
     /**
     *  @brief  NvEncoder class virtual destructor.
@@ -52,9 +52,9 @@ public:
     *  @brief  This function is used to encode a frame.
     *  Applications must call EncodeFrame() function to encode the uncompressed
     *  data, which has been copied to an input buffer obtained from the
-    *  GetNextInputFrame() function. 
+    *  GetNextInputFrame() function.
     *  This function returns video memory buffer pointers containing compressed data
-    *  in pOutputBuffer. If there is buffering enabled, this may return without 
+    *  in pOutputBuffer. If there is buffering enabled, this may return without
     *  any data in pOutputBuffer.
     */
     void EncodeFrame(std::vector<NV_ENC_OUTPUT_PTR> &pOutputBuffer, NV_ENC_PIC_PARAMS *pPicParams = nullptr);
@@ -76,7 +76,7 @@ public:
     *  by calling GetNextReferenceFrame(), and copy the input frame data to
     *  the buffer obtained by calling GetNextInputFrame() before calling the
     *  RunMotionEstimation() function.
-    *  This function returns video memory buffer pointers containing 
+    *  This function returns video memory buffer pointers containing
     *  motion vector data in pOutputBuffer.
     */
     void RunMotionEstimation(std::vector<NV_ENC_OUTPUT_PTR> &pOutputBuffer);
@@ -90,7 +90,7 @@ public:
     void DestroyEncoder();
 
     /**
-    *  @brief This function is used to get the size of output buffer required to be 
+    *  @brief This function is used to get the size of output buffer required to be
     *  allocated in order to store the output.
     */
     uint32_t GetOutputBufferSize();
@@ -98,7 +98,7 @@ public:
 private:
 
     /**
-    *  @brief This function is used to allocate output buffers in video memory for storing 
+    *  @brief This function is used to allocate output buffers in video memory for storing
     *  encode or motion estimation output.
     */
     void AllocateOutputBuffers(uint32_t numOutputBuffers);
@@ -140,5 +140,5 @@ private:
 private:
     std::vector<NV_ENC_OUTPUT_PTR> m_vMappedOutputBuffers;
     std::vector<NV_ENC_OUTPUT_PTR> m_pOutputBuffers;
-    std::vector<NV_ENC_REGISTERED_PTR> m_vRegisteredResourcesOutputBuffer; 
+    std::vector<NV_ENC_REGISTERED_PTR> m_vRegisteredResourcesOutputBuffer;
 };
@@ -58,7 +58,7 @@ typedef struct _CUcontextlock_st *CUvideoctxlock;
 //! These enums are used in CUVIDDECODECREATEINFO and CUVIDDECODECAPS structures
 /*********************************************************************************/
 typedef enum cudaVideoCodec_enum {
-    cudaVideoCodec_MPEG1=0,                                         /**<  MPEG1             */
+    cudaVideoCodec_MPEG1 = 0,                                       /**<  MPEG1             */
     cudaVideoCodec_MPEG2,                                           /**<  MPEG2             */
     cudaVideoCodec_MPEG4,                                           /**<  MPEG4             */
     cudaVideoCodec_VC1,                                             /**<  VC1               */
@@ -71,11 +71,11 @@ typedef enum cudaVideoCodec_enum {
     cudaVideoCodec_VP9,                                             /**<  VP9               */
     cudaVideoCodec_NumCodecs,                                       /**<  Max codecs        */
     // Uncompressed YUV
-    cudaVideoCodec_YUV420 = (('I'<<24)|('Y'<<16)|('U'<<8)|('V')),   /**< Y,U,V (4:2:0)      */
-    cudaVideoCodec_YV12   = (('Y'<<24)|('V'<<16)|('1'<<8)|('2')),   /**< Y,V,U (4:2:0)      */
-    cudaVideoCodec_NV12   = (('N'<<24)|('V'<<16)|('1'<<8)|('2')),   /**< Y,UV  (4:2:0)      */
-    cudaVideoCodec_YUYV   = (('Y'<<24)|('U'<<16)|('Y'<<8)|('V')),   /**< YUYV/YUY2 (4:2:2)  */
-    cudaVideoCodec_UYVY   = (('U'<<24)|('Y'<<16)|('V'<<8)|('Y'))    /**< UYVY (4:2:2)       */
+    cudaVideoCodec_YUV420 = (('I' << 24) | ('Y' << 16) | ('U' << 8) | ('V')), /**< Y,U,V (4:2:0)      */
+    cudaVideoCodec_YV12   = (('Y' << 24) | ('V' << 16) | ('1' << 8) | ('2')), /**< Y,V,U (4:2:0)      */
+    cudaVideoCodec_NV12   = (('N' << 24) | ('V' << 16) | ('1' << 8) | ('2')), /**< Y,UV  (4:2:0)      */
+    cudaVideoCodec_YUYV   = (('Y' << 24) | ('U' << 16) | ('Y' << 8) | ('V')), /**< YUYV/YUY2 (4:2:2)  */
+    cudaVideoCodec_UYVY   = (('U' << 24) | ('Y' << 16) | ('V' << 8) | ('Y')) /**< UYVY (4:2:2)       */
 } cudaVideoCodec;
 
 /*********************************************************************************/
@@ -84,11 +84,11 @@ typedef enum cudaVideoCodec_enum {
 //! These enums are used in CUVIDDECODECREATEINFO structure
 /*********************************************************************************/
 typedef enum cudaVideoSurfaceFormat_enum {
-    cudaVideoSurfaceFormat_NV12=0,          /**< Semi-Planar YUV [Y plane followed by interleaved UV plane]     */
-    cudaVideoSurfaceFormat_P016=1,          /**< 16 bit Semi-Planar YUV [Y plane followed by interleaved UV plane].
+    cudaVideoSurfaceFormat_NV12 = 0,        /**< Semi-Planar YUV [Y plane followed by interleaved UV plane]     */
+    cudaVideoSurfaceFormat_P016 = 1,          /**< 16 bit Semi-Planar YUV [Y plane followed by interleaved UV plane].
                                                  Can be used for 10 bit(6LSB bits 0), 12 bit (4LSB bits 0)      */
-    cudaVideoSurfaceFormat_YUV444=2,        /**< Planar YUV [Y plane followed by U and V planes]                */
-    cudaVideoSurfaceFormat_YUV444_16Bit=3,  /**< 16 bit Planar YUV [Y plane followed by U and V planes]. 
+    cudaVideoSurfaceFormat_YUV444 = 2,      /**< Planar YUV [Y plane followed by U and V planes]                */
+    cudaVideoSurfaceFormat_YUV444_16Bit = 3,  /**< 16 bit Planar YUV [Y plane followed by U and V planes].
                                                  Can be used for 10 bit(6LSB bits 0), 12 bit (4LSB bits 0)      */
 } cudaVideoSurfaceFormat;
 
@@ -100,7 +100,7 @@ typedef enum cudaVideoSurfaceFormat_enum {
 //! cudaVideoDeinterlaceMode_Adaptive needs more video memory than other DImodes
 /******************************************************************************************************************/
 typedef enum cudaVideoDeinterlaceMode_enum {
-    cudaVideoDeinterlaceMode_Weave=0,   /**< Weave both fields (no deinterlacing) */
+    cudaVideoDeinterlaceMode_Weave = 0, /**< Weave both fields (no deinterlacing) */
     cudaVideoDeinterlaceMode_Bob,       /**< Drop one field                       */
     cudaVideoDeinterlaceMode_Adaptive   /**< Adaptive deinterlacing               */
 } cudaVideoDeinterlaceMode;
@@ -111,7 +111,7 @@ typedef enum cudaVideoDeinterlaceMode_enum {
 //! These enums are used in CUVIDDECODECREATEINFO and CUVIDDECODECAPS structures
 /**************************************************************************************************************/
 typedef enum cudaVideoChromaFormat_enum {
-    cudaVideoChromaFormat_Monochrome=0,  /**< MonoChrome */
+    cudaVideoChromaFormat_Monochrome = 0, /**< MonoChrome */
     cudaVideoChromaFormat_420,           /**< YUV 4:2:0  */
     cudaVideoChromaFormat_422,           /**< YUV 4:2:2  */
     cudaVideoChromaFormat_444            /**< YUV 4:4:4  */
@@ -135,22 +135,20 @@ typedef enum cudaVideoCreateFlags_enum {
 //! Decode status enums
 //! These enums are used in CUVIDGETDECODESTATUS structure
 /*************************************************************************/
-typedef enum cuvidDecodeStatus_enum
-{
+typedef enum cuvidDecodeStatus_enum {
     cuvidDecodeStatus_Invalid         = 0,   // Decode status is not valid
     cuvidDecodeStatus_InProgress      = 1,   // Decode is in progress
     cuvidDecodeStatus_Success         = 2,   // Decode is completed without any errors
     // 3 to 7 enums are reserved for future use
     cuvidDecodeStatus_Error           = 8,   // Decode is completed with an error (error is not concealed)
-    cuvidDecodeStatus_Error_Concealed = 9,   // Decode is completed with an error and error is concealed 
+    cuvidDecodeStatus_Error_Concealed = 9,   // Decode is completed with an error and error is concealed
 } cuvidDecodeStatus;
 
 /**************************************************************************************************************/
 //! \struct CUVIDDECODECAPS;
 //! This structure is used in cuvidGetDecoderCaps API
 /**************************************************************************************************************/
-typedef struct _CUVIDDECODECAPS
-{
+typedef struct _CUVIDDECODECAPS {
     cudaVideoCodec          eCodecType;                 /**< IN: cudaVideoCodec_XXX                                             */
     cudaVideoChromaFormat   eChromaFormat;              /**< IN: cudaVideoChromaFormat_XXX                                      */
     unsigned int            nBitDepthMinus8;            /**< IN: The Value "BitDepth minus 8"                                   */
@@ -172,8 +170,7 @@ typedef struct _CUVIDDECODECAPS
 //! \struct CUVIDDECODECREATEINFO
 //! This structure is used in cuvidCreateDecoder API
 /**************************************************************************************************************/
-typedef struct _CUVIDDECODECREATEINFO
-{
+typedef struct _CUVIDDECODECREATEINFO {
     unsigned long ulWidth;              /**< IN: Coded sequence width in pixels                                             */
     unsigned long ulHeight;             /**< IN: Coded sequence height in pixels                                            */
     unsigned long ulNumDecodeSurfaces;  /**< IN: Maximum number of internal decode surfaces                                 */
@@ -187,7 +184,7 @@ typedef struct _CUVIDDECODECREATEINFO
                                              are not supported. However decoding might fail if the flag is enabled in case
                                              of supported codecs for regular bit streams having P and/or B frames.          */
     unsigned long ulMaxWidth;           /**< IN: Coded sequence max width in pixels used with reconfigure Decoder           */
-    unsigned long ulMaxHeight;          /**< IN: Coded sequence max height in pixels used with reconfigure Decoder          */                                           
+    unsigned long ulMaxHeight;          /**< IN: Coded sequence max height in pixels used with reconfigure Decoder          */
     unsigned long Reserved1;            /**< Reserved for future use - set to zero                                          */
     /**
     * IN: area of the frame that should be displayed
@@ -204,7 +201,7 @@ typedef struct _CUVIDDECODECREATEINFO
     unsigned long ulTargetWidth;               /**< IN: Post-processed output width (Should be aligned to 2)           */
     unsigned long ulTargetHeight;              /**< IN: Post-processed output height (Should be aligned to 2)          */
     unsigned long ulNumOutputSurfaces;         /**< IN: Maximum number of output surfaces simultaneously mapped        */
-    CUvideoctxlock vidLock;                    /**< IN: If non-NULL, context lock used for synchronizing ownership of 
+    CUvideoctxlock vidLock;                    /**< IN: If non-NULL, context lock used for synchronizing ownership of
                                                     the cuda context. Needed for cudaVideoCreate_PreferCUDA decode     */
     /**
     * IN: target rectangle in the output frame (for aspect ratio conversion)
@@ -224,8 +221,7 @@ typedef struct _CUVIDDECODECREATEINFO
 //! H.264 DPB entry
 //! This structure is used in CUVIDH264PICPARAMS structure
 /*********************************************************/
-typedef struct _CUVIDH264DPBENTRY
-{
+typedef struct _CUVIDH264DPBENTRY {
     int PicIdx;                 /**< picture index of reference frame                                        */
     int FrameIdx;               /**< frame_num(short-term) or LongTermFrameIdx(long-term)                    */
     int is_long_term;           /**< 0=short term reference, 1=long term reference                           */
@@ -239,8 +235,7 @@ typedef struct _CUVIDH264DPBENTRY
 //! H.264 MVC picture parameters ext
 //! This structure is used in CUVIDH264PICPARAMS structure
 /************************************************************/
-typedef struct _CUVIDH264MVCEXT
-{
+typedef struct _CUVIDH264MVCEXT {
     int num_views_minus1;                  /**< Max number of coded views minus 1 in video : Range - 0 to 1023              */
     int view_id;                           /**< view identifier                                                             */
     unsigned char inter_view_flag;         /**< 1 if used for inter-view prediction, 0 if not                               */
@@ -256,8 +251,7 @@ typedef struct _CUVIDH264MVCEXT
 //! H.264 SVC picture parameters ext
 //! This structure is used in CUVIDH264PICPARAMS structure
 /*********************************************************/
-typedef struct _CUVIDH264SVCEXT
-{
+typedef struct _CUVIDH264SVCEXT {
     unsigned char profile_idc;
     unsigned char level_idc;
     unsigned char DQId;
@@ -287,7 +281,7 @@ typedef struct _CUVIDH264SVCEXT
     short scaled_ref_layer_right_offset;
     short scaled_ref_layer_bottom_offset;
     unsigned short Reserved16Bits;
-    struct _CUVIDPICPARAMS *pNextLayer; /**< Points to the picparams for the next layer to be decoded. 
+    struct _CUVIDPICPARAMS *pNextLayer; /**< Points to the picparams for the next layer to be decoded.
                                              Linked list ends at the target layer. */
     int bRefBaseLayer;                  /**< whether to store ref base pic */
 } CUVIDH264SVCEXT;
@@ -297,8 +291,7 @@ typedef struct _CUVIDH264SVCEXT
 //! H.264 picture parameters
 //! This structure is used in CUVIDPICPARAMS structure
 /******************************************************/
-typedef struct _CUVIDH264PICPARAMS
-{
+typedef struct _CUVIDH264PICPARAMS {
     // SPS
     int log2_max_frame_num_minus4;
     int pic_order_cnt_type;
@@ -340,15 +333,13 @@ typedef struct _CUVIDH264PICPARAMS
     unsigned char slice_group_map_type;
     signed char pic_init_qs_minus26;
     unsigned int slice_group_change_rate_minus1;
-    union
-    {
+    union {
         unsigned long long slice_group_map_addr;
         const unsigned char *pMb2SliceGroupMap;
     } fmo;
     unsigned int  Reserved[12];
     // SVC/MVC
-    union
-    {
+    union {
         CUVIDH264MVCEXT mvcext;
         CUVIDH264SVCEXT svcext;
     };
@@ -360,8 +351,7 @@ typedef struct _CUVIDH264PICPARAMS
 //! MPEG-2 picture parameters
 //! This structure is used in CUVIDPICPARAMS structure
 /********************************************************/
-typedef struct _CUVIDMPEG2PICPARAMS
-{
+typedef struct _CUVIDMPEG2PICPARAMS {
     int ForwardRefIdx;          // Picture index of forward reference (P/B-frames)
     int BackwardRefIdx;         // Picture index of backward reference (B-frames)
     int picture_coding_type;
@@ -391,8 +381,7 @@ typedef struct _CUVIDMPEG2PICPARAMS
 //! MPEG-4 picture parameters
 //! This structure is used in CUVIDPICPARAMS structure
 /*******************************************************/
-typedef struct _CUVIDMPEG4PICPARAMS
-{
+typedef struct _CUVIDMPEG4PICPARAMS {
     int ForwardRefIdx;          // Picture index of forward reference (P/B-frames)
     int BackwardRefIdx;         // Picture index of backward reference (B-frames)
     // VOL
@@ -426,8 +415,7 @@ typedef struct _CUVIDMPEG4PICPARAMS
 //! VC1 picture parameters
 //! This structure is used in CUVIDPICPARAMS structure
 /********************************************************/
-typedef struct _CUVIDVC1PICPARAMS
-{
+typedef struct _CUVIDVC1PICPARAMS {
     int ForwardRefIdx;      /**< Picture index of forward reference (P/B-frames) */
     int BackwardRefIdx;     /**< Picture index of backward reference (B-frames)  */
     int FrameWidth;         /**< Actual frame width                              */
@@ -471,8 +459,7 @@ typedef struct _CUVIDVC1PICPARAMS
 //! JPEG picture parameters
 //! This structure is used in CUVIDPICPARAMS structure
 /***********************************************************/
-typedef struct _CUVIDJPEGPICPARAMS
-{
+typedef struct _CUVIDJPEGPICPARAMS {
     int Reserved;
 } CUVIDJPEGPICPARAMS;
 
@@ -482,8 +469,7 @@ typedef struct _CUVIDJPEGPICPARAMS
 //! HEVC picture parameters
 //! This structure is used in CUVIDPICPARAMS structure
 /*******************************************************/
-typedef struct _CUVIDHEVCPICPARAMS
-{
+typedef struct _CUVIDHEVCPICPARAMS {
     // sps
     int pic_width_in_luma_samples;
     int pic_height_in_luma_samples;
@@ -621,8 +607,7 @@ typedef struct _CUVIDHEVCPICPARAMS
 //! VP8 picture parameters
 //! This structure is used in CUVIDPICPARAMS structure
 /***********************************************************/
-typedef struct _CUVIDVP8PICPARAMS
-{
+typedef struct _CUVIDVP8PICPARAMS {
     int width;
     int height;
     unsigned int first_partition_size;
@@ -637,7 +622,7 @@ typedef struct _CUVIDVP8PICPARAMS
             unsigned char show_frame : 1;
             unsigned char update_mb_segmentation_data : 1;    /**< Must be 0 if segmentation is not enabled */
             unsigned char Reserved2Bits : 2;
-        }vp8_frame_tag;
+        } vp8_frame_tag;
         unsigned char wFrameTagFlags;
     };
     unsigned char Reserved1[4];
@@ -649,8 +634,7 @@ typedef struct _CUVIDVP8PICPARAMS
 //! VP9 picture parameters
 //! This structure is used in CUVIDPICPARAMS structure
 /***********************************************************/
-typedef struct _CUVIDVP9PICPARAMS
-{
+typedef struct _CUVIDVP9PICPARAMS {
     unsigned int width;
     unsigned int height;
 
@@ -722,8 +706,7 @@ typedef struct _CUVIDVP9PICPARAMS
 //! This structure is used in cuvidDecodePicture API
 //! IN  for cuvidDecodePicture
 /******************************************************************************************/
-typedef struct _CUVIDPICPARAMS
-{
+typedef struct _CUVIDPICPARAMS {
     int PicWidthInMbs;                     /**< IN: Coded frame size in macroblocks                           */
     int FrameHeightInMbs;                  /**< IN: Coded frame height in macroblocks                         */
     int CurrPicIdx;                        /**< IN: Output index of the current picture                       */
@@ -734,7 +717,7 @@ typedef struct _CUVIDPICPARAMS
     unsigned int nBitstreamDataLen;        /**< IN: Number of bytes in bitstream data buffer                  */
     const unsigned char *pBitstreamData;   /**< IN: Ptr to bitstream data for this picture (slice-layer)      */
     unsigned int nNumSlices;               /**< IN: Number of slices in this picture                          */
-    const unsigned int *pSliceDataOffsets; /**< IN: nNumSlices entries, contains offset of each slice within 
+    const unsigned int *pSliceDataOffsets; /**< IN: nNumSlices entries, contains offset of each slice within
                                                         the bitstream data buffer                             */
     int ref_pic_flag;                      /**< IN: This picture is a reference picture                       */
     int intra_pic_flag;                    /**< IN: This picture is entirely intra coded                      */
@@ -759,8 +742,7 @@ typedef struct _CUVIDPICPARAMS
 //! Picture parameters for postprocessing
 //! This structure is used in cuvidMapVideoFrame API
 /******************************************************/
-typedef struct _CUVIDPROCPARAMS
-{
+typedef struct _CUVIDPROCPARAMS {
     int progressive_frame;              /**< IN: Input is progressive (deinterlace_mode will be ignored)                */
     int second_field;                   /**< IN: Output the second field (ignored if deinterlace mode is Weave)         */
     int top_field_first;                /**< IN: Input frame is top field first (1st field is top, 2nd field is bottom) */
@@ -784,8 +766,7 @@ typedef struct _CUVIDPROCPARAMS
 //! Struct for reporting decode status.
 //! This structure is used in cuvidGetDecodeStatus API.
 /*********************************************************************************************************/
-typedef struct _CUVIDGETDECODESTATUS
-{
+typedef struct _CUVIDGETDECODESTATUS {
     cuvidDecodeStatus decodeStatus;
     unsigned int reserved[31];
     void *pReserved[8];
@@ -796,8 +777,7 @@ typedef struct _CUVIDGETDECODESTATUS
 //! Struct for decoder reset
 //! This structure is used in cuvidReconfigureDecoder() API
 /****************************************************/
-typedef struct _CUVIDRECONFIGUREDECODERINFO
-{
+typedef struct _CUVIDRECONFIGUREDECODERINFO {
     unsigned int ulWidth;             /**< IN: Coded sequence width in pixels, MUST be < = ulMaxWidth defined at CUVIDDECODECREATEINFO  */
     unsigned int ulHeight;            /**< IN: Coded sequence height in pixels, MUST be < = ulMaxHeight defined at CUVIDDECODECREATEINFO  */
     unsigned int ulTargetWidth;       /**< IN: Post processed output width */
@@ -823,7 +803,7 @@ typedef struct _CUVIDRECONFIGUREDECODERINFO
         short bottom;
     } target_rect;
     unsigned int reserved2[11]; /**< Reserved for future use. Set to Zero */
-} CUVIDRECONFIGUREDECODERINFO; 
+} CUVIDRECONFIGUREDECODERINFO;
 
 
 /***********************************************************************************************************/
@@ -862,7 +842,7 @@ typedef struct _CUVIDRECONFIGUREDECODERINFO
 //!    If IN parameters passed to the driver are not supported by NVDEC-HW, then all OUT params are set to 0.
 //! E.g. on Geforce GTX 960:
 //!   App fills - eCodecType = cudaVideoCodec_H264; eChromaFormat = cudaVideoChromaFormat_420; nBitDepthMinus8 = 0;
-//!   Given IN parameters are supported, hence driver fills: bIsSupported = 1; nMinWidth   = 48; nMinHeight  = 16; 
+//!   Given IN parameters are supported, hence driver fills: bIsSupported = 1; nMinWidth   = 48; nMinHeight  = 16;
 //!   nMaxWidth = 4096; nMaxHeight = 4096; nMaxMBCount = 65536;
 //! CodedWidth*CodedHeight/256 must be less than or equal to nMaxMBCount
 /**********************************************************************************************************************/
@@ -883,7 +863,7 @@ extern CUresult CUDAAPI cuvidDestroyDecoder(CUvideodecoder hDecoder);
 /*****************************************************************************************************/
 //! \fn CUresult CUDAAPI cuvidDecodePicture(CUvideodecoder hDecoder, CUVIDPICPARAMS *pPicParams)
 //! Decode a single picture (field or frame)
-//! Kicks off HW decoding 
+//! Kicks off HW decoding
 /*****************************************************************************************************/
 extern CUresult CUDAAPI cuvidDecodePicture(CUvideodecoder hDecoder, CUVIDPICPARAMS *pPicParams);
 
@@ -895,15 +875,15 @@ extern CUresult CUDAAPI cuvidGetDecodeStatus(CUvideodecoder hDecoder, int nPicId
 
 /*********************************************************************************************************/
 //! \fn CUresult CUDAAPI cuvidReconfigureDecoder(CUvideodecoder hDecoder, CUVIDRECONFIGUREDECODERINFO *pDecReconfigParams)
-//! Used to reuse single decoder for multiple clips. Currently supports resolution change, resize params, display area 
-//! params, target area params change for same codec. Must be called during CUVIDPARSERPARAMS::pfnSequenceCallback 
+//! Used to reuse single decoder for multiple clips. Currently supports resolution change, resize params, display area
+//! params, target area params change for same codec. Must be called during CUVIDPARSERPARAMS::pfnSequenceCallback
 /*********************************************************************************************************/
 extern CUresult CUDAAPI cuvidReconfigureDecoder(CUvideodecoder hDecoder, CUVIDRECONFIGUREDECODERINFO *pDecReconfigParams);
 
 
 #if !defined(__CUVID_DEVPTR64) || defined(__CUVID_INTERNAL)
 /************************************************************************************************************************/
-//! \fn CUresult CUDAAPI cuvidMapVideoFrame(CUvideodecoder hDecoder, int nPicIdx, unsigned int *pDevPtr, 
+//! \fn CUresult CUDAAPI cuvidMapVideoFrame(CUvideodecoder hDecoder, int nPicIdx, unsigned int *pDevPtr,
 //!                                         unsigned int *pPitch, CUVIDPROCPARAMS *pVPP);
 //! Post-process and map video frame corresponding to nPicIdx for use in cuda. Returns cuda device pointer and associated
 //! pitch of the video frame
@@ -921,7 +901,7 @@ extern CUresult CUDAAPI cuvidUnmapVideoFrame(CUvideodecoder hDecoder, unsigned i
 
 #if defined(_WIN64) || defined(__LP64__) || defined(__x86_64) || defined(AMD64) || defined(_M_AMD64)
 /****************************************************************************************************************************/
-//! \fn CUresult CUDAAPI cuvidMapVideoFrame64(CUvideodecoder hDecoder, int nPicIdx, unsigned long long *pDevPtr, 
+//! \fn CUresult CUDAAPI cuvidMapVideoFrame64(CUvideodecoder hDecoder, int nPicIdx, unsigned long long *pDevPtr,
 //!                                           unsigned int * pPitch, CUVIDPROCPARAMS *pVPP);
 //! Post-process and map video frame corresponding to nPicIdx for use in cuda. Returns cuda device pointer and associated
 //! pitch of the video frame
@@ -993,8 +973,8 @@ class CCtxAutoLock
 private:
     CUvideoctxlock m_ctx;
 public:
-    CCtxAutoLock(CUvideoctxlock ctx):m_ctx(ctx) { cuvidCtxLock(m_ctx,0); }
-    ~CCtxAutoLock() { cuvidCtxUnlock(m_ctx,0); }
+    CCtxAutoLock(CUvideoctxlock ctx): m_ctx(ctx) { cuvidCtxLock(m_ctx, 0); }
+    ~CCtxAutoLock() { cuvidCtxUnlock(m_ctx, 0); }
 };
 #endif /* __cplusplus */
 
@@ -70,7 +70,7 @@ typedef enum {
 //! Used in CUAUDIOFORMAT structure
 /************************************************************************/
 typedef enum {
-    cudaAudioCodec_MPEG1=0,         /**< MPEG-1 Audio               */
+    cudaAudioCodec_MPEG1 = 0,       /**< MPEG-1 Audio               */
     cudaAudioCodec_MPEG2,           /**< MPEG-2 Audio               */
     cudaAudioCodec_MP3,             /**< MPEG-1 Layer III Audio     */
     cudaAudioCodec_AC3,             /**< Dolby Digital (AC3) Audio  */
@@ -84,12 +84,11 @@ typedef enum {
 //! Video format
 //! Used in cuvidGetSourceVideoFormat API
 /************************************************************************************************/
-typedef struct
-{
+typedef struct {
     cudaVideoCodec codec;                   /**< OUT: Compression format          */
-   /**
-    * OUT: frame rate = numerator / denominator (for example: 30000/1001)
-    */
+    /**
+     * OUT: frame rate = numerator / denominator (for example: 30000/1001)
+     */
     struct {
         /**< OUT: frame rate numerator   (0 = unspecified or variable frame rate) */
         unsigned int numerator;
@@ -112,12 +111,12 @@ typedef struct
                                                       returned to parser during sequence callback.                     */
     unsigned int coded_width;               /**< OUT: coded frame width in pixels                                      */
     unsigned int coded_height;              /**< OUT: coded frame height in pixels                                     */
-   /**
-    * area of the frame that should be displayed
-    * typical example:
-    * coded_width = 1920, coded_height = 1088
-    * display_area = { 0,0,1920,1080 }
-    */
+    /**
+     * area of the frame that should be displayed
+     * typical example:
+     * coded_width = 1920, coded_height = 1088
+     * display_area = { 0,0,1920,1080 }
+     */
     struct {
         int left;                           /**< OUT: left position of display rect    */
         int top;                            /**< OUT: top position of display rect     */
@@ -126,9 +125,9 @@ typedef struct
     } display_area;
     cudaVideoChromaFormat chroma_format;    /**< OUT:  Chroma format                   */
     unsigned int bitrate;                   /**< OUT: video bitrate (bps, 0=unknown)   */
-   /**
-    * OUT: Display Aspect Ratio = x:y (4:3, 16:9, etc)
-    */
+    /**
+     * OUT: Display Aspect Ratio = x:y (4:3, 16:9, etc)
+     */
     struct {
         int x;
         int y;
@@ -154,8 +153,7 @@ typedef struct
 //! Video format including raw sequence header information
 //! Used in cuvidGetSourceVideoFormat API
 /****************************************************************/
-typedef struct
-{
+typedef struct {
     CUVIDEOFORMAT format;                 /**< OUT: CUVIDEOFORMAT structure */
     unsigned char raw_seqhdr_data[1024];  /**< OUT: Sequence header data    */
 } CUVIDEOFORMATEX;
@@ -166,8 +164,7 @@ typedef struct
 //! Audio formats
 //! Used in cuvidGetSourceAudioFormat API
 /****************************************************************/
-typedef struct
-{
+typedef struct {
     cudaAudioCodec codec;       /**< OUT: Compression format                                              */
     unsigned int channels;      /**< OUT: number of audio channels                                        */
     unsigned int samplespersec; /**< OUT: sampling frequency                                              */
@@ -199,8 +196,7 @@ typedef enum {
 //! Used in cuvidParseVideoData API
 //! IN for cuvidParseVideoData
 /*****************************************************************************/
-typedef struct _CUVIDSOURCEDATAPACKET
-{
+typedef struct _CUVIDSOURCEDATAPACKET {
     unsigned long flags;            /**< IN: Combination of CUVID_PKT_XXX flags                              */
     unsigned long payload_size;     /**< IN: number of bytes in the payload (may be zero if EOS flag is set) */
     const unsigned char *payload;   /**< IN: Pointer to packet payload data (may be NULL if EOS flag is set) */
@@ -218,8 +214,7 @@ typedef int (CUDAAPI *PFNVIDSOURCECALLBACK)(void *, CUVIDSOURCEDATAPACKET *);
 //! NVDECODE API is intended for HW accelerated video decoding so CUvideosource doesn't have audio demuxer for all supported
 //! containers. It's recommended to clients to use their own or third party demuxer if audio support is needed.
 /**************************************************************************************************************************/
-typedef struct _CUVIDSOURCEPARAMS
-{
+typedef struct _CUVIDSOURCEPARAMS {
     unsigned int ulClockRate;                   /**< IN: Time stamp units in Hz (0=default=10000000Hz)      */
     unsigned int uReserved1[7];                 /**< Reserved for future use - set to zero                  */
     void *pUserData;                            /**< IN: User private data passed in to the data handlers   */
@@ -243,9 +238,9 @@ typedef enum {
 /***************************************************************************************************************************/
 //! \ingroup FUNCTS
 //! \fn CUresult CUDAAPI cuvidCreateVideoSource(CUvideosource *pObj, const char *pszFileName, CUVIDSOURCEPARAMS *pParams)
-//! Create CUvideosource object. CUvideosource spawns demultiplexer thread that provides two callbacks: 
+//! Create CUvideosource object. CUvideosource spawns demultiplexer thread that provides two callbacks:
 //! pfnVideoDataHandler() and pfnAudioDataHandler()
-//! NVDECODE API is intended for HW accelerated video decoding so CUvideosource doesn't have audio demuxer for all supported 
+//! NVDECODE API is intended for HW accelerated video decoding so CUvideosource doesn't have audio demuxer for all supported
 //! containers. It's recommended to clients to use their own or third party demuxer if audio support is needed.
 /***************************************************************************************************************************/
 CUresult CUDAAPI cuvidCreateVideoSource(CUvideosource *pObj, const char *pszFileName, CUVIDSOURCEPARAMS *pParams);
@@ -296,7 +291,7 @@ CUresult CUDAAPI cuvidGetSourceVideoFormat(CUvideosource obj, CUVIDEOFORMAT *pvi
 //! \ingroup FUNCTS
 //! \fn CUresult CUDAAPI cuvidGetSourceAudioFormat(CUvideosource obj, CUAUDIOFORMAT *paudfmt, unsigned int flags)
 //! Get audio source format
-//! NVDECODE API is intended for HW accelerated video decoding so CUvideosource doesn't have audio demuxer for all supported 
+//! NVDECODE API is intended for HW accelerated video decoding so CUvideosource doesn't have audio demuxer for all supported
 //! containers. It's recommended to clients to use their own or third party demuxer if audio support is needed.
 /**************************************************************************************************************************/
 CUresult CUDAAPI cuvidGetSourceAudioFormat(CUvideosource obj, CUAUDIOFORMAT *paudfmt, unsigned int flags);
@@ -307,12 +302,11 @@ CUresult CUDAAPI cuvidGetSourceAudioFormat(CUvideosource obj, CUAUDIOFORMAT *pau
 //! \struct CUVIDPARSERDISPINFO
 //! Used in cuvidParseVideoData API with PFNVIDDISPLAYCALLBACK pfnDisplayPicture
 /**********************************************************************************/
-typedef struct _CUVIDPARSERDISPINFO
-{
+typedef struct _CUVIDPARSERDISPINFO {
     int picture_index;          /**< OUT: Index of the current picture                                                         */
     int progressive_frame;      /**< OUT: 1 if progressive frame; 0 otherwise                                                  */
     int top_field_first;        /**< OUT: 1 if top field is displayed first; 0 otherwise                                       */
-    int repeat_first_field;     /**< OUT: Number of additional fields (1=ivtc, 2=frame doubling, 4=frame tripling, 
+    int repeat_first_field;     /**< OUT: Number of additional fields (1=ivtc, 2=frame doubling, 4=frame tripling,
                                      -1=unpaired field)                                                                        */
     CUvideotimestamp timestamp; /**< OUT: Presentation time stamp                                                              */
 } CUVIDPARSERDISPINFO;
@@ -337,12 +331,11 @@ typedef int (CUDAAPI *PFNVIDDISPLAYCALLBACK)(void *, CUVIDPARSERDISPINFO *);
 //! \struct CUVIDPARSERPARAMS
 //! Used in cuvidCreateVideoParser API
 /**************************************/
-typedef struct _CUVIDPARSERPARAMS
-{
+typedef struct _CUVIDPARSERPARAMS {
     cudaVideoCodec CodecType;                   /**< IN: cudaVideoCodec_XXX                                                  */
     unsigned int ulMaxNumDecodeSurfaces;        /**< IN: Max # of decode surfaces (parser will cycle through these)          */
     unsigned int ulClockRate;                   /**< IN: Timestamp units in Hz (0=default=10000000Hz)                        */
-    unsigned int ulErrorThreshold;              /**< IN: % Error threshold (0-100) for calling pfnDecodePicture (100=always 
+    unsigned int ulErrorThreshold;              /**< IN: % Error threshold (0-100) for calling pfnDecodePicture (100=always
                                                      IN: call pfnDecodePicture even if picture bitstream is fully corrupted) */
     unsigned int ulMaxDisplayDelay;             /**< IN: Max display queue delay (improves pipelining of decode with display)
                                                          0=no delay (recommended values: 2..4)                               */
@@ -365,8 +358,8 @@ CUresult CUDAAPI cuvidCreateVideoParser(CUvideoparser *pObj, CUVIDPARSERPARAMS *
 /************************************************************************************************/
 //! \ingroup FUNCTS
 //! \fn CUresult CUDAAPI cuvidParseVideoData(CUvideoparser obj, CUVIDSOURCEDATAPACKET *pPacket)
-//! Parse the video data from source data packet in pPacket 
-//! Extracts parameter sets like SPS, PPS, bitstream etc. from pPacket and 
+//! Parse the video data from source data packet in pPacket
+//! Extracts parameter sets like SPS, PPS, bitstream etc. from pPacket and
 //! calls back pfnDecodePicture with CUVIDPICPARAMS data for kicking of HW decoding
 //! calls back pfnSequenceCallback with CUVIDEOFORMAT data for initial sequence header or when
 //! the decoder encounters a video format change
@@ -30,6 +30,7 @@ typedef void* MppApi;
 #include <functional>
 
 typedef std::function<void (void *, size_t)> rvpu_callback_t;
+// on_packet runs on the completion thread of the session
 void set_rvpu_callback(MppCtx ctx,
     rvpu_callback_t on_ctrl_prep, 
     rvpu_callback_t on_packet,
@@ -60,6 +61,38 @@ int process_rvpu(int fd, MppCtx ctx);
  */
 int process_rvpu_message(const uint8_t *data, size_t size, MppCtx ctx);
 
+typedef void* RvpuDispatcher;
+
+/**
+ * Called by dispatcher when peer of a session is closed, owner is the one
+ * given to rvpu_target_init and should close fd and destroy ctx
+ */
+typedef void (*rvpu_close_t)(void *owner, MppCtx ctx, int fd);
+
+/**
+ * Create dispatcher serving many rvpu-stub sessions with a thread pool
+ * @param dispatcher OUT created dispatcher
+ * @param threads number of threads, 0 for number of cpus
+ * @param on_close called when a session is dropped, NULL to close fd only
+ * @return 0 for success, else wise errcode
+ */
+int rvpu_dispatcher_init(RvpuDispatcher *dispatcher, int threads, rvpu_close_t on_close);
+
+/**
+ * Serve socket fd of a rvpu-stub peer with mpp context
+ * @param dispatcher dispatcher
+ * @param fd connected socket fd
+ * @param ctx mpp context, \ref rvpu_target_init
+ * @return 0 for success, else wise errcode
+ */
+int rvpu_dispatcher_add(RvpuDispatcher dispatcher, int fd, MppCtx ctx);
+
+/**
+ * Stop threads and drop all sessions
+ * @param dispatcher dispatcher
+ */
+void rvpu_dispatcher_deinit(RvpuDispatcher dispatcher);
+
 #ifdef __cplusplus
 }   /* extern C */
 #endif
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2019-2020 FoilPlanet. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_TAG "mpp_rvpu_backend"
+
+#include <pthread.h>
+#include <string.h>
+
+#include "mpp_log.h"
+
+#include "rvpu_backend.h"
+
+/*
+ * Backends are only appended, so a pointer handed out stays valid and its
+ * position is a stable iteration point.
+ */
+static const RvpuBackend *backends[RVPU_MAX_BACKENDS];
+static RK_U32 backend_count = 0;
+static RK_U32 disabled_caps = 0;
+static pthread_mutex_t backend_lock = PTHREAD_MUTEX_INITIALIZER;
+
+MPP_RET rvpu_backend_register(const RvpuBackend *backend)
+{
+    MPP_RET ret = MPP_OK;
+    RK_U32 i;
+
+    if (NULL == backend || NULL == backend->name)
+        return MPP_ERR_NULL_PTR;
+
+    pthread_mutex_lock(&backend_lock);
+    for (i = 0; i < backend_count; i++) {
+        if (!strcmp(backends[i]->name, backend->name))
+            break;
+    }
+
+    if (i < backend_count) {
+        // already registered
+    } else if (backend_count >= RVPU_MAX_BACKENDS) {
+        mpp_err("too many backends, drop %s", backend->name);
+        ret = MPP_NOK;
+    } else {
+        backends[backend_count++] = backend;
+    }
+    pthread_mutex_unlock(&backend_lock);
+
+    return ret;
+}
+
+void rvpu_backend_disable(RK_U32 caps)
+{
+    pthread_mutex_lock(&backend_lock);
+    disabled_caps |= caps;
+    pthread_mutex_unlock(&backend_lock);
+}
+
+const RvpuBackend *rvpu_backend_find(const char *name)
+{
+    const RvpuBackend *found = NULL;
+    RK_U32 i;
+
+    if (NULL == name)
+        return NULL;
+
+    pthread_mutex_lock(&backend_lock);
+    for (i = 0; i < backend_count; i++) {
+        if (!strcmp(backends[i]->name, name)) {
+            if (!(backends[i]->caps & disabled_caps))
+                found = backends[i];
+            break;
+        }
+    }
+    pthread_mutex_unlock(&backend_lock);
+
+    return found;
+}
+
+const RvpuBackend *rvpu_backend_next(const RvpuBackend *prev, RK_U32 caps)
+{
+    const RvpuBackend *found = NULL;
+    RK_U32 i = 0;
+
+    pthread_mutex_lock(&backend_lock);
+    if (prev) {
+        while (i < backend_count && backends[i] != prev)
+            i++;
+        i++;
+    }
+
+    for (; i < backend_count; i++) {
+        const RvpuBackend *b = backends[i];
+        if ((b->caps & caps) == caps && !(b->caps & disabled_caps)) {
+            found = b;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&backend_lock);
+
+    return found;
+}
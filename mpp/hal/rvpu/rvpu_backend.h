@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2019-2020 FoilPlanet. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __HAL_RVPU_BACKEND_H__
+#define __HAL_RVPU_BACKEND_H__
+
+#include "mpp_hal.h"
+
+/* what a backend does */
+#define RVPU_CAP_ENC_AVC            (0x00000001)
+#define RVPU_CAP_DEC_AVC            (0x00000002)
+
+/* where it runs */
+#define RVPU_CAP_SOFT               (0x00000100)    /**< cpu of this process */
+#define RVPU_CAP_REMOTE             (0x00000200)    /**< server behind rvpu socket */
+#define RVPU_CAP_HW                 (0x00000400)    /**< local gpu / vpu */
+
+/* max number of registered backends */
+#define RVPU_MAX_BACKENDS           8
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Codec backend behind a stub hal, selected per context at hal init.
+ * Functions take the hal context of the stub and keep their own state in its
+ * extra_info. A backend returns MPP_ERR_VPUHW when its device is gone, the
+ * stub then moves the context to the next backend.
+ */
+typedef struct rvpu_backend_t {
+    const char     *name;
+    RK_U32          caps;       /**< RVPU_CAP_XXX */
+
+    // MPP_OK when usable on this host, NULL for always
+    MPP_RET (*probe)(void);
+
+    MPP_RET (*init)(void *hal, MppHalCfg *cfg);
+    MPP_RET (*deinit)(void *hal);
+    MPP_RET (*reg_gen)(void *hal, HalTaskInfo *task);
+    MPP_RET (*start)(void *hal, HalTaskInfo *task);
+    MPP_RET (*wait)(void *hal, HalTaskInfo *task);
+    MPP_RET (*reset)(void *hal);
+    MPP_RET (*flush)(void *hal);
+    MPP_RET (*control)(void *hal, RK_S32 cmd, void *param);
+} RvpuBackend;
+
+/**
+ * Add a backend, earlier ones are preferred
+ * @param backend must stay valid, registering a name twice is ignored
+ * @return MPP_OK on success
+ */
+MPP_RET rvpu_backend_register(const RvpuBackend *backend);
+
+/**
+ * Skip backends with any of the caps from now on, e.g. a process serving
+ * rvpu sessions never encodes through the remote backend itself
+ * @param caps RVPU_CAP_XXX
+ * @return None
+ */
+void rvpu_backend_disable(RK_U32 caps);
+
+/**
+ * Look up an enabled backend by name
+ * @return NULL if not found
+ */
+const RvpuBackend *rvpu_backend_find(const char *name);
+
+/**
+ * Iterate enabled backends having all the caps in preference order
+ * @param prev NULL to get the first one
+ * @return NULL after the last one
+ */
+const RvpuBackend *rvpu_backend_next(const RvpuBackend *prev, RK_U32 caps);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HAL_RVPU_BACKEND_H__ */
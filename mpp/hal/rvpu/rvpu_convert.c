@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2019-2020 FoilPlanet. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_TAG "rvpu_convert"
+
+#include <string.h>
+
+#include "mpp_env.h"
+#include "mpp_log.h"
+#include "mpp_mem.h"
+#include "mpp_common.h"
+
+#include "rvpu_convert.h"
+
+#include "libyuv/convert.h"
+#include "libyuv/cpu_id.h"
+#include "libyuv/scale.h"
+
+/* libyuv cpu flags with only the initialized bit, all rows in C */
+#define LIBYUV_CPU_C_ONLY       (1)
+
+typedef struct RvpuConvertImpl_t {
+    // I420 at source size when converting and scaling
+    RK_U8          *tmp;
+    size_t          tmp_size;
+} RvpuConvertImpl;
+
+RK_S32 rvpu_image_bpp(MppFrameFormat fmt)
+{
+    switch (fmt) {
+    case MPP_FMT_YUV420SP:
+    case MPP_FMT_YUV420SP_VU:
+    case MPP_FMT_YUV420P:
+    case MPP_FMT_YUV422SP:
+    case MPP_FMT_YUV422SP_VU:
+    case MPP_FMT_YUV422P:
+    case MPP_FMT_YUV400:
+        return 1;
+    case MPP_FMT_YUV422_YUYV:
+    case MPP_FMT_YUV422_UYVY:
+    case MPP_FMT_RGB565:
+        return 2;
+    case MPP_FMT_RGB888:
+    case MPP_FMT_BGR888:
+        return 3;
+    case MPP_FMT_ARGB8888:
+    case MPP_FMT_ABGR8888:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+size_t rvpu_image_size(MppFrameFormat fmt, RK_S32 hor_stride, RK_S32 ver_stride)
+{
+    size_t luma = (size_t)hor_stride * ver_stride;
+
+    switch (fmt) {
+    case MPP_FMT_YUV420SP:
+    case MPP_FMT_YUV420SP_VU:
+    case MPP_FMT_YUV420P:
+        return luma * 3 / 2;
+    case MPP_FMT_YUV422SP:
+    case MPP_FMT_YUV422SP_VU:
+    case MPP_FMT_YUV422P:
+        return luma * 2;
+    default:
+        return luma * rvpu_image_bpp(fmt);
+    }
+}
+
+MPP_RET rvpu_image_setup(RvpuImage *img, void *ptr, MppFrameFormat fmt,
+                         RK_S32 width, RK_S32 height,
+                         RK_S32 hor_stride, RK_S32 ver_stride)
+{
+    RK_U8 *base = (RK_U8 *)ptr;
+    size_t luma = (size_t)hor_stride * ver_stride;
+    RK_S32 bpp = rvpu_image_bpp(fmt);
+
+    if (NULL == ptr || !bpp || width <= 0 || height <= 0 ||
+        hor_stride < width || ver_stride < height) {
+        mpp_err_f("invalid format %d %dx%d stride %dx%d\n", fmt,
+                  width, height, hor_stride, ver_stride);
+        return MPP_ERR_VALUE;
+    }
+
+    memset(img, 0, sizeof(*img));
+    img->format    = fmt;
+    img->width     = width;
+    img->height    = height;
+    img->plane[0]  = base;
+    img->stride[0] = hor_stride * bpp;
+
+    switch (fmt) {
+    case MPP_FMT_YUV420SP:
+    case MPP_FMT_YUV420SP_VU:
+    case MPP_FMT_YUV422SP:
+    case MPP_FMT_YUV422SP_VU:
+        img->plane[1]  = base + luma;
+        img->stride[1] = hor_stride;
+        break;
+    case MPP_FMT_YUV420P:
+    case MPP_FMT_YUV422P:
+        img->plane[1]  = base + luma;
+        img->stride[1] = hor_stride / 2;
+        img->plane[2]  = base + luma + ((fmt == MPP_FMT_YUV420P) ? luma / 4 : luma / 2);
+        img->stride[2] = hor_stride / 2;
+        break;
+    default:
+        break;
+    }
+
+    return MPP_OK;
+}
+
+MPP_RET rvpu_convert_init(RvpuConvert *ctx)
+{
+    RvpuConvertImpl *p;
+    RK_U32 simd = 1;
+
+    if (NULL == ctx)
+        return MPP_ERR_NULL_PTR;
+
+    p = mpp_calloc(RvpuConvertImpl, 1);
+    if (NULL == p) {
+        *ctx = NULL;
+        return MPP_ERR_MALLOC;
+    }
+
+    // process wide in libyuv
+    mpp_env_get_u32("rvpu_convert_simd", &simd, 1);
+    if (!simd)
+        MaskCpuFlags(LIBYUV_CPU_C_ONLY);
+
+    *ctx = p;
+    return MPP_OK;
+}
+
+MPP_RET rvpu_convert_deinit(RvpuConvert ctx)
+{
+    RvpuConvertImpl *p = (RvpuConvertImpl *)ctx;
+
+    if (p) {
+        MPP_FREE(p->tmp);
+        MPP_FREE(p);
+    }
+    return MPP_OK;
+}
+
+/*
+ * Byte order of the rgb formats follows the turbojpeg mapping of jpege:
+ * RGB888 is R, G, B in memory (libyuv RAW), BGR888 is libyuv RGB24, ARGB8888
+ * is R, G, B, A (libyuv ABGR) and ABGR8888 is B, G, R, A (libyuv ARGB).
+ * 4:2:2 semi-planar chroma is decimated by skipping every other line.
+ */
+static int convert_same_size(const RvpuImage *s, RvpuImage *d)
+{
+    const RK_U8 *sy = s->plane[0];
+    RK_S32 ss = s->stride[0];
+    RK_U8 *dy = d->plane[0];
+    RK_U8 *du = d->plane[1];
+    RK_U8 *dv = d->plane[2];
+    RK_S32 dys = d->stride[0];
+    RK_S32 dus = d->stride[1];
+    RK_S32 dvs = d->stride[2];
+    int w = s->width;
+    int h = s->height;
+
+    switch (s->format) {
+    case MPP_FMT_YUV420SP:
+        return NV12ToI420(sy, ss, s->plane[1], s->stride[1],
+                          dy, dys, du, dus, dv, dvs, w, h);
+    case MPP_FMT_YUV420SP_VU:
+        return NV21ToI420(sy, ss, s->plane[1], s->stride[1],
+                          dy, dys, du, dus, dv, dvs, w, h);
+    case MPP_FMT_YUV422SP:
+        return NV12ToI420(sy, ss, s->plane[1], s->stride[1] * 2,
+                          dy, dys, du, dus, dv, dvs, w, h);
+    case MPP_FMT_YUV422SP_VU:
+        return NV21ToI420(sy, ss, s->plane[1], s->stride[1] * 2,
+                          dy, dys, du, dus, dv, dvs, w, h);
+    case MPP_FMT_YUV420P:
+        return I420Copy(sy, ss, s->plane[1], s->stride[1], s->plane[2], s->stride[2],
+                        dy, dys, du, dus, dv, dvs, w, h);
+    case MPP_FMT_YUV422P:
+        return I422ToI420(sy, ss, s->plane[1], s->stride[1], s->plane[2], s->stride[2],
+                          dy, dys, du, dus, dv, dvs, w, h);
+    case MPP_FMT_YUV400:
+        return I400ToI420(sy, ss, dy, dys, du, dus, dv, dvs, w, h);
+    case MPP_FMT_YUV422_YUYV:
+        return YUY2ToI420(sy, ss, dy, dys, du, dus, dv, dvs, w, h);
+    case MPP_FMT_YUV422_UYVY:
+        return UYVYToI420(sy, ss, dy, dys, du, dus, dv, dvs, w, h);
+    case MPP_FMT_RGB565:
+        return RGB565ToI420(sy, ss, dy, dys, du, dus, dv, dvs, w, h);
+    case MPP_FMT_RGB888:
+        return RAWToI420(sy, ss, dy, dys, du, dus, dv, dvs, w, h);
+    case MPP_FMT_BGR888:
+        return RGB24ToI420(sy, ss, dy, dys, du, dus, dv, dvs, w, h);
+    case MPP_FMT_ARGB8888:
+        return ABGRToI420(sy, ss, dy, dys, du, dus, dv, dvs, w, h);
+    case MPP_FMT_ABGR8888:
+        return ARGBToI420(sy, ss, dy, dys, du, dus, dv, dvs, w, h);
+    default:
+        return -1;
+    }
+}
+
+MPP_RET rvpu_convert_to_i420(RvpuConvert ctx, const RvpuImage *src, RvpuImage *dst)
+{
+    RvpuConvertImpl *p = (RvpuConvertImpl *)ctx;
+    RvpuImage tmp;
+    const RvpuImage *s = src;
+    int ret;
+
+    if (NULL == p || NULL == src || NULL == dst || dst->format != MPP_FMT_YUV420P) {
+        mpp_err_f("invalid ctx %p src %p dst %p\n", p, src, dst);
+        return MPP_ERR_VALUE;
+    }
+
+    if (src->width == dst->width && src->height == dst->height) {
+        ret = convert_same_size(src, dst);
+        goto DONE;
+    }
+
+    // scale from I420, other formats are converted at source size first
+    if (src->format != MPP_FMT_YUV420P) {
+        RK_S32 w = MPP_ALIGN(src->width, 2);
+        RK_S32 h = MPP_ALIGN(src->height, 2);
+        size_t size = (size_t)w * h * 3 / 2;
+
+        if (p->tmp_size < size) {
+            MPP_FREE(p->tmp);
+            p->tmp = mpp_malloc(RK_U8, size);
+            p->tmp_size = p->tmp ? size : 0;
+            if (NULL == p->tmp)
+                return MPP_ERR_MALLOC;
+        }
+
+        tmp.format    = MPP_FMT_YUV420P;
+        tmp.width     = src->width;
+        tmp.height    = src->height;
+        tmp.plane[0]  = p->tmp;
+        tmp.stride[0] = w;
+        tmp.plane[1]  = p->tmp + w * h;
+        tmp.stride[1] = w / 2;
+        tmp.plane[2]  = p->tmp + w * h * 5 / 4;
+        tmp.stride[2] = w / 2;
+
+        ret = convert_same_size(src, &tmp);
+        if (ret)
+            goto DONE;
+        s = &tmp;
+    }
+
+    ret = I420Scale(s->plane[0], s->stride[0], s->plane[1], s->stride[1],
+                    s->plane[2], s->stride[2], s->width, s->height,
+                    dst->plane[0], dst->stride[0], dst->plane[1], dst->stride[1],
+                    dst->plane[2], dst->stride[2], dst->width, dst->height,
+                    kFilterBilinear);
+
+DONE:
+    if (ret) {
+        mpp_err_f("format %d %dx%d to I420 %dx%d failed %d\n", src->format,
+                  src->width, src->height, dst->width, dst->height, ret);
+        return MPP_NOK;
+    }
+    return MPP_OK;
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2019-2020 FoilPlanet. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __HAL_RVPU_CONVERT_H__
+#define __HAL_RVPU_CONVERT_H__
+
+#include "mpp_frame.h"
+
+/**
+ * Image planes of one frame, stride in bytes. Packed formats only use
+ * plane[0].
+ */
+typedef struct rvpu_image_t {
+    MppFrameFormat  format;
+    RK_S32          width;
+    RK_S32          height;
+    RK_U8          *plane[3];
+    RK_S32          stride[3];
+} RvpuImage;
+
+/**
+ * Color conversion and scaling stage of the software encoders, on top of
+ * libyuv which picks its SSE2 / AVX2 / NEON rows at runtime. Env
+ * rvpu_convert_simd=0 forces the C rows for comparison.
+ */
+typedef void* RvpuConvert;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Bytes per pixel of plane[0], 1 for the planar and semi-planar yuv
+ * @return 0 if the format is not supported
+ */
+RK_S32 rvpu_image_bpp(MppFrameFormat fmt);
+
+/**
+ * Buffer size of a frame in mpp layout, hor_stride in pixels and chroma
+ * planes following luma at ver_stride lines
+ * @return 0 if the format is not supported
+ */
+size_t rvpu_image_size(MppFrameFormat fmt, RK_S32 hor_stride, RK_S32 ver_stride);
+
+/**
+ * Point the image planes at a frame buffer in mpp layout
+ * @return MPP_OK on success
+ */
+MPP_RET rvpu_image_setup(RvpuImage *img, void *ptr, MppFrameFormat fmt,
+                         RK_S32 width, RK_S32 height,
+                         RK_S32 hor_stride, RK_S32 ver_stride);
+
+MPP_RET rvpu_convert_init(RvpuConvert *ctx);
+MPP_RET rvpu_convert_deinit(RvpuConvert ctx);
+
+/**
+ * Convert any supported format into the I420 planes of dst, scaling when the
+ * sizes differ
+ * @param dst I420 image with its planes allocated by caller
+ * @return MPP_OK on success
+ */
+MPP_RET rvpu_convert_to_i420(RvpuConvert ctx, const RvpuImage *src, RvpuImage *dst);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HAL_RVPU_CONVERT_H__ */
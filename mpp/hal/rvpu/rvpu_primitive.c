@@ -17,9 +17,12 @@
 #define MODULE_TAG "mpp_rvpu_prim"
 
 #include <fcntl.h>
+#include <poll.h>
 #include <sys/errno.h>
 #include <sys/socket.h>
+#include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <sys/un.h>
 #include <string.h>
 #include <unistd.h>
@@ -28,6 +31,8 @@
 #include "mpp_common.h"
 #include "mpp_mem.h"
 #include "mpp_log.h"
+#include "mpp_env.h"
+#include "mpp_time.h"
 
 #include "rvpu_primitive.h"
 
@@ -36,6 +41,11 @@
 
 #define CLIENT_TYPE_RVPU        0x02
 
+// wait time for RVPU_PRIM_HELLO response before falling back to ascii
+#define RVPU_HELLO_TIMEOUT      100     // ms
+
+#define RVPU_RECV_CHUNK         4096
+
 #ifndef min
 #define min(a,b)                (((a)<(b)) ? (a):(b))
 #endif
@@ -54,6 +64,16 @@ void set_rvpu_sockname(const char *sname)
     def_sockname = sname;
 }
 
+MPP_RET probe_remote(void)
+{
+    struct stat st;
+
+    if (stat(def_sockname, &st) < 0 || !S_ISSOCK(st.st_mode))
+        return MPP_NOK;
+
+    return MPP_OK;
+}
+
 int connect_remote()
 {
     struct sockaddr_un addr;
@@ -113,32 +133,76 @@ void disconnect_remote(int fd)
     }
 }
 
+static MPP_RET send_iov(int fd, struct iovec *iov, int cnt)
+{
+    struct msghdr msg;
+
+    memset(&msg, 0, sizeof(msg));
+    while (cnt > 0) {
+        ssize_t ret;
+
+        msg.msg_iov    = iov;
+        msg.msg_iovlen = cnt;
+        ret = sendmsg(fd, &msg, MSG_NOSIGNAL);
+        if (ret < 0) {
+            if (errno == EINTR)
+                continue;
+            mpp_err("sendmsg with error: %s", strerror(errno));
+            return MPP_NOK;
+        }
+
+        // skip the part already sent on short write
+        while (cnt > 0 && (size_t)ret >= iov->iov_len) {
+            ret -= iov->iov_len;
+            iov++;
+            cnt--;
+        }
+        if (cnt > 0) {
+            iov->iov_base = (RK_U8 *)iov->iov_base + ret;
+            iov->iov_len -= ret;
+        }
+    }
+
+    return MPP_OK;
+}
+
+size_t rvpu_pack_header(int proto, RK_U32 seq, RVPU_PRIM_CODE prim, size_t length, void *hdr)
+{
+    if (proto >= RVPU_PROTO_V1) {
+        RvpuMsgHdr msg;
+        msg.magic   = RVPU_PROTO_MAGIC;
+        msg.version = (RK_U8)proto;
+        msg.prim    = (RK_U16)prim;
+        msg.seq     = seq;
+        msg.length  = (RK_U32)length;
+        memcpy(hdr, &msg, sizeof(msg));
+        return sizeof(msg);
+    }
+
+    return sprintf((char *)hdr, "%d:%lu:", prim, (unsigned long)length);
+}
+
 MPP_RET send_remote(int fd, RVPU_PRIM_CODE prim, void *data, size_t datasiz)
 {
-    char buf[8 + MAX_CONTEXT_SIZE];
-    size_t  len;
-    ssize_t ret;
-    
+    char hdr[RVPU_MAX_HDR_SIZE];
+    struct iovec iov[2];
+
     if (fd <= 0)
         return MPP_NOK;
 
-    if (datasiz > 0) {
-        int n = sprintf(buf, "%d:%lu:", prim, datasiz);
-        memcpy(&buf[n], data, datasiz);
-        len = n + datasiz;
-    } else {
-        len = sprintf(buf, "%d:0:", prim);
-    }
+    iov[0].iov_base = hdr;
+    iov[0].iov_len  = rvpu_pack_header(RVPU_PROTO_ASCII, 0, prim, datasiz, hdr);
+    iov[1].iov_base = data;
+    iov[1].iov_len  = (data != NULL) ? datasiz : 0;
 
-    ret = send(fd, buf, len, MSG_NOSIGNAL);
-    return ret > 0 ? MPP_OK : MPP_NOK;
+    return send_iov(fd, iov, 2);
 }
 
-static size_t 
+static size_t
 parse_token(const uint8_t *pch_begin, const uint8_t *pch_end, char *out, size_t outsiz)
 {
     const uint8_t *pch;
-    char *pout = out; 
+    char *pout = out;
     const char *outend = out + outsiz - 1;
 
     for (pch = pch_begin; pch < pch_end && pout < outend; pout++) {
@@ -149,7 +213,7 @@ parse_token(const uint8_t *pch_begin, const uint8_t *pch_end, char *out, size_t
         *pout = ch;
     }
     *pout = '\0';
-    
+
     // mpp_log("parse_token '%s' %d bytes", out, pch - pch_begin);
     return pch - pch_begin;
 }
@@ -172,12 +236,12 @@ ssize_t recv_remote(int fd, RVPU_PRIM_CODE *prim, void *pdata, size_t maxsize)
     uint8_t buf[8 + MAX_CONTEXT_SIZE];
     size_t  len;
     ssize_t ret;
-    
+
     if (fd <= 0)
         return MPP_NOK;
     mpp_assert(prim != NULL);
 
-    ret = recv(fd, buf, len, MSG_DONTWAIT);
+    ret = recv(fd, buf, sizeof(buf), MSG_DONTWAIT);
 
     if (ret > 0) {
         const uint8_t *pch  = buf;
@@ -190,3 +254,420 @@ ssize_t recv_remote(int fd, RVPU_PRIM_CODE *prim, void *pdata, size_t maxsize)
     }
     return ret;
 }
+
+
+void rvpu_stream_reset(RvpuStream *s)
+{
+    s->pos = 0;
+    s->len = 0;
+}
+
+void rvpu_stream_deinit(RvpuStream *s)
+{
+    MPP_FREE(s->buf);
+    s->size = 0;
+    rvpu_stream_reset(s);
+}
+
+MPP_RET rvpu_stream_feed(RvpuStream *s, const void *data, size_t size)
+{
+    // drop consumed data before growing buffer
+    if (s->pos == s->len) {
+        rvpu_stream_reset(s);
+    } else if (s->pos > 0 && s->len + size > s->size) {
+        memmove(s->buf, s->buf + s->pos, s->len - s->pos);
+        s->len -= s->pos;
+        s->pos = 0;
+    }
+
+    if (s->len + size > s->size) {
+        size_t need = MPP_ALIGN(s->len + size, RVPU_RECV_CHUNK);
+        RK_U8 *buf;
+
+        if (need > RVPU_MAX_MSG_SIZE + 2 * RVPU_RECV_CHUNK) {
+            mpp_err("stream overflow %d bytes buffered", s->len + size);
+            rvpu_stream_reset(s);
+            return MPP_NOK;
+        }
+
+        buf = mpp_realloc(s->buf, RK_U8, need);
+        if (NULL == buf)
+            return MPP_ERR_NOMEM;
+        s->buf  = buf;
+        s->size = need;
+    }
+
+    memcpy(s->buf + s->len, data, size);
+    s->len += size;
+    return MPP_OK;
+}
+
+RK_S32 rvpu_stream_next(RvpuStream *s, RvpuMsg *msg)
+{
+    const RK_U8 *p = s->buf + s->pos;
+    size_t avail = s->len - s->pos;
+    size_t hlen = 0;
+    size_t len;
+
+    if (avail == 0)
+        return 0;
+
+    if (p[0] == RVPU_PROTO_MAGIC) {
+        RvpuMsgHdr hdr;
+
+        if (avail < sizeof(hdr))
+            return 0;
+
+        memcpy(&hdr, p, sizeof(hdr));
+        if (hdr.version < RVPU_PROTO_V1 || hdr.length > RVPU_MAX_MSG_SIZE) {
+            mpp_err("invalid header version %d length %u", hdr.version, hdr.length);
+            rvpu_stream_reset(s);
+            return MPP_NOK;
+        }
+
+        hlen = sizeof(hdr);
+        len  = hdr.length;
+        msg->prim    = (RVPU_PRIM_CODE)hdr.prim;
+        msg->version = hdr.version;
+        msg->seq     = hdr.seq;
+    } else {
+        // ascii framing: "{code}:{length}:"
+        RK_S32 colons = 0;
+        size_t i;
+
+        for (i = 0; i < avail && i < RVPU_MAX_HDR_SIZE; i++) {
+            if (p[i] == ':') {
+                if (++colons == 2) {
+                    hlen = i + 1;
+                    break;
+                }
+            } else if (p[i] < '0' || p[i] > '9') {
+                break;
+            }
+        }
+
+        if (hlen == 0) {
+            if (i < avail) {
+                mpp_err("invalid ascii header at offset %d", i);
+                rvpu_stream_reset(s);
+                return MPP_NOK;
+            }
+            return 0;
+        }
+
+        parse_header(p, p + hlen, &msg->prim, &len);
+        if (len > RVPU_MAX_MSG_SIZE) {
+            mpp_err("invalid ascii header length %d", len);
+            rvpu_stream_reset(s);
+            return MPP_NOK;
+        }
+        msg->version = RVPU_PROTO_ASCII;
+        msg->seq     = 0;
+    }
+
+    if (avail < hlen + len)
+        return 0;
+
+    msg->length = len;
+    msg->data   = p + hlen;
+    s->pos += hlen + len;
+    return 1;
+}
+
+static MPP_RET rvpu_send_batch(HalRvpuInfo *info, RVPU_PRIM_CODE prim,
+                               const void *data, size_t size, RK_S32 has_prim)
+{
+    RK_U8 hdr[RVPU_MAX_BATCH + 1][RVPU_MAX_HDR_SIZE];
+    struct iovec iov[2 * (RVPU_MAX_BATCH + 1)];
+    RK_S32 cnt = 0;
+    RK_S32 i;
+    MPP_RET ret;
+
+    if (info->remote_fd <= 0)
+        return MPP_NOK;
+
+    for (i = 0; i < info->pending; i++) {
+        RvpuPending *pend = &info->batch[i];
+        iov[cnt].iov_base = hdr[i];
+        iov[cnt].iov_len  = rvpu_pack_header(info->proto, info->seq++,
+                                             pend->prim, pend->size, hdr[i]);
+        cnt++;
+        iov[cnt].iov_base = pend->data;
+        iov[cnt].iov_len  = pend->size;
+        cnt++;
+    }
+
+    if (has_prim) {
+        if (NULL == data)
+            size = 0;
+        iov[cnt].iov_base = hdr[i];
+        iov[cnt].iov_len  = rvpu_pack_header(info->proto, info->seq++,
+                                             prim, size, hdr[i]);
+        cnt++;
+        iov[cnt].iov_base = (void *)data;
+        iov[cnt].iov_len  = size;
+        cnt++;
+    }
+
+    info->pending = 0;
+    if (cnt == 0)
+        return MPP_OK;
+
+    ret = send_iov(info->remote_fd, iov, cnt);
+    return ret;
+}
+
+MPP_RET rvpu_send(HalRvpuInfo *info, RVPU_PRIM_CODE prim, const void *data, size_t size)
+{
+    return rvpu_send_batch(info, prim, data, size, 1);
+}
+
+MPP_RET rvpu_flush(HalRvpuInfo *info)
+{
+    return rvpu_send_batch(info, RVPU_PRIM_UNDEFINED, NULL, 0, 0);
+}
+
+MPP_RET rvpu_queue(HalRvpuInfo *info, RVPU_PRIM_CODE prim, const void *data, size_t size)
+{
+    RvpuPending *pend;
+
+    if (NULL == data)
+        size = 0;
+
+    if (size > RVPU_MAX_BATCH_DATA)
+        return rvpu_send(info, prim, data, size);
+
+    if (info->pending >= RVPU_MAX_BATCH) {
+        MPP_RET ret = rvpu_flush(info);
+        if (ret)
+            return ret;
+    }
+
+    pend = &info->batch[info->pending++];
+    pend->prim = prim;
+    pend->size = size;
+    if (size)
+        memcpy(pend->data, data, size);
+
+    return MPP_OK;
+}
+
+RK_S32 rvpu_recv(HalRvpuInfo *info, RvpuMsg *msg, RK_S32 timeout)
+{
+    RK_U8 buf[RVPU_RECV_CHUNK];
+    RK_S64 deadline = (timeout >= 0) ? mpp_time() + (RK_S64)timeout * 1000 : 0;
+
+    if (info->remote_fd <= 0)
+        return MPP_NOK;
+
+    for (;;) {
+        struct pollfd pfd;
+        RK_S32 wait = timeout;
+        ssize_t ret = rvpu_stream_next(&info->stream, msg);
+
+        if (ret != 0)
+            return (RK_S32)ret;
+
+        if (timeout >= 0) {
+            RK_S64 left = deadline - mpp_time();
+            wait = (left > 0) ? (RK_S32)((left + 999) / 1000) : 0;
+        }
+
+        pfd.fd      = info->remote_fd;
+        pfd.events  = POLLIN;
+        pfd.revents = 0;
+        ret = poll(&pfd, 1, wait);
+        if (ret < 0) {
+            if (errno == EINTR)
+                continue;
+            return MPP_NOK;
+        } else if (ret == 0) {
+            return 0;
+        }
+
+        ret = recv(info->remote_fd, buf, sizeof(buf), MSG_DONTWAIT);
+        if (ret == 0) {
+            mpp_err("remote closed");
+            return MPP_NOK;
+        } else if (ret < 0) {
+            if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)
+                continue;
+            mpp_err("recv with error: %s", strerror(errno));
+            return MPP_NOK;
+        }
+
+        if (rvpu_stream_feed(&info->stream, buf, ret))
+            return MPP_NOK;
+    }
+}
+
+RK_S32 rvpu_wait(HalRvpuInfo *info, RK_U32 seq, RvpuWaitResult *result, RK_S32 timeout)
+{
+    RK_S64 deadline = mpp_time() + (RK_S64)timeout * 1000;
+    RvpuMsg msg;
+
+    for (;;) {
+        RK_S64 left = deadline - mpp_time();
+        RK_S32 ret;
+
+        if (left <= 0)
+            return 0;
+
+        ret = rvpu_recv(info, &msg, (RK_S32)((left + 999) / 1000));
+        if (ret <= 0)
+            return ret;
+
+        if (msg.prim != RVPU_PRIM_WAIT || msg.length != sizeof(*result))
+            continue;
+
+        // completions of frames which had timed out before
+        if (msg.seq != seq) {
+            mpp_log("drop completion %u while waiting %u", msg.seq, seq);
+            continue;
+        }
+
+        memcpy(result, msg.data, sizeof(*result));
+        return 1;
+    }
+}
+
+void rvpu_inflight_push(HalRvpuInfo *info, RK_U32 seq, RK_S32 type, RK_S64 pts,
+                        MppBuffer input, MppBuffer output)
+{
+    RvpuInflight *frame;
+
+    mpp_assert(info->inflight < RVPU_MAX_INFLIGHT);
+    frame = &info->frames[(info->head + info->inflight) % RVPU_MAX_INFLIGHT];
+    frame->seq  = seq;
+    frame->type = type;
+    frame->pts  = pts;
+    frame->input  = input;
+    frame->output = output;
+    info->inflight++;
+}
+
+RvpuInflight *rvpu_inflight_peek(HalRvpuInfo *info)
+{
+    return info->inflight ? &info->frames[info->head] : NULL;
+}
+
+RvpuInflight *rvpu_inflight_pop(HalRvpuInfo *info)
+{
+    RvpuInflight *frame;
+
+    if (!info->inflight)
+        return NULL;
+
+    frame = &info->frames[info->head];
+    info->head = (info->head + 1) % RVPU_MAX_INFLIGHT;
+    info->inflight--;
+    return frame;
+}
+
+RvpuInflight *rvpu_inflight_pop_newest(HalRvpuInfo *info)
+{
+    if (!info->inflight)
+        return NULL;
+
+    info->inflight--;
+    return &info->frames[(info->head + info->inflight) % RVPU_MAX_INFLIGHT];
+}
+
+void rvpu_inflight_release(RvpuInflight *frame)
+{
+    if (frame->input)
+        mpp_buffer_put(frame->input);
+    if (frame->output)
+        mpp_buffer_put(frame->output);
+
+    frame->input  = NULL;
+    frame->output = NULL;
+}
+
+void rvpu_inflight_reset(HalRvpuInfo *info)
+{
+    RvpuInflight *frame;
+
+    if (info->inflight)
+        mpp_log("drop %u frames in flight", info->inflight);
+
+    while (NULL != (frame = rvpu_inflight_pop(info)))
+        rvpu_inflight_release(frame);
+
+    info->inflight = 0;
+    info->head     = 0;
+}
+
+MPP_RET rvpu_open(HalRvpuInfo *info)
+{
+    RK_U32 proto = RVPU_PROTO_VERSION;
+
+    info->proto   = RVPU_PROTO_ASCII;
+    info->seq     = 0;
+    info->pending = 0;
+    info->depth   = 1;
+    info->timeout = RVPU_WAIT_TIMEOUT;
+    rvpu_inflight_reset(info);
+    rvpu_stream_reset(&info->stream);
+
+    if ((info->remote_fd = connect_remote()) <= 0) {
+        info->remote_fd = -1;
+        return MPP_NOK;
+    }
+
+    mpp_env_get_u32("rvpu_proto", &proto, RVPU_PROTO_VERSION);
+    if (proto >= RVPU_PROTO_V1) {
+        RK_U32 version = RVPU_PROTO_VERSION;
+        RK_U32 timeout = RVPU_HELLO_TIMEOUT;
+        RvpuMsg msg;
+
+        // a server loaded with many sessions may answer late
+        mpp_env_get_u32("rvpu_hello_timeout", &timeout, RVPU_HELLO_TIMEOUT);
+
+        /*
+         * probe in ascii framing, a legacy server skips the unknown primitive
+         * by its length and never answers, a binary one replies in binary
+         */
+        if (MPP_OK == rvpu_send(info, RVPU_PRIM_HELLO, &version, sizeof(version)) &&
+            rvpu_recv(info, &msg, (RK_S32)timeout) > 0 &&
+            msg.prim == RVPU_PRIM_HELLO && msg.length >= sizeof(version)) {
+            memcpy(&version, msg.data, sizeof(version));
+            info->proto = MPP_MIN(version, RVPU_PROTO_VERSION);
+        } else {
+            info->proto = RVPU_PROTO_ASCII;
+        }
+    }
+
+    // legacy server completes by ready-flag, only one frame at a time
+    if (info->proto >= RVPU_PROTO_V1) {
+        mpp_env_get_u32("rvpu_depth", &info->depth, 1);
+        if (!info->depth)
+            info->depth = 1;
+        else if (info->depth > RVPU_MAX_INFLIGHT)
+            info->depth = RVPU_MAX_INFLIGHT;
+
+        // a software server may take longer than a hardware one per frame
+        mpp_env_get_u32("rvpu_wait_timeout", &info->timeout, RVPU_WAIT_TIMEOUT);
+    }
+
+    mpp_log("remote fd %d protocol %s depth %u", info->remote_fd,
+            info->proto >= RVPU_PROTO_V1 ? "binary" : "ascii", info->depth);
+
+    return MPP_OK;
+}
+
+void rvpu_close(HalRvpuInfo *info)
+{
+    if (info->remote_fd > 0) {
+        rvpu_send(info, RVPU_PRIM_DEINIT, NULL, 0);
+        close(info->remote_fd);
+        info->remote_fd = -1;
+    }
+    info->pending = 0;
+    rvpu_inflight_reset(info);
+    rvpu_stream_deinit(&info->stream);
+    if (info->group) {
+        mpp_buffer_group_put(info->group);
+        info->group = NULL;
+    }
+}
@@ -30,7 +30,8 @@ extern "C" {
 
 /**
  * Codeing primtive sent to remote server
- *   message format: {code}:{length}:{data}
+ *   ascii  message format: {code}:{length}:{data}
+ *   binary message format: {RvpuMsgHdr}{data}
  */
 typedef enum rvpu_primitive_t {
     RVPU_PRIM_UNDEFINED = 0,
@@ -46,17 +47,140 @@ typedef enum rvpu_primitive_t {
     RVPU_PRIM_CONTROL,
     RVPU_PRIM_RESET,
     RVPU_PRIM_FLUSH,
+    RVPU_PRIM_HELLO,            /**< protocol negotiation, binary framing only */
     RVPU_PRIM_MAX
 } RVPU_PRIM_CODE;
 
+/**
+ * Wire protocol of a rvpu channel
+ *   RVPU_PROTO_ASCII: legacy "{code}:{length}:{data}" framing
+ *   RVPU_PROTO_V1   : fixed RvpuMsgHdr followed by {length} bytes of data
+ */
+#define RVPU_PROTO_ASCII            0
+#define RVPU_PROTO_V1               1
+#define RVPU_PROTO_VERSION          RVPU_PROTO_V1
+
+/* first byte of a binary message, never a digit of the ascii framing */
+#define RVPU_PROTO_MAGIC            0xA5
+
+/* upper limit of one message payload, larger messages are treated as corrupted */
+#define RVPU_MAX_MSG_SIZE           (1 << 20)
+
+/* max size of ascii or binary header */
+#define RVPU_MAX_HDR_SIZE           32
+
+/* max time waiting for the encoded packet of one frame */
+#define RVPU_WAIT_TIMEOUT           50      // ms
+
+/* max number of frames sent before the oldest completion is waited */
+#define RVPU_MAX_INFLIGHT           4
+
+/* max number of primitives batched into one sendmsg */
+#define RVPU_MAX_BATCH              4
+#define RVPU_MAX_BATCH_DATA         128
+
+/**
+ * Binary message header, all fields in host byte order (local socket only)
+ */
+typedef struct rvpu_msg_hdr_t {
+    RK_U8   magic;              /**< RVPU_PROTO_MAGIC */
+    RK_U8   version;            /**< RVPU_PROTO_XXX */
+    RK_U16  prim;               /**< RVPU_PRIM_CODE */
+    RK_U32  seq;                /**< sequence id, increased per message */
+    RK_U32  length;             /**< payload length */
+} RvpuMsgHdr;
+
+/**
+ * One message parsed from a rvpu stream
+ */
+typedef struct rvpu_msg_t {
+    RVPU_PRIM_CODE  prim;
+    RK_U32          version;    /**< RVPU_PROTO_XXX of this message */
+    RK_U32          seq;        /**< always 0 for ascii framing */
+    size_t          length;
+    const RK_U8    *data;       /**< valid until next rvpu_stream_feed */
+} RvpuMsg;
+
+/**
+ * Streaming reassembler, accepts data split at any byte boundary
+ */
+typedef struct rvpu_stream_t {
+    RK_U8  *buf;
+    size_t  size;               /**< buffer capacity */
+    size_t  pos;                /**< read position */
+    size_t  len;                /**< write position */
+} RvpuStream;
+
+/**
+ * Completion of RVPU_PRIM_WAIT, sent back with the sequence id of the request
+ * on binary channels. A packet not in an ion buffer is copied to the output
+ * buffer of the request and its info is all zero.
+ */
+typedef struct rvpu_wait_result_t {
+    RK_U32          length;     /**< packet length, 0 if no packet is ready */
+    MppBufferInfo   info;       /**< packet buffer, fd and ptr are cleared */
+} RvpuWaitResult;
+
+/**
+ * Optional payload of RVPU_PRIM_INIT, a single RK_S32 coding type is accepted
+ * as well
+ */
+typedef struct rvpu_init_cfg_t {
+    RK_S32          coding;     /**< MppCodingType */
+    RK_S32          depth;      /**< frames in flight, server keeps their packets */
+} RvpuInitCfg;
+
+/**
+ * Frame sent to remote and not completed yet
+ */
+typedef struct rvpu_inflight_t {
+    RK_U32          seq;        /**< sequence id of the WAIT request */
+    RK_S32          type;       /**< rc frame type, reported on completion */
+    RK_S64          pts;        /**< pts of the input frame */
+    MppBuffer       input;      /**< kept to encode the frame again on failover */
+    MppBuffer       output;     /**< server copies the packet here if not shared */
+} RvpuInflight;
+
+/**
+ * Primitive queued for the next batched send
+ */
+typedef struct rvpu_pending_t {
+    RVPU_PRIM_CODE  prim;
+    size_t          size;
+    RK_U8           data[RVPU_MAX_BATCH_DATA];
+} RvpuPending;
 
 /**
  * Context for encoder/decoder, keep in HalContext::extra_info
  */
 typedef struct hal_rvpu_info_s {
-    int remote_fd;
+    int         remote_fd;
+    int         proto;          /**< negotiated RVPU_PROTO_XXX */
+    RK_U32      seq;            /**< sequence id of next message */
+    RvpuStream  stream;         /**< incoming messages */
+    RK_S32      pending;
+    RvpuPending batch[RVPU_MAX_BATCH];
+    RK_U32      depth;          /**< max frames in flight, env rvpu_depth */
+    RK_U32      timeout;        /**< ms to wait a completion, env rvpu_wait_timeout */
+    RK_U32      inflight;       /**< frames waiting for completion */
+    RK_U32      head;           /**< index of the oldest in flight frame */
+    RvpuInflight frames[RVPU_MAX_INFLIGHT];
+    MppBufferGroup group;       /**< output buffers of frames in flight */
 } HalRvpuInfo;
 
+/**
+ * Override the default remote socket name
+ * @param sname unix socket path, must stay valid while in use
+ * @return None
+ */
+void set_rvpu_sockname(const char *sname);
+
+/**
+ * Check whether the remote socket exists, without connecting
+ * @return MPP_OK if present
+ */
+MPP_RET probe_remote(void);
+
 /**
  * Connect to remote vpu instance
  * @return remote fd
@@ -92,6 +216,93 @@ ssize_t recv_remote(int fd, RVPU_PRIM_CODE *prim, void *data, size_t maxsiz);
 
 ssize_t parse_header(const uint8_t *data, const uint8_t *pend, RVPU_PRIM_CODE *prim, size_t *plen);
 
+/**
+ * Build message header for given protocol
+ * @param proto RVPU_PROTO_XXX
+ * @param hdr OUT header buffer with at least RVPU_MAX_HDR_SIZE bytes
+ * @return header size
+ */
+size_t rvpu_pack_header(int proto, RK_U32 seq, RVPU_PRIM_CODE prim, size_t length, void *hdr);
+
+/**
+ * Append received data to stream
+ * @return MPP_OK on success
+ */
+MPP_RET rvpu_stream_feed(RvpuStream *s, const void *data, size_t size);
+
+/**
+ * Take next complete message from stream, ascii or binary framing is
+ * detected per message
+ * @param s stream fed by rvpu_stream_feed
+ * @param msg OUT message
+ * @return 1 for one message, 0 for more data required, negative on corruption
+ */
+RK_S32 rvpu_stream_next(RvpuStream *s, RvpuMsg *msg);
+
+void rvpu_stream_reset(RvpuStream *s);
+void rvpu_stream_deinit(RvpuStream *s);
+
+/**
+ * Connect to remote vpu instance and negotiate wire protocol
+ * @param info rvpu context
+ * @return MPP_OK on success
+ */
+MPP_RET rvpu_open(HalRvpuInfo *info);
+
+/**
+ * Flush pending primitives, send DEINIT and disconnect
+ */
+void rvpu_close(HalRvpuInfo *info);
+
+/**
+ * Send primitive together with all pending ones in one sendmsg
+ * @return MPP_OK on success
+ */
+MPP_RET rvpu_send(HalRvpuInfo *info, RVPU_PRIM_CODE prim, const void *data, size_t size);
+
+/**
+ * Queue primitive for the next rvpu_send or rvpu_flush
+ * @return MPP_OK on success
+ */
+MPP_RET rvpu_queue(HalRvpuInfo *info, RVPU_PRIM_CODE prim, const void *data, size_t size);
+
+/**
+ * Send all pending primitives
+ * @return MPP_OK on success
+ */
+MPP_RET rvpu_flush(HalRvpuInfo *info);
+
+/**
+ * Receive one message from remote
+ * @param info rvpu context
+ * @param msg OUT message, valid until next rvpu_recv
+ * @param timeout timeout in ms, negative for infinite
+ * @return 1 for one message, 0 for timeout, negative on error
+ */
+RK_S32 rvpu_recv(HalRvpuInfo *info, RvpuMsg *msg, RK_S32 timeout);
+
+/**
+ * Wait the completion of one RVPU_PRIM_WAIT request
+ * @param info rvpu context
+ * @param seq sequence id of the WAIT request
+ * @param result OUT packet of the completed frame
+ * @param timeout timeout in ms
+ * @return 1 on completion, 0 for timeout, negative on error
+ */
+RK_S32 rvpu_wait(HalRvpuInfo *info, RK_U32 seq, RvpuWaitResult *result, RK_S32 timeout);
+
+/**
+ * Track frames in flight, at most info->depth of them. The references of
+ * input and output are taken over, rvpu_inflight_release puts them after pop.
+ */
+void rvpu_inflight_push(HalRvpuInfo *info, RK_U32 seq, RK_S32 type, RK_S64 pts,
+                        MppBuffer input, MppBuffer output);
+RvpuInflight *rvpu_inflight_peek(HalRvpuInfo *info);
+RvpuInflight *rvpu_inflight_pop(HalRvpuInfo *info);
+RvpuInflight *rvpu_inflight_pop_newest(HalRvpuInfo *info);
+void rvpu_inflight_release(RvpuInflight *frame);
+void rvpu_inflight_reset(HalRvpuInfo *info);
+
 #ifdef __cplusplus
 }
 #endif
@@ -20,16 +20,25 @@
 #include <math.h>
 #include <limits.h>
 
+#include "mpp_env.h"
 #include "mpp_device.h"
 #include "mpp_common.h"
 #include "mpp_mem.h"
+#include "mpp_packet.h"
 
 #include "h264_syntax.h"
 
 #include "hal_h264e_x264.h"
+#include "rvpu_convert.h"
 #include "x264.h"
 #include "x264_config.h"
 
+/*
+ * x264 takes a frame counter as pts, the caller pts is looked up when the frame
+ * comes out. Must exceed the delay of x264, bframes + lookahead + threads.
+ */
+#define X264_PTS_RING           (64)
+
 /**
  * Context for x264 encoder, keep in H264eHalContext::extra_info
  */
@@ -40,6 +49,20 @@ typedef struct hal_x264_info_s {
     x264_picture_t *out_pic;
 
     uint32_t        bitrate;
+
+    // input layout from prep cfg
+    MppFrameFormat  format;
+    RK_U32          hor_stride;
+    RK_U32          ver_stride;
+    RK_U32          copy_input; /**< in_pic owns planes, input converted into them */
+    RvpuConvert     convert;
+
+    // caller pts of the frames in x264, indexed by frame counter
+    RK_S64          frame_num;
+    RK_S64          pts[X264_PTS_RING];
+    // first caller pts and pts step, kept out of the ring for negative dts
+    RK_S64          pts_base;
+    RK_S64          pts_step;
 } Halx264ExtraInfo;
 
 /**
@@ -69,19 +92,136 @@ static int get_rf_constant(Halx264ExtraInfo *info)
     return 24;
 }
 
+/*
+ * x264 colorspace of the input formats which are encoded in place, only 4:2:0
+ * ones as the input colorspace also selects the chroma format of the stream
+ */
+static int get_x264_csp(MppFrameFormat fmt)
+{
+    switch (fmt) {
+    case MPP_FMT_YUV420SP:
+        return X264_CSP_NV12;
+    case MPP_FMT_YUV420SP_VU:
+        return X264_CSP_NV21;
+    case MPP_FMT_YUV420P:
+        return X264_CSP_I420;
+    default:
+        return X264_CSP_NONE;
+    }
+}
+
+static void set_input_layout(Halx264ExtraInfo *info, MppEncPrepCfg *prep)
+{
+    info->format     = prep->format;
+    info->hor_stride = prep->hor_stride ? prep->hor_stride : prep->width;
+    info->ver_stride = prep->ver_stride ? prep->ver_stride : prep->height;
+}
+
+static void release_pictures(Halx264ExtraInfo *info)
+{
+    // wrapped planes belong to the input buffer
+    if (info->in_pic && info->copy_input)
+        x264_picture_clean(info->in_pic);
+    MPP_FREE(info->in_pic);
+    MPP_FREE(info->out_pic);
+}
+
+/*
+ * Point the x264 picture at the input buffer, no copy
+ */
+static MPP_RET wrap_input(Halx264ExtraInfo *info, MppBuffer input)
+{
+    x264_image_t *img = &info->in_pic->img;
+    RK_U8 *pbuf = mpp_buffer_get_ptr(input);
+    size_t luma = info->hor_stride * info->ver_stride;
+
+    if (NULL == pbuf || mpp_buffer_get_size(input) < luma * 3 / 2) {
+        mpp_err("invalid input buffer %p size %d", pbuf, (int)mpp_buffer_get_size(input));
+        return MPP_NOK;
+    }
+
+    img->plane[0]    = pbuf;
+    img->i_stride[0] = info->hor_stride;
+    img->plane[1]    = pbuf + luma;
+
+    if (img->i_csp == X264_CSP_I420) {
+        img->i_stride[1] = info->hor_stride / 2;
+        img->plane[2]    = pbuf + luma + luma / 4;
+        img->i_stride[2] = info->hor_stride / 2;
+    } else {
+        // NV12 / NV21 interleaved chroma
+        img->i_stride[1] = info->hor_stride;
+    }
+
+    return MPP_OK;
+}
+
+/*
+ * Convert the layouts x264 can not take into the I420 planes of in_pic
+ */
+static MPP_RET convert_input(Halx264ExtraInfo *info, MppBuffer input)
+{
+    x264_image_t *img = &info->in_pic->img;
+    size_t size = rvpu_image_size(info->format, info->hor_stride, info->ver_stride);
+    RvpuImage src;
+    RvpuImage dst;
+
+    if (mpp_buffer_get_size(input) < size) {
+        mpp_err("invalid input buffer size %d format %d needs %d",
+                (int)mpp_buffer_get_size(input), info->format, (int)size);
+        return MPP_NOK;
+    }
+
+    if (rvpu_image_setup(&src, mpp_buffer_get_ptr(input), info->format,
+                         info->param.i_width, info->param.i_height,
+                         info->hor_stride, info->ver_stride))
+        return MPP_NOK;
+
+    dst.format    = MPP_FMT_YUV420P;
+    dst.width     = info->param.i_width;
+    dst.height    = info->param.i_height;
+    dst.plane[0]  = img->plane[0];
+    dst.stride[0] = img->i_stride[0];
+    dst.plane[1]  = img->plane[1];
+    dst.stride[1] = img->i_stride[1];
+    dst.plane[2]  = img->plane[2];
+    dst.stride[2] = img->i_stride[2];
+
+    return rvpu_convert_to_i420(info->convert, &src, &dst);
+}
+
+/*
+ * Map x264 timestamp back to caller pts. Leading dts of reordered streams are
+ * negative and extrapolated from the first frame.
+ */
+static RK_S64 get_caller_pts(Halx264ExtraInfo *info, int64_t ts)
+{
+    if (ts < 0)
+        return info->pts_base + ts * info->pts_step;
+    return info->pts[ts % X264_PTS_RING];
+}
+
 static MPP_RET reinit_x264_encoder(x264_param_t *param, Halx264ExtraInfo *info)
 {
     int max_cached_frames;
+    int i_csp = get_x264_csp(info->format);
 
     mpp_log("init x264 %dx%d %d fps", param->i_width, param->i_height, param->i_fps_num);
 
+    if (i_csp == X264_CSP_NONE && !rvpu_image_bpp(info->format)) {
+        mpp_err("unsupported input format %d", info->format);
+        return MPP_NOK;
+    }
+
     if (NULL != info->encoder) {
-        x264_picture_clean(info->in_pic);
         x264_encoder_close(info->encoder);
-        MPP_FREE(info->in_pic);
-        MPP_FREE(info->out_pic);
+        release_pictures(info);
     }
 
+    // layouts x264 can not take are converted to I420
+    info->copy_input = (i_csp == X264_CSP_NONE);
+    param->i_csp = info->copy_input ? X264_CSP_I420 : i_csp;
+
     if (NULL == (info->encoder = x264_encoder_open(param))) {
         mpp_err("x264_encoder_open failed");
         return MPP_NOK;
@@ -89,14 +229,33 @@ static MPP_RET reinit_x264_encoder(x264_param_t *param, Halx264ExtraInfo *info)
 
     max_cached_frames = x264_encoder_maximum_delayed_frames(info->encoder);
     mpp_log("max caches frames %d", max_cached_frames);
+    if (max_cached_frames >= X264_PTS_RING)
+        mpp_err("x264 delays %d frames beyond pts ring %d", max_cached_frames, X264_PTS_RING);
+    info->frame_num = 0;
+    info->pts_base  = 0;
+    info->pts_step  = 1;
 
     info->in_pic  = mpp_calloc(x264_picture_t, 1);
     info->out_pic = mpp_calloc(x264_picture_t, 1);
     x264_picture_init(info->out_pic);
 
-    int i_csp = param->i_csp; // X264_CSP_I420
+    if (!info->copy_input) {
+        mpp_log("x264 takes format %d input in place", info->format);
+        x264_picture_init(info->in_pic);
+        info->in_pic->img.i_csp   = param->i_csp;
+        info->in_pic->img.i_plane = (param->i_csp == X264_CSP_I420) ? 3 : 2;
+        return MPP_OK;
+    }
+
+    if (NULL == info->convert && rvpu_convert_init(&info->convert)) {
+        info->copy_input = 0;
+        return MPP_ERR_NOMEM;
+    }
+
+    i_csp = param->i_csp; // X264_CSP_I420
     if (x264_picture_alloc(info->in_pic, i_csp, param->i_width, param->i_height)) {
         mpp_err("x264_picture_alloc failed");
+        info->copy_input = 0;
         return MPP_ERR_NOMEM;
     }
     info->in_pic->img.i_csp   = i_csp;
@@ -133,6 +292,7 @@ MPP_RET hal_h264e_x264_init(void *hal, MppHalCfg *cfg)
 
     param->i_width       = ecfg->prep.width;
     param->i_height      = ecfg->prep.height;
+    set_input_layout(info, &ecfg->prep);
     param->i_csp         = X264_CSP_I420;       // X264_CSP_BGRA
     param->i_frame_total = 0;                   // 编码总帧数. 默认用0.
     param->i_keyint_max  = 3;
@@ -160,7 +320,8 @@ MPP_RET hal_h264e_x264_init(void *hal, MppHalCfg *cfg)
     param->psz_cqm_file = NULL;
     param->analyse.i_weighted_pred = X264_WEIGHTP_NONE;
     param->rc.i_lookahead = 10;
-    param->i_bframe = 0;
+    // bframes delay output, the delayed frames are drained after eos
+    mpp_env_get_u32("x264_bframes", (RK_U32 *)&param->i_bframe, 0);
 
     return MPP_OK;
 }
@@ -175,10 +336,10 @@ MPP_RET hal_h264e_x264_deinit(void *hal)
 
     if (ctx->extra_info) {
         Halx264ExtraInfo *info = (Halx264ExtraInfo *)ctx->extra_info;
-        x264_picture_clean(info->in_pic);
-        x264_encoder_close(info->encoder);
-        MPP_FREE(info->in_pic);
-        MPP_FREE(info->out_pic);
+        if (info->encoder)
+            x264_encoder_close(info->encoder);
+        release_pictures(info);
+        rvpu_convert_deinit(info->convert);
         MPP_FREE(ctx->extra_info);
     }
 
@@ -213,46 +374,63 @@ MPP_RET hal_h264e_x264_start(void *hal, HalTaskInfo *task)
     return MPP_OK;
 }
 
+/*
+ * x264 gives out frames as its lookahead and bframes release them, so the
+ * packet of this task may belong to an earlier frame or be empty. A task
+ * without input drains one delayed frame after eos.
+ */
 MPP_RET hal_h264e_x264_wait(void *hal, HalTaskInfo *task)
 {
     H264eHalContext *ctx = (H264eHalContext *)hal;
     Halx264ExtraInfo *info = (Halx264ExtraInfo *)ctx->extra_info;
     x264_picture_t *in_pic = info->in_pic;
+    x264_picture_t *out_pic = info->out_pic;
     x264_nal_t *nal;
     int i, i_nal = 0, ret;
     MppBuffer   input  = task->enc.input;
     MppBuffer   output = task->enc.output;
+    unsigned char *pbuf;
+    int bsize = 0;
 
     // mpp_log("wait w:%u v:%u\n", ctx->cfg->prep.hor_stride, task->enc.valid);
 
-    // if (info->in_pic->img.i_plane == 3)
-    size_t size = info->param.i_width * info->param.i_height;
-    unsigned char *pbuf = mpp_buffer_get_ptr(input);
-
-    size_t plane_size = (size >> 2);    // size / 4
-    memcpy(in_pic->img.plane[0], pbuf, size);
-    memcpy(in_pic->img.plane[1], pbuf + size, plane_size);
-    memcpy(in_pic->img.plane[2], pbuf + size + plane_size, plane_size);
+    task->enc.length = 0;
+    task->enc.delayed = 0;
 
-    in_pic->i_type    = X264_TYPE_AUTO;
-    in_pic->i_qpplus1 = 0;
-    in_pic->param     = &info->param;
-    in_pic->i_pts     = 0;
-
-    ret = x264_encoder_encode(info->encoder, &nal, &i_nal, in_pic, info->out_pic);
-    // is_keyframe == out_pic->b_keyframe;
-    in_pic->i_pts++;
+    if (NULL == input) {
+        if (!x264_encoder_delayed_frames(info->encoder))
+            return MPP_OK;
+        in_pic = NULL;
+    } else {
+        if (info->copy_input ? convert_input(info, input) : wrap_input(info, input))
+            return MPP_NOK;
+
+        in_pic->i_type    = X264_TYPE_AUTO;
+        in_pic->i_qpplus1 = 0;
+        in_pic->param     = &info->param;
+        in_pic->i_pts     = info->frame_num;
+        info->pts[info->frame_num % X264_PTS_RING] =
+            (task->enc.frame) ? mpp_frame_get_pts(task->enc.frame) : info->frame_num;
+        if (info->frame_num == 0)
+            info->pts_base = info->pts[0];
+        else if (info->frame_num == 1)
+            info->pts_step = info->pts[1] - info->pts_base;
+        info->frame_num++;
+    }
 
+    ret = x264_encoder_encode(info->encoder, &nal, &i_nal, in_pic, out_pic);
     if (ret < 0) {
         mpp_err("x264_encoder_encode error: %d", ret);
         return MPP_NOK;
-    } else if (ret == 0) {
-        // data is cached, do NOTHING
-        mpp_log("x264_encoder_encode cached");
-    } else {
-        IOInterruptCB  *int_cb;
-        h264e_feedback *feedback;
-        int bsize = 0;
+    }
+
+    if (ret > 0) {
+        if ((size_t)ret > mpp_buffer_get_size(output)) {
+            mpp_err("x264 frame %d bytes overflows packet buffer %d",
+                    ret, (int)mpp_buffer_get_size(output));
+            return MPP_NOK;
+        }
+
         pbuf = mpp_buffer_get_ptr(output);
         for (i = 0; i < i_nal; i++) {
             RK_U8 *payload = nal[i].p_payload;
@@ -264,12 +442,22 @@ MPP_RET hal_h264e_x264_wait(void *hal, HalTaskInfo *task)
             }
         }
 
-        feedback = &ctx->feedback;
+        mpp_packet_set_pts(task->enc.packet, get_caller_pts(info, out_pic->i_pts));
+        mpp_packet_set_dts(task->enc.packet, get_caller_pts(info, out_pic->i_dts));
+        task->enc.is_intra = out_pic->b_keyframe;
+    }
+
+    task->enc.length  = bsize;
+    task->enc.delayed = x264_encoder_delayed_frames(info->encoder);
+
+    // rate control is only started for input frames, see enc_impl_proc_hal
+    if (in_pic) {
+        IOInterruptCB  *int_cb = &ctx->int_cb;
+        h264e_feedback *feedback = &ctx->feedback;
+
         feedback->hw_status = 0;
         feedback->out_strm_size = bsize;
-        task->enc.length = bsize;
 
-        int_cb = &ctx->int_cb;
         if (int_cb->callBack) {
             RcHalResult result;
             result.bits = bsize * 8;
@@ -283,27 +471,35 @@ MPP_RET hal_h264e_x264_wait(void *hal, HalTaskInfo *task)
     return MPP_OK;
 }
 
+/*
+ * x264 can not drop its delayed frames, reopen the encoder instead
+ */
 MPP_RET hal_h264e_x264_reset(void *hal)
 {
+    H264eHalContext *ctx = (H264eHalContext *)hal;
+    Halx264ExtraInfo *info = (Halx264ExtraInfo *)ctx->extra_info;
+
     mpp_log("reset %p\n", hal);
+
+    if (info && info->encoder && x264_encoder_delayed_frames(info->encoder))
+        return reinit_x264_encoder(&info->param, info);
+
     return MPP_OK;
 }
 
+/*
+ * Delayed frames are output by the drain tasks of mpp_enc after eos, what is
+ * still left here is dropped on close.
+ */
 MPP_RET hal_h264e_x264_flush(void *hal)
 {
     H264eHalContext *ctx = (H264eHalContext *)hal;
+    Halx264ExtraInfo *info = (Halx264ExtraInfo *)ctx->extra_info;
 
     mpp_log("flush %p\n", hal);
 
-    if (ctx->extra_info) {
-        Halx264ExtraInfo *info = (Halx264ExtraInfo *)ctx->extra_info;
-        x264_picture_t pic_out;
-        x264_nal_t *nal;
-        int i_nal;
-        if (x264_encoder_encode(info->encoder, &nal, &i_nal, NULL, &pic_out) < 0) {
-            // NOTHING
-        }
-    }
+    if (info && info->encoder && x264_encoder_delayed_frames(info->encoder))
+        mpp_log("drop %d delayed frames", x264_encoder_delayed_frames(info->encoder));
 
     return MPP_OK;
 }
@@ -321,8 +517,22 @@ MPP_RET hal_h264e_x264_control(void *hal, RK_S32 cmd, void *arg)
         if (info) {
             x264_param_t *param = &info->param;
             MppEncCfgSet *ecfg = ctx->set;
+            MppFrameFormat format = info->format;
+            RK_U32 hor_stride = info->hor_stride;
+            RK_U32 ver_stride = info->ver_stride;
+            int changed = param->i_width != ecfg->prep.width ||
+                          param->i_height != ecfg->prep.height;
+
             param->i_width  = ecfg->prep.width;
             param->i_height = ecfg->prep.height;
+            set_input_layout(info, &ecfg->prep);
+            changed |= format != info->format ||
+                       hor_stride != info->hor_stride ||
+                       ver_stride != info->ver_stride;
+
+            // an opened encoder keeps its geometry and input csp, reopen it
+            if (changed && info->encoder)
+                ret = reinit_x264_encoder(param, info);
         }
         break;
     
@@ -21,7 +21,8 @@
 // TODO(fbarchard): Some of these functions lack parameter setting.
 
 #ifdef __cplusplus
-namespace libyuv {
+namespace libyuv
+{
 extern "C" {
 #endif
 
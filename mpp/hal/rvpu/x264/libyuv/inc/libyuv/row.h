@@ -16,7 +16,8 @@
 #include "libyuv/basic_types.h"
 
 #ifdef __cplusplus
-namespace libyuv {
+namespace libyuv
+{
 extern "C" {
 #endif
 
@@ -614,31 +615,31 @@ typedef uint8_t ulvec8[32];
 #if defined(__aarch64__)
 // This struct is for Arm64 color conversion.
 struct YuvConstants {
-  uvec16 kUVToRB;
-  uvec16 kUVToRB2;
-  uvec16 kUVToG;
-  uvec16 kUVToG2;
-  vec16 kUVBiasBGR;
-  vec32 kYToRgb;
+    uvec16 kUVToRB;
+    uvec16 kUVToRB2;
+    uvec16 kUVToG;
+    uvec16 kUVToG2;
+    vec16 kUVBiasBGR;
+    vec32 kYToRgb;
 };
 #elif defined(__arm__)
 // This struct is for ArmV7 color conversion.
 struct YuvConstants {
-  uvec8 kUVToRB;
-  uvec8 kUVToG;
-  vec16 kUVBiasBGR;
-  vec32 kYToRgb;
+    uvec8 kUVToRB;
+    uvec8 kUVToG;
+    vec16 kUVBiasBGR;
+    vec32 kYToRgb;
 };
 #else
 // This struct is for Intel color conversion.
 struct YuvConstants {
-  int8_t kUVToB[32];
-  int8_t kUVToG[32];
-  int8_t kUVToR[32];
-  int16_t kUVBiasB[16];
-  int16_t kUVBiasG[16];
-  int16_t kUVBiasR[16];
-  int16_t kYToRgb[16];
+    int8_t kUVToB[32];
+    int8_t kUVToG[32];
+    int8_t kUVToR[32];
+    int16_t kUVBiasB[16];
+    int16_t kUVBiasG[16];
+    int16_t kUVBiasR[16];
+    int16_t kYToRgb[16];
 };
 
 // Offsets into YuvConstants structure
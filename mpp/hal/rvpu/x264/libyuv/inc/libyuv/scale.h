@@ -14,16 +14,17 @@
 #include "libyuv/basic_types.h"
 
 #ifdef __cplusplus
-namespace libyuv {
+namespace libyuv
+{
 extern "C" {
 #endif
 
 // Supported filtering.
 typedef enum FilterMode {
-  kFilterNone = 0,      // Point sample; Fastest.
-  kFilterLinear = 1,    // Filter horizontally only.
-  kFilterBilinear = 2,  // Faster than box, but lower quality scaling down.
-  kFilterBox = 3        // Highest quality.
+    kFilterNone = 0,      // Point sample; Fastest.
+    kFilterLinear = 1,    // Filter horizontally only.
+    kFilterBilinear = 2,  // Faster than box, but lower quality scaling down.
+    kFilterBox = 3        // Highest quality.
 } FilterModeEnum;
 
 // Scale a YUV plane.
@@ -99,28 +100,28 @@ int I420Scale_16(const uint16_t* src_y,
 
 #ifdef __cplusplus
 // Legacy API.  Deprecated.
-LIBYUV_API
-int Scale(const uint8_t* src_y,
-          const uint8_t* src_u,
-          const uint8_t* src_v,
-          int src_stride_y,
-          int src_stride_u,
-          int src_stride_v,
-          int src_width,
-          int src_height,
-          uint8_t* dst_y,
-          uint8_t* dst_u,
-          uint8_t* dst_v,
-          int dst_stride_y,
-          int dst_stride_u,
-          int dst_stride_v,
-          int dst_width,
-          int dst_height,
-          LIBYUV_BOOL interpolate);
+    LIBYUV_API
+    int Scale(const uint8_t* src_y,
+              const uint8_t* src_u,
+              const uint8_t* src_v,
+              int src_stride_y,
+              int src_stride_u,
+              int src_stride_v,
+              int src_width,
+              int src_height,
+              uint8_t* dst_y,
+              uint8_t* dst_u,
+              uint8_t* dst_v,
+              int dst_stride_y,
+              int dst_stride_u,
+              int dst_stride_v,
+              int dst_width,
+              int dst_height,
+              LIBYUV_BOOL interpolate);
 
 // For testing, allow disabling of specialized scalers.
-LIBYUV_API
-void SetUseReferenceImpl(LIBYUV_BOOL use);
+    LIBYUV_API
+    void SetUseReferenceImpl(LIBYUV_BOOL use);
 #endif  // __cplusplus
 
 #ifdef __cplusplus
@@ -15,7 +15,8 @@
 #include "libyuv/scale.h"  // For FilterMode
 
 #ifdef __cplusplus
-namespace libyuv {
+namespace libyuv
+{
 extern "C" {
 #endif
 
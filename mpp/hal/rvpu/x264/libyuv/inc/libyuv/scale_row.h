@@ -15,7 +15,8 @@
 #include "libyuv/scale.h"
 
 #ifdef __cplusplus
-namespace libyuv {
+namespace libyuv
+{
 extern "C" {
 #endif
 
@@ -30,6 +30,9 @@
 #include "hal_jpege_base.h"
 #include "hal_jpege_vepu1.h"
 #include "hal_jpege_vepu2.h"
+#ifdef USE_SOFT_JPEG
+#include "hal_jpege_stub.h"
+#endif
 
 #include "mpp_device.h"
 #include "mpp_platform.h"
@@ -94,8 +97,21 @@ static MPP_RET hal_jpege_init(void *hal, MppHalCfg *cfg)
 
     // NOTE: rk3036 and rk3228 do NOT have jpeg encoder
     if (NULL == mpp_get_vcodec_dev_name(MPP_CTX_ENC, MPP_VIDEO_CodingMJPEG)) {
+#ifdef USE_SOFT_JPEG
+        p_api->init    = hal_jpege_stub_init;
+        p_api->deinit  = hal_jpege_stub_deinit;
+        p_api->reg_gen = hal_jpege_stub_gen_regs;
+        p_api->start   = hal_jpege_stub_start;
+        p_api->wait    = hal_jpege_stub_wait;
+        p_api->reset   = hal_jpege_stub_reset;
+        p_api->flush   = hal_jpege_stub_flush;
+        p_api->control = hal_jpege_stub_control;
+        mpp_log("SOC %s use software jpeg encoder\n", mpp_get_soc_name());
+        return p_api->init(ctx, cfg);
+#else
         mpp_err("SOC %s do NOT support jpeg encoding\n", mpp_get_soc_name());
         return MPP_ERR_INIT;
+#endif
     }
 
     hw_flag = mpp_get_vcodec_type();
@@ -44,6 +44,7 @@ typedef struct hal_jpege_ctx_s {
     JpegeSyntax         syntax;
 
     MppHalApi           hal_api;
+    void                *extra_info;    /* software encoder state */
 } HalJpegeCtx;
 
 extern RK_U32 hal_jpege_debug;
@@ -58,6 +58,7 @@
 #define MPP_ENC_NOTIFY_FRAME_DEQUEUE        (MPP_INPUT_DEQUEUE)
 #define MPP_ENC_NOTIFY_PACKET_ENQUEUE       (MPP_OUTPUT_ENQUEUE)
 #define MPP_ENC_CONTROL                     (0x00000010)
+#define MPP_ENC_NOTIFY_TASK_DONE            (0x00000020)
 #define MPP_ENC_RESET                       (MPP_RESET)
 
 /*
@@ -99,6 +100,7 @@ public:
     ~Mpp();
     MPP_RET init(MppCtxType type, MppCodingType coding);
     MPP_RET put_packet(MppPacket packet);
+    MPP_RET put_packets(MppPacket *packets, RK_S32 count, RK_S32 *sent);
     MPP_RET get_frame(MppFrame *frame);
 
     MPP_RET put_frame(MppFrame frame);
@@ -114,6 +116,10 @@ public:
     MPP_RET notify(RK_U32 flag);
     MPP_RET notify(MppBufferGroup group);
 
+    /* sync the readiness event fd with the queue, called with the queue locked */
+    void    update_input_event();
+    void    update_output_event();
+
     mpp_list        *mPackets;
     mpp_list        *mFrames;
     mpp_list        *mTimeStamps;
@@ -124,6 +130,9 @@ public:
     RK_U32          mFrameGetCount;
     RK_U32          mTaskPutCount;
     RK_U32          mTaskGetCount;
+    /* input bytes copied by put_packet and bytes taken by reference */
+    RK_S64          mPacketCopyBytes;
+    RK_S64          mPacketZeroCopyBytes;
 
     /*
      * packet buffer group
@@ -147,6 +156,21 @@ public:
     MppPollType     mInputTimeout;
     MppPollType     mOutputTimeout;
 
+    /*
+     * decoder: packet queue depth before put_packet reports full
+     * encoder: frames in flight for asynchronous put_frame, 0 is synchronous
+     */
+    RK_U32          mInputDepth;
+
+    /*
+     * eventfd readable while the port is ready, created on request:
+     * input while the packet queue has room, output while frames wait
+     */
+    RK_S32          mInputEventFd;
+    RK_S32          mOutputEventFd;
+    RK_U32          mInputEventSet;
+    RK_U32          mOutputEventSet;
+
     MppTask         mInputTask;
 
     MppDec          mDec;
@@ -156,6 +180,10 @@ public:
 
 private:
     void clear();
+    MPP_RET put_frame_async(MppFrame frame);
+    MPP_RET wait_input_room();
+    MPP_RET queue_packet(MppPacket packet);
+    MPP_RET get_event_fd(MppPortType type, RK_S32 *fd);
 
     MppCtxType      mType;
     MppCodingType   mCoding;
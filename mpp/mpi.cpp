@@ -165,6 +165,45 @@ static MPP_RET mpi_decode_put_packet(MppCtx ctx, MppPacket packet)
     return ret;
 }
 
+static MPP_RET mpi_decode_put_packets(MppCtx ctx, MppPacket *packets,
+                                      RK_S32 count, RK_S32 *sent)
+{
+    MPP_RET ret = MPP_NOK;
+    MpiImpl *p = (MpiImpl *)ctx;
+    RK_S32 i;
+
+    mpi_dbg_func("enter ctx %p packets %p count %d\n", ctx, packets, count);
+    if (sent)
+        *sent = 0;
+
+    do {
+        ret = check_mpp_ctx(p);
+        if (ret)
+            break;
+
+        if (NULL == packets || count < 0) {
+            mpp_err_f("found invalid input packets %p count %d\n", packets, count);
+            ret = MPP_ERR_NULL_PTR;
+            break;
+        }
+
+        for (i = 0; i < count; i++) {
+            if (NULL == packets[i]) {
+                mpp_err_f("found NULL input packet at %d\n", i);
+                ret = MPP_ERR_NULL_PTR;
+                break;
+            }
+        }
+        if (ret)
+            break;
+
+        ret = p->ctx->put_packets(packets, count, sent);
+    } while (0);
+
+    mpi_dbg_func("leave ret %d\n", ret);
+    return ret;
+}
+
 static MPP_RET mpi_decode_get_frame(MppCtx ctx, MppFrame *frame)
 {
     MPP_RET ret = MPP_NOK;
@@ -404,6 +443,10 @@ static MPP_RET mpi_control(MppCtx ctx, MpiCmd cmd, MppParam param)
     return ret;
 }
 
+/* MppApi size must not change, 14 function pointers and 16 reserved words */
+typedef char mpp_api_size_check[(sizeof(MppApi) == 2 * sizeof(RK_U32) +
+                                 14 * sizeof(void *) + 16 * sizeof(RK_U32)) ? 1 : -1];
+
 static MppApi mpp_api = {
     sizeof(mpp_api),
     0,
@@ -421,6 +464,7 @@ static MppApi mpp_api = {
     mpi_enqueue,
     mpi_reset,
     mpi_control,
+    mpi_decode_put_packets,
     {0},
 };
 
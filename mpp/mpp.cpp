@@ -17,12 +17,15 @@
 #define  MODULE_TAG "mpp"
 
 #include <errno.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
 
 #include "rk_mpi.h"
 
 #include "mpp_log.h"
 #include "mpp_mem.h"
 #include "mpp_env.h"
+#include "mpp_common.h"
 #include "mpp_time.h"
 #include "mpp_impl.h"
 
@@ -37,6 +40,12 @@
 #define MPP_TEST_FRAME_SIZE     SZ_1M
 #define MPP_TEST_PACKET_SIZE    SZ_512K
 
+// preallocated nodes of the port queues, deeper queues spill to heap
+#define MPP_PACKET_QUEUE_NODES  8
+#define MPP_FRAME_QUEUE_NODES   16
+
+#define MPP_INPUT_DEPTH_DEFAULT 4
+
 static void mpp_notify_by_buffer_group(void *arg, void *group)
 {
     Mpp *mpp = (Mpp *)arg;
@@ -54,6 +63,8 @@ Mpp::Mpp()
       mFrameGetCount(0),
       mTaskPutCount(0),
       mTaskGetCount(0),
+      mPacketCopyBytes(0),
+      mPacketZeroCopyBytes(0),
       mPacketGroup(NULL),
       mFrameGroup(NULL),
       mExternalFrameGroup(0),
@@ -63,6 +74,11 @@ Mpp::Mpp()
       mOutputTaskQueue(NULL),
       mInputTimeout(MPP_POLL_BUTT),
       mOutputTimeout(MPP_POLL_BUTT),
+      mInputDepth(0),
+      mInputEventFd(-1),
+      mOutputEventFd(-1),
+      mInputEventSet(0),
+      mOutputEventSet(0),
       mInputTask(NULL),
       mDec(NULL),
       mEnc(NULL),
@@ -95,9 +111,12 @@ MPP_RET Mpp::init(MppCtxType type, MppCodingType coding)
     mCoding = coding;
     switch (mType) {
     case MPP_CTX_DEC : {
-        mPackets    = new mpp_list((node_destructor)mpp_packet_deinit);
-        mFrames     = new mpp_list((node_destructor)mpp_frame_deinit);
-        mTimeStamps = new mpp_list((node_destructor)mpp_packet_deinit);
+        mPackets    = new mpp_list((node_destructor)mpp_packet_deinit,
+                                   sizeof(MppPacket), MPP_PACKET_QUEUE_NODES);
+        mFrames     = new mpp_list((node_destructor)mpp_frame_deinit,
+                                   sizeof(MppFrame), MPP_FRAME_QUEUE_NODES);
+        mTimeStamps = new mpp_list((node_destructor)mpp_packet_deinit,
+                                   sizeof(MppPacket), MPP_FRAME_QUEUE_NODES);
 
         if (mInputTimeout == MPP_POLL_BUTT)
             mInputTimeout = MPP_POLL_NON_BLOCK;
@@ -105,6 +124,13 @@ MPP_RET Mpp::init(MppCtxType type, MppCodingType coding)
         if (mOutputTimeout == MPP_POLL_BUTT)
             mOutputTimeout = MPP_POLL_NON_BLOCK;
 
+        if (!mInputDepth) {
+            mpp_env_get_u32("mpp_input_depth", &mInputDepth,
+                            MPP_INPUT_DEPTH_DEFAULT);
+            if (!mInputDepth)
+                mInputDepth = MPP_INPUT_DEPTH_DEFAULT;
+        }
+
         if (mCoding != MPP_VIDEO_CodingMJPEG) {
             mpp_buffer_group_get_internal(&mPacketGroup, MPP_BUFFER_TYPE_ION);
             mpp_buffer_group_limit_config(mPacketGroup, 0, 3);
@@ -137,8 +163,10 @@ MPP_RET Mpp::init(MppCtxType type, MppCodingType coding)
         mInitDone = 1;
     } break;
     case MPP_CTX_ENC : {
-        mFrames     = new mpp_list((node_destructor)NULL);
-        mPackets    = new mpp_list((node_destructor)mpp_packet_deinit);
+        mFrames     = new mpp_list((node_destructor)NULL,
+                                   sizeof(MppFrame), MPP_FRAME_QUEUE_NODES);
+        mPackets    = new mpp_list((node_destructor)mpp_packet_deinit,
+                                   sizeof(MppPacket), MPP_PACKET_QUEUE_NODES);
 
         if (mInputTimeout == MPP_POLL_BUTT)
             mInputTimeout = MPP_POLL_BLOCK;
@@ -149,10 +177,11 @@ MPP_RET Mpp::init(MppCtxType type, MppCodingType coding)
         mpp_buffer_group_get_internal(&mPacketGroup, MPP_BUFFER_TYPE_ION);
         mpp_buffer_group_get_internal(&mFrameGroup, MPP_BUFFER_TYPE_ION);
 
+        // asynchronous put_frame keeps input depth frames in flight
         mpp_task_queue_init(&mInputTaskQueue);
         mpp_task_queue_init(&mOutputTaskQueue);
-        mpp_task_queue_setup(mInputTaskQueue, 1);
-        mpp_task_queue_setup(mOutputTaskQueue, 1);
+        mpp_task_queue_setup(mInputTaskQueue, MPP_MAX(mInputDepth, 1));
+        mpp_task_queue_setup(mOutputTaskQueue, MPP_MAX(mInputDepth, 1));
 
         mInputPort  = mpp_task_queue_get_port(mInputTaskQueue,  MPP_PORT_INPUT);
         mOutputPort = mpp_task_queue_get_port(mOutputTaskQueue, MPP_PORT_OUTPUT);
@@ -202,6 +231,10 @@ void Mpp::clear()
                                       NULL, NULL);
 
     if (mType == MPP_CTX_DEC) {
+        if (mpp_debug & MPP_DBG_INFO)
+            mpp_log("input packet %d copied %lld bytes zero copy %lld bytes\n",
+                    mPacketPutCount, mPacketCopyBytes, mPacketZeroCopyBytes);
+
         if (mDec) {
             mpp_dec_stop(mDec);
             mpp_dec_deinit(mDec);
@@ -257,12 +290,108 @@ void Mpp::clear()
         mpp_buffer_group_put(mFrameGroup);
         mFrameGroup = NULL;
     }
+    if (mInputEventFd >= 0) {
+        close(mInputEventFd);
+        mInputEventFd = -1;
+    }
+    if (mOutputEventFd >= 0) {
+        close(mOutputEventFd);
+        mOutputEventFd = -1;
+    }
 
     mpp_dump_deinit(&mDump);
 }
 
+/* keep the eventfd counter non-zero exactly while the port is ready */
+static void update_event_fd(RK_S32 fd, RK_U32 *set, RK_U32 ready)
+{
+    uint64_t val = 1;
+
+    if (fd < 0 || *set == ready)
+        return;
+
+    if (ready) {
+        if (write(fd, &val, sizeof(val)) != sizeof(val))
+            return;
+    } else {
+        if (read(fd, &val, sizeof(val)) != sizeof(val))
+            return;
+    }
+
+    *set = ready;
+}
+
+void Mpp::update_input_event()
+{
+    update_event_fd(mInputEventFd, &mInputEventSet,
+                    mPackets->list_size() < (RK_S32)mInputDepth);
+}
+
+void Mpp::update_output_event()
+{
+    update_event_fd(mOutputEventFd, &mOutputEventSet,
+                    mFrames->list_size() > 0);
+}
+
+MPP_RET Mpp::wait_input_room()
+{
+    while (mPackets->list_size() >= (RK_S32)mInputDepth) {
+        if (mInputTimeout == MPP_POLL_NON_BLOCK)
+            return MPP_ERR_BUFFER_FULL;
+
+        if (mInputTimeout < 0) {
+            /* block wait */
+            mPackets->wait();
+        } else {
+            RK_S32 ret = mPackets->wait(mInputTimeout);
+            if (ret)
+                return (ret == ETIMEDOUT) ? MPP_ERR_TIMEOUT : MPP_NOK;
+        }
+    }
+
+    return MPP_OK;
+}
+
+MPP_RET Mpp::queue_packet(MppPacket packet)
+{
+    MppPacketImpl *impl = (MppPacketImpl *)packet;
+    RK_U32 zero_copy = impl->release || impl->buffer;
+    size_t length = mpp_packet_get_length(packet);
+    MppPacket pkt;
+
+    if (MPP_OK != mpp_packet_copy_init(&pkt, packet))
+        return MPP_NOK;
+
+    if (zero_copy)
+        mPacketZeroCopyBytes += length;
+    else
+        mPacketCopyBytes += length;
+
+    mPackets->add_at_tail(&pkt, sizeof(pkt));
+    mPacketPutCount++;
+    // dump input packet
+    mpp_ops_dec_put_pkt(mDump, packet);
+
+    // when packet has been send clear the length
+    mpp_packet_set_length(packet, 0);
+
+    return MPP_OK;
+}
+
 MPP_RET Mpp::put_packet(MppPacket packet)
 {
+    return put_packets(&packet, 1, NULL);
+}
+
+MPP_RET Mpp::put_packets(MppPacket *packets, RK_S32 count, RK_S32 *sent)
+{
+    MPP_RET ret = MPP_OK;
+    RK_S32 notified = 0;
+    RK_S32 i;
+
+    if (sent)
+        *sent = 0;
+
     if (!mInitDone)
         return MPP_ERR_INIT;
 
@@ -273,25 +402,37 @@ MPP_RET Mpp::put_packet(MppPacket packet)
         mPacketPutCount++;
     }
 
-    RK_U32 eos = mpp_packet_get_eos(packet);
-    if (mPackets->list_size() < 4 || eos) {
-        MppPacket pkt;
-        if (MPP_OK != mpp_packet_copy_init(&pkt, packet))
-            return MPP_NOK;
+    for (i = 0; i < count; i++) {
+        MppPacket packet = packets[i];
 
-        mPackets->add_at_tail(&pkt, sizeof(pkt));
-        mPacketPutCount++;
-        // dump input packet
-        mpp_ops_dec_put_pkt(mDump, packet);
+        // eos always goes in so that the decoder can drain
+        if (!mpp_packet_get_eos(packet) &&
+            mPackets->list_size() >= (RK_S32)mInputDepth) {
+            // the decoder has to see the queued packets before we wait on it
+            if (i > notified) {
+                notify(MPP_INPUT_ENQUEUE);
+                notified = i;
+            }
+
+            ret = wait_input_room();
+            if (ret)
+                break;
+        }
 
-        // when packet has been send clear the length
-        mpp_packet_set_length(packet, 0);
+        ret = queue_packet(packet);
+        if (ret)
+            break;
+    }
 
+    if (i > notified)
         notify(MPP_INPUT_ENQUEUE);
-        return MPP_OK;
-    }
 
-    return MPP_ERR_BUFFER_FULL;
+    update_input_event();
+
+    if (sent)
+        *sent = i;
+
+    return ret;
 }
 
 MPP_RET Mpp::get_frame(MppFrame *frame)
@@ -316,9 +457,13 @@ MPP_RET Mpp::get_frame(MppFrame *frame)
                         return MPP_NOK;
                 }
             }
-        } else {
-            /* NOTE: in non-block mode the sleep is to avoid user's dead loop */
-            msleep(1);
+        } else if (mOutputEventFd < 0) {
+            /*
+             * NOTE: in non-block mode a short wait avoids user's dead loop.
+             * It returns as soon as a frame is queued. Users polling the
+             * output event fd get no wait at all.
+             */
+            mFrames->wait(1);
         }
     }
 
@@ -338,6 +483,8 @@ MPP_RET Mpp::get_frame(MppFrame *frame)
                 prev = next;
             }
         }
+
+        update_output_event();
     } else {
         // NOTE: Add signal here is not efficient
         // This is for fix bug of stucking on decoder parser thread
@@ -358,11 +505,49 @@ MPP_RET Mpp::get_frame(MppFrame *frame)
     return MPP_OK;
 }
 
+MPP_RET Mpp::put_frame_async(MppFrame frame)
+{
+    MppTask task = NULL;
+    MPP_RET ret = MPP_NOK;
+
+    /* wait for a free task, encoder has released the frame it carried */
+    ret = poll(MPP_PORT_INPUT, mInputTimeout);
+    if (ret) {
+        mpp_log_f("poll on set timeout %d ret %d\n", mInputTimeout, ret);
+        return ret;
+    }
+
+    ret = dequeue(MPP_PORT_INPUT, &task);
+    if (ret || NULL == task) {
+        mpp_log_f("dequeue on set ret %d task %p\n", ret, task);
+        return ret ? ret : MPP_NOK;
+    }
+
+    ret = mpp_task_meta_set_frame(task, KEY_INPUT_FRAME, frame);
+    if (ret) {
+        mpp_log_f("set input frame to task ret %d\n", ret);
+        /* encoder hands a task without frame straight back, keep the slot */
+        enqueue(MPP_PORT_INPUT, task);
+        return ret;
+    }
+    // dump input
+    mpp_ops_enc_put_frm(mDump, frame);
+
+    ret = enqueue(MPP_PORT_INPUT, task);
+    if (ret)
+        mpp_log_f("enqueue ret %d\n", ret);
+
+    return ret;
+}
+
 MPP_RET Mpp::put_frame(MppFrame frame)
 {
     if (!mInitDone)
         return MPP_ERR_INIT;
 
+    if (mInputDepth)
+        return put_frame_async(frame);
+
     MPP_RET ret = MPP_NOK;
 
     if (mInputTask == NULL) {
@@ -648,12 +833,16 @@ MPP_RET Mpp::reset()
             }
         }
         mPackets->flush();
+        update_input_event();
+        // release put_packet blocked on the full queue
+        mPackets->signal();
         mPackets->unlock();
 
         mpp_dec_reset(mDec);
 
         mFrames->lock();
         mFrames->flush();
+        update_output_event();
         mFrames->unlock();
     } else {
         mFrames->lock();
@@ -716,6 +905,44 @@ MPP_RET Mpp::control_mpp(MpiCmd cmd, MppParam param)
             mOutputTimeout = timeout;
     } break;
 
+    case MPP_SET_INPUT_DEPTH: {
+        RK_U32 depth = (param) ? *((RK_U32 *)param) : 0;
+
+        if (!depth) {
+            mpp_err("invalid input depth %d\n", depth);
+            ret = MPP_ERR_VALUE;
+            break;
+        }
+
+        // encoder task queue is sized on init
+        if (mInitDone && mType == MPP_CTX_ENC) {
+            mpp_err("encoder input depth must be set before init\n");
+            ret = MPP_NOK;
+            break;
+        }
+
+        if (mPackets) {
+            AutoMutex autoLock(mPackets->mutex());
+            mInputDepth = depth;
+            update_input_event();
+            // a deeper queue may release a blocked put_packet
+            mPackets->signal();
+        } else {
+            mInputDepth = depth;
+        }
+    } break;
+
+    case MPP_GET_INPUT_EVENT_FD:
+    case MPP_GET_OUTPUT_EVENT_FD: {
+        if (NULL == param) {
+            ret = MPP_ERR_NULL_PTR;
+            break;
+        }
+
+        ret = get_event_fd((cmd == MPP_GET_INPUT_EVENT_FD) ?
+                           MPP_PORT_INPUT : MPP_PORT_OUTPUT, (RK_S32 *)param);
+    } break;
+
     default : {
         ret = MPP_NOK;
     } break;
@@ -723,6 +950,35 @@ MPP_RET Mpp::control_mpp(MpiCmd cmd, MppParam param)
     return ret;
 }
 
+MPP_RET Mpp::get_event_fd(MppPortType type, RK_S32 *fd)
+{
+    RK_S32 *event_fd = (type == MPP_PORT_INPUT) ? &mInputEventFd : &mOutputEventFd;
+    mpp_list *list = (type == MPP_PORT_INPUT) ? mPackets : mFrames;
+
+    // only the decoder queues packets and frames directly
+    if (!mInitDone || mType != MPP_CTX_DEC) {
+        mpp_err_f("event fd is only available on initialized decoder\n");
+        return MPP_ERR_INIT;
+    }
+
+    AutoMutex autoLock(list->mutex());
+    if (*event_fd < 0) {
+        *event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (*event_fd < 0) {
+            mpp_err_f("eventfd failed errno %d\n", errno);
+            return MPP_NOK;
+        }
+
+        if (type == MPP_PORT_INPUT)
+            update_input_event();
+        else
+            update_output_event();
+    }
+
+    *fd = *event_fd;
+    return MPP_OK;
+}
+
 MPP_RET Mpp::control_osal(MpiCmd cmd, MppParam param)
 {
     MPP_RET ret = MPP_NOK;
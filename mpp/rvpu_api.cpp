@@ -18,15 +18,24 @@
 #define MODULE_TAG "mpp_rvpu"
 
 #include <fcntl.h>
+#include <string.h>
 #include <unistd.h>
+#include <sys/epoll.h>
 #include <sys/errno.h>
+#include <sys/eventfd.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <sys/un.h>
 
+#include <map>
+#include <set>
+#include <deque>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 #include <functional>
+#include <condition_variable>
 
 #include "rk_mpi.h"
 #include "mpp_buffer.h"
@@ -35,81 +44,227 @@
 #include "mpp_log.h"
 #include "mpi_impl.h"
 #include "mpp_info.h"
+#include "mpp_runtime.h"
 
 #include "hal/rvpu/rvpu_api.h"
 #include "hal/rvpu/rvpu_primitive.h"
+#include "hal/rvpu/rvpu_backend.h"
 //#include "rk_venc_cmd.h"
 
-#define MAX_MPP_TRIES           3
 
-static rvpu_callback_t on_ctrl_prep_cb  = NULL;
-static rvpu_callback_t on_packet_cb     = NULL;
-static rvpu_callback_t on_flush_cb      = NULL;
+// callbacks of sessions without their own, see set_rvpu_callback
+static rvpu_callback_t def_ctrl_prep_cb = NULL;
+static rvpu_callback_t def_packet_cb    = NULL;
+static rvpu_callback_t def_flush_cb     = NULL;
 
-static MppApi *mpp_api = nullptr;
+/**
+ * WAIT request of peer, answered in order by the completion thread
+ */
+typedef struct RvpuWaitReq_t {
+    RK_U32          seq;
+    int             proto;      /**< framing of the request */
+    int             has_info;
+    MppBufferInfo   info;       /**< output buffer of peer */
+} RvpuWaitReq;
+
+/**
+ * Connection state of one rvpu-stub peer
+ */
+typedef struct RvpuSession_t {
+    MppCtx      ctx;
+    MppApi      *api;
+    void        *owner;     /**< from rvpu_target_init */
+    int         fd;         /**< -1 if data is fed by process_rvpu_message */
+    int         proto;      /**< protocol of last message from peer */
+    int         closed;     /**< peer has closed the socket */
+    RvpuStream  stream;
+    RK_U32      depth;      /**< frames in flight of peer, see RvpuInitCfg */
+    RK_U32      held_idx;
+    MppPacket   held[RVPU_MAX_INFLIGHT];    /**< packets peer may still import */
+
+    rvpu_callback_t on_ctrl_prep;
+    rvpu_callback_t on_packet;
+    rvpu_callback_t on_flush;
+
+    /*
+     * START only puts the frame and WAIT is queued here, so the frames of
+     * peer in flight are encoded while the oldest one is waited for
+     */
+    std::mutex              lock;       /**< waits, held packets and replies */
+    std::condition_variable cond;
+    std::deque<RvpuWaitReq> waits;
+    std::thread             worker;
+    bool                    quit;
+    bool                    busy;       /**< worker is getting a packet */
+    RK_U32                  gen;        /**< increased on reset */
+    RK_U32                  pending;    /**< frames put without packet got */
+} RvpuSession;
+
+static std::mutex sessions_lock;
+static std::map<MppCtx, RvpuSession *> sessions;
+
+static RvpuSession *get_session(MppCtx ctx)
+{
+    std::lock_guard<std::mutex> lock(sessions_lock);
+    RvpuSession *session = sessions[ctx];
+
+    if (nullptr == session) {
+        session = new RvpuSession();
+        session->ctx            = ctx;
+        session->api            = ((MpiImpl *)ctx)->api;
+        session->fd             = -1;
+        session->on_ctrl_prep   = def_ctrl_prep_cb;
+        session->on_packet      = def_packet_cb;
+        session->on_flush       = def_flush_cb;
+        sessions[ctx] = session;
+    }
+    return session;
+}
+
+/*
+ * Keep the packet buffer out of the pool until peer has imported it, peer
+ * completes a frame only after depth more frames have been sent
+ */
+static void hold_packet(RvpuSession *session, MppPacket packet)
+{
+    MppPacket *slot = &session->held[session->held_idx];
+
+    if (*slot)
+        mpp_packet_deinit(slot);
+
+    *slot = packet;
+    session->held_idx = (session->held_idx + 1) % MPP_MAX(session->depth, 1);
+}
+
+static void release_packets(RvpuSession *session)
+{
+    RK_U32 i;
 
-static void stream_init(MppCtx ctx, void *cfg)
+    for (i = 0; i < RVPU_MAX_INFLIGHT; i++) {
+        if (session->held[i])
+            mpp_packet_deinit(&session->held[i]);
+    }
+    session->held_idx = 0;
+}
+
+static void stop_worker(RvpuSession *session)
+{
+    {
+        std::lock_guard<std::mutex> lock(session->lock);
+        session->quit = true;
+        session->cond.notify_all();
+    }
+
+    if (session->worker.joinable())
+        session->worker.join();
+}
+
+static void put_session(MppCtx ctx)
 {
+    std::lock_guard<std::mutex> lock(sessions_lock);
+    auto it = sessions.find(ctx);
+
+    if (it != sessions.end()) {
+        RvpuSession *session = it->second;
+        if (session) {
+            stop_worker(session);
+            release_packets(session);
+            rvpu_stream_deinit(&session->stream);
+            delete session;
+        }
+        sessions.erase(it);
+    }
+}
+
+static void stream_init(RvpuSession *session, void *cfg, size_t len)
+{
+    MppCtx ctx = session->ctx;
     MPP_RET ret;
-    (void)cfg;
     MppCodingType type = MPP_VIDEO_CodingAVC;   // H.264/AVC
     MppCtxType ctxtype = MPP_CTX_ENC;
+    MppPollType timeout;
+    RvpuInitCfg init;
+
+    {
+        std::lock_guard<std::mutex> lock(session->lock);
+        release_packets(session);
+        session->depth = 1;
+    }
+
+    // optional coding type, H.264/AVC by default
+    if (len == sizeof(init)) {
+        memcpy(&init, cfg, sizeof(init));
+        type = (MppCodingType)init.coding;
+        if (init.depth > 1)
+            session->depth = MPP_MIN(init.depth, RVPU_MAX_INFLIGHT);
+    } else if (len == sizeof(RK_S32)) {
+        memcpy(&type, cfg, sizeof(RK_S32));
+    }
 
     if (MPP_OK != (ret = mpp_init(ctx, ctxtype, type))) {
         mpp_err("mpp_init failed ret %d\n", ret);
         return;
     }
 
+    // let WAIT block on the output port instead of polling for packet
+    timeout = (MppPollType)RVPU_WAIT_TIMEOUT;
+    if (MPP_OK != (ret = session->api->control(ctx, MPP_SET_OUTPUT_TIMEOUT, &timeout))) {
+        mpp_err("set output timeout failed ret %d\n", ret);
+    }
+
     mpp_log("mpp_init succuss.");
 }
 
-static void stream_control_dec(MppCtx ctx, RVPU_PRIM_CODE prim, void *cfg)
+static void stream_control_dec(RvpuSession *session, RVPU_PRIM_CODE prim, void *cfg)
 {
-    (void)ctx;
+    (void)session;
     (void)prim;
     (void)cfg;
     // TODO
 }
 
-static void stream_control_enc(MppCtx ctx, RVPU_PRIM_CODE prim, void *cfg)
+static void stream_control_enc(RvpuSession *session, RVPU_PRIM_CODE prim, void *cfg)
 {
+    MppCtx ctx = session->ctx;
+    MppApi *api = session->api;
+
     switch (prim) {
     case RVPU_PRIM_CONTROL_PREP: {
         MppEncPrepCfg *prep = (MppEncPrepCfg *)(cfg);
         mpp_log("preferences %dx%d format %d", prep->width, prep->height, prep->format);
-        if (on_ctrl_prep_cb) {
+        if (session->on_ctrl_prep) {
             // m_width  = prep->width;
             // m_height = prep->height;
             // m_format = prep->format;
             // m_hor_stride = prep->hor_stride;
             // m_ver_stride = prep->ver_stride;
-            on_ctrl_prep_cb(prep, sizeof(*prep));
+            session->on_ctrl_prep(prep, sizeof(*prep));
         }
-        (void)mpp_api->control(ctx, MPP_ENC_SET_PREP_CFG, prep);
+        (void)api->control(ctx, MPP_ENC_SET_PREP_CFG, prep);
         break;
     }
     case RVPU_PRIM_CONTROL_RC: {
         MppEncRcCfg *prc = (MppEncRcCfg *)(cfg);
-        mpp_log("rc_mode %s, fps in/out %d/%d", 
-             (prc->rc_mode == MPP_ENC_RC_MODE_VBR) ? "VBR" : "CBR", 
-             prc->fps_in_num, prc->fps_out_num);
-        (void)mpp_api->control(ctx, MPP_ENC_SET_RC_CFG, prc);
+        mpp_log("rc_mode %s, fps in/out %d/%d",
+                (prc->rc_mode == MPP_ENC_RC_MODE_VBR) ? "VBR" : "CBR",
+                prc->fps_in_num, prc->fps_out_num);
+        (void)api->control(ctx, MPP_ENC_SET_RC_CFG, prc);
         break;
     }
     case RVPU_PRIM_CONTROL_CODEC: {
-      #if 0
+#if 0
         MppEncH264Cfg *pcfg = (MppEncH264Cfg *)(cfg);
-        mpp_log("H264 profile %d level %d, qp(init %d max %d min %d)", 
-             pcfg->profile, pcfg->level, 
-             pcfg->qp_init, pcfg->qp_max, pcfg->qp_min);
-      #endif
-        (void)mpp_api->control(ctx, MPP_ENC_SET_CODEC_CFG, cfg);
+        mpp_log("H264 profile %d level %d, qp(init %d max %d min %d)",
+                pcfg->profile, pcfg->level,
+                pcfg->qp_init, pcfg->qp_max, pcfg->qp_min);
+#endif
+        (void)api->control(ctx, MPP_ENC_SET_CODEC_CFG, cfg);
         break;
     }
     case RVPU_PRIM_CONTROL_SEI: {
         MppEncSeiMode *sei = (MppEncSeiMode *)(cfg);
         mpp_log("Sei mode %d", *sei);
-        (void)mpp_api->control(ctx, MPP_ENC_SET_SEI_CFG, sei);
+        (void)api->control(ctx, MPP_ENC_SET_SEI_CFG, sei);
         break;
     }
     default:
@@ -118,17 +273,35 @@ static void stream_control_enc(MppCtx ctx, RVPU_PRIM_CODE prim, void *cfg)
     } // (prim)
 }
 
-static void stream_control(MppCtx ctx, RVPU_PRIM_CODE prim, void *cfg)
+static void stream_control(RvpuSession *session, RVPU_PRIM_CODE prim, void *cfg)
+{
+    stream_control_enc(session, prim, cfg);
+    // TODO:
+    //stream_control_dec(session, prim. cfg);
+}
+
+/*
+ * Peer drops its frames in flight, so do their waits. The output buffers
+ * of peer may be gone once this returns.
+ */
+static void drop_waits(RvpuSession *session)
 {
-    stream_control_enc(ctx, prim, cfg);
-    // TODO: 
-    //stream_control_dec(ctx, prim. cfg);
+    std::unique_lock<std::mutex> lock(session->lock);
+
+    session->waits.clear();
+    session->gen++;
+    session->pending = 0;
+    while (session->busy)
+        session->cond.wait(lock);
+    release_packets(session);
 }
 
-static void stream_reset(MppCtx ctx)
+static void stream_reset(RvpuSession *session)
 {
     MPP_RET ret;
-    if (MPP_OK != (ret = mpp_api->reset(ctx))) {
+
+    drop_waits(session);
+    if (MPP_OK != (ret = session->api->reset(session->ctx))) {
         mpp_err("mpp reset: %d", ret);
     }
 }
@@ -139,13 +312,12 @@ static void stream_flush(MppCtx ctx)
     // NOTHING
 }
 
-static void stream_end(MppCtx ctx)
+static void stream_end(RvpuSession *session)
 {
-    (void)ctx;
-    // NOTHING
+    drop_waits(session);
 }
 
-static void encode_packet(MppCtx ctx, void *data, size_t size)
+static void encode_packet(RvpuSession *session, void *data, size_t size)
 {
     MPP_RET   ret;
     MppBuffer frmbuf;
@@ -159,7 +331,7 @@ static void encode_packet(MppCtx ctx, void *data, size_t size)
     }
 
     if (MPP_OK != (ret = mpp_buffer_import(&frmbuf, info))) {
-        mpp_err("mpp_buffer_import (type:%d size:%06X fd:%d hnd:%p ptr:%p) failed: %d", 
+        mpp_err("mpp_buffer_import (type:%d size:%06X fd:%d hnd:%p ptr:%p) failed: %d",
                 info->type, info->size, info->fd, info->hnd, info->ptr, ret);
         return;
     }
@@ -183,71 +355,175 @@ static void encode_packet(MppCtx ctx, void *data, size_t size)
     mpp_frame_set_buffer(frame, frmbuf);
     mpp_frame_set_eos(frame, (frmbuf == nullptr) ? 1 : 0);
 
-    if (MPP_OK != (ret = mpp_api->encode_put_frame(ctx, frame))) {
+    if (MPP_OK != (ret = session->api->encode_put_frame(session->ctx, frame))) {
         mpp_err("mpp encode_put_frame: %d", ret);
+    } else {
+        std::lock_guard<std::mutex> lock(session->lock);
+        session->pending++;
     }
     
     // mpp_frame_deinit(&frame);
     mpp_buffer_put(frmbuf);
 }
 
-static void wait_packet(MppCtx ctx, void *data, size_t size)
+static void complete_wait(RvpuSession *session, const RvpuWaitReq *req,
+                          RvpuWaitResult *result)
 {
-    MPP_RET   ret;
-    MppBufferInfo *info = static_cast<MppBufferInfo *>(data);
-    MppPacket packet = nullptr;
+    char hdr[RVPU_MAX_HDR_SIZE + sizeof(*result)];
+    size_t len;
 
-    if (size != sizeof(*info)) {
-        mpp_err("Mismatched type size %d", size);
+    // legacy peer polls the ready-flag in its output buffer instead
+    if (session->fd <= 0 || req->proto < RVPU_PROTO_V1)
         return;
-    }
 
-    int n = 0;
-    do {
-        if (MPP_OK != (ret = mpp_api->encode_get_packet(ctx, &packet))) {
-            mpp_err("mpp encode_get_packet: %d", ret);
-            return;
-        }
+    len = rvpu_pack_header(req->proto, req->seq, RVPU_PRIM_WAIT, sizeof(*result), hdr);
+    memcpy(hdr + len, result, sizeof(*result));
+    if (send(session->fd, hdr, len + sizeof(*result), MSG_NOSIGNAL) < 0) {
+        mpp_err("send completion with error: %s", strerror(errno));
+    }
+}
 
-        if (nullptr == packet) {
-            mpp_err("encode_get_packet timeout %d", ++n);
-            std::this_thread::sleep_for(std::chrono::milliseconds(1)); // usleep(1000);
-        }
-    } while (nullptr == packet && n < MAX_MPP_TRIES);
+/*
+ * Hand the packet to peer, called with session lock held
+ */
+static void finish_wait(RvpuSession *session, const RvpuWaitReq *req, MppPacket packet)
+{
+    RvpuWaitResult result;
 
+    memset(&result, 0, sizeof(result));
     if (nullptr != packet) {
         size_t pkt_len = mpp_packet_get_length(packet);
+        MppBuffer pktbuf = mpp_packet_get_buffer(packet);
+
         // send to peer via socket in callback
-        if (on_packet_cb) {
+        if (session->on_packet) {
             void  *pkt_ptr = mpp_packet_get_pos(packet);
-            on_packet_cb(pkt_ptr, pkt_len);
+            session->on_packet(pkt_ptr, pkt_len);
+        }
+
+        result.length = pkt_len;
+        if (pktbuf) {
+            mpp_buffer_info_get(pktbuf, &result.info);
+            result.info.fd  = 0;    // requires ion_map from binfo.hdl
+            result.info.ptr = NULL; // required ion_import
         }
 
       #ifndef SEND_SOCKET
         // send to remote via ion session
         MppBuffer outbuf;
-        MppBuffer pktbuf = mpp_packet_get_buffer(packet);
-        if (pktbuf && MPP_OK == (ret = mpp_buffer_import(&outbuf, info))) {
-            MppBufferInfo binfo;
-            mpp_buffer_info_get(pktbuf, &binfo);
-            if (binfo.type == MPP_BUFFER_TYPE_ION) {
+        MPP_RET ret;
+        if (req->has_info && pktbuf &&
+            MPP_OK == (ret = mpp_buffer_import(&outbuf, (MppBufferInfo *)&req->info))) {
+            if (req->proto >= RVPU_PROTO_V1) {
+                // peer imports an ion packet, other packets are copied to it
+                if (result.info.type != MPP_BUFFER_TYPE_ION ||
+                    !mpp_rt_allcator_is_valid(MPP_BUFFER_TYPE_ION)) {
+                    if (pkt_len <= mpp_buffer_get_size(outbuf)) {
+                        memcpy(mpp_buffer_get_ptr(outbuf), mpp_packet_get_pos(packet), pkt_len);
+                    } else {
+                        mpp_err("packet size %u over output buffer %u", (RK_U32)pkt_len,
+                                (RK_U32)mpp_buffer_get_size(outbuf));
+                        result.length = 0;
+                    }
+                    memset(&result.info, 0, sizeof(result.info));
+                }
+            } else if (result.info.type == MPP_BUFFER_TYPE_ION) {
                 uint32_t *ptag  = (uint32_t *)mpp_buffer_get_ptr(outbuf);
-                binfo.fd  = 0;      // requires ion_map from binfo.hdl
-                binfo.ptr = NULL;   // required ion_import
-                memcpy(ptag + 1, &binfo, sizeof(binfo));
+                memcpy(ptag + 1, &result.info, sizeof(result.info));
                 // mpp_buffer_inc_ref(pktbuf);
-                // mpp_log("size %X (%X) => %X", *ptag, info->size, pkt_len);
+                // mpp_log("size %X (%X) => %X", *ptag, req->info.size, pkt_len);
                 *ptag = pkt_len;   // ready-flag
             } else {
-                // mpp_err("packet buffer type is %d", binfo.type);
+                // mpp_err("packet buffer type is %d", result.info.type);
             }
             mpp_buffer_put(outbuf);
         }
-      #endif /* !SEND_SOCKET */
+#endif /* !SEND_SOCKET */
+
+        // release packet after peer has got it
+        hold_packet(session, packet);
+    }
+
+    complete_wait(session, req, &result);
+}
+
+/*
+ * Completion thread of session, gets the packets in the order of the waits
+ */
+static void wait_worker(RvpuSession *session)
+{
+    std::unique_lock<std::mutex> lock(session->lock);
+
+    while (!session->quit) {
+        MppPacket packet = nullptr;
+        RvpuWaitReq req;
+        RK_U32 gen;
+        RK_U32 retry;
+        MPP_RET ret = MPP_OK;
+
+        if (session->waits.empty()) {
+            session->cond.wait(lock);
+            continue;
+        }
+
+        req = session->waits.front();
+        gen = session->gen;
+        session->busy = true;
+
+        // frames queued before the oldest one may take a timeout each
+        for (retry = 0; session->pending && retry <= RVPU_MAX_INFLIGHT; retry++) {
+            lock.unlock();
+            // blocks on output port up to RVPU_WAIT_TIMEOUT, see stream_init
+            ret = session->api->encode_get_packet(session->ctx, &packet);
+            lock.lock();
+            if (MPP_OK != ret || nullptr != packet || session->quit || gen != session->gen)
+                break;
+        }
+
+        session->busy = false;
+        session->cond.notify_all();
+
+        // reset or closed while getting, the packet belongs to no wait
+        if (session->quit || gen != session->gen) {
+            if (packet)
+                mpp_packet_deinit(&packet);
+            continue;
+        }
+
+        if (MPP_OK != ret) {
+            mpp_err("mpp encode_get_packet: %d", ret);
+        } else if (nullptr == packet && session->pending) {
+            mpp_err("encode_get_packet timeout");
+        }
+
+        // the frame is given up without its packet as well
+        if (session->pending)
+            session->pending--;
+        session->waits.pop_front();
+        finish_wait(session, &req, packet);
+    }
+}
 
-        // release packet
-        mpp_packet_deinit(&packet);
+static void wait_packet(RvpuSession *session, const RvpuMsg *msg)
+{
+    RvpuWaitReq req;
+
+    memset(&req, 0, sizeof(req));
+    req.seq   = msg->seq;
+    req.proto = session->proto;
+    if (msg->length == sizeof(req.info)) {
+        memcpy(&req.info, msg->data, sizeof(req.info));
+        req.has_info = 1;
+    } else if (msg->length) {
+        mpp_err("Mismatched type size %d", msg->length);
     }
+
+    std::lock_guard<std::mutex> lock(session->lock);
+    if (!session->worker.joinable())
+        session->worker = std::thread(wait_worker, session);
+
+    session->waits.push_back(req);
+    session->cond.notify_all();
 }
 
 static int valid_cfg_size(MppCtx ctx, size_t len)
@@ -257,13 +533,17 @@ static int valid_cfg_size(MppCtx ctx, size_t len)
     return len;
 }
 
-int rvpu_target_init(void *self, MppCtx ctx)
+int rvpu_target_init(void *owner, MppCtx ctx)
 {
-    MpiImpl *p = (MpiImpl*)ctx;
+    RvpuSession *session;
 
-    if (mpp_api == nullptr) {
-         mpp_api = p->api;
+    if (NULL == ctx || NULL == (session = get_session(ctx))) {
+        return MPP_NOK;
     }
+    session->owner = owner;
+
+    // sessions served here must not be sent to a remote again
+    rvpu_backend_disable(RVPU_CAP_REMOTE);
 
     mpp_log("Assigned context %p", ctx);
 
@@ -271,121 +551,378 @@ int rvpu_target_init(void *self, MppCtx ctx)
 }
 
 void set_rvpu_callback(MppCtx ctx,
-    rvpu_callback_t on_ctrl_prep, 
-    rvpu_callback_t on_packet,
-    rvpu_callback_t on_flush)
+                       rvpu_callback_t on_ctrl_prep,
+                       rvpu_callback_t on_packet,
+                       rvpu_callback_t on_flush)
 {
-    (void)ctx;
-    on_ctrl_prep_cb = on_ctrl_prep;
-    on_packet_cb    = on_packet;
-    on_flush_cb     = on_flush;
+    RvpuSession *session;
+
+    // without ctx set the callbacks of sessions created later
+    if (NULL == ctx) {
+        def_ctrl_prep_cb = on_ctrl_prep;
+        def_packet_cb    = on_packet;
+        def_flush_cb     = on_flush;
+    } else if (NULL != (session = get_session(ctx))) {
+        session->on_ctrl_prep = on_ctrl_prep;
+        session->on_packet    = on_packet;
+        session->on_flush     = on_flush;
+    }
+}
+
+static void stream_hello(RvpuSession *session, const RvpuMsg *msg)
+{
+    RK_U32 version = msg->version;
+    char hdr[RVPU_MAX_HDR_SIZE];
+    size_t len;
+
+    // the probe comes in ascii framing, the peer version is in its payload
+    if (msg->length >= sizeof(version))
+        memcpy(&version, msg->data, sizeof(version));
+    mpp_log("peer protocol version %d", version);
+
+    session->proto = MPP_MIN(version, (RK_U32)RVPU_PROTO_VERSION);
+    version = RVPU_PROTO_VERSION;
+
+    if (session->fd <= 0)
+        return;
+
+    // reply in binary, the peer falls back to ascii without it
+    len = rvpu_pack_header(RVPU_PROTO_V1, msg->seq, RVPU_PRIM_HELLO, sizeof(version), hdr);
+    memcpy(hdr + len, &version, sizeof(version));
+    std::lock_guard<std::mutex> lock(session->lock);
+    if (send(session->fd, hdr, len + sizeof(version), MSG_NOSIGNAL) < 0) {
+        mpp_err("send hello with error: %s", strerror(errno));
+    }
+}
+
+static void dispatch_message(RvpuSession *session, const RvpuMsg *msg)
+{
+    RVPU_PRIM_CODE prim = msg->prim;
+    size_t len = msg->length;
+    uint8_t *pch = (uint8_t *)msg->data;
+
+    switch (prim) {
+    case RVPU_PRIM_HELLO:
+        stream_hello(session, msg);
+        break;
+
+    case RVPU_PRIM_INIT:
+        stream_init(session, pch, len);
+        break;
+
+    case RVPU_PRIM_DEINIT:
+        stream_end(session);
+        break;
+
+    case RVPU_PRIM_REGS:
+        break;
+
+    case RVPU_PRIM_START:
+        encode_packet(session, pch, len);
+        break;
+
+    case RVPU_PRIM_WAIT:
+        wait_packet(session, msg);
+        break;
+
+    case RVPU_PRIM_CONTROL_PREP:
+        if (len != sizeof(MppEncPrepCfg)) {
+            mpp_log("Invalid primitive %d: invalid param size %d", prim, len);
+        } else {
+            stream_control(session, RVPU_PRIM_CONTROL_PREP, pch);
+        }
+        break;
+
+    case RVPU_PRIM_CONTROL_RC:
+        if (len != sizeof(MppEncRcCfg)) {
+            mpp_log("Invalid primitive %d: invalid param size %d", prim, len);
+        } else {
+            stream_control(session, RVPU_PRIM_CONTROL_RC, pch);
+        }
+        break;
+
+    case RVPU_PRIM_CONTROL_CODEC:
+        if (!valid_cfg_size(session->ctx, len)) {
+            mpp_log("Invalid primitive %d: invalid param size %d", prim, len);
+        } else {
+            stream_control(session, RVPU_PRIM_CONTROL_CODEC, pch);
+        }
+        break;
+
+    case RVPU_PRIM_CONTROL_SEI:
+        if (len != sizeof(MppEncSeiMode)) {
+            mpp_log("Invalid primitive %d: invalid param size %d", prim, len);
+        } else {
+            stream_control(session, RVPU_PRIM_CONTROL_SEI, pch);
+        }
+        break;
+
+    case RVPU_PRIM_CONTROL:
+        // TODO
+        break;
+
+    case RVPU_PRIM_RESET:
+        stream_reset(session);
+        break;
+
+    case RVPU_PRIM_FLUSH:
+        stream_flush(session->ctx);
+        break;
+
+    default:
+        mpp_log("Unknown primitive '%d' len %d", prim, len);
+        break;
+    }
+}
+
+static int process_session(RvpuSession *session)
+{
+    RvpuMsg msg;
+    RK_S32 ret;
+
+    while ((ret = rvpu_stream_next(&session->stream, &msg)) > 0) {
+        // reply in the framing of the request, peer may have fallen back
+        session->proto = msg.version;
+        dispatch_message(session, &msg);
+    }
+
+    if (ret < 0) {
+        mpp_err("corrupted stream, buffered data dropped");
+        return MPP_NOK;
+    }
+
+    return MPP_OK;
+}
+
+/*
+ * Drain socket of session, partial messages are kept in session stream
+ */
+static int recv_session(RvpuSession *session)
+{
+    uint8_t buf[4096];
+    ssize_t ret;
+
+    for (;;) {
+        ret = recv(session->fd, buf, sizeof(buf), MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (ret > 0) {
+            if (rvpu_stream_feed(&session->stream, buf, ret))
+                return MPP_NOK;
+            if (process_session(session))
+                return MPP_NOK;
+            continue;
+        }
+
+        if (ret == 0) {
+            // peer closed
+            session->closed = 1;
+            return MPP_NOK;
+        }
+
+        if (errno == EINTR)
+            continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+            break;
+
+        mpp_err("recv with error: %s", strerror(errno));
+        return MPP_NOK;
+    }
+
+    return MPP_OK;
 }
 
 int process_rvpu(int fd, MppCtx ctx)
 {
-    uint8_t buf[MAX_CONTEXT_SIZE];
-    ssize_t ret = recv(fd, buf, sizeof(buf), MSG_NOSIGNAL);
+    RvpuSession *session;
+    int ret;
 
-    if (ret >= 0)
-        return process_rvpu_message(buf, ret, ctx);
-    return MPP_NOK;
+    if (NULL == ctx || NULL == (session = get_session(ctx))) {
+        return MPP_NOK;
+    }
+    session->fd = fd;
+
+    ret = recv_session(session);
+    if (session->closed) {
+        put_session(ctx);
+    }
+
+    return ret;
 }
 
 int process_rvpu_message(const uint8_t *data, size_t size, MppCtx ctx)
 {
-    const uint8_t *pch  = data;
-    const uint8_t *pend = data + size;
+    RvpuSession *session;
 
     // mpp_log("process_data %d bytes: %s", size, data);
 
-    if (NULL == ctx) {
+    if (NULL == ctx || NULL == (session = get_session(ctx))) {
         return -1;
     }
 
-    // if (size == 0) {
-    //  stream_reset(ctx);
-    //}
+    if (size > 0 && rvpu_stream_feed(&session->stream, data, size)) {
+        return MPP_NOK;
+    }
 
-    while (pch < pend) {
-        RVPU_PRIM_CODE prim;
-        size_t len;
-        pch += parse_header(pch, pend, &prim, &len);
+    return process_session(session);
+}
 
-        switch (prim) {
-        case RVPU_PRIM_INIT:
-            stream_init(ctx, (uint8_t *)(pch));
-            break;
- 
-        case RVPU_PRIM_DEINIT:
-            stream_end(ctx);
-            break;
+/**
+ * Sessions multiplexed on one epoll set, served by a pool of threads.
+ * EPOLLONESHOT keeps each session on one thread at a time, so messages of a
+ * session are still handled in order.
+ */
+typedef struct RvpuDispatcherImpl_t {
+    int                         epfd;
+    int                         evfd;       /**< wakes all threads on deinit */
+    rvpu_close_t                on_close;
+    std::mutex                  lock;
+    std::set<RvpuSession *>     sessions;
+    std::vector<std::thread>    threads;
+} RvpuDispatcherImpl;
+
+static void dispatcher_drop(RvpuDispatcherImpl *disp, RvpuSession *session)
+{
+    MppCtx ctx  = session->ctx;
+    void *owner = session->owner;
+    int fd      = session->fd;
 
-        case RVPU_PRIM_REGS:
-            break;
+    {
+        std::lock_guard<std::mutex> lock(disp->lock);
+        disp->sessions.erase(session);
+    }
 
-        case RVPU_PRIM_START:
-            encode_packet(ctx, (uint8_t *)(pch), len);
-            break;
+    epoll_ctl(disp->epfd, EPOLL_CTL_DEL, fd, NULL);
+    put_session(ctx);
 
-        case RVPU_PRIM_WAIT:
-            wait_packet(ctx, (uint8_t *)(pch), len);
-            break;
+    // owner releases fd and ctx
+    if (disp->on_close) {
+        disp->on_close(owner, ctx, fd);
+    } else {
+        close(fd);
+    }
+}
 
-        case RVPU_PRIM_CONTROL_PREP:
-            if (len != sizeof(MppEncPrepCfg)) {
-                mpp_log("Invalid primitive %d: invalid param size %d", prim, len);
-            } else {
-                stream_control(ctx, RVPU_PRIM_CONTROL_PREP, (uint8_t *)(pch));
-            }
+static void dispatcher_loop(RvpuDispatcherImpl *disp)
+{
+    for (;;) {
+        struct epoll_event ev;
+        RvpuSession *session;
+        int n = epoll_wait(disp->epfd, &ev, 1, -1);
+
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0 || NULL == ev.data.ptr)
             break;
 
-        case RVPU_PRIM_CONTROL_RC:
-            if (len != sizeof(MppEncRcCfg)) {
-                mpp_log("Invalid primitive %d: invalid param size %d", prim, len);
-            } else {
-                stream_control(ctx, RVPU_PRIM_CONTROL_RC, (uint8_t *)(pch));
-            }
-            break;
+        session = (RvpuSession *)ev.data.ptr;
+        if (MPP_OK == recv_session(session) && !(ev.events & EPOLLERR)) {
+            ev.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+            if (!epoll_ctl(disp->epfd, EPOLL_CTL_MOD, session->fd, &ev))
+                continue;
+        }
 
-        case RVPU_PRIM_CONTROL_CODEC:
-            if (!valid_cfg_size(ctx, len)) {
-                mpp_log("Invalid primitive %d: invalid param size %d", prim, len);
-            } else {
-                stream_control(ctx, RVPU_PRIM_CONTROL_CODEC, (uint8_t *)(pch));
-            }
-            break;
+        dispatcher_drop(disp, session);
+    }
+}
 
-        case RVPU_PRIM_CONTROL_SEI:
-            if (len != sizeof(MppEncSeiMode)) {
-                mpp_log("Invalid primitive %d: invalid param size %d", prim, len);
-            } else {
-                stream_control(ctx, RVPU_PRIM_CONTROL_SEI, (uint8_t *)(pch));
-            }
-            break;
+int rvpu_dispatcher_init(RvpuDispatcher *dispatcher, int threads, rvpu_close_t on_close)
+{
+    RvpuDispatcherImpl *disp;
+    struct epoll_event ev;
+    int i;
+
+    if (NULL == dispatcher)
+        return MPP_ERR_NULL_PTR;
+
+    *dispatcher = NULL;
+    if (threads <= 0)
+        threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (threads <= 0)
+        threads = 1;
+
+    disp = new RvpuDispatcherImpl();
+    disp->on_close = on_close;
+    disp->epfd = epoll_create1(EPOLL_CLOEXEC);
+    disp->evfd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (disp->epfd < 0 || disp->evfd < 0) {
+        mpp_err("create dispatcher with error: %s", strerror(errno));
+        goto FAILED;
+    }
 
-        case RVPU_PRIM_CONTROL:
-            // TODO
-            break;
+    // level triggered, every thread sees it once signaled
+    ev.events   = EPOLLIN;
+    ev.data.ptr = NULL;
+    if (epoll_ctl(disp->epfd, EPOLL_CTL_ADD, disp->evfd, &ev) < 0) {
+        mpp_err("add eventfd with error: %s", strerror(errno));
+        goto FAILED;
+    }
 
-        case RVPU_PRIM_RESET:
-            stream_reset(ctx);
-            break;
+    for (i = 0; i < threads; i++) {
+        disp->threads.push_back(std::thread(dispatcher_loop, disp));
+    }
 
-        case RVPU_PRIM_FLUSH:
-            stream_flush(ctx);
-            break;
+    mpp_log("dispatcher %p with %d threads", disp, threads);
+    *dispatcher = disp;
+    return MPP_OK;
 
-        default:
-            mpp_log("Unknown primitive '%d' len %d: %s", prim, len, data);
-            break;
-        }
-        
-        pch += len;
-    } // while (pch < pend)
+FAILED:
+    if (disp->epfd >= 0)
+        close(disp->epfd);
+    if (disp->evfd >= 0)
+        close(disp->evfd);
+    delete disp;
+    return MPP_NOK;
+}
+
+int rvpu_dispatcher_add(RvpuDispatcher dispatcher, int fd, MppCtx ctx)
+{
+    RvpuDispatcherImpl *disp = (RvpuDispatcherImpl *)dispatcher;
+    RvpuSession *session;
+    struct epoll_event ev;
+
+    if (NULL == disp || fd < 0 || NULL == ctx || NULL == (session = get_session(ctx))) {
+        return MPP_ERR_NULL_PTR;
+    }
+    session->fd = fd;
+
+    {
+        std::lock_guard<std::mutex> lock(disp->lock);
+        disp->sessions.insert(session);
+    }
 
-    if (pch > pend) {
-        mpp_log("Recv bytes %d, parsed %d", size, pend - pch);
+    ev.events   = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+    ev.data.ptr = session;
+    if (epoll_ctl(disp->epfd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+        mpp_err("add fd %d with error: %s", fd, strerror(errno));
+        std::lock_guard<std::mutex> lock(disp->lock);
+        disp->sessions.erase(session);
+        return MPP_NOK;
     }
 
-    return (int)MPP_OK;
-}
\ No newline at end of file
+    return MPP_OK;
+}
+
+void rvpu_dispatcher_deinit(RvpuDispatcher dispatcher)
+{
+    RvpuDispatcherImpl *disp = (RvpuDispatcherImpl *)dispatcher;
+    uint64_t quit = 1;
+
+    if (NULL == disp)
+        return;
+
+    if (write(disp->evfd, &quit, sizeof(quit)) != sizeof(quit)) {
+        mpp_err("wake dispatcher with error: %s", strerror(errno));
+    }
+
+    for (auto & thd : disp->threads) {
+        thd.join();
+    }
+
+    // sessions whose peer is still connected
+    while (!disp->sessions.empty()) {
+        dispatcher_drop(disp, *disp->sessions.begin());
+    }
+
+    close(disp->epfd);
+    close(disp->evfd);
+    delete disp;
+}
@@ -0,0 +1,222 @@
+/*
+ * Copyright 2015 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_TAG "mpp_input_test"
+
+#include <poll.h>
+#include <string.h>
+
+#include "rk_mpi.h"
+
+#include "mpp_log.h"
+#include "mpp_time.h"
+#include "mpp_common.h"
+
+#include "mpi_impl.h"
+#include "mpp_dec_impl.h"
+
+#define TEST_DEPTH          (3)
+#define TEST_PUT_TIMEOUT    (1000)      // ms of the blocked put_packet
+
+typedef struct MppInputTest_t {
+    MppCtx          ctx;
+    MppApi          *mpi;
+    MppPacket       pkt[TEST_DEPTH + 2];
+    RK_U8           data[TEST_DEPTH + 2][16];
+    MPP_RET         put_ret;
+    RK_S64          put_time;
+} MppInputTest;
+
+static RK_S32 fd_ready(RK_S32 fd, RK_S32 timeout)
+{
+    struct pollfd pfd;
+
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+
+    return poll(&pfd, 1, timeout) == 1 && (pfd.revents & POLLIN);
+}
+
+static void *put_thread(void *arg)
+{
+    MppInputTest *p = (MppInputTest *)arg;
+    RK_S64 start = mpp_time();
+
+    mpp_packet_set_length(p->pkt[TEST_DEPTH], sizeof(p->data[0]));
+    p->put_ret = p->mpi->decode_put_packet(p->ctx, p->pkt[TEST_DEPTH]);
+    p->put_time = (mpp_time() - start) / 1000;
+    return NULL;
+}
+
+static void *reset_thread(void *arg)
+{
+    MppInputTest *p = (MppInputTest *)arg;
+
+    p->mpi->reset(p->ctx);
+    return NULL;
+}
+
+/* any working decoder does, the packets are never parsed */
+static MppCodingType test_coding(void)
+{
+    static const MppCodingType codings[] = {
+        MPP_VIDEO_CodingAVC,
+        MPP_VIDEO_CodingHEVC,
+        MPP_VIDEO_CodingMPEG2,
+        MPP_VIDEO_CodingVP8,
+        MPP_VIDEO_CodingVP9,
+    };
+    RK_U32 i;
+
+    for (i = 0; i < MPP_ARRAY_ELEMS(codings); i++) {
+        if (!mpp_check_support_format(MPP_CTX_DEC, codings[i]))
+            return codings[i];
+    }
+
+    return MPP_VIDEO_CodingUnused;
+}
+
+int main()
+{
+    MppInputTest test;
+    MppInputTest *p = &test;
+    MppCodingType coding = test_coding();
+    MppDecImpl *dec = NULL;
+    MppThread *parser = NULL;
+    pthread_t put_thd;
+    pthread_t reset_thd;
+    RK_U32 depth = TEST_DEPTH;
+    MppPollType timeout;
+    RK_S32 in_fd = -1;
+    RK_S32 out_fd = -1;
+    RK_S32 sent = 0;
+    RK_S32 started = 0;
+    MPP_RET ret;
+    RK_U32 i;
+
+    mpp_log("mpp_input test start\n");
+
+    memset(p, 0, sizeof(*p));
+    for (i = 0; i < MPP_ARRAY_ELEMS(p->pkt); i++) {
+        memset(p->data[i], 0xff, sizeof(p->data[i]));
+        mpp_packet_init(&p->pkt[i], p->data[i], sizeof(p->data[i]));
+    }
+
+    if (coding == MPP_VIDEO_CodingUnused) {
+        mpp_log("no decoder built in, skip\n");
+        goto TEST_SUCCESS;
+    }
+
+    ret = mpp_create(&p->ctx, &p->mpi);
+    if (ret)
+        goto TEST_FAILED;
+
+    ret = p->mpi->control(p->ctx, MPP_SET_INPUT_DEPTH, &depth);
+    if (!ret)
+        ret = mpp_init(p->ctx, MPP_CTX_DEC, coding);
+    if (ret) {
+        mpp_err("decoder init failed ret %d\n", ret);
+        goto TEST_FAILED;
+    }
+
+    ret = p->mpi->control(p->ctx, MPP_GET_INPUT_EVENT_FD, &in_fd);
+    if (!ret)
+        ret = p->mpi->control(p->ctx, MPP_GET_OUTPUT_EVENT_FD, &out_fd);
+    if (ret || in_fd < 0 || out_fd < 0) {
+        mpp_err("get event fd failed ret %d\n", ret);
+        goto TEST_FAILED;
+    }
+
+    // empty queue has room and there is no frame
+    if (!fd_ready(in_fd, 0) || fd_ready(out_fd, 0)) {
+        mpp_err("event fd not ready on empty decoder\n");
+        goto TEST_FAILED;
+    }
+
+    // hold the parser thread so that the queue only drains on reset
+    msleep(20);
+    dec = (MppDecImpl *)((MpiImpl *)p->ctx)->ctx->mDec;
+    parser = dec->thread_parser;
+    parser->lock();
+
+    // non-block put_packets stops at the depth
+    ret = p->mpi->decode_put_packets(p->ctx, p->pkt, TEST_DEPTH + 1, &sent);
+    if (ret != MPP_ERR_BUFFER_FULL || sent != TEST_DEPTH) {
+        mpp_err("put %d packets at depth %d ret %d sent %d\n",
+                TEST_DEPTH + 1, TEST_DEPTH, ret, sent);
+        goto TEST_FAILED;
+    }
+
+    if (fd_ready(in_fd, 0)) {
+        mpp_err("input event fd ready on full queue\n");
+        goto TEST_FAILED;
+    }
+
+    // timed put waits for room, only reset can make it
+    timeout = (MppPollType)TEST_PUT_TIMEOUT;
+    p->mpi->control(p->ctx, MPP_SET_INPUT_TIMEOUT, &timeout);
+    p->put_ret = MPP_NOK;
+    pthread_create(&put_thd, NULL, put_thread, p);
+    started = 1;
+    msleep(50);
+
+    // reset flushes the queue and then waits for the parser
+    pthread_create(&reset_thd, NULL, reset_thread, p);
+    if (!fd_ready(in_fd, TEST_PUT_TIMEOUT / 2)) {
+        mpp_err("input event fd not ready after reset\n");
+        parser->unlock();
+        parser = NULL;
+        pthread_join(reset_thd, NULL);
+        goto TEST_FAILED;
+    }
+
+    parser->unlock();
+    parser = NULL;
+    pthread_join(reset_thd, NULL);
+    pthread_join(put_thd, NULL);
+    started = 0;
+
+    if (p->put_ret || p->put_time >= TEST_PUT_TIMEOUT) {
+        mpp_err("blocked put_packet not released by reset ret %d after %lld ms\n",
+                p->put_ret, p->put_time);
+        goto TEST_FAILED;
+    }
+
+    mpp_log("put released in %lld ms\n", p->put_time);
+    mpp_destroy(p->ctx);
+    p->ctx = NULL;
+
+TEST_SUCCESS:
+    for (i = 0; i < MPP_ARRAY_ELEMS(p->pkt); i++)
+        mpp_packet_deinit(&p->pkt[i]);
+
+    mpp_log("mpp_input test success\n");
+    return 0;
+
+TEST_FAILED:
+    if (parser)
+        parser->unlock();
+    if (started)
+        pthread_join(put_thd, NULL);
+    if (p->ctx)
+        mpp_destroy(p->ctx);
+    for (i = 0; i < MPP_ARRAY_ELEMS(p->pkt); i++)
+        mpp_packet_deinit(&p->pkt[i]);
+
+    mpp_log("mpp_input test failed\n");
+    return -1;
+}
@@ -0,0 +1,27 @@
+/*
+ * Copyright 2010 Rockchip Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __VERSION_H__
+#define __VERSION_H__
+
+#define	MPP_VERSION             "3a32e0620244c6d367d5b834d2fc525b1ff8006b"
+#define	MPP_AUTHOR              "agent"
+#define	MPP_DATE                "Sun Oct 18 07:00:48 2026 +0000"
+#define	MPP_ONE_LINE            "3a32e06 author: agent [user-014] fix: keep the MppApi size with decode_put_packets"
+#define	MPP_VER_NUM             "-1"
+
+#endif /*__VERSION_H__*/
+
@@ -0,0 +1,820 @@
+/*
+ * Copyright 2018 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_TAG "iep_sw"
+
+#include <string.h>
+#include <unistd.h>
+
+#include "mpp_env.h"
+#include "mpp_log.h"
+#include "mpp_mem.h"
+#include "mpp_time.h"
+#include "mpp_common.h"
+#include "mpp_thread.h"
+
+#include "iep_api.h"
+
+/*
+ * Rows are filtered on 16-bit lanes, V_W pixels per step. The sums of the
+ * motion adaptive filter need up to 10 bits.
+ */
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define V_W     16
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define V_W     8
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define V_W     8
+#endif
+
+#define IEP_SW_MAX_THREADS          (8)
+
+#define IEP_SW_DBG_FUNCTION         (0x00000001)
+#define IEP_SW_DBG_TIME             (0x00000002)
+
+#define iep_sw_dbg(flag, fmt, ...)  _mpp_dbg(iep_sw_debug, flag, fmt, ## __VA_ARGS__)
+#define iep_sw_dbg_f(flag, fmt, ...) _mpp_dbg_f(iep_sw_debug, flag, fmt, ## __VA_ARGS__)
+
+#define iep_sw_dbg_func(fmt, ...)   iep_sw_dbg_f(IEP_SW_DBG_FUNCTION, fmt, ## __VA_ARGS__)
+#define iep_sw_dbg_time(fmt, ...)   iep_sw_dbg(IEP_SW_DBG_TIME, fmt, ## __VA_ARGS__)
+
+RK_U32 iep_sw_debug = 0;
+
+typedef enum IepSwMode_e {
+    IEP_SW_MODE_BOB,                // average of the field lines around
+    IEP_SW_MODE_BLEND,              // vertical [1 2 1] low pass on the frame
+    IEP_SW_MODE_YADIF,              // motion adaptive, spatial only on I2O1
+    IEP_SW_MODE_BUTT,
+} IepSwMode;
+
+/*
+ * One output picture. The lines of the kept field are copied from cur and
+ * the other lines interpolated. prev and next hold the opposite field just
+ * before and after the kept one, ref the same parity field two fields away.
+ */
+typedef struct IepSwJob_t {
+    const RK_U8     *cur;
+    const RK_U8     *prev;
+    const RK_U8     *next;
+    const RK_U8     *ref;
+    RK_U8           *dst;
+    RK_S32          parity;         // 0 keep the top lines, 1 the bottom ones
+    RK_S32          temporal;
+} IepSwJob;
+
+typedef struct IepSwPlane_t {
+    RK_S32          offset;
+    RK_S32          width;          // in byte
+    RK_S32          height;
+    RK_S32          step;           // byte distance of horizontal neighbours
+} IepSwPlane;
+
+struct IepSwCtxImpl_t;
+
+typedef struct IepSwWorker_t {
+    struct IepSwCtxImpl_t *impl;
+    MppThread       *thd;
+    RK_S32          band;
+    RK_U32          pending;
+} IepSwWorker;
+
+typedef struct IepSwCtxImpl_t {
+    IepCmdParamImage    src;
+    IepCmdParamImage    dst;
+    IepCmdParamImage    src1;
+    IepCmdParamImage    dst1;
+    IepCmdParamDeiCfg   dei_cfg;
+    IepCap              cap;
+
+    RK_U32              mode;
+    RK_U32              simd;
+
+    IepSwJob            jobs[2];
+    RK_S32              job_cnt;
+    IepSwPlane          planes[2];
+    RK_S32              stride;
+
+    // band 0 runs on the caller, band i on workers[i - 1]
+    RK_S32              band_cnt;
+    IepSwWorker         workers[IEP_SW_MAX_THREADS - 1];
+    MppMutexCond        done;
+    RK_S32              busy;
+} IepSwCtxImpl;
+
+static void row_bob_c(RK_U8 *dst, const RK_U8 *c, const RK_U8 *e, RK_S32 x, RK_S32 w)
+{
+    for (; x < w; x++)
+        dst[x] = (c[x] + e[x] + 1) >> 1;
+}
+
+static void row_blend_c(RK_U8 *dst, const RK_U8 *a, const RK_U8 *b,
+                        const RK_U8 *c, RK_S32 x, RK_S32 w)
+{
+    for (; x < w; x++)
+        dst[x] = (a[x] + 2 * b[x] + c[x] + 2) >> 2;
+}
+
+/* edge directed average of the lines c and e, plain one on the borders */
+static inline RK_S32 spatial_pixel(const RK_U8 *c, const RK_U8 *e,
+                                   RK_S32 x, RK_S32 s, RK_S32 w)
+{
+    RK_S32 pred = (c[x] + e[x]) >> 1;
+    RK_S32 score, tmp;
+
+    if (x < 2 * s || x + 2 * s >= w)
+        return pred;
+
+    score = MPP_ABS(c[x - s] - e[x - s]) + MPP_ABS(c[x] - e[x]) +
+            MPP_ABS(c[x + s] - e[x + s]) - 1;
+
+    tmp = MPP_ABS(c[x - 2 * s] - e[x]) + MPP_ABS(c[x - s] - e[x + s]) +
+          MPP_ABS(c[x] - e[x + 2 * s]);
+    if (tmp < score) {
+        score = tmp;
+        pred = (c[x - s] + e[x + s]) >> 1;
+    }
+
+    tmp = MPP_ABS(c[x] - e[x - 2 * s]) + MPP_ABS(c[x + s] - e[x - s]) +
+          MPP_ABS(c[x + 2 * s] - e[x]);
+    if (tmp < score)
+        pred = (c[x + s] + e[x - s]) >> 1;
+
+    return pred;
+}
+
+static void row_ela_c(RK_U8 *dst, const RK_U8 *c, const RK_U8 *e,
+                      RK_S32 x, RK_S32 w, RK_S32 s)
+{
+    for (; x < w; x++)
+        dst[x] = spatial_pixel(c, e, x, s, w);
+}
+
+/*
+ * yadif: the temporal prediction of the opposite fields is kept unless the
+ * kept field moved, then the spatial one is used within the motion found.
+ * p, n are the missing line in prev and next, pu, nu, pd, nd two lines
+ * above and below it, ru, rd the lines c and e in ref.
+ */
+static void row_yadif_c(RK_U8 *dst, const RK_U8 *c, const RK_U8 *e,
+                        const RK_U8 *p, const RK_U8 *n,
+                        const RK_U8 *pu, const RK_U8 *nu,
+                        const RK_U8 *pd, const RK_U8 *nd,
+                        const RK_U8 *ru, const RK_U8 *rd,
+                        RK_S32 x, RK_S32 w, RK_S32 s)
+{
+    for (; x < w; x++) {
+        RK_S32 d = (p[x] + n[x]) >> 1;
+        RK_S32 td0 = MPP_ABS(p[x] - n[x]);
+        RK_S32 td1 = (MPP_ABS(ru[x] - c[x]) + MPP_ABS(rd[x] - e[x])) >> 1;
+        RK_S32 diff = MPP_MAX(td0 >> 1, td1);
+        RK_S32 pred = spatial_pixel(c, e, x, s, w);
+        RK_S32 b = (pu[x] + nu[x]) >> 1;
+        RK_S32 f = (pd[x] + nd[x]) >> 1;
+        RK_S32 mx = MPP_MAX(MPP_MAX(d - e[x], d - c[x]), MPP_MIN(b - c[x], f - e[x]));
+        RK_S32 mn = MPP_MIN(MPP_MIN(d - e[x], d - c[x]), MPP_MAX(b - c[x], f - e[x]));
+
+        diff = MPP_MAX(MPP_MAX(diff, mn), -mx);
+        dst[x] = MPP_CLIP3(d - diff, d + diff, pred);
+    }
+}
+
+#ifdef V_W
+#if defined(__AVX2__)
+typedef __m256i IepV;
+typedef __m256i IepM;
+
+static inline IepV v_load(const RK_U8 *p)
+{
+    return _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)p));
+}
+
+static inline void v_store(RK_U8 *p, IepV v)
+{
+    __m256i t = _mm256_permute4x64_epi64(_mm256_packus_epi16(v, v), 0xd8);
+
+    _mm_storeu_si128((__m128i *)p, _mm256_castsi256_si128(t));
+}
+
+#define v_set(a)        _mm256_set1_epi16(a)
+#define v_add(a, b)     _mm256_add_epi16(a, b)
+#define v_sub(a, b)     _mm256_sub_epi16(a, b)
+#define v_shr1(a)       _mm256_srai_epi16(a, 1)
+#define v_shr2(a)       _mm256_srai_epi16(a, 2)
+#define v_abs(a)        _mm256_abs_epi16(a)
+#define v_min(a, b)     _mm256_min_epi16(a, b)
+#define v_max(a, b)     _mm256_max_epi16(a, b)
+#define v_lt(a, b)      _mm256_cmpgt_epi16(b, a)
+#define v_sel(m, a, b)  _mm256_blendv_epi8(b, a, m)
+#elif defined(__SSE2__)
+typedef __m128i IepV;
+typedef __m128i IepM;
+
+static inline IepV v_load(const RK_U8 *p)
+{
+    return _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)p), _mm_setzero_si128());
+}
+
+static inline void v_store(RK_U8 *p, IepV v)
+{
+    _mm_storel_epi64((__m128i *)p, _mm_packus_epi16(v, v));
+}
+
+static inline IepV v_abs(IepV a)
+{
+    return _mm_max_epi16(a, _mm_sub_epi16(_mm_setzero_si128(), a));
+}
+
+static inline IepV v_sel(IepM m, IepV a, IepV b)
+{
+    return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b));
+}
+
+#define v_set(a)        _mm_set1_epi16(a)
+#define v_add(a, b)     _mm_add_epi16(a, b)
+#define v_sub(a, b)     _mm_sub_epi16(a, b)
+#define v_shr1(a)       _mm_srai_epi16(a, 1)
+#define v_shr2(a)       _mm_srai_epi16(a, 2)
+#define v_min(a, b)     _mm_min_epi16(a, b)
+#define v_max(a, b)     _mm_max_epi16(a, b)
+#define v_lt(a, b)      _mm_cmpgt_epi16(b, a)
+#else
+typedef int16x8_t IepV;
+typedef uint16x8_t IepM;
+
+static inline IepV v_load(const RK_U8 *p)
+{
+    return vreinterpretq_s16_u16(vmovl_u8(vld1_u8(p)));
+}
+
+static inline void v_store(RK_U8 *p, IepV v)
+{
+    vst1_u8(p, vqmovun_s16(v));
+}
+
+#define v_set(a)        vdupq_n_s16(a)
+#define v_add(a, b)     vaddq_s16(a, b)
+#define v_sub(a, b)     vsubq_s16(a, b)
+#define v_shr1(a)       vshrq_n_s16(a, 1)
+#define v_shr2(a)       vshrq_n_s16(a, 2)
+#define v_abs(a)        vabsq_s16(a)
+#define v_min(a, b)     vminq_s16(a, b)
+#define v_max(a, b)     vmaxq_s16(a, b)
+#define v_lt(a, b)      vcltq_s16(a, b)
+#define v_sel(m, a, b)  vbslq_s16(m, a, b)
+#endif
+
+static RK_S32 row_bob_simd(RK_U8 *dst, const RK_U8 *c, const RK_U8 *e, RK_S32 w)
+{
+    const IepV one = v_set(1);
+    RK_S32 x;
+
+    for (x = 0; x + V_W <= w; x += V_W)
+        v_store(dst + x, v_shr1(v_add(v_add(v_load(c + x), v_load(e + x)), one)));
+
+    return x;
+}
+
+static RK_S32 row_blend_simd(RK_U8 *dst, const RK_U8 *a, const RK_U8 *b,
+                             const RK_U8 *c, RK_S32 w)
+{
+    const IepV two = v_set(2);
+    RK_S32 x;
+
+    for (x = 0; x + V_W <= w; x += V_W) {
+        IepV vb = v_load(b + x);
+        IepV sum = v_add(v_add(v_load(a + x), v_load(c + x)), v_add(vb, vb));
+
+        v_store(dst + x, v_shr2(v_add(sum, two)));
+    }
+
+    return x;
+}
+
+/* spatial_pixel on V_W pixels away from the borders */
+static inline IepV spatial_simd(const RK_U8 *c, const RK_U8 *e, RK_S32 x, RK_S32 s)
+{
+    IepV c0 = v_load(c + x);
+    IepV e0 = v_load(e + x);
+    IepV cl = v_load(c + x - s);
+    IepV cr = v_load(c + x + s);
+    IepV el = v_load(e + x - s);
+    IepV er = v_load(e + x + s);
+    IepV pred = v_shr1(v_add(c0, e0));
+    IepV score, tmp;
+    IepM m;
+
+    score = v_add(v_add(v_abs(v_sub(cl, el)), v_abs(v_sub(c0, e0))),
+                  v_sub(v_abs(v_sub(cr, er)), v_set(1)));
+
+    tmp = v_add(v_add(v_abs(v_sub(v_load(c + x - 2 * s), e0)), v_abs(v_sub(cl, er))),
+                v_abs(v_sub(c0, v_load(e + x + 2 * s))));
+    m = v_lt(tmp, score);
+    score = v_sel(m, tmp, score);
+    pred = v_sel(m, v_shr1(v_add(cl, er)), pred);
+
+    tmp = v_add(v_add(v_abs(v_sub(c0, v_load(e + x - 2 * s))), v_abs(v_sub(cr, el))),
+                v_abs(v_sub(v_load(c + x + 2 * s), e0)));
+    m = v_lt(tmp, score);
+
+    return v_sel(m, v_shr1(v_add(cr, el)), pred);
+}
+
+/* return the first pixel left to the c loop, which also does the borders */
+static RK_S32 row_ela_simd(RK_U8 *dst, const RK_U8 *c, const RK_U8 *e,
+                           RK_S32 w, RK_S32 s)
+{
+    RK_S32 x = 2 * s;
+
+    if (x + V_W + 2 * s > w)
+        return 0;
+
+    row_ela_c(dst, c, e, 0, x, s);
+    for (; x + V_W + 2 * s <= w; x += V_W)
+        v_store(dst + x, spatial_simd(c, e, x, s));
+
+    return x;
+}
+
+static RK_S32 row_yadif_simd(RK_U8 *dst, const RK_U8 *c, const RK_U8 *e,
+                             const RK_U8 *p, const RK_U8 *n,
+                             const RK_U8 *pu, const RK_U8 *nu,
+                             const RK_U8 *pd, const RK_U8 *nd,
+                             const RK_U8 *ru, const RK_U8 *rd,
+                             RK_S32 w, RK_S32 s)
+{
+    const IepV zero = v_set(0);
+    RK_S32 x = 2 * s;
+
+    if (x + V_W + 2 * s > w)
+        return 0;
+
+    row_yadif_c(dst, c, e, p, n, pu, nu, pd, nd, ru, rd, 0, x, s);
+    for (; x + V_W + 2 * s <= w; x += V_W) {
+        IepV c0 = v_load(c + x);
+        IepV e0 = v_load(e + x);
+        IepV p0 = v_load(p + x);
+        IepV n0 = v_load(n + x);
+        IepV d = v_shr1(v_add(p0, n0));
+        IepV td1 = v_shr1(v_add(v_abs(v_sub(v_load(ru + x), c0)),
+                                v_abs(v_sub(v_load(rd + x), e0))));
+        IepV diff = v_max(v_shr1(v_abs(v_sub(p0, n0))), td1);
+        IepV pred = spatial_simd(c, e, x, s);
+        IepV b = v_shr1(v_add(v_load(pu + x), v_load(nu + x)));
+        IepV f = v_shr1(v_add(v_load(pd + x), v_load(nd + x)));
+        IepV de = v_sub(d, e0);
+        IepV dc = v_sub(d, c0);
+        IepV bc = v_sub(b, c0);
+        IepV fe = v_sub(f, e0);
+        IepV mx = v_max(v_max(de, dc), v_min(bc, fe));
+        IepV mn = v_min(v_min(de, dc), v_max(bc, fe));
+
+        diff = v_max(v_max(diff, mn), v_sub(zero, mx));
+        pred = v_min(v_max(pred, v_sub(d, diff)), v_add(d, diff));
+        v_store(dst + x, pred);
+    }
+
+    return x;
+}
+#endif
+
+static void iep_sw_plane(IepSwCtxImpl *impl, IepSwJob *job, IepSwPlane *plane,
+                         RK_S32 y_start, RK_S32 y_end)
+{
+    RK_S32 stride = impl->stride;
+    RK_S32 w = plane->width;
+    RK_S32 h = plane->height;
+    RK_S32 s = plane->step;
+    const RK_U8 *cur = job->cur + plane->offset;
+    RK_U8 *dst = job->dst + plane->offset;
+    RK_S32 y;
+
+    for (y = y_start; y < y_end; y++) {
+        RK_U8 *out = dst + y * stride;
+        // field lines around y, mirrored on the picture edges
+        RK_S32 up = (y > 0) ? (y - 1) : (y + 1);
+        RK_S32 dn = (y + 1 < h) ? (y + 1) : (y - 1);
+        RK_S32 x = 0;
+
+        if (h < 2) {
+            memcpy(out, cur + y * stride, w);
+            continue;
+        }
+
+        if (impl->mode == IEP_SW_MODE_BLEND) {
+            const RK_U8 *a = cur + up * stride;
+            const RK_U8 *b = cur + y * stride;
+            const RK_U8 *c = cur + dn * stride;
+
+#ifdef V_W
+            if (impl->simd)
+                x = row_blend_simd(out, a, b, c, w);
+#endif
+            row_blend_c(out, a, b, c, x, w);
+            continue;
+        }
+
+        if ((y & 1) == job->parity) {
+            memcpy(out, cur + y * stride, w);
+            continue;
+        }
+
+        const RK_U8 *c = cur + up * stride;
+        const RK_U8 *e = cur + dn * stride;
+
+        if (impl->mode == IEP_SW_MODE_BOB) {
+#ifdef V_W
+            if (impl->simd)
+                x = row_bob_simd(out, c, e, w);
+#endif
+            row_bob_c(out, c, e, x, w);
+        } else if (!job->temporal) {
+#ifdef V_W
+            if (impl->simd)
+                x = row_ela_simd(out, c, e, w, s);
+#endif
+            row_ela_c(out, c, e, x, w, s);
+        } else {
+            const RK_U8 *prev = job->prev + plane->offset;
+            const RK_U8 *next = job->next + plane->offset;
+            const RK_U8 *ref = job->ref + plane->offset;
+            RK_S32 y_up = (y >= 2) ? (y - 2) : y;
+            RK_S32 y_dn = (y + 2 < h) ? (y + 2) : y;
+            const RK_U8 *p = prev + y * stride;
+            const RK_U8 *n = next + y * stride;
+            const RK_U8 *pu = prev + y_up * stride;
+            const RK_U8 *nu = next + y_up * stride;
+            const RK_U8 *pd = prev + y_dn * stride;
+            const RK_U8 *nd = next + y_dn * stride;
+            const RK_U8 *ru = ref + up * stride;
+            const RK_U8 *rd = ref + dn * stride;
+
+#ifdef V_W
+            if (impl->simd)
+                x = row_yadif_simd(out, c, e, p, n, pu, nu, pd, nd, ru, rd, w, s);
+#endif
+            row_yadif_c(out, c, e, p, n, pu, nu, pd, nd, ru, rd, x, w, s);
+        }
+    }
+}
+
+/* bands are cut on 4 luma lines to keep the chroma fields of a band whole */
+static void iep_sw_band(IepSwCtxImpl *impl, RK_S32 band)
+{
+    IepSwPlane *luma = &impl->planes[0];
+    IepSwPlane *chroma = &impl->planes[1];
+    RK_S32 units = (luma->height + 3) >> 2;
+    RK_S32 start = units * band / impl->band_cnt * 4;
+    RK_S32 end = MPP_MIN(units * (band + 1) / impl->band_cnt * 4, luma->height);
+    RK_S32 c_start = start * chroma->height / luma->height;
+    RK_S32 c_end = end * chroma->height / luma->height;
+    RK_S32 i;
+
+    for (i = 0; i < impl->job_cnt; i++) {
+        iep_sw_plane(impl, &impl->jobs[i], luma, start, end);
+        iep_sw_plane(impl, &impl->jobs[i], chroma, c_start, c_end);
+    }
+}
+
+static void *iep_sw_worker(void *arg)
+{
+    IepSwWorker *worker = (IepSwWorker *)arg;
+    IepSwCtxImpl *impl = worker->impl;
+    MppThread *thd = worker->thd;
+
+    while (1) {
+        thd->lock();
+        while (MPP_THREAD_RUNNING == thd->get_status() && !worker->pending)
+            thd->wait();
+
+        if (MPP_THREAD_RUNNING != thd->get_status()) {
+            thd->unlock();
+            break;
+        }
+        worker->pending = 0;
+        thd->unlock();
+
+        iep_sw_band(impl, worker->band);
+
+        impl->done.lock();
+        if (!--impl->busy)
+            impl->done.signal();
+        impl->done.unlock();
+    }
+
+    return NULL;
+}
+
+static void iep_sw_run(IepSwCtxImpl *impl)
+{
+    RK_S32 i;
+
+    impl->done.lock();
+    impl->busy = impl->band_cnt - 1;
+    impl->done.unlock();
+
+    for (i = 0; i < impl->band_cnt - 1; i++) {
+        IepSwWorker *worker = &impl->workers[i];
+
+        worker->thd->lock();
+        worker->pending = 1;
+        worker->thd->signal();
+        worker->thd->unlock();
+    }
+
+    iep_sw_band(impl, 0);
+
+    impl->done.lock();
+    while (impl->busy)
+        impl->done.wait();
+    impl->done.unlock();
+}
+
+static MPP_RET iep_sw_check_img(IepCmdParamImage *param, IepImg *src)
+{
+    IepImg *img = &param->image;
+
+    if (NULL == param->ptr) {
+        mpp_err("iep_sw needs the cpu address of the images\n");
+        return MPP_NOK;
+    }
+
+    if (img->format != src->format || img->act_w != src->act_w ||
+        img->act_h != src->act_h || img->vir_w != src->vir_w ||
+        img->vir_h != src->vir_h) {
+        mpp_err("iep_sw can not scale or convert %dx%d fmt %x to %dx%d fmt %x\n",
+                src->act_w, src->act_h, src->format,
+                img->act_w, img->act_h, img->format);
+        return MPP_NOK;
+    }
+
+    return MPP_OK;
+}
+
+static MPP_RET iep_sw_setup(IepSwCtxImpl *impl)
+{
+    IepImg *src = &impl->src.image;
+    IepSwPlane *luma = &impl->planes[0];
+    IepSwPlane *chroma = &impl->planes[1];
+    RK_U32 mode = impl->dei_cfg.dei_mode;
+    // the field coded first is kept on a single output
+    RK_S32 first = (impl->dei_cfg.dei_field_order == IEP_DEI_FLD_ORDER_TOP_FIRST) ? 0 : 1;
+    IepSwJob *job0 = &impl->jobs[0];
+    IepSwJob *job1 = &impl->jobs[1];
+
+    switch (src->format) {
+    case IEP_FORMAT_YCbCr_420_SP :
+    case IEP_FORMAT_YCrCb_420_SP : {
+        chroma->height = (src->act_h + 1) >> 1;
+    } break;
+    case IEP_FORMAT_YCbCr_422_SP :
+    case IEP_FORMAT_YCrCb_422_SP : {
+        chroma->height = src->act_h;
+    } break;
+    default : {
+        mpp_err("iep_sw does not support format %x\n", src->format);
+        return MPP_NOK;
+    } break;
+    }
+
+    if (NULL == impl->src.ptr || !src->act_w || !src->act_h ||
+        src->act_w > src->vir_w || src->act_h > src->vir_h) {
+        mpp_err("invalid source %dx%d stride %dx%d ptr %p\n", src->act_w, src->act_h,
+                src->vir_w, src->vir_h, impl->src.ptr);
+        return MPP_NOK;
+    }
+
+    if (iep_sw_check_img(&impl->dst, src))
+        return MPP_NOK;
+
+    impl->stride = src->vir_w;
+    luma->offset = 0;
+    luma->width = src->act_w;
+    luma->height = src->act_h;
+    luma->step = 1;
+    chroma->offset = src->vir_w * src->vir_h;
+    chroma->width = MPP_ALIGN(src->act_w, 2);
+    chroma->step = 2;
+
+    job0->cur = job0->prev = job0->next = job0->ref = impl->src.ptr;
+    job0->dst = impl->dst.ptr;
+    job0->parity = first;
+    job0->temporal = 0;
+    impl->job_cnt = 1;
+
+    switch (mode) {
+    case IEP_DEI_MODE_I2O1 : {
+    } break;
+    case IEP_DEI_MODE_I4O2 : {
+        const RK_U8 *src0 = impl->src.ptr;
+        const RK_U8 *src1 = impl->src1.ptr;
+
+        if (iep_sw_check_img(&impl->src1, src) || iep_sw_check_img(&impl->dst1, src))
+            return MPP_NOK;
+
+        /*
+         * Of the fields src0 f0 f1, src1 f2 f3 in time order f1 and f2 are
+         * output, the bottom one to dst and the top one to dst1.
+         */
+        job0->prev = job1->prev = src0;
+        job0->next = job1->next = src1;
+        job0->temporal = job1->temporal = 1;
+
+        job0->cur = (first) ? src1 : src0;
+        job0->ref = (first) ? src0 : src1;
+        job0->parity = 1;
+
+        job1->cur = (first) ? src0 : src1;
+        job1->ref = (first) ? src1 : src0;
+        job1->dst = impl->dst1.ptr;
+        job1->parity = 0;
+        impl->job_cnt = 2;
+    } break;
+    case IEP_DEI_MODE_BYPASS : {
+        impl->job_cnt = 0;
+    } break;
+    default : {
+        mpp_err("iep_sw does not support deinterlace mode %d\n", mode);
+        return MPP_NOK;
+    } break;
+    }
+
+    return MPP_OK;
+}
+
+static MPP_RET iep_sw_process(IepSwCtxImpl *impl)
+{
+    IepImg *src = &impl->src.image;
+    RK_S64 time = mpp_time();
+    MPP_RET ret;
+
+    if (impl->dei_cfg.dei_mode == IEP_DEI_MODE_DISABLE)
+        return MPP_OK;
+
+    ret = iep_sw_setup(impl);
+    if (ret)
+        return ret;
+
+    if (!impl->job_cnt) {
+        RK_S32 size = impl->planes[1].offset + impl->planes[1].height * impl->stride;
+
+        memcpy(impl->dst.ptr, impl->src.ptr, size);
+        return MPP_OK;
+    }
+
+    iep_sw_run(impl);
+
+    iep_sw_dbg_time("mode %d dei %d %dx%d in %d bands %lld us\n", impl->mode,
+                    impl->dei_cfg.dei_mode, src->act_w, src->act_h,
+                    impl->band_cnt, mpp_time() - time);
+
+    return MPP_OK;
+}
+
+MPP_RET iep_sw_init(IepCtx *ctx)
+{
+    if (NULL == ctx) {
+        mpp_err_f("invalid NULL input\n");
+        return MPP_ERR_NULL_PTR;
+    }
+
+    IepSwCtxImpl *impl = NULL;
+    RK_U32 threads = 0;
+    RK_S32 i;
+
+    mpp_env_get_u32("iep_sw_debug", &iep_sw_debug, 0);
+    *ctx = NULL;
+
+    impl = new IepSwCtxImpl();
+    if (NULL == impl) {
+        mpp_err_f("failed to alloc context\n");
+        return MPP_ERR_MALLOC;
+    }
+
+    mpp_env_get_u32("iep_sw_mode", &impl->mode, IEP_SW_MODE_YADIF);
+    if (impl->mode >= IEP_SW_MODE_BUTT)
+        impl->mode = IEP_SW_MODE_YADIF;
+    mpp_env_get_u32("iep_sw_simd", &impl->simd, 1);
+
+    // one band per cpu, the caller thread runs one of them
+    mpp_env_get_u32("iep_sw_threads", &threads, 0);
+    if (!threads)
+        threads = (RK_U32)sysconf(_SC_NPROCESSORS_ONLN);
+    impl->band_cnt = mpp_clip((RK_S32)threads, 1, IEP_SW_MAX_THREADS);
+
+    for (i = 0; i < impl->band_cnt - 1; i++) {
+        IepSwWorker *worker = &impl->workers[i];
+
+        worker->impl = impl;
+        worker->band = i + 1;
+        worker->thd = new MppThread(iep_sw_worker, worker, "iep_sw");
+        worker->thd->start();
+    }
+
+    impl->cap.i4_deinterlace_supported = 1;
+    impl->cap.i2_deinterlace_supported = 1;
+    impl->cap.max_dynamic_width = 8192;
+    impl->cap.max_dynamic_height = 8192;
+    impl->cap.max_static_width = 8192;
+    impl->cap.max_static_height = 8192;
+
+    iep_sw_dbg_func("mode %d simd %d bands %d\n", impl->mode, impl->simd,
+                    impl->band_cnt);
+
+    *ctx = impl;
+    return MPP_OK;
+}
+
+MPP_RET iep_sw_deinit(IepCtx ctx)
+{
+    if (NULL == ctx) {
+        mpp_err_f("invalid NULL input\n");
+        return MPP_ERR_NULL_PTR;
+    }
+
+    IepSwCtxImpl *impl = (IepSwCtxImpl *)ctx;
+    RK_S32 i;
+
+    for (i = 0; i < impl->band_cnt - 1; i++) {
+        IepSwWorker *worker = &impl->workers[i];
+
+        worker->thd->stop();
+        delete worker->thd;
+        worker->thd = NULL;
+    }
+
+    delete impl;
+    return MPP_OK;
+}
+
+MPP_RET iep_sw_control(IepCtx ctx, IepCmd cmd, void *param)
+{
+    if (NULL == ctx) {
+        mpp_err_f("invalid NULL input\n");
+        return MPP_ERR_NULL_PTR;
+    }
+
+    MPP_RET ret = MPP_OK;
+    IepSwCtxImpl *impl = (IepSwCtxImpl *)ctx;
+
+    switch (cmd) {
+    case IEP_CMD_INIT : {
+        memset(&impl->src, 0, sizeof(impl->src));
+        memset(&impl->dst, 0, sizeof(impl->dst));
+        memset(&impl->src1, 0, sizeof(impl->src1));
+        memset(&impl->dst1, 0, sizeof(impl->dst1));
+        memset(&impl->dei_cfg, 0, sizeof(impl->dei_cfg));
+    } break;
+    case IEP_CMD_SET_SRC : {
+        mpp_assert(param);
+        memcpy(&impl->src, param, sizeof(impl->src));
+    } break;
+    case IEP_CMD_SET_DST : {
+        mpp_assert(param);
+        memcpy(&impl->dst, param, sizeof(impl->dst));
+    } break;
+    case IEP_CMD_SET_DEI_SRC1 : {
+        mpp_assert(param);
+        memcpy(&impl->src1, param, sizeof(impl->src1));
+    } break;
+    case IEP_CMD_SET_DEI_DST1 : {
+        mpp_assert(param);
+        memcpy(&impl->dst1, param, sizeof(impl->dst1));
+    } break;
+    case IEP_CMD_SET_DEI_CFG : {
+        mpp_assert(param);
+        memcpy(&impl->dei_cfg, param, sizeof(impl->dei_cfg));
+    } break;
+    case IEP_CMD_RUN_SYNC :
+    case IEP_CMD_RUN_ASYNC : {
+        ret = iep_sw_process(impl);
+    } break;
+    case IEP_CMD_QUERY_CAP : {
+        if (param)
+            *(IepCap **)param = &impl->cap;
+        else
+            mpp_err("Can NOT query to NULL output\n");
+    } break;
+    default : {
+        mpp_err("iep_sw does not support command %x\n", cmd);
+        ret = MPP_NOK;
+    } break;
+    }
+
+    return ret;
+}
@@ -0,0 +1,253 @@
+/*
+ * Copyright 2018 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_TAG "iep_sw_test"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "mpp_env.h"
+#include "mpp_log.h"
+#include "mpp_mem.h"
+#include "mpp_time.h"
+#include "mpp_common.h"
+
+#include "iep_api.h"
+
+#define TEST_WIDTH          (718)       // not a multiple of any simd width
+#define TEST_HEIGHT         (480)
+#define TEST_HOR_STRIDE     (736)
+#define TEST_VER_STRIDE     (480)
+#define TEST_FRAME_SIZE     (TEST_HOR_STRIDE * TEST_VER_STRIDE * 3 / 2)
+#define TEST_SPEED          (6)         // pixel of motion per field
+
+typedef struct IepSwTestPic_t {
+    RK_U8   *src0;
+    RK_U8   *src1;
+    RK_U8   *dst0;
+    RK_U8   *dst1;
+} IepSwTestPic;
+
+/*
+ * progressive picture of field n, a bar moving right over a texture which
+ * grows to the bottom so that yadif has no vertical detail to keep
+ */
+static RK_U8 test_pixel(RK_S32 x, RK_S32 y, RK_S32 field)
+{
+    RK_S32 bar = (x - field * TEST_SPEED + TEST_WIDTH) % 128;
+
+    if (bar < 32)
+        return 235;
+
+    return 16 + ((x * 3) & 0x7f) + y / 8;
+}
+
+/* weave field a on the top lines and field b on the bottom lines */
+static void test_weave(RK_U8 *frm, RK_S32 top, RK_S32 bot)
+{
+    RK_U8 *uv = frm + TEST_HOR_STRIDE * TEST_VER_STRIDE;
+    RK_S32 x, y;
+
+    for (y = 0; y < TEST_HEIGHT; y++) {
+        RK_S32 field = (y & 1) ? bot : top;
+
+        for (x = 0; x < TEST_WIDTH; x++)
+            frm[y * TEST_HOR_STRIDE + x] = test_pixel(x, y, field);
+    }
+
+    for (y = 0; y < TEST_HEIGHT / 2; y++) {
+        RK_S32 field = (y & 1) ? bot : top;
+
+        for (x = 0; x < TEST_WIDTH; x++)
+            uv[y * TEST_HOR_STRIDE + x] = 128 + ((test_pixel(x & ~1, y * 2, field) - 128) >> 2);
+    }
+}
+
+/* energy of the line to line alternation, large on a combed picture */
+static RK_S64 test_comb(RK_U8 *frm)
+{
+    RK_S64 sum = 0;
+    RK_S32 x, y;
+
+    for (y = 1; y < TEST_HEIGHT - 1; y++) {
+        RK_U8 *p = frm + y * TEST_HOR_STRIDE;
+
+        for (x = 0; x < TEST_WIDTH; x++) {
+            RK_S32 v = 2 * p[x] - p[x - TEST_HOR_STRIDE] - p[x + TEST_HOR_STRIDE];
+
+            sum += MPP_ABS(v);
+        }
+    }
+
+    return sum;
+}
+
+static void test_set_img(IepCtx ctx, IepCmd cmd, RK_U8 *ptr)
+{
+    IepCmdParamImage img;
+
+    memset(&img, 0, sizeof(img));
+    img.image.act_w = TEST_WIDTH;
+    img.image.act_h = TEST_HEIGHT;
+    img.image.vir_w = TEST_HOR_STRIDE;
+    img.image.vir_h = TEST_VER_STRIDE;
+    img.image.format = IEP_FORMAT_YCbCr_420_SP;
+    img.ptr = ptr;
+
+    iep_sw_control(ctx, cmd, &img);
+}
+
+static MPP_RET test_run(IepSwTestPic *pic, RK_U32 mode, RK_U32 simd,
+                        RK_U32 threads, IepDeiMode dei_mode,
+                        IepDeiFldOrder order, RK_S64 *time)
+{
+    IepCtx ctx = NULL;
+    IepCmdParamDeiCfg cfg;
+    RK_S64 start;
+    MPP_RET ret;
+
+    mpp_env_set_u32("iep_sw_mode", mode);
+    mpp_env_set_u32("iep_sw_simd", simd);
+    mpp_env_set_u32("iep_sw_threads", threads);
+
+    ret = iep_sw_init(&ctx);
+    if (ret)
+        return ret;
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.dei_mode = dei_mode;
+    cfg.dei_field_order = order;
+
+    iep_sw_control(ctx, IEP_CMD_INIT, NULL);
+    test_set_img(ctx, IEP_CMD_SET_SRC, pic->src0);
+    test_set_img(ctx, IEP_CMD_SET_DST, pic->dst0);
+    test_set_img(ctx, IEP_CMD_SET_DEI_SRC1, pic->src1);
+    test_set_img(ctx, IEP_CMD_SET_DEI_DST1, pic->dst1);
+    iep_sw_control(ctx, IEP_CMD_SET_DEI_CFG, &cfg);
+
+    start = mpp_time();
+    ret = iep_sw_control(ctx, IEP_CMD_RUN_SYNC, NULL);
+    if (time)
+        *time = mpp_time() - start;
+
+    iep_sw_deinit(ctx);
+    return ret;
+}
+
+int main()
+{
+    static const char *mode_name[] = { "bob", "blend", "yadif" };
+    RK_U8 *buf = mpp_malloc(RK_U8, TEST_FRAME_SIZE * 6);
+    RK_U8 *ref0 = buf + TEST_FRAME_SIZE * 4;
+    RK_U8 *ref1 = buf + TEST_FRAME_SIZE * 5;
+    IepSwTestPic pic;
+    RK_S64 comb_in, comb_out;
+    RK_S64 time = 0;
+    RK_U32 mode, order, dei;
+
+    mpp_log("iep_sw test start\n");
+
+    if (NULL == buf) {
+        mpp_err("failed to alloc test frames\n");
+        goto TEST_FAILED;
+    }
+
+    pic.src0 = buf;
+    pic.src1 = buf + TEST_FRAME_SIZE;
+    pic.dst0 = buf + TEST_FRAME_SIZE * 2;
+    pic.dst1 = buf + TEST_FRAME_SIZE * 3;
+
+    // fields 0 1 2 3 in time order, frames woven in the field order
+    for (order = 0; order < IEP_DEI_FLD_ORDER_BUTT; order++) {
+        if (order == IEP_DEI_FLD_ORDER_TOP_FIRST) {
+            test_weave(pic.src0, 0, 1);
+            test_weave(pic.src1, 2, 3);
+        } else {
+            test_weave(pic.src0, 1, 0);
+            test_weave(pic.src1, 3, 2);
+        }
+        comb_in = test_comb(pic.src1);
+
+        for (mode = 0; mode < MPP_ARRAY_ELEMS(mode_name); mode++) {
+            for (dei = IEP_DEI_MODE_I2O1; dei <= IEP_DEI_MODE_I4O2; dei += 2) {
+                IepDeiMode dei_mode = (IepDeiMode)dei;
+                IepDeiFldOrder fld_order = (IepDeiFldOrder)order;
+
+                // plain c on one thread is the reference
+                memset(pic.dst0, 0, TEST_FRAME_SIZE * 2);
+                if (test_run(&pic, mode, 0, 1, dei_mode, fld_order, &time))
+                    goto TEST_FAILED;
+                memcpy(ref0, pic.dst0, TEST_FRAME_SIZE);
+                memcpy(ref1, pic.dst1, TEST_FRAME_SIZE);
+
+                mpp_log("%-5s %s %s c %lld us\n", mode_name[mode],
+                        (dei == IEP_DEI_MODE_I4O2) ? "i4o2" : "i2o1",
+                        order ? "bot" : "top", time);
+
+                memset(pic.dst0, 0, TEST_FRAME_SIZE);
+                memset(pic.dst1, 0, TEST_FRAME_SIZE);
+                if (test_run(&pic, mode, 1, 3, dei_mode, fld_order, &time))
+                    goto TEST_FAILED;
+
+                mpp_log("%-5s %s %s simd 3 threads %lld us\n", mode_name[mode],
+                        (dei == IEP_DEI_MODE_I4O2) ? "i4o2" : "i2o1",
+                        order ? "bot" : "top", time);
+
+                if (memcmp(ref0, pic.dst0, TEST_FRAME_SIZE) ||
+                    memcmp(ref1, pic.dst1, TEST_FRAME_SIZE)) {
+                    mpp_err("%s simd output differs from c\n", mode_name[mode]);
+                    goto TEST_FAILED;
+                }
+
+                if (dei != IEP_DEI_MODE_I4O2 || mode == 1)
+                    continue;
+
+                // both outputs of the interpolating modes lose the comb
+                comb_out = test_comb(pic.dst1);
+                if (comb_out * 2 > comb_in || test_comb(pic.dst0) * 2 > comb_in) {
+                    mpp_err("%s still combed %lld -> %lld\n", mode_name[mode],
+                            comb_in, comb_out);
+                    goto TEST_FAILED;
+                }
+            }
+        }
+    }
+
+    // a still picture comes back from yadif as it was
+    test_weave(pic.src0, 0, 0);
+    test_weave(pic.src1, 0, 0);
+    if (test_run(&pic, 2, 1, 2, IEP_DEI_MODE_I4O2, IEP_DEI_FLD_ORDER_TOP_FIRST, NULL))
+        goto TEST_FAILED;
+
+    for (RK_S32 y = 2; y < TEST_HEIGHT - 2; y++) {
+        RK_S32 offset = y * TEST_HOR_STRIDE;
+
+        if (memcmp(pic.dst0 + offset, pic.src0 + offset, TEST_WIDTH) ||
+            memcmp(pic.dst1 + offset, pic.src0 + offset, TEST_WIDTH)) {
+            mpp_err("yadif changed still line %d\n", y);
+            goto TEST_FAILED;
+        }
+    }
+
+    MPP_FREE(buf);
+    mpp_log("iep_sw test success\n");
+    return 0;
+
+TEST_FAILED:
+    MPP_FREE(buf);
+    mpp_log("iep_sw test failed\n");
+    return -1;
+}
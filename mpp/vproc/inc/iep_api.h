@@ -91,9 +91,12 @@ typedef struct IegImg_t {
  * IEP_CMD_SET_DST
  * IEP_CMD_SET_DEI_SRC1
  * IEP_CMD_SET_DEI_DST1
+ *
+ * The hardware only reads image, the software deinterlacer works on ptr.
  */
 typedef struct IepCmdParamImage_t {
     IepImg  image;
+    RK_U8   *ptr;           // cpu address of mem_addr
 } IepCmdParamImage;
 
 typedef enum IepDeiMode_e {
@@ -234,6 +237,17 @@ MPP_RET iep_init(IepCtx *ctx);
 MPP_RET iep_deinit(IepCtx ctx);
 MPP_RET iep_control(IepCtx ctx, IepCmd cmd, void *param);
 
+/*
+ * Software deinterlacer with the same commands, for the hosts without iep.
+ * Only the deinterlace commands on yuv semi-planar images are supported.
+ * Env iep_sw_mode selects 0 - bob, 1 - linear blend, 2 - yadif (default),
+ * iep_sw_threads the row bands run in parallel, iep_sw_simd=0 disables the
+ * simd kernels.
+ */
+MPP_RET iep_sw_init(IepCtx *ctx);
+MPP_RET iep_sw_deinit(IepCtx ctx);
+MPP_RET iep_sw_control(IepCtx ctx, IepCmd cmd, void *param);
+
 #ifdef __cplusplus
 }
 #endif
@@ -51,6 +51,20 @@
 
 RK_U32 vproc_debug = 0;
 
+typedef struct IepApi_t {
+    const char          *name;
+    RK_U32              cpu_access;     // works on the mapped buffers
+    MPP_RET             (*init)(IepCtx *ctx);
+    MPP_RET             (*deinit)(IepCtx ctx);
+    MPP_RET             (*control)(IepCtx ctx, IepCmd cmd, void *param);
+} IepApi;
+
+// hardware first, the software deinterlacer when there is no iep device
+static const IepApi iep_apis[] = {
+    { "iep",    0,  iep_init,       iep_deinit,     iep_control     },
+    { "iep_sw", 1,  iep_sw_init,    iep_sw_deinit,  iep_sw_control  },
+};
+
 typedef struct MppDecVprocCtxImpl_t {
     Mpp                 *mpp;
     HalTaskGroup        task_group;
@@ -60,6 +74,7 @@ typedef struct MppDecVprocCtxImpl_t {
     RK_U32              reset;
     sem_t               reset_sem;
 
+    const IepApi        *iep_api;
     IepCtx              iep_ctx;
     IepCmdParamDeiCfg   dei_cfg;
 
@@ -90,6 +105,7 @@ static void dec_vproc_put_frame(Mpp *mpp, MppFrame frame, MppBuffer buf, RK_S64
 
     mpp->mFramePutCount++;
     list->signal();
+    mpp->update_output_event();
     list->unlock();
 }
 
@@ -127,14 +143,19 @@ static void dec_vproc_set_img_fmt(IepImg *img, MppFrame frm)
     img->format = IEP_FORMAT_YCbCr_420_SP;
 }
 
-static void dec_vproc_set_img(MppDecVprocCtxImpl *ctx, IepImg *img, RK_S32 fd, IepCmd cmd)
+static void dec_vproc_set_img(MppDecVprocCtxImpl *ctx, IepCmdParamImage *param,
+                              MppBuffer buf, IepCmd cmd)
 {
+    IepImg *img = &param->image;
+    RK_S32 fd = mpp_buffer_get_fd(buf);
     RK_S32 y_size = img->vir_w * img->vir_h;
     img->mem_addr = fd;
     img->uv_addr = fd + (y_size << 10);
     img->v_addr = fd + ((y_size + y_size / 4) << 10);
+    param->ptr = (ctx->iep_api->cpu_access) ?
+                 (RK_U8 *)mpp_buffer_get_ptr(buf) : NULL;
 
-    MPP_RET ret = iep_control(ctx->iep_ctx, cmd, img);
+    MPP_RET ret = ctx->iep_api->control(ctx->iep_ctx, cmd, param);
     if (ret)
         mpp_log_f("control %08x failed %d\n", cmd, ret);
 }
@@ -162,11 +183,11 @@ static void dec_vproc_start_dei(MppDecVprocCtxImpl *ctx, RK_U32 mode)
         (IEP_DEI_FLD_ORDER_TOP_FIRST) :
         (IEP_DEI_FLD_ORDER_BOT_FIRST);
 
-    MPP_RET ret = iep_control(ctx->iep_ctx, IEP_CMD_SET_DEI_CFG, &ctx->dei_cfg);
+    MPP_RET ret = ctx->iep_api->control(ctx->iep_ctx, IEP_CMD_SET_DEI_CFG, &ctx->dei_cfg);
     if (ret)
         mpp_log_f("IEP_CMD_SET_DEI_CFG failed %d\n", ret);
 
-    ret = iep_control(ctx->iep_ctx, IEP_CMD_RUN_SYNC, NULL);
+    ret = ctx->iep_api->control(ctx->iep_ctx, IEP_CMD_RUN_SYNC, NULL);
     if (ret)
         mpp_log_f("IEP_CMD_RUN_SYNC failed %d\n", ret);
 }
@@ -179,7 +200,7 @@ static void *dec_vproc_thread(void *data)
     Mpp *mpp = ctx->mpp;
     MppDecImpl *dec = (MppDecImpl *)mpp->mDec;
     MppBufSlots slots = dec->frame_slots;
-    IepImg img;
+    IepCmdParamImage img;
 
     HalTaskHnd task = NULL;
     HalTaskInfo task_info;
@@ -262,18 +283,17 @@ static void *dec_vproc_thread(void *data)
                 MppBuffer buf = mpp_frame_get_buffer(frm);
                 MppBuffer dst0 = NULL;
                 MppBuffer dst1 = NULL;
-                int fd = -1;
                 size_t buf_size = mpp_buffer_get_size(buf);
 
                 // setup source IepImg
-                dec_vproc_set_img_fmt(&img, frm);
+                dec_vproc_set_img_fmt(&img.image, frm);
 
-                ret = iep_control(ctx->iep_ctx, IEP_CMD_INIT, NULL);
+                ret = ctx->iep_api->control(ctx->iep_ctx, IEP_CMD_INIT, NULL);
                 if (ret)
                     mpp_log_f("IEP_CMD_INIT failed %d\n", ret);
 
                 IepCap_t *cap = NULL;
-                ret = iep_control(ctx->iep_ctx, IEP_CMD_QUERY_CAP, &cap);
+                ret = ctx->iep_api->control(ctx->iep_ctx, IEP_CMD_QUERY_CAP, &cap);
                 if (ret)
                     mpp_log_f("IEP_CMD_QUERY_CAP failed %d\n", ret);
 
@@ -288,24 +308,20 @@ static void *dec_vproc_thread(void *data)
                     RK_S64 first_pts = (prev_pts + curr_pts) / 2;
 
                     buf = mpp_frame_get_buffer(ctx->prev_frm);
-                    fd = mpp_buffer_get_fd(buf);
-                    dec_vproc_set_img(ctx, &img, fd, IEP_CMD_SET_SRC);
+                    dec_vproc_set_img(ctx, &img, buf, IEP_CMD_SET_SRC);
 
                     // setup dst 0
                     dst0 = dec_vproc_get_buffer(group, buf_size);
                     mpp_assert(dst0);
-                    fd = mpp_buffer_get_fd(dst0);
-                    dec_vproc_set_img(ctx, &img, fd, IEP_CMD_SET_DST);
+                    dec_vproc_set_img(ctx, &img, dst0, IEP_CMD_SET_DST);
 
                     buf = mpp_frame_get_buffer(frm);
-                    fd = mpp_buffer_get_fd(buf);
-                    dec_vproc_set_img(ctx, &img, fd, IEP_CMD_SET_DEI_SRC1);
+                    dec_vproc_set_img(ctx, &img, buf, IEP_CMD_SET_DEI_SRC1);
 
                     // setup dst 1
                     dst1 = dec_vproc_get_buffer(group, buf_size);
                     mpp_assert(dst1);
-                    fd = mpp_buffer_get_fd(dst1);
-                    dec_vproc_set_img(ctx, &img, fd, IEP_CMD_SET_DEI_DST1);
+                    dec_vproc_set_img(ctx, &img, dst1, IEP_CMD_SET_DEI_DST1);
 
                     ctx->dei_cfg.dei_mode = IEP_DEI_MODE_I4O2;
 
@@ -327,14 +343,12 @@ static void *dec_vproc_thread(void *data)
                     // 2 in 1 out case
                     vproc_dbg_status("2 field in and 1 frame out\n");
                     buf = mpp_frame_get_buffer(frm);
-                    fd = mpp_buffer_get_fd(buf);
-                    dec_vproc_set_img(ctx, &img, fd, IEP_CMD_SET_SRC);
+                    dec_vproc_set_img(ctx, &img, buf, IEP_CMD_SET_SRC);
 
                     // setup dst 0
                     dst0 = dec_vproc_get_buffer(group, buf_size);
                     mpp_assert(dst0);
-                    fd = mpp_buffer_get_fd(dst0);
-                    dec_vproc_set_img(ctx, &img, fd, IEP_CMD_SET_DST);
+                    dec_vproc_set_img(ctx, &img, dst0, IEP_CMD_SET_DST);
 
                     ctx->dei_cfg.dei_mode = IEP_DEI_MODE_I2O1;
                     mode = mode | MPP_FRAME_FLAG_IEP_DEI_I2O1;
@@ -392,7 +406,24 @@ MPP_RET dec_vproc_init(MppDecVprocCtx *ctx, MppDecVprocCfg *cfg)
         return MPP_ERR_MALLOC;
     }
     cfg->task_group = p->task_group;
-    ret = iep_init(&p->iep_ctx);
+
+    RK_U32 iep_sw = 1;
+    RK_U32 i;
+
+    // vproc_iep_sw=0 turns deinterlace off again when there is no iep
+    mpp_env_get_u32("vproc_iep_sw", &iep_sw, 1);
+    for (i = 0; i < MPP_ARRAY_ELEMS(iep_apis); i++) {
+        if (!iep_sw && iep_apis[i].cpu_access)
+            continue;
+
+        ret = iep_apis[i].init(&p->iep_ctx);
+        if (MPP_OK == ret) {
+            p->iep_api = &iep_apis[i];
+            vproc_dbg_status("deinterlace with %s\n", p->iep_api->name);
+            break;
+        }
+    }
+
     if (!p->thd || ret) {
         mpp_err("failed to create context\n");
         if (p->thd) {
@@ -401,7 +432,7 @@ MPP_RET dec_vproc_init(MppDecVprocCtx *ctx, MppDecVprocCfg *cfg)
         }
 
         if (p->iep_ctx) {
-            iep_deinit(p->iep_ctx);
+            p->iep_api->deinit(p->iep_ctx);
             p->iep_ctx = NULL;
         }
 
@@ -451,7 +482,7 @@ MPP_RET dec_vproc_deinit(MppDecVprocCtx ctx)
     }
 
     if (p->iep_ctx) {
-        iep_deinit(p->iep_ctx);
+        p->iep_api->deinit(p->iep_ctx);
         p->iep_ctx = NULL;
     }
 
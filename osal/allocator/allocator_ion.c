@@ -513,7 +513,7 @@ MPP_RET _allocator_ion_custom_ioctl(void *ctx, unsigned int cmd, unsigned long a
     }
 
     ion_dbg(ION_IOCTL, "custom-ioctl fd %d { %08X %lu } \n", p->ion_device, cmd, args);
-    
+
     if (ion_ioctl(p->ion_device, ION_IOC_CUSTOM, &data) != 0) {
         return MPP_ERR_VALUE;
     }
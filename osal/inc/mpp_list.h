@@ -35,6 +35,9 @@ class mpp_list
 {
 public:
     mpp_list(node_destructor func = NULL);
+    // preallocate capacity nodes for data up to node_size bytes,
+    // adding only goes to heap when all of them are queued
+    mpp_list(node_destructor func, RK_S32 node_size, RK_S32 capacity);
     ~mpp_list();
 
     // for FIFO or FILO implement
@@ -54,6 +57,8 @@ public:
     // for status check
     RK_S32 list_is_empty();
     RK_S32 list_size();
+    // nodes allocated from heap since creation
+    RK_S32 heap_count();
 
     // for vector implement - not implemented yet
     // adding function will return a key
@@ -85,6 +90,17 @@ private:
     static RK_U32           keys;
     static RK_U32           get_key();
 
+    // preallocated nodes, the free ones are linked by next
+    struct mpp_list_node    *pool;
+    struct mpp_list_node    *pool_free;
+    RK_S32                  pool_node_size;
+    RK_S32                  pool_stride;
+    RK_S32                  pool_count;
+    RK_S32                  heap_nodes;
+
+    struct mpp_list_node    *node_get(RK_S32 size);
+    void                    node_put(struct mpp_list_node *node);
+
     mpp_list(const mpp_list &);
     mpp_list &operator=(const mpp_list &);
 };
@@ -66,6 +66,18 @@
 
 #define MPP_ABORT                       (0x10000000)
 
+/*
+ * mpp_log_set_flag bits, initial value comes from env mpp_log_flag
+ *
+ * MPP_LOG_FLAG_ASYNC - format on the calling thread into a per-thread ring
+ *                      and write from a background thread with timestamp.
+ *                      Clearing the flag flushes the pending messages.
+ *
+ * env mpp_log_rate limits each call site to that many messages a second,
+ * zero means no limit. Suppressed and dropped messages are reported.
+ */
+#define MPP_LOG_FLAG_ASYNC              (0x00000001)
+
 /*
  * mpp_dbg usage:
  *
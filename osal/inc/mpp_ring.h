@@ -0,0 +1,50 @@
+/*
+ * Copyright 2015 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __MPP_RING_H__
+#define __MPP_RING_H__
+
+#include "rk_type.h"
+#include "mpp_err.h"
+
+/*
+ * MppRing is a bounded lock-free queue for exactly one producer thread and
+ * one consumer thread. Elements of a fixed size are copied in and out.
+ * Nothing is allocated after init and no lock is taken on put / get, so it
+ * suits stage to stage handoff between two worker threads.
+ */
+typedef void* MppRing;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* capacity is rounded up to power of two */
+MPP_RET mpp_ring_init(MppRing *ring, RK_S32 elem_size, RK_S32 capacity);
+MPP_RET mpp_ring_deinit(MppRing ring);
+
+/* producer side, return MPP_ERR_BUFFER_FULL when no slot is free */
+MPP_RET mpp_ring_put(MppRing ring, const void *data);
+/* consumer side, return MPP_NOK when empty */
+MPP_RET mpp_ring_get(MppRing ring, void *data);
+
+RK_S32  mpp_ring_count(MppRing ring);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*__MPP_RING_H__*/
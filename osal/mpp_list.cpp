@@ -23,6 +23,7 @@
 
 #include "mpp_log.h"
 #include "mpp_list.h"
+#include "mpp_common.h"
 
 
 #define LIST_DEBUG(fmt, ...) mpp_log(fmt, ## __VA_ARGS__)
@@ -49,19 +50,41 @@ static inline void list_node_init_with_key_and_size(mpp_list_node *node, RK_U32
     node->size  = size;
 }
 
-static mpp_list_node* create_list(void *data, RK_S32 size, RK_U32 key)
+mpp_list_node *mpp_list::node_get(RK_S32 size)
 {
-    mpp_list_node *node = (mpp_list_node*)malloc(sizeof(mpp_list_node) + size);
-    if (node) {
-        void *dst = (void*)(node + 1);
-        list_node_init_with_key_and_size(node, key, size);
-        memcpy(dst, data, size);
+    mpp_list_node *node = NULL;
+
+    if (pool_free && size <= pool_node_size) {
+        node = pool_free;
+        pool_free = node->next;
     } else {
-        LIST_ERROR("failed to allocate list node");
+        node = (mpp_list_node*)malloc(sizeof(mpp_list_node) + size);
+        if (node)
+            heap_nodes++;
+        else
+            LIST_ERROR("failed to allocate list node");
     }
     return node;
 }
 
+void mpp_list::node_put(mpp_list_node *node)
+{
+    if (pool && (char *)node >= (char *)pool &&
+        (char *)node < (char *)pool + pool_stride * pool_count) {
+        node->next = pool_free;
+        pool_free = node;
+    } else {
+        free(node);
+    }
+}
+
+static void init_list(mpp_list_node *node, void *data, RK_S32 size, RK_U32 key)
+{
+    void *dst = (void*)(node + 1);
+    list_node_init_with_key_and_size(node, key, size);
+    memcpy(dst, data, size);
+}
+
 static inline void _mpp_list_add(mpp_list_node * _new, mpp_list_node * prev, mpp_list_node * next)
 {
     next->prev = _new;
@@ -84,8 +107,9 @@ RK_S32 mpp_list::add_at_head(void *data, RK_S32 size)
 {
     RK_S32 ret = -EINVAL;
     if (head) {
-        mpp_list_node *node = create_list(data, size, 0);
+        mpp_list_node *node = node_get(size);
         if (node) {
+            init_list(node, data, size, 0);
             mpp_list_add(node, head);
             count++;
             ret = 0;
@@ -100,8 +124,9 @@ RK_S32 mpp_list::add_at_tail(void *data, RK_S32 size)
 {
     RK_S32 ret = -EINVAL;
     if (head) {
-        mpp_list_node *node = create_list(data, size, 0);
+        mpp_list_node *node = node_get(size);
         if (node) {
+            init_list(node, data, size, 0);
             mpp_list_add_tail(node, head);
             count++;
             ret = 0;
@@ -112,7 +137,7 @@ RK_S32 mpp_list::add_at_tail(void *data, RK_S32 size)
     return ret;
 }
 
-static void release_list(mpp_list_node*node, void *data, RK_S32 size)
+static void release_list(mpp_list_node *node, void *data, RK_S32 size)
 {
     void *src = (void*)(node + 1);
     if (node->size == size) {
@@ -124,7 +149,6 @@ static void release_list(mpp_list_node*node, void *data, RK_S32 size)
         if (data)
             memcpy(data, src, size);
     }
-    free(node);
 }
 
 static inline void _mpp_list_del(mpp_list_node *prev, mpp_list_node *next)
@@ -149,7 +173,9 @@ RK_S32 mpp_list::del_at_head(void *data, RK_S32 size)
 {
     RK_S32 ret = -EINVAL;
     if (head && count) {
-        _list_del_node_no_lock(head->next, data, size);
+        mpp_list_node *node = head->next;
+        _list_del_node_no_lock(node, data, size);
+        node_put(node);
         count--;
         ret = 0;
     }
@@ -160,34 +186,30 @@ RK_S32 mpp_list::del_at_tail(void *data, RK_S32 size)
 {
     RK_S32 ret = -EINVAL;
     if (head && count) {
-        _list_del_node_no_lock(head->prev, data, size);
+        mpp_list_node *node = head->prev;
+        _list_del_node_no_lock(node, data, size);
+        node_put(node);
         count--;
         ret = 0;
     }
     return ret;
 }
 
-static mpp_list_node* create_list_with_size(void *data, RK_S32 size, RK_U32 key)
+static void init_list_with_size(mpp_list_node *node, void *data, RK_S32 size, RK_U32 key)
 {
-    mpp_list_node *node = (mpp_list_node*)malloc(sizeof(mpp_list_node) +
-                                                 sizeof(size) + size);
-    if (node) {
-        RK_S32 *dst = (RK_S32 *)(node + 1);
-        list_node_init_with_key_and_size(node, key, size);
-        *dst++ = size;
-        memcpy(dst, data, size);
-    } else {
-        LIST_ERROR("failed to allocate list node");
-    }
-    return node;
+    RK_S32 *dst = (RK_S32 *)(node + 1);
+    list_node_init_with_key_and_size(node, key, size);
+    *dst++ = size;
+    memcpy(dst, data, size);
 }
 
 RK_S32 mpp_list::fifo_wr(void *data, RK_S32 size)
 {
     RK_S32 ret = -EINVAL;
     if (head) {
-        mpp_list_node *node = create_list_with_size(data, size, 0);
+        mpp_list_node *node = node_get(sizeof(size) + size);
         if (node) {
+            init_list_with_size(node, data, size, 0);
             mpp_list_add_tail(node, head);
             count++;
             ret = 0;
@@ -207,8 +229,6 @@ static void release_list_with_size(mpp_list_node* node, void *data, RK_S32 *size
 
     if (data)
         memcpy(data, src, data_size);
-
-    free(node);
 }
 
 RK_S32 mpp_list::fifo_rd(void *data, RK_S32 *size)
@@ -219,6 +239,7 @@ RK_S32 mpp_list::fifo_rd(void *data, RK_S32 *size)
 
         mpp_list_del_init(node);
         release_list_with_size(node, data, size);
+        node_put(node);
         count--;
         ret = 0;
     }
@@ -237,14 +258,20 @@ RK_S32 mpp_list::list_size()
     return ret;
 }
 
+RK_S32 mpp_list::heap_count()
+{
+    return heap_nodes;
+}
+
 RK_S32 mpp_list::add_by_key(void *data, RK_S32 size, RK_U32 *key)
 {
     RK_S32 ret = 0;
     if (head) {
         RK_U32 list_key = get_key();
         *key = list_key;
-        mpp_list_node *node = create_list(data, size, list_key);
+        mpp_list_node *node = node_get(size);
         if (node) {
+            init_list(node, data, size, list_key);
             mpp_list_add_tail(node, head);
             count++;
             ret = 0;
@@ -264,6 +291,7 @@ RK_S32 mpp_list::del_by_key(void *data, RK_S32 size, RK_U32 key)
         while (tmp->next != head) {
             if (tmp->key == key) {
                 _list_del_node_no_lock(tmp, data, size);
+                node_put(tmp);
                 count--;
                 break;
             }
@@ -290,7 +318,7 @@ RK_S32 mpp_list::flush()
             if (destroy) {
                 destroy((void*)(node + 1));
             }
-            free(node);
+            node_put(node);
             count--;
         }
     }
@@ -341,7 +369,13 @@ void mpp_list::signal()
 mpp_list::mpp_list(node_destructor func)
     : destroy(NULL),
       head(NULL),
-      count(0)
+      count(0),
+      pool(NULL),
+      pool_free(NULL),
+      pool_node_size(0),
+      pool_stride(0),
+      pool_count(0),
+      heap_nodes(0)
 {
     destroy = func;
     head = (mpp_list_node*)malloc(sizeof(mpp_list_node));
@@ -352,11 +386,53 @@ mpp_list::mpp_list(node_destructor func)
     }
 }
 
+mpp_list::mpp_list(node_destructor func, RK_S32 node_size, RK_S32 capacity)
+    : destroy(NULL),
+      head(NULL),
+      count(0),
+      pool(NULL),
+      pool_free(NULL),
+      pool_node_size(0),
+      pool_stride(0),
+      pool_count(0),
+      heap_nodes(0)
+{
+    RK_S32 i;
+
+    destroy = func;
+    head = (mpp_list_node*)malloc(sizeof(mpp_list_node));
+    if (NULL == head) {
+        LIST_ERROR("failed to allocate list header");
+        return;
+    }
+    list_node_init_with_key_and_size(head, 0, 0);
+
+    // room for the size word of fifo_wr and pointer alignment of the next node
+    pool_node_size = (RK_S32)MPP_ALIGN(node_size + sizeof(RK_S32), sizeof(void *));
+    pool_stride = sizeof(mpp_list_node) + pool_node_size;
+    pool = (mpp_list_node*)malloc(pool_stride * capacity);
+    if (NULL == pool) {
+        LIST_ERROR("failed to allocate %d list nodes", capacity);
+        pool_node_size = 0;
+        return;
+    }
+
+    pool_count = capacity;
+    for (i = capacity - 1; i >= 0; i--) {
+        mpp_list_node *node = (mpp_list_node*)((char *)pool + pool_stride * i);
+        node->next = pool_free;
+        pool_free = node;
+    }
+}
+
 mpp_list::~mpp_list()
 {
     flush();
     if (head) free(head);
+    if (pool) free(pool);
     head = NULL;
+    pool = NULL;
+    pool_free = NULL;
     destroy = NULL;
 }
 
@@ -18,18 +18,72 @@
 
 #include <stdio.h>
 #include <stdarg.h>
+#include <stdint.h>
 #include <string.h>
+#include <pthread.h>
 
 #include "mpp_log.h"
+#include "mpp_env.h"
 #include "mpp_mem.h"
+#include "mpp_ring.h"
+#include "mpp_time.h"
 #include "mpp_common.h"
 
 #include "os_log.h"
 
 #define MPP_LOG_MAX_LEN     256
 
+/* async records buffered per logging thread */
+#define MPP_LOG_RING_SIZE   128
+/* call sites tracked for rate limit, more sites are not limited */
+#define MPP_LOG_SITE_COUNT  256
+#define MPP_LOG_SITE_PROBE  8
+
 typedef void (*mpp_log_callback)(const char*, const char*, va_list);
 
+typedef struct MppLogRecord_t {
+    RK_S64          time;
+    const char      *tag;
+    RK_U32          err;
+    char            msg[MPP_LOG_MAX_LEN + 1];
+} MppLogRecord;
+
+typedef struct MppLogRing_t {
+    MppRing         ring;
+    RK_U32          dead;
+    struct MppLogRing_t *next;
+} MppLogRing;
+
+typedef struct MppLogSite_t {
+    const char      *key;
+    RK_S64          window;
+    RK_U32          count;
+    RK_U32          suppressed;
+} MppLogSite;
+
+/* marks a thread that is registering its ring, its logs go out directly */
+#define MPP_LOG_RING_BUSY   ((MppLogRing *)1)
+
+static pthread_once_t log_once = PTHREAD_ONCE_INIT;
+static pthread_key_t log_key;
+static RK_U32 log_rate = 0;
+
+/* ring list, the lock is only taken on register and by the consumer */
+static pthread_mutex_t log_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t log_cond = PTHREAD_COND_INITIALIZER;
+static MppLogRing *log_rings = NULL;
+/* set by the drain thread before it sleeps, cleared by the first producer */
+static RK_U32 log_idle = 0;
+static pthread_t log_thread;
+static RK_U32 log_thread_on = 0;
+static RK_U32 log_thread_stop = 0;
+
+static MppLogSite log_sites[MPP_LOG_SITE_COUNT];
+
+static RK_U32 log_drop_full = 0;
+static RK_U32 log_drop_rate = 0;
+static RK_U32 log_report_full = 0;
+static RK_U32 log_report_rate = 0;
 
 #ifdef __cplusplus
 extern "C" {
@@ -38,13 +92,252 @@ extern "C" {
 RK_U32 mpp_debug = 0;
 static RK_U32 mpp_log_flag = 0;
 
-// TODO: add log timing information and switch flag
 static const char *msg_log_warning = "log message is long\n";
 static const char *msg_log_nothing = "\n";
 
-static void __mpp_log(mpp_log_callback func, const char *tag, const char *fmt,
+static void log_print(mpp_log_callback func, const char *tag, const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    func(tag, fmt, args);
+    va_end(args);
+}
+
+/* producer side, wake the drain thread only when it went to sleep */
+static void log_wake(void)
+{
+    // pairs with the fence in log_drain_thread, one of them sees the other
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&log_idle, __ATOMIC_RELAXED) &&
+        __atomic_exchange_n(&log_idle, 0, __ATOMIC_RELAXED)) {
+        pthread_mutex_lock(&log_lock);
+        pthread_cond_signal(&log_cond);
+        pthread_mutex_unlock(&log_lock);
+    }
+}
+
+static void log_ring_exit(void *arg)
+{
+    MppLogRing *ring = (MppLogRing *)arg;
+
+    // the drain thread frees the ring once it is empty
+    if (ring && ring != MPP_LOG_RING_BUSY) {
+        __atomic_store_n(&ring->dead, 1, __ATOMIC_RELEASE);
+        log_wake();
+    }
+}
+
+static void log_init(void)
+{
+    pthread_key_create(&log_key, log_ring_exit);
+    mpp_env_get_u32("mpp_log_flag", &mpp_log_flag, 0);
+    mpp_env_get_u32("mpp_log_rate", &log_rate, 0);
+}
+
+static void log_report(RK_U32 *reported, RK_U32 *counter, const char *reason)
+{
+    RK_U32 count = __atomic_load_n(counter, __ATOMIC_RELAXED);
+
+    if (count != *reported) {
+        log_print(os_err, MODULE_TAG, "%u messages dropped by %s\n",
+                  count - *reported, reason);
+        *reported = count;
+    }
+}
+
+/* consumer side of all rings, called with log_lock held */
+static RK_S32 log_drain_rings(void)
+{
+    MppLogRing **prev = &log_rings;
+    MppLogRecord rec;
+    RK_S32 count = 0;
+
+    while (*prev) {
+        MppLogRing *ring = *prev;
+        RK_U32 dead = __atomic_load_n(&ring->dead, __ATOMIC_ACQUIRE);
+
+        while (MPP_OK == mpp_ring_get(ring->ring, &rec)) {
+            log_print(rec.err ? os_err : os_log, rec.tag, "[%lld.%06lld] %s",
+                      rec.time / 1000000, rec.time % 1000000, rec.msg);
+            count++;
+        }
+
+        if (dead) {
+            *prev = ring->next;
+            mpp_ring_deinit(ring->ring);
+            free(ring);
+        } else {
+            prev = &ring->next;
+        }
+    }
+
+    log_report(&log_report_full, &log_drop_full, "full log ring");
+    log_report(&log_report_rate, &log_drop_rate, "rate limit");
+
+    return count;
+}
+
+static void *log_drain_thread(void *arg)
+{
+    (void)arg;
+
+    pthread_mutex_lock(&log_lock);
+    while (!log_thread_stop) {
+        if (log_drain_rings())
+            continue;
+
+        // announce the sleep then look once more for a racing producer
+        __atomic_store_n(&log_idle, 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (log_drain_rings())
+            continue;
+
+        while (__atomic_load_n(&log_idle, __ATOMIC_RELAXED) && !log_thread_stop)
+            pthread_cond_wait(&log_cond, &log_lock);
+    }
+    pthread_mutex_unlock(&log_lock);
+
+    return NULL;
+}
+
+static void log_drain_stop(void)
+{
+    if (log_thread_on) {
+        pthread_mutex_lock(&log_lock);
+        log_thread_stop = 1;
+        pthread_cond_signal(&log_cond);
+        pthread_mutex_unlock(&log_lock);
+        pthread_join(log_thread, NULL);
+        log_thread_on = 0;
+    }
+
+    pthread_mutex_lock(&log_lock);
+    log_drain_rings();
+    pthread_mutex_unlock(&log_lock);
+    fflush(stdout);
+}
+
+static MppLogRing *log_ring_get(void)
+{
+    MppLogRing *ring = (MppLogRing *)pthread_getspecific(log_key);
+
+    if (ring)
+        return (ring == MPP_LOG_RING_BUSY) ? NULL : ring;
+
+    // allocation below may log itself, send that out directly
+    pthread_setspecific(log_key, MPP_LOG_RING_BUSY);
+
+    ring = (MppLogRing *)calloc(1, sizeof(*ring));
+    if (ring && mpp_ring_init(&ring->ring, sizeof(MppLogRecord), MPP_LOG_RING_SIZE)) {
+        free(ring);
+        ring = NULL;
+    }
+
+    if (ring) {
+        pthread_mutex_lock(&log_lock);
+        ring->next = log_rings;
+        log_rings = ring;
+
+        if (!log_thread_on && !log_thread_stop &&
+            !pthread_create(&log_thread, NULL, log_drain_thread, NULL)) {
+            log_thread_on = 1;
+            atexit(log_drain_stop);
+        }
+        pthread_mutex_unlock(&log_lock);
+    }
+
+    pthread_setspecific(log_key, ring ? ring : MPP_LOG_RING_BUSY);
+    return ring;
+}
+
+static void log_async(RK_U32 err, const char *tag, const char *fmt, va_list args)
+{
+    MppLogRing *ring = log_ring_get();
+    MppLogRecord rec;
+
+    if (NULL == ring) {
+        (err ? os_err : os_log)(tag, fmt, args);
+        return;
+    }
+
+    rec.time = mpp_time();
+    rec.tag = tag;
+    rec.err = err;
+    vsnprintf(rec.msg, sizeof(rec.msg), fmt, args);
+
+    if (mpp_ring_put(ring->ring, &rec))
+        __atomic_fetch_add(&log_drop_full, 1, __ATOMIC_RELAXED);
+    else
+        log_wake();
+}
+
+static void log_async_log(const char *tag, const char *fmt, va_list args)
+{
+    log_async(0, tag, fmt, args);
+}
+
+static void log_async_err(const char *tag, const char *fmt, va_list args)
+{
+    log_async(1, tag, fmt, args);
+}
+
+/*
+ * Count messages per call site keyed by the format string in one second
+ * windows. Return 0 when the message should be dropped.
+ */
+static RK_U32 log_rate_check(mpp_log_callback func, const char *tag,
+                             const char *fmt)
+{
+    uintptr_t hash = ((uintptr_t)fmt >> 2) * 2654435761u;
+    MppLogSite *site = NULL;
+    RK_S64 now;
+    RK_S64 window;
+    RK_U32 i;
+
+    for (i = 0; i < MPP_LOG_SITE_PROBE; i++) {
+        MppLogSite *p = &log_sites[(hash + i) % MPP_LOG_SITE_COUNT];
+        const char *key = __atomic_load_n(&p->key, __ATOMIC_ACQUIRE);
+
+        if (NULL == key && __atomic_compare_exchange_n(&p->key, &key, fmt, 0,
+                                                       __ATOMIC_ACQ_REL,
+                                                       __ATOMIC_ACQUIRE))
+            key = fmt;
+
+        if (key == fmt) {
+            site = p;
+            break;
+        }
+    }
+
+    if (NULL == site)
+        return 1;
+
+    now = mpp_time() / 1000000;
+    window = __atomic_load_n(&site->window, __ATOMIC_RELAXED);
+    if (window != now &&
+        __atomic_compare_exchange_n(&site->window, &window, now, 0,
+                                    __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        RK_U32 suppressed = __atomic_exchange_n(&site->suppressed, 0,
+                                                __ATOMIC_RELAXED);
+
+        __atomic_store_n(&site->count, 0, __ATOMIC_RELAXED);
+        if (suppressed)
+            log_print(func, tag, "%u messages suppressed from here\n",
+                      suppressed);
+    }
+
+    if (__atomic_fetch_add(&site->count, 1, __ATOMIC_RELAXED) < log_rate)
+        return 1;
+
+    __atomic_fetch_add(&site->suppressed, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&log_drop_rate, 1, __ATOMIC_RELAXED);
+    return 0;
+}
+
+static void __mpp_log(RK_U32 err, const char *tag, const char *fmt,
                       const char *fname, va_list args)
 {
+    mpp_log_callback func = err ? os_err : os_log;
     char msg[MPP_LOG_MAX_LEN + 1];
     char *tmp = msg;
     const char *buf = fmt;
@@ -56,6 +349,14 @@ static void __mpp_log(mpp_log_callback func, const char *tag, const char *fmt,
     if (NULL == tag)
         tag = MODULE_TAG;
 
+    pthread_once(&log_once, log_init);
+
+    if (mpp_log_flag & MPP_LOG_FLAG_ASYNC)
+        func = err ? log_async_err : log_async_log;
+
+    if (log_rate && !log_rate_check(func, tag, fmt))
+        return;
+
     if (len_name) {
         buf = msg;
         buf_left -= snprintf(msg, buf_left, "%s ", fname);
@@ -83,7 +384,7 @@ void _mpp_log(const char *tag, const char *fmt, const char *fname, ...)
 {
     va_list args;
     va_start(args, fname);
-    __mpp_log(os_log, tag, fmt, fname, args);
+    __mpp_log(0, tag, fmt, fname, args);
     va_end(args);
 }
 
@@ -91,18 +392,31 @@ void _mpp_err(const char *tag, const char *fmt, const char *fname, ...)
 {
     va_list args;
     va_start(args, fname);
-    __mpp_log(os_err, tag, fmt, fname, args);
+    __mpp_log(1, tag, fmt, fname, args);
     va_end(args);
 }
 
 void mpp_log_set_flag(RK_U32 flag)
 {
+    RK_U32 old;
+
+    pthread_once(&log_once, log_init);
+
+    old = mpp_log_flag;
     mpp_log_flag = flag;
+
+    // let queued messages out before the following direct ones
+    if ((old & MPP_LOG_FLAG_ASYNC) && !(flag & MPP_LOG_FLAG_ASYNC)) {
+        pthread_mutex_lock(&log_lock);
+        log_drain_rings();
+        pthread_mutex_unlock(&log_lock);
+    }
     return ;
 }
 
 RK_U32 mpp_log_get_flag()
 {
+    pthread_once(&log_once, log_init);
     return mpp_log_flag;
 }
 
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2015 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_TAG "mpp_ring"
+
+#include <string.h>
+
+#include "mpp_log.h"
+#include "mpp_mem.h"
+#include "mpp_ring.h"
+
+#define RING_CACHE_LINE     64
+
+typedef struct MppRingImpl_t {
+    // written by producer only
+    RK_U32      wr;
+    RK_U8       pad0[RING_CACHE_LINE - sizeof(RK_U32)];
+    // written by consumer only
+    RK_U32      rd;
+    RK_U8       pad1[RING_CACHE_LINE - sizeof(RK_U32)];
+
+    RK_U32      mask;
+    RK_S32      elem_size;
+    RK_U8       *data;
+} MppRingImpl;
+
+MPP_RET mpp_ring_init(MppRing *ring, RK_S32 elem_size, RK_S32 capacity)
+{
+    MppRingImpl *p = NULL;
+    RK_U32 size = 1;
+
+    if (NULL == ring || elem_size <= 0 || capacity <= 0) {
+        mpp_err_f("invalid input ring %p elem_size %d capacity %d\n",
+                  ring, elem_size, capacity);
+        return MPP_ERR_NULL_PTR;
+    }
+
+    *ring = NULL;
+
+    while (size < (RK_U32)capacity)
+        size <<= 1;
+
+    p = mpp_calloc(MppRingImpl, 1);
+    if (p)
+        p->data = mpp_malloc(RK_U8, elem_size * size);
+    if (NULL == p || NULL == p->data) {
+        mpp_err_f("failed to malloc ring with %d x %d bytes\n", size, elem_size);
+        MPP_FREE(p);
+        return MPP_ERR_MALLOC;
+    }
+
+    p->mask = size - 1;
+    p->elem_size = elem_size;
+    *ring = p;
+    return MPP_OK;
+}
+
+MPP_RET mpp_ring_deinit(MppRing ring)
+{
+    MppRingImpl *p = (MppRingImpl *)ring;
+
+    if (NULL == p)
+        return MPP_ERR_NULL_PTR;
+
+    MPP_FREE(p->data);
+    mpp_free(p);
+    return MPP_OK;
+}
+
+MPP_RET mpp_ring_put(MppRing ring, const void *data)
+{
+    MppRingImpl *p = (MppRingImpl *)ring;
+    RK_U32 wr = p->wr;
+    RK_U32 rd = __atomic_load_n(&p->rd, __ATOMIC_ACQUIRE);
+
+    if (wr - rd > p->mask)
+        return MPP_ERR_BUFFER_FULL;
+
+    memcpy(p->data + (wr & p->mask) * p->elem_size, data, p->elem_size);
+    // publish the element before the index
+    __atomic_store_n(&p->wr, wr + 1, __ATOMIC_RELEASE);
+    return MPP_OK;
+}
+
+MPP_RET mpp_ring_get(MppRing ring, void *data)
+{
+    MppRingImpl *p = (MppRingImpl *)ring;
+    RK_U32 rd = p->rd;
+    RK_U32 wr = __atomic_load_n(&p->wr, __ATOMIC_ACQUIRE);
+
+    if (rd == wr)
+        return MPP_NOK;
+
+    memcpy(data, p->data + (rd & p->mask) * p->elem_size, p->elem_size);
+    // the slot may be reused by producer after this store
+    __atomic_store_n(&p->rd, rd + 1, __ATOMIC_RELEASE);
+    return MPP_OK;
+}
+
+RK_S32 mpp_ring_count(MppRing ring)
+{
+    MppRingImpl *p = (MppRingImpl *)ring;
+
+    return (RK_S32)(__atomic_load_n(&p->wr, __ATOMIC_ACQUIRE) -
+                    __atomic_load_n(&p->rd, __ATOMIC_ACQUIRE));
+}
@@ -0,0 +1,195 @@
+/*
+ * Copyright 2015 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_TAG "mpp_list_test"
+
+#include <stdlib.h>
+
+#include "mpp_log.h"
+#include "mpp_list.h"
+#include "mpp_ring.h"
+#include "mpp_time.h"
+#include "mpp_common.h"
+
+#define LIST_TEST_LOOPS     (1000 * 1000)
+#define LIST_TEST_DEPTH     4
+#define RING_TEST_ITEMS     (1000 * 1000)
+
+static RK_S32 destroyed = 0;
+
+static void *count_destroy(void *)
+{
+    destroyed++;
+    return NULL;
+}
+
+/* order is kept across pooled and spilled nodes and pool nodes come back */
+static MPP_RET check_pool(void)
+{
+    mpp_list list(count_destroy, sizeof(void *), LIST_TEST_DEPTH);
+    RK_S32 i;
+
+    for (i = 0; i < LIST_TEST_DEPTH * 2; i++) {
+        void *p = (void *)(intptr_t)i;
+        list.add_at_tail(&p, sizeof(p));
+    }
+
+    if (list.heap_count() != LIST_TEST_DEPTH) {
+        mpp_err("expect %d heap nodes got %d\n", LIST_TEST_DEPTH, list.heap_count());
+        return MPP_NOK;
+    }
+
+    for (i = 0; i < LIST_TEST_DEPTH * 2; i++) {
+        void *p = NULL;
+        list.del_at_head(&p, sizeof(p));
+        if ((intptr_t)p != i) {
+            mpp_err("pop %d got %d\n", i, (RK_S32)(intptr_t)p);
+            return MPP_NOK;
+        }
+    }
+
+    // fifo_wr stores a size word in the node as well
+    for (i = 0; i < LIST_TEST_DEPTH; i++) {
+        RK_S64 v = i;
+        list.fifo_wr(&v, sizeof(v));
+    }
+    for (i = 0; i < LIST_TEST_DEPTH; i++) {
+        RK_S64 v = -1;
+        RK_S32 size = 0;
+        list.fifo_rd(&v, &size);
+        if (v != i || size != sizeof(v)) {
+            mpp_err("fifo_rd %d got %lld size %d\n", i, v, size);
+            return MPP_NOK;
+        }
+    }
+
+    for (i = 0; i < LIST_TEST_DEPTH; i++) {
+        void *p = NULL;
+        list.add_at_tail(&p, sizeof(p));
+    }
+    list.flush();
+
+    if (list.heap_count() != LIST_TEST_DEPTH || destroyed != LIST_TEST_DEPTH) {
+        mpp_err("pool not reused heap %d destroyed %d\n", list.heap_count(), destroyed);
+        return MPP_NOK;
+    }
+
+    return MPP_OK;
+}
+
+/* the way Mpp moves packets: lock, queue a pointer, dequeue it later */
+static void bench_list(const char *name, mpp_list *list)
+{
+    RK_S64 time = mpp_time();
+    RK_S32 i, j;
+
+    for (i = 0; i < LIST_TEST_LOOPS / LIST_TEST_DEPTH; i++) {
+        for (j = 0; j < LIST_TEST_DEPTH; j++) {
+            void *p = list;
+            AutoMutex auto_lock(list->mutex());
+            list->add_at_tail(&p, sizeof(p));
+        }
+        for (j = 0; j < LIST_TEST_DEPTH; j++) {
+            void *p = NULL;
+            AutoMutex auto_lock(list->mutex());
+            list->del_at_head(&p, sizeof(p));
+        }
+    }
+    time = mpp_time() - time;
+
+    mpp_log("%-8s %6.2f Mops/s %.3f heap alloc per op\n", name,
+            (double)LIST_TEST_LOOPS / MPP_MAX(time, 1),
+            (double)list->heap_count() / LIST_TEST_LOOPS);
+}
+
+static void *ring_producer(void *arg)
+{
+    MppRing ring = (MppRing)arg;
+    RK_U32 i;
+
+    for (i = 0; i < RING_TEST_ITEMS; i++) {
+        while (mpp_ring_put(ring, &i))
+            sched_yield();
+    }
+    return NULL;
+}
+
+/* one thread puts a sequence, this one checks it comes out in order */
+static MPP_RET check_ring(void)
+{
+    MppRing ring = NULL;
+    MPP_RET ret = MPP_OK;
+    pthread_t thd;
+    RK_S64 time;
+    RK_U32 i;
+
+    if (mpp_ring_init(&ring, sizeof(RK_U32), 64))
+        return MPP_NOK;
+
+    time = mpp_time();
+    pthread_create(&thd, NULL, ring_producer, ring);
+    for (i = 0; i < RING_TEST_ITEMS; i++) {
+        RK_U32 v;
+
+        while (mpp_ring_get(ring, &v))
+            sched_yield();
+
+        if (v != i) {
+            mpp_err("ring get %u expect %u\n", v, i);
+            ret = MPP_NOK;
+            break;
+        }
+    }
+    pthread_join(thd, NULL);
+    time = mpp_time() - time;
+
+    if (!ret)
+        mpp_log("%-8s %6.2f Mops/s across two threads\n", "ring",
+                (double)RING_TEST_ITEMS / MPP_MAX(time, 1));
+
+    mpp_ring_deinit(ring);
+    return ret;
+}
+
+int main()
+{
+    MPP_RET ret = MPP_NOK;
+
+    mpp_log("mpp_list_test start\n");
+
+    if (check_pool())
+        goto TEST_FAILED;
+
+    {
+        mpp_list heap(NULL);
+        mpp_list pool(NULL, sizeof(void *), LIST_TEST_DEPTH);
+
+        bench_list("heap", &heap);
+        bench_list("pool", &pool);
+    }
+
+    if (check_ring())
+        goto TEST_FAILED;
+
+    ret = MPP_OK;
+TEST_FAILED:
+    if (ret)
+        mpp_log("mpp_list_test failed\n");
+    else
+        mpp_log("mpp_list_test success\n");
+
+    return ret;
+}
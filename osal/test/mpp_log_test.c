@@ -16,10 +16,50 @@
 
 #define MODULE_TAG "mpp_log_test"
 
+#include <pthread.h>
+
 #include "mpp_log.h"
+#include "mpp_time.h"
+
+#define LOG_THREADS     4
+#define LOG_LINES       500
+
+static void *log_loop(void *arg)
+{
+    RK_S32 idx = (RK_S32)(intptr_t)arg;
+    RK_S32 i;
+
+    for (i = 0; i < LOG_LINES; i++)
+        mpp_log("thread %d line %d\n", idx, i);
+
+    return NULL;
+}
+
+/* time spent in the logging threads, async flag is cleared to flush */
+static RK_S64 log_burst(RK_U32 flag)
+{
+    pthread_t threads[LOG_THREADS];
+    RK_S64 time;
+    RK_S32 i;
+
+    mpp_log_set_flag(flag);
+
+    time = mpp_time();
+    for (i = 0; i < LOG_THREADS; i++)
+        pthread_create(&threads[i], NULL, log_loop, (void *)(intptr_t)i);
+    for (i = 0; i < LOG_THREADS; i++)
+        pthread_join(threads[i], NULL);
+    time = mpp_time() - time;
+
+    mpp_log_set_flag(0);
+
+    return time;
+}
 
 int main()
 {
+    RK_S64 time_sync;
+    RK_S64 time_async;
     RK_U32 flag_dbg = 0x02;
     RK_U32 flag_set = 0xffff;
     RK_U32 flag_get = 0;
@@ -48,6 +88,14 @@ int main()
     mpp_log("try _mpp_dbg test 0 debug %x, flag %x", flag_get, flag_dbg);
     _mpp_dbg(flag_get, flag_dbg, "mpp_dbg printing debug %x, flag %x", flag_get, flag_dbg);
 
+    time_sync = log_burst(0);
+    time_async = log_burst(MPP_LOG_FLAG_ASYNC);
+
+    mpp_log("%d lines from %d threads: direct %lld us async %lld us\n",
+            LOG_THREADS * LOG_LINES, LOG_THREADS, time_sync, time_async);
+
+    // back to async, exit has to flush the rest
+    mpp_log_set_flag(MPP_LOG_FLAG_ASYNC);
     mpp_err("mpp log log test done\n");
 
     return 0;
@@ -55,6 +55,10 @@ typedef struct {
     FILE            *fp_input;
     FILE            *fp_output;
     FILE            *fp_config;
+    FILE            *fp_crc;
+    FILE            *fp_golden;
+    CrcType         crc_type;
+    RK_U32          crc_mismatch;
     RK_S32          frame_count;
     RK_S32          frame_num;
     size_t          max_usage;
@@ -64,6 +68,8 @@ typedef struct {
     char            file_input[MAX_FILE_NAME_LENGTH];
     char            file_output[MAX_FILE_NAME_LENGTH];
     char            file_config[MAX_FILE_NAME_LENGTH];
+    char            file_crc[MAX_FILE_NAME_LENGTH];
+    char            file_golden[MAX_FILE_NAME_LENGTH];
     MppCodingType   type;
     MppFrameFormat  format;
     RK_U32          width;
@@ -73,6 +79,9 @@ typedef struct {
     RK_U32          have_input;
     RK_U32          have_output;
     RK_U32          have_config;
+    RK_U32          have_crc;
+    RK_U32          have_golden;
+    CrcType         crc_type;
 
     RK_U32          simple;
     RK_S32          timeout;
@@ -94,8 +103,38 @@ static OptionInfo mpi_dec_cmd[] = {
     {"d",               "debug",                "debug flag"},
     {"x",               "timeout",              "output timeout interval"},
     {"n",               "frame_number",         "max output frame number"},
+    {"k",               "checksum_file",        "write frame checksums to file"},
+    {"g",               "golden_file",          "compare frame checksums with golden file"},
+    {"e",               "checksum_type",        "0 - byte sum and xor, 1 - crc32c"},
 };
 
+/* write the checksum of each output frame and compare it with the golden one */
+static void check_frm_crc(MpiDecLoopData *data, MppFrame frame)
+{
+    FrmCrc crc;
+    FrmCrc golden;
+
+    if ((NULL == data->fp_crc && NULL == data->fp_golden) ||
+        NULL == mpp_frame_get_buffer(frame))
+        return;
+
+    calc_frm_crc(frame, &crc, data->crc_type);
+    write_frm_crc(data->fp_crc, &crc);
+
+    if (data->fp_golden) {
+        memset(&golden, 0, sizeof(golden));
+        read_frm_crc(data->fp_golden, &golden);
+        if (memcmp(&crc, &golden, sizeof(crc))) {
+            if (!data->crc_mismatch)
+                mpp_err("frame %d checksum %08x %08x %08x %08x golden %08x %08x %08x %08x\n",
+                        data->frame_count, crc.luma.sum, crc.luma.vor,
+                        crc.chroma.sum, crc.chroma.vor, golden.luma.sum,
+                        golden.luma.vor, golden.chroma.sum, golden.chroma.vor);
+            data->crc_mismatch++;
+        }
+    }
+}
+
 static int decode_simple(MpiDecLoopData *data)
 {
     RK_U32 pkt_done = 0;
@@ -324,6 +363,8 @@ static int decode_simple(MpiDecLoopData *data)
                     mpp_log("decode_get_frame get frame %d\n", data->frame_count);
                     if (data->fp_output && !err_info)
                         dump_mpp_frame_to_file(frame, data->fp_output);
+                    if (!err_info)
+                        check_frm_crc(data, frame);
                 }
                 frm_eos = mpp_frame_get_eos(frame);
                 mpp_frame_deinit(&frame);
@@ -451,9 +492,14 @@ static int decode_advanced(MpiDecLoopData *data)
         //mpp_assert(packet_out == packet);
 
         if (frame) {
+            RK_U32 err_info = mpp_frame_get_errinfo(frame) |
+                              mpp_frame_get_discard(frame);
+
             /* write frame to file here */
             if (data->fp_output)
                 dump_mpp_frame_to_file(frame, data->fp_output);
+            if (!err_info)
+                check_frm_crc(data, frame);
 
             data->frame_count++;
             mpp_log("decoded frame %d\n", data->frame_count);
@@ -526,6 +572,23 @@ int mpi_dec_test_decode(MpiDecTestCmd *cmd)
         }
     }
 
+    if (cmd->have_crc) {
+        data.fp_crc = fopen(cmd->file_crc, "w");
+        if (NULL == data.fp_crc) {
+            mpp_err("failed to open checksum file %s\n", cmd->file_crc);
+            goto MPP_TEST_OUT;
+        }
+    }
+
+    if (cmd->have_golden) {
+        data.fp_golden = fopen(cmd->file_golden, "r");
+        if (NULL == data.fp_golden) {
+            mpp_err("failed to open golden file %s\n", cmd->file_golden);
+            goto MPP_TEST_OUT;
+        }
+    }
+    data.crc_type = cmd->crc_type;
+
     if (cmd->have_config) {
         data.fp_config = fopen(cmd->file_config, "r");
         if (NULL == data.fp_config) {
@@ -667,6 +730,17 @@ int mpi_dec_test_decode(MpiDecTestCmd *cmd)
         goto MPP_TEST_OUT;
     }
 
+    if (data.fp_golden) {
+        // golden frames left over are missing in the output
+        if (fgetc(data.fp_golden) != EOF)
+            data.crc_mismatch++;
+        if (data.crc_mismatch) {
+            mpp_err("%d of %d frames differ from golden file %s\n",
+                    data.crc_mismatch, data.frame_count, cmd->file_golden);
+            ret = MPP_NOK;
+        }
+    }
+
 MPP_TEST_OUT:
     if (packet) {
         mpp_packet_deinit(&packet);
@@ -720,6 +794,16 @@ MPP_TEST_OUT:
         data.fp_input = NULL;
     }
 
+    if (data.fp_crc) {
+        fclose(data.fp_crc);
+        data.fp_crc = NULL;
+    }
+
+    if (data.fp_golden) {
+        fclose(data.fp_golden);
+        data.fp_golden = NULL;
+    }
+
     return ret;
 }
 
@@ -794,6 +878,33 @@ static RK_S32 mpi_dec_test_parse_options(int argc, char **argv, MpiDecTestCmd* c
                     goto PARSE_OPINIONS_OUT;
                 }
                 break;
+            case 'k':
+                if (next) {
+                    strncpy(cmd->file_crc, next, MAX_FILE_NAME_LENGTH - 1);
+                    cmd->have_crc = 1;
+                } else {
+                    mpp_err("checksum file is invalid\n");
+                    goto PARSE_OPINIONS_OUT;
+                }
+                break;
+            case 'g':
+                if (next) {
+                    strncpy(cmd->file_golden, next, MAX_FILE_NAME_LENGTH - 1);
+                    cmd->have_golden = 1;
+                } else {
+                    mpp_err("golden file is invalid\n");
+                    goto PARSE_OPINIONS_OUT;
+                }
+                break;
+            case 'e':
+                if (next)
+                    cmd->crc_type = (CrcType)atoi(next);
+
+                if (!next || cmd->crc_type >= CRC_TYPE_BUTT) {
+                    mpp_err("invalid checksum type\n");
+                    goto PARSE_OPINIONS_OUT;
+                }
+                break;
             case 'd':
                 if (next) {
                     cmd->debug = atoi(next);;
@@ -900,6 +1011,7 @@ int main(int argc, char **argv)
     memset((void*)cmd, 0, sizeof(*cmd));
     cmd->format = MPP_FMT_BUTT;
     cmd->pkt_size = MPI_DEC_STREAM_SIZE;
+    cmd->crc_type = CRC_TYPE_CRC32C;
 
     // parse the cmd option
     ret = mpi_dec_test_parse_options(argc, argv, cmd);
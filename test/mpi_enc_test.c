@@ -32,19 +32,26 @@
 #include "utils.h"
 
 #define MAX_FILE_NAME_LENGTH        256
+#define MAX_ASYNC_DEPTH             16
 
 typedef struct {
     char            file_input[MAX_FILE_NAME_LENGTH];
     char            file_output[MAX_FILE_NAME_LENGTH];
+    char            file_crc[MAX_FILE_NAME_LENGTH];
+    char            file_golden[MAX_FILE_NAME_LENGTH];
     MppCodingType   type;
     RK_U32          width;
     RK_U32          height;
     MppFrameFormat  format;
     RK_U32          debug;
     RK_U32          num_frames;
+    RK_U32          async;
 
     RK_U32          have_input;
     RK_U32          have_output;
+    RK_U32          have_crc;
+    RK_U32          have_golden;
+    CrcType         crc_type;
 } MpiEncTestCmd;
 
 typedef struct {
@@ -58,6 +65,13 @@ typedef struct {
     FILE *fp_input;
     FILE *fp_output;
 
+    // packet checksums written and compared with golden ones
+    FILE *fp_crc;
+    FILE *fp_golden;
+    CrcType crc_type;
+    RK_U32 crc_count;
+    RK_U32 crc_mismatch;
+
     // base flow context
     MppCtx ctx;
     MppApi *mpi;
@@ -69,6 +83,13 @@ typedef struct {
     MppBuffer frm_buf;
     MppEncSeiMode sei_mode;
 
+    RK_U32 frm_put;
+
+    // asynchronous encoding keeps async frames in flight
+    RK_U32 async;
+    MppBuffer frm_bufs[MAX_ASYNC_DEPTH + 1];
+    RK_U32 frm_busy[MAX_ASYNC_DEPTH + 1];
+
     // paramter for resource malloc
     RK_U32 width;
     RK_U32 height;
@@ -98,6 +119,10 @@ static OptionInfo mpi_enc_cmd[] = {
     {"t",               "type",                 "output stream coding type"},
     {"n",               "max frame number",     "max encoding frame number"},
     {"d",               "debug",                "debug flag"},
+    {"a",               "async depth",          "frames in flight for asynchronous put_frame"},
+    {"k",               "checksum_file",        "write packet checksums to file"},
+    {"g",               "golden_file",          "compare packet checksums with golden file"},
+    {"e",               "checksum_type",        "0 - byte sum and xor, 1 - crc32c"},
 };
 
 MPP_RET test_ctx_init(MpiEncTestData **data, MpiEncTestCmd *cmd)
@@ -127,6 +152,7 @@ MPP_RET test_ctx_init(MpiEncTestData **data, MpiEncTestCmd *cmd)
     if (cmd->type == MPP_VIDEO_CodingMJPEG)
         cmd->num_frames = 1;
     p->num_frames   = cmd->num_frames;
+    p->async        = MPP_MIN(cmd->async, MAX_ASYNC_DEPTH);
 
     if (cmd->have_input) {
         p->fp_input = fopen(cmd->file_input, "rb");
@@ -144,6 +170,23 @@ MPP_RET test_ctx_init(MpiEncTestData **data, MpiEncTestCmd *cmd)
         }
     }
 
+    if (cmd->have_crc) {
+        p->fp_crc = fopen(cmd->file_crc, "w");
+        if (NULL == p->fp_crc) {
+            mpp_err("failed to open checksum file %s\n", cmd->file_crc);
+            ret = MPP_ERR_OPEN_FILE;
+        }
+    }
+
+    if (cmd->have_golden) {
+        p->fp_golden = fopen(cmd->file_golden, "r");
+        if (NULL == p->fp_golden) {
+            mpp_err("failed to open golden file %s\n", cmd->file_golden);
+            ret = MPP_ERR_OPEN_FILE;
+        }
+    }
+    p->crc_type = cmd->crc_type;
+
     // update resource parameter
     if (p->fmt <= MPP_FMT_YUV420SP_VU)
         p->frame_size = p->hor_stride * p->ver_stride * 3 / 2;
@@ -179,6 +222,14 @@ MPP_RET test_ctx_deinit(MpiEncTestData **data)
             fclose(p->fp_output);
             p->fp_output = NULL;
         }
+        if (p->fp_crc) {
+            fclose(p->fp_crc);
+            p->fp_crc = NULL;
+        }
+        if (p->fp_golden) {
+            fclose(p->fp_golden);
+            p->fp_golden = NULL;
+        }
         MPP_FREE(p);
         *data = NULL;
     }
@@ -324,6 +375,169 @@ RET:
     return ret;
 }
 
+static MPP_RET test_frame_prepare(MpiEncTestData *p, MppBuffer frm_buf,
+                                  MppFrame *frame)
+{
+    void *buf = mpp_buffer_get_ptr(frm_buf);
+    MPP_RET ret = MPP_OK;
+
+    if (p->fp_input) {
+        ret = read_image(buf, p->fp_input, p->width, p->height,
+                         p->hor_stride, p->ver_stride, p->fmt);
+        if (ret == MPP_NOK || feof(p->fp_input)) {
+            mpp_log("found last frame. feof %d\n", feof(p->fp_input));
+            p->frm_eos = 1;
+        } else if (ret == MPP_ERR_VALUE)
+            return ret;
+    } else {
+        ret = fill_image(buf, p->width, p->height, p->hor_stride,
+                         p->ver_stride, p->fmt, p->frm_put);
+        if (ret)
+            return ret;
+    }
+
+    ret = mpp_frame_init(frame);
+    if (ret) {
+        mpp_err_f("mpp_frame_init failed\n");
+        return ret;
+    }
+
+    mpp_frame_set_width(*frame, p->width);
+    mpp_frame_set_height(*frame, p->height);
+    mpp_frame_set_hor_stride(*frame, p->hor_stride);
+    mpp_frame_set_ver_stride(*frame, p->ver_stride);
+    mpp_frame_set_fmt(*frame, p->fmt);
+    mpp_frame_set_eos(*frame, p->frm_eos);
+
+    if (p->fp_input && feof(p->fp_input))
+        mpp_frame_set_buffer(*frame, NULL);
+    else
+        mpp_frame_set_buffer(*frame, frm_buf);
+
+    return MPP_OK;
+}
+
+/* empty packets of delayed frames depend on timing and are skipped */
+static void test_packet_crc(MpiEncTestData *p, RK_U8 *ptr, size_t len)
+{
+    DataCrc crc;
+    DataCrc golden;
+
+    if ((NULL == p->fp_crc && NULL == p->fp_golden) || !len)
+        return;
+
+    calc_data_crc(ptr, len, &crc, p->crc_type);
+    write_data_crc(p->fp_crc, &crc);
+
+    if (p->fp_golden) {
+        memset(&golden, 0, sizeof(golden));
+        read_data_crc(p->fp_golden, &golden);
+        if (memcmp(&crc, &golden, sizeof(crc))) {
+            if (!p->crc_mismatch)
+                mpp_err("packet %d checksum %d %08x %08x golden %d %08x %08x\n",
+                        p->crc_count, crc.len, crc.sum, crc.vor,
+                        golden.len, golden.sum, golden.vor);
+            p->crc_mismatch++;
+        }
+    }
+    p->crc_count++;
+}
+
+static void test_packet_write(MpiEncTestData *p, MppPacket packet)
+{
+    // write packet to file here
+    void *ptr   = mpp_packet_get_pos(packet);
+    size_t len  = mpp_packet_get_length(packet);
+
+    p->pkt_eos = mpp_packet_get_eos(packet);
+
+    if (p->fp_output)
+        fwrite(ptr, 1, len, p->fp_output);
+    test_packet_crc(p, ptr, len);
+    mpp_packet_deinit(&packet);
+
+    mpp_log_f("encoded frame %d size %d\n", p->frame_count, len);
+    p->stream_size += len;
+    p->frame_count++;
+
+    if (p->pkt_eos) {
+        mpp_log("found last packet\n");
+        mpp_assert(p->frm_eos);
+    }
+}
+
+/* called by encoder thread once the input frame has been encoded */
+static void test_frame_release(void *arg, MppFrame frame)
+{
+    RK_U32 *busy = (RK_U32 *)arg;
+
+    (void)frame;
+    __atomic_store_n(busy, 0, __ATOMIC_RELEASE);
+}
+
+/*
+ * Keep up to async frames in the encoder and only wait for a packet when
+ * the pipeline is full, so that reading input overlaps with encoding.
+ */
+static MPP_RET test_mpp_run_async(MpiEncTestData *p)
+{
+    MppApi *mpi = p->mpi;
+    MppCtx ctx = p->ctx;
+    RK_U32 count = p->async + 1;
+    MPP_RET ret = MPP_OK;
+
+    while (!p->pkt_eos) {
+        if (!p->frm_eos) {
+            RK_U32 idx = p->frm_put % count;
+            MppFrame frame = NULL;
+
+            // at most async frames are in flight so the next buffer is free
+            if (__atomic_load_n(&p->frm_busy[idx], __ATOMIC_ACQUIRE)) {
+                mpp_err("input buffer %d is still used by encoder\n", idx);
+                return MPP_NOK;
+            }
+
+            ret = test_frame_prepare(p, p->frm_bufs[idx], &frame);
+            if (ret)
+                return ret;
+
+            // stop on the frame limit with eos to drain frames in flight
+            if (p->num_frames && p->frm_put + 1 >= p->num_frames) {
+                p->frm_eos = 1;
+                mpp_frame_set_eos(frame, 1);
+            }
+
+            p->frm_busy[idx] = 1;
+            mpp_frame_set_release(frame, test_frame_release, &p->frm_busy[idx]);
+
+            ret = mpi->encode_put_frame(ctx, frame);
+            if (ret) {
+                mpp_err("mpp encode put frame failed\n");
+                return ret;
+            }
+            p->frm_put++;
+        }
+
+        // each frame gives one packet, hal with delay adds more on eos
+        while (!p->pkt_eos &&
+               (p->frm_eos || p->frm_put - p->frame_count >= p->async)) {
+            MppPacket packet = NULL;
+
+            ret = mpi->encode_get_packet(ctx, &packet);
+            if (ret) {
+                mpp_err("mpp encode get packet failed\n");
+                return ret;
+            }
+
+            mpp_assert(packet);
+            if (packet)
+                test_packet_write(p, packet);
+        }
+    }
+
+    return ret;
+}
+
 MPP_RET test_mpp_run(MpiEncTestData *p)
 {
     MPP_RET ret;
@@ -356,49 +570,23 @@ MPP_RET test_mpp_run(MpiEncTestData *p)
         }
     }
 
+    if (p->async)
+        return test_mpp_run_async(p);
+
     while (!p->pkt_eos) {
         MppFrame frame = NULL;
         MppPacket packet = NULL;
-        void *buf = mpp_buffer_get_ptr(p->frm_buf);
 
-        if (p->fp_input) {
-            ret = read_image(buf, p->fp_input, p->width, p->height,
-                             p->hor_stride, p->ver_stride, p->fmt);
-            if (ret == MPP_NOK || feof(p->fp_input)) {
-                mpp_log("found last frame. feof %d\n", feof(p->fp_input));
-                p->frm_eos = 1;
-            } else if (ret == MPP_ERR_VALUE)
-                goto RET;
-        } else {
-            ret = fill_image(buf, p->width, p->height, p->hor_stride,
-                             p->ver_stride, p->fmt, p->frame_count);
-            if (ret)
-                goto RET;
-        }
-
-        ret = mpp_frame_init(&frame);
-        if (ret) {
-            mpp_err_f("mpp_frame_init failed\n");
+        ret = test_frame_prepare(p, p->frm_buf, &frame);
+        if (ret)
             goto RET;
-        }
-
-        mpp_frame_set_width(frame, p->width);
-        mpp_frame_set_height(frame, p->height);
-        mpp_frame_set_hor_stride(frame, p->hor_stride);
-        mpp_frame_set_ver_stride(frame, p->ver_stride);
-        mpp_frame_set_fmt(frame, p->fmt);
-        mpp_frame_set_eos(frame, p->frm_eos);
-
-        if (p->fp_input && feof(p->fp_input))
-            mpp_frame_set_buffer(frame, NULL);
-        else
-            mpp_frame_set_buffer(frame, p->frm_buf);
 
         ret = mpi->encode_put_frame(ctx, frame);
         if (ret) {
             mpp_err("mpp encode put frame failed\n");
             goto RET;
         }
+        p->frm_put++;
 
         ret = mpi->encode_get_packet(ctx, &packet);
         if (ret) {
@@ -408,26 +596,8 @@ MPP_RET test_mpp_run(MpiEncTestData *p)
 
         mpp_assert(packet);
 
-        if (packet) {
-            // write packet to file here
-            void *ptr   = mpp_packet_get_pos(packet);
-            size_t len  = mpp_packet_get_length(packet);
-
-            p->pkt_eos = mpp_packet_get_eos(packet);
-
-            if (p->fp_output)
-                fwrite(ptr, 1, len, p->fp_output);
-            mpp_packet_deinit(&packet);
-
-            mpp_log_f("encoded frame %d size %d\n", p->frame_count, len);
-            p->stream_size += len;
-            p->frame_count++;
-
-            if (p->pkt_eos) {
-                mpp_log("found last packet\n");
-                mpp_assert(p->frm_eos);
-            }
-        }
+        if (packet)
+            test_packet_write(p, packet);
 
         if (p->num_frames && p->frame_count >= p->num_frames) {
             mpp_log_f("encode max %d frames", p->frame_count);
@@ -461,6 +631,19 @@ int mpi_enc_test(MpiEncTestCmd *cmd)
         goto MPP_TEST_OUT;
     }
 
+    if (p->async) {
+        RK_U32 i;
+
+        p->frm_bufs[0] = p->frm_buf;
+        for (i = 1; i <= p->async; i++) {
+            ret = mpp_buffer_get(NULL, &p->frm_bufs[i], p->frame_size);
+            if (ret) {
+                mpp_err_f("failed to get buffer for input frame ret %d\n", ret);
+                goto MPP_TEST_OUT;
+            }
+        }
+    }
+
     mpp_log("mpi_enc_test encoder test start w %d h %d type %d\n",
             p->width, p->height, p->type);
 
@@ -477,6 +660,14 @@ int mpi_enc_test(MpiEncTestCmd *cmd)
         goto MPP_TEST_OUT;
     }
 
+    if (p->async) {
+        ret = p->mpi->control(p->ctx, MPP_SET_INPUT_DEPTH, &p->async);
+        if (MPP_OK != ret) {
+            mpp_err("mpi control set input depth %d ret %d\n", p->async, ret);
+            goto MPP_TEST_OUT;
+        }
+    }
+
     ret = mpp_init(p->ctx, MPP_CTX_ENC, p->type);
     if (ret) {
         mpp_err("mpp_init failed ret %d\n", ret);
@@ -501,6 +692,17 @@ int mpi_enc_test(MpiEncTestCmd *cmd)
         goto MPP_TEST_OUT;
     }
 
+    if (p->fp_golden) {
+        // golden packets left over are missing in the output
+        if (fgetc(p->fp_golden) != EOF)
+            p->crc_mismatch++;
+        if (p->crc_mismatch) {
+            mpp_err("%d of %d packets differ from golden file %s\n",
+                    p->crc_mismatch, p->crc_count, cmd->file_golden);
+            ret = MPP_NOK;
+        }
+    }
+
 MPP_TEST_OUT:
     if (p->ctx) {
         mpp_destroy(p->ctx);
@@ -512,6 +714,17 @@ MPP_TEST_OUT:
         p->frm_buf = NULL;
     }
 
+    if (p->async) {
+        RK_U32 i;
+
+        for (i = 1; i <= p->async; i++) {
+            if (p->frm_bufs[i]) {
+                mpp_buffer_put(p->frm_bufs[i]);
+                p->frm_bufs[i] = NULL;
+            }
+        }
+    }
+
     if (MPP_OK == ret)
         mpp_log("mpi_enc_test success total frame %d bps %lld\n",
                 p->frame_count, (RK_U64)((p->stream_size * 8 * p->fps) / p->frame_count));
@@ -642,6 +855,41 @@ static RK_S32 mpi_enc_test_parse_options(int argc, char **argv, MpiEncTestCmd* c
                     goto PARSE_OPINIONS_OUT;
                 }
                 break;
+            case 'a':
+                if (next) {
+                    cmd->async = atoi(next);
+                } else {
+                    mpp_err("invalid async depth\n");
+                    goto PARSE_OPINIONS_OUT;
+                }
+                break;
+            case 'k':
+                if (next) {
+                    strncpy(cmd->file_crc, next, MAX_FILE_NAME_LENGTH - 1);
+                    cmd->have_crc = 1;
+                } else {
+                    mpp_err("checksum file is invalid\n");
+                    goto PARSE_OPINIONS_OUT;
+                }
+                break;
+            case 'g':
+                if (next) {
+                    strncpy(cmd->file_golden, next, MAX_FILE_NAME_LENGTH - 1);
+                    cmd->have_golden = 1;
+                } else {
+                    mpp_err("golden file is invalid\n");
+                    goto PARSE_OPINIONS_OUT;
+                }
+                break;
+            case 'e':
+                if (next)
+                    cmd->crc_type = (CrcType)atoi(next);
+
+                if (!next || cmd->crc_type >= CRC_TYPE_BUTT) {
+                    mpp_err("invalid checksum type\n");
+                    goto PARSE_OPINIONS_OUT;
+                }
+                break;
             default:
                 mpp_err("skip invalid opt %c\n", *opt);
                 break;
@@ -667,6 +915,7 @@ static void mpi_enc_test_show_options(MpiEncTestCmd* cmd)
     mpp_log("format     : %d\n", cmd->format);
     mpp_log("type       : %d\n", cmd->type);
     mpp_log("debug flag : %x\n", cmd->debug);
+    mpp_log("async depth: %d\n", cmd->async);
 }
 
 int main(int argc, char **argv)
@@ -676,6 +925,7 @@ int main(int argc, char **argv)
     MpiEncTestCmd* cmd = &cmd_ctx;
 
     memset((void*)cmd, 0, sizeof(*cmd));
+    cmd->crc_type = CRC_TYPE_CRC32C;
 
     // parse the cmd option
     ret = mpi_enc_test_parse_options(argc, argv, cmd);
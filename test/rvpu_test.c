@@ -0,0 +1,1003 @@
+/*
+ * Copyright (c) 2019-2020 FoilPlanet. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_TAG "rvpu_test"
+
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "rk_mpi.h"
+
+#include "mpp_env.h"
+#include "mpp_mem.h"
+#include "mpp_log.h"
+#include "mpp_time.h"
+#include "mpp_common.h"
+
+#include "rvpu_api.h"
+#include "rvpu_primitive.h"
+
+#include "utils.h"
+
+#define RVPU_TEST_LOCAL         (0x00000001)
+#define RVPU_TEST_STUB          (0x00000002)
+#define RVPU_TEST_FAILOVER      (0x00000004)
+#define RVPU_TEST_PIPELINE      (0x00000008)
+#define RVPU_TEST_REMOTE        (0x00000010)
+#define RVPU_TEST_LEGACY        (0x00000020)
+
+#define LEGACY_MAX_PRIMS        (16)
+
+typedef struct {
+    MppCodingType   type;
+    MppFrameFormat  format;
+    RK_U32          width;
+    RK_U32          height;
+    RK_U32          num_frames;
+    RK_U32          mode;
+    RK_U32          depth;
+    RK_U32          sessions;
+    RK_U32          threads;
+    RK_U32          debug;
+} RvpuTestCmd;
+
+typedef struct {
+    RvpuTestCmd    *cmd;
+
+    // paramter for resource malloc
+    RK_U32          hor_stride;
+    RK_U32          ver_stride;
+    MppFrameFormat  fmt;
+    size_t          frame_size;
+
+    MppEncPrepCfg   prep_cfg;
+    MppEncRcCfg     rc_cfg;
+    MppEncCodecCfg  codec_cfg;
+
+    // one input buffer per frame in flight
+    MppBuffer       frm_buf[RVPU_MAX_INFLIGHT];
+
+    // round-trip time of each frame in us
+    RK_S64          start[RVPU_MAX_INFLIGHT];
+    RK_S64         *latency;
+    RK_U8          *pts_seen;
+    RK_S64          last_dts;
+    RK_S64          elapsed;
+    RK_U32          frame_count;
+    RK_U64          stream_size;
+    RK_U32          stream_hash;
+    MPP_RET         ret;
+} RvpuTestData;
+
+typedef struct {
+    int             fd;
+    pthread_t       thd;
+    RvpuDispatcher  disp;
+    char            path[sizeof(((struct sockaddr_un *)0)->sun_path)];
+} RvpuTestServer;
+
+/*
+ * Peer parsing one recv buffer at a time in ascii only, as the dispatcher
+ * before binary framing did
+ */
+typedef struct {
+    int             fd;
+    pthread_t       thd;
+    char            path[sizeof(((struct sockaddr_un *)0)->sun_path)];
+    RK_U32          count;
+    RVPU_PRIM_CODE  prims[LEGACY_MAX_PRIMS];
+    size_t          lens[LEGACY_MAX_PRIMS];
+} RvpuLegacyPeer;
+
+static OptionInfo rvpu_test_cmd[] = {
+    {"w",               "width",                "the width of input picture"},
+    {"h",               "height",               "the height of input picture"},
+    {"t",               "type",                 "coding type, 7 - H.264 (x264) 8 - MJPEG"},
+    {"f",               "format",               "input format, 0 - NV12 4 - I420 10 - UYVY 65546 - ARGB"},
+    {"n",               "max frame number",     "number of frames of each run"},
+    {"m",               "mode",                 "1 - local, 2 - stub, 4 - remote lost, 8 - task count, 16 - remote, 32 - legacy peer, or'ed"},
+    {"p",               "depth",                "frames in flight of stub and remote, 1 to 4"},
+    {"s",               "sessions",             "number of concurrent stub sessions"},
+    {"c",               "threads",              "server dispatcher threads, 0 for cpu count"},
+    {"d",               "debug",                "debug flag"},
+};
+
+static void server_close(void *owner, MppCtx ctx, int fd)
+{
+    (void)owner;
+    mpp_destroy(ctx);
+    close(fd);
+}
+
+static void *server_thread(void *arg)
+{
+    RvpuTestServer *srv = (RvpuTestServer *)arg;
+
+    for (;;) {
+        MppCtx ctx = NULL;
+        MppApi *mpi = NULL;
+        RK_U8 type;
+        int fd = accept(srv->fd, NULL, NULL);
+
+        if (fd < 0)
+            break;
+
+        // reply channel type as anbox does, see connect_remote
+        if (read(fd, &type, 1) != 1 || write(fd, &type, 1) != 1 ||
+            mpp_create(&ctx, &mpi)) {
+            mpp_err("failed to setup session on fd %d\n", fd);
+            close(fd);
+            continue;
+        }
+
+        rvpu_target_init(srv, ctx);
+        if (rvpu_dispatcher_add(srv->disp, fd, ctx))
+            server_close(srv, ctx, fd);
+    }
+
+    return NULL;
+}
+
+static MPP_RET server_start(RvpuTestServer *srv, RK_U32 threads)
+{
+    struct sockaddr_un addr;
+
+    snprintf(srv->path, sizeof(srv->path), "/tmp/rvpu_test_%05d.socket", getpid());
+    unlink(srv->path);
+
+    if (rvpu_dispatcher_init(&srv->disp, threads, server_close))
+        return MPP_NOK;
+
+    srv->fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (srv->fd < 0) {
+        rvpu_dispatcher_deinit(srv->disp);
+        return MPP_NOK;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, srv->path, sizeof(addr.sun_path) - 1);
+    if (bind(srv->fd, (struct sockaddr *)&addr, sizeof(addr)) ||
+        listen(srv->fd, 64) ||
+        pthread_create(&srv->thd, NULL, server_thread, srv)) {
+        mpp_err("failed to listen on %s\n", srv->path);
+        close(srv->fd);
+        rvpu_dispatcher_deinit(srv->disp);
+        return MPP_NOK;
+    }
+
+    set_rvpu_sockname(srv->path);
+    return MPP_OK;
+}
+
+static void server_stop(RvpuTestServer *srv)
+{
+    shutdown(srv->fd, SHUT_RDWR);
+    close(srv->fd);
+    pthread_join(srv->thd, NULL);
+    rvpu_dispatcher_deinit(srv->disp);
+    unlink(srv->path);
+}
+
+static MPP_RET test_ctx_init(RvpuTestData *p, RvpuTestCmd *cmd)
+{
+    MppEncPrepCfg *prep_cfg = &p->prep_cfg;
+    MppEncRcCfg *rc_cfg = &p->rc_cfg;
+    MppEncCodecCfg *codec_cfg = &p->codec_cfg;
+    RK_S32 fps = 30;
+    RK_U32 i;
+
+    p->cmd          = cmd;
+    p->hor_stride   = MPP_ALIGN(cmd->width, 16);
+    p->ver_stride   = MPP_ALIGN(cmd->height, 16);
+
+    // software encoders convert other formats, default to what they take as is
+    if (cmd->format != MPP_FMT_BUTT)
+        p->fmt = cmd->format;
+    else if (cmd->type == MPP_VIDEO_CodingMJPEG)
+        p->fmt = MPP_FMT_ARGB8888;
+    else
+        p->fmt = MPP_FMT_YUV420P;
+    // fill_image writes 4 bytes per rgb pixel
+    p->frame_size = p->hor_stride * p->ver_stride * 4;
+
+    prep_cfg->change        = MPP_ENC_PREP_CFG_CHANGE_INPUT |
+                              MPP_ENC_PREP_CFG_CHANGE_FORMAT;
+    prep_cfg->width         = cmd->width;
+    prep_cfg->height        = cmd->height;
+    prep_cfg->hor_stride    = p->hor_stride;
+    prep_cfg->ver_stride    = p->ver_stride;
+    prep_cfg->format        = p->fmt;
+
+    rc_cfg->change          = MPP_ENC_RC_CFG_CHANGE_ALL;
+    rc_cfg->rc_mode         = MPP_ENC_RC_MODE_CBR;
+    rc_cfg->quality         = MPP_ENC_RC_QUALITY_MEDIUM;
+    rc_cfg->bps_target      = cmd->width * cmd->height / 8 * fps;
+    rc_cfg->bps_max         = rc_cfg->bps_target * 17 / 16;
+    rc_cfg->bps_min         = rc_cfg->bps_target * 15 / 16;
+    rc_cfg->fps_in_num      = fps;
+    rc_cfg->fps_in_denorm   = 1;
+    rc_cfg->fps_out_num     = fps;
+    rc_cfg->fps_out_denorm  = 1;
+    rc_cfg->gop             = fps * 2;
+
+    codec_cfg->coding = cmd->type;
+    if (cmd->type == MPP_VIDEO_CodingMJPEG) {
+        codec_cfg->jpeg.change  = MPP_ENC_JPEG_CFG_CHANGE_QP;
+        codec_cfg->jpeg.quant   = 8;
+    } else {
+        codec_cfg->h264.change  = MPP_ENC_H264_CFG_CHANGE_PROFILE;
+        codec_cfg->h264.profile = 66;
+        codec_cfg->h264.level   = 40;
+    }
+
+    p->latency = mpp_calloc(RK_S64, cmd->num_frames);
+    p->pts_seen = mpp_calloc(RK_U8, cmd->num_frames);
+    if (NULL == p->latency || NULL == p->pts_seen)
+        return MPP_ERR_MALLOC;
+
+    for (i = 0; i < cmd->depth; i++) {
+        MPP_RET ret = mpp_buffer_get(NULL, &p->frm_buf[i], p->frame_size);
+        if (ret)
+            return ret;
+    }
+
+    return MPP_OK;
+}
+
+static void test_ctx_deinit(RvpuTestData *p)
+{
+    RK_U32 i;
+
+    for (i = 0; i < RVPU_MAX_INFLIGHT; i++) {
+        if (p->frm_buf[i]) {
+            mpp_buffer_put(p->frm_buf[i]);
+            p->frm_buf[i] = NULL;
+        }
+    }
+    MPP_FREE(p->latency);
+    MPP_FREE(p->pts_seen);
+}
+
+static void reset_stats(RvpuTestData *p)
+{
+    p->frame_count = 0;
+    p->stream_size = 0;
+    p->elapsed     = 0;
+    p->stream_hash = 2166136261u;
+    p->last_dts    = 0;
+    memset(p->pts_seen, 0, p->cmd->num_frames);
+}
+
+static int cmp_latency(const void *a, const void *b)
+{
+    RK_S64 x = *(const RK_S64 *)a;
+    RK_S64 y = *(const RK_S64 *)b;
+
+    return (x > y) - (x < y);
+}
+
+static void show_latency(const char *name, RvpuTestData *p)
+{
+    RK_S64 *lat = p->latency;
+    RK_U32 cnt = p->frame_count;
+    RK_S64 sum = 0;
+    RK_U32 i;
+
+    if (!cnt) {
+        mpp_log("%-6s no frame encoded\n", name);
+        return;
+    }
+
+    for (i = 0; i < cnt; i++)
+        sum += lat[i];
+
+    qsort(lat, cnt, sizeof(lat[0]), cmp_latency);
+
+    mpp_log("%-6s frames %4d bytes %8lld fps %6.2f latency(us) min %6lld avg %6lld "
+            "p50 %6lld p90 %6lld p99 %6lld max %6lld\n",
+            name, cnt, p->stream_size,
+            p->elapsed ? cnt * 1000000.0 / p->elapsed : 0.0,
+            lat[0], sum / cnt, lat[cnt / 2],
+            lat[cnt * 90 / 100], lat[cnt * 99 / 100], lat[cnt - 1]);
+}
+
+/*
+ * Encoder may delay frames, empty packets carry no frame. Each packet must
+ * carry the pts of a distinct input frame, in decode order of increasing dts.
+ */
+static MPP_RET check_packet(RvpuTestData *p, MppPacket packet, RK_U32 *count)
+{
+    RK_U8 *pos = (RK_U8 *)mpp_packet_get_pos(packet);
+    size_t len = mpp_packet_get_length(packet);
+    RK_S64 pts = mpp_packet_get_pts(packet);
+    RK_S64 dts = mpp_packet_get_dts(packet);
+    size_t i;
+
+    if (!len)
+        return MPP_OK;
+
+    if (pts < 0 || pts >= p->cmd->num_frames || p->pts_seen[pts] ||
+        dts > pts || (*count && dts <= p->last_dts)) {
+        mpp_err("packet %d pts %lld dts %lld invalid\n", *count, pts, dts);
+        return MPP_NOK;
+    }
+
+    // a packet not copied from remote is left as the stale buffer content
+    if (p->cmd->type == MPP_VIDEO_CodingAVC &&
+        (len < 4 || pos[0] || pos[1] || pos[2] || pos[3] != 1)) {
+        mpp_err("packet %d without start code\n", *count);
+        return MPP_NOK;
+    }
+
+    // fnv-1a over the whole stream to compare runs
+    for (i = 0; i < len; i++)
+        p->stream_hash = (p->stream_hash ^ pos[i]) * 16777619;
+
+    p->pts_seen[pts] = 1;
+    p->last_dts = dts;
+    (*count)++;
+    p->stream_size += len;
+    return MPP_OK;
+}
+
+/*
+ * Encode through mpp. The stub hal picks the remote backend when a server is
+ * listening. drop stops that server in the middle of the stream, so the
+ * encoder has to fall back to a local backend without losing any frame, also
+ * the ones in flight on the server.
+ */
+static MPP_RET run_local(RvpuTestData *p, RvpuTestServer *drop)
+{
+    RvpuTestCmd *cmd = p->cmd;
+    MppPollType timeout = MPP_POLL_BLOCK;
+    MppCtx ctx = NULL;
+    MppApi *mpi = NULL;
+    MppFrame eos = NULL;
+    MPP_RET ret;
+    RK_S64 begin;
+    RK_U32 pkt_count = 0;
+    RK_U32 is_eos = 0;
+    RK_U32 i;
+
+    ret = mpp_create(&ctx, &mpi);
+    if (ret) {
+        mpp_err("mpp_create failed ret %d\n", ret);
+        goto RET;
+    }
+
+    ret = mpi->control(ctx, MPP_SET_OUTPUT_TIMEOUT, &timeout);
+    if (ret)
+        goto RET;
+
+    ret = mpp_init(ctx, MPP_CTX_ENC, cmd->type);
+    if (ret) {
+        mpp_err("mpp_init failed ret %d\n", ret);
+        goto RET;
+    }
+
+    ret = mpi->control(ctx, MPP_ENC_SET_PREP_CFG, &p->prep_cfg);
+    if (!ret)
+        ret = mpi->control(ctx, MPP_ENC_SET_RC_CFG, &p->rc_cfg);
+    if (!ret)
+        ret = mpi->control(ctx, MPP_ENC_SET_CODEC_CFG, &p->codec_cfg);
+    if (ret) {
+        mpp_err("mpi control enc cfg failed ret %d\n", ret);
+        goto RET;
+    }
+
+    begin = mpp_time();
+    for (i = 0; i < cmd->num_frames; i++) {
+        // frames in flight on remote still read their input buffer
+        MppBuffer buf = p->frm_buf[i % cmd->depth];
+        MppFrame frame = NULL;
+        MppPacket packet = NULL;
+        RK_S64 start;
+
+        if (drop && i == cmd->num_frames / 2) {
+            server_stop(drop);
+            drop = NULL;
+        }
+
+        fill_image(mpp_buffer_get_ptr(buf), cmd->width, cmd->height,
+                   p->hor_stride, p->ver_stride, p->fmt, i);
+
+        ret = mpp_frame_init(&frame);
+        if (ret)
+            goto RET;
+
+        mpp_frame_set_width(frame, cmd->width);
+        mpp_frame_set_height(frame, cmd->height);
+        mpp_frame_set_hor_stride(frame, p->hor_stride);
+        mpp_frame_set_ver_stride(frame, p->ver_stride);
+        mpp_frame_set_fmt(frame, p->fmt);
+        mpp_frame_set_buffer(frame, buf);
+        mpp_frame_set_pts(frame, i);
+
+        start = mpp_time();
+        ret = mpi->encode_put_frame(ctx, frame);
+        if (!ret)
+            ret = mpi->encode_get_packet(ctx, &packet);
+        if (ret || NULL == packet) {
+            mpp_err("local encode frame %d failed ret %d\n", i, ret);
+            ret = MPP_NOK;
+            goto RET;
+        }
+        p->latency[p->frame_count++] = mpp_time() - start;
+        ret = check_packet(p, packet, &pkt_count);
+        mpp_packet_deinit(&packet);
+        if (ret)
+            goto RET;
+    }
+
+    // eos frame without buffer, the frames delayed by encoder follow it.
+    // put_frame releases the frame
+    ret = mpp_frame_init(&eos);
+    if (ret)
+        goto RET;
+    mpp_frame_set_eos(eos, 1);
+    ret = mpi->encode_put_frame(ctx, eos);
+    while (!ret) {
+        MppPacket packet = NULL;
+
+        ret = mpi->encode_get_packet(ctx, &packet);
+        if (ret || NULL == packet) {
+            mpp_err("local drain failed ret %d\n", ret);
+            ret = MPP_NOK;
+            break;
+        }
+        is_eos = mpp_packet_get_eos(packet);
+        ret = check_packet(p, packet, &pkt_count);
+        mpp_packet_deinit(&packet);
+        if (is_eos)
+            break;
+    }
+    p->elapsed = mpp_time() - begin;
+    if (ret)
+        goto RET;
+
+    // every input frame must come out exactly once, the last packet with eos
+    if (!is_eos) {
+        mpp_err("local drain ended without eos packet\n");
+        ret = MPP_NOK;
+    } else if (pkt_count != cmd->num_frames) {
+        mpp_err("local input %d frames but output %d packets\n",
+                cmd->num_frames, pkt_count);
+        ret = MPP_NOK;
+    }
+
+RET:
+    if (drop)
+        server_stop(drop);
+    if (ctx)
+        mpp_destroy(ctx);
+    return ret;
+}
+
+static MPP_RET complete_frame(RvpuTestData *p, HalRvpuInfo *info, RK_U32 idx)
+{
+    RvpuInflight *frame = rvpu_inflight_pop(info);
+    RvpuWaitResult result;
+    // frames of other sessions may be queued on server before this one
+    RK_S32 timeout = RVPU_WAIT_TIMEOUT * 4 * p->cmd->sessions;
+
+    if (rvpu_wait(info, frame->seq, &result, timeout) <= 0) {
+        mpp_err("stub frame %d no completion\n", idx);
+        return MPP_NOK;
+    }
+
+    if (!result.length) {
+        mpp_err("stub frame %d encode failed\n", idx);
+        return MPP_NOK;
+    }
+
+    p->latency[p->frame_count] = mpp_time() - p->start[idx % RVPU_MAX_INFLIGHT];
+    p->frame_count++;
+    p->stream_size += result.length;
+    return MPP_OK;
+}
+
+static MPP_RET run_stub(RvpuTestData *p)
+{
+    RvpuTestCmd *cmd = p->cmd;
+    RvpuInitCfg init;
+    HalRvpuInfo info;
+    MPP_RET ret;
+    RK_S64 begin;
+    RK_U32 i;
+
+    memset(&info, 0, sizeof(info));
+    ret = rvpu_open(&info);
+    if (ret) {
+        mpp_err("rvpu_open failed ret %d\n", ret);
+        return ret;
+    }
+    info.depth = cmd->depth;
+
+    init.coding = cmd->type;
+    init.depth  = cmd->depth;
+    ret = rvpu_send(&info, RVPU_PRIM_INIT, &init, sizeof(init));
+    if (!ret)
+        ret = rvpu_send(&info, RVPU_PRIM_CONTROL_PREP, &p->prep_cfg, sizeof(p->prep_cfg));
+    if (!ret)
+        ret = rvpu_send(&info, RVPU_PRIM_CONTROL_RC, &p->rc_cfg, sizeof(p->rc_cfg));
+    if (!ret)
+        ret = rvpu_send(&info, RVPU_PRIM_CONTROL_CODEC, &p->codec_cfg, sizeof(p->codec_cfg));
+    if (ret)
+        goto RET;
+
+    begin = mpp_time();
+    for (i = 0; i < cmd->num_frames; i++) {
+        MppBuffer buf = p->frm_buf[i % cmd->depth];
+        MppBufferInfo binfo;
+
+        // input buffer is reused once its frame has completed
+        if (info.inflight >= info.depth) {
+            ret = complete_frame(p, &info, p->frame_count);
+            if (ret)
+                goto RET;
+        }
+
+        fill_image(mpp_buffer_get_ptr(buf), cmd->width, cmd->height,
+                   p->hor_stride, p->ver_stride, p->fmt, i);
+
+        // server shares the address space, so a normal buffer can be imported
+        mpp_buffer_info_get(buf, &binfo);
+
+        p->start[i % RVPU_MAX_INFLIGHT] = mpp_time();
+        rvpu_queue(&info, RVPU_PRIM_REGS, NULL, 0);
+        rvpu_queue(&info, RVPU_PRIM_START, &binfo, sizeof(binfo));
+        ret = rvpu_send(&info, RVPU_PRIM_WAIT, NULL, 0);
+        if (ret)
+            goto RET;
+
+        rvpu_inflight_push(&info, info.seq - 1, 0, i, NULL, NULL);
+    }
+
+    while (info.inflight) {
+        ret = complete_frame(p, &info, p->frame_count);
+        if (ret)
+            goto RET;
+    }
+    p->elapsed = mpp_time() - begin;
+
+RET:
+    rvpu_close(&info);
+    return ret;
+}
+
+static void *stub_thread(void *arg)
+{
+    RvpuTestData *p = (RvpuTestData *)arg;
+
+    p->ret = run_stub(p);
+    return NULL;
+}
+
+/*
+ * Run stub sessions concurrently, latency of all frames is collected into
+ * all for the report
+ */
+static MPP_RET run_stubs(RvpuTestData *all)
+{
+    RvpuTestCmd *cmd = all->cmd;
+    RvpuTestData *data = mpp_calloc(RvpuTestData, cmd->sessions);
+    pthread_t *thds = mpp_calloc(pthread_t, cmd->sessions);
+    MPP_RET ret = MPP_OK;
+    RK_U32 started = 0;
+    RK_S64 begin;
+    RK_U32 i;
+
+    MPP_FREE(all->latency);
+    all->latency = mpp_calloc(RK_S64, cmd->num_frames * cmd->sessions);
+    if (NULL == data || NULL == thds || NULL == all->latency) {
+        ret = MPP_ERR_MALLOC;
+        goto RET;
+    }
+
+    for (i = 0; i < cmd->sessions; i++) {
+        ret = test_ctx_init(&data[i], cmd);
+        if (ret)
+            goto RET;
+    }
+
+    begin = mpp_time();
+    for (; started < cmd->sessions; started++) {
+        if (pthread_create(&thds[started], NULL, stub_thread, &data[started])) {
+            ret = MPP_NOK;
+            break;
+        }
+    }
+
+    for (i = 0; i < started; i++) {
+        RvpuTestData *p = &data[i];
+
+        pthread_join(thds[i], NULL);
+        memcpy(all->latency + all->frame_count, p->latency,
+               p->frame_count * sizeof(p->latency[0]));
+        all->frame_count += p->frame_count;
+        all->stream_size += p->stream_size;
+        if (p->ret) {
+            mpp_err("stub session %d failed ret %d\n", i, p->ret);
+            ret = p->ret;
+        }
+    }
+    all->elapsed = mpp_time() - begin;
+
+RET:
+    if (data) {
+        for (i = 0; i < cmd->sessions; i++)
+            test_ctx_deinit(&data[i]);
+    }
+    MPP_FREE(data);
+    MPP_FREE(thds);
+    return ret;
+}
+
+static void *legacy_thread(void *arg)
+{
+    RvpuLegacyPeer *peer = (RvpuLegacyPeer *)arg;
+    uint8_t buf[4096];
+    RK_U8 type;
+    ssize_t size;
+    int fd = accept(peer->fd, NULL, NULL);
+
+    if (fd < 0)
+        return NULL;
+
+    if (read(fd, &type, 1) != 1 || write(fd, &type, 1) != 1) {
+        close(fd);
+        return NULL;
+    }
+
+    // unknown primitives are skipped by their length, nothing is answered
+    while ((size = recv(fd, buf, sizeof(buf), MSG_NOSIGNAL)) > 0) {
+        const uint8_t *pch  = buf;
+        const uint8_t *pend = buf + size;
+
+        while (pch < pend) {
+            RVPU_PRIM_CODE prim;
+            size_t len;
+
+            pch += parse_header(pch, pend, &prim, &len);
+            if (peer->count < LEGACY_MAX_PRIMS) {
+                peer->prims[peer->count] = prim;
+                peer->lens[peer->count] = len;
+            }
+            peer->count++;
+            pch += len;
+        }
+    }
+
+    close(fd);
+    return NULL;
+}
+
+/*
+ * Stub has to fall back to ascii without confusing a legacy peer
+ */
+static MPP_RET run_legacy(RvpuTestData *p)
+{
+    static const RVPU_PRIM_CODE expect[] = {
+        RVPU_PRIM_HELLO,
+        RVPU_PRIM_INIT,
+        RVPU_PRIM_CONTROL_PREP,
+        RVPU_PRIM_CONTROL_RC,
+        RVPU_PRIM_DEINIT,
+    };
+    const size_t sizes[] = {
+        sizeof(RK_U32),
+        sizeof(RvpuInitCfg),
+        sizeof(p->prep_cfg),
+        sizeof(p->rc_cfg),
+        0,
+    };
+    RvpuLegacyPeer peer;
+    struct sockaddr_un addr;
+    RvpuInitCfg init;
+    HalRvpuInfo info;
+    MPP_RET ret = MPP_NOK;
+    RK_U32 i;
+
+    memset(&peer, 0, sizeof(peer));
+    snprintf(peer.path, sizeof(peer.path), "/tmp/rvpu_legacy_%05d.socket", getpid());
+    unlink(peer.path);
+
+    peer.fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (peer.fd < 0)
+        return MPP_NOK;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, peer.path, sizeof(addr.sun_path) - 1);
+    if (bind(peer.fd, (struct sockaddr *)&addr, sizeof(addr)) ||
+        listen(peer.fd, 1) ||
+        pthread_create(&peer.thd, NULL, legacy_thread, &peer)) {
+        mpp_err("failed to listen on %s\n", peer.path);
+        close(peer.fd);
+        unlink(peer.path);
+        return MPP_NOK;
+    }
+    set_rvpu_sockname(peer.path);
+
+    // legacy peer never answers the probe
+    mpp_env_set_u32("rvpu_hello_timeout", 100);
+    memset(&info, 0, sizeof(info));
+    if (rvpu_open(&info)) {
+        mpp_err("rvpu_open on legacy peer failed\n");
+    } else if (info.proto != RVPU_PROTO_ASCII) {
+        mpp_err("legacy peer negotiated protocol %d\n", info.proto);
+    } else {
+        init.coding = p->cmd->type;
+        init.depth  = 1;
+        ret = rvpu_send(&info, RVPU_PRIM_INIT, &init, sizeof(init));
+        if (!ret)
+            ret = rvpu_send(&info, RVPU_PRIM_CONTROL_PREP, &p->prep_cfg, sizeof(p->prep_cfg));
+        if (!ret)
+            ret = rvpu_send(&info, RVPU_PRIM_CONTROL_RC, &p->rc_cfg, sizeof(p->rc_cfg));
+    }
+    rvpu_close(&info);
+    mpp_env_set_u32("rvpu_hello_timeout", 5000);
+
+    pthread_join(peer.thd, NULL);
+    close(peer.fd);
+    unlink(peer.path);
+    if (ret)
+        return ret;
+
+    if (peer.count != MPP_ARRAY_ELEMS(expect)) {
+        mpp_err("legacy peer parsed %d primitives, expect %d\n",
+                peer.count, MPP_ARRAY_ELEMS(expect));
+        return MPP_NOK;
+    }
+
+    for (i = 0; i < peer.count; i++) {
+        if (peer.prims[i] != expect[i] || peer.lens[i] != sizes[i]) {
+            mpp_err("legacy peer primitive %d is %d:%d, expect %d:%d\n", i,
+                    peer.prims[i], peer.lens[i], expect[i], sizes[i]);
+            return MPP_NOK;
+        }
+    }
+
+    return MPP_OK;
+}
+
+static MPP_RET rvpu_test(RvpuTestCmd *cmd)
+{
+    RvpuTestServer srv;
+    RvpuTestData data;
+    RK_U32 local_hash = 0;
+    MPP_RET ret;
+
+    memset(&data, 0, sizeof(data));
+    ret = test_ctx_init(&data, cmd);
+    if (ret) {
+        mpp_err("test data init failed ret %d\n", ret);
+        goto RET;
+    }
+
+    if (cmd->mode & RVPU_TEST_LOCAL) {
+        reset_stats(&data);
+        ret = run_local(&data, NULL);
+        show_latency("local", &data);
+        if (ret)
+            goto RET;
+        local_hash = data.stream_hash;
+    }
+
+    // the pipelined encoder has to give the same stream as the serial one
+    if (cmd->mode & RVPU_TEST_PIPELINE) {
+        RK_U32 hash = 0;
+        RK_U32 count;
+
+        for (count = 1; count <= 3; count += 2) {
+            char name[16];
+
+            snprintf(name, sizeof(name), "task%d", count);
+            mpp_env_set_u32("mpp_enc_task_count", count);
+            reset_stats(&data);
+            ret = run_local(&data, NULL);
+            show_latency(name, &data);
+            if (ret)
+                break;
+
+            if (count == 1) {
+                hash = data.stream_hash;
+            } else if (hash != data.stream_hash) {
+                mpp_err("task count %d stream %08x differs from serial %08x\n",
+                        count, data.stream_hash, hash);
+                ret = MPP_NOK;
+            }
+        }
+        mpp_env_set_u32("mpp_enc_task_count", 1);
+        if (ret)
+            goto RET;
+    }
+
+    // mpp encoder on the remote backend keeps depth frames in flight
+    if (cmd->mode & RVPU_TEST_REMOTE) {
+        ret = server_start(&srv, cmd->threads);
+        if (ret)
+            goto RET;
+
+        // x264 on server is much slower than a hardware encoder
+        mpp_env_set_u32("rvpu_depth", cmd->depth);
+        mpp_env_set_u32("rvpu_wait_timeout", RVPU_WAIT_TIMEOUT * 20);
+        reset_stats(&data);
+        ret = run_local(&data, NULL);
+        show_latency("remote", &data);
+        server_stop(&srv);
+        mpp_env_set_u32("rvpu_depth", 1);
+        mpp_env_set_u32("rvpu_wait_timeout", RVPU_WAIT_TIMEOUT);
+        if (ret)
+            goto RET;
+
+        // the packets copied back from server are the same as local ones
+        if ((cmd->mode & RVPU_TEST_LOCAL) && data.stream_hash != local_hash) {
+            mpp_err("remote stream %08x differs from local %08x\n",
+                    data.stream_hash, local_hash);
+            ret = MPP_NOK;
+            goto RET;
+        }
+    }
+
+    if (cmd->mode & RVPU_TEST_FAILOVER) {
+        ret = server_start(&srv, cmd->threads);
+        if (ret)
+            goto RET;
+
+        mpp_env_set_u32("rvpu_depth", cmd->depth);
+        mpp_env_set_u32("rvpu_wait_timeout", RVPU_WAIT_TIMEOUT * 20);
+        reset_stats(&data);
+        ret = run_local(&data, &srv);
+        show_latency("lost", &data);
+        mpp_env_set_u32("rvpu_depth", 1);
+        mpp_env_set_u32("rvpu_wait_timeout", RVPU_WAIT_TIMEOUT);
+        if (ret)
+            goto RET;
+    }
+
+    if (cmd->mode & RVPU_TEST_LEGACY) {
+        ret = run_legacy(&data);
+        mpp_log("legacy peer %s\n", ret ? "failed" : "ok");
+        if (ret)
+            goto RET;
+    }
+
+    if (cmd->mode & RVPU_TEST_STUB) {
+        ret = server_start(&srv, cmd->threads);
+        if (ret)
+            goto RET;
+
+        reset_stats(&data);
+        ret = run_stubs(&data);
+        show_latency("stub", &data);
+        server_stop(&srv);
+    }
+
+RET:
+    test_ctx_deinit(&data);
+    return ret;
+}
+
+static RK_S32 rvpu_test_parse_options(int argc, char **argv, RvpuTestCmd *cmd)
+{
+    RK_S32 optindex = 1;
+
+    while (optindex < argc) {
+        const char *opt  = argv[optindex++];
+        const char *next = (optindex < argc) ? argv[optindex] : NULL;
+
+        if (opt[0] != '-' || opt[1] == '\0')
+            continue;
+
+        if (!strcmp(opt, "--help") || !strcmp(opt, "-help"))
+            return 1;
+
+        if (NULL == next) {
+            mpp_err("missing value of option %s\n", opt);
+            return MPP_NOK;
+        }
+
+        switch (opt[1]) {
+        case 'w':
+            cmd->width = atoi(next);
+            break;
+        case 'h':
+            cmd->height = atoi(next);
+            break;
+        case 't':
+            cmd->type = (MppCodingType)atoi(next);
+            break;
+        case 'f':
+            cmd->format = (MppFrameFormat)atoi(next);
+            break;
+        case 'n':
+            cmd->num_frames = atoi(next);
+            break;
+        case 'm':
+            cmd->mode = atoi(next);
+            break;
+        case 'p':
+            cmd->depth = atoi(next);
+            break;
+        case 's':
+            cmd->sessions = atoi(next);
+            break;
+        case 'c':
+            cmd->threads = atoi(next);
+            break;
+        case 'd':
+            cmd->debug = atoi(next);
+            break;
+        default:
+            mpp_err("skip invalid opt %c\n", opt[1]);
+            break;
+        }
+        optindex++;
+    }
+
+    if (!cmd->width || !cmd->height || !cmd->num_frames || !cmd->mode ||
+        !cmd->depth || cmd->depth > RVPU_MAX_INFLIGHT || !cmd->sessions) {
+        mpp_err("invalid width %d height %d frames %d mode %d depth %d sessions %d\n",
+                cmd->width, cmd->height, cmd->num_frames, cmd->mode,
+                cmd->depth, cmd->sessions);
+        return MPP_NOK;
+    }
+
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    RvpuTestCmd cmd;
+    RK_S32 ret;
+
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.type        = MPP_VIDEO_CodingAVC;
+    cmd.format      = MPP_FMT_BUTT;
+    cmd.width       = 1280;
+    cmd.height      = 720;
+    cmd.num_frames  = 100;
+    cmd.mode        = RVPU_TEST_LOCAL | RVPU_TEST_STUB;
+    cmd.depth       = 1;
+    cmd.sessions    = 1;
+    cmd.threads     = 4;
+
+    ret = rvpu_test_parse_options(argc, argv, &cmd);
+    if (ret) {
+        mpp_log("usage: rvpu_test [options]\n");
+        show_options(rvpu_test_cmd);
+        return ret;
+    }
+
+    mpp_env_set_u32("mpi_debug", cmd.debug);
+    // the in-process server always answers, do not fall back when it is busy
+    mpp_env_set_u32("rvpu_hello_timeout", 5000);
+
+    ret = rvpu_test(&cmd);
+    if (ret)
+        mpp_err("rvpu_test failed ret %d\n", ret);
+    else
+        mpp_log("rvpu_test success\n");
+
+    mpp_env_set_u32("mpi_debug", 0x0);
+    return ret;
+}
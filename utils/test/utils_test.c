@@ -0,0 +1,189 @@
+/*
+ * Copyright 2015 Rockchip Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_TAG "utils_test"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "mpp_log.h"
+#include "mpp_mem.h"
+#include "mpp_buffer.h"
+
+#include "utils.h"
+
+#define TEST_BUF_SIZE       (8192)
+#define TEST_MAX_WIDTH      (200)
+#define TEST_MAX_HEIGHT     (9)
+#define TEST_ROUNDS         (500)
+
+static void calc_data_crc_c(RK_U8 *dat, RK_U32 len, DataCrc *crc, CrcType type)
+{
+    set_data_crc_simd(0);
+    calc_data_crc(dat, len, crc, type);
+    set_data_crc_simd(1);
+}
+
+static RK_S32 crc_differs(DataCrc *a, DataCrc *b)
+{
+    return a->len != b->len || a->sum != b->sum || a->vor != b->vor;
+}
+
+/* crc32c check value of the standard test string */
+static MPP_RET test_crc32c_known(void)
+{
+    RK_U8 str[] = "123456789";
+    DataCrc hw;
+    DataCrc c;
+
+    calc_data_crc(str, 9, &hw, CRC_TYPE_CRC32C);
+    calc_data_crc_c(str, 9, &c, CRC_TYPE_CRC32C);
+    if (hw.sum != 0xe3069283 || c.sum != 0xe3069283) {
+        mpp_err("crc32c of \"123456789\" %08x c %08x expect e3069283\n",
+                hw.sum, c.sum);
+        return MPP_NOK;
+    }
+
+    return MPP_OK;
+}
+
+/* every length and alignment around the vector widths and the 8-byte steps */
+static MPP_RET test_data_crc(RK_U8 *buf)
+{
+    RK_U32 round;
+
+    for (round = 0; round < TEST_ROUNDS; round++) {
+        RK_U32 offset = rand() % 64;
+        RK_U32 len = (round < 200) ? round : (RK_U32)rand() % (TEST_BUF_SIZE - 64);
+        RK_U32 type;
+
+        for (type = 0; type < CRC_TYPE_BUTT; type++) {
+            DataCrc simd;
+            DataCrc c;
+
+            calc_data_crc(buf + offset, len, &simd, (CrcType)type);
+            calc_data_crc_c(buf + offset, len, &c, (CrcType)type);
+            if (crc_differs(&simd, &c)) {
+                mpp_err("%s len %d offset %d %08x %08x c %08x %08x\n",
+                        type ? "crc32c" : "sum", len, offset,
+                        simd.sum, simd.vor, c.sum, c.vor);
+                return MPP_NOK;
+            }
+        }
+    }
+
+    return MPP_OK;
+}
+
+/* odd widths, strides and heights, stride padding must not count */
+static MPP_RET test_frame_crc(MppBuffer buffer)
+{
+    RK_U8 *buf = (RK_U8 *)mpp_buffer_get_ptr(buffer);
+    MppFrame frame = NULL;
+    MPP_RET ret = MPP_OK;
+    RK_U32 width;
+
+    mpp_frame_init(&frame);
+    mpp_frame_set_fmt(frame, MPP_FMT_YUV420SP);
+    mpp_frame_set_buffer(frame, buffer);
+
+    for (width = 1; width <= TEST_MAX_WIDTH && !ret; width++) {
+        RK_U32 height = 1 + width % TEST_MAX_HEIGHT;
+        RK_U32 h_stride = width + rand() % 40;
+        RK_U32 v_stride = height + (height & 1);
+        RK_U32 type;
+
+        mpp_frame_set_width(frame, width);
+        mpp_frame_set_height(frame, height);
+        mpp_frame_set_hor_stride(frame, h_stride);
+        mpp_frame_set_ver_stride(frame, v_stride);
+
+        for (type = 0; type < CRC_TYPE_BUTT; type++) {
+            FrmCrc simd;
+            FrmCrc c;
+            FrmCrc pad;
+            RK_U32 y;
+
+            calc_frm_crc(frame, &simd, (CrcType)type);
+            set_data_crc_simd(0);
+            calc_frm_crc(frame, &c, (CrcType)type);
+            set_data_crc_simd(1);
+
+            if (crc_differs(&simd.luma, &c.luma) ||
+                crc_differs(&simd.chroma, &c.chroma)) {
+                mpp_err("%s frame %dx%d stride %d differs from c\n",
+                        type ? "crc32c" : "sum", width, height, h_stride);
+                ret = MPP_NOK;
+                break;
+            }
+
+            // scramble the padding of every luma and chroma row
+            for (y = 0; y < v_stride * 3 / 2; y++)
+                memset(buf + y * h_stride + width, rand(), h_stride - width);
+
+            calc_frm_crc(frame, &pad, (CrcType)type);
+            if (crc_differs(&simd.luma, &pad.luma) ||
+                crc_differs(&simd.chroma, &pad.chroma)) {
+                mpp_err("%s frame %dx%d stride %d changed by padding\n",
+                        type ? "crc32c" : "sum", width, height, h_stride);
+                ret = MPP_NOK;
+                break;
+            }
+        }
+    }
+
+    mpp_frame_deinit(&frame);
+    return ret;
+}
+
+int main()
+{
+    MppBuffer buffer = NULL;
+    RK_U8 *buf;
+    RK_U32 i;
+
+    mpp_log("utils test start\n");
+
+    mpp_buffer_get(NULL, &buffer, TEST_BUF_SIZE);
+    if (NULL == buffer) {
+        mpp_err("failed to get test buffer\n");
+        goto TEST_FAILED;
+    }
+
+    srand(1);
+    buf = (RK_U8 *)mpp_buffer_get_ptr(buffer);
+    for (i = 0; i < TEST_BUF_SIZE; i++)
+        buf[i] = rand();
+
+    if (test_crc32c_known())
+        goto TEST_FAILED;
+
+    if (test_data_crc(buf))
+        goto TEST_FAILED;
+
+    if (test_frame_crc(buffer))
+        goto TEST_FAILED;
+
+    mpp_buffer_put(buffer);
+    mpp_log("utils test success\n");
+    return 0;
+
+TEST_FAILED:
+    if (buffer)
+        mpp_buffer_put(buffer);
+    mpp_log("utils test failed\n");
+    return -1;
+}
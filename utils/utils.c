@@ -17,9 +17,11 @@
 #define MODULE_TAG "utils"
 
 #include <string.h>
+#include <pthread.h>
 
 #include "mpp_mem.h"
 #include "mpp_log.h"
+#include "mpp_env.h"
 #include "utils.h"
 
 void _show_options(int count, OptionInfo *options)
@@ -148,34 +150,267 @@ void dump_mpp_frame_to_file(MppFrame frame, FILE *fp)
     }
 }
 
-void calc_data_crc(RK_U8 *dat, RK_U32 len, DataCrc *crc)
+/*
+ * Checksum kernels. CRC_TYPE_SUM adds up the bytes and xors the 32-bit words
+ * of each row, the row tail zero padded, so vectors of any width fold to the
+ * same result. CRC_TYPE_CRC32C runs over the rows back to back. Env
+ * utils_crc_simd 0, read at first use, or set_data_crc_simd(0) falls back to
+ * plain c for both.
+ */
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CRC_SIMD_WIDTH  32
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define CRC_SIMD_WIDTH  16
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define CRC_SIMD_WIDTH  16
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define CRC32C_HW_ARM
+#elif defined(__x86_64__) && defined(__GNUC__)
+#include <nmmintrin.h>
+#define CRC32C_HW_SSE42
+#endif
+
+#define CRC32C_POLY     (0x82f63b78)
+
+typedef struct CrcState_t {
+    CrcType         type;
+    RK_U32          simd;
+    RK_U32          len;
+    RK_U64          sum;
+    RK_U32          vor;
+    RK_U32          crc;
+} CrcState;
+
+typedef RK_U32 (*Crc32cFunc)(RK_U32 crc, const RK_U8 *dat, RK_U32 len);
+
+static pthread_once_t crc32c_once = PTHREAD_ONCE_INIT;
+static RK_U32 crc32c_table[8][256];
+static Crc32cFunc crc32c_update;
+
+// env is read once, checksums run for every plane of every frame
+static pthread_once_t crc_simd_once = PTHREAD_ONCE_INIT;
+static RK_U32 crc_simd = 1;
+
+static void sum_xor_update(CrcState *s, const RK_U8 *dat, RK_U32 len)
 {
+    RK_U64 sum = 0;
+    RK_U32 vor = 0;
     RK_U32 i = 0;
-    RK_U8 *dat8 = NULL;
-    RK_U32 *dat32 = NULL;
-    RK_U32 sum = 0, xor = 0;
 
-    /*calc sum */
-    dat8 = dat;
-    for (i = 0; i < len; i++)
-        sum += dat8[i];
+#if defined(__AVX2__)
+    if (s->simd) {
+        const __m256i zero = _mm256_setzero_si256();
+        __m256i vs = zero;
+        __m256i vx = zero;
+        RK_U64 s4[4];
+        RK_U32 x8[8];
+        RK_U32 n;
+
+        for (; i + CRC_SIMD_WIDTH <= len; i += CRC_SIMD_WIDTH) {
+            __m256i v = _mm256_loadu_si256((const __m256i *)(dat + i));
 
-    /*calc xor */
-    dat32 = (RK_U32 *)dat;
-    for (i = 0; i < len / 4; i++)
-        xor ^= dat32[i];
+            vs = _mm256_add_epi64(vs, _mm256_sad_epu8(v, zero));
+            vx = _mm256_xor_si256(vx, v);
+        }
+        _mm256_storeu_si256((__m256i *)s4, vs);
+        _mm256_storeu_si256((__m256i *)x8, vx);
+        for (n = 0; n < 4; n++)
+            sum += s4[n];
+        for (n = 0; n < 8; n++)
+            vor ^= x8[n];
+    }
+#elif defined(__SSE2__)
+    if (s->simd) {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i vs = zero;
+        __m128i vx = zero;
+        RK_U64 s2[2];
+        RK_U32 x4[4];
+
+        for (; i + CRC_SIMD_WIDTH <= len; i += CRC_SIMD_WIDTH) {
+            __m128i v = _mm_loadu_si128((const __m128i *)(dat + i));
+
+            vs = _mm_add_epi64(vs, _mm_sad_epu8(v, zero));
+            vx = _mm_xor_si128(vx, v);
+        }
+        _mm_storeu_si128((__m128i *)s2, vs);
+        _mm_storeu_si128((__m128i *)x4, vx);
+        sum = s2[0] + s2[1];
+        vor = x4[0] ^ x4[1] ^ x4[2] ^ x4[3];
+    }
+#elif defined(__aarch64__)
+    if (s->simd) {
+        uint64x2_t vs = vdupq_n_u64(0);
+        uint8x16_t vx = vdupq_n_u8(0);
+        uint32x4_t x;
+
+        for (; i + CRC_SIMD_WIDTH <= len; i += CRC_SIMD_WIDTH) {
+            uint8x16_t v = vld1q_u8(dat + i);
+
+            vs = vpadalq_u32(vs, vpaddlq_u16(vpaddlq_u8(v)));
+            vx = veorq_u8(vx, v);
+        }
+        x = vreinterpretq_u32_u8(vx);
+        sum = vaddvq_u64(vs);
+        vor = vgetq_lane_u32(x, 0) ^ vgetq_lane_u32(x, 1) ^
+              vgetq_lane_u32(x, 2) ^ vgetq_lane_u32(x, 3);
+    }
+#endif
 
-    if (len % 4) {
+    for (; i + 4 <= len; i += 4) {
+        RK_U32 val;
+
+        memcpy(&val, dat + i, 4);
+        sum += dat[i] + dat[i + 1] + dat[i + 2] + dat[i + 3];
+        vor ^= val;
+    }
+    if (i < len) {
         RK_U32 val = 0;
-        dat8 = (RK_U8 *)&val;
-        for (i = (len / 4) * 4; i < len; i++)
-            dat8[i % 4] = dat[i];
-        xor ^= val;
+
+        memcpy(&val, dat + i, len - i);
+        for (; i < len; i++)
+            sum += dat[i];
+        vor ^= val;
+    }
+
+    s->sum += sum;
+    s->vor ^= vor;
+}
+
+/* slice-by-8 */
+static RK_U32 crc32c_update_c(RK_U32 crc, const RK_U8 *dat, RK_U32 len)
+{
+    for (; len >= 8; dat += 8, len -= 8) {
+        RK_U32 lo = crc ^ (dat[0] | dat[1] << 8 | dat[2] << 16 | (RK_U32)dat[3] << 24);
+        RK_U32 hi = dat[4] | dat[5] << 8 | dat[6] << 16 | (RK_U32)dat[7] << 24;
+
+        crc = crc32c_table[7][lo & 0xff] ^ crc32c_table[6][(lo >> 8) & 0xff] ^
+              crc32c_table[5][(lo >> 16) & 0xff] ^ crc32c_table[4][lo >> 24] ^
+              crc32c_table[3][hi & 0xff] ^ crc32c_table[2][(hi >> 8) & 0xff] ^
+              crc32c_table[1][(hi >> 16) & 0xff] ^ crc32c_table[0][hi >> 24];
+    }
+    for (; len; len--)
+        crc = crc32c_table[0][(crc ^ *dat++) & 0xff] ^ (crc >> 8);
+
+    return crc;
+}
+
+#if defined(CRC32C_HW_ARM)
+static RK_U32 crc32c_update_hw(RK_U32 crc, const RK_U8 *dat, RK_U32 len)
+{
+    for (; len >= 8; dat += 8, len -= 8) {
+        RK_U64 val;
+
+        memcpy(&val, dat, 8);
+        crc = __crc32cd(crc, val);
+    }
+    for (; len; len--)
+        crc = __crc32cb(crc, *dat++);
+
+    return crc;
+}
+#elif defined(CRC32C_HW_SSE42)
+__attribute__((target("sse4.2")))
+static RK_U32 crc32c_update_hw(RK_U32 crc, const RK_U8 *dat, RK_U32 len)
+{
+    RK_U64 c = crc;
+
+    for (; len >= 8; dat += 8, len -= 8) {
+        RK_U64 val;
+
+        memcpy(&val, dat, 8);
+        c = _mm_crc32_u64(c, val);
+    }
+    crc = (RK_U32)c;
+    for (; len; len--)
+        crc = _mm_crc32_u8(crc, *dat++);
+
+    return crc;
+}
+#endif
+
+static void crc32c_init(void)
+{
+    RK_U32 i, j;
+
+    for (i = 0; i < 256; i++) {
+        RK_U32 crc = i;
+
+        for (j = 0; j < 8; j++)
+            crc = (crc >> 1) ^ ((crc & 1) ? CRC32C_POLY : 0);
+        crc32c_table[0][i] = crc;
+    }
+    for (i = 0; i < 256; i++)
+        for (j = 1; j < 8; j++)
+            crc32c_table[j][i] = (crc32c_table[j - 1][i] >> 8) ^
+                                 crc32c_table[0][crc32c_table[j - 1][i] & 0xff];
+
+    crc32c_update = crc32c_update_c;
+#if defined(CRC32C_HW_ARM)
+    crc32c_update = crc32c_update_hw;
+#elif defined(CRC32C_HW_SSE42)
+    if (__builtin_cpu_supports("sse4.2"))
+        crc32c_update = crc32c_update_hw;
+#endif
+}
+
+static void crc_simd_init(void)
+{
+    mpp_env_get_u32("utils_crc_simd", &crc_simd, 1);
+}
+
+void set_data_crc_simd(RK_U32 enable)
+{
+    pthread_once(&crc_simd_once, crc_simd_init);
+    crc_simd = enable;
+}
+
+static void crc_init(CrcState *s, CrcType type)
+{
+    memset(s, 0, sizeof(*s));
+    s->type = type;
+    s->crc = ~0U;
+    pthread_once(&crc_simd_once, crc_simd_init);
+    s->simd = crc_simd;
+
+    if (type == CRC_TYPE_CRC32C)
+        pthread_once(&crc32c_once, crc32c_init);
+}
+
+static void crc_update(CrcState *s, const RK_U8 *dat, RK_U32 len)
+{
+    s->len += len;
+    if (s->type == CRC_TYPE_CRC32C)
+        s->crc = (s->simd ? crc32c_update : crc32c_update_c)(s->crc, dat, len);
+    else
+        sum_xor_update(s, dat, len);
+}
+
+static void crc_final(CrcState *s, DataCrc *crc)
+{
+    crc->len = s->len;
+    if (s->type == CRC_TYPE_CRC32C) {
+        crc->sum = ~s->crc;
+        crc->vor = 0;
+    } else {
+        crc->sum = (RK_U32)s->sum;
+        crc->vor = s->vor;
     }
+}
 
-    crc->len = len;
-    crc->sum = sum;
-    crc->vor = xor;
+void calc_data_crc(RK_U8 *dat, RK_U32 len, DataCrc *crc, CrcType type)
+{
+    CrcState s;
+
+    crc_init(&s, type);
+    crc_update(&s, dat, len);
+    crc_final(&s, crc);
 }
 
 void write_data_crc(FILE *fp, DataCrc *crc)
@@ -196,47 +431,121 @@ void read_data_crc(FILE *fp, DataCrc *crc)
     }
 }
 
-void calc_frm_crc(MppFrame frame, FrmCrc *crc)
+typedef struct CrcPlane_t {
+    RK_U8           *ptr;
+    RK_U32          bytes;      /* of one row */
+    RK_U32          rows;
+    RK_U32          stride;
+} CrcPlane;
+
+static void crc_plane(CrcState *s, CrcPlane *p)
 {
-    RK_U32 y = 0, x = 0;
-    RK_U8 *dat8 = NULL;
-    RK_U32 *dat32 = NULL;
-    RK_U32 sum = 0, xor = 0;
+    RK_U32 y;
 
+    for (y = 0; y < p->rows; y++)
+        crc_update(s, p->ptr + y * p->stride, p->bytes);
+}
+
+/*
+ * The visible part of each plane, strides in bytes as set by mpp_buf_slot.
+ * 10-bit formats are packed with 4 pixels in 5 bytes, the 4:2:2 packed ones
+ * only have a luma plane. Returns the number of chroma planes, -1 if the
+ * format is not known.
+ */
+static RK_S32 get_crc_planes(MppFrame frame, RK_U8 *buf, CrcPlane *luma, CrcPlane *chroma)
+{
+    MppFrameFormat fmt = mpp_frame_get_fmt(frame);
     RK_U32 width  = mpp_frame_get_width(frame);
     RK_U32 height = mpp_frame_get_height(frame);
-    RK_U32 stride = mpp_frame_get_hor_stride(frame);
-    RK_U8 *buf = (RK_U8 *)mpp_buffer_get_ptr(mpp_frame_get_buffer(frame));
-
-    /* luma */
-    dat8 = buf;
-    for (y = 0; y < height; y++)
-        for (x = 0; x < width; x++)
-            sum += dat8[y * stride + x];
-
-    for (y = 0; y < height; y++) {
-        dat32 = (RK_U32 *)&dat8[y * stride];
-        for (x = 0; x < width / 4; x++)
-            xor ^= dat32[x];
+    RK_U32 h_stride = mpp_frame_get_hor_stride(frame);
+    RK_U32 v_stride = mpp_frame_get_ver_stride(frame);
+    RK_U8 *base_c = buf + h_stride * v_stride;
+    RK_U32 bytes = width;
+    RK_S32 count = 1;
+
+    if (fmt == MPP_FMT_YUV420SP_10BIT || fmt == MPP_FMT_YUV422SP_10BIT)
+        bytes = (width * 10 + 7) >> 3;
+
+    luma->ptr    = buf;
+    luma->bytes  = bytes;
+    luma->rows   = height;
+    luma->stride = h_stride;
+
+    chroma[0] = *luma;
+    chroma[0].ptr = base_c;
+
+    switch (fmt) {
+    case MPP_FMT_YUV420SP :
+    case MPP_FMT_YUV420SP_VU :
+    case MPP_FMT_YUV420SP_10BIT : {
+        chroma[0].rows = (height + 1) / 2;
+    } break;
+    case MPP_FMT_YUV422SP :
+    case MPP_FMT_YUV422SP_VU :
+    case MPP_FMT_YUV422SP_10BIT : {
+    } break;
+    case MPP_FMT_YUV420P :
+    case MPP_FMT_YUV422P : {
+        RK_U32 rows = (fmt == MPP_FMT_YUV420P) ? (height + 1) / 2 : height;
+        RK_U32 v_rows = (fmt == MPP_FMT_YUV420P) ? v_stride / 2 : v_stride;
+
+        chroma[0].bytes  = (width + 1) / 2;
+        chroma[0].rows   = rows;
+        chroma[0].stride = h_stride / 2;
+        chroma[1] = chroma[0];
+        chroma[1].ptr = base_c + h_stride / 2 * v_rows;
+        count = 2;
+    } break;
+    case MPP_FMT_YUV444SP : {
+        chroma[0].bytes  = width * 2;
+        chroma[0].stride = h_stride * 2;
+    } break;
+    case MPP_FMT_YUV400 : {
+        count = 0;
+    } break;
+    case MPP_FMT_YUV422_YUYV :
+    case MPP_FMT_YUV422_YVYU :
+    case MPP_FMT_YUV422_UYVY :
+    case MPP_FMT_YUV422_VYUY : {
+        luma->bytes = width * 2;
+        count = 0;
+    } break;
+    default : {
+        count = -1;
+    } break;
     }
-    crc->luma.len = height * width;
-    crc->luma.sum = sum;
-    crc->luma.vor = xor;
-
-    /* chroma */
-    dat8 = buf + height * stride;
-    for (y = 0; y < height / 2; y++)
-        for (x = 0; x < width; x++)
-            sum += dat8[y * stride + x];
-
-    for (y = 0; y < height / 2; y++) {
-        dat32 = (RK_U32 *)&dat8[y * stride];
-        for (x = 0; x < width / 4; x++)
-            xor ^= dat32[x];
+
+    return count;
+}
+
+void calc_frm_crc(MppFrame frame, FrmCrc *crc, CrcType type)
+{
+    MppBuffer buffer = mpp_frame_get_buffer(frame);
+    RK_U8 *buf = buffer ? (RK_U8 *)mpp_buffer_get_ptr(buffer) : NULL;
+    CrcPlane luma;
+    CrcPlane chroma[2];
+    CrcState s;
+    RK_S32 count;
+    RK_S32 i;
+
+    memset(crc, 0, sizeof(*crc));
+    if (NULL == buf)
+        return;
+
+    count = get_crc_planes(frame, buf, &luma, chroma);
+    if (count < 0) {
+        mpp_err_f("not supported format %d\n", mpp_frame_get_fmt(frame));
+        return;
     }
-    crc->chroma.len = height * width / 2;
-    crc->chroma.sum = sum;
-    crc->chroma.vor = xor;
+
+    crc_init(&s, type);
+    crc_plane(&s, &luma);
+    crc_final(&s, &crc->luma);
+
+    crc_init(&s, type);
+    for (i = 0; i < count; i++)
+        crc_plane(&s, &chroma[i]);
+    crc_final(&s, &crc->chroma);
 }
 
 void write_frm_crc(FILE *fp, FrmCrc *crc)
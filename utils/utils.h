@@ -27,6 +27,12 @@ typedef struct OptionInfo_t {
     const char*     help;
 } OptionInfo;
 
+typedef enum CrcType_e {
+    CRC_TYPE_SUM,           /* byte sum and xor of 32-bit words */
+    CRC_TYPE_CRC32C,        /* crc32c in sum, vor is zero */
+    CRC_TYPE_BUTT,
+} CrcType;
+
 typedef struct data_crc_t {
     RK_U32          len;
     RK_U32          sum;
@@ -51,11 +57,12 @@ extern "C" {
 void _show_options(int count, OptionInfo *options);
 void dump_mpp_frame_to_file(MppFrame frame, FILE *fp);
 
-void calc_data_crc(RK_U8 *dat, RK_U32 len, DataCrc *crc);
+void calc_data_crc(RK_U8 *dat, RK_U32 len, DataCrc *crc, CrcType type);
 void write_data_crc(FILE *fp, DataCrc *crc);
 void read_data_crc(FILE *fp, DataCrc *crc);
+void set_data_crc_simd(RK_U32 enable);
 
-void calc_frm_crc(MppFrame frame, FrmCrc *crc);
+void calc_frm_crc(MppFrame frame, FrmCrc *crc, CrcType type);
 void write_frm_crc(FILE *fp, FrmCrc *crc);
 void read_frm_crc(FILE *fp, FrmCrc *crc);
 